@@ -43,6 +43,7 @@
 #include <stdlib.h>
 #include "adxl345.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -61,6 +62,17 @@ uint8_t adxl345_get_register_value(struct adxl345_dev *dev,
 {
 	uint8_t data_buffer[2] = {0, 0};
 	uint8_t register_value = 0;
+	struct no_os_i2c_msg msgs[] = {
+		{
+			.buff = &register_address,
+			.bytes_number = 1,
+		},
+		{
+			.buff = &register_value,
+			.bytes_number = 1,
+			.flags = NO_OS_I2C_M_RD,
+		},
+	};
 
 	if (dev->communication_type == ADXL345_SPI_COMM) {
 		data_buffer[0] = ADXL345_SPI_READ | register_address;
@@ -70,14 +82,8 @@ uint8_t adxl345_get_register_value(struct adxl345_dev *dev,
 					 2);
 		register_value = data_buffer[1];
 	} else {
-		no_os_i2c_write(dev->i2c_desc,
-				&register_address, // Transmission data.
-				1,                 // Number of bytes to write.
-				0);                // Stop condition control.
-		no_os_i2c_read(dev->i2c_desc,
-			       &register_value,    // Received data.
-			       1,                  // Number of bytes to read.
-			       1);                 // Stop condition control.
+		/* Address write, repeated start and read. */
+		no_os_i2c_transfer(dev->i2c_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
 	}
 
 	return register_value;
@@ -219,6 +225,17 @@ void adxl345_get_xyz(struct adxl345_dev *dev,
 {
 	uint8_t first_reg_address = ADXL345_DATAX0;
 	uint8_t read_buffer[7]    = {0, 0, 0, 0, 0, 0, 0};
+	struct no_os_i2c_msg msgs[] = {
+		{
+			.buff = &first_reg_address,
+			.bytes_number = 1,
+		},
+		{
+			.buff = read_buffer,
+			.bytes_number = 6,
+			.flags = NO_OS_I2C_M_RD,
+		},
+	};
 
 	if (dev->communication_type == ADXL345_SPI_COMM) {
 		read_buffer[0] = ADXL345_SPI_READ |
@@ -234,14 +251,8 @@ void adxl345_get_xyz(struct adxl345_dev *dev,
 		/* z = ((ADXL345_DATAZ1) << 8) + ADXL345_DATAZ0 */
 		*z = ((int16_t)read_buffer[6] << 8) + read_buffer[5];
 	} else {
-		no_os_i2c_write(dev->i2c_desc,
-				&first_reg_address, // Transmission data.
-				1,                  // Number of bytes to write.
-				0);                 // Stop condition control.
-		no_os_i2c_read(dev->i2c_desc,
-			       read_buffer,         // Received data.
-			       6,                   // Number of bytes to read.
-			       1);                  // Stop condition control.
+		/* Address write, repeated start and read of the 6 registers. */
+		no_os_i2c_transfer(dev->i2c_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
 		/* x = ((ADXL345_DATAX1) << 8) + ADXL345_DATAX0 */
 		*x = ((int16_t)read_buffer[1] << 8) + read_buffer[0];
 		/* y = ((ADXL345_DATAY1) << 8) + ADXL345_DATAY0 */
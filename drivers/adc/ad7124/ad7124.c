@@ -55,6 +55,25 @@
  */
 #define AD7124_POST_RESET_DELAY	4
 
+/*
+ * Registers changed by the device: status, data, the ADC control register
+ * (the mode returns to idle or standby on its own), the error flags, the
+ * MCLK counter and the calibration results.
+ */
+static const struct no_os_regmap_range ad7124_volatile_regs[] = {
+	{ .min = AD7124_STATUS_REG, .max = AD7124_DATA_REG },
+	{ .min = AD7124_ERR_REG, .max = AD7124_ERR_REG },
+	{ .min = AD7124_Mclk_Count, .max = AD7124_Mclk_Count },
+	{ .min = AD7124_OFFS0_REG, .max = AD7124_GAIN7_REG },
+};
+
+static const struct no_os_regmap_config ad7124_regmap_config = {
+	.max_register = AD7124_REG_NO - 1,
+	.volatile_table = ad7124_volatile_regs,
+	.volatile_table_len = NO_OS_ARRAY_SIZE(ad7124_volatile_regs),
+	.cache_type = NO_OS_REGMAP_CACHE_FLAT,
+};
+
 /***************************************************************************//**
  * @brief Reads the value of the specified register without checking if the
  *        device is ready to accept user requests.
@@ -167,10 +186,71 @@ int32_t ad7124_no_check_write_register(struct ad7124_dev *dev,
 					: reg.size + 1);
 }
 
+/***************************************************************************//**
+ * @brief Register cache backend: reads a register from the device, after
+ *        checking that it is ready to accept user requests.
+ * @param ctx - The handler of the instance of the driver.
+ * @param reg - Address of the register to be read.
+ * @param val - Pointer to the register value.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int32_t ad7124_regmap_read(void *ctx, uint32_t reg, uint32_t *val)
+{
+	struct ad7124_dev *dev = ctx;
+	int32_t ret;
+
+	if (reg != AD7124_ERR_REG && dev->check_ready) {
+		ret = ad7124_wait_for_spi_ready(dev,
+						dev->spi_rdy_poll_cnt);
+		if (ret)
+			return ret;
+	}
+
+	ret = ad7124_no_check_read_register(dev, &dev->regs[reg]);
+	if (ret)
+		return ret;
+
+	*val = dev->regs[reg].value;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Register cache backend: writes a register of the device, after
+ *        checking that it is ready to accept user requests.
+ * @param ctx - The handler of the instance of the driver.
+ * @param reg - Address of the register to be written.
+ * @param val - New value for the register.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int32_t ad7124_regmap_write(void *ctx, uint32_t reg, uint32_t val)
+{
+	struct ad7124_dev *dev = ctx;
+	int32_t ret;
+
+	if (dev->check_ready) {
+		ret = ad7124_wait_for_spi_ready(dev,
+						dev->spi_rdy_poll_cnt);
+		if (ret)
+			return ret;
+	}
+
+	dev->regs[reg].value = val;
+
+	return ad7124_no_check_write_register(dev, dev->regs[reg]);
+}
+
+static const struct no_os_regmap_bus_ops ad7124_regmap_ops = {
+	.reg_read = ad7124_regmap_read,
+	.reg_write = ad7124_regmap_write,
+};
+
 /***************************************************************************//**
  * @brief Reads the value of the specified register only when the device is ready
  *        to accept user requests. If the device ready flag is deactivated the
  *        read operation will be executed without checking the device state.
+ *        Registers which are not changed by the device are read from the
+ *        register cache once known.
  *        DEPRECATED, use ad7124_read_register2.
  * @param dev   - The handler of the instance of the driver.
  * @param p_reg - Pointer to the register structure holding info about the
@@ -181,17 +261,19 @@ int32_t ad7124_no_check_write_register(struct ad7124_dev *dev,
 int32_t ad7124_read_register(struct ad7124_dev *dev,
 			     struct ad7124_st_reg* p_reg)
 {
+	uint32_t val;
 	int32_t ret;
 
-	if (p_reg->addr != AD7124_ERR_REG && dev->check_ready) {
-		ret = ad7124_wait_for_spi_ready(dev,
-						dev->spi_rdy_poll_cnt);
-		if (ret)
-			return ret;
-	}
+	if (!dev || !p_reg)
+		return -EINVAL;
+
+	ret = no_os_regmap_read(dev->regmap, p_reg->addr, &val);
+	if (ret)
+		return ret;
 
-	return ad7124_no_check_read_register(dev,
-					     p_reg);
+	p_reg->value = val;
+
+	return 0;
 }
 
 /***************************************************************************//**
@@ -228,17 +310,10 @@ int32_t ad7124_read_register2(struct ad7124_dev *dev,
 int32_t ad7124_write_register(struct ad7124_dev *dev,
 			      struct ad7124_st_reg p_reg)
 {
-	int32_t ret;
-
-	if (dev->check_ready) {
-		ret = ad7124_wait_for_spi_ready(dev,
-						dev->spi_rdy_poll_cnt);
-		if (ret)
-			return ret;
-	}
+	if (!dev)
+		return -EINVAL;
 
-	return ad7124_no_check_write_register(dev,
-					      p_reg);
+	return no_os_regmap_write(dev->regmap, p_reg.addr, p_reg.value);
 }
 
 /***************************************************************************//**
@@ -277,6 +352,9 @@ int32_t ad7124_reset(struct ad7124_dev *dev)
 	/* CRC is disabled after reset */
 	dev->use_crc = AD7124_DISABLE_CRC;
 
+	/* The registers are back to their reset values */
+	no_os_regmap_cache_drop(dev->regmap);
+
 	/* Read POR bit to clear */
 	ret = ad7124_wait_to_power_on(dev, dev->spi_rdy_poll_cnt);
 	if (ret)
@@ -692,6 +770,8 @@ int32_t ad7124_set_odr(struct ad7124_dev *dev,
 
 /***************************************************************************//**
  * @brief		   - SPI internal register write to device using a mask.
+ *                   The register is read from the device only if it is not
+ *                   cached and written only if its value changes.
  * @param dev      - The device structure.
  * @param reg_addr - The register address.
  * @param data     - The register data.
@@ -703,17 +783,10 @@ int ad7124_reg_write_msk(struct ad7124_dev *dev,
 			 uint32_t data,
 			 uint32_t mask)
 {
-	int ret;
-	uint32_t reg_data;
-
-	ret = ad7124_read_register2(dev, reg_addr, &reg_data);
-	if (ret)
-		return ret;
-
-	reg_data &= ~mask;
-	reg_data |= data;
+	if (!dev)
+		return -EINVAL;
 
-	return ad7124_write_register2(dev, reg_addr, reg_data);
+	return no_os_regmap_update_bits(dev->regmap, reg_addr, mask, data);
 }
 
 /***************************************************************************//**
@@ -753,15 +826,16 @@ int ad7124_set_channel_status(struct ad7124_dev *device,
 			      bool channel_status)
 {
 	int ret;
+	uint32_t reg_val;
 
 	if (channel_status)
-		channel_status = AD7124_CH_MAP_REG_CH_ENABLE;
+		reg_val = AD7124_CH_MAP_REG_CH_ENABLE;
 	else
-		channel_status = 0x0U;
+		reg_val = 0x0U;
 
 	ret = ad7124_reg_write_msk(device,
 				   AD7124_CH0_MAP_REG+chn_num,
-				   channel_status,
+				   reg_val,
 				   AD7124_CH_MAP_REG_CH_ENABLE);
 	if (ret)
 		return ret;
@@ -847,15 +921,16 @@ int ad7124_set_polarity(struct ad7124_dev* device,
 			uint8_t setup_id)
 {
 	int ret;
+	uint32_t reg_val;
 
 	if (bipolar)
-		bipolar = AD7124_CFG_REG_BIPOLAR;
+		reg_val = AD7124_CFG_REG_BIPOLAR;
 	else
-		bipolar = 0x0U;
+		reg_val = 0x0U;
 
 	ret = ad7124_reg_write_msk(device,
 				   AD7124_CFG0_REG+setup_id,
-				   bipolar,
+				   reg_val,
 				   AD7124_CFG_REG_BIPOLAR);
 	if (ret)
 		return ret;
@@ -891,16 +966,11 @@ int ad7124_set_reference_source(struct ad7124_dev* device,
 
 	device->setups[setup_id].ref_source = ref_source;
 
-	if (ref_en)
-		ref_en = AD7124_ADC_CTRL_REG_REF_EN;
-	else
-		ref_en = 0x0U;
-
 	/* Enable the REF_EN Bit in case of Internal reference */
 	if (ref_source == INTERNAL_REF) {
 		ret = ad7124_reg_write_msk(device,
 					   AD7124_ADC_CTRL_REG,
-					   ref_en,
+					   ref_en ? AD7124_ADC_CTRL_REG_REF_EN : 0,
 					   AD7124_ADC_CTRL_REG_REF_EN);
 		if (ret)
 			return ret;
@@ -981,6 +1051,7 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 		return -ENOMEM;
 
 	dev->regs = init_param->regs;
+	dev->regmap = NULL;
 	dev->spi_rdy_poll_cnt = init_param->spi_rdy_poll_cnt;
 
 	/* Initialize the SPI communication. */
@@ -988,6 +1059,11 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 	if (ret)
 		goto error_dev;
 
+	ret = no_os_regmap_init(&dev->regmap, &ad7124_regmap_ops, dev,
+				&ad7124_regmap_config);
+	if (ret)
+		goto error_spi;
+
 	/* Update the device structure with power-on/reset settings. */
 	dev->check_ready = init_param->check_ready;
 
@@ -1071,6 +1147,7 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 	return 0;
 
 error_spi:
+	no_os_regmap_remove(dev->regmap);
 	no_os_spi_remove(dev->spi_desc);
 error_dev:
 	free(dev);
@@ -1091,6 +1168,7 @@ int32_t ad7124_remove(struct ad7124_dev *dev)
 	if (ret)
 		return ret;
 
+	no_os_regmap_remove(dev->regmap);
 	no_os_free(dev);
 
 	return 0;
@@ -48,6 +48,7 @@
 #include "no_os_spi.h"
 #include "no_os_delay.h"
 #include "no_os_util.h"
+#include "no_os_regmap.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -476,6 +477,8 @@ enum ad7124_registers {
 struct ad7124_dev {
 	/* SPI */
 	struct no_os_spi_desc		*spi_desc;
+	/* Register cache */
+	struct no_os_regmap	*regmap;
 	/* Device Settings */
 	struct ad7124_st_reg	*regs;
 	int16_t use_crc;
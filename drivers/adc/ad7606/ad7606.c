@@ -65,8 +65,8 @@ struct ad7606_chip_info {
 	uint32_t sw_range_table_sz;
 };
 
-NO_OS_DECLARE_CRC8_TABLE(ad7606_crc8);
-NO_OS_DECLARE_CRC16_TABLE(ad7606_crc16);
+NO_OS_DEFINE_CRC8_TABLE(ad7606_crc8, 0x7);
+NO_OS_DEFINE_CRC16_TABLE(ad7606_crc16, 0x755b);
 
 static const struct ad7606_range ad7606_range_table[] = {
 	{-5000, 5000, false},	/* RANGE pin LOW */
@@ -1114,9 +1114,6 @@ int32_t ad7606_init(struct ad7606_dev **device,
 	uint8_t reg, id;
 	int32_t i, ret;
 
-	no_os_crc8_populate_msb(ad7606_crc8, 0x7);
-	no_os_crc16_populate_msb(ad7606_crc16, 0x755b);
-
 	dev = (struct ad7606_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -ENOMEM;
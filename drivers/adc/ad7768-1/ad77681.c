@@ -48,6 +48,9 @@
 #include "no_os_error.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "no_os_crc8.h"
+
+NO_OS_DEFINE_CRC8_TABLE(ad77681_crc8, AD77681_CRC8_POLY);
 
 /******************************************************************************/
 /************************** Functions Implementation **************************/
@@ -63,21 +66,7 @@ uint8_t ad77681_compute_crc8(uint8_t *data,
 			     uint8_t data_size,
 			     uint8_t init_val)
 {
-	uint8_t i;
-	uint8_t crc = init_val;
-
-	while (data_size) {
-		for (i = 0x80; i != 0; i >>= 1) {
-			if (((crc & 0x80) != 0) != ((*data & i) != 0)) {
-				crc <<= 1;
-				crc ^= AD77681_CRC8_POLY;
-			} else
-				crc <<= 1;
-		}
-		data++;
-		data_size--;
-	}
-	return crc;
+	return no_os_crc8(ad77681_crc8, data, data_size, init_val);
 }
 
 /**
@@ -46,10 +46,13 @@
 #include "no_os_util.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_crc8.h"
 
 /******************************************************************************/
 /*************************** Constants Definitions ****************************/
 /******************************************************************************/
+NO_OS_DEFINE_CRC8_TABLE(ad7779_crc8, AD7779_CRC8_POLY);
+
 const uint8_t pin_mode_options[16][4] = {
 	/*GAIN_1, GAIN_2, GAIN_4, GAIN_8 */
 	{0x03,	0xFF,	0x07,	0xFF},	// DEC_RATE_128, HIGH_RES, EXT_REF
@@ -82,22 +85,7 @@ const uint8_t pin_mode_options[16][4] = {
 uint8_t ad7779_compute_crc8(uint8_t *data,
 			    uint8_t data_size)
 {
-	uint8_t i;
-	uint8_t crc = 0;
-
-	while (data_size) {
-		for (i = 0x80; i != 0; i >>= 1) {
-			if (((crc & 0x80) != 0) != ((*data & i) != 0)) {
-				crc <<= 1;
-				crc ^= AD7779_CRC8_POLY;
-			} else
-				crc <<= 1;
-		}
-		data++;
-		data_size--;
-	}
-
-	return crc;
+	return no_os_crc8(ad7779_crc8, data, data_size, 0);
 }
 
 /**
@@ -44,6 +44,7 @@
 #include "no_os_util.h"
 #include "iio_adc_demo.h"
 #include "iio.h"
+#include "iio_scan.h"
 
 /**
  * @brief utility function for computing next upcoming channel
@@ -143,37 +144,49 @@ int set_adc_demo_attr(void *device, char *buf, uint32_t len,
 int32_t adc_submit_samples(struct iio_device_data *dev_data)
 {
 	struct adc_demo_desc *desc;
-	uint32_t k = 0;
+	struct iio_scan_layout layout;
+	const void *ch_data[TOTAL_ADC_CHANNELS];
+	uint32_t lut_len = NO_OS_ARRAY_SIZE(sine_lut);
+	uint32_t offset_per_ch = lut_len / TOTAL_ADC_CHANNELS;
 	uint32_t ch = -1;
-	uint16_t buff[TOTAL_ADC_CHANNELS];
-	uint32_t i;
-	uint16_t *ch_buf_ptr;
+	uint32_t nb_scans, i, n, idx;
+	int ret;
 
 	if(!dev_data)
 		return -ENODEV;
 
 	desc = (struct adc_demo_desc *)dev_data->dev;
+	nb_scans = dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
+
+	ret = iio_scan_layout_init(&layout, adc_demo_iio_descriptor.channels,
+				   TOTAL_ADC_CHANNELS, desc->active_ch);
+	if (ret)
+		return ret;
 
 	if(desc->ext_buff == NULL) {
-		int offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
-		for(i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan; i++) {
-			while(get_next_ch_idx(desc->active_ch, ch, &ch))
-				buff[k++] = sine_lut[(i + ch * offset_per_ch ) % NO_OS_ARRAY_SIZE(sine_lut)];
-			k = 0;
-			iio_buffer_push_scan(dev_data->buffer, buff);
+		/* Push the longest runs in which no channel wraps around the LUT */
+		for (i = 0; i < nb_scans; i += n) {
+			n = nb_scans - i;
+			while(get_next_ch_idx(desc->active_ch, ch, &ch)) {
+				idx = (i + ch * offset_per_ch) % lut_len;
+				ch_data[ch] = &sine_lut[idx];
+				n = no_os_min(n, lut_len - idx);
+			}
+			ret = iio_buffer_push_scans(dev_data->buffer, &layout,
+						    ch_data, n);
+			if (ret)
+				return ret;
 		}
-		return dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
+		return nb_scans;
 	}
 
-	for(i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan; i++) {
-		while(get_next_ch_idx(desc->active_ch, ch, &ch)) {
-			ch_buf_ptr = (uint16_t*)desc->ext_buff + (ch * desc->ext_buff_len);
-			buff[k++] = ch_buf_ptr[i];
-		}
-		k = 0;
-		iio_buffer_push_scan(dev_data->buffer, buff);
-	}
-	return dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
+	while(get_next_ch_idx(desc->active_ch, ch, &ch))
+		ch_data[ch] = (uint16_t*)desc->ext_buff + (ch * desc->ext_buff_len);
+	ret = iio_buffer_push_scans(dev_data->buffer, &layout, ch_data, nb_scans);
+	if (ret)
+		return ret;
+
+	return nb_scans;
 }
 
 
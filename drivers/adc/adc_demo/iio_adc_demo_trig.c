@@ -63,10 +63,8 @@ struct iio_trigger adc_iio_sw_trig_desc = {
 	.attributes = trig_attr,
 };
 
-#ifndef LINUX_PLATFORM
 struct iio_trigger adc_iio_timer_trig_desc = {
 	.is_synchronous = true,
 	.enable = iio_trig_enable,
 	.disable = iio_trig_disable,
 };
-#endif
@@ -50,8 +50,11 @@
 #include "no_os_error.h"
 #include "no_os_irq.h"
 #include "no_os_print_log.h"
+#include "no_os_crc8.h"
 #include <string.h>
 
+NO_OS_DEFINE_CRC8_TABLE(ad4110_crc8, AD4110_CRC8_POLY);
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
@@ -66,21 +69,7 @@
 uint8_t ad4110_compute_crc8(uint8_t *data,
 			    uint8_t data_size)
 {
-	uint8_t i;
-	uint8_t crc = 0;
-
-	while (data_size) {
-		for (i = 0x80; i != 0; i >>= 1) {
-			if (((crc & 0x80) != 0) != ((*data & i) != 0)) {
-				crc <<= 1;
-				crc ^= AD4110_CRC8_POLY;
-			} else
-				crc <<= 1;
-		}
-		data++;
-		data_size--;
-	}
-	return crc;
+	return no_os_crc8(ad4110_crc8, data, data_size, 0);
 }
 
 /***************************************************************************//**
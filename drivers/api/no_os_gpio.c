@@ -239,3 +239,95 @@ int32_t no_os_gpio_get_value(struct no_os_gpio_desc *desc,
 
 	return 0;
 }
+
+/**
+ * @brief Check if the GPIOs of an array can be handled with a single call to
+ * the platform specific multiple values function.
+ * @param desc - Array of GPIO descriptors, NULL entries are ignored.
+ * @param nb_gpios - Number of descriptors in the array.
+ * @return Platform ops shared by all the GPIOs, NULL if they differ.
+ */
+static const struct no_os_gpio_platform_ops *
+no_os_gpio_common_ops(struct no_os_gpio_desc **desc, uint8_t nb_gpios)
+{
+	const struct no_os_gpio_platform_ops *ops = NULL;
+	uint8_t i;
+
+	for (i = 0; i < nb_gpios; i++) {
+		if (!desc[i])
+			continue;
+		if (ops && desc[i]->platform_ops != ops)
+			return NULL;
+		ops = desc[i]->platform_ops;
+	}
+
+	return ops;
+}
+
+/**
+ * @brief Set the values of several GPIOs.
+ *
+ * If all the GPIOs use the same platform and it implements
+ * gpio_ops_set_values, they are set together (in a single operation when
+ * the platform allows it). Otherwise they are set one by one.
+ * @param desc - Array of GPIO descriptors, NULL entries are ignored.
+ * @param nb_gpios - Number of descriptors in the array.
+ * @param values - Array of values, one for each descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_set_values(struct no_os_gpio_desc **desc,
+			      uint8_t nb_gpios, const uint8_t *values)
+{
+	const struct no_os_gpio_platform_ops *ops;
+	int32_t ret;
+	uint8_t i;
+
+	if (!desc || !values)
+		return -EINVAL;
+
+	ops = no_os_gpio_common_ops(desc, nb_gpios);
+	if (ops && ops->gpio_ops_set_values)
+		return ops->gpio_ops_set_values(desc, nb_gpios, values);
+
+	for (i = 0; i < nb_gpios; i++) {
+		ret = no_os_gpio_set_value(desc[i], values[i]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the values of several GPIOs.
+ *
+ * If all the GPIOs use the same platform and it implements
+ * gpio_ops_get_values, they are read together (in a single operation when
+ * the platform allows it). Otherwise they are read one by one.
+ * @param desc - Array of GPIO descriptors, NULL entries are ignored.
+ * @param nb_gpios - Number of descriptors in the array.
+ * @param values - Array where the values will be stored.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_get_values(struct no_os_gpio_desc **desc,
+			      uint8_t nb_gpios, uint8_t *values)
+{
+	const struct no_os_gpio_platform_ops *ops;
+	int32_t ret;
+	uint8_t i;
+
+	if (!desc || !values)
+		return -EINVAL;
+
+	ops = no_os_gpio_common_ops(desc, nb_gpios);
+	if (ops && ops->gpio_ops_get_values)
+		return ops->gpio_ops_get_values(desc, nb_gpios, values);
+
+	for (i = 0; i < nb_gpios; i++) {
+		ret = no_os_gpio_get_value(desc[i], &values[i]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
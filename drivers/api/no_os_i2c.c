@@ -148,6 +148,7 @@ void no_os_i2cbus_remove(uint32_t bus_number)
 		if (bus != NULL) {
 			no_os_free(bus);
 			bus = NULL;
+			i2c_table[bus_number] = NULL;
 		}
 	}
 }
@@ -213,3 +214,62 @@ int32_t no_os_i2c_read(struct no_os_i2c_desc *desc,
 
 	return ret;
 }
+
+/**
+ * @brief Send a sequence of messages as a single bus transaction: the
+ * messages are separated by repeated START conditions and the STOP is
+ * generated after the last one. A register read is a write of the address
+ * followed by a read.
+ * @param desc - The I2C descriptor.
+ * @param msgs - Array of messages.
+ * @param nb_msgs - Number of messages in the array.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t nb_msgs)
+{
+	int32_t ret = 0;
+	uint8_t stop_bit;
+	uint32_t i;
+
+	if (!desc || !desc->platform_ops || (!msgs && nb_msgs))
+		return -EINVAL;
+
+	no_os_mutex_lock(desc->bus->mutex);
+
+	if (desc->platform_ops->i2c_ops_transfer) {
+		ret = desc->platform_ops->i2c_ops_transfer(desc, msgs, nb_msgs);
+		goto out;
+	}
+
+	if (!desc->platform_ops->i2c_ops_write ||
+	    !desc->platform_ops->i2c_ops_read) {
+		ret = -ENOSYS;
+		goto out;
+	}
+
+	for (i = 0; i < nb_msgs; i++) {
+		if (msgs[i].bytes_number > UINT8_MAX) {
+			ret = -EINVAL;
+			goto out;
+		}
+
+		stop_bit = (i == nb_msgs - 1);
+		if (msgs[i].flags & NO_OS_I2C_M_RD)
+			ret = desc->platform_ops->i2c_ops_read(desc, msgs[i].buff,
+							       msgs[i].bytes_number,
+							       stop_bit);
+		else
+			ret = desc->platform_ops->i2c_ops_write(desc, msgs[i].buff,
+								msgs[i].bytes_number,
+								stop_bit);
+		if (ret)
+			goto out;
+	}
+
+out:
+	no_os_mutex_unlock(desc->bus->mutex);
+
+	return ret;
+}
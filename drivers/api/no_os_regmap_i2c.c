@@ -0,0 +1,134 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap_i2c.c
+ *   @brief  I2C backend of the register map layer.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stddef.h>
+#include "no_os_regmap.h"
+#include "no_os_i2c.h"
+#include "no_os_error.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Read a register over I2C.
+ * @param ctx - The register map.
+ * @param reg - The register address.
+ * @param val - The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t regmap_i2c_read(void *ctx, uint32_t reg, uint32_t *val)
+{
+	struct no_os_regmap *map = ctx;
+	uint8_t buf[NO_OS_REGMAP_MAX_BYTES];
+	uint32_t len;
+	int32_t ret;
+
+	len = no_os_regmap_format(map, buf, reg, 0);
+	ret = no_os_i2c_write(map->i2c, buf, len, 0);
+	if (ret)
+		return ret;
+
+	ret = no_os_i2c_read(map->i2c, &buf[len], map->config.val_bits / 8,
+			     1);
+	if (ret)
+		return ret;
+
+	*val = no_os_regmap_parse(map, &buf[len]);
+
+	return 0;
+}
+
+/**
+ * @brief Write a register over I2C.
+ * @param ctx - The register map.
+ * @param reg - The register address.
+ * @param val - The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t regmap_i2c_write(void *ctx, uint32_t reg, uint32_t val)
+{
+	struct no_os_regmap *map = ctx;
+	uint8_t buf[NO_OS_REGMAP_MAX_BYTES];
+	uint32_t len;
+
+	len = no_os_regmap_format(map, buf, reg, val);
+
+	return no_os_i2c_write(map->i2c, buf, len + map->config.val_bits / 8,
+			       1);
+}
+
+/**
+ * @brief I2C backend.
+ */
+static const struct no_os_regmap_bus_ops regmap_i2c_ops = {
+	.reg_read = regmap_i2c_read,
+	.reg_write = regmap_i2c_write,
+};
+
+/**
+ * @brief Initialize a register map of an I2C device. The address is written
+ * first, then the value is written or read after a repeated start, both big
+ * endian.
+ * @param map - The register map.
+ * @param i2c - The I2C descriptor of the device.
+ * @param config - Description of the register map, copied by this function.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_regmap_init_i2c(struct no_os_regmap **map,
+			      struct no_os_i2c_desc *i2c,
+			      const struct no_os_regmap_config *config)
+{
+	int32_t ret;
+
+	if (!i2c || !no_os_regmap_valid_format(config))
+		return -EINVAL;
+
+	ret = no_os_regmap_init(map, &regmap_i2c_ops, NULL, config);
+	if (ret)
+		return ret;
+
+	(*map)->ctx = *map;
+	(*map)->i2c = i2c;
+
+	return 0;
+}
@@ -0,0 +1,158 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap_spi.c
+ *   @brief  SPI backend of the register map layer.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stddef.h>
+#include "no_os_regmap.h"
+#include "no_os_spi.h"
+#include "no_os_error.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Read a register over SPI.
+ * @param ctx - The register map.
+ * @param reg - The register address.
+ * @param val - The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t regmap_spi_read(void *ctx, uint32_t reg, uint32_t *val)
+{
+	struct no_os_regmap *map = ctx;
+	uint8_t buf[NO_OS_REGMAP_MAX_BYTES] = {0};
+	uint32_t len;
+	int32_t ret;
+
+	len = no_os_regmap_format(map, buf, reg | map->config.read_flag_mask,
+				  0);
+	ret = no_os_spi_write_and_read(map->spi, buf,
+				       len + map->config.val_bits / 8);
+	if (ret)
+		return ret;
+
+	*val = no_os_regmap_parse(map, &buf[len]);
+
+	return 0;
+}
+
+/**
+ * @brief Write a register over SPI.
+ * @param ctx - The register map.
+ * @param reg - The register address.
+ * @param val - The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t regmap_spi_write(void *ctx, uint32_t reg, uint32_t val)
+{
+	struct no_os_regmap *map = ctx;
+	uint8_t buf[NO_OS_REGMAP_MAX_BYTES];
+	uint32_t len;
+
+	len = no_os_regmap_format(map, buf, reg | map->config.write_flag_mask,
+				  val);
+
+	return no_os_spi_queue_msg(map->spi, buf, NULL,
+				   len + map->config.val_bits / 8);
+}
+
+/**
+ * @brief Open the SPI batch holding the writes of no_os_regmap_sync().
+ * @param ctx - The register map.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t regmap_spi_sync_begin(void *ctx)
+{
+	struct no_os_regmap *map = ctx;
+
+	return no_os_spi_batch_begin(map->spi);
+}
+
+/**
+ * @brief Send the writes of no_os_regmap_sync().
+ * @param ctx - The register map.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t regmap_spi_sync_end(void *ctx)
+{
+	struct no_os_regmap *map = ctx;
+
+	return no_os_spi_batch_end(map->spi);
+}
+
+/**
+ * @brief SPI backend. The writes done by no_os_regmap_sync() are sent as a
+ * single SPI batch.
+ */
+static const struct no_os_regmap_bus_ops regmap_spi_ops = {
+	.reg_read = regmap_spi_read,
+	.reg_write = regmap_spi_write,
+	.sync_begin = regmap_spi_sync_begin,
+	.sync_end = regmap_spi_sync_end,
+};
+
+/**
+ * @brief Initialize a register map of a SPI device. Registers are accessed
+ * with the address followed by the value, both big endian.
+ * @param map - The register map.
+ * @param spi - The SPI descriptor of the device.
+ * @param config - Description of the register map, copied by this function.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_regmap_init_spi(struct no_os_regmap **map,
+			      struct no_os_spi_desc *spi,
+			      const struct no_os_regmap_config *config)
+{
+	int32_t ret;
+
+	if (!spi || !no_os_regmap_valid_format(config))
+		return -EINVAL;
+
+	ret = no_os_regmap_init(map, &regmap_spi_ops, NULL, config);
+	if (ret)
+		return ret;
+
+	(*map)->ctx = *map;
+	(*map)->spi = spi;
+
+	return 0;
+}
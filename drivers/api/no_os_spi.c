@@ -40,6 +40,7 @@
 #include <inttypes.h>
 #include "no_os_spi.h"
 #include <stdlib.h>
+#include <string.h>
 #include "no_os_error.h"
 #include "no_os_mutex.h"
 #include "no_os_alloc.h"
@@ -49,6 +50,11 @@
 */
 static void *spi_table[SPI_MAX_BUS_NUMBER + 1];
 
+/**
+ * @brief Number of SPI messages sent on all the buses, used for profiling.
+*/
+static uint32_t spi_xfer_count;
+
 /**
  * @brief Initialize the SPI communication peripheral.
  * @param desc - The SPI descriptor.
@@ -81,6 +87,7 @@ int32_t no_os_spi_init(struct no_os_spi_desc **desc,
 	(*desc)->bus->slave_number++;
 	(*desc)->platform_ops = param->platform_ops;
 	(*desc)->parent = param->parent;
+	(*desc)->queue = NULL;
 
 	return 0;
 }
@@ -128,6 +135,10 @@ int32_t no_os_spi_remove(struct no_os_spi_desc *desc)
 
 	if (!desc->platform_ops->remove)
 		return -ENOSYS;
+
+	no_os_free(desc->queue);
+	desc->queue = NULL;
+
 	return desc->platform_ops->remove(desc);
 }
 
@@ -173,9 +184,15 @@ int32_t no_os_spi_write_and_read(struct no_os_spi_desc *desc,
 	if (!desc->platform_ops->write_and_read)
 		return -ENOSYS;
 
+	ret = no_os_spi_flush(desc);
+	if (ret)
+		return ret;
+
 	no_os_mutex_lock(desc->bus->mutex);
 	ret =  desc->platform_ops->write_and_read(desc, data, bytes_number);
 	no_os_mutex_unlock(desc->bus->mutex);
+	if (!ret)
+		__atomic_fetch_add(&spi_xfer_count, 1, __ATOMIC_RELAXED);
 
 	return ret;
 }
@@ -197,8 +214,17 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (desc->platform_ops->transfer)
-		return desc->platform_ops->transfer(desc, msgs, len);
+	ret = no_os_spi_flush(desc);
+	if (ret)
+		return ret;
+
+	if (desc->platform_ops->transfer) {
+		ret = desc->platform_ops->transfer(desc, msgs, len);
+		if (!ret)
+			__atomic_fetch_add(&spi_xfer_count, len, __ATOMIC_RELAXED);
+
+		return ret;
+	}
 
 	no_os_mutex_lock(desc->bus->mutex);
 
@@ -218,3 +244,167 @@ out:
 	no_os_mutex_unlock(desc->bus->mutex);
 	return ret;
 }
+
+/**
+ * @brief Start queueing the messages sent with no_os_spi_queue_msg().
+ *
+ * Batches may be nested, the queued messages are sent when the outermost one
+ * is closed.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_batch_begin(struct no_os_spi_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->queue) {
+		desc->queue = no_os_calloc(1, sizeof(*desc->queue));
+		if (!desc->queue)
+			return -ENOMEM;
+	}
+
+	desc->queue->depth++;
+
+	return 0;
+}
+
+/**
+ * @brief Close a batch opened by no_os_spi_batch_begin().
+ *
+ * Closing the outermost batch sends the queued messages.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise. The error of
+ * a flush done while the batch was open is also reported here.
+ */
+int32_t no_os_spi_batch_end(struct no_os_spi_desc *desc)
+{
+	struct no_os_spi_queue *queue;
+	int32_t ret;
+
+	if (!desc || !desc->queue || !desc->queue->depth)
+		return -EINVAL;
+
+	queue = desc->queue;
+	if (--queue->depth)
+		return 0;
+
+	ret = no_os_spi_flush(desc);
+	if (!ret)
+		ret = queue->err;
+	queue->err = 0;
+
+	return ret;
+}
+
+/**
+ * @brief Queue a message or send it right away if no batch is open.
+ *
+ * The data is copied, so the caller may reuse its buffer when this returns.
+ * If no batch is open, the message is sent in place, like with
+ * no_os_spi_write_and_read().
+ * @param desc - The SPI descriptor.
+ * @param data - The data to send.
+ * @param rx_buff - Where to copy the bytes_number received bytes once the
+ * message was sent. NULL if the received data is not needed.
+ * @param bytes_number - Number of bytes to write/read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_queue_msg(struct no_os_spi_desc *desc,
+			    uint8_t *data,
+			    uint8_t *rx_buff,
+			    uint16_t bytes_number)
+{
+	struct no_os_spi_queue *queue;
+	struct no_os_spi_msg *msg;
+	int32_t ret;
+
+	if (!desc || !data || !bytes_number)
+		return -EINVAL;
+
+	queue = desc->queue;
+	if (!queue || !queue->depth ||
+	    bytes_number > NO_OS_SPI_QUEUE_BUFF_SIZE) {
+		ret = no_os_spi_write_and_read(desc, data, bytes_number);
+		if (ret)
+			return ret;
+		if (rx_buff)
+			memcpy(rx_buff, data, bytes_number);
+
+		return 0;
+	}
+
+	if (queue->nb_msgs == NO_OS_SPI_QUEUE_MSGS ||
+	    queue->buff_len + bytes_number > NO_OS_SPI_QUEUE_BUFF_SIZE) {
+		ret = no_os_spi_flush(desc);
+		if (ret)
+			return ret;
+	}
+
+	msg = &queue->msgs[queue->nb_msgs];
+	msg->tx_buff = &queue->buff[queue->buff_len];
+	msg->rx_buff = msg->tx_buff;
+	msg->bytes_number = bytes_number;
+	msg->cs_change = 1;
+	memcpy(msg->tx_buff, data, bytes_number);
+
+	queue->rx_buffs[queue->nb_msgs++] = rx_buff;
+	queue->buff_len += bytes_number;
+
+	return 0;
+}
+
+/**
+ * @brief Send the queued messages with a single no_os_spi_transfer() call.
+ *
+ * CS is deasserted after every message, the last one included, the same as if
+ * each of them was sent with no_os_spi_write_and_read().
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_spi_flush(struct no_os_spi_desc *desc)
+{
+	struct no_os_spi_queue *queue;
+	uint32_t i, nb_msgs;
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	queue = desc->queue;
+	if (!queue || !queue->nb_msgs)
+		return 0;
+
+	/* Empty the queue first, no_os_spi_transfer() flushes it again. */
+	nb_msgs = queue->nb_msgs;
+	queue->nb_msgs = 0;
+	queue->buff_len = 0;
+
+	ret = no_os_spi_transfer(desc, queue->msgs, nb_msgs);
+	if (ret) {
+		if (!queue->err)
+			queue->err = ret;
+		return ret;
+	}
+
+	for (i = 0; i < nb_msgs; i++)
+		if (queue->rx_buffs[i])
+			memcpy(queue->rx_buffs[i], queue->msgs[i].rx_buff,
+			       queue->msgs[i].bytes_number);
+
+	return 0;
+}
+
+/**
+ * @brief Get the number of SPI messages sent so far, on all the buses.
+ *
+ * Each message (chip select frame) counts once, whether it was sent with
+ * no_os_spi_write_and_read() or as part of a no_os_spi_transfer() call, once
+ * the call succeeded. The counter is updated atomically, since the buses have
+ * a lock each, and wraps around, so compute differences between two readings.
+ * @return The number of SPI messages sent.
+ */
+uint32_t no_os_spi_get_xfer_count(void)
+{
+	return __atomic_load_n(&spi_xfer_count, __ATOMIC_RELAXED);
+}
@@ -51,173 +51,178 @@
 #include "axi_dmac.h"
 
 /*******************************************************************************
- * @brief ISR for dev to mem DMA transfer. It computes the next transfer params,
- *			if any, and sets the transfer structure fields accordingly.
+ * @brief Write the source and/or destination registers of a transfer,
+ *			depending on the direction of the DMAC.
  *
- * @param instance - the instance that triggered the ISR.
+ * @param dmac - DMAC istance.
+ * @param src_addr - Source address.
+ * @param dest_addr - Destination address.
+ * @param src_stride - Source stride.
+ * @param dest_stride - Destination stride.
  *
  * @return None.
 *******************************************************************************/
-void axi_dmac_dev_to_mem_isr(void *instance)
+static void axi_dmac_write_addr(struct axi_dmac *dmac, uint32_t src_addr,
+				uint32_t dest_addr, uint32_t src_stride,
+				uint32_t dest_stride)
 {
-	struct axi_dmac *dmac = (struct axi_dmac *)instance;
-	uint32_t burst_size;
-	uint32_t reg_val;
-
-	/* Get interrupt sources and clear interrupts. */
-	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
-
-	if (reg_val & AXI_DMAC_IRQ_SOT) {
-		if (dmac->remaining_size) {
-			/* See if remaining size is bigger than max transfer size and
-			 * set burst size. */
-			if (dmac->remaining_size > dmac->max_length) {
-				burst_size = dmac->max_length;
-			} else {
-				burst_size = dmac->remaining_size - 1;
-			}
-
-			/* The current transfer was started; set up the new one. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-
-			/* Compute size of the next transfer. */
-			dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
-			/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-
-			/* Trigger the next transfer. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
-		}
+	if (dmac->direction != DMA_MEM_TO_DEV) {
+		axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dest_addr);
+		axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, dest_stride);
 	}
-	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if (!dmac->remaining_size) {
-			dmac->transfer.transfer_done = true;
-			dmac->next_dest_addr = 0;
-		}
+	if (dmac->direction != DMA_DEV_TO_MEM) {
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, src_addr);
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, src_stride);
 	}
 }
 
 /*******************************************************************************
- * @brief ISR for mem DMA to dev transfer. It computes the next transfer params,
- *			if any, and sets the transfer structure fields accordingly.
+ * @brief Submit transfers from the segment list until the hardware queue is
+ *			full or all segments are submitted. 1D segments longer
+ *			than max_length are split in bursts. A 2D segment is
+ *			submitted at once.
  *
- * @param instance - the instance that triggered the ISR.
+ * @param dmac - DMAC istance.
  *
  * @return None.
 *******************************************************************************/
-void axi_dmac_mem_to_dev_isr(void *instance)
+static void axi_dmac_queue_fill(struct axi_dmac *dmac)
 {
-	struct axi_dmac *dmac = (struct axi_dmac *)instance;
-	uint32_t burst_size;
-	uint32_t reg_val;
-
-	/* Get interrupt sources and clear interrupts. */
-	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
-
-	if (reg_val & AXI_DMAC_IRQ_SOT) {
-		if ((dmac->transfer.cyclic == CYCLIC) &&
-		    (dmac->next_src_addr >= (dmac->init_addr + dmac->transfer.size - 1))) {
-			dmac->remaining_size = dmac->transfer.size;
-			dmac->next_src_addr = dmac->init_addr;
+	struct axi_dma_segment *seg;
+	uint32_t reg_val, burst_size, id;
+
+	while (dmac->queue_len < AXI_DMAC_QUEUE_MAX) {
+		if (dmac->next_seg == dmac->nb_segs) {
+			/* SW cyclic transfers restart from the first segment. */
+			if (dmac->transfer.cyclic != CYCLIC || dmac->hw_cyclic_en)
+				return;
+			dmac->next_seg = 0;
 		}
 
-		if (dmac->remaining_size) {
-			/** See if remaining size is bigger than max transfer size and
-			 * set burst size. */
-			if (dmac->remaining_size > dmac->max_length) {
-				burst_size = dmac->max_length;
-			} else {
-				burst_size = dmac->remaining_size - 1;
-			}
-
-			/* The current transfer was started; set up the new one. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
+		if (reg_val & AXI_DMAC_QUEUE_FULL)
+			return;
+
+		seg = &dmac->segs[dmac->next_seg];
+		if (seg->y_length > 1) {
+			axi_dmac_write_addr(dmac, seg->src_addr, seg->dest_addr,
+					    seg->src_stride, seg->dest_stride);
+			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, seg->x_length - 1);
+			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, seg->y_length - 1);
+			dmac->next_seg++;
+		} else {
+			/* The DMAC transfers X_LENGTH + 1 bytes. */
+			burst_size = no_os_min(seg->x_length - dmac->next_offset - 1,
+					       dmac->max_length);
+			axi_dmac_write_addr(dmac, seg->src_addr + dmac->next_offset,
+					    seg->dest_addr + dmac->next_offset, 0x0, 0x0);
 			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
 			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-
-			/* Compute parameters for the next transfer. */
-			dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
-			/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-
-			/* Trigger the current transfer */
-			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+			dmac->next_offset += burst_size + 1;
+			if (dmac->next_offset == seg->x_length) {
+				dmac->next_offset = 0;
+				dmac->next_seg++;
+			}
 		}
+
+		/* Keep the id in order to find out when the transfer is done. */
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_ID, &id);
+		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+		dmac->queue_ids[(dmac->queue_first + dmac->queue_len) %
+				AXI_DMAC_QUEUE_MAX] = id;
+		dmac->queue_len++;
 	}
-	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if ((!dmac->remaining_size) && (dmac->transfer.cyclic != CYCLIC)) {
-			dmac->transfer.transfer_done = true;
-			dmac->next_src_addr = 0;
-		}
+}
+
+/*******************************************************************************
+ * @brief Remove the done transfers from the queue.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_queue_retire(struct axi_dmac *dmac)
+{
+	uint32_t done;
+
+	/* Transfers complete in the order in which they were submitted. */
+	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_DONE, &done);
+	while (dmac->queue_len &&
+	       (done & NO_OS_BIT(dmac->queue_ids[dmac->queue_first]))) {
+		dmac->queue_first = (dmac->queue_first + 1) % AXI_DMAC_QUEUE_MAX;
+		dmac->queue_len--;
 	}
 }
 
 /*******************************************************************************
- * @brief ISR for mem DMA to mem DMA transfer. It computes the next transfer
- *			params, if any, and sets the transfer structure fields accordingly.
+ * @brief Handle the DMAC interrupt sources. Completed transfers are removed
+ *			from the queue, which is then filled again. Sets
+ *			dmac->transfer.transfer_done when all segments are done.
  *
- * @param instance - the instance that triggered the ISR.
+ * @param dmac - DMAC istance.
  *
  * @return None.
 *******************************************************************************/
-void axi_dmac_mem_to_mem_isr(void *instance)
+static void axi_dmac_process(struct axi_dmac *dmac)
 {
-	struct axi_dmac *dmac = (struct axi_dmac *)instance;
-	uint32_t burst_size;
 	uint32_t reg_val;
 
 	/* Get interrupt sources and clear interrupts. */
 	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
 	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
 
-	if (reg_val & AXI_DMAC_IRQ_SOT) {
-		if (dmac->remaining_size) {
-			/** See if remaining size is bigger than max transfer size and
-			 * set burst size. */
-			if (dmac->remaining_size > dmac->max_length) {
-				burst_size = dmac->max_length;
-			} else {
-				burst_size = dmac->remaining_size - 1;
-			}
+	if (reg_val & AXI_DMAC_IRQ_EOT)
+		axi_dmac_queue_retire(dmac);
 
-			/* The current transfer was started; set up the new one. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
+	/* A queue slot gets free on start of transfer, refill the queue. */
+	if (reg_val & (AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT))
+		axi_dmac_queue_fill(dmac);
 
-			/* Compute parameters for the next transfer. */
-			dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
-			/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
+	if (dmac->transfer.cyclic != CYCLIC && !dmac->queue_len &&
+	    dmac->next_seg == dmac->nb_segs)
+		dmac->transfer.transfer_done = true;
+}
 
-			/* If transfer finished advance src address so that transfer_done can be set*/
-			if (!dmac->remaining_size) {
-				dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			}
+/*******************************************************************************
+ * @brief ISR for dev to mem DMA transfer. It submits the next segments of the
+ *			transfer, if any, and sets the transfer structure fields
+ *			accordingly.
+ *
+ * @param instance - the instance that triggered the ISR.
+ *
+ * @return None.
+*******************************************************************************/
+void axi_dmac_dev_to_mem_isr(void *instance)
+{
+	axi_dmac_process((struct axi_dmac *)instance);
+}
 
-			/* Trigger the current transfer */
-			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
-		}
-	}
-	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if (!dmac->remaining_size) {
-			if(dmac->next_src_addr > (dmac->init_addr + dmac->transfer.size)) {
-				dmac->transfer.transfer_done = true;
-				dmac->next_src_addr = 0;
-				dmac->next_dest_addr = 0;
-			}
-		}
-	}
+/*******************************************************************************
+ * @brief ISR for mem DMA to dev transfer. It submits the next segments of the
+ *			transfer, if any, and sets the transfer structure fields
+ *			accordingly.
+ *
+ * @param instance - the instance that triggered the ISR.
+ *
+ * @return None.
+*******************************************************************************/
+void axi_dmac_mem_to_dev_isr(void *instance)
+{
+	axi_dmac_process((struct axi_dmac *)instance);
+}
+
+/*******************************************************************************
+ * @brief ISR for mem DMA to mem DMA transfer. It submits the next segments of
+ *			the transfer, if any, and sets the transfer structure fields
+ *			accordingly.
+ *
+ * @param instance - the instance that triggered the ISR.
+ *
+ * @return None.
+*******************************************************************************/
+void axi_dmac_mem_to_mem_isr(void *instance)
+{
+	axi_dmac_process((struct axi_dmac *)instance);
 }
 
 /*******************************************************************************
@@ -302,6 +307,12 @@ static int32_t axi_dmac_detect_caps(struct axi_dmac *dmac)
 	axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, dmac->max_length);
 	axi_dmac_read(dmac, AXI_DMAC_REG_X_LENGTH, &dmac->max_length);
 
+	/* Check if 2D transfers are possible */
+	axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 1);
+	axi_dmac_read(dmac, AXI_DMAC_REG_Y_LENGTH, &reg_val);
+	dmac->hw_2d = reg_val == 1;
+	axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0);
+
 	/* Get transfer direction and set value. */
 	axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, 0xffffffff);
 	axi_dmac_read(dmac, AXI_DMAC_REG_DEST_ADDRESS, &dest_mem_mapped);
@@ -369,60 +380,80 @@ int32_t axi_dmac_remove(struct axi_dmac *dmac)
 }
 
 /*******************************************************************************
- * @brief Start a DMA transfer.
+ * @brief Start a scatter-gather DMA transfer. As many transfers as the hardware
+ *			queue accepts are submitted, the rest are submitted from
+ *			the ISR (or from axi_dmac_transfer_wait_completion() when
+ *			IRQ is disabled) as soon as the queue has free slots.
  *
  * @param dmac - DMAC istance.
- * @param dma_transfer - Structure containing transfer details.
+ * @param segs - List of segments. Must be valid until the transfer is done
+ *		 (or stopped, for cyclic transfers).
+ * @param nb_segs - Number of segments.
+ * @param cyclic - Restart from the first segment when the list is done.
  *
- * @return 0 for success, -1 in case of failure.
+ * @return 0 for success, negative error code otherwise.
 *******************************************************************************/
-int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
-				struct axi_dma_transfer *dma_transfer)
+int32_t axi_dmac_transfer_sg_start(struct axi_dmac *dmac,
+				   struct axi_dma_segment *segs,
+				   uint32_t nb_segs,
+				   enum cyclic_transfer cyclic)
 {
-	uint32_t reg_val, burst_size;
-
-	if (dma_transfer->size == 0)
-		return 0; /* Nothing to do. */
+	uint32_t reg_val, i;
 
-	/* Set current transfer parameters. */
-	dmac->transfer.size = dma_transfer->size;
-	dmac->transfer.cyclic = dma_transfer->cyclic;
-	dmac->transfer.dest_addr = dma_transfer->dest_addr;
-	dmac->transfer.src_addr = dma_transfer->src_addr;
+	if (!dmac || !segs || !nb_segs)
+		return -EINVAL;
 
-	dmac->remaining_size = dma_transfer->size;
-	dmac->next_dest_addr = dma_transfer->dest_addr;
-	dmac->next_src_addr = dma_transfer->src_addr;
-
-	/* If HW cyclic transfer selected and not available, show error */
-	/* HW cyclic transfer available only for MEM to DEV transfers. */
-	if ((!dmac->hw_cyclic) && (dma_transfer->cyclic == CYCLIC)) {
-		printf("Transfer mode not supported!\n");
-		return -1;
+	/*
+	 * A cyclic transfer is replaced, a non cyclic one must be done. The
+	 * transfers of a cyclic one never complete, so the DMAC is disabled
+	 * to drop them and enabled again below.
+	 */
+	if (dmac->transfer.cyclic == CYCLIC && dmac->queue_len) {
+		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, 0x0);
+		dmac->queue_len = 0;
+	}
+	axi_dmac_queue_retire(dmac);
+	if (dmac->queue_len)
+		return -EBUSY;
+
+	for (i = 0; i < nb_segs; i++) {
+		if (!segs[i].x_length)
+			return -EINVAL;
+		if (segs[i].y_length > 1 &&
+		    (!dmac->hw_2d || segs[i].x_length - 1 > dmac->max_length))
+			return -EINVAL;
 	}
 
+	/* If HW cyclic transfer selected and not available, show error */
 	/* Cyclic transfers not possible for DEV_TO_MEM and MEM_TO_MEM transmissions. */
-	if ((dmac->direction == DMA_DEV_TO_MEM)
-	    || (dmac->direction == DMA_MEM_TO_MEM)) {
-		if (dma_transfer->cyclic == CYCLIC) {
-			printf("Transfer mode not supported!\n");
-			return -1;
-		}
+	if (cyclic == CYCLIC &&
+	    (!dmac->hw_cyclic || dmac->direction != DMA_MEM_TO_DEV)) {
+		printf("Transfer mode not supported!\n");
+		return -EINVAL;
 	}
 
-	/* Cyclic transfers set to HW or SW depending on size for MEM to DEV. */
-	if ((dmac->direction == DMA_MEM_TO_DEV) && (dmac->transfer.cyclic == CYCLIC)) {
-		if ((dmac->remaining_size - 1) <= dmac->max_length) {
-			if (dmac->hw_cyclic) {
-				axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
-				reg_val = reg_val | DMA_CYCLIC;
-				axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
-			}
-		} else {
-			axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
-			reg_val = reg_val & ~DMA_CYCLIC;
-			axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
-		}
+	dmac->segs = segs;
+	dmac->nb_segs = nb_segs;
+	dmac->next_seg = 0;
+	dmac->next_offset = 0;
+	dmac->queue_first = 0;
+	dmac->transfer.cyclic = cyclic;
+	dmac->transfer.transfer_done = false;
+
+	/*
+	 * Cyclic transfers are done by HW when a single submission is enough,
+	 * otherwise the segments are submitted again by SW.
+	 */
+	dmac->hw_cyclic_en = cyclic == CYCLIC && nb_segs == 1 &&
+			     (segs[0].y_length > 1 ||
+			      segs[0].x_length - 1 <= dmac->max_length);
+	if (dmac->direction == DMA_MEM_TO_DEV) {
+		axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
+		if (dmac->hw_cyclic_en)
+			reg_val |= DMA_CYCLIC;
+		else
+			reg_val &= ~DMA_CYCLIC;
+		axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
 	}
 
 	/* Enable DMA if not already enabled. */
@@ -433,65 +464,46 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
 	}
 
-	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
-	/* If we don't have a start of transfer then start compute
-	 * values and trigger next transfer. */
-	if (!(reg_val & AXI_DMAC_QUEUE_FULL)) {
-		switch (dmac->direction) {
-		case DMA_DEV_TO_MEM:
-			dmac->init_addr = dmac->next_dest_addr;
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			break;
-		case DMA_MEM_TO_DEV:
-			dmac->init_addr = dmac->next_src_addr;
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			break;
-		case DMA_MEM_TO_MEM:
-			dmac->init_addr = dmac->next_src_addr;
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			break;
-		default:
-			return -1; /* Other directions are not supported yet. */
-		}
+	/* Pre-submit as many transfers as the queue accepts. */
+	axi_dmac_queue_fill(dmac);
+	if (!dmac->queue_len)
+		return -EBUSY;
 
-		/* Compute the burst size. */
-		if (dmac->remaining_size > dmac->max_length) {
-			burst_size = dmac->max_length;
-		} else {
-			burst_size = dmac->remaining_size - 1;
-		}
+	return 0;
+}
 
-		/* Compute next address (src or dest, or both, depending on type of transfer). */
-		switch (dmac->direction) {
-		case DMA_DEV_TO_MEM:
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-			break;
-		case DMA_MEM_TO_DEV:
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			break;
-		case DMA_MEM_TO_MEM:
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			break;
-		default:
-			return -1;
-		}
+/*******************************************************************************
+ * @brief Start a DMA transfer.
+ *
+ * @param dmac - DMAC istance.
+ * @param dma_transfer - Structure containing transfer details.
+ *
+ * @return 0 for success, -1 in case of failure.
+*******************************************************************************/
+int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
+				struct axi_dma_transfer *dma_transfer)
+{
+	int32_t ret;
 
-		/* Compute remaining size. */
-		dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
+	if (dma_transfer->size == 0)
+		return 0; /* Nothing to do. */
 
-		/* Specify the length of the transfer and trigger transfer. */
-		axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-		axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
-	} else {
+	/* Set current transfer parameters. */
+	dmac->transfer.size = dma_transfer->size;
+	dmac->transfer.dest_addr = dma_transfer->dest_addr;
+	dmac->transfer.src_addr = dma_transfer->src_addr;
+
+	dmac->seg.src_addr = dma_transfer->src_addr;
+	dmac->seg.dest_addr = dma_transfer->dest_addr;
+	dmac->seg.x_length = dma_transfer->size;
+	dmac->seg.y_length = 0;
+	dmac->seg.src_stride = 0;
+	dmac->seg.dest_stride = 0;
+
+	ret = axi_dmac_transfer_sg_start(dmac, &dmac->seg, 1,
+					 dma_transfer->cyclic);
+	if (ret)
 		return -1;
-	}
 
 	return 0;
 }
@@ -508,7 +520,6 @@ int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms)
 {
 	uint32_t timeout = 0;
-	uint32_t reg_val = 0;
 
 	if (dmac->irq_option == IRQ_ENABLED) {
 		while (!dmac->transfer.transfer_done) {
@@ -520,15 +531,16 @@ int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 			}
 		}
 	} else if (dmac->irq_option == IRQ_DISABLED) {
-		axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-		while (reg_val != (AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT)) {
+		/* Poll the interrupt sources in order to submit the next segments. */
+		axi_dmac_process(dmac);
+		while (!dmac->transfer.transfer_done) {
 			timeout++;
 			no_os_mdelay(1);
 			if (timeout == timeout_ms) {
 				printf("Error transferring data using DMA.\n");
 				return -1;
 			}
-			axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
+			axi_dmac_process(dmac);
 		}
 	}
 
@@ -545,4 +557,9 @@ int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 void axi_dmac_transfer_stop(struct axi_dmac *dmac)
 {
 	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
+
+	/* Disabling the DMAC drops the queued transfers. */
+	dmac->transfer.cyclic = NO;
+	dmac->queue_len = 0;
+	dmac->next_seg = dmac->nb_segs;
 }
@@ -76,6 +76,9 @@
 #define AXI_DMAC_REG_SRC_STRIDE			0x424
 #define AXI_DMAC_REG_TRANSFER_DONE		0x428
 
+/* Transfer ids are 2 bits wide, so at most 4 transfers can be in flight */
+#define AXI_DMAC_QUEUE_MAX				4
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -111,19 +114,41 @@ struct axi_dma_transfer {
 	uint32_t dest_addr;
 };
 
+/* One element of a scatter-gather list */
+struct axi_dma_segment {
+	uint32_t src_addr;
+	uint32_t dest_addr;
+	/* Number of bytes (of a row, for 2D segments) */
+	uint32_t x_length;
+	/* Number of rows. 0 or 1 for 1D segments */
+	uint32_t y_length;
+	/* Distance in bytes between the start of two rows. Only for 2D */
+	uint32_t src_stride;
+	uint32_t dest_stride;
+};
+
 struct axi_dmac {
 	const char *name;
 	uint32_t base;
 	enum use_irq irq_option;
 	enum dma_direction direction;
 	bool hw_cyclic;
+	bool hw_2d;
 	uint32_t max_length;
 	volatile struct axi_dma_transfer transfer;
-	//Current sub-transfer properties
-	uint32_t init_addr;
-	uint32_t remaining_size;
-	uint32_t next_src_addr;
-	uint32_t next_dest_addr;
+	//Current transfer properties
+	struct axi_dma_segment *segs;
+	uint32_t nb_segs;
+	bool hw_cyclic_en;
+	//Segment used by axi_dmac_transfer_start
+	struct axi_dma_segment seg;
+	//Next segment to be submitted and offset in it
+	uint32_t next_seg;
+	uint32_t next_offset;
+	//Ids of the submitted transfers that are not done, oldest first
+	uint32_t queue_ids[AXI_DMAC_QUEUE_MAX];
+	uint32_t queue_first;
+	uint32_t queue_len;
 };
 
 struct axi_dmac_init {
@@ -149,6 +174,10 @@ int32_t axi_dmac_init(struct axi_dmac **adc_core,
 int32_t axi_dmac_remove(struct axi_dmac *dmac);
 int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 				struct axi_dma_transfer *dma_transfer);
+int32_t axi_dmac_transfer_sg_start(struct axi_dmac *dmac,
+				   struct axi_dma_segment *segs,
+				   uint32_t nb_segs,
+				   enum cyclic_transfer cyclic);
 int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms);
 void axi_dmac_transfer_stop(struct axi_dmac *dmac);
@@ -0,0 +1,168 @@
+/***************************************************************************//**
+ *   @file   axi_clkgen_clk.c
+ *   @brief  Analog Devices AXI CLKGEN clock.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "clk_axi_clkgen.h"
+#include "axi_clkgen_clk.h"
+
+/******************************************************************************/
+/************************** Functions Implementation **************************/
+/******************************************************************************/
+/**
+ * @brief Take the parent rate from the parent clock, if there is one.
+ */
+static int axi_clkgen_clk_sync_parent(struct no_os_clk_desc *desc)
+{
+	struct axi_clkgen *clkgen = desc->dev_desc;
+	uint64_t parent_rate;
+	int32_t ret;
+
+	if (!no_os_clk_get_parent(desc))
+		return 0;
+
+	ret = no_os_clk_get_parent_rate(desc, &parent_rate);
+	if (ret)
+		return ret;
+
+	clkgen->parent_rate = parent_rate;
+
+	return 0;
+}
+
+/**
+ * @brief axi_clkgen_clk_init
+ */
+static int axi_clkgen_clk_init(struct no_os_clk_desc **desc,
+			       const struct no_os_clk_init_param *init_param)
+{
+	if (!init_param->dev_desc)
+		return -EINVAL;
+
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->name = init_param->name;
+	(*desc)->hw_ch_num = init_param->hw_ch_num;
+	(*desc)->dev_desc = init_param->dev_desc;
+
+	return 0;
+}
+
+/**
+ * @brief axi_clkgen_clk_remove
+ */
+static int axi_clkgen_clk_remove(struct no_os_clk_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief axi_clkgen_clk_recalc_rate
+ */
+static int axi_clkgen_clk_recalc_rate(struct no_os_clk_desc *desc,
+				      uint64_t *rate)
+{
+	uint32_t val;
+	int32_t ret;
+
+	ret = axi_clkgen_clk_sync_parent(desc);
+	if (ret)
+		return ret;
+
+	ret = axi_clkgen_get_rate(desc->dev_desc, &val);
+	if (ret)
+		return ret;
+
+	*rate = val;
+
+	return 0;
+}
+
+/**
+ * @brief axi_clkgen_clk_round_rate
+ */
+static int axi_clkgen_clk_round_rate(struct no_os_clk_desc *desc,
+				     uint64_t rate, uint64_t *rounded_rate)
+{
+	uint32_t val;
+	int32_t ret;
+
+	ret = axi_clkgen_clk_sync_parent(desc);
+	if (ret)
+		return ret;
+
+	ret = axi_clkgen_round_rate(desc->dev_desc, rate, &val);
+	if (ret)
+		return ret;
+
+	*rounded_rate = val;
+
+	return 0;
+}
+
+/**
+ * @brief axi_clkgen_clk_set_rate
+ */
+static int axi_clkgen_clk_set_rate(struct no_os_clk_desc *desc, uint64_t rate)
+{
+	int32_t ret;
+
+	ret = axi_clkgen_clk_sync_parent(desc);
+	if (ret)
+		return ret;
+
+	return axi_clkgen_set_rate(desc->dev_desc, rate);
+}
+
+/**
+ * @brief axi_clkgen specific CLK platform ops structure
+ */
+const struct no_os_clk_platform_ops axi_clkgen_clk_ops = {
+	.init = &axi_clkgen_clk_init,
+	.clk_recalc_rate = &axi_clkgen_clk_recalc_rate,
+	.clk_round_rate = &axi_clkgen_clk_round_rate,
+	.clk_set_rate = &axi_clkgen_clk_set_rate,
+	.remove = &axi_clkgen_clk_remove
+};
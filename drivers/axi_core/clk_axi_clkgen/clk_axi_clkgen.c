@@ -519,6 +519,30 @@ int32_t axi_clkgen_get_rate(struct axi_clkgen *clkgen, uint32_t *rate)
 	return 0;
 }
 
+/**
+ * @brief axi_clkgen_round_rate
+ */
+int32_t axi_clkgen_round_rate(struct axi_clkgen *clkgen, uint32_t rate,
+			      uint32_t *rounded_rate)
+{
+	uint32_t d, m, dout;
+	uint64_t tmp;
+
+	if (clkgen->parent_rate == 0 || rate == 0)
+		return -EINVAL;
+
+	axi_clkgen_calc_params(clkgen, clkgen->parent_rate, rate, &d, &m, &dout);
+	if (d == 0 || dout == 0 || m == 0)
+		return -EINVAL;
+
+	tmp = (uint64_t)(clkgen->parent_rate / d) * m;
+	tmp = tmp / dout;
+
+	*rounded_rate = tmp > 0xffffffff ? 0xffffffff : (uint32_t)tmp;
+
+	return 0;
+}
+
 /**
  * @brief axi_clkgen_init
  */
@@ -64,6 +64,8 @@ struct axi_clkgen_init {
 /******************************************************************************/
 int32_t axi_clkgen_set_rate(struct axi_clkgen *clkgen, uint32_t rate);
 int32_t axi_clkgen_get_rate(struct axi_clkgen *clkgen, uint32_t *rate);
+int32_t axi_clkgen_round_rate(struct axi_clkgen *clkgen, uint32_t rate,
+			      uint32_t *rounded_rate);
 int32_t axi_clkgen_init(struct axi_clkgen **clk,
 			const struct axi_clkgen_init *init);
 int32_t axi_clkgen_remove(struct axi_clkgen *clkgen);
@@ -48,6 +48,8 @@
 #include <stdlib.h>
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_util.h"
 #include "iio.h"
 #include "iio_axi_adc.h"
 
@@ -341,45 +343,119 @@ int32_t iio_axi_adc_prepare_transfer(void *dev, uint32_t mask)
 }
 
 /**
- * @brief Update active channels
- * @param dev - Instance of the iio_axi_adc
- * @param buff - Buffer where to read samples
- * @param nb_samples - Number of samples
+ * @brief Start a DMA transfer in all the free blocks of the buffer.
+ * @param iio_adc - Instance of the iio_axi_adc
+ * @param buffer - IIO buffer
  * @return 0 in case of success or negative value otherwise.
  */
-int32_t	iio_axi_adc_read_dev(void *dev, void *buff, uint32_t nb_samples)
+static int32_t iio_axi_adc_start_blocks(struct iio_axi_adc_desc *iio_adc,
+					struct iio_buffer *buffer)
 {
-	struct iio_axi_adc_desc *iio_adc;
-	int ret, bytes;
+	void *block;
+	int32_t ret;
+	uint32_t i;
 
-	if (!dev)
-		return -1;
+	for (i = 0; i < NO_OS_ARRAY_SIZE(iio_adc->segs); i++) {
+		ret = iio_buffer_get_block(buffer, &block);
+		if (ret == -EAGAIN)
+			break;
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
 
-	iio_adc = (struct iio_axi_adc_desc *)dev;
-	bytes = nb_samples * no_os_hweight32(iio_adc->mask) * (STORAGE_BITS / 8);
-
-	struct axi_dma_transfer transfer = {
-		// Number of bytes to writen/read
-		.size = bytes,
-		// Transfer done flag
-		.transfer_done = 0,
-		// Signal transfer mode
-		.cyclic = NO,
-		// Address of data source
-		.src_addr = 0,
-		// Address of data destination
-		.dest_addr = (uintptr_t)buff
-	};
-	ret = axi_dmac_transfer_start(iio_adc->dmac, &transfer);
-	if (ret < 0)
+		iio_adc->segs[i] = (struct axi_dma_segment) {
+			.dest_addr = (uintptr_t)block,
+			.x_length = buffer->size,
+		};
+	}
+	if (!i)
+		return 0;
+
+	ret = axi_dmac_transfer_sg_start(iio_adc->dmac, iio_adc->segs, i, NO);
+	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
-	/* Wait until transfer finishes */
+
+	iio_adc->nb_blocks = i;
+
+	return 0;
+}
+
+/**
+ * @brief Wait for the blocks of the started DMA transfer and add them to the
+ * buffer.
+ * @param iio_adc - Instance of the iio_axi_adc
+ * @param buffer - IIO buffer
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_adc_complete_blocks(struct iio_axi_adc_desc *iio_adc,
+		struct iio_buffer *buffer)
+{
+	int32_t ret;
+	uint32_t i;
+
 	ret = axi_dmac_transfer_wait_completion(iio_adc->dmac, 500);
-	if(ret)
+	if (ret)
+		return ret;
+
+	for (i = 0; i < iio_adc->nb_blocks; i++) {
+		if (iio_adc->dcache_invalidate_range)
+			iio_adc->dcache_invalidate_range(iio_adc->segs[i].dest_addr,
+							 buffer->size);
+
+		ret = iio_buffer_block_done(buffer);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+	iio_adc->nb_blocks = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Fill the buffer with samples.
+ *
+ * The free blocks of the buffer are filled by one DMA transfer, which is
+ * started before returning so that the acquisition continues while the
+ * previous blocks are sent to the client. The next call collects them.
+ * @param dev_data - IIO device data
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_adc_submit(struct iio_device_data *dev_data)
+{
+	struct iio_axi_adc_desc *iio_adc = dev_data->dev;
+	struct iio_buffer *buffer = dev_data->buffer;
+	uint32_t size;
+	int32_t ret;
+
+	if (!iio_adc->nb_blocks) {
+		no_os_cb_size(buffer->buf, &size);
+		/* Data already acquired is read first */
+		if (size)
+			return iio_axi_adc_start_blocks(iio_adc, buffer);
+
+		ret = iio_axi_adc_start_blocks(iio_adc, buffer);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	ret = iio_axi_adc_complete_blocks(iio_adc, buffer);
+	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
-	if (iio_adc->dcache_invalidate_range)
-		iio_adc->dcache_invalidate_range((uintptr_t)buff, bytes);
+	return iio_axi_adc_start_blocks(iio_adc, buffer);
+}
+
+/**
+ * @brief Stop the acquisition when the buffer is closed.
+ * @param dev - Instance of the iio_axi_adc
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_adc_end_transfer(void *dev)
+{
+	struct iio_axi_adc_desc *iio_adc = dev;
+
+	axi_dmac_transfer_stop(iio_adc->dmac);
+	/* The blocks are dropped by iio when the buffer is closed */
+	iio_adc->nb_blocks = 0;
 
 	return 0;
 }
@@ -457,7 +533,10 @@ static int32_t iio_axi_adc_create_device_descriptor(
 	}
 
 	iio_device->pre_enable = iio_axi_adc_prepare_transfer;
-	iio_device->read_dev = iio_axi_adc_read_dev;
+	if (desc->dmac) {
+		iio_device->submit = iio_axi_adc_submit;
+		iio_device->post_disable = iio_axi_adc_end_transfer;
+	}
 
 	return 0;
 error:
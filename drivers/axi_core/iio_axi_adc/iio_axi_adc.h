@@ -44,7 +44,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
-#include "iio_types.h"
+#include "iio.h"
 #include "axi_adc_core.h"
 #include "axi_dmac.h"
 
@@ -63,6 +63,10 @@ struct iio_axi_adc_desc {
 	uint32_t mask;
 	/** dma device */
 	struct axi_dmac *dmac;
+	/** Blocks of the buffer being filled by the DMA transfer */
+	struct axi_dma_segment segs[IIO_MAX_BUFFERS_COUNT];
+	/** Number of blocks in segs */
+	uint32_t nb_blocks;
 	/** Invalidate cache memory function pointer */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
 	/** Custom implementation for get sampling frequency */
@@ -229,8 +229,14 @@ static const struct xilinx_xcvr_drp_ops adxcvr_drp_ops = {
 	.write = adxcvr_drp_write,
 };
 
-static unsigned long adxcvr_clk_recalc_rate(struct adxcvr *xcvr,
-		unsigned long parent_rate)
+/**
+ * @brief AXI ADXCVR Clock Recalculate Rate
+ * @param xcvr - The device structure.
+ * @param parent_rate - The reference clock rate (Hz).
+ * @return Returns the lane rate (kHz) read back from the transceiver.
+ */
+unsigned long adxcvr_clk_recalc_rate(struct adxcvr *xcvr,
+				     unsigned long parent_rate)
 {
 	unsigned int *rx_out_div;
 	unsigned int *tx_out_div;
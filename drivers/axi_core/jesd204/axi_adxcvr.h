@@ -147,6 +147,9 @@ int32_t adxcvr_init(struct adxcvr **ad_xcvr,
 		    const struct adxcvr_init *init);
 /** AXI ADXCVR Resources Deallocation */
 int32_t adxcvr_remove(struct adxcvr *xcvr);
+/** AXI ADXCVR Clock Recalculate Rate */
+unsigned long adxcvr_clk_recalc_rate(struct adxcvr *xcvr,
+				     unsigned long parent_rate);
 /** AXI ADXCVR Clock Set Rate */
 int adxcvr_clk_set_rate(struct adxcvr *xcvr,
 			unsigned long rate,
@@ -753,10 +753,8 @@ static int axi_jesd204_rx_jesd204_link_enable(struct jesd204_dev *jdev,
 #endif
 		axi_jesd204_rx_write(jesd, JESD204_RX_REG_LINK_DISABLE, 0x1);
 
-#if 0
-		if (__clk_is_enabled(jesd->lane_clk))
-			clk_disable_unprepare(jesd->lane_clk);
-#endif
+		if (no_os_clk_is_enabled(jesd->lane_clk->clk_desc))
+			no_os_clk_disable(jesd->lane_clk->clk_desc);
 
 		return JESD204_STATE_CHANGE_DONE;
 	default:
@@ -770,6 +768,11 @@ static int axi_jesd204_rx_jesd204_link_enable(struct jesd204_dev *jdev,
 		return ret;
 	}
 #endif
+	/* Enables are counted, drop the one held from a previous run so the
+	 * transceiver goes through reset again. */
+	if (no_os_clk_is_enabled(jesd->lane_clk->clk_desc))
+		no_os_clk_disable(jesd->lane_clk->clk_desc);
+
 	ret = no_os_clk_enable(jesd->lane_clk->clk_desc);
 	if (ret) {
 		pr_err("%s: Link%u enable lane clock failed (%d)\n",
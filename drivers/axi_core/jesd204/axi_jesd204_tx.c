@@ -622,6 +622,11 @@ static int axi_jesd204_tx_jesd204_link_setup(struct jesd204_dev *jdev,
 		return ret;
 	}
 
+	/* Enables are counted, drop the one held from a previous run so the
+	 * transceiver goes through reset again. */
+	if (no_os_clk_is_enabled(jesd->lane_clk->clk_desc))
+		no_os_clk_disable(jesd->lane_clk->clk_desc);
+
 	ret = no_os_clk_enable(jesd->lane_clk->clk_desc);
 	if (ret) {
 		pr_err("%s: Link%u enable lane clock failed (%d)\n",
@@ -43,6 +43,7 @@
 #include "no_os_error.h"
 #include "no_os_alloc.h"
 #include "no_os_clk.h"
+#include "no_os_util.h"
 #include "jesd204_clk.h"
 
 /******************************************************************************/
@@ -125,6 +126,77 @@ int32_t jesd204_clk_set_rate(struct jesd204_clk *clk, uint32_t chan,
 	return 0;
 }
 
+/**
+ * Get the lane rate from the transceiver configuration.
+ * @param clk - The clock structure.
+ * @param ref_rate_khz - The transceiver reference clock rate.
+ * @param rate - The lane rate in kHz.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t jesd204_clk_recalc_rate(struct jesd204_clk *clk, uint32_t ref_rate_khz,
+				uint32_t *rate)
+{
+	if (!clk->xcvr)
+		return -ENODEV;
+
+	*rate = adxcvr_clk_recalc_rate(clk->xcvr, ref_rate_khz * 1000);
+
+	return 0;
+}
+
+/**
+ * Check that the transceiver can run at the desired lane rate.
+ * @param clk - The clock structure.
+ * @param ref_rate_khz - The transceiver reference clock rate.
+ * @param rate - The desired lane rate in kHz.
+ * @param rounded_rate - The lane rate the transceiver will run at.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t jesd204_clk_round_rate(struct jesd204_clk *clk, uint32_t ref_rate_khz,
+			       uint32_t rate, uint32_t *rounded_rate)
+{
+	struct adxcvr *xcvr = clk->xcvr;
+	int ret;
+
+	if (!xcvr)
+		return -ENODEV;
+
+	if (xcvr->cpll_enable)
+		ret = xilinx_xcvr_calc_cpll_config(&xcvr->xlx_xcvr, ref_rate_khz,
+						   rate, NULL, NULL);
+	else
+		ret = xilinx_xcvr_calc_qpll_config(&xcvr->xlx_xcvr,
+						   xcvr->sys_clk_sel,
+						   ref_rate_khz, rate, NULL, NULL);
+	if (ret < 0)
+		return ret;
+
+	*rounded_rate = rate;
+
+	return 0;
+}
+
+/**
+ * @brief Get the transceiver reference clock rate.
+ *
+ * The rate of the parent clock takes precedence over the one the transceiver
+ * was initialized with.
+ *
+ * @param desc - The CLK descriptor.
+ *
+ * @return The reference clock rate in kHz.
+ */
+static uint32_t jesd204_no_os_clk_ref_rate(struct no_os_clk_desc *desc)
+{
+	struct jesd204_clk *clk = desc->dev_desc;
+	uint64_t parent_rate;
+
+	if (!no_os_clk_get_parent_rate(desc, &parent_rate))
+		return NO_OS_DIV_ROUND_CLOSEST_ULL(parent_rate, 1000);
+
+	return clk->xcvr ? clk->xcvr->ref_rate_khz : 0;
+}
+
 /**
  * @brief Initialize the CLK structure.
  *
@@ -222,9 +294,65 @@ static int jesd204_no_os_clk_disable(struct no_os_clk_desc *desc)
 static int jesd204_no_os_clk_set_rate(struct no_os_clk_desc *desc,
 				      uint64_t rate)
 {
+	struct jesd204_clk *clk = desc->dev_desc;
+
+	if (clk->xcvr && no_os_clk_get_parent(desc))
+		return adxcvr_clk_set_rate(clk->xcvr, rate,
+					   jesd204_no_os_clk_ref_rate(desc));
+
 	return jesd204_clk_set_rate(desc->dev_desc, 0, (uint32_t)rate);
 }
 
+/*
+ * @brief Get the lane rate.
+ *
+ * @param desc - The CLK descriptor.
+ * @param rate - The lane rate in kHz.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int jesd204_no_os_clk_recalc_rate(struct no_os_clk_desc *desc,
+		uint64_t *rate)
+{
+	uint32_t val;
+	int32_t ret;
+
+	ret = jesd204_clk_recalc_rate(desc->dev_desc,
+				      jesd204_no_os_clk_ref_rate(desc), &val);
+	if (ret)
+		return ret;
+
+	*rate = val;
+
+	return 0;
+}
+
+/*
+ * @brief Check the lane rate against the transceiver limits.
+ *
+ * @param desc - The CLK descriptor.
+ * @param rate - The desired lane rate in kHz.
+ * @param rounded_rate - The lane rate the transceiver will run at.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int jesd204_no_os_clk_round_rate(struct no_os_clk_desc *desc,
+					uint64_t rate, uint64_t *rounded_rate)
+{
+	uint32_t val;
+	int32_t ret;
+
+	ret = jesd204_clk_round_rate(desc->dev_desc,
+				     jesd204_no_os_clk_ref_rate(desc), rate,
+				     &val);
+	if (ret)
+		return ret;
+
+	*rounded_rate = val;
+
+	return 0;
+}
+
 /*
  * @brief jesd204 platform specific CLK platform ops structure
  */
@@ -233,5 +361,7 @@ const struct no_os_clk_platform_ops jesd204_clk_ops = {
 	.clk_enable = &jesd204_no_os_clk_enable,
 	.clk_disable = &jesd204_no_os_clk_disable,
 	.clk_set_rate = &jesd204_no_os_clk_set_rate,
+	.clk_recalc_rate = &jesd204_no_os_clk_recalc_rate,
+	.clk_round_rate = &jesd204_no_os_clk_round_rate,
 	.remove = &jesd204_no_os_clk_remove
 };
@@ -71,4 +71,10 @@ int32_t jesd204_clk_disable(struct jesd204_clk *clk);
 /* Change the frequency of the clock. */
 int32_t jesd204_clk_set_rate(struct jesd204_clk *clk, uint32_t chan,
 			     uint32_t rate);
+/* Get the lane rate from the transceiver configuration. */
+int32_t jesd204_clk_recalc_rate(struct jesd204_clk *clk, uint32_t ref_rate_khz,
+				uint32_t *rate);
+/* Check that the transceiver can run at the desired lane rate. */
+int32_t jesd204_clk_round_rate(struct jesd204_clk *clk, uint32_t ref_rate_khz,
+			       uint32_t rate, uint32_t *rounded_rate);
 #endif
@@ -44,6 +44,7 @@
 #include "no_os_util.h"
 #include "iio_dac_demo.h"
 #include "iio.h"
+#include "iio_scan.h"
 
 /**
  * @brief utility function for computing next upcoming channel
@@ -110,11 +111,10 @@ int get_dac_demo_attr(void *device, char *buf, uint32_t len,
 int32_t dac_submit_samples(struct iio_device_data *dev_data)
 {
 	struct dac_demo_desc *desc;
-	uint32_t k = 0;
+	struct iio_scan_layout layout;
+	void *ch_data[TOTAL_DAC_CHANNELS];
 	uint32_t ch = -1;
-	uint16_t data[TOTAL_DAC_CHANNELS] = {0};
 	int ret;
-	uint32_t i = 0;
 
 	if(!dev_data)
 		return -ENODEV;
@@ -124,23 +124,18 @@ int32_t dac_submit_samples(struct iio_device_data *dev_data)
 	if (!desc->loopback_buffers)
 		return -EINVAL;
 
-	for (i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
-	     i++) {
-		ret = iio_buffer_pop_scan(dev_data->buffer, data);
-		if (ret)
-			return ret;
-
-		while (get_next_ch_idx(desc->active_ch, ch, &ch)) {
-			uint16_t* ch_buffer = (uint16_t*)(desc->loopback_buffers +
-							  (ch * desc->loopback_buffer_len *
-							   sizeof(uint16_t) / sizeof(ch_buffer)));
-			ch_buffer[i] = data[k++];
-		}
+	ret = iio_scan_layout_init(&layout, dac_demo_iio_descriptor.channels,
+				   TOTAL_DAC_CHANNELS, desc->active_ch);
+	if (ret)
+		return ret;
 
-		k = 0;
-	}
+	while (get_next_ch_idx(desc->active_ch, ch, &ch))
+		ch_data[ch] = (uint16_t *)desc->loopback_buffers +
+			      ch * desc->loopback_buffer_len;
 
-	return 0;
+	return iio_buffer_pop_scans(dev_data->buffer, &layout, ch_data,
+				    dev_data->buffer->size /
+				    dev_data->buffer->bytes_per_scan);
 }
 
 /**
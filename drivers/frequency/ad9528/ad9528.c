@@ -44,6 +44,7 @@
 #include <stdio.h>
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_error.h"
 #include "ad9528.h"
 
 static bool ad9528_pll2_valid_calib_div(unsigned int div)
@@ -744,6 +745,43 @@ uint32_t ad9528_calc_out_div(uint32_t rate,
 	return div;
 }
 
+/***************************************************************************//**
+ * @brief Get the current channel rate from the device state.
+ *
+ * @param dev - is a pointer to the ad9528_dev data structure.
+ * @param chan - The output channel.
+ * @param rate - The channel rate in Hz.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ *******************************************************************************/
+int32_t ad9528_clk_recalc_rate(struct ad9528_dev *dev, uint32_t chan,
+			       uint64_t *rate)
+{
+	struct ad9528_channel_spec *channel;
+
+	if (chan >= dev->pdata->num_channels)
+		return -EINVAL;
+
+	channel = &dev->pdata->channels[chan];
+
+	switch (channel->signal_source) {
+	case AD9528_VCO:
+		if (!channel->channel_divider)
+			return -EINVAL;
+		*rate = dev->ad9528_st.vco_out_freq[AD9528_VCO] /
+			channel->channel_divider;
+		break;
+	case AD9528_SYSREF:
+	case AD9528_VCXO:
+		*rate = dev->ad9528_st.vco_out_freq[channel->signal_source];
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Calculate closest possible rate.
  *
@@ -916,3 +954,112 @@ int32_t ad9528_reset(struct ad9528_dev *dev)
 
 	return 0;
 }
+
+/***************************************************************************//**
+ * @brief Initialize the CLK structure.
+ *
+ * @param desc - The CLK descriptor.
+ * @param init_param - The structure holding the device initial parameters.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ *******************************************************************************/
+static int ad9528_no_os_clk_init(struct no_os_clk_desc **desc,
+				 const struct no_os_clk_init_param *init_param)
+{
+	struct ad9528_dev *dev = init_param->dev_desc;
+
+	if (!dev || init_param->hw_ch_num >= dev->pdata->num_channels)
+		return -EINVAL;
+
+	*desc = no_os_calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->name = init_param->name;
+	(*desc)->hw_ch_num = init_param->hw_ch_num;
+	(*desc)->dev_desc = dev;
+
+	/* SYSREF sourced channels share the K divider, a rate cached for one of
+	 * them goes stale when another one is set. */
+	if (dev->pdata->channels[init_param->hw_ch_num].signal_source ==
+	    AD9528_SYSREF)
+		(*desc)->flags = NO_OS_CLK_GET_RATE_NOCACHE;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Free the CLK structure, the ad9528 device is left untouched.
+ *
+ * @param desc - The CLK descriptor.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ *******************************************************************************/
+static int ad9528_no_os_clk_remove(struct no_os_clk_desc *desc)
+{
+	no_os_free(desc);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Get the current channel rate.
+ *
+ * @param desc - The CLK descriptor.
+ * @param rate - The channel rate in Hz.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ *******************************************************************************/
+static int ad9528_no_os_clk_recalc_rate(struct no_os_clk_desc *desc,
+					uint64_t *rate)
+{
+	return ad9528_clk_recalc_rate(desc->dev_desc, desc->hw_ch_num, rate);
+}
+
+/***************************************************************************//**
+ * @brief Round the desired rate to a rate the channel can output.
+ *
+ * @param desc - The CLK descriptor.
+ * @param rate - The desired rate in Hz.
+ * @param rounded_rate - The closest possible rate.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ *******************************************************************************/
+static int ad9528_no_os_clk_round_rate(struct no_os_clk_desc *desc,
+				       uint64_t rate, uint64_t *rounded_rate)
+{
+	uint32_t rounded;
+
+	rounded = ad9528_clk_round_rate(desc->dev_desc, desc->hw_ch_num, rate);
+	if (!rounded || rounded == (uint32_t)-1)
+		return -EINVAL;
+
+	*rounded_rate = rounded;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Set the channel rate.
+ *
+ * @param desc - The CLK descriptor.
+ * @param rate - The desired rate in Hz.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ *******************************************************************************/
+static int ad9528_no_os_clk_set_rate(struct no_os_clk_desc *desc,
+				     uint64_t rate)
+{
+	return ad9528_clk_set_rate(desc->dev_desc, desc->hw_ch_num, rate);
+}
+
+/**
+ * @brief ad9528 specific CLK platform ops structure
+ */
+const struct no_os_clk_platform_ops ad9528_clk_ops = {
+	.init = &ad9528_no_os_clk_init,
+	.clk_recalc_rate = &ad9528_no_os_clk_recalc_rate,
+	.clk_round_rate = &ad9528_no_os_clk_round_rate,
+	.clk_set_rate = &ad9528_no_os_clk_set_rate,
+	.remove = &ad9528_no_os_clk_remove
+};
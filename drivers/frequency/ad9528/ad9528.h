@@ -47,6 +47,7 @@
 #include "no_os_delay.h"
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
+#include "no_os_clk.h"
 
 /******************************************************************************/
 /****************************** AD9528 ****************************************/
@@ -496,6 +497,13 @@ struct ad9528_init_param {
 	struct ad9528_platform_data *pdata;
 };
 
+/**
+ * @brief ad9528 specific CLK platform ops structure. The descriptor takes the
+ * ad9528 device as dev_desc and the index in pdata->channels as hw_ch_num.
+ * SYSREF sourced channels share the K divider, so their rates are not cached.
+ */
+extern const struct no_os_clk_platform_ops ad9528_clk_ops;
+
 /* Helpers to avoid excess line breaks */
 #define AD_IFE(_pde, _a, _b) ((dev->pdata->_pde) ? _a : _b)
 #define AD_IF(_pde, _a) AD_IFE(_pde, _a, 0)
@@ -525,6 +533,8 @@ int32_t ad9528_poll(struct ad9528_dev *dev,
 		    uint32_t data);
 int32_t ad9528_io_update(struct ad9528_dev *dev);
 int32_t ad9528_sync(struct ad9528_dev *dev);
+int32_t ad9528_clk_recalc_rate(struct ad9528_dev *dev, uint32_t chan,
+			       uint64_t *rate);
 uint32_t ad9528_clk_round_rate(struct ad9528_dev *dev, uint32_t chan,
 			       uint32_t rate);
 int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
@@ -43,6 +43,8 @@
 /******************************************************************************/
 #include <malloc.h>
 #include <stdio.h>
+#include <string.h>
+#include <errno.h>
 #include "adf4350.h"
 #include "no_os_alloc.h"
 
@@ -64,7 +66,7 @@ int32_t adf4350_write(adf4350_dev *dev,
 	txData[2] = (data & 0x0000FF00) >> 8;
 	txData[3] = (data & 0x000000FF) >> 0;
 
-	return no_os_spi_write_and_read(dev->spi_desc, txData, 4);
+	return no_os_spi_queue_msg(dev->spi_desc, txData, NULL, 4);
 }
 
 /***************************************************************************//**
@@ -139,25 +141,31 @@ uint32_t gcd(uint32_t x, uint32_t y)
 }
 
 /***************************************************************************//**
- * @brief Sets the ADF4350 frequency.
+ * @brief Computes the register image of a frequency.
+ *
+ * The PLL parameters and the register values of the device structure are
+ * updated, the device registers are not written.
  *
  * @param dev - The device structure.
  * @param freq - The desired frequency value.
+ * @param hop - The computed image.
  *
- * @return calculatedFrequency - The actual frequency value that was set.
+ * @return Returns 0 in case of success or negative error code.
 *******************************************************************************/
-int64_t adf4350_set_freq(adf4350_dev *dev,
-			 uint64_t freq)
+static int32_t adf4350_hop_compute(adf4350_dev *dev,
+				   uint64_t freq,
+				   struct adf4350_hop *hop)
 {
 	uint64_t tmp;
 	uint32_t div_gcd, prescaler, chspc;
 	uint16_t mdiv, r_cnt = 0;
 	uint8_t band_sel_div;
-	int32_t ret;
 
 	if ((freq > ADF4350_MAX_OUT_FREQ) || (freq < ADF4350_MIN_OUT_FREQ))
 		return -1;
 
+	hop->freq = freq;
+
 	if (freq > ADF4350_MAX_FREQ_45_PRESC) {
 		prescaler = ADF4350_REG1_PRESCALER;
 		mdiv = 75;
@@ -256,10 +264,26 @@ int64_t adf4350_set_freq(adf4350_dev *dev,
 
 	dev->regs[ADF4350_REG5] = ADF4350_REG5_LD_PIN_MODE_DIGITAL | 0x00180000;
 
-	ret = adf4350_sync_config(dev);
-	if(ret < 0) {
-		return ret;
-	}
+	hop->fpfd = dev->fpfd;
+	hop->r0_int = dev->r0_int;
+	hop->r0_fract = dev->r0_fract;
+	hop->r1_mod = dev->r1_mod;
+	hop->r4_rf_div_sel = dev->r4_rf_div_sel;
+	memcpy(hop->regs, dev->regs, sizeof(hop->regs));
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Computes the frequency set by the current PLL parameters.
+ *
+ * @param dev - The device structure.
+ *
+ * @return The output frequency.
+*******************************************************************************/
+static int64_t adf4350_get_freq(adf4350_dev *dev)
+{
+	uint64_t tmp;
 
 	tmp = (uint64_t)((dev->r0_int * dev->r1_mod) +
 			 dev->r0_fract) * (uint64_t)dev->fpfd;
@@ -268,6 +292,113 @@ int64_t adf4350_set_freq(adf4350_dev *dev,
 	return tmp;
 }
 
+/***************************************************************************//**
+ * @brief Sets the ADF4350 frequency.
+ *
+ * @param dev - The device structure.
+ * @param freq - The desired frequency value.
+ *
+ * @return calculatedFrequency - The actual frequency value that was set.
+*******************************************************************************/
+int64_t adf4350_set_freq(adf4350_dev *dev,
+			 uint64_t freq)
+{
+	struct adf4350_hop hop;
+	int32_t ret;
+
+	ret = adf4350_hop_compute(dev, freq, &hop);
+	if (ret < 0)
+		return ret;
+
+	ret = adf4350_sync_config(dev);
+	if(ret < 0) {
+		return ret;
+	}
+
+	return adf4350_get_freq(dev);
+}
+
+/***************************************************************************//**
+ * @brief Computes the register images of a list of frequencies.
+ *
+ * The images are based on the current device settings, so the table must be
+ * computed again if settings other than the frequency are changed (e.g. the
+ * channel spacing or the power down state).
+ *
+ * @param dev - The device structure.
+ * @param freqs - The output frequencies.
+ * @param nb_freqs - Number of frequencies.
+ * @param table - Array of nb_freqs images, filled in the order of freqs.
+ *
+ * @return Returns 0 in case of success or negative error code.
+*******************************************************************************/
+int32_t adf4350_hop_table_init(adf4350_dev *dev,
+			       const uint64_t *freqs,
+			       uint32_t nb_freqs,
+			       struct adf4350_hop *table)
+{
+	adf4350_dev tmp_dev;
+	uint32_t i;
+	int32_t ret;
+
+	if (!dev || !freqs || !table)
+		return -EINVAL;
+
+	/* Keep the current configuration of the device structure */
+	tmp_dev = *dev;
+	for (i = 0; i < nb_freqs; i++) {
+		ret = adf4350_hop_compute(&tmp_dev, freqs[i], &table[i]);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Switches to a precomputed frequency.
+ *
+ * Only the registers that differ from the last written values are sent, as
+ * one SPI batch. Register 0 is also written if a double buffered register
+ * changed.
+ *
+ * @param dev - The device structure.
+ * @param hop - The register image, computed by adf4350_hop_table_init().
+ *
+ * @return Returns 0 in case of success or negative error code.
+*******************************************************************************/
+int32_t adf4350_hop(adf4350_dev *dev,
+		    const struct adf4350_hop *hop)
+{
+	int32_t ret, ret_end;
+
+	if (!dev || !hop)
+		return -EINVAL;
+
+	dev->fpfd = hop->fpfd;
+	dev->r0_int = hop->r0_int;
+	dev->r0_fract = hop->r0_fract;
+	dev->r1_mod = hop->r1_mod;
+	dev->r4_rf_div_sel = hop->r4_rf_div_sel;
+	memcpy(dev->regs, hop->regs, sizeof(dev->regs));
+
+	ret = no_os_spi_batch_begin(dev->spi_desc);
+	if (ret < 0)
+		return ret;
+
+	ret = adf4350_sync_config(dev);
+	ret_end = no_os_spi_batch_end(dev->spi_desc);
+	if (ret >= 0)
+		ret = ret_end;
+	if (ret < 0) {
+		/* The queued registers may not have been written */
+		memset(dev->regs_hw, 0xFF, sizeof(dev->regs_hw));
+		return ret;
+	}
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Initializes the ADF4350.
  *
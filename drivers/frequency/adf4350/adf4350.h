@@ -196,6 +196,17 @@ typedef struct {
 	uint32_t 	val;
 } adf4350_dev;
 
+/* Register image of one output frequency, see adf4350_hop_table_init(). */
+struct adf4350_hop {
+	uint64_t	freq;
+	uint32_t	fpfd;
+	uint32_t	r0_fract;
+	uint32_t	r0_int;
+	uint32_t	r1_mod;
+	uint32_t	r4_rf_div_sel;
+	uint32_t	regs[6];
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -205,6 +216,14 @@ int32_t adf4350_setup(adf4350_dev **device,
 /*! Writes 4 bytes of data to ADF4350. */
 int32_t adf4350_write(adf4350_dev *dev,
 		      uint32_t data);
+/*! Computes the register images of a list of frequencies. */
+int32_t adf4350_hop_table_init(adf4350_dev *dev,
+			       const uint64_t *freqs,
+			       uint32_t nb_freqs,
+			       struct adf4350_hop *table);
+/*! Switches to a precomputed frequency, writing only the changed registers. */
+int32_t adf4350_hop(adf4350_dev *dev,
+		    const struct adf4350_hop *hop);
 /*! Stores PLL 0 frequency in Hz. */
 int64_t adf4350_out_altvoltage0_frequency(adf4350_dev *dev,
 		int64_t Hz);
@@ -44,6 +44,7 @@
 #include <stdbool.h>
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 #include "no_os_error.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
@@ -247,7 +248,7 @@ static int32_t adf4371_write(struct adf4371_dev *dev,
 	buf[1] = cmd & 0xFF;
 	buf[2] = val;
 
-	return no_os_spi_write_and_read(dev->spi_desc, buf, NO_OS_ARRAY_SIZE(buf));
+	return no_os_spi_queue_msg(dev->spi_desc, buf, NULL, NO_OS_ARRAY_SIZE(buf));
 }
 
 /**
@@ -263,17 +264,20 @@ static int32_t adf4371_write_bulk(struct adf4371_dev *dev,
 				  uint8_t *val,
 				  uint8_t size)
 {
-	uint8_t buf[10];
+	uint8_t buf[12];
 	uint16_t cmd;
 	uint8_t i;
 
+	if (size > NO_OS_ARRAY_SIZE(buf) - 2)
+		return -EINVAL;
+
 	cmd = ADF4371_WRITE | ADF4371_ADDR(reg);
 	buf[0] = cmd >> 8;
 	buf[1] = cmd & 0xFF;
 	for (i = 0; i < size; i++)
 		buf[2 + i] = val[i];
 
-	return no_os_spi_write_and_read(dev->spi_desc, buf, 2 + size);
+	return no_os_spi_queue_msg(dev->spi_desc, buf, NULL, 2 + size);
 }
 
 /**
@@ -404,19 +408,23 @@ static void adf4371_pll_fract_n_compute(uint64_t vco,
 }
 
 /**
- * Set the output frequency for one channel.
+ * Compute the register image of an output frequency.
  * @param dev - The device structure.
  * @param freq - The output frequency.
  * @param channel - The selected channel.
+ * @param hop - The computed image.
  * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t adf4371_set_freq(struct adf4371_dev *dev,
-				uint64_t freq,
-				uint32_t channel)
+static int32_t adf4371_hop_compute(struct adf4371_dev *dev,
+				   uint64_t freq,
+				   uint32_t channel,
+				   struct adf4371_hop *hop)
 {
 	uint32_t cp_bleed;
-	uint8_t int_mode = 0;
-	int32_t ret;
+
+	hop->freq = freq;
+	hop->chan = channel;
+	hop->rf_div_sel = dev->rf_div_sel;
 
 	switch (channel) {
 	case ADF4371_CH_RF8:
@@ -424,11 +432,11 @@ static int32_t adf4371_set_freq(struct adf4371_dev *dev,
 		if (ADF4371_CHECK_RANGE(freq, OUT_RF8_FREQ))
 			return -1;
 
-		dev->rf_div_sel = 0;
+		hop->rf_div_sel = 0;
 
 		while (freq < ADF4371_MIN_VCO_FREQ) {
 			freq <<= 1;
-			dev->rf_div_sel++;
+			hop->rf_div_sel++;
 		}
 		break;
 	case ADF4371_CH_RF16:
@@ -449,59 +457,118 @@ static int32_t adf4371_set_freq(struct adf4371_dev *dev,
 		return -1;
 	}
 
-	adf4371_pll_fract_n_compute(freq, dev->fpfd, &dev->integer, &dev->fract1,
-				    &dev->fract2, &dev->mod2);
-
-	dev->buf[0] = dev->integer >> 8;
-	dev->buf[1] = 0x40; /* REG12 default */
-	dev->buf[2] = 0x00;
-	dev->buf[3] = dev->fract1 & 0xFF;
-	dev->buf[4] = dev->fract1 >> 8;
-	dev->buf[5] = dev->fract1 >> 16;
-	dev->buf[6] = ADF4371_FRAC2WORD_L(dev->fract2 & 0x7F) |
-		      ADF4371_FRAC1WORD(dev->fract1 >> 24);
-	dev->buf[7] = ADF4371_FRAC2WORD_H(dev->fract2 >> 7);
-	dev->buf[8] = dev->mod2 & 0xFF;
-	dev->buf[9] = ADF4371_MOD2WORD(dev->mod2 >> 8);
+	adf4371_pll_fract_n_compute(freq, dev->fpfd, &hop->integer, &hop->fract1,
+				    &hop->fract2, &hop->mod2);
+
+	hop->pll_regs[0] = hop->integer & 0xFF;
+	hop->pll_regs[1] = hop->integer >> 8;
+	hop->pll_regs[2] = 0x40; /* REG12 default */
+	hop->pll_regs[3] = 0x00;
+	hop->pll_regs[4] = hop->fract1 & 0xFF;
+	hop->pll_regs[5] = hop->fract1 >> 8;
+	hop->pll_regs[6] = hop->fract1 >> 16;
+	hop->pll_regs[7] = ADF4371_FRAC2WORD_L(hop->fract2 & 0x7F) |
+			   ADF4371_FRAC1WORD(hop->fract1 >> 24);
+	hop->pll_regs[8] = ADF4371_FRAC2WORD_H(hop->fract2 >> 7);
+	hop->pll_regs[9] = hop->mod2 & 0xFF;
+	hop->pll_regs[10] = ADF4371_MOD2WORD(hop->mod2 >> 8);
 
-	ret = adf4371_write_bulk(dev, ADF4371_REG(0x11), dev->buf, 10);
-	if (ret < 0)
-		return ret;
 	/*
 	 * The R counter allows the input reference frequency to be
 	 * divided down to produce the reference clock to the PFD
 	 */
-	ret = adf4371_write(dev, ADF4371_REG(0x1F), dev->ref_div_factor);
-	if (ret < 0)
-		return ret;
-
-	ret = adf4371_update(dev, ADF4371_REG(0x24),
-			     ADF4371_RF_DIV_SEL_MSK,
-			     ADF4371_RF_DIV_SEL(dev->rf_div_sel));
-	if (ret < 0)
-		return ret;
+	hop->ref_div = dev->ref_div_factor;
 
 	/*
 	 * The optimum bleed current is set by ((4/N) × ICP)/3.75,
 	 * where ICP is the charge pump current in μA
 	 */
-	cp_bleed = NO_OS_DIV_ROUND_UP(400 * dev->cp_settings.icp, dev->integer * 375);
-	cp_bleed = no_os_clamp(cp_bleed, 1U, 255U);
-	ret = adf4371_write(dev, ADF4371_REG(0x26), cp_bleed);
-	if (ret < 0)
-		return ret;
+	cp_bleed = NO_OS_DIV_ROUND_UP(400 * dev->cp_settings.icp, hop->integer * 375);
+	hop->cp_bleed = no_os_clamp(cp_bleed, 1U, 255U);
+
 	/*
 	 * Set to 1 when in INT mode (when FRAC1 = FRAC2 = 0),
 	 * and set to 0 when in FRAC mode.
 	 */
-	if (dev->fract1 == 0 && dev->fract2 == 0)
-		int_mode = 0x01;
+	hop->int_mode = (hop->fract1 == 0 && hop->fract2 == 0) ? 0x01 : 0x00;
+
+	return 0;
+}
+
+/**
+ * Make a register image the current configuration of the device structure.
+ * @param dev - The device structure.
+ * @param hop - The register image.
+ * @return None.
+ */
+static void adf4371_hop_apply(struct adf4371_dev *dev,
+			      const struct adf4371_hop *hop)
+{
+	dev->integer = hop->integer;
+	dev->fract1 = hop->fract1;
+	dev->fract2 = hop->fract2;
+	dev->mod2 = hop->mod2;
+	dev->rf_div_sel = hop->rf_div_sel;
+	dev->hop = *hop;
+}
 
-	ret = adf4371_write(dev, ADF4371_REG(0x2B), int_mode);
+/**
+ * Set the output frequency for one channel.
+ * @param dev - The device structure.
+ * @param freq - The output frequency.
+ * @param channel - The selected channel.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adf4371_set_freq(struct adf4371_dev *dev,
+				uint64_t freq,
+				uint32_t channel)
+{
+	struct adf4371_hop hop;
+	uint8_t reg24;
+	int32_t ret;
+
+	ret = adf4371_hop_compute(dev, freq, channel, &hop);
+	if (ret < 0)
+		return ret;
+
+	dev->hop_synced = false;
+	adf4371_hop_apply(dev, &hop);
+
+	memcpy(dev->buf, &hop.pll_regs[1], sizeof(dev->buf));
+	ret = adf4371_write_bulk(dev, ADF4371_REG(0x11), dev->buf, 10);
 	if (ret < 0)
 		return ret;
 
-	return adf4371_write(dev, ADF4371_REG(0x10), dev->integer & 0xFF);
+	ret = adf4371_write(dev, ADF4371_REG(0x1F), hop.ref_div);
+	if (ret < 0)
+		return ret;
+
+	ret = adf4371_read(dev, ADF4371_REG(0x24), &reg24);
+	if (ret < 0)
+		return ret;
+
+	reg24 &= ~ADF4371_RF_DIV_SEL_MSK;
+	reg24 |= ADF4371_RF_DIV_SEL(hop.rf_div_sel);
+	ret = adf4371_write(dev, ADF4371_REG(0x24), reg24);
+	if (ret < 0)
+		return ret;
+
+	ret = adf4371_write(dev, ADF4371_REG(0x26), hop.cp_bleed);
+	if (ret < 0)
+		return ret;
+
+	ret = adf4371_write(dev, ADF4371_REG(0x2B), hop.int_mode);
+	if (ret < 0)
+		return ret;
+
+	ret = adf4371_write(dev, ADF4371_REG(0x10), hop.pll_regs[0]);
+	if (ret < 0)
+		return ret;
+
+	dev->reg24 = reg24;
+	dev->hop_synced = true;
+
+	return 0;
 }
 
 /**
@@ -737,6 +804,140 @@ int32_t adf4371_clk_set_rate(struct adf4371_dev *dev, uint32_t chan,
 	return adf4371_set_freq(dev, rate, chan);
 }
 
+/**
+ * Compute the register images of a list of frequencies.
+ *
+ * The images are based on the current device configuration, so the table
+ * must be computed again if the reference or charge pump settings change.
+ * @param dev - The device structure.
+ * @param chan - The channel of all the frequencies.
+ * @param freqs - The output frequencies.
+ * @param nb_freqs - Number of frequencies.
+ * @param table - Array of nb_freqs images, filled in the order of freqs.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adf4371_hop_table_init(struct adf4371_dev *dev, uint32_t chan,
+			       const uint64_t *freqs, uint32_t nb_freqs,
+			       struct adf4371_hop *table)
+{
+	uint32_t i;
+	int32_t ret;
+
+	if (!dev || !freqs || !table || chan >= dev->num_channels)
+		return -EINVAL;
+
+	for (i = 0; i < nb_freqs; i++) {
+		ret = adf4371_hop_compute(dev, freqs[i], chan, &table[i]);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * Switch to a precomputed frequency.
+ *
+ * Only the registers that differ from the last written frequency are sent,
+ * as one SPI batch: the changed span of the registers 0x11 to 0x1A in a
+ * single streaming write, then the other changed registers and finally
+ * register 0x10, which starts the update. Nothing is written if the image is
+ * the current one.
+ * @param dev - The device structure.
+ * @param hop - The register image, computed by adf4371_hop_table_init().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adf4371_hop(struct adf4371_dev *dev, const struct adf4371_hop *hop)
+{
+	const struct adf4371_hop *cur;
+	uint32_t first, last;
+	bool update = false;
+	int32_t ret, ret_end;
+	uint8_t reg24;
+
+	if (!dev || !hop)
+		return -EINVAL;
+
+	if (!dev->hop_synced)
+		return adf4371_set_freq(dev, hop->freq, hop->chan);
+
+	cur = &dev->hop;
+	reg24 = (dev->reg24 & ~ADF4371_RF_DIV_SEL_MSK) |
+		ADF4371_RF_DIV_SEL(hop->rf_div_sel);
+
+	ret = no_os_spi_batch_begin(dev->spi_desc);
+	if (ret < 0)
+		return ret;
+
+	for (first = 1; first < ADF4371_HOP_PLL_REGS; first++)
+		if (hop->pll_regs[first] != cur->pll_regs[first])
+			break;
+	for (last = ADF4371_HOP_PLL_REGS - 1; last > first; last--)
+		if (hop->pll_regs[last] != cur->pll_regs[last])
+			break;
+
+	if (first < ADF4371_HOP_PLL_REGS) {
+		ret = adf4371_write_bulk(dev, ADF4371_REG(0x10) + first,
+					 (uint8_t *)&hop->pll_regs[first],
+					 last - first + 1);
+		if (ret < 0)
+			goto end;
+
+		update = true;
+	}
+
+	if (hop->ref_div != cur->ref_div) {
+		ret = adf4371_write(dev, ADF4371_REG(0x1F), hop->ref_div);
+		if (ret < 0)
+			goto end;
+
+		update = true;
+	}
+
+	if (reg24 != dev->reg24) {
+		ret = adf4371_write(dev, ADF4371_REG(0x24), reg24);
+		if (ret < 0)
+			goto end;
+
+		update = true;
+	}
+
+	if (hop->cp_bleed != cur->cp_bleed) {
+		ret = adf4371_write(dev, ADF4371_REG(0x26), hop->cp_bleed);
+		if (ret < 0)
+			goto end;
+
+		update = true;
+	}
+
+	if (hop->int_mode != cur->int_mode) {
+		ret = adf4371_write(dev, ADF4371_REG(0x2B), hop->int_mode);
+		if (ret < 0)
+			goto end;
+
+		update = true;
+	}
+
+	if (update || hop->pll_regs[0] != cur->pll_regs[0])
+		ret = adf4371_write(dev, ADF4371_REG(0x10), hop->pll_regs[0]);
+
+end:
+	ret_end = no_os_spi_batch_end(dev->spi_desc);
+	if (ret >= 0)
+		ret = ret_end;
+	if (ret < 0) {
+		/* Write all the registers on the next frequency change */
+		dev->hop_synced = false;
+
+		return ret;
+	}
+
+	dev->reg24 = reg24;
+	adf4371_hop_apply(dev, hop);
+
+	return 0;
+}
+
 /**
  * Initialize the device.
  * @param device - The device structure.
@@ -43,6 +43,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_spi.h"
 
 /******************************************************************************/
@@ -63,6 +64,24 @@ struct adf4371_chan_spec {
 	uint64_t	power_up_frequency;
 };
 
+/* Values of the registers 0x10 to 0x1A: INT, FRAC1, FRAC2 and MOD2 words */
+#define ADF4371_HOP_PLL_REGS	11
+
+/* Register image of one output frequency, see adf4371_hop_table_init() */
+struct adf4371_hop {
+	uint64_t	freq;
+	uint32_t	chan;
+	uint32_t	integer;
+	uint32_t	fract1;
+	uint32_t	fract2;
+	uint32_t	mod2;
+	uint32_t	rf_div_sel;
+	uint8_t		pll_regs[ADF4371_HOP_PLL_REGS];
+	uint8_t		ref_div;
+	uint8_t		cp_bleed;
+	uint8_t		int_mode;
+};
+
 struct adf4371_dev {
 	struct no_os_spi_desc	*spi_desc;
 	bool		spi_3wire_en;
@@ -84,6 +103,10 @@ struct adf4371_dev {
 	uint32_t	mod2;
 	uint32_t	rf_div_sel;
 	uint8_t		buf[10];
+	/* Last frequency written, valid if hop_synced */
+	struct adf4371_hop	hop;
+	uint8_t		reg24;
+	bool		hop_synced;
 };
 
 struct adf4371_init_param {
@@ -122,4 +145,12 @@ int32_t adf4371_clk_round_rate(struct adf4371_dev *dev, uint64_t rate,
 int32_t adf4371_clk_set_rate(struct adf4371_dev *dev, uint32_t chan,
 			     uint64_t rate);
 
+/* Compute the register images of a list of frequencies. */
+int32_t adf4371_hop_table_init(struct adf4371_dev *dev, uint32_t chan,
+			       const uint64_t *freqs, uint32_t nb_freqs,
+			       struct adf4371_hop *table);
+
+/* Switch to a precomputed frequency, writing only the changed registers. */
+int32_t adf4371_hop(struct adf4371_dev *dev, const struct adf4371_hop *hop);
+
 #endif
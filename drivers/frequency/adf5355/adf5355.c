@@ -42,6 +42,7 @@
 /******************************************************************************/
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
 #include "no_os_error.h"
 #include <malloc.h>
 #include "no_os_delay.h"
@@ -76,7 +77,7 @@ static int32_t adf5355_write(struct adf5355_dev *dev,
 	buf[2] = data >> 8;
 	buf[3] = data;
 
-	return no_os_spi_write_and_read(dev->spi_desc, buf, NO_OS_ARRAY_SIZE(buf));
+	return no_os_spi_queue_msg(dev->spi_desc, buf, NULL, NO_OS_ARRAY_SIZE(buf));
 }
 
 /**
@@ -185,15 +186,17 @@ static int32_t adf5355_reg_config(struct adf5355_dev *dev, bool sync_all)
 }
 
 /**
- * Set the output frequency for one channel.
+ * Compute the register image of an output frequency.
  * @param dev - The device structure.
  * @param freq - The output frequency.
  * @param chan - The selected channel.
+ * @param hop - The computed image, based on the current register values.
  * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t adf5355_set_freq(struct adf5355_dev *dev,
-				uint64_t freq,
-				uint8_t chan)
+static int32_t adf5355_hop_compute(struct adf5355_dev *dev,
+				   uint64_t freq,
+				   uint8_t chan,
+				   struct adf5355_hop *hop)
 {
 	uint32_t cp_bleed;
 	bool prescaler, cp_neg_bleed_en;
@@ -201,37 +204,35 @@ static int32_t adf5355_set_freq(struct adf5355_dev *dev,
 	if (chan > dev->num_channels)
 		return -1;
 
+	hop->freq = freq;
+	hop->chan = chan;
+	hop->rf_div_sel = 0;
+
 	if (chan == 0) {
 		if ((freq > dev->max_out_freq) || (freq < dev->min_out_freq))
 			return -EINVAL;
 
-		dev->rf_div_sel = 0;
-
-		dev->regs[ADF5355_REG(6)] = dev->regs[ADF5355_REG(6)] |
-					    ADF5355_REG6_RF_OUT_EN(dev->outa_en);
-
 		while (freq < dev->min_vco_freq) {
 			freq <<= 1;
-			dev->rf_div_sel++;
+			hop->rf_div_sel++;
 		}
 	} else {
 		/* ADF5355 RFoutB 6800...13600 MHz */
 		if ((freq > ADF5355_MAX_OUTB_FREQ) || (freq < ADF5355_MIN_OUTB_FREQ))
 			return -EINVAL;
 
-		dev->regs[ADF5355_REG(6)] = dev->regs[ADF5355_REG(6)] |
-					    ADF4355_REG6_RF_OUTB_EN(dev->outb_en);
+		hop->rf_div_sel = dev->rf_div_sel;
 
 		freq >>= 1;
 	}
 
-	adf5355_pll_fract_n_compute(freq, dev->fpfd, &dev->integer, &dev->fract1,
-				    &dev->fract2, &dev->mod2,
+	adf5355_pll_fract_n_compute(freq, dev->fpfd, &hop->integer, &hop->fract1,
+				    &hop->fract2, &hop->mod2,
 				    (dev->dev_id == ADF5356) ? ADF5356_MAX_MODULUS2 : ADF5355_MAX_MODULUS2);
 
-	prescaler = (dev->integer >= ADF5355_MIN_INT_PRESCALER_89);
+	prescaler = (hop->integer >= ADF5355_MIN_INT_PRESCALER_89);
 
-	if (dev->fpfd > 100000000UL || ((dev->fract1 == 0) && (dev->fract2 == 0)))
+	if (dev->fpfd > 100000000UL || ((hop->fract1 == 0) && (hop->fract2 == 0)))
 		cp_neg_bleed_en = false;
 	else
 		cp_neg_bleed_en = dev->cp_neg_bleed_en;
@@ -239,32 +240,34 @@ static int32_t adf5355_set_freq(struct adf5355_dev *dev,
 	if (dev->dev_id == ADF5356) {
 		cp_bleed = (24U * (dev->fpfd / 1000) * dev->cp_ua) / (61440 * 900);
 	} else {
-		cp_bleed = NO_OS_DIV_ROUND_UP(400 * dev->cp_ua, dev->integer * 375);
+		cp_bleed = NO_OS_DIV_ROUND_UP(400 * dev->cp_ua, hop->integer * 375);
 	}
 
 	cp_bleed = no_os_clamp(cp_bleed, 1U, 255U);
 
-	dev->regs[ADF5355_REG(0)] = ADF5355_REG0_INT(dev->integer) |
+	memcpy(hop->regs, dev->regs, sizeof(hop->regs));
+
+	hop->regs[ADF5355_REG(0)] = ADF5355_REG0_INT(hop->integer) |
 				    ADF5355_REG0_PRESCALER(prescaler) |
 				    ADF5355_REG0_AUTOCAL(1);
 
-	dev->regs[ADF5355_REG(1)] = ADF5355_REG1_FRACT(dev->fract1);
+	hop->regs[ADF5355_REG(1)] = ADF5355_REG1_FRACT(hop->fract1);
 
-	dev->regs[ADF5355_REG(2)] = ADF5355_REG2_MOD2(dev->mod2) |
-				    ADF5355_REG2_FRAC2(dev->fract2);
+	hop->regs[ADF5355_REG(2)] = ADF5355_REG2_MOD2(hop->mod2) |
+				    ADF5355_REG2_FRAC2(hop->fract2);
 
 	if (dev->dev_id == ADF5356)
-		dev->regs[ADF5355_REG(13)] = ADF5356_REG13_MOD2_MSB(dev->mod2 >> 14) |
-					     ADF5356_REG13_FRAC2_MSB(dev->fract2 >> 14);
+		hop->regs[ADF5355_REG(13)] = ADF5356_REG13_MOD2_MSB(hop->mod2 >> 14) |
+					     ADF5356_REG13_FRAC2_MSB(hop->fract2 >> 14);
 
-	dev->regs[ADF5355_REG(6)] = ADF5355_REG6_OUTPUT_PWR(dev->outa_power) |
+	hop->regs[ADF5355_REG(6)] = ADF5355_REG6_OUTPUT_PWR(dev->outa_power) |
 				    ADF5355_REG6_RF_OUT_EN(dev->outa_en) |
 				    (dev->dev_id == ADF5355 ? ADF5355_REG6_RF_OUTB_EN(!dev->outb_en) :
 				     ADF4355_REG6_OUTPUTB_PWR(dev->outb_power) |
 				     ADF4355_REG6_RF_OUTB_EN(dev->outb_en)) |
 				    ADF5355_REG6_MUTE_TILL_LOCK_EN(dev->mute_till_lock_en) |
 				    ADF5355_REG6_CP_BLEED_CURR(cp_bleed) |
-				    ADF5355_REG6_RF_DIV_SEL(dev->rf_div_sel) |
+				    ADF5355_REG6_RF_DIV_SEL(hop->rf_div_sel) |
 				    ADF5355_REG6_FEEDBACK_FUND(1) |
 				    ADF5355_REG6_NEG_BLEED_EN(cp_neg_bleed_en) |
 				    ADF5355_REG6_GATED_BLEED_EN(dev->cp_gated_bleed_en) |
@@ -272,7 +275,47 @@ static int32_t adf5355_set_freq(struct adf5355_dev *dev,
 						    dev->cp_bleed_current_polarity_en : 0) |
 				    ADF5355_REG6_DEFAULT;
 
-	dev->freq_req = freq;
+	return 0;
+}
+
+/**
+ * Make a register image the current configuration of the device structure.
+ * @param dev - The device structure.
+ * @param hop - The register image.
+ * @return None.
+ */
+static void adf5355_hop_apply(struct adf5355_dev *dev,
+			      const struct adf5355_hop *hop)
+{
+	memcpy(dev->regs, hop->regs, sizeof(dev->regs));
+	dev->integer = hop->integer;
+	dev->fract1 = hop->fract1;
+	dev->fract2 = hop->fract2;
+	dev->mod2 = hop->mod2;
+	dev->rf_div_sel = hop->rf_div_sel;
+	dev->freq_req = hop->freq;
+	dev->freq_req_chan = hop->chan;
+}
+
+/**
+ * Set the output frequency for one channel.
+ * @param dev - The device structure.
+ * @param freq - The output frequency.
+ * @param chan - The selected channel.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adf5355_set_freq(struct adf5355_dev *dev,
+				uint64_t freq,
+				uint8_t chan)
+{
+	struct adf5355_hop hop;
+	int32_t ret;
+
+	ret = adf5355_hop_compute(dev, freq, chan, &hop);
+	if (ret != 0)
+		return ret;
+
+	adf5355_hop_apply(dev, &hop);
 
 	return adf5355_reg_config(dev, dev->all_synced);
 }
@@ -351,6 +394,135 @@ int32_t adf5355_clk_round_rate(struct adf5355_dev *dev, uint64_t rate,
 	return 0;
 }
 
+/**
+ * Compute the register images of a list of frequencies.
+ *
+ * The images are based on the current device configuration, so the table
+ * must be computed again if settings other than the frequency are changed.
+ * @param dev - The device structure.
+ * @param chan - The channel of all the frequencies.
+ * @param freqs - The output frequencies.
+ * @param nb_freqs - Number of frequencies.
+ * @param table - Array of nb_freqs images, filled in the order of freqs.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adf5355_hop_table_init(struct adf5355_dev *dev, uint8_t chan,
+			       const uint64_t *freqs, uint32_t nb_freqs,
+			       struct adf5355_hop *table)
+{
+	uint32_t i;
+	int32_t ret;
+
+	if (!dev || !freqs || !table || chan >= dev->num_channels)
+		return -EINVAL;
+
+	for (i = 0; i < nb_freqs; i++) {
+		ret = adf5355_hop_compute(dev, freqs[i], chan, &table[i]);
+		if (ret != 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * Switch to a precomputed frequency.
+ *
+ * Only the registers that differ from the current configuration are written,
+ * in the order of the frequency update sequence, and sent as one SPI batch.
+ * When the VCO frequency changes, register 0 is written again with the
+ * autocalibration enabled after the ADC conversion delay. Otherwise, it is
+ * only written to load the double buffered fields.
+ * @param dev - The device structure.
+ * @param hop - The register image, computed by adf5355_hop_table_init().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adf5355_hop(struct adf5355_dev *dev, const struct adf5355_hop *hop)
+{
+	uint32_t max_reg, last_reg, i;
+	bool vco_cal, update = false;
+	int32_t ret, ret_end;
+
+	if (!dev || !hop)
+		return -EINVAL;
+
+	if (!dev->all_synced) {
+		adf5355_hop_apply(dev, hop);
+
+		return adf5355_reg_config(dev, true);
+	}
+
+	max_reg = (dev->dev_id == ADF5356) ? ADF5355_REG(13) : ADF5355_REG(12);
+
+	vco_cal = hop->regs[ADF5355_REG(0)] != dev->regs[ADF5355_REG(0)] ||
+		  hop->regs[ADF5355_REG(1)] != dev->regs[ADF5355_REG(1)] ||
+		  hop->regs[ADF5355_REG(2)] != dev->regs[ADF5355_REG(2)] ||
+		  hop->regs[ADF5355_REG(13)] != dev->regs[ADF5355_REG(13)];
+
+	ret = no_os_spi_batch_begin(dev->spi_desc);
+	if (ret != 0)
+		return ret;
+
+	/* With a VCO calibration, registers 4 to 1 follow the counter reset */
+	last_reg = vco_cal ? ADF5355_REG(5) : ADF5355_REG(3);
+	for (i = max_reg; i >= last_reg; i--) {
+		if (hop->regs[i] == dev->regs[i])
+			continue;
+
+		ret = adf5355_write(dev, ADF5355_REG(i), hop->regs[i]);
+		if (ret != 0)
+			goto end;
+
+		update = true;
+	}
+
+	if (vco_cal) {
+		ret = adf5355_write(dev, ADF5355_REG(4),
+				    hop->regs[ADF5355_REG(4)] | ADF5355_REG4_COUNTER_RESET_EN(1));
+		if (ret != 0)
+			goto end;
+
+		for (i = ADF5355_REG(3); i >= ADF5355_REG(1); i--) {
+			if (hop->regs[i] == dev->regs[i])
+				continue;
+
+			ret = adf5355_write(dev, ADF5355_REG(i), hop->regs[i]);
+			if (ret != 0)
+				goto end;
+		}
+	}
+
+	if (vco_cal || update) {
+		ret = adf5355_write(dev, ADF5355_REG(0),
+				    hop->regs[ADF5355_REG(0)] & ~ADF5355_REG0_AUTOCAL(1));
+		if (ret != 0)
+			goto end;
+	}
+
+	if (vco_cal)
+		ret = adf5355_write(dev, ADF5355_REG(4), hop->regs[ADF5355_REG(4)]);
+
+end:
+	ret_end = no_os_spi_batch_end(dev->spi_desc);
+	if (ret == 0)
+		ret = ret_end;
+	if (ret == 0 && vco_cal) {
+		no_os_udelay(dev->delay_us);
+
+		ret = adf5355_write(dev, ADF5355_REG(0), hop->regs[ADF5355_REG(0)]);
+	}
+	if (ret != 0) {
+		/* The device registers are unknown, rewrite all of them next time */
+		dev->all_synced = false;
+
+		return ret;
+	}
+
+	adf5355_hop_apply(dev, hop);
+
+	return 0;
+}
+
 /**
  * Setup the device.
  * @param dev - The device structure.
@@ -171,6 +171,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_spi.h"
 
 /******************************************************************************/
@@ -244,6 +245,28 @@ struct adf5355_dev {
 	uint32_t                    delay_us;
 };
 
+/**
+ * @struct adf5355_hop
+ * @brief Register image of one output frequency, computed by
+ * adf5355_hop_table_init(). The image depends on the device settings, so a
+ * table generated offline is only valid for a device with the same settings.
+ */
+struct adf5355_hop {
+	/** Output frequency in Hz */
+	uint64_t                    freq;
+	/** Output channel */
+	uint8_t                     chan;
+	/** RF divider select */
+	uint8_t                     rf_div_sel;
+	/** PLL parameters, restored by adf5355_hop() */
+	uint32_t                    integer;
+	uint32_t                    fract1;
+	uint32_t                    fract2;
+	uint32_t                    mod2;
+	/** Register values */
+	uint32_t                    regs[ADF5355_REG_NUM];
+};
+
 /**
  * @struct ad5355_init_param
  * @brief  Structure containing the initialization parameters.
@@ -287,6 +310,14 @@ int32_t adf5355_clk_set_rate(struct adf5355_dev *dev, uint32_t chan,
 int32_t adf5355_clk_round_rate(struct adf5355_dev *dev, uint64_t rate,
 			       uint64_t *rounded_rate);
 
+/* Compute the register images of a list of frequencies. */
+int32_t adf5355_hop_table_init(struct adf5355_dev *dev, uint8_t chan,
+			       const uint64_t *freqs, uint32_t nb_freqs,
+			       struct adf5355_hop *table);
+
+/* Switch to a precomputed frequency, writing only the changed registers. */
+int32_t adf5355_hop(struct adf5355_dev *dev, const struct adf5355_hop *hop);
+
 /* Initializes the ADF5355. */
 int32_t adf5355_init(struct adf5355_dev **device,
 		     const struct adf5355_init_param *init_param);
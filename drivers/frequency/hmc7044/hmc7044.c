@@ -1386,10 +1386,15 @@ static int hmc7044_jesd204_link_pre_setup(struct jesd204_dev *jdev,
 
 			hmc7044_clk_round_rate(hmc, hmc->jdev_lmfc_lemc_gcd, &rate);
 
-			if (rate == (long)hmc->jdev_lmfc_lemc_gcd)
-				ret = hmc7044_clk_set_rate(hmc, hmc->channels[i].num, hmc->jdev_lmfc_lemc_gcd);
-			else
+			/* Go through the clock tree when the channels are
+			 * exported so that the cached rates stay in sync. */
+			if (rate != (long)hmc->jdev_lmfc_lemc_gcd)
 				ret = -EINVAL;
+			else if (hmc->clk_desc)
+				ret = no_os_clk_set_rate(hmc->clk_desc[hmc->channels[i].num],
+							 hmc->jdev_lmfc_lemc_gcd);
+			else
+				ret = hmc7044_clk_set_rate(hmc, hmc->channels[i].num, hmc->jdev_lmfc_lemc_gcd);
 
 			if (ret < 0)
 				pr_err("%s: Link%u setting SYSREF rate %u failed (%d)\n",
@@ -1476,8 +1481,8 @@ int32_t hmc7044_init(struct hmc7044_dev **device,
 	struct hmc7044_dev *dev;
 	int32_t ret;
 	unsigned int i;
-	struct no_os_clk_desc **clocks;
-	struct no_os_clk_init_param clk_init;
+	struct no_os_clk_desc **clocks = NULL;
+	struct no_os_clk_init_param clk_init = { 0 };
 	const char *names[HMC7044_NUM_CHAN] = {
 		"clock_0", "clock_1", "clock_2", "clock_3", "clock_4",
 		"clock_5", "clock_6", "clock_7", "clock_8", "clock_9",
@@ -1731,11 +1736,41 @@ static int hmc7044_recalc_rate(struct no_os_clk_desc *desc, uint64_t *rate)
 				       rate);
 }
 
+/**
+ * @brief Round the desired rate to a rate the channel can output.
+ *
+ * @param desc - The CLK descriptor.
+ * @param rate - The desired rate.
+ * @param rounded_rate - The closest possible rate.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hmc7044_round_rate(struct no_os_clk_desc *desc, uint64_t rate,
+			      uint64_t *rounded_rate)
+{
+	return hmc7044_clk_round_rate(desc->dev_desc, rate, rounded_rate);
+}
+
+/**
+ * @brief Set the channel rate.
+ *
+ * @param desc - The CLK descriptor.
+ * @param rate - The desired rate.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hmc7044_set_rate(struct no_os_clk_desc *desc, uint64_t rate)
+{
+	return hmc7044_clk_set_rate(desc->dev_desc, desc->hw_ch_num, rate);
+}
+
 /**
  * @brief ad9523 platform specific CLK platform ops structure
  */
 const struct no_os_clk_platform_ops hmc7044_clk_ops = {
 	.init = &hmc7044_clk_init,
 	.clk_recalc_rate =&hmc7044_recalc_rate,
+	.clk_round_rate = &hmc7044_round_rate,
+	.clk_set_rate = &hmc7044_set_rate,
 	.remove = &hmc7044_clk_remove
 };
@@ -184,7 +184,17 @@ int ltc4306_write(struct ltc4306_dev *dev, uint8_t addr, uint8_t *write_data,
 int ltc4306_read(struct ltc4306_dev *dev, uint8_t addr, uint8_t *read_data,
 		 uint8_t bytes)
 {
-	int ret;
+	struct no_os_i2c_msg msgs[] = {
+		{
+			.buff = &addr,
+			.bytes_number = 1,
+		},
+		{
+			.buff = read_data,
+			.bytes_number = bytes,
+			.flags = NO_OS_I2C_M_RD,
+		},
+	};
 
 	/* Check if valid readable register */
 	if (addr < LTC4306_CTRL_REG0 || addr > LTC4306_CTRL_REG3)
@@ -194,11 +204,7 @@ int ltc4306_read(struct ltc4306_dev *dev, uint8_t addr, uint8_t *read_data,
 	if (addr + bytes > LTC4306_OUT_OF_BOUNDS)
 		return -EINVAL;
 
-	ret = no_os_i2c_write(dev->i2c_desc, &addr, 1, 0);
-	if (ret)
-		return ret;
-
-	return no_os_i2c_read(dev->i2c_desc, read_data, bytes, 1);
+	return no_os_i2c_transfer(dev->i2c_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
 }
 
 /***************************************************************************//**
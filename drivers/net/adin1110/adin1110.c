@@ -50,7 +50,7 @@
 
 #define ADIN1110_CRC_POLYNOMIAL	0x7
 
-NO_OS_DECLARE_CRC8_TABLE(_crc_table);
+NO_OS_DEFINE_CRC8_TABLE(_crc_table, ADIN1110_CRC_POLYNOMIAL);
 
 struct _adin1110_priv {
 	uint32_t phy_id;
@@ -68,91 +68,167 @@ static struct _adin1110_priv driver_data[2] = {
 	},
 };
 
+/* Padding of the frames shorter than 64 bytes, sent from here to avoid a copy */
+static uint8_t adin1110_zero_pad[64];
+
 /**
- * @brief Write a register's value
+ * @brief Send SPI messages and count the bytes on the bus.
+ * @param desc - the device descriptor
+ * @param msgs - the messages
+ * @param len - number of messages
+ * @return 0 in case of success, negative error code otherwise
+ */
+static int adin1110_spi_transfer(struct adin1110_desc *desc,
+				 struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		desc->stats.spi_bytes += msgs[i].bytes_number;
+	desc->stats.spi_transfers++;
+
+	return no_os_spi_transfer(desc->comm_desc, msgs, len);
+}
+
+/**
+ * @brief Forget the cached FIFO state, after a reset.
+ * @param desc - the device descriptor
+ */
+static void adin1110_drop_fifo_state(struct adin1110_desc *desc)
+{
+	desc->rx_fsize_valid = 0;
+	desc->tx_space = 0;
+}
+
+/**
+ * @brief Prepare the message of a register write.
  * @param desc - the device descriptor
+ * @param buff - data of the message, ADIN1110_WR_FRAME_SIZE + 2 bytes long
  * @param addr - register's address
  * @param data - register's value
- * @return 0 in case of success, negative error code otherwise
+ * @param xfer - the message
  */
-int adin1110_reg_write(struct adin1110_desc *desc, uint16_t addr, uint32_t data)
+static void adin1110_reg_write_msg(struct adin1110_desc *desc, uint8_t *buff,
+				   uint16_t addr, uint32_t data,
+				   struct no_os_spi_msg *xfer)
 {
 	uint32_t header_len = ADIN1110_WR_HDR_SIZE;
-	struct no_os_spi_msg xfer = {
-		.tx_buff = desc->data,
-		.bytes_number = ADIN1110_WR_FRAME_SIZE,
-		.cs_change = 1,
-	};
+
+	xfer->tx_buff = buff;
+	xfer->rx_buff = NULL;
+	xfer->bytes_number = ADIN1110_WR_FRAME_SIZE;
+	xfer->cs_change = 1;
 
 	addr &= ADIN1110_ADDR_MASK;
 	addr |= ADIN1110_CD_MASK | ADIN1110_RW_MASK;
-	no_os_put_unaligned_be16(addr, desc->data);
+	no_os_put_unaligned_be16(addr, buff);
 
 	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
+		buff[2] = no_os_crc8(_crc_table, buff, 2, 0);
 		header_len++;
-		xfer.bytes_number++;
+		xfer->bytes_number++;
 	}
 
-	no_os_put_unaligned_be32(data, &desc->data[header_len]);
+	no_os_put_unaligned_be32(data, &buff[header_len]);
 	if (desc->append_crc) {
-		desc->data[header_len + ADIN1110_REG_LEN] =
-			no_os_crc8(_crc_table, &desc->data[header_len], ADIN1110_REG_LEN, 0);
-		xfer.bytes_number++;
+		buff[header_len + ADIN1110_REG_LEN] =
+			no_os_crc8(_crc_table, &buff[header_len], ADIN1110_REG_LEN, 0);
+		xfer->bytes_number++;
 	}
-
-	return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
 }
 
 /**
- * @brief Read a register's value
+ * @brief Prepare the message of a register read.
  * @param desc - the device descriptor
+ * @param buff - data of the message, ADIN1110_RD_FRAME_SIZE + 2 bytes long
  * @param addr - register's address
- * @param data - register's value
- * @return 0 in case of success, negative error code otherwise
+ * @param xfer - the message
  */
-int adin1110_reg_read(struct adin1110_desc *desc, uint16_t addr, uint32_t *data)
+static void adin1110_reg_read_msg(struct adin1110_desc *desc, uint8_t *buff,
+				  uint16_t addr, struct no_os_spi_msg *xfer)
 {
-	uint8_t crc;
-	uint8_t recv_crc;
 	uint32_t header_len = ADIN1110_RD_HEADER_LEN;
-	struct no_os_spi_msg xfer = {
-		.tx_buff = desc->data,
-		.rx_buff = desc->data,
-		.bytes_number = ADIN1110_REG_LEN,
-		.cs_change = 1,
-	};
-	int ret;
 
-	no_os_put_unaligned_be16(addr, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD;
-	desc->data[2] = 0x0;
+	xfer->tx_buff = buff;
+	xfer->rx_buff = buff;
+	xfer->bytes_number = ADIN1110_REG_LEN;
+	xfer->cs_change = 1;
+
+	no_os_put_unaligned_be16(addr, &buff[0]);
+	buff[0] |= ADIN1110_SPI_CD;
+	buff[2] = 0x0;
 
 	if (desc->append_crc) {
-		xfer.bytes_number += ADIN1110_CRC_LEN;
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		desc->data[3] = 0x0;
+		xfer->bytes_number += ADIN1110_CRC_LEN;
+		buff[2] = no_os_crc8(_crc_table, buff, 2, 0);
+		buff[3] = 0x0;
 		header_len++;
 	}
 
-	xfer.bytes_number += header_len;
-	ret = no_os_spi_transfer(desc->comm_desc, &xfer, 1);
-	if (ret)
-		return ret;
+	xfer->bytes_number += header_len;
+}
 
-	if (desc->append_crc) {
-		crc = no_os_crc8(_crc_table, &desc->data[header_len], 4, 0);
-		recv_crc = desc->data[header_len + ADIN1110_REG_LEN];
+/**
+ * @brief Get the value from a register read message, once it was sent.
+ * @param desc - the device descriptor
+ * @param buff - data of the message
+ * @param data - register's value
+ * @return 0 in case of success, -EINVAL if the CRC doesn't match
+ */
+static int adin1110_reg_read_val(struct adin1110_desc *desc, uint8_t *buff,
+				 uint32_t *data)
+{
+	uint32_t header_len = ADIN1110_RD_HEADER_LEN;
+	uint8_t crc;
 
-		if (crc != recv_crc)
+	if (desc->append_crc) {
+		header_len++;
+		crc = no_os_crc8(_crc_table, &buff[header_len], 4, 0);
+		if (crc != buff[header_len + ADIN1110_REG_LEN])
 			return -EINVAL;
 	}
 
-	*data = no_os_get_unaligned_be32(&desc->data[header_len]);
+	*data = no_os_get_unaligned_be32(&buff[header_len]);
 
 	return 0;
 }
 
+/**
+ * @brief Write a register's value
+ * @param desc - the device descriptor
+ * @param addr - register's address
+ * @param data - register's value
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_reg_write(struct adin1110_desc *desc, uint16_t addr, uint32_t data)
+{
+	struct no_os_spi_msg xfer;
+
+	adin1110_reg_write_msg(desc, desc->data, addr, data, &xfer);
+
+	return adin1110_spi_transfer(desc, &xfer, 1);
+}
+
+/**
+ * @brief Read a register's value
+ * @param desc - the device descriptor
+ * @param addr - register's address
+ * @param data - register's value
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_reg_read(struct adin1110_desc *desc, uint16_t addr, uint32_t *data)
+{
+	struct no_os_spi_msg xfer;
+	int ret;
+
+	adin1110_reg_read_msg(desc, desc->data, addr, &xfer);
+	ret = adin1110_spi_transfer(desc, &xfer, 1);
+	if (ret)
+		return ret;
+
+	return adin1110_reg_read_val(desc, desc->data, data);
+}
+
 /**
  * @brief Update a register's value based on a mask
  * @param desc - the device descriptor
@@ -486,101 +562,200 @@ int adin1110_broadcast_filter(struct adin1110_desc *desc, bool enabled)
 }
 
 /**
- * @brief Write a frame to the TX FIFO.
+ * @brief Write a frame made of several fragments to the TX FIFO.
+ *
+ * The TX_FSIZE write, the header and the fragments are sent in a single SPI
+ * transfer, straight from the fragments. The free space of the TX FIFO is
+ * only read when the space left after the previous frames is not enough.
  * @param desc - the device descriptor
  * @param port - the port for the frame to be transmitted on.
- * @param eth_buff - the frame to be transmitted.
- * @return 0 in case of success, negative error code otherwise
+ * @param frags - the fragments of the frame, starting with the MAC header.
+ * @param nb_frags - number of fragments, at most ADIN1110_TX_MAX_FRAGS.
+ * @return 0 in case of success, -EAGAIN if the TX FIFO is full, negative error
+ * code otherwise
  */
-int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
-			struct adin1110_eth_buff *eth_buff)
+int adin1110_write_fifo_frags(struct adin1110_desc *desc, uint32_t port,
+			      const struct adin1110_frag *frags,
+			      uint32_t nb_frags)
 {
+	struct no_os_spi_msg xfer[ADIN1110_TX_MAX_FRAGS + 3] = {0};
 	uint32_t header_len = ADIN1110_WR_HEADER_LEN;
-	uint32_t frame_offset;
 	uint32_t padding = 0;
 	uint32_t padded_len;
 	uint32_t round_len;
-	uint32_t tx_space;
+	uint32_t len = 0;
+	uint32_t words;
+	uint32_t n = 0;
+	uint32_t i;
 	int ret;
 
-	struct no_os_spi_msg xfer = {
-		.tx_buff = desc->data,
-		.cs_change = 1,
-	};
-
-	if (port >= driver_data[desc->chip_type].num_ports)
+	if (port >= driver_data[desc->chip_type].num_ports || !nb_frags ||
+	    nb_frags > ADIN1110_TX_MAX_FRAGS)
 		return -EINVAL;
 
+	for (i = 0; i < nb_frags; i++)
+		len += frags[i].len;
+
 	/* The minimum frame length is 64 bytes */
-	if (eth_buff->len + ADIN1110_FCS_LEN < 64)
-		padding = 64 - (eth_buff->len + ADIN1110_FCS_LEN);
+	if (len + ADIN1110_FCS_LEN < 64)
+		padding = 64 - (len + ADIN1110_FCS_LEN);
 
-	padded_len = eth_buff->len + padding + ADIN1110_FRAME_HEADER_LEN;
+	padded_len = len + padding + ADIN1110_FRAME_HEADER_LEN;
 
 	/** Align the frame length to 4 bytes */
 	round_len = no_os_align(padded_len, 4);
 
-	ret = adin1110_reg_read(desc, ADIN1110_TX_SPACE_REG, &tx_space);
-	if (ret)
-		return ret;
-
 	/*
 	 * Check if there is enough space for the frame in the TX FIFO.
 	 * The tx_space value is expressed in 16 bit words.
 	 */
-	if (padded_len > 2 * (tx_space - ADIN1110_FRAME_HEADER_LEN))
-		return -EAGAIN;
+	words = NO_OS_DIV_ROUND_UP(padded_len, 2) + ADIN1110_FRAME_HEADER_LEN;
+	if (desc->tx_space < words) {
+		desc->stats.tx_space_reads++;
+		ret = adin1110_reg_read(desc, ADIN1110_TX_SPACE_REG, &desc->tx_space);
+		if (ret) {
+			desc->tx_space = 0;
+			return ret;
+		}
 
-	ret = adin1110_reg_write(desc, ADIN1110_TX_FSIZE_REG, padded_len);
-	if (ret)
-		return ret;
+		if (desc->tx_space < words)
+			return -EAGAIN;
+	}
 
-	no_os_put_unaligned_be16(ADIN1110_TX_REG, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD | ADIN1110_SPI_RW;
+	adin1110_reg_write_msg(desc, desc->reg_buff, ADIN1110_TX_FSIZE_REG,
+			       padded_len, &xfer[n++]);
+
+	no_os_put_unaligned_be16(ADIN1110_TX_REG, &desc->tx_hdr[0]);
+	desc->tx_hdr[0] |= ADIN1110_SPI_CD | ADIN1110_SPI_RW;
 
 	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
+		desc->tx_hdr[2] = no_os_crc8(_crc_table, desc->tx_hdr, 2, 0);
 		header_len++;
 	}
 
 	/* Set the port on which to send the frame */
-	no_os_put_unaligned_be16(port, &desc->data[header_len]);
-	xfer.bytes_number = round_len + header_len;
-	frame_offset = header_len + ADIN1110_FRAME_HEADER_LEN;
+	no_os_put_unaligned_be16(port, &desc->tx_hdr[header_len]);
+	xfer[n].tx_buff = desc->tx_hdr;
+	xfer[n++].bytes_number = header_len + ADIN1110_FRAME_HEADER_LEN;
+
+	for (i = 0; i < nb_frags; i++) {
+		if (!frags[i].len)
+			continue;
+
+		xfer[n].tx_buff = frags[i].data;
+		xfer[n++].bytes_number = frags[i].len;
+	}
+
+	if (round_len > len + ADIN1110_FRAME_HEADER_LEN) {
+		xfer[n].tx_buff = adin1110_zero_pad;
+		xfer[n++].bytes_number = round_len - len - ADIN1110_FRAME_HEADER_LEN;
+	}
+	xfer[n - 1].cs_change = 1;
+
+	ret = adin1110_spi_transfer(desc, xfer, n);
+	if (ret) {
+		desc->tx_space = 0;
+		return ret;
+	}
 
-	memcpy(&desc->data[frame_offset], (void *)&eth_buff->mac_dest[0],
-	       ADIN1110_ETH_HDR_LEN);
-	frame_offset += ADIN1110_ETH_HDR_LEN;
-	memcpy(&desc->data[frame_offset], eth_buff->payload,
-	       eth_buff->len - ADIN1110_ETH_HDR_LEN);
+	desc->tx_space -= words;
+	desc->stats.tx_frames++;
+	desc->stats.tx_bytes += len;
 
-	return no_os_spi_transfer(desc->comm_desc, &xfer, 1);
+	return 0;
 }
 
 /**
- * @brief Read a frame from the RX FIFO.
+ * @brief Write a frame to the TX FIFO.
+ * @param desc - the device descriptor
+ * @param port - the port for the frame to be transmitted on.
+ * @param eth_buff - the frame to be transmitted.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_write_fifo(struct adin1110_desc *desc, uint32_t port,
+			struct adin1110_eth_buff *eth_buff)
+{
+	struct adin1110_frag frags[2] = {
+		{
+			/* mac_dest, mac_source and ethertype are contiguous */
+			.data = eth_buff->mac_dest,
+			.len = ADIN1110_ETH_HDR_LEN,
+		},
+		{
+			.data = eth_buff->payload,
+			.len = eth_buff->len - ADIN1110_ETH_HDR_LEN,
+		},
+	};
+
+	return adin1110_write_fifo_frags(desc, port, frags, 2);
+}
+
+/**
+ * @brief Get the length of the next frame in the RX FIFO.
+ *
+ * After a frame is read, the size of the next one is read in the same SPI
+ * transfer and used here once, instead of reading the RX_FSIZE register.
  * @param desc - the device descriptor
  * @param port - the port from which the frame shall be received.
- * @param eth_buff - the frame to be received.
+ * @param len - length of the frame (without the frame header), 0 if the FIFO
+ * is empty.
  * @return 0 in case of success, negative error code otherwise
  */
-int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
-		       struct adin1110_eth_buff *eth_buff)
+int adin1110_rx_frame_len(struct adin1110_desc *desc, uint32_t port,
+			  uint32_t *len)
+{
+	uint32_t frame_size;
+	int ret;
+
+	if (port >= driver_data[desc->chip_type].num_ports)
+		return -EINVAL;
+
+	if (desc->rx_fsize_valid & NO_OS_BIT(port)) {
+		desc->rx_fsize_valid &= ~NO_OS_BIT(port);
+		frame_size = desc->rx_fsize[port];
+	} else {
+		ret = adin1110_reg_read(desc, port ? ADIN2111_RX_P2_FSIZE_REG :
+					ADIN1110_RX_FSIZE_REG, &frame_size);
+		if (ret)
+			return ret;
+	}
+
+	if (frame_size < ADIN1110_FRAME_HEADER_LEN + ADIN1110_FEC_LEN) {
+		*len = 0;
+		return 0;
+	}
+
+	*len = frame_size - ADIN1110_FRAME_HEADER_LEN;
+	if (ADIN1110_RX_BUFF_LEN(*len) > ADIN1110_BUFF_LEN)
+		return -EINVAL;
+
+	return 0;
+}
+
+/**
+ * @brief Read the next frame from the RX FIFO, in place.
+ *
+ * The frame is received at buff + ADIN1110_RX_HDR_ROOM, the bytes before it
+ * are used for the SPI header. The size of the following frame is read in the
+ * same SPI transfer.
+ * @param desc - the device descriptor
+ * @param port - the port from which the frame shall be received.
+ * @param buff - buffer of ADIN1110_RX_BUFF_LEN(len) bytes.
+ * @param len - length of the frame, from adin1110_rx_frame_len().
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_read_fifo_inplace(struct adin1110_desc *desc, uint32_t port,
+			       uint8_t *buff, uint32_t len)
 {
-	uint32_t field_offset = ADIN1110_RD_HEADER_LEN;
-	uint32_t payload_length;
+	uint32_t header_len = ADIN1110_RD_HEADER_LEN;
+	struct no_os_spi_msg xfer[3] = {0};
 	uint32_t fifo_fsize_reg;
-	uint32_t rounded_len;
 	uint32_t frame_size;
 	uint32_t fifo_reg;
-	struct no_os_spi_msg xfer = {
-		.tx_buff = desc->data,
-		.rx_buff = desc->data,
-		.cs_change = 1,
-	};
+	uint8_t *start;
 	int ret;
 
-	if (port >= driver_data[desc->chip_type].num_ports)
+	if (port >= driver_data[desc->chip_type].num_ports || !buff || !len)
 		return -EINVAL;
 
 	if (!port) {
@@ -591,43 +766,95 @@ int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
 		fifo_fsize_reg = ADIN2111_RX_P2_FSIZE_REG;
 	}
 
-	ret = adin1110_reg_read(desc, fifo_fsize_reg, &frame_size);
-	if (ret)
-		return ret;
-
-	if (frame_size < ADIN1110_FRAME_HEADER_LEN + ADIN1110_FEC_LEN)
-		return 0;
+	if (desc->append_crc)
+		header_len++;
 
-	memset(desc->data, 0, ADIN1110_BUFF_LEN);
-	no_os_put_unaligned_be16(fifo_reg, &desc->data[0]);
-	desc->data[0] |= ADIN1110_SPI_CD;
-	desc->data[2] = 0x0;
+	start = buff + ADIN1110_RX_HDR_ROOM - ADIN1110_FRAME_HEADER_LEN -
+		header_len;
+	no_os_put_unaligned_be16(fifo_reg, &start[0]);
+	start[0] |= ADIN1110_SPI_CD;
+	start[2] = 0x0;
 
 	if (desc->append_crc) {
-		desc->data[2] = no_os_crc8(_crc_table, desc->data, 2, 0);
-		desc->data[3] = 0x0;
-		field_offset++;
+		start[2] = no_os_crc8(_crc_table, start, 2, 0);
+		start[3] = 0x0;
 	}
 
 	/* Set the port from which to receive the frame */
-	no_os_put_unaligned_be16(port, &desc->data[field_offset]);
-	rounded_len = no_os_align(frame_size, 4);
+	no_os_put_unaligned_be16(port, &start[header_len]);
+	xfer[0].tx_buff = start;
+	xfer[0].rx_buff = start;
+	xfer[0].bytes_number = header_len + ADIN1110_FRAME_HEADER_LEN;
 
 	/* Can only read multiples of 4 bytes (the last bytes might be 0) */
-	xfer.bytes_number = rounded_len + field_offset;
-	field_offset += ADIN1110_FRAME_HEADER_LEN;
+	xfer[1].rx_buff = buff + ADIN1110_RX_HDR_ROOM;
+	xfer[1].bytes_number = no_os_align(len + ADIN1110_FRAME_HEADER_LEN, 4) -
+			       ADIN1110_FRAME_HEADER_LEN;
+	xfer[1].cs_change = 1;
+
+	adin1110_reg_read_msg(desc, desc->reg_buff, fifo_fsize_reg, &xfer[2]);
+
+	/** Burst read the whole frame and the size of the next one */
+	desc->rx_fsize_valid &= ~NO_OS_BIT(port);
+	ret = adin1110_spi_transfer(desc, xfer, 3);
+	if (ret)
+		return ret;
+
+	desc->stats.rx_frames++;
+	desc->stats.rx_bytes += len;
+
+	/* On a CRC error, the size is read again for the next frame */
+	if (!adin1110_reg_read_val(desc, desc->reg_buff, &frame_size)) {
+		desc->rx_fsize[port] = frame_size;
+		desc->rx_fsize_valid |= NO_OS_BIT(port);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Read a frame from the RX FIFO.
+ * @param desc - the device descriptor
+ * @param port - the port from which the frame shall be received.
+ * @param eth_buff - the frame to be received.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_read_fifo(struct adin1110_desc *desc, uint32_t port,
+		       struct adin1110_eth_buff *eth_buff)
+{
+	uint8_t *frame = &desc->data[ADIN1110_RX_HDR_ROOM];
+	uint32_t len;
+	int ret;
+
+	ret = adin1110_rx_frame_len(desc, port, &len);
+	if (ret || !len)
+		return ret;
 
-	/** Burst read the whole frame */
-	ret = no_os_spi_transfer(desc->comm_desc, &xfer, 1);
+	ret = adin1110_read_fifo_inplace(desc, port, desc->data, len);
 	if (ret)
 		return ret;
 
-	payload_length = frame_size - ADIN1110_FRAME_HEADER_LEN - ADIN1110_ETH_HDR_LEN;
-	memcpy((void *)&eth_buff->mac_dest[0], &desc->data[field_offset],
-	       ADIN1110_ETH_HDR_LEN);
-	field_offset += ADIN1110_ETH_HDR_LEN;
-	memcpy(eth_buff->payload, &desc->data[field_offset], payload_length);
-	eth_buff->len = frame_size - ADIN1110_FRAME_HEADER_LEN;
+	memcpy((void *)&eth_buff->mac_dest[0], frame, ADIN1110_ETH_HDR_LEN);
+	memcpy(eth_buff->payload, frame + ADIN1110_ETH_HDR_LEN,
+	       len - ADIN1110_ETH_HDR_LEN);
+	eth_buff->len = len;
+
+	return 0;
+}
+
+/**
+ * @brief Get the traffic counters.
+ * @param desc - the device descriptor
+ * @param stats - the counters
+ * @return 0 in case of success, negative error code otherwise
+ */
+int adin1110_get_stats(struct adin1110_desc *desc,
+		       struct adin1110_stats *stats)
+{
+	if (!desc || !stats)
+		return -EINVAL;
+
+	*stats = desc->stats;
 
 	return 0;
 }
@@ -642,6 +869,8 @@ int adin1110_mac_reset(struct adin1110_desc *desc)
 	uint32_t val;
 	int ret;
 
+	adin1110_drop_fifo_state(desc);
+
 	ret = adin1110_reg_write(desc, ADIN1110_SOFT_RST_REG, ADIN1110_SWRESET_KEY1);
 	if (ret)
 		return ret;
@@ -701,6 +930,8 @@ int adin1110_phy_reset(struct adin1110_desc *desc)
 	uint32_t expected_id;
 	int ret;
 
+	adin1110_drop_fifo_state(desc);
+
 	/* The timing values for the reset sequence are spcified in the datasheet */
 	ret = no_os_gpio_set_value(desc->reset_gpio, NO_OS_GPIO_LOW);
 	if (ret)
@@ -733,6 +964,8 @@ int adin1110_phy_reset(struct adin1110_desc *desc)
  */
 int adin1110_sw_reset(struct adin1110_desc *desc)
 {
+	adin1110_drop_fifo_state(desc);
+
 	return adin1110_reg_write(desc, ADIN1110_RESET_REG, 0x1);
 }
 
@@ -892,7 +1125,6 @@ int adin1110_init(struct adin1110_desc **desc,
 	if (ret)
 		goto free_rst_gpio;
 
-	no_os_crc8_populate_msb(_crc_table, ADIN1110_CRC_POLYNOMIAL);
 	strncpy((char *)descriptor->mac_address, (char *)param->mac_address,
 		ADIN1110_MAC_LEN);
 
@@ -185,6 +185,15 @@
 #define ADIN1110_CRC_LEN			1
 #define ADIN1110_FEC_LEN			4
 
+/* Bytes before the frame in a buffer read by adin1110_read_fifo_inplace() */
+#define ADIN1110_RX_HDR_ROOM			(ADIN1110_RD_HEADER_LEN + ADIN1110_CRC_LEN + \
+						 ADIN1110_FRAME_HEADER_LEN)
+/* Size of the buffer needed by adin1110_read_fifo_inplace() for a frame */
+#define ADIN1110_RX_BUFF_LEN(len)		(ADIN1110_RX_HDR_ROOM - ADIN1110_FRAME_HEADER_LEN + \
+						 no_os_align((len) + ADIN1110_FRAME_HEADER_LEN, 4))
+/* Maximum number of fragments of a frame written to the TX FIFO */
+#define ADIN1110_TX_MAX_FRAGS			8
+
 #define ADIN_MAC_MULTICAST_ADDR_SLOT		0
 #define ADIN_MAC_BROADCAST_ADDR_SLOT		1
 #define ADIN_MAC_P1_ADDR_SLOT			2
@@ -199,6 +208,26 @@ enum adin1110_chip_id {
 	ADIN2111,
 };
 
+/**
+ * @brief Traffic counters, used to measure the SPI overhead.
+ */
+struct adin1110_stats {
+	/** Frames read from the RX FIFOs */
+	uint32_t rx_frames;
+	/** Frames written to the TX FIFO */
+	uint32_t tx_frames;
+	/** Bytes of the frames read from the RX FIFOs */
+	uint64_t rx_bytes;
+	/** Bytes of the frames written to the TX FIFO */
+	uint64_t tx_bytes;
+	/** Bytes clocked on the SPI bus, headers and register accesses included */
+	uint64_t spi_bytes;
+	/** Number of SPI transfers (each may contain several messages) */
+	uint32_t spi_transfers;
+	/** Number of TX_SPACE register reads */
+	uint32_t tx_space_reads;
+};
+
 /**
  * @brief ADIN1110 device descriptor.
  */
@@ -209,6 +238,26 @@ struct adin1110_desc {
 	uint8_t data[ADIN1110_BUFF_LEN];
 	struct no_os_gpio_desc *reset_gpio;
 	bool append_crc;
+	/** Register access sent in the same SPI transfer as a frame */
+	uint8_t reg_buff[ADIN1110_RD_FRAME_SIZE + 2 * ADIN1110_CRC_LEN];
+	/** SPI and frame header of a frame written to the TX FIFO */
+	uint8_t tx_hdr[ADIN1110_WR_HEADER_LEN + ADIN1110_CRC_LEN +
+		       ADIN1110_FRAME_HEADER_LEN];
+	/** Size of the next RX frame of each port, read after the previous one */
+	uint32_t rx_fsize[ADIN2111_PORTS];
+	/** Ports for which rx_fsize is valid */
+	uint32_t rx_fsize_valid;
+	/** TX FIFO space known to be free (16 bit words) */
+	uint32_t tx_space;
+	struct adin1110_stats stats;
+};
+
+/**
+ * @brief Fragment of a frame written to the TX FIFO.
+ */
+struct adin1110_frag {
+	uint8_t *data;
+	uint32_t len;
 };
 
 /**
@@ -253,6 +302,20 @@ int adin1110_write_fifo(struct adin1110_desc *, uint32_t,
 int adin1110_read_fifo(struct adin1110_desc *, uint32_t,
 		       struct adin1110_eth_buff *);
 
+/* Write a frame made of several fragments to the TX FIFO, without copying it */
+int adin1110_write_fifo_frags(struct adin1110_desc *, uint32_t,
+			      const struct adin1110_frag *, uint32_t);
+
+/* Get the length of the next frame in the RX FIFO, 0 if there is none */
+int adin1110_rx_frame_len(struct adin1110_desc *, uint32_t, uint32_t *);
+
+/* Read the next frame to buff + ADIN1110_RX_HDR_ROOM, without copying it */
+int adin1110_read_fifo_inplace(struct adin1110_desc *, uint32_t, uint8_t *,
+			       uint32_t);
+
+/* Get the traffic counters */
+int adin1110_get_stats(struct adin1110_desc *, struct adin1110_stats *);
+
 /* Write a PHY register using clause 22 */
 int adin1110_mdio_write(struct adin1110_desc *, uint32_t, uint32_t, uint16_t);
 
@@ -160,7 +160,6 @@ static int32_t aducm3029_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 	uint32_t		errors;
 	uint32_t		to_read;
 	uint32_t		idx = 0;
-	int ret;
 
 	if (!desc || !data)
 		return -1;
@@ -172,12 +171,8 @@ static int32_t aducm3029_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 	}
 
 	if (desc->rx_fifo) {
-		for (idx = 0; idx < bytes_number; idx++) {
-			ret = lf256fifo_read(desc->rx_fifo, &data[idx]);
-			if (ret)
-				return idx ? idx : -EAGAIN;
-		}
-		return idx;
+		idx = lf256fifo_read_n(desc->rx_fifo, data, bytes_number);
+		return idx ? idx : -EAGAIN;
 	}
 
 	/* Wait until a previously aducm3029_uart_read_nonblocking ends */
@@ -406,7 +401,8 @@ static int32_t aducm3029_uart_init(struct no_os_uart_desc **desc,
 
 	// nonblocking uart_read
 	if(param->asynchronous_rx) {
-		ret = lf256fifo_init(&descriptor->rx_fifo);
+		ret = lf256fifo_init_size(&descriptor->rx_fifo,
+					  param->rx_fifo_size);
 		if (ret < 0)
 			goto failure;
 
@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
+#include <sys/alt_alarm.h>
 #include "no_os_delay.h"
 
 /******************************************************************************/
@@ -66,3 +67,22 @@ void no_os_mdelay(uint32_t msecs)
 {
 	usleep(msecs * 1000);
 }
+
+/**
+ * @brief Get current time.
+ * @return Current time structure from system start (seconds, microseconds).
+ */
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {0, 0};
+	uint32_t ticks = alt_nticks();
+	uint32_t rate = alt_ticks_per_second();
+
+	if (!rate)
+		return t;
+
+	t.s = ticks / rate;
+	t.us = (uint64_t)(ticks % rate) * 1000000 / rate;
+
+	return t;
+}
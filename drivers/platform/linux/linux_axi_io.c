@@ -40,153 +40,270 @@
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
+#include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/mman.h>
 #include "no_os_error.h"
 #include "no_os_axi_io.h"
+#include "linux_axi_io.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_axi_io_map
+ * @brief Register window mapped whole on first use and kept until
+ * linux_axi_io_unmap_all().
+ */
+struct linux_axi_io_map {
+	/** UIO index or base address used by the driver */
+	uint32_t base;
+	/** Start of the mapping */
+	void *addr;
+	/** Size of the mapping */
+	size_t size;
+	/** Offset of base inside the mapping (/dev/mem windows are page aligned) */
+	size_t skew;
+};
+
+/******************************************************************************/
+/************************ Variables Definitions *******************************/
+/******************************************************************************/
+
+static struct linux_axi_io_map axi_io_maps[LINUX_AXI_IO_MAX_MAPS];
+static uint32_t axi_io_nb_maps;
+/* Held for reading during the register accesses, so that the windows can't
+ * be unmapped under them. */
+static pthread_rwlock_t axi_io_lock = PTHREAD_RWLOCK_INITIALIZER;
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+#ifndef DEVMEM
 /**
- * @brief AXI IO through UIO read/write function.
+ * @brief Get the size of the first memory region of a UIO device.
  * @param base - UIO index (/dev/uioX).
- * @param offset - Address offset.
- * @param read - Location where read data will be stored.
- * @param write - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @return Size of the region, 0 if it can't be read from sysfs.
+ */
+static size_t uio_get_map_size(uint32_t base)
+{
+	char buf[64];
+	FILE *f;
+	unsigned long long size = 0;
+
+	sprintf(buf, "/sys/class/uio/uio%"PRIu32"/maps/map0/size", base);
+
+	f = fopen(buf, "r");
+	if (!f)
+		return 0;
+
+	if (fscanf(f, "%llx", &size) != 1)
+		size = 0;
+
+	fclose(f);
+
+	return size;
+}
+#endif
+
+/**
+ * @brief Map a whole register window: the UIO memory region, or
+ * LINUX_AXI_IO_DEVMEM_SIZE bytes from base for /dev/mem.
+ * @param map - Window to be mapped, base must be set.
+ * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t uio_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-			      uint32_t *write)
+static int32_t linux_axi_io_map_window(struct linux_axi_io_map *map)
 {
 	char buf[32];
-	int ret;
-	int uio_fd;
-	int32_t status = 0;
-	void *uio_addr;
+	int32_t ret;
+	size_t size;
+	off_t off;
+	void *addr;
+	int fd;
 
-	sprintf(buf, "/dev/uio%"PRIu32"", base);
+#ifdef DEVMEM
+	size_t page = sysconf(_SC_PAGESIZE);
 
-	uio_fd = open(buf, O_RDWR);
-	if (uio_fd < 0) {
+	sprintf(buf, "/dev/mem");
+	map->skew = map->base & (page - 1);
+	off = map->base - map->skew;
+	size = (map->skew + LINUX_AXI_IO_DEVMEM_SIZE + page - 1) & ~(page - 1);
+	fd = open(buf, O_RDWR | O_SYNC);
+#else
+	sprintf(buf, "/dev/uio%"PRIu32"", map->base);
+	map->skew = 0;
+	off = 0;
+	size = uio_get_map_size(map->base);
+	if (!size)
+		size = LINUX_AXI_IO_DEVMEM_SIZE;
+	fd = open(buf, O_RDWR);
+#endif
+	if (fd < 0) {
+		ret = -errno;
 		printf("%s: Can't open %s\n\r", __func__, buf);
-		return -1;
+		return ret;
 	}
 
-	uio_addr = mmap(NULL,
-			offset + sizeof(*read),
-			PROT_READ|PROT_WRITE,
-			MAP_SHARED,
-			uio_fd,
-			0);
-	if (uio_addr == MAP_FAILED) {
-		printf("%s: mmap() failed\n\r", __func__);
-		status = -1;
-		goto close;
+	addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, off);
+	if (addr == MAP_FAILED) {
+		ret = -errno;
+		close(fd);
+		printf("%s: mmap() of %s failed\n\r", __func__, buf);
+		return ret;
 	}
 
-	if (read)
-		*read = *(uint32_t *)((uintptr_t)uio_addr + offset);
-	if (write)
-		*(uint32_t *)((uintptr_t)uio_addr + offset) = *write;
+	/* The mapping stays valid after the descriptor is closed. */
+	close(fd);
 
-	ret = munmap(uio_addr, offset + sizeof(*read));
-	if (ret < 0) {
-		printf("%s: munmap() failed\n\r", __func__);
-		status = -1;
-	}
+	map->addr = addr;
+	map->size = size;
+
+	return 0;
+}
+
+/**
+ * @brief Find the window of a base. Called with axi_io_lock held.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @return The window, NULL if it is not mapped.
+ */
+static struct linux_axi_io_map *linux_axi_io_find(uint32_t base)
+{
+	uint32_t i;
+
+	for (i = 0; i < axi_io_nb_maps; i++)
+		if (axi_io_maps[i].base == base)
+			return &axi_io_maps[i];
 
-close:
-	ret = close(uio_fd);
-	if (ret < 0) {
-		printf("%s: Can't close %s\n\r", __func__, buf);
-		status = -1;
+	return NULL;
+}
+
+/**
+ * @brief Map the window of a base, if it isn't mapped yet.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_axi_io_map(uint32_t base)
+{
+	struct linux_axi_io_map *map;
+	int32_t ret = 0;
+
+	pthread_rwlock_wrlock(&axi_io_lock);
+
+	if (linux_axi_io_find(base))
+		goto unlock;
+
+	if (axi_io_nb_maps == LINUX_AXI_IO_MAX_MAPS) {
+		ret = -ENOMEM;
+		goto unlock;
 	}
 
-	return status;
+	map = &axi_io_maps[axi_io_nb_maps];
+	map->base = base;
+	ret = linux_axi_io_map_window(map);
+	if (!ret)
+		axi_io_nb_maps++;
+unlock:
+	pthread_rwlock_unlock(&axi_io_lock);
+
+	return ret;
 }
 
-#ifdef DEVMEM
 /**
- * @brief AXI IO through devmem read/write function.
- * @param base - Base address.
+ * @brief Read or write a register, mapping its window on first use.
+ * @param base - UIO index (/dev/uioX)/base address.
  * @param offset - Address offset.
- * @param read - Location where read data will be stored.
- * @param write - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @param data - Data to be written, or location where read data is stored.
+ * @param write - true to write the register, false to read it.
+ * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t devmem_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-				 uint32_t *write)
+static int32_t linux_axi_io_access(uint32_t base, uint32_t offset,
+				   uint32_t *data, bool write)
 {
-	char command[64];
-	char answer[64];
-	FILE *stream;
+	struct linux_axi_io_map *map;
+	volatile uint32_t *reg;
 	int32_t ret;
 
+	pthread_rwlock_rdlock(&axi_io_lock);
+
+	/* Loop in case the windows are unmapped right after being mapped. */
+	while (!(map = linux_axi_io_find(base))) {
+		pthread_rwlock_unlock(&axi_io_lock);
+		ret = linux_axi_io_map(base);
+		if (ret)
+			return ret;
+		pthread_rwlock_rdlock(&axi_io_lock);
+	}
+
+	if ((size_t)offset + sizeof(uint32_t) > map->size - map->skew) {
+		pthread_rwlock_unlock(&axi_io_lock);
+		return -EINVAL;
+	}
+
+	reg = (volatile uint32_t *)((uintptr_t)map->addr + map->skew + offset);
 	if (write)
-		ret = snprintf(command, sizeof(command),
-			       "busybox devmem 0x%x w 0x%x", base + offset, *write);
-	else if (read)
-		ret = snprintf(command, sizeof(command),
-			       "busybox devmem 0x%x", base + offset);
+		*reg = *data;
 	else
-		return -1;
+		*data = *reg;
 
-	if (ret < 0 || ret >= (int32_t) sizeof(command))
-		return -1;
+	pthread_rwlock_unlock(&axi_io_lock);
 
-	stream = popen(command, "r");
-	if (stream == NULL)
-		return -1;
+	return 0;
+}
 
-	if (!(fgets(answer, sizeof(answer), stream))) {
-		ret = -1;
-		goto close;
-	}
+/**
+ * @brief Unmap all the register windows.
+ *
+ * Windows are mapped on the first access and kept for the lifetime of the
+ * process. This releases them, after the accesses in progress complete.
+ * Later accesses map them again.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_axi_io_unmap_all(void)
+{
+	int32_t ret = 0;
+	uint32_t i;
+
+	pthread_rwlock_wrlock(&axi_io_lock);
 
-	if (read)
-		*read = strtol(answer, NULL, 0);
+	for (i = 0; i < axi_io_nb_maps; i++)
+		if (munmap(axi_io_maps[i].addr, axi_io_maps[i].size))
+			ret = -errno;
 
-	ret = 0;
-close:
-	pclose(stream);
+	axi_io_nb_maps = 0;
+
+	pthread_rwlock_unlock(&axi_io_lock);
 
 	return ret;
 }
-#endif //DEVMEM
+
 /**
  * @brief AXI IO through UIO/devmem read function.
  * @param base - UIO index (/dev/uioX)/base address.
  * @param offset - Address offset.
  * @param data - Location where read data will be stored.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
-#ifdef DEVMEM
-	return devmem_read_write(base, offset, data, NULL);
-#else
-	return uio_read_write(base, offset, data, NULL);
-#endif
+	return linux_axi_io_access(base, offset, data, false);
 }
 
 /**
- * @brief AXI IO through UIO specific write function.
- * @param base - UIO index (/dev/uioX).
+ * @brief AXI IO through UIO/devmem write function.
+ * @param base - UIO index (/dev/uioX)/base address.
  * @param offset - Address offset.
  * @param data - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
-#ifdef DEVMEM
-	return devmem_read_write(base, offset, NULL, &data);
-#else
-	return uio_read_write(base, offset, NULL, &data);
-#endif
+	return linux_axi_io_access(base, offset, &data, true);
 }
@@ -0,0 +1,150 @@
+/***************************************************************************//**
+ *   @file   linux/linux_circular_buffer.c
+ *   @brief  Circular buffers in double-mapped memory.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "linux_circular_buffer.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Create a circular buffer whose memory is mapped twice.
+ * @param desc - Where to store the circular buffer reference
+ * @param size - Minimum size of the buffer. desc->size holds the actual size.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t linux_cb_init_mirrored(struct no_os_circular_buffer **desc,
+			       uint32_t size)
+{
+	struct no_os_circular_buffer *ldesc;
+	long page_size;
+	uint8_t *addr;
+	int32_t ret;
+	int fd;
+
+	if (!desc || !size)
+		return -EINVAL;
+
+	page_size = sysconf(_SC_PAGESIZE);
+	if (page_size <= 0)
+		return -errno;
+
+	if (size > UINT32_MAX / 2 - page_size)
+		return -EINVAL;
+	size = NO_OS_DIV_ROUND_UP(size, page_size) * page_size;
+
+	ldesc = no_os_calloc(1, sizeof(*ldesc));
+	if (!ldesc)
+		return -ENOMEM;
+
+	fd = memfd_create("no_os_cb", MFD_CLOEXEC);
+	if (fd < 0) {
+		ret = -errno;
+		goto free_desc;
+	}
+
+	if (ftruncate(fd, size)) {
+		ret = -errno;
+		goto close_fd;
+	}
+
+	/* Reserve both halves, then map the file over each of them */
+	addr = mmap(NULL, 2 * (size_t)size, PROT_NONE,
+		    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (addr == MAP_FAILED) {
+		ret = -errno;
+		goto close_fd;
+	}
+
+	if (mmap(addr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+		 fd, 0) == MAP_FAILED ||
+	    mmap(addr + size, size, PROT_READ | PROT_WRITE,
+		 MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+		ret = -errno;
+		goto unmap;
+	}
+
+	/* The mappings keep the memory alive */
+	close(fd);
+
+	ret = no_os_cb_cfg_mirrored(ldesc, (int8_t *)addr, size);
+	if (ret) {
+		munmap(addr, 2 * (size_t)size);
+		goto free_desc;
+	}
+
+	*desc = ldesc;
+
+	return 0;
+unmap:
+	munmap(addr, 2 * (size_t)size);
+close_fd:
+	close(fd);
+free_desc:
+	no_os_free(ldesc);
+
+	return ret;
+}
+
+/**
+ * @brief Free a circular buffer created by linux_cb_init_mirrored().
+ * @param desc - Circular buffer reference
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t linux_cb_remove_mirrored(struct no_os_circular_buffer *desc)
+{
+	if (!desc || !desc->mirrored)
+		return -EINVAL;
+
+	if (munmap(desc->buff, 2 * (size_t)desc->size))
+		return -errno;
+
+	no_os_free(desc);
+
+	return 0;
+}
@@ -39,9 +39,35 @@
 #ifndef LINUX_GPIO_H_
 #define LINUX_GPIO_H_
 
+#include <stdint.h>
+#include "no_os_gpio.h"
+
+/* Number of GPIO chips that can be used through linux_gpio_cdev_ops. */
+#define LINUX_GPIO_MAX_CHIPS	8
+/* Number of lines that can be requested on a GPIO chip. */
+#define LINUX_GPIO_MAX_LINES	64
+
 /**
- * @brief Linux specific GPIO platform ops structure
+ * @brief Linux specific GPIO platform ops structure (sysfs, number is the
+ * global GPIO number)
  */
 extern const struct no_os_gpio_platform_ops linux_gpio_ops;
 
+/**
+ * @brief Linux GPIO character device platform ops structure. port is the
+ * index of the chip (/dev/gpiochipN) and number is the offset of the line.
+ */
+extern const struct no_os_gpio_platform_ops linux_gpio_cdev_ops;
+
+/* Enable (edge_flags != 0) or disable edge events on a line, used by the
+ * GPIO interrupt controller. fd gets the file descriptor of the events. */
+int32_t linux_gpio_cdev_set_edge(int32_t port, uint32_t offset,
+				 uint64_t edge_flags, int *fd);
+
+/* Get several lines of a chip with a single line request, so that their
+ * values are set and read with one ioctl. */
+int32_t linux_gpio_cdev_get_group(struct no_os_gpio_desc **desc,
+				  uint8_t nb_gpios,
+				  const struct no_os_gpio_init_param *param);
+
 #endif // LINUX_GPIO_H_
@@ -0,0 +1,985 @@
+/***************************************************************************//**
+ *   @file   linux/linux_gpio_cdev.c
+ *   @brief  Implementation of Linux GPIO through the GPIO character device.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_gpio.h"
+#include "no_os_util.h"
+#include "linux_gpio.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_gpio_line
+ * @brief Line of a GPIO chip requested by this process.
+ */
+struct linux_gpio_line {
+	/** Offset of the line in the chip */
+	uint32_t offset;
+	/** GPIO_V2_LINE_FLAG_* */
+	uint64_t flags;
+	/** Last value written while the line is an output */
+	uint8_t value;
+	/** Number of GPIO descriptors using the line */
+	uint32_t users;
+	/** The line is also used by the interrupt controller */
+	bool irq;
+	/** Line request file descriptor, shared by the lines requested together */
+	int req_fd;
+	/** Index of the line in its line request */
+	uint32_t req_idx;
+};
+
+/**
+ * @struct linux_gpio_chip
+ * @brief GPIO chip. Each line has its own line request, so adding or
+ * removing a line doesn't disturb the outputs and the events of the others,
+ * except the lines of linux_gpio_cdev_get_group() which share one request so
+ * that their values are set and read with a single ioctl.
+ */
+struct linux_gpio_chip {
+	/** Chip index (/dev/gpiochipN), -1 if the slot is free */
+	int32_t port;
+	/** Chip file descriptor */
+	int chip_fd;
+	/** Requested lines */
+	struct linux_gpio_line lines[LINUX_GPIO_MAX_LINES];
+	uint32_t nb_lines;
+};
+
+/******************************************************************************/
+/************************ Variables Definitions *******************************/
+/******************************************************************************/
+
+static struct linux_gpio_chip gpio_chips[LINUX_GPIO_MAX_CHIPS] = {
+	[0 ... LINUX_GPIO_MAX_CHIPS - 1] = {.port = -1, .chip_fd = -1}
+};
+/* Protects the chips and their line configuration. Values are read and
+ * written without it. */
+static pthread_mutex_t gpio_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Find a chip, opening it if needed.
+ * @param port - Chip index (/dev/gpiochipN).
+ * @param chip - Location where the chip will be stored.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_chip_get(int32_t port, struct linux_gpio_chip **chip)
+{
+	struct linux_gpio_chip *free_chip = NULL;
+	char path[32];
+	int32_t ret;
+	uint32_t i;
+
+	for (i = 0; i < LINUX_GPIO_MAX_CHIPS; i++) {
+		if (gpio_chips[i].port == port) {
+			*chip = &gpio_chips[i];
+			return 0;
+		}
+		if (!free_chip && gpio_chips[i].port < 0)
+			free_chip = &gpio_chips[i];
+	}
+
+	if (!free_chip)
+		return -ENOMEM;
+
+	sprintf(path, "/dev/gpiochip%"PRIi32"", port);
+	free_chip->chip_fd = open(path, O_RDWR | O_CLOEXEC);
+	if (free_chip->chip_fd < 0) {
+		ret = -errno;
+		printf("%s: Can't open %s\n\r", __func__, path);
+		return ret;
+	}
+
+	free_chip->port = port;
+	free_chip->nb_lines = 0;
+	*chip = free_chip;
+
+	return 0;
+}
+
+/**
+ * @brief Close a chip if it is no longer used.
+ * @param chip - The chip.
+ */
+static void linux_gpio_chip_put(struct linux_gpio_chip *chip)
+{
+	if (chip->nb_lines)
+		return;
+
+	close(chip->chip_fd);
+	chip->chip_fd = -1;
+	chip->port = -1;
+}
+
+/**
+ * @brief Find the index of a line in the requested lines of its chip.
+ * @param chip - The chip.
+ * @param offset - Offset of the line.
+ * @return Index of the line, -1 if it is not requested.
+ */
+static int32_t linux_gpio_line_find(struct linux_gpio_chip *chip,
+				    uint32_t offset)
+{
+	uint32_t i;
+
+	for (i = 0; i < chip->nb_lines; i++)
+		if (chip->lines[i].offset == offset)
+			return i;
+
+	return -1;
+}
+
+/**
+ * @brief Get the lines of a line request.
+ * @param chip - The chip.
+ * @param req_fd - Line request file descriptor.
+ * @param lines - Location where the lines are stored, in the request order.
+ * @return Number of lines of the request.
+ */
+static uint32_t linux_gpio_req_lines(struct linux_gpio_chip *chip, int req_fd,
+				     struct linux_gpio_line **lines)
+{
+	uint32_t i, nb_lines = 0;
+
+	for (i = 0; i < chip->nb_lines; i++) {
+		if (chip->lines[i].req_fd != req_fd)
+			continue;
+		lines[chip->lines[i].req_idx] = &chip->lines[i];
+		nb_lines++;
+	}
+
+	return nb_lines;
+}
+
+/**
+ * @brief Build the configuration of the lines of a request. The flags of the
+ * first line are the default ones, the lines with other flags get a flags
+ * attribute.
+ * @param lines - The lines, in the request order.
+ * @param nb_lines - Number of lines.
+ * @param config - Location where the configuration will be stored.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_build_config(struct linux_gpio_line **lines,
+				       uint32_t nb_lines,
+				       struct gpio_v2_line_config *config)
+{
+	struct gpio_v2_line_config_attribute *attr;
+	uint64_t done = 0, outputs = 0, values = 0;
+	uint32_t i, j;
+
+	memset(config, 0, sizeof(*config));
+	config->flags = lines[0]->flags;
+
+	for (i = 0; i < nb_lines; i++) {
+		if (lines[i]->flags & GPIO_V2_LINE_FLAG_OUTPUT) {
+			outputs |= NO_OS_BIT_ULL(i);
+			if (lines[i]->value)
+				values |= NO_OS_BIT_ULL(i);
+		}
+
+		if (lines[i]->flags == config->flags || (done & NO_OS_BIT_ULL(i)))
+			continue;
+
+		/* Keep one attribute for the output values */
+		if (config->num_attrs == GPIO_V2_LINE_NUM_ATTRS_MAX - 1)
+			return -E2BIG;
+
+		attr = &config->attrs[config->num_attrs++];
+		attr->attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+		attr->attr.flags = lines[i]->flags;
+		for (j = i; j < nb_lines; j++) {
+			if (lines[j]->flags != lines[i]->flags)
+				continue;
+			attr->mask |= NO_OS_BIT_ULL(j);
+			done |= NO_OS_BIT_ULL(j);
+		}
+	}
+
+	if (outputs) {
+		attr = &config->attrs[config->num_attrs++];
+		attr->attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+		attr->attr.values = values;
+		attr->mask = outputs;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Request lines from the kernel, with a single line request.
+ * @param chip - The chip.
+ * @param lines - The lines, in the request order.
+ * @param nb_lines - Number of lines.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_lines_request(struct linux_gpio_chip *chip,
+					struct linux_gpio_line **lines,
+					uint32_t nb_lines)
+{
+	struct gpio_v2_line_request req;
+	int32_t ret;
+	uint32_t i;
+
+	memset(&req, 0, sizeof(req));
+	ret = linux_gpio_build_config(lines, nb_lines, &req.config);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb_lines; i++)
+		req.offsets[i] = lines[i]->offset;
+	req.num_lines = nb_lines;
+	strncpy(req.consumer, "no-OS", sizeof(req.consumer) - 1);
+
+	if (ioctl(chip->chip_fd, GPIO_V2_GET_LINE_IOCTL, &req)) {
+		ret = -errno;
+		printf("%s: Can't request line %"PRIu32" of gpiochip%"PRIi32"\n\r",
+		       __func__, lines[0]->offset, chip->port);
+		return ret;
+	}
+
+	for (i = 0; i < nb_lines; i++) {
+		lines[i]->req_fd = req.fd;
+		lines[i]->req_idx = i;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Apply the flags and the output values of the line request of a line.
+ * @param chip - The chip.
+ * @param line - The line.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_line_config(struct linux_gpio_chip *chip,
+				      struct linux_gpio_line *line)
+{
+	struct linux_gpio_line *lines[LINUX_GPIO_MAX_LINES];
+	struct gpio_v2_line_config config;
+	uint32_t nb_lines;
+	int32_t ret;
+
+	nb_lines = linux_gpio_req_lines(chip, line->req_fd, lines);
+	ret = linux_gpio_build_config(lines, nb_lines, &config);
+	if (ret)
+		return ret;
+
+	if (ioctl(line->req_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config))
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Add a user of a line, requesting the line if it is the first one, or
+ * remove one, releasing the line with the last one.
+ * @param chip - The chip.
+ * @param offset - Offset of the line.
+ * @param flags - Initial flags of the line, when it is added.
+ * @param add - true to add a user of the line, false to remove one.
+ * @param irq - The user is the interrupt controller.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_line_use(struct linux_gpio_chip *chip,
+				   uint32_t offset, uint64_t flags, bool add,
+				   bool irq)
+{
+	struct linux_gpio_line *lines[LINUX_GPIO_MAX_LINES];
+	struct linux_gpio_line *line;
+	uint32_t i, j, nb_lines;
+	int32_t idx, ret;
+	int req_fd;
+
+	idx = linux_gpio_line_find(chip, offset);
+	if (add) {
+		if (idx >= 0) {
+			line = &chip->lines[idx];
+			if (irq)
+				line->irq = true;
+			else
+				line->users++;
+			return 0;
+		}
+
+		if (chip->nb_lines == LINUX_GPIO_MAX_LINES)
+			return -ENOMEM;
+
+		line = &chip->lines[chip->nb_lines];
+		line->offset = offset;
+		line->flags = flags;
+		line->value = 0;
+		line->users = irq ? 0 : 1;
+		line->irq = irq;
+
+		ret = linux_gpio_lines_request(chip, &line, 1);
+		if (ret)
+			return ret;
+
+		chip->nb_lines++;
+
+		return 0;
+	}
+
+	if (idx < 0)
+		return -ENOENT;
+
+	line = &chip->lines[idx];
+	if (irq)
+		line->irq = false;
+	else
+		line->users--;
+	if (line->users || line->irq)
+		return 0;
+
+	/* The lines requested together are released with the last one */
+	req_fd = line->req_fd;
+	nb_lines = linux_gpio_req_lines(chip, req_fd, lines);
+	for (i = 0; i < nb_lines; i++)
+		if (lines[i]->users || lines[i]->irq)
+			return 0;
+
+	close(req_fd);
+	for (i = 0, j = 0; i < chip->nb_lines; i++)
+		if (chip->lines[i].req_fd != req_fd)
+			chip->lines[j++] = chip->lines[i];
+	chip->nb_lines = j;
+
+	return 0;
+}
+
+/**
+ * @brief Get the initial flags of a line.
+ * @param pull - Pull of the line.
+ * @return GPIO_V2_LINE_FLAG_* of the line.
+ */
+static uint64_t linux_gpio_pull_flags(enum no_os_gpio_pull_up pull)
+{
+	/* Bias needs an explicit direction, start as an input. */
+	switch (pull) {
+	case NO_OS_PULL_UP:
+	case NO_OS_PULL_UP_WEAK:
+		return GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_UP;
+	case NO_OS_PULL_DOWN:
+	case NO_OS_PULL_DOWN_WEAK:
+		return GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Obtain the GPIO decriptor.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO initialization parameters
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_get(struct no_os_gpio_desc **desc,
+				   const struct no_os_gpio_init_param *param)
+{
+	struct no_os_gpio_desc *descriptor;
+	struct linux_gpio_chip *chip;
+	int32_t ret;
+
+	if (!desc || !param || param->number < 0)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	pthread_mutex_lock(&gpio_lock);
+
+	ret = linux_gpio_chip_get(param->port, &chip);
+	if (ret)
+		goto unlock;
+
+	ret = linux_gpio_line_use(chip, param->number,
+				  linux_gpio_pull_flags(param->pull), true, false);
+	if (ret) {
+		linux_gpio_chip_put(chip);
+		goto unlock;
+	}
+
+	pthread_mutex_unlock(&gpio_lock);
+
+	descriptor->port = param->port;
+	descriptor->number = param->number;
+	descriptor->pull = param->pull;
+	descriptor->extra = chip;
+	*desc = descriptor;
+
+	return 0;
+
+unlock:
+	pthread_mutex_unlock(&gpio_lock);
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Get an optional GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param param - GPIO Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_get_optional(struct no_os_gpio_desc **desc,
+		const struct no_os_gpio_init_param *param)
+{
+	if (!param || param->number < 0) {
+		*desc = NULL;
+		return 0;
+	}
+
+	return linux_gpio_cdev_get(desc, param);
+}
+
+/**
+ * @brief Free the resources allocated by no_os_gpio_get().
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_remove(struct no_os_gpio_desc *desc)
+{
+	struct linux_gpio_chip *chip;
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	chip = desc->extra;
+
+	pthread_mutex_lock(&gpio_lock);
+	ret = linux_gpio_line_use(chip, desc->number, 0, false, false);
+	linux_gpio_chip_put(chip);
+	pthread_mutex_unlock(&gpio_lock);
+
+	no_os_free(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Change the flags of a line.
+ * @param desc - The GPIO descriptor.
+ * @param set - Flags to be set.
+ * @param clear - Flags to be cleared.
+ * @param value - Output value, if the line becomes an output.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_set_flags(struct no_os_gpio_desc *desc,
+		uint64_t set, uint64_t clear,
+		uint8_t value)
+{
+	struct linux_gpio_chip *chip = desc->extra;
+	struct linux_gpio_line *line;
+	uint64_t old_flags;
+	int32_t idx, ret;
+
+	pthread_mutex_lock(&gpio_lock);
+
+	idx = linux_gpio_line_find(chip, desc->number);
+	if (idx < 0) {
+		ret = -ENOENT;
+		goto unlock;
+	}
+
+	line = &chip->lines[idx];
+	old_flags = line->flags;
+	line->flags = (line->flags & ~clear) | set;
+	line->value = value;
+
+	ret = linux_gpio_line_config(chip, line);
+	if (ret)
+		line->flags = old_flags;
+unlock:
+	pthread_mutex_unlock(&gpio_lock);
+
+	return ret;
+}
+
+/**
+ * @brief Enable the input direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_direction_input(struct no_os_gpio_desc *desc)
+{
+	return linux_gpio_cdev_set_flags(desc, GPIO_V2_LINE_FLAG_INPUT,
+					 GPIO_V2_LINE_FLAG_OUTPUT, 0);
+}
+
+/**
+ * @brief Enable the output direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_direction_output(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	/* Edge detection and bias are only valid for inputs. */
+	return linux_gpio_cdev_set_flags(desc, GPIO_V2_LINE_FLAG_OUTPUT,
+					 GPIO_V2_LINE_FLAG_INPUT |
+					 GPIO_V2_LINE_FLAG_EDGE_RISING |
+					 GPIO_V2_LINE_FLAG_EDGE_FALLING |
+					 GPIO_V2_LINE_FLAG_BIAS_PULL_UP |
+					 GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN,
+					 value);
+}
+
+/**
+ * @brief Get the direction of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param direction - The direction.
+ *                    Example: NO_OS_GPIO_OUT
+ *                             NO_OS_GPIO_IN
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_get_direction(struct no_os_gpio_desc *desc,
+		uint8_t *direction)
+{
+	struct linux_gpio_chip *chip = desc->extra;
+	struct gpio_v2_line_info info;
+	uint64_t flags = 0;
+	int32_t idx;
+
+	pthread_mutex_lock(&gpio_lock);
+	idx = linux_gpio_line_find(chip, desc->number);
+	if (idx >= 0)
+		flags = chip->lines[idx].flags;
+	pthread_mutex_unlock(&gpio_lock);
+
+	/* Direction left as-is at request time, ask the kernel. */
+	if (!(flags & (GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_OUTPUT))) {
+		memset(&info, 0, sizeof(info));
+		info.offset = desc->number;
+		if (ioctl(chip->chip_fd, GPIO_V2_GET_LINEINFO_IOCTL, &info))
+			return -errno;
+		flags = info.flags;
+	}
+
+	*direction = (flags & GPIO_V2_LINE_FLAG_OUTPUT) ? NO_OS_GPIO_OUT :
+		     NO_OS_GPIO_IN;
+
+	return 0;
+}
+
+/**
+ * @brief Sort the lines of several GPIOs by line request.
+ * @param desc - Array of GPIO descriptors, NULL entries are ignored.
+ * @param nb_gpios - Number of descriptors in the array.
+ * @param fds - Location where the line request file descriptors are stored.
+ * @param vals - Location where the mask of the lines of each request is stored.
+ * @param reqs - Location where the request of each descriptor is stored.
+ * @param lines - Location where the line of each descriptor is stored.
+ * @return Number of line requests, negative error code otherwise.
+ */
+static int32_t linux_gpio_sort_lines(struct no_os_gpio_desc **desc,
+				     uint8_t nb_gpios, int *fds,
+				     struct gpio_v2_line_values *vals,
+				     uint8_t *reqs,
+				     struct linux_gpio_line **lines)
+{
+	struct linux_gpio_chip *chip;
+	uint32_t i, j, nb_reqs = 0;
+	int32_t idx;
+
+	for (i = 0; i < nb_gpios; i++) {
+		lines[i] = NULL;
+		if (!desc[i])
+			continue;
+
+		chip = desc[i]->extra;
+		idx = linux_gpio_line_find(chip, desc[i]->number);
+		if (idx < 0)
+			return -ENOENT;
+
+		lines[i] = &chip->lines[idx];
+		for (j = 0; j < nb_reqs; j++)
+			if (fds[j] == lines[i]->req_fd)
+				break;
+		if (j == nb_reqs) {
+			fds[j] = lines[i]->req_fd;
+			vals[j].mask = 0;
+			vals[j].bits = 0;
+			nb_reqs++;
+		}
+
+		vals[j].mask |= NO_OS_BIT_ULL(lines[i]->req_idx);
+		reqs[i] = j;
+	}
+
+	return nb_reqs;
+}
+
+/**
+ * @brief Set the values of several GPIOs, with one ioctl for each line
+ * request.
+ * @param desc - Array of GPIO descriptors, NULL entries are ignored.
+ * @param nb_gpios - Number of descriptors in the array.
+ * @param values - Array of values, one for each descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_set_values(struct no_os_gpio_desc **desc,
+		uint8_t nb_gpios,
+		const uint8_t *values)
+{
+	struct gpio_v2_line_values vals[UINT8_MAX];
+	struct linux_gpio_line *lines[UINT8_MAX];
+	uint8_t reqs[UINT8_MAX];
+	int fds[UINT8_MAX];
+	int32_t nb_reqs, i;
+
+	nb_reqs = linux_gpio_sort_lines(desc, nb_gpios, fds, vals, reqs, lines);
+	if (nb_reqs < 0)
+		return nb_reqs;
+
+	for (i = 0; i < nb_gpios; i++) {
+		if (!lines[i])
+			continue;
+
+		lines[i]->value = values[i];
+		if (values[i])
+			vals[reqs[i]].bits |= NO_OS_BIT_ULL(lines[i]->req_idx);
+	}
+
+	for (i = 0; i < nb_reqs; i++)
+		if (ioctl(fds[i], GPIO_V2_LINE_SET_VALUES_IOCTL, &vals[i]))
+			return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Get the values of several GPIOs, with one ioctl for each line
+ * request.
+ * @param desc - Array of GPIO descriptors, NULL entries are ignored.
+ * @param nb_gpios - Number of descriptors in the array.
+ * @param values - Array where the values will be stored.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_get_values(struct no_os_gpio_desc **desc,
+		uint8_t nb_gpios, uint8_t *values)
+{
+	struct gpio_v2_line_values vals[UINT8_MAX];
+	struct linux_gpio_line *lines[UINT8_MAX];
+	uint8_t reqs[UINT8_MAX];
+	int fds[UINT8_MAX];
+	int32_t nb_reqs, i;
+
+	nb_reqs = linux_gpio_sort_lines(desc, nb_gpios, fds, vals, reqs, lines);
+	if (nb_reqs < 0)
+		return nb_reqs;
+
+	for (i = 0; i < nb_reqs; i++)
+		if (ioctl(fds[i], GPIO_V2_LINE_GET_VALUES_IOCTL, &vals[i]))
+			return -errno;
+
+	for (i = 0; i < nb_gpios; i++) {
+		if (!lines[i])
+			continue;
+
+		values[i] = (vals[reqs[i]].bits & NO_OS_BIT_ULL(lines[i]->req_idx)) ?
+			    NO_OS_GPIO_HIGH : NO_OS_GPIO_LOW;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Set the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ *                         NO_OS_GPIO_HIGH_Z (the line becomes an input)
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_set_value(struct no_os_gpio_desc *desc,
+		uint8_t value)
+{
+	if (value == NO_OS_GPIO_HIGH_Z)
+		return linux_gpio_cdev_direction_input(desc);
+
+	return linux_gpio_cdev_set_values(&desc, 1, &value);
+}
+
+/**
+ * @brief Get the value of the specified GPIO.
+ * @param desc - The GPIO descriptor.
+ * @param value - The value.
+ *                Example: NO_OS_GPIO_HIGH
+ *                         NO_OS_GPIO_LOW
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_cdev_get_value(struct no_os_gpio_desc *desc,
+		uint8_t *value)
+{
+	return linux_gpio_cdev_get_values(&desc, 1, value);
+}
+
+/**
+ * @brief Enable or disable edge events on a line. The line is requested when
+ * the events are enabled, if no GPIO descriptor uses it, and released when
+ * they are disabled. The caller must stop reading the line request file
+ * descriptor before disabling the events.
+ * @param port - Chip index (/dev/gpiochipN).
+ * @param offset - Offset of the line.
+ * @param edge_flags - GPIO_V2_LINE_FLAG_EDGE_RISING and/or
+ *                     GPIO_V2_LINE_FLAG_EDGE_FALLING, 0 to disable.
+ * @param fd - Location where the line request file descriptor delivering the
+ *             events is stored, -1 when the events are disabled. May be NULL.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_set_edge(int32_t port, uint32_t offset,
+				 uint64_t edge_flags, int *fd)
+{
+	const uint64_t edge_mask = GPIO_V2_LINE_FLAG_EDGE_RISING |
+				   GPIO_V2_LINE_FLAG_EDGE_FALLING;
+	struct linux_gpio_line *lines[LINUX_GPIO_MAX_LINES];
+	struct linux_gpio_chip *chip;
+	struct linux_gpio_line *line;
+	bool added = false;
+	uint64_t old_flags;
+	int req_fd = -1;
+	int32_t idx, ret;
+
+	pthread_mutex_lock(&gpio_lock);
+
+	ret = linux_gpio_chip_get(port, &chip);
+	if (ret)
+		goto unlock;
+
+	idx = linux_gpio_line_find(chip, offset);
+	if (idx < 0 || !chip->lines[idx].irq) {
+		if (!edge_flags)
+			goto put;
+
+		/* The events of a line request are those of all its lines */
+		if (idx >= 0 && linux_gpio_req_lines(chip, chip->lines[idx].req_fd,
+						     lines) > 1) {
+			ret = -EBUSY;
+			goto put;
+		}
+
+		/* Edge detection needs an explicit input. */
+		ret = linux_gpio_line_use(chip, offset,
+					  GPIO_V2_LINE_FLAG_INPUT | edge_flags,
+					  true, true);
+		if (ret)
+			goto put;
+
+		added = true;
+		if (idx < 0) {
+			/* Requested with the edge flags */
+			idx = linux_gpio_line_find(chip, offset);
+			req_fd = chip->lines[idx].req_fd;
+			goto put;
+		}
+	}
+
+	line = &chip->lines[idx];
+	if (!edge_flags) {
+		/* A GPIO descriptor keeps the line, without the events */
+		if (line->users) {
+			line->flags &= ~edge_mask;
+			ret = linux_gpio_line_config(chip, line);
+		}
+		linux_gpio_line_use(chip, offset, 0, false, true);
+		goto put;
+	}
+
+	old_flags = line->flags;
+	line->flags &= ~(edge_mask | GPIO_V2_LINE_FLAG_OUTPUT);
+	line->flags |= GPIO_V2_LINE_FLAG_INPUT | edge_flags;
+	ret = linux_gpio_line_config(chip, line);
+	if (ret) {
+		line->flags = old_flags;
+		if (added)
+			line->irq = false;
+		goto put;
+	}
+
+	req_fd = line->req_fd;
+put:
+	linux_gpio_chip_put(chip);
+unlock:
+	pthread_mutex_unlock(&gpio_lock);
+
+	if (fd)
+		*fd = ret ? -1 : req_fd;
+
+	return ret;
+}
+
+/**
+ * @brief Get several lines of a chip with a single line request, so that
+ * no_os_gpio_set_values() and no_os_gpio_get_values() use one ioctl for all
+ * of them. Each line gets its own GPIO descriptor, freed by
+ * no_os_gpio_remove(); the request is released with the last line. Edge
+ * events can't be enabled on these lines.
+ * @param desc - Array where the GPIO descriptors will be stored.
+ * @param nb_gpios - Number of lines.
+ * @param param - Array of initialization parameters, one for each line, all
+ *                with the same port.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_cdev_get_group(struct no_os_gpio_desc **desc,
+				  uint8_t nb_gpios,
+				  const struct no_os_gpio_init_param *param)
+{
+	struct linux_gpio_line *lines[GPIO_V2_LINES_MAX];
+	struct linux_gpio_chip *chip;
+	int32_t ret;
+	uint32_t i, j;
+
+	if (!desc || !param || !nb_gpios || nb_gpios > GPIO_V2_LINES_MAX)
+		return -EINVAL;
+
+	for (i = 0; i < nb_gpios; i++) {
+		if (param[i].number < 0 || param[i].port != param[0].port)
+			return -EINVAL;
+		for (j = 0; j < i; j++)
+			if (param[j].number == param[i].number)
+				return -EINVAL;
+		desc[i] = NULL;
+	}
+
+	for (i = 0; i < nb_gpios; i++) {
+		desc[i] = no_os_calloc(1, sizeof(**desc));
+		if (!desc[i]) {
+			ret = -ENOMEM;
+			goto free;
+		}
+	}
+
+	pthread_mutex_lock(&gpio_lock);
+
+	ret = linux_gpio_chip_get(param[0].port, &chip);
+	if (ret)
+		goto unlock;
+
+	if (chip->nb_lines + nb_gpios > LINUX_GPIO_MAX_LINES) {
+		ret = -ENOMEM;
+		goto put;
+	}
+
+	for (i = 0; i < nb_gpios; i++) {
+		if (linux_gpio_line_find(chip, param[i].number) >= 0) {
+			ret = -EBUSY;
+			goto put;
+		}
+
+		lines[i] = &chip->lines[chip->nb_lines + i];
+		lines[i]->offset = param[i].number;
+		lines[i]->flags = linux_gpio_pull_flags(param[i].pull);
+		lines[i]->value = 0;
+		lines[i]->users = 1;
+		lines[i]->irq = false;
+	}
+
+	ret = linux_gpio_lines_request(chip, lines, nb_gpios);
+	if (ret)
+		goto put;
+
+	chip->nb_lines += nb_gpios;
+put:
+	linux_gpio_chip_put(chip);
+unlock:
+	pthread_mutex_unlock(&gpio_lock);
+	if (ret)
+		goto free;
+
+	for (i = 0; i < nb_gpios; i++) {
+		desc[i]->port = param[i].port;
+		desc[i]->number = param[i].number;
+		desc[i]->pull = param[i].pull;
+		desc[i]->extra = chip;
+		desc[i]->platform_ops = &linux_gpio_cdev_ops;
+	}
+
+	return 0;
+
+free:
+	for (i = 0; i < nb_gpios; i++) {
+		no_os_free(desc[i]);
+		desc[i] = NULL;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Linux GPIO character device platform ops structure
+ */
+const struct no_os_gpio_platform_ops linux_gpio_cdev_ops = {
+	.gpio_ops_get = &linux_gpio_cdev_get,
+	.gpio_ops_get_optional = &linux_gpio_cdev_get_optional,
+	.gpio_ops_remove = &linux_gpio_cdev_remove,
+	.gpio_ops_direction_input = &linux_gpio_cdev_direction_input,
+	.gpio_ops_direction_output = &linux_gpio_cdev_direction_output,
+	.gpio_ops_get_direction = &linux_gpio_cdev_get_direction,
+	.gpio_ops_set_value = &linux_gpio_cdev_set_value,
+	.gpio_ops_get_value = &linux_gpio_cdev_get_value,
+	.gpio_ops_set_values = &linux_gpio_cdev_set_values,
+	.gpio_ops_get_values = &linux_gpio_cdev_get_values,
+};
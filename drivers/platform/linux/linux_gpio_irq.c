@@ -0,0 +1,505 @@
+/***************************************************************************//**
+ *   @file   linux/linux_gpio_irq.c
+ *   @brief  Implementation of the Linux GPIO interrupt controller.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/gpio.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_irq.h"
+#include "linux_irq.h"
+#include "linux_gpio_irq.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Find the action registered for a line.
+ * @param gdesc - Linux GPIO IRQ descriptor.
+ * @param offset - Offset of the line.
+ * @return The action, NULL if no callback is registered for the line.
+ */
+static struct linux_gpio_irq_action *
+linux_gpio_irq_find(struct linux_gpio_irq_desc *gdesc, uint32_t offset)
+{
+	uint32_t i;
+
+	for (i = 0; i < gdesc->nb_actions; i++)
+		if (gdesc->actions[i].used && gdesc->actions[i].offset == offset)
+			return &gdesc->actions[i];
+
+	return NULL;
+}
+
+/**
+ * @brief Called from the event thread when edge events of a line are pending.
+ * @param ctx - Action of the line.
+ */
+static void linux_gpio_irq_handler(void *ctx)
+{
+	struct gpio_v2_line_event events[16];
+	struct linux_gpio_irq_action *action = ctx;
+	struct linux_gpio_irq_desc *gdesc = action->gdesc;
+	struct timespec now;
+	uint64_t now_ns, latency;
+	ssize_t len;
+	size_t i;
+
+	len = read(action->fd, events, sizeof(events));
+	if (len <= 0)
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	now_ns = (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+
+	for (i = 0; i < len / sizeof(events[0]); i++) {
+		gdesc->nb_events++;
+		latency = now_ns - events[i].timestamp_ns;
+		gdesc->last_latency_ns = latency;
+		if (latency > gdesc->max_latency_ns)
+			gdesc->max_latency_ns = latency;
+
+		if (action->enabled && action->callback)
+			action->callback(action->ctx);
+	}
+}
+
+/**
+ * @brief Enable or disable the edge events of a line and watch the file
+ * descriptor delivering them.
+ * @param action - Action of the line.
+ * @param edge_flags - Edge flags, 0 to disable the events.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_set_edge(struct linux_gpio_irq_action *action,
+				       uint64_t edge_flags)
+{
+	struct linux_gpio_irq_desc *gdesc = action->gdesc;
+	int32_t ret;
+	int fd;
+
+	/* The file descriptor is closed when the events are disabled. */
+	if (!edge_flags && action->fd >= 0) {
+		linux_irq_unwatch_fd(action->fd);
+		action->fd = -1;
+	}
+
+	ret = linux_gpio_cdev_set_edge(gdesc->port, action->offset, edge_flags,
+				       &fd);
+	if (ret || fd < 0 || fd == action->fd)
+		return ret;
+
+	ret = linux_irq_watch_fd(fd, linux_gpio_irq_handler, action);
+	if (ret) {
+		linux_gpio_cdev_set_edge(gdesc->port, action->offset, 0, NULL);
+		return ret;
+	}
+
+	action->fd = fd;
+	linux_irq_set_fd_priority(fd, action->priority);
+
+	return 0;
+}
+
+/**
+ * @brief Get the edge flags of a trigger condition.
+ * @param trig - Trigger condition.
+ * @param flags - Location where the flags will be stored.
+ * @return 0 in case of success, -EINVAL for level triggers.
+ */
+static int32_t linux_gpio_irq_edge(enum no_os_irq_trig_level trig,
+				   uint64_t *flags)
+{
+	switch (trig) {
+	case NO_OS_IRQ_EDGE_RISING:
+		*flags = GPIO_V2_LINE_FLAG_EDGE_RISING;
+		return 0;
+	case NO_OS_IRQ_EDGE_FALLING:
+		*flags = GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		return 0;
+	case NO_OS_IRQ_EDGE_BOTH:
+		*flags = GPIO_V2_LINE_FLAG_EDGE_RISING |
+			 GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		return 0;
+	default:
+		/* The character device only reports edges. */
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief Initialize the GPIO interrupt controller of a GPIO chip.
+ * @param desc - Pointer where the configured instance is stored.
+ * @param param - Configuration information for the instance, irq_ctrl_id is
+ *                the index of the chip (/dev/gpiochipN).
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+					const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *descriptor;
+	struct linux_gpio_irq_desc *gdesc;
+	int32_t ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	gdesc = no_os_calloc(1, sizeof(*gdesc));
+	if (!gdesc) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	gdesc->port = param->irq_ctrl_id;
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->extra = gdesc;
+
+	*desc = descriptor;
+
+	return 0;
+
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by linux_gpio_irq_ctrl_init().
+ * @param desc - GPIO interrupt controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpio_irq_desc *gdesc;
+	uint32_t i;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	for (i = 0; i < gdesc->nb_actions; i++)
+		if (gdesc->actions[i].used && gdesc->actions[i].enabled)
+			linux_gpio_irq_set_edge(&gdesc->actions[i], 0);
+
+	no_os_free(gdesc);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Register a callback for the edge events of a line.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param irq_id - Line offset.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_register_callback(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_gpio_irq_action *action;
+	struct linux_gpio_irq_desc *gdesc;
+	int32_t ret = 0;
+	uint32_t i;
+
+	if (!desc || !desc->extra || !cb)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	linux_irq_lock();
+
+	action = linux_gpio_irq_find(gdesc, irq_id);
+	if (!action) {
+		/* The event thread keeps a pointer to the action, reuse a slot. */
+		for (i = 0; i < gdesc->nb_actions; i++)
+			if (!gdesc->actions[i].used)
+				break;
+		if (i == LINUX_GPIO_MAX_LINES) {
+			ret = -ENOMEM;
+			goto unlock;
+		}
+		if (i == gdesc->nb_actions)
+			gdesc->nb_actions++;
+
+		action = &gdesc->actions[i];
+		action->used = true;
+		action->gdesc = gdesc;
+		action->offset = irq_id;
+		action->trig = NO_OS_IRQ_EDGE_RISING;
+		action->enabled = false;
+		action->fd = -1;
+		action->priority = LINUX_IRQ_PRIO_DEFAULT;
+	}
+
+	action->callback = cb->callback;
+	action->ctx = cb->ctx;
+unlock:
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Disable the edge events of a line.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param irq_id - Line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				      uint32_t irq_id)
+{
+	struct linux_gpio_irq_action *action;
+	struct linux_gpio_irq_desc *gdesc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	action = linux_gpio_irq_find(gdesc, irq_id);
+	if (!action)
+		return -ENOENT;
+
+	if (!action->enabled)
+		return 0;
+
+	action->enabled = false;
+
+	return linux_gpio_irq_set_edge(action, 0);
+}
+
+/**
+ * @brief Unregister the callback of a line.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param irq_id - Line offset.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_gpio_irq_action *action;
+	struct linux_gpio_irq_desc *gdesc;
+	int32_t ret;
+
+	(void)cb;
+
+	ret = linux_gpio_irq_disable(desc, irq_id);
+	if (ret)
+		return ret;
+
+	gdesc = desc->extra;
+
+	linux_irq_lock();
+	action = linux_gpio_irq_find(gdesc, irq_id);
+	action->used = false;
+	while (gdesc->nb_actions && !gdesc->actions[gdesc->nb_actions - 1].used)
+		gdesc->nb_actions--;
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Set the trigger condition of a line.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param irq_id - Line offset.
+ * @param trig - Trigger condition, only edges are supported.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_trigger_level_set(struct no_os_irq_ctrl_desc
+		*desc, uint32_t irq_id,
+		enum no_os_irq_trig_level trig)
+{
+	struct linux_gpio_irq_action *action;
+	struct linux_gpio_irq_desc *gdesc;
+	uint64_t flags;
+	int32_t ret;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	ret = linux_gpio_irq_edge(trig, &flags);
+	if (ret)
+		return ret;
+
+	gdesc = desc->extra;
+
+	action = linux_gpio_irq_find(gdesc, irq_id);
+	if (!action)
+		return -ENOENT;
+
+	if (action->enabled) {
+		ret = linux_gpio_irq_set_edge(action, flags);
+		if (ret)
+			return ret;
+	}
+
+	action->trig = trig;
+
+	return 0;
+}
+
+/**
+ * @brief Enable the edge events of a line.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param irq_id - Line offset.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				     uint32_t irq_id)
+{
+	struct linux_gpio_irq_action *action;
+	struct linux_gpio_irq_desc *gdesc;
+	uint64_t flags;
+	int32_t ret;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	action = linux_gpio_irq_find(gdesc, irq_id);
+	if (!action)
+		return -ENOENT;
+
+	ret = linux_gpio_irq_edge(action->trig, &flags);
+	if (ret)
+		return ret;
+
+	ret = linux_gpio_irq_set_edge(action, flags);
+	if (ret)
+		return ret;
+
+	action->enabled = true;
+
+	return 0;
+}
+
+/**
+ * @brief Set the priority of the events of a line.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @param irq_id - Line offset.
+ * @param priority_level - Priority, lower values are served first.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_gpio_irq_set_priority(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		uint32_t priority_level)
+{
+	struct linux_gpio_irq_action *action;
+	struct linux_gpio_irq_desc *gdesc;
+	int32_t ret = 0;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	gdesc = desc->extra;
+
+	linux_irq_lock();
+	action = linux_gpio_irq_find(gdesc, irq_id);
+	if (action) {
+		action->priority = priority_level;
+		if (action->fd >= 0)
+			linux_irq_set_fd_priority(action->fd, priority_level);
+	} else {
+		ret = -ENOENT;
+	}
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Unblock the callbacks, after linux_gpio_irq_global_disable().
+ * @param desc - GPIO interrupt controller descriptor.
+ * @return 0
+ */
+static int32_t linux_gpio_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	(void)desc;
+
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Block the callbacks of all the interrupt controllers. Must be
+ * paired with linux_gpio_irq_global_enable(), from the same thread.
+ * @param desc - GPIO interrupt controller descriptor.
+ * @return 0
+ */
+static int32_t linux_gpio_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	(void)desc;
+
+	linux_irq_lock();
+
+	return 0;
+}
+
+/**
+ * @brief Linux specific GPIO IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_gpio_irq_ops = {
+	.init = &linux_gpio_irq_ctrl_init,
+	.register_callback = &linux_gpio_irq_register_callback,
+	.unregister_callback = &linux_gpio_irq_unregister_callback,
+	.global_enable = &linux_gpio_irq_global_enable,
+	.global_disable = &linux_gpio_irq_global_disable,
+	.trigger_level_set = &linux_gpio_irq_trigger_level_set,
+	.enable = &linux_gpio_irq_enable,
+	.disable = &linux_gpio_irq_disable,
+	.set_priority = &linux_gpio_irq_set_priority,
+	.remove = &linux_gpio_irq_ctrl_remove,
+};
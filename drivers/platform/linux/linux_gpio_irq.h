@@ -0,0 +1,102 @@
+/***************************************************************************//**
+ *   @file   linux/linux_gpio_irq.h
+ *   @brief  Header file of the Linux GPIO interrupt controller.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_GPIO_IRQ_H_
+#define LINUX_GPIO_IRQ_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "no_os_irq.h"
+#include "linux_gpio.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+struct linux_gpio_irq_desc;
+
+/**
+ * @struct linux_gpio_irq_action
+ * @brief Callback registered for a line
+ */
+struct linux_gpio_irq_action {
+	/** The slot holds a registered callback */
+	bool used;
+	/** Controller of the line */
+	struct linux_gpio_irq_desc *gdesc;
+	/** Offset of the line */
+	uint32_t offset;
+	/** Callback and its parameter */
+	void (*callback)(void *ctx);
+	void *ctx;
+	/** Trigger condition, only edges are supported */
+	enum no_os_irq_trig_level trig;
+	/** The edge events of the line are enabled */
+	bool enabled;
+	/** Line request file descriptor watched by the event thread, or -1 */
+	int fd;
+	/** Priority of the events of the line in the event thread */
+	uint32_t priority;
+};
+
+/**
+ * @struct linux_gpio_irq_desc
+ * @brief Linux platform specific GPIO IRQ descriptor. irq_ctrl_id is the
+ * index of the GPIO chip (/dev/gpiochipN) and irq_id is the line offset.
+ */
+struct linux_gpio_irq_desc {
+	/** Chip index */
+	int32_t port;
+	/** Registered callbacks, the slots below nb_actions may be free */
+	struct linux_gpio_irq_action actions[LINUX_GPIO_MAX_LINES];
+	uint32_t nb_actions;
+	/** Number of edge events received */
+	uint64_t nb_events;
+	/** Time from the edge to the call of the callback, last and maximum */
+	uint64_t last_latency_ns;
+	uint64_t max_latency_ns;
+};
+
+/**
+ * @brief Linux specific GPIO IRQ platform ops structure
+ */
+extern const struct no_os_irq_platform_ops linux_gpio_irq_ops;
+
+#endif // LINUX_GPIO_IRQ_H_
@@ -46,13 +46,23 @@
 #include "no_os_alloc.h"
 #include "linux_i2c.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Maximum number of messages of an I2C_RDWR transaction. */
+#define LINUX_I2C_MAX_MSGS	I2C_RDWR_IOCTL_MAX_MSGS
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -64,6 +74,10 @@
 struct linux_i2c_desc {
 	/** /dev/i2c-"device_id" file descriptor */
 	int fd;
+	/** The adapter supports I2C_RDWR (I2C_FUNC_I2C) */
+	bool rdwr;
+	/** Address selected with I2C_SLAVE, -1 if none */
+	int slave_address;
 };
 
 /******************************************************************************/
@@ -74,7 +88,7 @@ struct linux_i2c_desc {
  * @brief Initialize the I2C communication peripheral.
  * @param desc - The I2C descriptor.
  * @param param - The structure that contains the I2C parameters.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, negative error code otherwise.
  */
 int32_t linux_i2c_init(struct no_os_i2c_desc **desc,
 		       const struct no_os_i2c_init_param *param)
@@ -82,28 +96,40 @@ int32_t linux_i2c_init(struct no_os_i2c_desc **desc,
 	struct linux_i2c_init_param *linux_init;
 	struct linux_i2c_desc *linux_desc;
 	struct no_os_i2c_desc *descriptor;
+	unsigned long funcs;
 	char path[64];
+	int32_t ret;
+
+	if (!desc || !param || !param->extra)
+		return -EINVAL;
 
-	descriptor = no_os_malloc(sizeof(*descriptor));
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
 	if (!descriptor)
-		return -1;
+		return -ENOMEM;
 
-	linux_desc = (struct linux_i2c_desc*) no_os_malloc(sizeof(
-				struct linux_i2c_desc));
-	if (!linux_desc)
+	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
+	if (!linux_desc) {
+		ret = -ENOMEM;
 		goto free_desc;
+	}
 
 	descriptor->extra = linux_desc;
 	linux_init = param->extra;
 
 	snprintf(path, sizeof(path), "/dev/i2c-%d", linux_init->device_id);
 
-	linux_desc->fd = open(path, O_RDWR);
+	linux_desc->fd = open(path, O_RDWR | O_CLOEXEC);
 	if (linux_desc->fd < 0) {
+		ret = -errno;
 		printf("%s: Can't open %s\n\r", __func__, path);
 		goto free;
 	}
 
+	/* SMBus only adapters can't do combined transfers. */
+	if (!ioctl(linux_desc->fd, I2C_FUNCS, &funcs))
+		linux_desc->rdwr = funcs & I2C_FUNC_I2C;
+	linux_desc->slave_address = -1;
+
 	descriptor->slave_address = param->slave_address;
 
 	*desc = descriptor;
@@ -115,25 +141,159 @@ free:
 free_desc:
 	no_os_free(descriptor);
 
-	return -1;
+	return ret;
+}
+
+/**
+ * @brief Send messages in a single I2C_RDWR transaction.
+ * @param desc - The I2C descriptor.
+ * @param msgs - Messages.
+ * @param nb_msgs - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_i2c_rdwr(struct no_os_i2c_desc *desc,
+			      struct no_os_i2c_msg *msgs,
+			      uint32_t nb_msgs)
+{
+	struct linux_i2c_desc *linux_desc = desc->extra;
+	struct i2c_msg i2c_msgs[LINUX_I2C_MAX_MSGS];
+	struct i2c_rdwr_ioctl_data data = {
+		.msgs = i2c_msgs,
+		.nmsgs = nb_msgs
+	};
+	uint32_t i;
+
+	if (nb_msgs > LINUX_I2C_MAX_MSGS)
+		return -EINVAL;
+
+	if (!nb_msgs)
+		return 0;
+
+	for (i = 0; i < nb_msgs; i++) {
+		if (msgs[i].bytes_number > UINT16_MAX)
+			return -EINVAL;
+
+		i2c_msgs[i].addr = desc->slave_address;
+		i2c_msgs[i].flags = (msgs[i].flags & NO_OS_I2C_M_RD) ?
+				    I2C_M_RD : 0;
+		i2c_msgs[i].len = msgs[i].bytes_number;
+		i2c_msgs[i].buf = msgs[i].buff;
+	}
+
+	if (ioctl(linux_desc->fd, I2C_RDWR, &data) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Select the slave address for read() and write(), only when it
+ * changed since the previous access.
+ * @param desc - The I2C descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_i2c_select(struct no_os_i2c_desc *desc)
+{
+	struct linux_i2c_desc *linux_desc = desc->extra;
+	int32_t ret;
+
+	if (linux_desc->slave_address == desc->slave_address)
+		return 0;
+
+	if (ioctl(linux_desc->fd, I2C_SLAVE, desc->slave_address) < 0) {
+		ret = -errno;
+		linux_desc->slave_address = -1;
+		printf("%s: Can't select device\n\r", __func__);
+		return ret;
+	}
+
+	linux_desc->slave_address = desc->slave_address;
+
+	return 0;
+}
+
+/**
+ * @brief Send messages one by one with read() and write(), for the adapters
+ * without I2C_RDWR support. A STOP is generated after each message.
+ * @param desc - The I2C descriptor.
+ * @param msgs - Messages.
+ * @param nb_msgs - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_i2c_rw(struct no_os_i2c_desc *desc,
+			    struct no_os_i2c_msg *msgs,
+			    uint32_t nb_msgs)
+{
+	struct linux_i2c_desc *linux_desc = desc->extra;
+	int32_t ret;
+	ssize_t len;
+	uint32_t i;
+
+	ret = linux_i2c_select(desc);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb_msgs; i++) {
+		if (msgs[i].flags & NO_OS_I2C_M_RD)
+			len = read(linux_desc->fd, msgs[i].buff,
+				   msgs[i].bytes_number);
+		else
+			len = write(linux_desc->fd, msgs[i].buff,
+				    msgs[i].bytes_number);
+		if (len < 0)
+			return -errno;
+		if ((uint32_t)len != msgs[i].bytes_number)
+			return -EIO;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Send messages separated by repeated START conditions, with a single
+ * I2C_RDWR ioctl.
+ * @param desc - The I2C descriptor.
+ * @param msgs - Messages.
+ * @param nb_msgs - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t nb_msgs)
+{
+	struct linux_i2c_desc *linux_desc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	if (linux_desc->rdwr)
+		return linux_i2c_rdwr(desc, msgs, nb_msgs);
+
+	return linux_i2c_rw(desc, msgs, nb_msgs);
 }
 
 /**
  * @brief Free the resources allocated by no_os_i2c_init().
  * @param desc - The I2C descriptor.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, negative error code otherwise.
  */
 int32_t linux_i2c_remove(struct no_os_i2c_desc *desc)
 {
 	struct linux_i2c_desc *linux_desc;
 	int32_t ret;
 
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
 	linux_desc = desc->extra;
 
 	ret = close(linux_desc->fd);
 	if (ret < 0) {
+		ret = -errno;
 		printf("%s: Can't close device\n\r", __func__);
-		return -1;
+		return ret;
 	}
 
 	no_os_free(desc->extra);
@@ -150,35 +310,25 @@ int32_t linux_i2c_remove(struct no_os_i2c_desc *desc)
  * @param stop_bit - Stop condition control.
  *                   Example: 0 - A stop condition will not be generated;
  *                            1 - A stop condition will be generated.
- * @return 0 in case of success, -1 otherwise.
+ *                   A stop condition is always generated, use
+ *                   no_os_i2c_transfer() for a write followed by a read
+ *                   after a repeated start.
+ * @return 0 in case of success, negative error code otherwise.
  */
 int32_t linux_i2c_write(struct no_os_i2c_desc *desc,
 			uint8_t *data,
 			uint8_t bytes_number,
 			uint8_t stop_bit)
 {
-	struct linux_i2c_desc *linux_desc;
-	int32_t ret;
-
-	linux_desc = desc->extra;
-
-	ret = ioctl(linux_desc->fd, I2C_SLAVE, desc->slave_address);
-	if (ret < 0) {
-		printf("%s: Can't select device\n\r", __func__);
-		return -1;
-	}
+	struct no_os_i2c_msg msg = {
+		.buff = data,
+		.bytes_number = bytes_number,
+		.flags = 0
+	};
 
-	ret = write(linux_desc->fd, data, bytes_number);
-	if (ret < 0) {
-		printf("%s: Can't write to file\n\r", __func__);
-		return -1;
-	}
-
-	if (stop_bit) {
-		// Unused variable - fix compiler warning
-	}
+	(void)stop_bit;
 
-	return 0;
+	return linux_i2c_transfer(desc, &msg, 1);
 }
 
 /**
@@ -186,38 +336,24 @@ int32_t linux_i2c_write(struct no_os_i2c_desc *desc,
  * @param desc - The I2C descriptor.
  * @param data - Buffer that will store the received data.
  * @param bytes_number - Number of bytes to read.
- * @param stop_bit - Stop condition control.
- *                   Example: 0 - A stop condition will not be generated;
- *                            1 - A stop condition will be generated.
- * @return 0 in case of success, -1 otherwise.
+ * @param stop_bit - Stop condition control, a stop condition is always
+ *                   generated.
+ * @return 0 in case of success, negative error code otherwise.
  */
 int32_t linux_i2c_read(struct no_os_i2c_desc *desc,
 		       uint8_t *data,
 		       uint8_t bytes_number,
 		       uint8_t stop_bit)
 {
-	struct linux_i2c_desc *linux_desc;
-	int32_t ret;
+	struct no_os_i2c_msg msg = {
+		.buff = data,
+		.bytes_number = bytes_number,
+		.flags = NO_OS_I2C_M_RD
+	};
 
-	linux_desc = desc->extra;
+	(void)stop_bit;
 
-	ret = ioctl(linux_desc->fd, I2C_SLAVE, desc->slave_address);
-	if (ret < 0) {
-		printf("%s: Can't select device\n\r", __func__);
-		return -1;
-	}
-
-	ret = read(linux_desc->fd, data, bytes_number);
-	if (ret < 0) {
-		printf("%s: Can't read from file\n\r", __func__);
-		return -1;
-	}
-
-	if (stop_bit) {
-		// Unused variable - fix compiler warning
-	}
-
-	return 0;
+	return linux_i2c_transfer(desc, &msg, 1);
 }
 
 /**
@@ -227,5 +363,6 @@ const struct no_os_i2c_platform_ops linux_i2c_ops = {
 	.i2c_ops_init = &linux_i2c_init,
 	.i2c_ops_write = &linux_i2c_write,
 	.i2c_ops_read = &linux_i2c_read,
+	.i2c_ops_transfer = &linux_i2c_transfer,
 	.i2c_ops_remove = &linux_i2c_remove
 };
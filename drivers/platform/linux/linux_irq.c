@@ -0,0 +1,881 @@
+/***************************************************************************//**
+ *   @file   linux/linux_irq.c
+ *   @brief  Implementation of the Linux interrupt emulation.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "linux_irq.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_irq_source
+ * @brief File descriptor watched by the event thread.
+ */
+struct linux_irq_source {
+	/** Watched file descriptor, -1 if the slot is free */
+	int fd;
+	/** Incremented each time the slot is reused */
+	uint32_t gen;
+	/** Lower values are served first */
+	uint32_t priority;
+	/** Called from the event thread when fd is readable */
+	void (*handler)(void *ctx);
+	void *ctx;
+};
+
+/**
+ * @struct linux_irq_line
+ * @brief Interrupt line of linux_irq_ops.
+ */
+struct linux_irq_line {
+	/** Callback and its parameter */
+	void (*callback)(void *ctx);
+	void *ctx;
+	/** The callback is called when the line is raised */
+	bool enabled;
+	/** Priority given to the sources of the line */
+	uint32_t priority;
+	/** Source connected with linux_irq_line_connect(), -1 if none */
+	int src_fd;
+	/** Eventfd used by linux_irq_trigger(), -1 until the first trigger */
+	int efd;
+	/** Time of the last software trigger */
+	uint64_t trigger_ns;
+	/** Statistics, the mean and the sum of squared differences (Welford) */
+	uint64_t nb_events;
+	uint64_t nb_missed;
+	uint64_t min_latency_ns;
+	uint64_t max_latency_ns;
+	double mean_latency_ns;
+	double m2_latency;
+};
+
+/******************************************************************************/
+/************************ Variables Definitions *******************************/
+/******************************************************************************/
+
+static struct linux_irq_source irq_sources[LINUX_IRQ_MAX_FDS];
+static struct linux_irq_line irq_lines[LINUX_IRQ_MAX_LINES];
+static uint32_t irq_nb_sources;
+static pthread_mutex_t irq_lock;
+static pthread_once_t irq_once = PTHREAD_ONCE_INIT;
+static pthread_t irq_thread;
+static bool irq_thread_running;
+static int irq_epoll_fd = -1;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize the event lock and the tables. The lock is recursive so
+ * the handlers can call linux_irq_lock() and the watch functions.
+ */
+static void linux_irq_once_init(void)
+{
+	pthread_mutexattr_t attr;
+	uint32_t i;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&irq_lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+
+	for (i = 0; i < LINUX_IRQ_MAX_FDS; i++)
+		irq_sources[i].fd = -1;
+
+	for (i = 0; i < LINUX_IRQ_MAX_LINES; i++) {
+		irq_lines[i].src_fd = -1;
+		irq_lines[i].efd = -1;
+	}
+}
+
+/**
+ * @brief Block the handlers of all the interrupt sources.
+ */
+void linux_irq_lock(void)
+{
+	pthread_once(&irq_once, linux_irq_once_init);
+	pthread_mutex_lock(&irq_lock);
+}
+
+/**
+ * @brief Unblock the handlers of all the interrupt sources.
+ */
+void linux_irq_unlock(void)
+{
+	pthread_once(&irq_once, linux_irq_once_init);
+	/* Fails (EPERM) if the calling thread doesn't hold the lock. */
+	pthread_mutex_unlock(&irq_lock);
+}
+
+/**
+ * @brief Get the CLOCK_MONOTONIC time, the time base of the event
+ * timestamps.
+ * @return Time, in nanoseconds.
+ */
+uint64_t linux_irq_time_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+/**
+ * @brief Event thread. Waits for the watched file descriptors and calls their
+ * handlers, in the order of their priority.
+ * @param arg - Unused.
+ * @return NULL.
+ */
+static void *linux_irq_thread(void *arg)
+{
+	struct epoll_event events[LINUX_IRQ_MAX_FDS];
+	struct linux_irq_source *src;
+	struct epoll_event ev;
+	uint32_t idx, gen, prio;
+	int i, j, n;
+
+	(void)arg;
+
+	while (true) {
+		n = epoll_wait(irq_epoll_fd, events, LINUX_IRQ_MAX_FDS, -1);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		linux_irq_lock();
+
+		/*
+		 * More sources may have become ready while waiting for the lock
+		 * (global disable), poll again so they are served by priority.
+		 */
+		n = epoll_wait(irq_epoll_fd, events, LINUX_IRQ_MAX_FDS, 0);
+		if (n < 0)
+			n = 0;
+
+		/* Insertion sort, stable for sources of the same priority. */
+		for (i = 1; i < n; i++) {
+			ev = events[i];
+			prio = irq_sources[ev.data.u64 & 0xFFFFFFFF].priority;
+			for (j = i; j > 0; j--) {
+				idx = events[j - 1].data.u64 & 0xFFFFFFFF;
+				if (irq_sources[idx].priority <= prio)
+					break;
+				events[j] = events[j - 1];
+			}
+			events[j] = ev;
+		}
+
+		for (i = 0; i < n; i++) {
+			idx = events[i].data.u64 & 0xFFFFFFFF;
+			gen = events[i].data.u64 >> 32;
+			src = &irq_sources[idx];
+			/* The source may have been removed after epoll_wait(). */
+			if (src->fd < 0 || src->gen != gen)
+				continue;
+
+			src->handler(src->ctx);
+		}
+
+		linux_irq_unlock();
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Create the epoll instance and start the event thread, if not
+ * already done. The thread is kept for the lifetime of the process, it only
+ * sleeps in epoll_wait() while no source is watched. Called with the event
+ * lock held.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_thread_start(void)
+{
+	int32_t ret;
+
+	if (irq_thread_running)
+		return 0;
+
+	irq_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (irq_epoll_fd < 0)
+		return -errno;
+
+	ret = -pthread_create(&irq_thread, NULL, linux_irq_thread, NULL);
+	if (ret) {
+		close(irq_epoll_fd);
+		irq_epoll_fd = -1;
+		return ret;
+	}
+
+	irq_thread_running = true;
+
+	return 0;
+}
+
+/**
+ * @brief Run the event thread with the real-time SCHED_FIFO policy, so the
+ * handlers preempt the other threads of the system.
+ * @param sched_priority - SCHED_FIFO priority (1 - 99), 0 to restore the
+ *                         SCHED_OTHER policy.
+ * @return 0 in case of success, negative error code otherwise (-EPERM
+ *         without CAP_SYS_NICE).
+ */
+int32_t linux_irq_set_sched_priority(int sched_priority)
+{
+	struct sched_param param = {
+		.sched_priority = sched_priority
+	};
+	int32_t ret;
+
+	linux_irq_lock();
+
+	ret = linux_irq_thread_start();
+	if (!ret)
+		ret = -pthread_setschedparam(irq_thread,
+					     sched_priority ? SCHED_FIFO : SCHED_OTHER,
+					     &param);
+
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Call a handler from the event thread each time a file descriptor
+ * becomes readable. The event thread is started with the first source.
+ * @param fd - File descriptor to be watched.
+ * @param handler - Function called when fd is readable. It must consume the
+ *                  data (level triggered).
+ * @param ctx - Parameter of the handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_irq_watch_fd(int fd, void (*handler)(void *ctx), void *ctx)
+{
+	struct linux_irq_source *src = NULL;
+	struct epoll_event ev;
+	int32_t ret = 0;
+	uint32_t i;
+
+	if (fd < 0 || !handler)
+		return -EINVAL;
+
+	linux_irq_lock();
+
+	ret = linux_irq_thread_start();
+	if (ret)
+		goto unlock;
+
+	for (i = 0; i < LINUX_IRQ_MAX_FDS; i++) {
+		if (irq_sources[i].fd == fd) {
+			ret = -EBUSY;
+			goto unlock;
+		}
+		if (!src && irq_sources[i].fd < 0)
+			src = &irq_sources[i];
+	}
+	if (!src) {
+		ret = -ENOMEM;
+		goto unlock;
+	}
+
+	src->gen++;
+	src->priority = LINUX_IRQ_PRIO_DEFAULT;
+	src->handler = handler;
+	src->ctx = ctx;
+
+	ev.events = EPOLLIN;
+	ev.data.u64 = ((uint64_t)src->gen << 32) | (src - irq_sources);
+	if (epoll_ctl(irq_epoll_fd, EPOLL_CTL_ADD, fd, &ev)) {
+		ret = -errno;
+		goto unlock;
+	}
+
+	src->fd = fd;
+	irq_nb_sources++;
+unlock:
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Find a watched file descriptor. Called with the event lock held.
+ * @param fd - File descriptor passed to linux_irq_watch_fd().
+ * @return The source, NULL if fd is not watched.
+ */
+static struct linux_irq_source *linux_irq_find_fd(int fd)
+{
+	uint32_t i;
+
+	if (fd < 0)
+		return NULL;
+
+	for (i = 0; i < LINUX_IRQ_MAX_FDS; i++)
+		if (irq_sources[i].fd == fd)
+			return &irq_sources[i];
+
+	return NULL;
+}
+
+/**
+ * @brief Stop watching a file descriptor.
+ * @param fd - File descriptor passed to linux_irq_watch_fd().
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_irq_unwatch_fd(int fd)
+{
+	struct linux_irq_source *src;
+	int32_t ret = -ENOENT;
+
+	linux_irq_lock();
+
+	src = linux_irq_find_fd(fd);
+	if (src) {
+		epoll_ctl(irq_epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+		src->fd = -1;
+		irq_nb_sources--;
+		ret = 0;
+	}
+
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Set the priority of a watched file descriptor. When several sources
+ * are ready at the same time, the handlers of the lower values are called
+ * first.
+ * @param fd - File descriptor passed to linux_irq_watch_fd().
+ * @param priority - Priority of the source.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_irq_set_fd_priority(int fd, uint32_t priority)
+{
+	struct linux_irq_source *src;
+	int32_t ret = -ENOENT;
+
+	linux_irq_lock();
+
+	src = linux_irq_find_fd(fd);
+	if (src) {
+		src->priority = priority;
+		ret = 0;
+	}
+
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Integer square root.
+ * @param x - Value.
+ * @return floor(sqrt(x)).
+ */
+static uint64_t linux_irq_sqrt(uint64_t x)
+{
+	uint64_t res = 0;
+	uint64_t bit = 1ull << 62;
+
+	while (bit > x)
+		bit >>= 2;
+
+	while (bit) {
+		if (x >= res + bit) {
+			x -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return res;
+}
+
+/**
+ * @brief Make a watched file descriptor a source of a line. The source takes
+ * the priority of the line, now and when it is changed.
+ * @param irq_id - Interrupt line.
+ * @param fd - File descriptor passed to linux_irq_watch_fd(), -1 to
+ *             disconnect the current source.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_irq_line_connect(uint32_t irq_id, int fd)
+{
+	struct linux_irq_line *line;
+	int32_t ret = 0;
+
+	if (irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	linux_irq_lock();
+
+	line = &irq_lines[irq_id];
+	line->src_fd = fd;
+	if (fd >= 0)
+		ret = linux_irq_set_fd_priority(fd, line->priority);
+
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Deliver the events of a line: call its callback, if enabled, and
+ * update its statistics. Called by the handlers of the sources, from the
+ * event thread.
+ * @param irq_id - Interrupt line.
+ * @param event_ns - Time (CLOCK_MONOTONIC) of the last event.
+ * @param count - Number of events since the previous call, the callback is
+ *                called once.
+ */
+void linux_irq_line_signal(uint32_t irq_id, uint64_t event_ns, uint64_t count)
+{
+	struct linux_irq_line *line;
+	uint64_t latency, now;
+	double delta;
+
+	if (irq_id >= LINUX_IRQ_MAX_LINES || !count)
+		return;
+
+	linux_irq_lock();
+
+	line = &irq_lines[irq_id];
+	if (!line->enabled || !line->callback) {
+		line->nb_missed += count;
+		goto unlock;
+	}
+
+	now = linux_irq_time_ns();
+	latency = now > event_ns ? now - event_ns : 0;
+
+	line->nb_events++;
+	line->nb_missed += count - 1;
+	if (line->nb_events == 1 || latency < line->min_latency_ns)
+		line->min_latency_ns = latency;
+	if (latency > line->max_latency_ns)
+		line->max_latency_ns = latency;
+	delta = latency - line->mean_latency_ns;
+	line->mean_latency_ns += delta / line->nb_events;
+	line->m2_latency += delta * (latency - line->mean_latency_ns);
+
+	line->callback(line->ctx);
+unlock:
+	linux_irq_unlock();
+}
+
+/**
+ * @brief Handler of the eventfd of a line, delivers the software triggers.
+ * @param ctx - Interrupt line.
+ */
+static void linux_irq_line_efd_handler(void *ctx)
+{
+	struct linux_irq_line *line = ctx;
+	uint64_t count;
+
+	if (read(line->efd, &count, sizeof(count)) != sizeof(count))
+		return;
+
+	linux_irq_line_signal(line - irq_lines,
+			      __atomic_load_n(&line->trigger_ns, __ATOMIC_ACQUIRE),
+			      count);
+}
+
+/**
+ * @brief Raise a line, as a software interrupt. Can be called from any
+ * thread, including from the callbacks. The callback is called from the
+ * event thread.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_irq_trigger(uint32_t irq_id)
+{
+	struct linux_irq_line *line;
+	uint64_t one = 1;
+	int32_t ret = 0;
+	int efd;
+
+	if (irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	line = &irq_lines[irq_id];
+
+	efd = __atomic_load_n(&line->efd, __ATOMIC_ACQUIRE);
+	if (efd < 0) {
+		linux_irq_lock();
+		if (line->efd < 0) {
+			efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if (efd < 0) {
+				ret = -errno;
+				goto unlock;
+			}
+			ret = linux_irq_watch_fd(efd, linux_irq_line_efd_handler,
+						 line);
+			if (ret) {
+				close(efd);
+				goto unlock;
+			}
+			linux_irq_set_fd_priority(efd, line->priority);
+			__atomic_store_n(&line->efd, efd, __ATOMIC_RELEASE);
+		}
+		efd = line->efd;
+unlock:
+		linux_irq_unlock();
+		if (ret)
+			return ret;
+	}
+
+	__atomic_store_n(&line->trigger_ns, linux_irq_time_ns(),
+			 __ATOMIC_RELEASE);
+	if (write(efd, &one, sizeof(one)) != sizeof(one))
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Get the statistics of a line.
+ * @param irq_id - Interrupt line.
+ * @param stats - Location where the statistics will be stored.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_irq_get_stats(uint32_t irq_id, struct linux_irq_stats *stats)
+{
+	struct linux_irq_line *line;
+
+	if (irq_id >= LINUX_IRQ_MAX_LINES || !stats)
+		return -EINVAL;
+
+	linux_irq_lock();
+
+	line = &irq_lines[irq_id];
+	stats->nb_events = line->nb_events;
+	stats->nb_missed = line->nb_missed;
+	stats->min_latency_ns = line->min_latency_ns;
+	stats->max_latency_ns = line->max_latency_ns;
+	stats->mean_latency_ns = line->mean_latency_ns;
+	stats->jitter_ns = line->nb_events ?
+			   linux_irq_sqrt(line->m2_latency / line->nb_events) : 0;
+
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Reset the statistics of a line.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_irq_clear_stats(uint32_t irq_id)
+{
+	struct linux_irq_line *line;
+
+	if (irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	linux_irq_lock();
+
+	line = &irq_lines[irq_id];
+	line->nb_events = 0;
+	line->nb_missed = 0;
+	line->min_latency_ns = 0;
+	line->max_latency_ns = 0;
+	line->mean_latency_ns = 0;
+	line->m2_latency = 0;
+
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Initialize the interrupt controller.
+ * @param desc - Pointer where the configured instance is stored.
+ * @param param - Configuration information for the instance, extra may point
+ *                to a struct linux_irq_init_param.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+				   const struct no_os_irq_init_param *param)
+{
+	struct linux_irq_init_param *linux_ip;
+	struct no_os_irq_ctrl_desc *descriptor;
+	int32_t ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	linux_ip = param->extra;
+	if (linux_ip && linux_ip->sched_priority) {
+		ret = linux_irq_set_sched_priority(linux_ip->sched_priority);
+		if (ret)
+			return ret;
+	}
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by linux_irq_ctrl_init(). The lines
+ * are shared and keep their state.
+ * @param desc - Interrupt controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Register the callback of a line.
+ * @param desc - Interrupt controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	if (!desc || !cb || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	linux_irq_lock();
+	irq_lines[irq_id].callback = cb->callback;
+	irq_lines[irq_id].ctx = cb->ctx;
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Unregister the callback of a line, the line is disabled.
+ * @param desc - Interrupt controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	(void)cb;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	linux_irq_lock();
+	irq_lines[irq_id].enabled = false;
+	irq_lines[irq_id].callback = NULL;
+	irq_lines[irq_id].ctx = NULL;
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Set the trigger condition of a line. The events of the timers and of
+ * linux_irq_trigger() behave as rising edges.
+ * @param desc - Interrupt controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param trig - Trigger condition.
+ * @return 0 for NO_OS_IRQ_EDGE_RISING, -EINVAL otherwise.
+ */
+static int32_t linux_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		enum no_os_irq_trig_level trig)
+{
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	return trig == NO_OS_IRQ_EDGE_RISING ? 0 : -EINVAL;
+}
+
+/**
+ * @brief Enable or disable a line.
+ * @param desc - Interrupt controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param enable - New state of the line.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_set_enabled(struct no_os_irq_ctrl_desc *desc,
+				     uint32_t irq_id, bool enable)
+{
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	linux_irq_lock();
+	irq_lines[irq_id].enabled = enable;
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Enable a line.
+ * @param desc - Interrupt controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id)
+{
+	return linux_irq_set_enabled(desc, irq_id, true);
+}
+
+/**
+ * @brief Disable a line. The events raised while disabled are lost.
+ * @param desc - Interrupt controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id)
+{
+	return linux_irq_set_enabled(desc, irq_id, false);
+}
+
+/**
+ * @brief Set the priority of a line and of its sources.
+ * @param desc - Interrupt controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param priority_level - Priority, lower values are served first.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_set_priority(struct no_os_irq_ctrl_desc *desc,
+				      uint32_t irq_id,
+				      uint32_t priority_level)
+{
+	struct linux_irq_line *line;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	linux_irq_lock();
+
+	line = &irq_lines[irq_id];
+	line->priority = priority_level;
+	if (line->src_fd >= 0)
+		linux_irq_set_fd_priority(line->src_fd, priority_level);
+	if (line->efd >= 0)
+		linux_irq_set_fd_priority(line->efd, priority_level);
+
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Unblock the callbacks, after linux_irq_global_disable().
+ * @param desc - Interrupt controller descriptor.
+ * @return 0
+ */
+static int32_t linux_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	(void)desc;
+
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Block the callbacks of all the interrupt controllers. Must be
+ * paired with linux_irq_global_enable(), from the same thread.
+ * @param desc - Interrupt controller descriptor.
+ * @return 0
+ */
+static int32_t linux_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	(void)desc;
+
+	linux_irq_lock();
+
+	return 0;
+}
+
+/**
+ * @brief Linux specific IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_irq_ops = {
+	.init = &linux_irq_ctrl_init,
+	.register_callback = &linux_irq_register_callback,
+	.unregister_callback = &linux_irq_unregister_callback,
+	.global_enable = &linux_irq_global_enable,
+	.global_disable = &linux_irq_global_disable,
+	.trigger_level_set = &linux_irq_trigger_level_set,
+	.enable = &linux_irq_enable,
+	.disable = &linux_irq_disable,
+	.set_priority = &linux_irq_set_priority,
+	.remove = &linux_irq_ctrl_remove,
+};
@@ -0,0 +1,138 @@
+/***************************************************************************//**
+ *   @file   linux/linux_irq.h
+ *   @brief  Header file of the Linux interrupt emulation.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_IRQ_H_
+#define LINUX_IRQ_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "no_os_irq.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/* Number of file descriptors that can be watched by the event thread. */
+#define LINUX_IRQ_MAX_FDS	32
+/* Number of interrupt lines of linux_irq_ops. */
+#define LINUX_IRQ_MAX_LINES	32
+/* Priority of the sources which were not given one (highest). */
+#define LINUX_IRQ_PRIO_DEFAULT	0
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_irq_init_param
+ * @brief Linux specific IRQ controller parameters (extra of
+ * no_os_irq_init_param, may be NULL).
+ */
+struct linux_irq_init_param {
+	/**
+	 * SCHED_FIFO priority (1 - 99) of the event thread, 0 to keep the
+	 * default scheduling policy. Needs CAP_SYS_NICE.
+	 */
+	int sched_priority;
+};
+
+/**
+ * @struct linux_irq_stats
+ * @brief Statistics of an interrupt line. The latency is the time from the
+ * event (timer expiration, software trigger) to the call of the callback.
+ */
+struct linux_irq_stats {
+	/** Number of calls of the callback */
+	uint64_t nb_events;
+	/** Events lost: coalesced (timer overruns) or raised while disabled */
+	uint64_t nb_missed;
+	/** Latency, in nanoseconds */
+	uint64_t min_latency_ns;
+	uint64_t max_latency_ns;
+	uint64_t mean_latency_ns;
+	/** Standard deviation of the latency, in nanoseconds */
+	uint64_t jitter_ns;
+};
+
+/**
+ * @brief Linux specific IRQ platform ops structure. The interrupt lines are
+ * shared by all the controllers, like the lines of an NVIC. A line is raised
+ * by the timer with the same id (see linux_timer.h) or by linux_irq_trigger().
+ * Lower priority values are served first when several sources are ready.
+ */
+extern const struct no_os_irq_platform_ops linux_irq_ops;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/*
+ * Interrupts are emulated by a single event thread which waits (epoll) on the
+ * file descriptors of the interrupt sources and calls their handler when they
+ * become readable. Handlers are called one at a time, with the event lock
+ * held, so taking the lock from another thread has the same effect as
+ * disabling the interrupts on a microcontroller.
+ */
+
+/* Call handler from the event thread each time fd becomes readable. */
+int32_t linux_irq_watch_fd(int fd, void (*handler)(void *ctx), void *ctx);
+/* Stop watching fd. The handler is not running when this returns. */
+int32_t linux_irq_unwatch_fd(int fd);
+/* Set the order in which the handlers of the ready sources are called. */
+int32_t linux_irq_set_fd_priority(int fd, uint32_t priority);
+/* Run the event thread with the SCHED_FIFO policy (0 restores SCHED_OTHER). */
+int32_t linux_irq_set_sched_priority(int sched_priority);
+/* Block the handlers (global interrupt disable). Calls can be nested. */
+void linux_irq_lock(void);
+/* Unblock the handlers (global interrupt enable). */
+void linux_irq_unlock(void);
+
+/* Get the CLOCK_MONOTONIC time, in nanoseconds. */
+uint64_t linux_irq_time_ns(void);
+/* Make the watched fd a source of a line, it takes the priority of the line. */
+int32_t linux_irq_line_connect(uint32_t irq_id, int fd);
+/* Deliver count events of a line, the last one occurred at event_ns. */
+void linux_irq_line_signal(uint32_t irq_id, uint64_t event_ns, uint64_t count);
+/* Raise a line from any thread (software interrupt). */
+int32_t linux_irq_trigger(uint32_t irq_id);
+/* Get the statistics of a line. */
+int32_t linux_irq_get_stats(uint32_t irq_id, struct linux_irq_stats *stats);
+/* Reset the statistics of a line. */
+int32_t linux_irq_clear_stats(uint32_t irq_id);
+
+#endif // LINUX_IRQ_H_
@@ -49,6 +49,7 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include <linux/spi/spidev.h>
@@ -198,16 +199,26 @@ static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
 				  uint32_t len)
 
 {
+	struct spi_ioc_transfer tr_queue[NO_OS_SPI_QUEUE_MSGS];
 	struct spi_ioc_transfer *tr;
 	struct linux_spi_desc	*linux_desc;
-	int			ret;
+	int			ret, err;
 	uint32_t		i;
 
+	if (!len)
+		return 0;
+
 	linux_desc = desc->extra;
 
-	tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
-	if (!tr)
-		return -ENOMEM;
+	/* A flushed queue fits on the stack and is sent with one ioctl. */
+	if (len <= NO_OS_SPI_QUEUE_MSGS) {
+		tr = tr_queue;
+		memset(tr, 0, len * sizeof(*tr));
+	} else {
+		tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
+		if (!tr)
+			return -ENOMEM;
+	}
 
 	for (i = 0; i < len; i++) {
 		tr[i].tx_buf = (unsigned long) msgs[i].tx_buff;
@@ -217,13 +228,24 @@ static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
 		tr[i].word_delay_usecs = msgs[i].cs_change_delay;
 	}
 
+	/*
+	 * The messages of a flushed batch all have cs_change set, so that CS
+	 * is deasserted after each of them. spidev reads cs_change of the last
+	 * transfer as "keep CS asserted after the message", so it is cleared
+	 * there. The messages of the other callers are passed as they are.
+	 */
+	if (desc->queue && msgs == desc->queue->msgs)
+		tr[len - 1].cs_change = 0;
+
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(len), tr);
+	err = errno;
 
-	no_os_free(tr);
+	if (tr != tr_queue)
+		no_os_free(tr);
 
 	if (ret < 0) {
-		printf("%s: Can't send spi message (%d)\n\r", __func__, errno);
-		return ret;
+		printf("%s: Can't send spi message (%d)\n\r", __func__, err);
+		return -err;
 	}
 
 	return 0;
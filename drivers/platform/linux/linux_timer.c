@@ -40,13 +40,18 @@
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
+#include <errno.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
 #include "no_os_error.h"
 #include "no_os_timer.h"
 #include "no_os_alloc.h"
+#include "linux_irq.h"
+#include "linux_timer.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -57,19 +62,112 @@
  * @brief Linux platform specific timer descriptor
  */
 struct linux_timer_desc {
-	timer_t		timer_id;
+	/** timerfd (CLOCK_MONOTONIC) expiring at the end of each period */
+	int		fd;
 	bool		enable;
-	struct timespec	start_time;
+	/** Time at which the counter was 0 */
+	uint64_t	start_ns;
+	/** Time of the first expiration after the timer was armed */
+	uint64_t	first_ns;
+	uint64_t	period_ns;
+	/** Number of expirations since the timer was armed */
+	uint64_t	expirations;
 };
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * @brief Convert a number of ticks of the counter to nanoseconds.
+ * @param desc - timer descriptor
+ * @param ticks - number of ticks
+ * @return Duration in nanoseconds.
+ */
+static uint64_t linux_timer_ticks_to_ns(struct no_os_timer_desc *desc,
+					uint64_t ticks)
+{
+	return (ticks / desc->freq_hz) * 1000000000ull +
+	       (ticks % desc->freq_hz) * 1000000000ull / desc->freq_hz;
+}
+
+/**
+ * @brief Convert a duration to a number of ticks of the counter.
+ * @param desc - timer descriptor
+ * @param ns - duration in nanoseconds
+ * @return Number of ticks.
+ */
+static uint64_t linux_timer_ns_to_ticks(struct no_os_timer_desc *desc,
+					uint64_t ns)
+{
+	return (ns / 1000000000ull) * desc->freq_hz +
+	       (ns % 1000000000ull) * desc->freq_hz / 1000000000ull;
+}
+
+/**
+ * @brief Program the timerfd with the next expiration of the counter, or
+ * disarm it if the timer is stopped or has no period. Called with the event
+ * lock held.
+ * @param desc - timer descriptor
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_timer_arm(struct no_os_timer_desc *desc)
+{
+	struct linux_timer_desc *linux_desc = desc->extra;
+	struct itimerspec its = {0};
+	uint64_t now;
+
+	linux_desc->period_ns = linux_timer_ticks_to_ns(desc, desc->ticks_count);
+	linux_desc->expirations = 0;
+
+	if (linux_desc->enable && linux_desc->period_ns) {
+		/* The counter is reloaded at each multiple of the period. */
+		now = linux_irq_time_ns();
+		linux_desc->first_ns = linux_desc->start_ns + linux_desc->period_ns;
+		if (now >= linux_desc->first_ns)
+			linux_desc->first_ns += ((now - linux_desc->first_ns) /
+						 linux_desc->period_ns + 1) *
+						linux_desc->period_ns;
+
+		its.it_value.tv_sec = linux_desc->first_ns / 1000000000ull;
+		its.it_value.tv_nsec = linux_desc->first_ns % 1000000000ull;
+		its.it_interval.tv_sec = linux_desc->period_ns / 1000000000ull;
+		its.it_interval.tv_nsec = linux_desc->period_ns % 1000000000ull;
+	}
+
+	if (timerfd_settime(linux_desc->fd, TFD_TIMER_ABSTIME, &its, NULL))
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Called from the event thread when the timer expired. Raises the
+ * interrupt line of the timer.
+ * @param ctx - timer descriptor
+ */
+static void linux_timer_handler(void *ctx)
+{
+	struct no_os_timer_desc *desc = ctx;
+	struct linux_timer_desc *linux_desc = desc->extra;
+	uint64_t count;
+
+	if (read(linux_desc->fd, &count, sizeof(count)) != sizeof(count))
+		return;
+
+	linux_desc->expirations += count;
+
+	linux_irq_line_signal(LINUX_TIMER_IRQ_ID(desc->id),
+			      linux_desc->first_ns + (linux_desc->expirations - 1) *
+			      linux_desc->period_ns, count);
+}
+
 /**
  * @brief Timer driver init function
  * @param desc - timer descriptor to be initialized
- * @param param - initialization parameter for the desc
+ * @param param - initialization parameter for the desc. freq_hz is the
+ *                frequency of the counter and ticks_count its period; 0
+ *                disables the period (and the interrupt).
  * @return 0 in case of success, negative errno error codes otherwise.
  */
 int linux_timer_init(struct no_os_timer_desc **desc,
@@ -77,29 +175,61 @@ int linux_timer_init(struct no_os_timer_desc **desc,
 {
 	struct no_os_timer_desc *descriptor;
 	struct linux_timer_desc *linux_desc;
+	int ret;
+
+	if (!desc || !param || LINUX_TIMER_IRQ_ID(param->id) >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
 
 	descriptor = no_os_calloc(1, sizeof(*descriptor));
 	if (!descriptor)
 		return -ENOMEM;
 
 	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
-	if (!linux_desc)
+	if (!linux_desc) {
+		ret = -ENOMEM;
 		goto free_desc;
+	}
 
 	descriptor->extra = linux_desc;
 
 	descriptor->id = param->id;
-	descriptor->freq_hz = param->freq_hz;
+	descriptor->freq_hz = param->freq_hz ? param->freq_hz :
+			      LINUX_TIMER_DEFAULT_FREQ_HZ;
 	descriptor->ticks_count = param->ticks_count;
 
+	linux_desc->fd = timerfd_create(CLOCK_MONOTONIC,
+					TFD_NONBLOCK | TFD_CLOEXEC);
+	if (linux_desc->fd < 0) {
+		ret = -errno;
+		goto free_linux_desc;
+	}
+
+	linux_desc->start_ns = linux_irq_time_ns();
+
+	ret = linux_irq_watch_fd(linux_desc->fd, linux_timer_handler,
+				 descriptor);
+	if (ret)
+		goto close_fd;
+
+	ret = linux_irq_line_connect(LINUX_TIMER_IRQ_ID(descriptor->id),
+				     linux_desc->fd);
+	if (ret)
+		goto unwatch;
+
 	*desc = descriptor;
 
 	return 0;
 
+unwatch:
+	linux_irq_unwatch_fd(linux_desc->fd);
+close_fd:
+	close(linux_desc->fd);
+free_linux_desc:
+	no_os_free(linux_desc);
 free_desc:
 	no_os_free(descriptor);
 
-	return -ENOMEM;
+	return ret;
 }
 
 /**
@@ -109,6 +239,20 @@ free_desc:
  */
 int linux_timer_remove(struct no_os_timer_desc *desc)
 {
+	struct linux_timer_desc *linux_desc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	linux_irq_lock();
+	linux_irq_line_connect(LINUX_TIMER_IRQ_ID(desc->id), -1);
+	linux_irq_unwatch_fd(linux_desc->fd);
+	linux_irq_unlock();
+
+	close(linux_desc->fd);
+
 	no_os_free(desc->extra);
 	no_os_free(desc);
 
@@ -116,97 +260,93 @@ int linux_timer_remove(struct no_os_timer_desc *desc)
 }
 
 /**
- * @brief Timer count start function
+ * @brief Timer count start function. The counter restarts from 0.
  * @param desc - timer descriptor
- * @return 0 in case of success, -EINVAL otherwise.
+ * @return 0 in case of success, negative errno error codes otherwise.
  */
 int linux_timer_start(struct no_os_timer_desc *desc)
 {
 	struct linux_timer_desc *linux_desc;
+	int ret;
 
 	linux_desc = desc->extra;
 
-	clock_gettime(CLOCK_REALTIME, &linux_desc->start_time);
+	linux_irq_lock();
+	linux_desc->start_ns = linux_irq_time_ns();
 	linux_desc->enable = true;
+	ret = linux_timer_arm(desc);
+	linux_irq_unlock();
 
-	return 0;
+	return ret;
 }
 
 /**
- * @brief Timer count stop function
+ * @brief Timer count stop function. Stops the period interrupt.
  * @param desc - timer descriptor
- * @return 0 in case of success, -EINVAL otherwise.
+ * @return 0 in case of success, negative errno error codes otherwise.
  */
 int linux_timer_stop(struct no_os_timer_desc *desc)
 {
 	struct linux_timer_desc *linux_desc;
+	int ret;
 
 	linux_desc = desc->extra;
 
+	linux_irq_lock();
 	linux_desc->enable = false;
+	ret = linux_timer_arm(desc);
+	linux_irq_unlock();
 
-	return 0;
+	return ret;
 }
 
 /**
  * @brief Function to get the current timer counter value
  * @param desc - timer descriptor
- * @param counter - the timer counter value
+ * @param counter - the timer counter value, reloaded after ticks_count ticks
+ *                  when a period is set.
  * @return 0 in case of success, -EINVAL otherwise.
  */
 int linux_timer_counter_get(struct no_os_timer_desc *desc,
 			    uint32_t *counter)
 {
 	struct linux_timer_desc *linux_desc;
-	struct timespec curr_value;
+	uint64_t ticks;
 
 	linux_desc = desc->extra;
 
-	clock_gettime(CLOCK_REALTIME, &curr_value);
+	ticks = linux_timer_ns_to_ticks(desc, linux_irq_time_ns() -
+					linux_desc->start_ns);
+	if (desc->ticks_count)
+		ticks %= desc->ticks_count;
 
-	curr_value.tv_sec -= linux_desc->start_time.tv_sec;
-
-	if (curr_value.tv_sec) {
-		curr_value.tv_nsec += 1000000000 -
-				      linux_desc->start_time.tv_nsec;
-		if (curr_value.tv_nsec >= 1000000000)
-			curr_value.tv_nsec -= 1000000000;
-		else
-			curr_value.tv_sec--;
-	} else {
-		curr_value.tv_nsec -= linux_desc->start_time.tv_nsec;
-	}
-
-	*counter = curr_value.tv_sec * 1000 + curr_value.tv_nsec / 1000000;
+	*counter = ticks;
 
 	return 0;
 }
 
 /**
- * @brief Function to set the timer counter value
+ * @brief Function to set the timer counter value. The period interrupt is
+ * moved accordingly.
  * @param desc - timer descriptor
  * @param new_val - timer counter value to be set
- * @return 0 in case of success, -EINVAL otherwise.
+ * @return 0 in case of success, negative errno error codes otherwise.
  */
 int linux_timer_counter_set(struct no_os_timer_desc *desc,
 			    uint32_t new_val)
 {
 	struct linux_timer_desc *linux_desc;
-	struct timespec curr_value;
+	int ret;
 
 	linux_desc = desc->extra;
 
-	clock_gettime(CLOCK_REALTIME, &curr_value);
-
-	linux_desc->start_time.tv_sec = curr_value.tv_sec + new_val / 1000;
-	linux_desc->start_time.tv_nsec = curr_value.tv_nsec +
-					 (new_val % 1000) * 1000000;
-	if (linux_desc->start_time.tv_nsec >= 1000000000) {
-		linux_desc->start_time.tv_nsec -= 1000000000;
-		linux_desc->start_time.tv_sec++;
-	}
+	linux_irq_lock();
+	linux_desc->start_ns = linux_irq_time_ns() -
+			       linux_timer_ticks_to_ns(desc, new_val);
+	ret = linux_timer_arm(desc);
+	linux_irq_unlock();
 
-	return 0;
+	return ret;
 }
 
 /**
@@ -218,13 +358,13 @@ int linux_timer_counter_set(struct no_os_timer_desc *desc,
 int linux_timer_count_clk_get(struct no_os_timer_desc *desc,
 			      uint32_t *freq_hz)
 {
-	*freq_hz = 1000;
+	*freq_hz = desc->freq_hz;
 
 	return 0;
 }
 
 /**
- * @brief Function to set the timer frequency.
+ * @brief Function to set the timer frequency. The counter keeps its value.
  * @param desc - timer descriptor.
  * @param freq_hz - the timer frequency value to be set.
  * @return 0 in case of success, negative errno error codes otherwise.
@@ -232,11 +372,28 @@ int linux_timer_count_clk_get(struct no_os_timer_desc *desc,
 int linux_timer_count_clk_set(struct no_os_timer_desc *desc,
 			      uint32_t freq_hz)
 {
-	return -ENOSYS;
+	struct linux_timer_desc *linux_desc;
+	uint64_t now, ticks;
+	int ret;
+
+	if (!freq_hz)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+
+	linux_irq_lock();
+	now = linux_irq_time_ns();
+	ticks = linux_timer_ns_to_ticks(desc, now - linux_desc->start_ns);
+	desc->freq_hz = freq_hz;
+	linux_desc->start_ns = now - linux_timer_ticks_to_ns(desc, ticks);
+	ret = linux_timer_arm(desc);
+	linux_irq_unlock();
+
+	return ret;
 }
 
 /**
- * @brief Not implemented
+ * @brief Get the time elapsed since the timer was started.
  * @param desc - timer descriptor
  * @param elapsed_time - time in nanoseconds
  * @return 0 in case of success, negative errno error codes otherwise.
@@ -245,15 +402,10 @@ int linux_timer_get_elapsed_time_nsec(struct no_os_timer_desc *desc,
 				      uint64_t *elapsed_time)
 {
 	struct linux_timer_desc *linux_desc;
-	struct timespec curr_value;
 
 	linux_desc = desc->extra;
 
-	clock_gettime(CLOCK_REALTIME, &curr_value);
-
-	*elapsed_time = curr_value.tv_sec * 1000000000 + curr_value.tv_nsec -
-			linux_desc->start_time.tv_sec * 1000000000 -
-			linux_desc->start_time.tv_nsec;
+	*elapsed_time = linux_irq_time_ns() - linux_desc->start_ns;
 
 	return 0;
 }
@@ -273,4 +425,3 @@ const struct no_os_timer_platform_ops linux_timer_ops = {
 	(int32_t (*)())linux_timer_get_elapsed_time_nsec,
 	.remove = (int32_t (*)())linux_timer_remove
 };
-
@@ -45,6 +45,17 @@
 /******************************************************************************/
 #include "no_os_timer.h"
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/*
+ * Each period (ticks_count at freq_hz) the timer raises the line of
+ * linux_irq_ops with the same number as its id.
+ */
+#define LINUX_TIMER_IRQ_ID(id)		(id)
+/* Counter frequency used when freq_hz is 0. */
+#define LINUX_TIMER_DEFAULT_FREQ_HZ	1000
+
 /**
  * @brief Linux specific timer platform ops.
  */
@@ -42,6 +42,8 @@
 /******************************************************************************/
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_lf256fifo.h"
+#include "linux_irq.h"
 #include "linux_uart.h"
 
 #include <fcntl.h>
@@ -70,6 +72,36 @@ struct linux_uart_desc {
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/**
+ * @brief Move the received data to the software FIFO. Called by the event
+ * thread of linux_irq when the device is readable.
+ * @param ctx - The UART descriptor.
+ */
+static void linux_uart_rx_handler(void *ctx)
+{
+	struct no_os_uart_desc *desc = ctx;
+	struct linux_uart_desc *linux_desc = desc->extra;
+	uint8_t discard[256];
+	uint32_t len;
+	uint8_t *buf;
+	ssize_t ret;
+
+	do {
+		len = lf256fifo_peek_write(desc->rx_fifo, &buf);
+		if (len) {
+			ret = read(linux_desc->fd, buf, len);
+			if (ret > 0)
+				lf256fifo_commit_write(desc->rx_fifo, ret);
+		} else {
+			/* FIFO full, drop the data (counted as overflow) */
+			len = sizeof(discard);
+			ret = read(linux_desc->fd, discard, len);
+			if (ret > 0)
+				lf256fifo_write_n(desc->rx_fifo, discard, ret);
+		}
+	} while (ret == (ssize_t)len);
+}
+
 /**
  * @brief Initialize the UART communication peripheral.
  * @param desc - The UART descriptor.
@@ -86,7 +118,7 @@ static int32_t linux_uart_init(struct no_os_uart_desc **desc,
 	char path[64];
 	int ret;
 
-	descriptor = no_os_malloc(sizeof(*descriptor));
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
 	if (!descriptor)
 		return -ENOMEM;
 
@@ -169,6 +201,36 @@ static int32_t linux_uart_init(struct no_os_uart_desc **desc,
 	case 38400:
 		speed = B38400;
 		break;
+	case 57600:
+		speed = B57600;
+		break;
+	case 115200:
+		speed = B115200;
+		break;
+	case 230400:
+		speed = B230400;
+		break;
+	case 460800:
+		speed = B460800;
+		break;
+	case 921600:
+		speed = B921600;
+		break;
+	case 1000000:
+		speed = B1000000;
+		break;
+	case 1500000:
+		speed = B1500000;
+		break;
+	case 2000000:
+		speed = B2000000;
+		break;
+	case 3000000:
+		speed = B3000000;
+		break;
+	case 4000000:
+		speed = B4000000;
+		break;
 	default:
 		ret = -EINVAL;
 		goto free;
@@ -222,10 +284,24 @@ static int32_t linux_uart_init(struct no_os_uart_desc **desc,
 
 	tcflush(linux_desc->fd, TCIOFLUSH);
 
+	if (param->asynchronous_rx) {
+		ret = lf256fifo_init_size(&descriptor->rx_fifo,
+					  param->rx_fifo_size);
+		if (ret)
+			goto free;
+
+		ret = linux_irq_watch_fd(linux_desc->fd, linux_uart_rx_handler,
+					 descriptor);
+		if (ret)
+			goto free_fifo;
+	}
+
 	*desc = descriptor;
 
 	return 0;
 
+free_fifo:
+	lf256fifo_remove(descriptor->rx_fifo);
 free:
 	close(linux_desc->fd);
 free_terminal:
@@ -250,10 +326,16 @@ static int32_t linux_uart_remove(struct no_os_uart_desc *desc)
 
 	linux_desc = desc->extra;
 
+	if (desc->rx_fifo) {
+		linux_irq_unwatch_fd(linux_desc->fd);
+		lf256fifo_remove(desc->rx_fifo);
+	}
+
 	ret = close(linux_desc->fd);
 	if (ret < 0)
 		printf("%s: Can't close device\n\r", __func__);
 
+	no_os_free(linux_desc->terminal);
 	no_os_free(desc->extra);
 	no_os_free(desc);
 
@@ -291,7 +373,8 @@ static int32_t linux_uart_write(struct no_os_uart_desc *desc,
  * @param desc - Instance of UART.
  * @param data - Pointer to buffer containing data.
  * @param bytes_number - Number of bytes to read.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, -1 otherwise. With asynchronous_rx, the number
+ * of bytes taken from the software FIFO or -EAGAIN if it is empty.
  */
 static int32_t linux_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 			       uint32_t bytes_number)
@@ -302,6 +385,11 @@ static int32_t linux_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 
 	linux_desc = desc->extra;
 
+	if (desc->rx_fifo) {
+		count = lf256fifo_read_n(desc->rx_fifo, data, bytes_number);
+		return count ? (int32_t)count : -EAGAIN;
+	}
+
 	while (count < bytes_number) {
 		ret = read(linux_desc->fd, &data[count], bytes_number - count);
 		if (ret > 0)
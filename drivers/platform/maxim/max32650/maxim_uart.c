@@ -113,12 +113,8 @@ static int32_t max_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 		return -EINVAL;
 
 	if (desc->rx_fifo) {
-		for (i = 0; i < bytes_number; i++) {
-			ret = lf256fifo_read(desc->rx_fifo, &data[i]);
-			if (ret)
-				return i ? (int32_t)i : -EAGAIN;
-		}
-		return i;
+		i = lf256fifo_read_n(desc->rx_fifo, data, bytes_number);
+		return i ? (int32_t)i : -EAGAIN;
 	}
 
 	ret = MXC_UART_Read(MXC_UART_GET_UART(desc->device_id), data,
@@ -238,7 +234,17 @@ static int32_t max_uart_write_nonblocking(struct no_os_uart_desc *desc,
 void uart_rx_callback(void *context)
 {
 	struct no_os_uart_desc *d = context;
+	uint32_t len;
+	uint8_t *buf;
+
 	lf256fifo_write(d->rx_fifo, c);
+	/* Move what else is in the hardware FIFO with a single call */
+	len = lf256fifo_peek_write(d->rx_fifo, &buf);
+	if (len) {
+		len = MXC_UART_ReadRXFIFO(MXC_UART_GET_UART(d->device_id), buf,
+					  len);
+		lf256fifo_commit_write(d->rx_fifo, len);
+	}
 	max_uart_read_nonblocking(d, &c, 1);
 }
 
@@ -380,7 +386,8 @@ static int32_t max_uart_init(struct no_os_uart_desc **desc,
 	*desc = descriptor;
 
 	if (param->asynchronous_rx) {
-		ret = lf256fifo_init(&descriptor->rx_fifo);
+		ret = lf256fifo_init_size(&descriptor->rx_fifo,
+					  param->rx_fifo_size);
 		if (ret)
 			goto error_uart;
 
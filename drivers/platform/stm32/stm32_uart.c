@@ -130,7 +130,8 @@ static int32_t stm32_uart_init(struct no_os_uart_desc **desc,
 
 	// nonblocking uart_read
 	if(param->asynchronous_rx) {
-		ret = lf256fifo_init(&descriptor->rx_fifo);
+		ret = lf256fifo_init_size(&descriptor->rx_fifo,
+					  param->rx_fifo_size);
 		if (ret < 0)
 			goto error;
 
@@ -271,13 +272,8 @@ static int32_t stm32_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 	sud = desc->extra;
 
 	if (desc->rx_fifo) {
-		while(i < bytes_number) {
-			ret = lf256fifo_read(desc->rx_fifo, &data[i]);
-			if (ret < 0)
-				return i ? i : -EAGAIN;
-			i++;
-		}
-		return i;
+		i = lf256fifo_read_n(desc->rx_fifo, data, bytes_number);
+		return i ? i : -EAGAIN;
 	} else {
 		ret = HAL_UART_Receive(sud->huart, (uint8_t *)data, bytes_number,
 				       sud->timeout);
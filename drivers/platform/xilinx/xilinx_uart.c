@@ -78,7 +78,7 @@ static int32_t uart_fifo_insert(struct no_os_uart_desc *desc)
 		ret = no_os_irq_disable(irq_desc, xil_uart_desc->irq_id);
 		if (ret < 0)
 			return ret;
-		ret = no_os_fifo_insert(&xil_uart_desc->fifo, xil_uart_desc->buff,
+		ret = no_os_fifo_insert(xil_uart_desc->fifo, xil_uart_desc->buff,
 					xil_uart_desc->bytes_received);
 		if (ret < 0)
 			return ret;
@@ -117,25 +117,26 @@ static int32_t xil_uart_read_byte(struct no_os_uart_desc *desc, uint8_t *data)
 	XUartLite *instance = xil_uart_desc->instance;
 #endif
 #ifdef XUARTPS_H
+	struct no_os_fifo_element *element;
 	int32_t ret;
 #endif
 
 	switch(xil_uart_desc->type) {
 	case UART_PS:
 #ifdef XUARTPS_H
-		while (xil_uart_desc->fifo == NULL) {
+		while (!(element = no_os_fifo_read(xil_uart_desc->fifo))) {
 			/* nothing in fifo, wait until something is received */
 			ret = uart_fifo_insert(desc);
 			if (ret < 0)
 				return ret;
 		}
 
-		*data = xil_uart_desc->fifo->data[xil_uart_desc->fifo_read_offset];
+		*data = element->data[xil_uart_desc->fifo_read_offset];
 		xil_uart_desc->fifo_read_offset++;
 
-		if (xil_uart_desc->fifo->len - xil_uart_desc->fifo_read_offset <= 0) {
+		if (element->len - xil_uart_desc->fifo_read_offset <= 0) {
 			xil_uart_desc->fifo_read_offset = 0;
-			xil_uart_desc->fifo = no_os_fifo_remove(xil_uart_desc->fifo);
+			no_os_fifo_release(xil_uart_desc->fifo);
 		}
 #endif // XUARTPS_H
 		break;
@@ -399,6 +400,11 @@ static int32_t xil_uart_init(struct no_os_uart_desc **desc,
 		xil_uart_desc->instance = no_os_calloc(1, sizeof(XUartPs));
 		if (!(xil_uart_desc->instance))
 			goto error_free_xil_uart_desc;
+
+		status = no_os_fifo_init(&xil_uart_desc->fifo, UART_BUFF_LENGTH,
+					 UART_FIFO_PREALLOC, 0);
+		if (status)
+			goto error_free_instance;
 		/*
 		 * Initialize the UART driver so that it's ready to use
 		 * Look up the configuration in the config table, then initialize it.
@@ -469,6 +475,8 @@ static int32_t xil_uart_init(struct no_os_uart_desc **desc,
 	return 0;
 
 error_free_instance:
+	if (xil_uart_desc->fifo)
+		no_os_fifo_remove(xil_uart_desc->fifo);
 	no_os_free(xil_uart_desc->instance);
 error_free_xil_uart_desc:
 	no_os_free(xil_uart_desc);
@@ -486,6 +494,8 @@ error_free_descriptor:
 static int32_t xil_uart_remove(struct no_os_uart_desc *desc)
 {
 	struct xil_uart_desc *xil_uart_desc = desc->extra;
+	if (xil_uart_desc->fifo)
+		no_os_fifo_remove(xil_uart_desc->fifo);
 	no_os_free(xil_uart_desc->instance);
 	no_os_free(xil_uart_desc);
 	no_os_free(desc);
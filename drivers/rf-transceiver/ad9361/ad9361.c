@@ -690,15 +690,15 @@ const char *ad9361_ensm_states[] = {
 };
 
 /**
- * SPI multiple bytes register read.
+ * SPI multiple bytes register read, bypassing the register cache.
  * @param spi
  * @param reg The register address.
  * @param rbuf The data buffer.
  * @param num The number of bytes to read.
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
-			 uint8_t *rbuf, uint32_t num)
+static int32_t __ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
+				  uint8_t *rbuf, uint32_t num)
 {
 	int32_t ret = 0;
 	uint16_t cmd;
@@ -734,16 +734,16 @@ int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
 
 /**
  * SPI register read.
- * @param spi
+ * @param phy The AD9361 state structure.
  * @param reg The register address.
  * @return The register value or negative error code in case of failure.
  */
-int32_t ad9361_spi_read(struct no_os_spi_desc *spi, uint32_t reg)
+int32_t ad9361_spi_read(struct ad9361_rf_phy *phy, uint32_t reg)
 {
 	uint8_t buf;
 	int32_t ret;
 
-	ret = ad9361_spi_readm(spi, reg, &buf, 1);
+	ret = ad9361_spi_readm(phy, reg, &buf, 1);
 	if (ret < 0)
 		return ret;
 
@@ -761,7 +761,7 @@ int32_t ad9361_reg_read(struct ad9361_rf_phy *phy, uint32_t reg, uint32_t *val)
 {
 	int32_t ret;
 
-	ret = ad9361_spi_read(phy->spi, reg);
+	ret = ad9361_spi_read(phy, reg);
 	if (ret < 0)
 		return ret;
 
@@ -772,13 +772,13 @@ int32_t ad9361_reg_read(struct ad9361_rf_phy *phy, uint32_t reg, uint32_t *val)
 
 /**
  * SPI register bits read.
- * @param spi
+ * @param phy The AD9361 state structure.
  * @param reg The register address.
  * @param mask The bits mask.
  * @param offset The mask offset.
  * @return The bits value or negative error code in case of failure.
  */
-static int32_t __ad9361_spi_readf(struct no_os_spi_desc *spi, uint32_t reg,
+static int32_t __ad9361_spi_readf(struct ad9361_rf_phy *phy, uint32_t reg,
 				  uint32_t mask, uint32_t offset)
 {
 	uint8_t buf;
@@ -787,7 +787,7 @@ static int32_t __ad9361_spi_readf(struct no_os_spi_desc *spi, uint32_t reg,
 	if (!mask)
 		return -EINVAL;
 
-	ret = ad9361_spi_readm(spi, reg, &buf, 1);
+	ret = ad9361_spi_readm(phy, reg, &buf, 1);
 	if (ret < 0)
 		return ret;
 
@@ -799,23 +799,23 @@ static int32_t __ad9361_spi_readf(struct no_os_spi_desc *spi, uint32_t reg,
 
 /**
  * SPI register bits read.
- * @param spi
+ * @param phy The AD9361 state structure.
  * @param reg The register address.
  * @param mask The bits mask.
  * @return The bits value or negative error code in case of failure.
  */
-#define ad9361_spi_readf(spi, reg, mask) \
-	__ad9361_spi_readf(spi, reg, mask, find_first_bit(mask))
+#define ad9361_spi_readf(phy, reg, mask) \
+	__ad9361_spi_readf(phy, reg, mask, find_first_bit(mask))
 
 /**
- * SPI register write.
+ * SPI register write, bypassing the register cache.
  * @param spi
  * @param reg The register address.
  * @param val The value of the register.
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
-			 uint32_t reg, uint32_t val)
+static int32_t __ad9361_spi_write(struct no_os_spi_desc *spi,
+				  uint32_t reg, uint32_t val)
 {
 	uint8_t buf[3];
 	int32_t ret;
@@ -826,7 +826,7 @@ int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 	buf[1] = cmd & 0xFF;
 	buf[2] = val;
 
-	ret = no_os_spi_write_and_read(spi, buf, 3);
+	ret = no_os_spi_queue_msg(spi, buf, NULL, 3);
 	if (ret < 0) {
 		dev_err(&spi->dev, "Write Error %"PRId32, ret);
 		return ret;
@@ -839,6 +839,138 @@ int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 	return 0;
 }
 
+/**
+ * Register cache backend: read a register from the device.
+ * @param ctx The SPI descriptor.
+ * @param reg The register address.
+ * @param val The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_regmap_read(void *ctx, uint32_t reg, uint32_t *val)
+{
+	uint8_t buf;
+	int32_t ret;
+
+	ret = __ad9361_spi_readm(ctx, reg, &buf, 1);
+	if (ret < 0)
+		return ret;
+
+	*val = buf;
+
+	return 0;
+}
+
+/**
+ * Register cache backend: write a register of the device.
+ * @param ctx The SPI descriptor.
+ * @param reg The register address.
+ * @param val The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_regmap_write(void *ctx, uint32_t reg, uint32_t val)
+{
+	return __ad9361_spi_write(ctx, reg, val);
+}
+
+static const struct no_os_regmap_bus_ops ad9361_regmap_ops = {
+	.reg_read = ad9361_regmap_read,
+	.reg_write = ad9361_regmap_write,
+};
+
+/*
+ * Configuration registers which are only changed by the driver. The
+ * calibration, status, table access and synthesizer registers are not cached.
+ */
+static const struct no_os_regmap_range ad9361_cached_regs[] = {
+	{ .min = REG_TX_ENABLE_FILTER_CTRL, .max = REG_TX_CLOCK_DATA_DELAY },
+	{ .min = REG_CLOCK_ENABLE, .max = REG_BBPLL },
+	{ .min = REG_PARALLEL_PORT_CONF_1, .max = REG_PARALLEL_PORT_CONF_3 },
+	{ .min = REG_AGC_GAIN_LOCK_DELAY, .max = REG_AUXDAC2_TX_DELAY },
+	{ .min = REG_REFERENCE_CLOCK_CYCLES, .max = REG_LVDS_INVERT_CTRL2 },
+	{ .min = REG_AGC_CONFIG_1, .max = REG_LARGE_LMT_OVERLOAD_THRESH },
+	{ .min = REG_FAST_CONFIG_1, .max = REG_FAST_INCREMENT_TIME },
+	{ .min = REG_AGC_INNER_LOW_THRESH, .max = REG_AGC_INNER_LOW_THRESH },
+	{ .min = REG_OUTER_POWER_THRESHS, .max = REG_EXT_LNA_LOW_GAIN },
+	{ .min = REG_MEASURE_DURATION_01, .max = REG_RSSI_CONFIG },
+};
+
+static const struct no_os_regmap_config ad9361_regmap_config = {
+	.max_register = 0x3FF,
+	.cache_table = ad9361_cached_regs,
+	.cache_table_len = NO_OS_ARRAY_SIZE(ad9361_cached_regs),
+	.cache_type = NO_OS_REGMAP_CACHE_FLAT,
+};
+
+/**
+ * Create the register cache of a device.
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_regmap_init(struct ad9361_rf_phy *phy)
+{
+	return no_os_regmap_init(&phy->regmap, &ad9361_regmap_ops, phy->spi,
+				 &ad9361_regmap_config);
+}
+
+/**
+ * Free the register cache of a device.
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_regmap_remove(struct ad9361_rf_phy *phy)
+{
+	no_os_regmap_remove(phy->regmap);
+	phy->regmap = NULL;
+
+	return 0;
+}
+
+/**
+ * SPI register write.
+ * @param phy The AD9361 state structure.
+ * @param reg The register address.
+ * @param val The value of the register.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_write(struct ad9361_rf_phy *phy,
+			 uint32_t reg, uint32_t val)
+{
+	if (!phy->regmap)
+		return __ad9361_spi_write(phy->spi, reg, val);
+
+	if (reg == REG_SPI_CONF && (val & SOFT_RESET))
+		no_os_regmap_cache_drop(phy->regmap);
+
+	return no_os_regmap_write(phy->regmap, reg, val);
+}
+
+/**
+ * SPI multiple bytes register read. Single byte reads of the cached registers
+ * are served from the register cache.
+ * @param phy The AD9361 state structure.
+ * @param reg The register address.
+ * @param rbuf The data buffer.
+ * @param num The number of bytes to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_readm(struct ad9361_rf_phy *phy, uint32_t reg,
+			 uint8_t *rbuf, uint32_t num)
+{
+	uint32_t val;
+	int32_t ret;
+
+	if (!phy->regmap || num != 1)
+		return __ad9361_spi_readm(phy->spi, reg, rbuf, num);
+
+	ret = no_os_regmap_read(phy->regmap, reg, &val);
+	if (ret < 0)
+		return ret;
+
+	rbuf[0] = val;
+
+	return 0;
+}
+
 /**
  * IIO SPI register write.
  * @param phy The AD9361 state structure.
@@ -849,19 +981,19 @@ int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 int32_t ad9361_reg_write(struct ad9361_rf_phy *phy,
 			 uint32_t reg, uint32_t val)
 {
-	return ad9361_spi_write(phy->spi, reg, val);
+	return ad9361_spi_write(phy, reg, val);
 }
 
 /**
  * SPI register bits write.
- * @param spi
+ * @param phy The AD9361 state structure.
  * @param reg The register address.
  * @param mask The bits mask.
  * @param offset The mask offset.
  * @param val The bits value.
  * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t __ad9361_spi_writef(struct no_os_spi_desc *spi, uint32_t reg,
+static int32_t __ad9361_spi_writef(struct ad9361_rf_phy *phy, uint32_t reg,
 				   uint32_t mask, uint32_t offset, uint32_t val)
 {
 	uint8_t buf;
@@ -870,38 +1002,43 @@ static int32_t __ad9361_spi_writef(struct no_os_spi_desc *spi, uint32_t reg,
 	if (!mask)
 		return -EINVAL;
 
-	ret = ad9361_spi_readm(spi, reg, &buf, 1);
+	if (phy->regmap)
+		return no_os_regmap_update_bits(phy->regmap, reg, mask,
+						val << offset);
+
+	ret = ad9361_spi_readm(phy, reg, &buf, 1);
 	if (ret < 0)
 		return ret;
 
 	buf &= ~mask;
 	buf |= ((val << offset) & mask);
 
-	return ad9361_spi_write(spi, reg, buf);
+	return ad9361_spi_write(phy, reg, buf);
 }
 
 /**
  * SPI register bits write.
- * @param spi
+ * @param phy The AD9361 state structure.
  * @param reg The register address.
  * @param mask The bits mask.
  * @param val The bits value.
  * @return 0 in case of success, negative error code otherwise.
  */
-#define ad9361_spi_writef(spi, reg, mask, val) \
-	__ad9361_spi_writef(spi, reg, mask, find_first_bit(mask), val)
+#define ad9361_spi_writef(phy, reg, mask, val) \
+	__ad9361_spi_writef(phy, reg, mask, find_first_bit(mask), val)
 
 /**
  * SPI multiple bytes register write.
- * @param spi
+ * @param phy The AD9361 state structure.
  * @param reg The register address.
  * @param tbuf The data buffer.
  * @param num The number of bytes to read.
  * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t ad9361_spi_writem(struct no_os_spi_desc *spi,
+static int32_t ad9361_spi_writem(struct ad9361_rf_phy *phy,
 				 uint32_t reg, uint8_t *tbuf, uint32_t num)
 {
+	struct no_os_spi_desc *spi = phy->spi;
 	uint8_t buf[10];
 	int32_t ret;
 	uint16_t cmd;
@@ -920,7 +1057,7 @@ static int32_t ad9361_spi_writem(struct no_os_spi_desc *spi,
 	for (i = 0; i < num; i++)
 		buf[2 + i] =  tbuf[i];
 #endif
-	ret = no_os_spi_write_and_read(spi, buf, num + 2);
+	ret = no_os_spi_queue_msg(spi, buf, NULL, num + 2);
 	if (ret < 0) {
 		dev_err(&spi->dev, "Write Error %"PRId32, ret);
 		return ret;
@@ -1047,6 +1184,8 @@ int32_t ad9361_1rx1tx_channel_map(struct ad9361_rf_phy *phy, bool tx,
  */
 int32_t ad9361_reset(struct ad9361_rf_phy *phy)
 {
+	no_os_regmap_cache_drop(phy->regmap);
+
 	if (phy->gpio_desc_resetb) {
 		no_os_gpio_set_value(phy->gpio_desc_resetb, 0);
 		no_os_mdelay(1);
@@ -1061,8 +1200,8 @@ int32_t ad9361_reset(struct ad9361_rf_phy *phy)
 	 * Please specify a RESET GPIO.
 	 */
 
-	ad9361_spi_write(phy->spi, REG_SPI_CONF, SOFT_RESET | _SOFT_RESET);
-	ad9361_spi_write(phy->spi, REG_SPI_CONF, 0x0);
+	ad9361_spi_write(phy, REG_SPI_CONF, SOFT_RESET | _SOFT_RESET);
+	ad9361_spi_write(phy, REG_SPI_CONF, 0x0);
 	dev_err(&phy->spi->dev,
 		"%s: by SPI, this may cause unpredicted behavior!", __func__);
 
@@ -1082,7 +1221,7 @@ int32_t ad9361_en_dis_tx(struct ad9361_rf_phy *phy, uint32_t tx_if,
 	if ((tx_if & enable) > 1 && AD9364_DEVICE && enable)
 		return -EINVAL;
 
-	return ad9361_spi_writef(phy->spi, REG_TX_ENABLE_FILTER_CTRL,
+	return ad9361_spi_writef(phy, REG_TX_ENABLE_FILTER_CTRL,
 				 TX_CHANNEL_ENABLE(tx_if), enable);
 }
 
@@ -1099,7 +1238,7 @@ int32_t ad9361_en_dis_rx(struct ad9361_rf_phy *phy, uint32_t rx_if,
 	if ((rx_if & enable) > 1 && AD9364_DEVICE && enable)
 		return -EINVAL;
 
-	return ad9361_spi_writef(phy->spi, REG_RX_ENABLE_FILTER_CTRL,
+	return ad9361_spi_writef(phy, REG_RX_ENABLE_FILTER_CTRL,
 				 RX_CHANNEL_ENABLE(rx_if), enable);
 }
 
@@ -1134,7 +1273,7 @@ int32_t ad9361_bist_loopback(struct ad9361_rf_phy *phy, int32_t mode)
 
 	dev_dbg(&phy->spi->dev, "%s: mode %"PRId32, __func__, mode);
 
-	reg = ad9361_spi_read(phy->spi, REG_OBSERVE_CONFIG);
+	reg = ad9361_spi_read(phy, REG_OBSERVE_CONFIG);
 
 	phy->bist_loopback_mode = mode;
 
@@ -1144,12 +1283,12 @@ int32_t ad9361_bist_loopback(struct ad9361_rf_phy *phy, int32_t mode)
 		ad9361_int_loopback_fix_ch_cross(phy, false);
 		reg &= ~(DATA_PORT_SP_HD_LOOP_TEST_OE |
 			 DATA_PORT_LOOP_TEST_ENABLE);
-		return ad9361_spi_write(phy->spi, REG_OBSERVE_CONFIG, reg);
+		return ad9361_spi_write(phy, REG_OBSERVE_CONFIG, reg);
 	case 1:
 		/* loopback (AD9361 internal) TX->RX */
 		ad9361_hdl_loopback(phy, false);
 		ad9361_int_loopback_fix_ch_cross(phy, true);
-		sp_hd = ad9361_spi_read(phy->spi, REG_PARALLEL_PORT_CONF_3);
+		sp_hd = ad9361_spi_read(phy, REG_PARALLEL_PORT_CONF_3);
 		if ((sp_hd & SINGLE_PORT_MODE) && (sp_hd & HALF_DUPLEX_MODE))
 			reg |= DATA_PORT_SP_HD_LOOP_TEST_OE;
 		else
@@ -1157,14 +1296,14 @@ int32_t ad9361_bist_loopback(struct ad9361_rf_phy *phy, int32_t mode)
 
 		reg |= DATA_PORT_LOOP_TEST_ENABLE;
 
-		return ad9361_spi_write(phy->spi, REG_OBSERVE_CONFIG, reg);
+		return ad9361_spi_write(phy, REG_OBSERVE_CONFIG, reg);
 	case 2:
 		/* loopback (FPGA internal) RX->TX */
 		ad9361_hdl_loopback(phy, true);
 		ad9361_int_loopback_fix_ch_cross(phy, false);
 		reg &= ~(DATA_PORT_SP_HD_LOOP_TEST_OE |
 			 DATA_PORT_LOOP_TEST_ENABLE);
-		return ad9361_spi_write(phy->spi, REG_OBSERVE_CONFIG, reg);
+		return ad9361_spi_write(phy, REG_OBSERVE_CONFIG, reg);
 	default:
 		return -EINVAL;
 	}
@@ -1209,7 +1348,7 @@ int32_t ad9361_bist_prbs(struct ad9361_rf_phy *phy, enum ad9361_bist_mode mode)
 
 	phy->bist_config = reg;
 
-	return ad9361_spi_write(phy->spi, REG_BIST_CONFIG, reg);
+	return ad9361_spi_write(phy, REG_BIST_CONFIG, reg);
 }
 
 /**
@@ -1275,11 +1414,11 @@ int32_t ad9361_bist_tone(struct ad9361_rf_phy *phy,
 		   BIST_MASK_CHANNEL_2_I_DATA | BIST_MASK_CHANNEL_2_Q_DATA;
 
 	reg1 = ((mask << 2) & reg_mask);
-	ad9361_spi_write(phy->spi, REG_BIST_AND_DATA_PORT_TEST_CONFIG, reg1);
+	ad9361_spi_write(phy, REG_BIST_AND_DATA_PORT_TEST_CONFIG, reg1);
 
 	phy->bist_config = reg;
 
-	return ad9361_spi_write(phy->spi, REG_BIST_CONFIG, reg);
+	return ad9361_spi_write(phy, REG_BIST_CONFIG, reg);
 }
 
 /**
@@ -1316,7 +1455,7 @@ static int32_t ad9361_check_cal_done(struct ad9361_rf_phy *phy, uint32_t reg,
 	uint32_t state;
 
 	do {
-		state = ad9361_spi_readf(phy->spi, reg, mask);
+		state = ad9361_spi_readf(phy, reg, mask);
 		if (state == done_state)
 			return 0;
 
@@ -1342,7 +1481,7 @@ static int32_t ad9361_check_cal_done(struct ad9361_rf_phy *phy, uint32_t reg,
  */
 static int32_t ad9361_run_calibration(struct ad9361_rf_phy *phy, uint32_t mask)
 {
-	int32_t ret = ad9361_spi_write(phy->spi, REG_CALIBRATION_CTRL, mask);
+	int32_t ret = ad9361_spi_write(phy, REG_CALIBRATION_CTRL, mask);
 	if (ret < 0)
 		return ret;
 
@@ -1466,13 +1605,13 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	tab = phy->gt_info[band].tab;
 	index_max = phy->gt_info[band].max_index;
 
-	ad9361_spi_writef(spi, REG_AGC_CONFIG_2,
+	ad9361_spi_writef(phy, REG_AGC_CONFIG_2,
 			  AGC_USE_FULL_GAIN_TABLE, !phy->pdata->split_gt);
 
-	ad9361_spi_write(spi, REG_MAX_LMT_FULL_GAIN,
+	ad9361_spi_write(phy, REG_MAX_LMT_FULL_GAIN,
 			 index_max - 1); /* Max Full/LMT Gain Table Index */
 
-	set_gain = ad9361_spi_readf(spi, REG_RX1_MANUAL_LMT_FULL_GAIN,
+	set_gain = ad9361_spi_readf(phy, REG_RX1_MANUAL_LMT_FULL_GAIN,
 				    RX_FULL_TBL_IDX_MASK);
 
 	if (phy->current_table != NO_GAIN_TABLE) {
@@ -1484,7 +1623,7 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 		rx1_gain = phy->gt_info[band].abs_gain_tbl[set_gain];
 	}
 
-	set_gain = ad9361_spi_readf(spi, REG_RX2_MANUAL_LMT_FULL_GAIN,
+	set_gain = ad9361_spi_readf(phy, REG_RX2_MANUAL_LMT_FULL_GAIN,
 				    RX_FULL_TBL_IDX_MASK);
 
 	if (phy->current_table != NO_GAIN_TABLE) {
@@ -1499,7 +1638,11 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	lna = phy->pdata->elna_ctrl.elna_in_gaintable_all_index_en ?
 	      EXT_LNA_CTRL : 0;
 
-	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
+	ret = no_os_spi_batch_begin(spi);
+	if (ret < 0)
+		return ret;
+
+	ad9361_spi_write(phy, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
 			 RECEIVER_SELECT(dest)); /* Start Gain Table Clock */
 
 	/* TX QUAD Calibration */
@@ -1511,20 +1654,20 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	phy->tx_quad_lpf_tia_match = -EINVAL;
 
 	for (i = 0; i < index_max; i++) {
-		ad9361_spi_write(spi, REG_GAIN_TABLE_ADDRESS, i); /* Gain Table Index */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA1,
+		ad9361_spi_write(phy, REG_GAIN_TABLE_ADDRESS, i); /* Gain Table Index */
+		ad9361_spi_write(phy, REG_GAIN_TABLE_WRITE_DATA1,
 				 tab[i][0] | lna); /* Ext LNA, Int LNA, & Mixer Gain Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA2,
+		ad9361_spi_write(phy, REG_GAIN_TABLE_WRITE_DATA2,
 				 tab[i][1]); /* TIA & LPF Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA3,
+		ad9361_spi_write(phy, REG_GAIN_TABLE_WRITE_DATA3,
 				 tab[i][2]); /* DC Cal bit & Dig Gain Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG,
+		ad9361_spi_write(phy, REG_GAIN_TABLE_CONFIG,
 				 START_GAIN_TABLE_CLOCK |
 				 WRITE_GAIN_TABLE |
 				 RECEIVER_SELECT(dest)); /* Gain Table Index */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
+		ad9361_spi_write(phy, REG_GAIN_TABLE_READ_DATA1,
 				 0); /* Dummy Write to delay 3 ADCCLK/16 cycles */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
+		ad9361_spi_write(phy, REG_GAIN_TABLE_READ_DATA1,
 				 0); /* Dummy Write to delay ~1u */
 
 		if ((tab[i][1] & lpf_tia_mask) == 0x20)
@@ -1532,13 +1675,17 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 
 	}
 
-	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
+	ad9361_spi_write(phy, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
 			 RECEIVER_SELECT(dest)); /* Clear Write Bit */
-	ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
+	ad9361_spi_write(phy, REG_GAIN_TABLE_READ_DATA1,
 			 0); /* Dummy Write to delay ~1u */
-	ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
+	ad9361_spi_write(phy, REG_GAIN_TABLE_READ_DATA1,
 			 0); /* Dummy Write to delay ~1u */
-	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, 0); /* Stop Gain Table Clock */
+	ad9361_spi_write(phy, REG_GAIN_TABLE_CONFIG, 0); /* Stop Gain Table Clock */
+
+	ret = no_os_spi_batch_end(spi);
+	if (ret < 0)
+		return ret;
 
 	phy->current_table = band;
 
@@ -1546,14 +1693,14 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	if (ret < 0)
 		ret = phy->gt_info[band].max_index - 1;
 
-	ad9361_spi_writef(spi, REG_RX1_MANUAL_LMT_FULL_GAIN,
+	ad9361_spi_writef(phy, REG_RX1_MANUAL_LMT_FULL_GAIN,
 			  RX_FULL_TBL_IDX_MASK, ret); /* Rx1 Full/LMT Gain Index */
 
 	ret = find_table_index(phy, rx2_gain);
 	if (ret < 0)
 		ret = phy->gt_info[band].max_index - 1;
 
-	ad9361_spi_write(spi, REG_RX2_MANUAL_LMT_FULL_GAIN,
+	ad9361_spi_write(phy, REG_RX2_MANUAL_LMT_FULL_GAIN,
 			 ret); /* Rx2 Full/LMT Gain Index */
 
 	return 0;
@@ -1568,16 +1715,16 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 static int32_t ad9361_setup_ext_lna(struct ad9361_rf_phy *phy,
 				    struct elna_control *ctrl)
 {
-	ad9361_spi_writef(phy->spi, REG_EXTERNAL_LNA_CTRL, EXTERNAL_LNA1_CTRL,
+	ad9361_spi_writef(phy, REG_EXTERNAL_LNA_CTRL, EXTERNAL_LNA1_CTRL,
 			  ctrl->elna_1_control_en);
 
-	ad9361_spi_writef(phy->spi, REG_EXTERNAL_LNA_CTRL, EXTERNAL_LNA2_CTRL,
+	ad9361_spi_writef(phy, REG_EXTERNAL_LNA_CTRL, EXTERNAL_LNA2_CTRL,
 			  ctrl->elna_2_control_en);
 
-	ad9361_spi_write(phy->spi, REG_EXT_LNA_HIGH_GAIN,
+	ad9361_spi_write(phy, REG_EXT_LNA_HIGH_GAIN,
 			 EXT_LNA_HIGH_GAIN(ctrl->gain_mdB / 500));
 
-	return ad9361_spi_write(phy->spi, REG_EXT_LNA_LOW_GAIN,
+	return ad9361_spi_write(phy, REG_EXT_LNA_LOW_GAIN,
 				EXT_LNA_LOW_GAIN(ctrl->bypass_loss_mdB / 500));
 }
 
@@ -1591,9 +1738,9 @@ static int32_t ad9361_clkout_control(struct ad9361_rf_phy *phy,
 				     enum ad9361_clkout mode)
 {
 	if (mode == CLKOUT_DISABLE)
-		return ad9361_spi_writef(phy->spi, REG_BBPLL, CLKOUT_ENABLE, 0);
+		return ad9361_spi_writef(phy, REG_BBPLL, CLKOUT_ENABLE, 0);
 
-	return ad9361_spi_writef(phy->spi, REG_BBPLL,
+	return ad9361_spi_writef(phy, REG_BBPLL,
 				 CLKOUT_ENABLE | CLKOUT_SELECT(~0),
 				 ((mode - 1) << 1) | 0x1);
 }
@@ -1605,35 +1752,39 @@ static int32_t ad9361_clkout_control(struct ad9361_rf_phy *phy,
  */
 static int32_t ad9361_load_mixer_gm_subtable(struct ad9361_rf_phy *phy)
 {
-	int32_t i, addr;
+	int32_t i, addr, ret;
 	dev_dbg(&phy->spi->dev, "%s", __func__);
 
-	ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_CONFIG,
+	ret = no_os_spi_batch_begin(phy->spi);
+	if (ret < 0)
+		return ret;
+
+	ad9361_spi_write(phy, REG_GM_SUB_TABLE_CONFIG,
 			 START_GM_SUB_TABLE_CLOCK); /* Start Clock */
 
 	for (i = 0, addr = NO_OS_ARRAY_SIZE(gm_st_ctrl);
 	     i < (int64_t)NO_OS_ARRAY_SIZE(gm_st_ctrl);
 	     i++) {
-		ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_ADDRESS,
+		ad9361_spi_write(phy, REG_GM_SUB_TABLE_ADDRESS,
 				 --addr); /* Gain Table Index */
-		ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_BIAS_WRITE, 0); /* Bias */
-		ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_GAIN_WRITE,
+		ad9361_spi_write(phy, REG_GM_SUB_TABLE_BIAS_WRITE, 0); /* Bias */
+		ad9361_spi_write(phy, REG_GM_SUB_TABLE_GAIN_WRITE,
 				 gm_st_gain[i]); /* Gain */
-		ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_CTRL_WRITE,
+		ad9361_spi_write(phy, REG_GM_SUB_TABLE_CTRL_WRITE,
 				 gm_st_ctrl[i]); /* Control */
-		ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_CONFIG,
+		ad9361_spi_write(phy, REG_GM_SUB_TABLE_CONFIG,
 				 WRITE_GM_SUB_TABLE | START_GM_SUB_TABLE_CLOCK); /* Write Words */
-		ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_GAIN_READ, 0); /* Dummy Delay */
-		ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_GAIN_READ, 0); /* Dummy Delay */
+		ad9361_spi_write(phy, REG_GM_SUB_TABLE_GAIN_READ, 0); /* Dummy Delay */
+		ad9361_spi_write(phy, REG_GM_SUB_TABLE_GAIN_READ, 0); /* Dummy Delay */
 	}
 
-	ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_CONFIG,
+	ad9361_spi_write(phy, REG_GM_SUB_TABLE_CONFIG,
 			 START_GM_SUB_TABLE_CLOCK); /* Clear Write */
-	ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_GAIN_READ, 0); /* Dummy Delay */
-	ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_GAIN_READ, 0); /* Dummy Delay */
-	ad9361_spi_write(phy->spi, REG_GM_SUB_TABLE_CONFIG, 0); /* Stop Clock */
+	ad9361_spi_write(phy, REG_GM_SUB_TABLE_GAIN_READ, 0); /* Dummy Delay */
+	ad9361_spi_write(phy, REG_GM_SUB_TABLE_GAIN_READ, 0); /* Dummy Delay */
+	ad9361_spi_write(phy, REG_GM_SUB_TABLE_CONFIG, 0); /* Stop Clock */
 
-	return 0;
+	return no_os_spi_batch_end(phy->spi);
 }
 
 /**
@@ -1662,17 +1813,17 @@ int32_t ad9361_set_tx_atten(struct ad9361_rf_phy *phy, uint32_t atten_mdb,
 	buf[0] = atten_mdb >> 8;
 	buf[1] = atten_mdb & 0xFF;
 
-	ad9361_spi_writef(phy->spi, REG_TX2_DIG_ATTEN,
+	ad9361_spi_writef(phy, REG_TX2_DIG_ATTEN,
 			  IMMEDIATELY_UPDATE_TPC_ATTEN, 0);
 
 	if (tx1)
-		ret = ad9361_spi_writem(phy->spi, REG_TX1_ATTEN_1, buf, 2);
+		ret = ad9361_spi_writem(phy, REG_TX1_ATTEN_1, buf, 2);
 
 	if (tx2)
-		ret = ad9361_spi_writem(phy->spi, REG_TX2_ATTEN_1, buf, 2);
+		ret = ad9361_spi_writem(phy, REG_TX2_ATTEN_1, buf, 2);
 
 	if (immed)
-		ad9361_spi_writef(phy->spi, REG_TX2_DIG_ATTEN,
+		ad9361_spi_writef(phy, REG_TX2_DIG_ATTEN,
 				  IMMEDIATELY_UPDATE_TPC_ATTEN, 1);
 
 	return ret;
@@ -1690,7 +1841,7 @@ int32_t ad9361_get_tx_atten(struct ad9361_rf_phy *phy, uint32_t tx_num)
 	int32_t ret = 0;
 	uint32_t code;
 
-	ret = ad9361_spi_readm(phy->spi, (tx_num == 1) ?
+	ret = ad9361_spi_readm(phy, (tx_num == 1) ?
 			       REG_TX1_ATTEN_1 : REG_TX2_ATTEN_1, buf, 2);
 
 	if (ret < 0)
@@ -1760,7 +1911,6 @@ static int32_t ad9361_rfpll_vco_init(struct ad9361_rf_phy *phy,
 				     bool tx, uint64_t vco_freq,
 				     uint32_t ref_clk)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	const struct SynthLUT(*tab);
 	int32_t i = 0;
 	uint32_t range, offs = 0;
@@ -1799,36 +1949,36 @@ static int32_t ad9361_rfpll_vco_init(struct ad9361_rf_phy *phy,
 	dev_dbg(&phy->spi->dev, "%s : freq %d MHz : index %"PRId32,
 		__func__, tab[i].VCO_MHz, i);
 
-	ad9361_spi_write(spi, REG_RX_VCO_OUTPUT + offs,
+	ad9361_spi_write(phy, REG_RX_VCO_OUTPUT + offs,
 			 VCO_OUTPUT_LEVEL(tab[i].VCO_Output_Level) |
 			 PORB_VCO_LOGIC);
-	ad9361_spi_writef(spi, REG_RX_ALC_VARACTOR + offs,
+	ad9361_spi_writef(phy, REG_RX_ALC_VARACTOR + offs,
 			  VCO_VARACTOR(~0), tab[i].VCO_Varactor);
-	ad9361_spi_write(spi, REG_RX_VCO_BIAS_1 + offs,
+	ad9361_spi_write(phy, REG_RX_VCO_BIAS_1 + offs,
 			 VCO_BIAS_REF(tab[i].VCO_Bias_Ref) |
 			 VCO_BIAS_TCF(tab[i].VCO_Bias_Tcf));
 
-	ad9361_spi_write(spi, REG_RX_FORCE_VCO_TUNE_1 + offs,
+	ad9361_spi_write(phy, REG_RX_FORCE_VCO_TUNE_1 + offs,
 			 VCO_CAL_OFFSET(tab[i].VCO_Cal_Offset));
-	ad9361_spi_write(spi, REG_RX_VCO_VARACTOR_CTRL_1 + offs,
+	ad9361_spi_write(phy, REG_RX_VCO_VARACTOR_CTRL_1 + offs,
 			 VCO_VARACTOR_REFERENCE(
 				 tab[i].VCO_Varactor_Reference));
 
-	ad9361_spi_write(spi, REG_RX_VCO_CAL_REF + offs, VCO_CAL_REF_TCF(0));
+	ad9361_spi_write(phy, REG_RX_VCO_CAL_REF + offs, VCO_CAL_REF_TCF(0));
 
-	ad9361_spi_write(spi, REG_RX_VCO_VARACTOR_CTRL_0 + offs,
+	ad9361_spi_write(phy, REG_RX_VCO_VARACTOR_CTRL_0 + offs,
 			 VCO_VARACTOR_OFFSET(0) |
 			 VCO_VARACTOR_REFERENCE_TCF(7));
 
-	ad9361_spi_writef(spi, REG_RX_CP_CURRENT + offs, CHARGE_PUMP_CURRENT(~0),
+	ad9361_spi_writef(phy, REG_RX_CP_CURRENT + offs, CHARGE_PUMP_CURRENT(~0),
 			  tab[i].Charge_Pump_Current);
-	ad9361_spi_write(spi, REG_RX_LOOP_FILTER_1 + offs,
+	ad9361_spi_write(phy, REG_RX_LOOP_FILTER_1 + offs,
 			 LOOP_FILTER_C2(tab[i].LF_C2) |
 			 LOOP_FILTER_C1(tab[i].LF_C1));
-	ad9361_spi_write(spi, REG_RX_LOOP_FILTER_2 + offs,
+	ad9361_spi_write(phy, REG_RX_LOOP_FILTER_2 + offs,
 			 LOOP_FILTER_R1(tab[i].LF_R1) |
 			 LOOP_FILTER_C3(tab[i].LF_C3));
-	ad9361_spi_write(spi, REG_RX_LOOP_FILTER_3 + offs,
+	ad9361_spi_write(phy, REG_RX_LOOP_FILTER_3 + offs,
 			 LOOP_FILTER_R3(tab[i].LF_R3));
 
 	return 0;
@@ -1845,35 +1995,34 @@ static int32_t ad9361_get_split_table_gain(struct ad9361_rf_phy *phy,
 		uint32_t idx_reg,
 		struct rf_rx_gain *rx_gain)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t val, tbl_addr;
 	int32_t rc = 0;
 
 
-	rx_gain->fgt_lmt_index = ad9361_spi_readf(spi, idx_reg,
+	rx_gain->fgt_lmt_index = ad9361_spi_readf(phy, idx_reg,
 				 FULL_TABLE_GAIN_INDEX(~0));
-	tbl_addr = ad9361_spi_read(spi, REG_GAIN_TABLE_ADDRESS);
+	tbl_addr = ad9361_spi_read(phy, REG_GAIN_TABLE_ADDRESS);
 
-	ad9361_spi_write(spi, REG_GAIN_TABLE_ADDRESS, rx_gain->fgt_lmt_index);
+	ad9361_spi_write(phy, REG_GAIN_TABLE_ADDRESS, rx_gain->fgt_lmt_index);
 
-	val = ad9361_spi_read(spi, REG_GAIN_TABLE_READ_DATA1);
+	val = ad9361_spi_read(phy, REG_GAIN_TABLE_READ_DATA1);
 	rx_gain->lna_index = TO_LNA_GAIN(val);
 	rx_gain->mixer_index = TO_MIXER_GM_GAIN(val);
 
-	rx_gain->tia_index = ad9361_spi_readf(spi, REG_GAIN_TABLE_READ_DATA2, TIA_GAIN);
+	rx_gain->tia_index = ad9361_spi_readf(phy, REG_GAIN_TABLE_READ_DATA2, TIA_GAIN);
 
 	rx_gain->lmt_gain = lna_table[ad9361_gt(phy) -
 				      RXGAIN_TBLS_END][rx_gain->lna_index] +
 			    mixer_table[ad9361_gt(phy) - RXGAIN_TBLS_END][rx_gain->mixer_index] +
 			    tia_table[rx_gain->tia_index];
 
-	ad9361_spi_write(spi, REG_GAIN_TABLE_ADDRESS, tbl_addr);
+	ad9361_spi_write(phy, REG_GAIN_TABLE_ADDRESS, tbl_addr);
 
 	/* Read LPF Index */
-	rx_gain->lpf_gain = ad9361_spi_readf(spi, idx_reg + 1, LPF_GAIN_RX(~0));
+	rx_gain->lpf_gain = ad9361_spi_readf(phy, idx_reg + 1, LPF_GAIN_RX(~0));
 
 	/* Read Digital Gain */
-	rx_gain->digital_gain = ad9361_spi_readf(spi, idx_reg + 2,
+	rx_gain->digital_gain = ad9361_spi_readf(phy, idx_reg + 2,
 				DIGITAL_GAIN_RX(~0));
 
 	rx_gain->gain_db = rx_gain->lmt_gain + rx_gain->lpf_gain +
@@ -1892,13 +2041,12 @@ static int32_t ad9361_get_full_table_gain(struct ad9361_rf_phy *phy,
 		uint32_t idx_reg,
 		struct rf_rx_gain *rx_gain)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t val;
 
-	rx_gain->fgt_lmt_index = val = ad9361_spi_readf(spi, idx_reg,
+	rx_gain->fgt_lmt_index = val = ad9361_spi_readf(phy, idx_reg,
 				       FULL_TABLE_GAIN_INDEX(~0));
 	/* Read Digital Gain */
-	rx_gain->digital_gain = ad9361_spi_readf(spi, idx_reg + 2,
+	rx_gain->digital_gain = ad9361_spi_readf(phy, idx_reg + 2,
 				DIGITAL_GAIN_RX(~0));
 
 	rx_gain->gain_db = phy->gt_info[ad9361_gt(phy)].abs_gain_tbl[val];
@@ -1916,7 +2064,6 @@ static int32_t ad9361_get_full_table_gain(struct ad9361_rf_phy *phy,
 int32_t ad9361_get_rx_gain(struct ad9361_rf_phy *phy,
 			   uint32_t rx_id, struct rf_rx_gain *rx_gain)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t val, idx_reg;
 	uint8_t gain_ctl_shift, rx_enable_mask;
 	uint8_t fast_atk_shift;
@@ -1939,7 +2086,7 @@ int32_t ad9361_get_rx_gain(struct ad9361_rf_phy *phy,
 		goto out;
 	}
 
-	val = ad9361_spi_readf(spi, REG_RX_ENABLE_FILTER_CTRL, rx_enable_mask);
+	val = ad9361_spi_readf(phy, REG_RX_ENABLE_FILTER_CTRL, rx_enable_mask);
 
 	if (!val) {
 		dev_dbg(dev, "Rx%"PRIu32" is not enabled", rx_gain->ant);
@@ -1947,7 +2094,7 @@ int32_t ad9361_get_rx_gain(struct ad9361_rf_phy *phy,
 		goto out;
 	}
 
-	val = ad9361_spi_read(spi, REG_AGC_CONFIG_1);
+	val = ad9361_spi_read(phy, REG_AGC_CONFIG_1);
 
 	val = (val >> gain_ctl_shift) & RX_GAIN_CTL_MASK;
 
@@ -1955,7 +2102,7 @@ int32_t ad9361_get_rx_gain(struct ad9361_rf_phy *phy,
 		/* In fast attack mode check whether Fast attack state machine
 		* has locked gain, if not then we can not read gain.
 		*/
-		val = ad9361_spi_read(spi, REG_FAST_ATTACK_STATE);
+		val = ad9361_spi_read(phy, REG_FAST_ATTACK_STATE);
 		val = (val >> fast_atk_shift) & FAST_ATK_MASK;
 		if (val != FAST_ATK_GAIN_LOCKED) {
 			dev_warn(dev, "Failed to read gain, state m/c at %"PRIx32,
@@ -1981,7 +2128,7 @@ out:
  */
 uint8_t ad9361_ensm_get_state(struct ad9361_rf_phy *phy)
 {
-	return ad9361_spi_readf(phy->spi, REG_STATE, ENSM_STATE(~0));
+	return ad9361_spi_readf(phy, REG_STATE, ENSM_STATE(~0));
 }
 
 /**
@@ -1994,12 +2141,11 @@ uint8_t ad9361_ensm_get_state(struct ad9361_rf_phy *phy)
  */
 void ad9361_ensm_force_state(struct ad9361_rf_phy *phy, uint8_t ensm_state)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint8_t dev_ensm_state;
 	int32_t rc, timeout = 10;
 	uint32_t val;
 
-	dev_ensm_state = ad9361_spi_readf(spi, REG_STATE, ENSM_STATE(~0));
+	dev_ensm_state = ad9361_spi_readf(phy, REG_STATE, ENSM_STATE(~0));
 
 	phy->prev_ensm_state = dev_ensm_state;
 
@@ -2012,7 +2158,7 @@ void ad9361_ensm_force_state(struct ad9361_rf_phy *phy, uint8_t ensm_state)
 	dev_dbg(dev, "Device is in %x state, forcing to %x", dev_ensm_state,
 		ensm_state);
 
-	val = ad9361_spi_read(spi, REG_ENSM_CONFIG_1);
+	val = ad9361_spi_read(phy, REG_ENSM_CONFIG_1);
 
 	/* Enable control through SPI writes, and take out from
 	* Alert
@@ -2046,9 +2192,9 @@ void ad9361_ensm_force_state(struct ad9361_rf_phy *phy, uint8_t ensm_state)
 		goto out;
 	}
 
-	ad9361_spi_write(spi, REG_ENSM_CONFIG_1, TO_ALERT | FORCE_ALERT_STATE);
+	ad9361_spi_write(phy, REG_ENSM_CONFIG_1, TO_ALERT | FORCE_ALERT_STATE);
 
-	rc = ad9361_spi_write(spi, REG_ENSM_CONFIG_1, val);
+	rc = ad9361_spi_write(phy, REG_ENSM_CONFIG_1, val);
 	if (rc) {
 		dev_err(dev, "Failed to write ENSM_CONFIG_1\n");
 		goto out;
@@ -2074,11 +2220,10 @@ out:
  */
 void ad9361_ensm_restore_state(struct ad9361_rf_phy *phy, uint8_t ensm_state)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	int32_t rc;
 	uint32_t val;
 
-	val = ad9361_spi_read(spi, REG_ENSM_CONFIG_1);
+	val = ad9361_spi_read(phy, REG_ENSM_CONFIG_1);
 
 	/* We are restoring state only, so clear State bits first
 	* which might have set while forcing a particular state
@@ -2106,9 +2251,9 @@ void ad9361_ensm_restore_state(struct ad9361_rf_phy *phy, uint8_t ensm_state)
 		return;
 	}
 
-	ad9361_spi_write(spi, REG_ENSM_CONFIG_1, TO_ALERT | FORCE_ALERT_STATE);
+	ad9361_spi_write(phy, REG_ENSM_CONFIG_1, TO_ALERT | FORCE_ALERT_STATE);
 
-	rc = ad9361_spi_write(spi, REG_ENSM_CONFIG_1, val);
+	rc = ad9361_spi_write(phy, REG_ENSM_CONFIG_1, val);
 	if (rc) {
 		dev_err(dev, "Failed to write ENSM_CONFIG_1");
 		return;
@@ -2116,7 +2261,7 @@ void ad9361_ensm_restore_state(struct ad9361_rf_phy *phy, uint8_t ensm_state)
 
 	if (phy->ensm_pin_ctl_en) {
 		val |= ENABLE_ENSM_PIN_CTRL;
-		rc = ad9361_spi_write(spi, REG_ENSM_CONFIG_1, val);
+		rc = ad9361_spi_write(phy, REG_ENSM_CONFIG_1, val);
 		if (rc)
 			dev_err(dev, "Failed to write ENSM_CONFIG_1");
 	}
@@ -2142,7 +2287,6 @@ void ad9361_ensm_restore_prev_state(struct ad9361_rf_phy *phy)
 static int32_t set_split_table_gain(struct ad9361_rf_phy *phy, uint32_t idx_reg,
 				    struct rf_rx_gain *rx_gain)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	int32_t rc = 0;
 
 	if ((rx_gain->fgt_lmt_index > MAX_LMT_INDEX) ||
@@ -2170,15 +2314,15 @@ static int32_t set_split_table_gain(struct ad9361_rf_phy *phy, uint32_t idx_reg,
 
 	rx_gain->fgt_lmt_index = rc;
 
-	rc = ad9361_spi_writef(spi, idx_reg, RX_FULL_TBL_IDX_MASK,
+	rc = ad9361_spi_writef(phy, idx_reg, RX_FULL_TBL_IDX_MASK,
 			       rx_gain->fgt_lmt_index);
 	if (rc < 0)
 		goto out;
-	rc = ad9361_spi_writef(spi, idx_reg + 1, RX_LPF_IDX_MASK, rx_gain->lpf_gain);
+	rc = ad9361_spi_writef(phy, idx_reg + 1, RX_LPF_IDX_MASK, rx_gain->lpf_gain);
 	if (rc < 0)
 		goto out;
 	if (phy->pdata->gain_ctrl.dig_gain_en) {
-		rc = ad9361_spi_writef(spi, idx_reg + 2, RX_DIGITAL_IDX_MASK,
+		rc = ad9361_spi_writef(phy, idx_reg + 2, RX_DIGITAL_IDX_MASK,
 				       rx_gain->digital_gain);
 	} else if (rx_gain->digital_gain > 0) {
 		dev_err(dev, "Digital gain is disabled and cannot be set");
@@ -2197,7 +2341,6 @@ out:
 static int32_t set_full_table_gain(struct ad9361_rf_phy *phy, uint32_t idx_reg,
 				   struct rf_rx_gain *rx_gain)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	int rc = 0;
 
 	if (rx_gain->fgt_lmt_index != ((uint32_t)~0) ||
@@ -2216,7 +2359,7 @@ static int32_t set_full_table_gain(struct ad9361_rf_phy *phy, uint32_t idx_reg,
 		goto out;
 	}
 
-	rc = ad9361_spi_writef(spi, idx_reg, RX_FULL_TBL_IDX_MASK, rc);
+	rc = ad9361_spi_writef(phy, idx_reg, RX_FULL_TBL_IDX_MASK, rc);
 out:
 	return rc;
 }
@@ -2231,7 +2374,6 @@ out:
 int32_t ad9361_set_rx_gain(struct ad9361_rf_phy *phy,
 			   uint32_t rx_id, struct rf_rx_gain *rx_gain)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t val, idx_reg;
 	uint8_t gain_ctl_shift;
 	int32_t rc = 0;
@@ -2250,7 +2392,7 @@ int32_t ad9361_set_rx_gain(struct ad9361_rf_phy *phy,
 
 	}
 
-	val = ad9361_spi_read(spi, REG_AGC_CONFIG_1);
+	val = ad9361_spi_read(phy, REG_AGC_CONFIG_1);
 	val = (val >> gain_ctl_shift) & RX_GAIN_CTL_MASK;
 
 	if (val != RX_GAIN_CTL_MGC) {
@@ -2281,7 +2423,6 @@ out:
  */
 static int32_t ad9361_gc_update(struct ad9361_rf_phy *phy)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t clkrf;
 	uint32_t reg, delay_lna, settling_delay, dec_pow_meas_dur;
 	int32_t ret;
@@ -2299,7 +2440,7 @@ static int32_t ad9361_gc_update(struct ad9361_rf_phy *phy)
 	reg = NO_OS_DIV_ROUND_UP(reg, 1000UL) +
 	      phy->pdata->gain_ctrl.agc_attack_delay_extra_margin_us;
 	reg = no_os_clamp_t(uint8_t, reg, 0U, 31U);
-	ret = ad9361_spi_writef(spi, REG_AGC_ATTACK_DELAY,
+	ret = ad9361_spi_writef(phy, REG_AGC_ATTACK_DELAY,
 				AGC_ATTACK_DELAY(~0), reg);
 
 	/*
@@ -2309,7 +2450,7 @@ static int32_t ad9361_gc_update(struct ad9361_rf_phy *phy)
 	reg = (delay_lna + 100UL) * (clkrf / 1000UL);
 	reg = NO_OS_DIV_ROUND_UP(reg, 1000000UL) + 1;
 	reg = no_os_clamp_t(uint8_t, reg, 0U, 31U);
-	ret |= ad9361_spi_writef(spi, REG_PEAK_WAIT_TIME,
+	ret |= ad9361_spi_writef(phy, REG_PEAK_WAIT_TIME,
 				 PEAK_OVERLOAD_WAIT_TIME(~0), reg);
 
 	/*
@@ -2320,7 +2461,7 @@ static int32_t ad9361_gc_update(struct ad9361_rf_phy *phy)
 	reg = (delay_lna + 200UL) * (clkrf / 2000UL);
 	reg = NO_OS_DIV_ROUND_UP(reg, 1000000UL) + 7;
 	reg = settling_delay = no_os_clamp_t(uint8_t, reg, 0U, 31U);
-	ret |= ad9361_spi_writef(spi, REG_FAST_CONFIG_2_SETTLING_DELAY,
+	ret |= ad9361_spi_writef(phy, REG_FAST_CONFIG_2_SETTLING_DELAY,
 				 SETTLING_DELAY(~0), reg);
 
 	/*
@@ -2347,19 +2488,19 @@ static int32_t ad9361_gc_update(struct ad9361_rf_phy *phy)
 	}
 
 	/* Power Measurement Duration */
-	ad9361_spi_writef(spi, REG_DEC_POWER_MEASURE_DURATION_0,
+	ad9361_spi_writef(phy, REG_DEC_POWER_MEASURE_DURATION_0,
 			  DEC_POWER_MEASUREMENT_DURATION(~0),
 			  ilog2(dec_pow_meas_dur / 16));
 
 
-	ret |= ad9361_spi_writef(spi, REG_DIGITAL_SAT_COUNTER,
+	ret |= ad9361_spi_writef(phy, REG_DIGITAL_SAT_COUNTER,
 				 DOUBLE_GAIN_COUNTER,  reg > 65535);
 
 	if (reg > 65535)
 		reg /= 2;
 
-	ret |= ad9361_spi_write(spi, REG_GAIN_UPDATE_COUNTER1, reg & 0xFF);
-	ret |= ad9361_spi_write(spi, REG_GAIN_UPDATE_COUNTER2, reg >> 8);
+	ret |= ad9361_spi_write(phy, REG_GAIN_UPDATE_COUNTER1, reg & 0xFF);
+	ret |= ad9361_spi_write(phy, REG_GAIN_UPDATE_COUNTER2, reg >> 8);
 
 	/*
 	 * Fast AGC State Wait Time - Energy Detect Count
@@ -2368,7 +2509,7 @@ static int32_t ad9361_gc_update(struct ad9361_rf_phy *phy)
 	reg = NO_OS_DIV_ROUND_CLOSEST(phy->pdata->gain_ctrl.f_agc_state_wait_time_ns *
 				      (clkrf / 1000UL), 1000000UL);
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 31U);
-	ret |= ad9361_spi_writef(spi, REG_FAST_ENERGY_DETECT_COUNT,
+	ret |= ad9361_spi_writef(phy, REG_FAST_ENERGY_DETECT_COUNT,
 				 ENERGY_DETECT_COUNT(~0),  reg);
 
 	return ret;
@@ -2384,12 +2525,11 @@ static int32_t ad9361_gc_update(struct ad9361_rf_phy *phy)
 int32_t ad9361_set_gain_ctrl_mode(struct ad9361_rf_phy *phy,
 				  struct rf_gain_ctrl *gain_ctrl)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	int32_t rc = 0;
 	uint32_t gain_ctl_shift, mode;
 	uint8_t val;
 
-	rc = ad9361_spi_readm(spi, REG_AGC_CONFIG_1, &val, 1);
+	rc = ad9361_spi_readm(phy, REG_AGC_CONFIG_1, &val, 1);
 	if (rc) {
 		dev_err(dev, "Unable to read AGC config1 register: %x",
 			REG_AGC_CONFIG_1);
@@ -2437,7 +2577,7 @@ int32_t ad9361_set_gain_ctrl_mode(struct ad9361_rf_phy *phy,
 	else
 		val &= ~SLOW_ATTACK_HYBRID_MODE;
 
-	rc = ad9361_spi_write(spi, REG_AGC_CONFIG_1, val);
+	rc = ad9361_spi_write(phy, REG_AGC_CONFIG_1, val);
 	if (rc) {
 		dev_err(dev, "Unable to write AGC config1 register: %x",
 			REG_AGC_CONFIG_1);
@@ -2458,11 +2598,10 @@ out:
  */
 int32_t ad9361_read_rssi(struct ad9361_rf_phy *phy, struct rf_rssi *rssi)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint8_t reg_val_buf[6];
 	int32_t rc;
 
-	rc = ad9361_spi_readm(spi, REG_PREAMBLE_LSB,
+	rc = ad9361_spi_readm(phy, REG_PREAMBLE_LSB,
 			      reg_val_buf, NO_OS_ARRAY_SIZE(reg_val_buf));
 	if (rssi->ant == 1) {
 		rssi->symbol = RSSI_RESOLUTION *
@@ -2506,9 +2645,9 @@ static int32_t ad9361_rx_adc_setup(struct ad9361_rf_phy *phy,
 	uint32_t i;
 	int32_t ret;
 
-	uint8_t c3_msb = ad9361_spi_read(phy->spi, REG_RX_BBF_C3_MSB);
-	uint8_t c3_lsb = ad9361_spi_read(phy->spi, REG_RX_BBF_C3_LSB);
-	uint8_t r2346 = ad9361_spi_read(phy->spi, REG_RX_BBF_R2346);
+	uint8_t c3_msb = ad9361_spi_read(phy, REG_RX_BBF_C3_MSB);
+	uint8_t c3_lsb = ad9361_spi_read(phy, REG_RX_BBF_C3_LSB);
+	uint8_t r2346 = ad9361_spi_read(phy, REG_RX_BBF_R2346);
 
 	/*
 	* BBBW = (BBPLL / RxTuneDiv) * ln(2) / (1.4 * 2PI )
@@ -2636,7 +2775,7 @@ static int32_t ad9361_rx_adc_setup(struct ad9361_rf_phy *phy,
 	data[39] = 0x00;
 
 	for (i = 0; i < 40; i++) {
-		ret = ad9361_spi_write(phy->spi, 0x200 + i, data[i]);
+		ret = ad9361_spi_write(phy, 0x200 + i, data[i]);
 		if (ret < 0)
 			return ret;
 	}
@@ -2655,9 +2794,9 @@ static int32_t ad9361_rx_tia_calib(struct ad9361_rf_phy *phy, uint32_t bb_bw_Hz)
 	uint32_t Cbbf, R2346;
 	uint64_t CTIA_fF;
 
-	uint8_t reg1EB = ad9361_spi_read(phy->spi, REG_RX_BBF_C3_MSB);
-	uint8_t reg1EC = ad9361_spi_read(phy->spi, REG_RX_BBF_C3_LSB);
-	uint8_t reg1E6 = ad9361_spi_read(phy->spi, REG_RX_BBF_R2346);
+	uint8_t reg1EB = ad9361_spi_read(phy, REG_RX_BBF_C3_MSB);
+	uint8_t reg1EC = ad9361_spi_read(phy, REG_RX_BBF_C3_LSB);
+	uint8_t reg1E6 = ad9361_spi_read(phy, REG_RX_BBF_R2346);
 	uint8_t reg1DB, reg1DF, reg1DD, reg1DC, reg1DE, temp;
 
 	dev_dbg(&phy->spi->dev, "%s : bb_bw_Hz %"PRIu32,
@@ -2692,11 +2831,11 @@ static int32_t ad9361_rx_tia_calib(struct ad9361_rf_phy *phy, uint32_t bb_bw_Hz)
 		reg1DF = 0;
 	}
 
-	ad9361_spi_write(phy->spi, REG_RX_TIA_CONFIG, reg1DB);
-	ad9361_spi_write(phy->spi, REG_TIA1_C_LSB, reg1DC);
-	ad9361_spi_write(phy->spi, REG_TIA1_C_MSB, reg1DD);
-	ad9361_spi_write(phy->spi, REG_TIA2_C_LSB, reg1DE);
-	ad9361_spi_write(phy->spi, REG_TIA2_C_MSB, reg1DF);
+	ad9361_spi_write(phy, REG_RX_TIA_CONFIG, reg1DB);
+	ad9361_spi_write(phy, REG_TIA1_C_LSB, reg1DC);
+	ad9361_spi_write(phy, REG_TIA1_C_MSB, reg1DD);
+	ad9361_spi_write(phy, REG_TIA2_C_LSB, reg1DE);
+	ad9361_spi_write(phy, REG_TIA2_C_MSB, reg1DF);
 
 	return 0;
 }
@@ -2727,33 +2866,33 @@ static int32_t ad9361_rx_bb_analog_filter_calib(struct ad9361_rf_phy *phy,
 				     target));
 
 	/* Set RX baseband filter divide value */
-	ad9361_spi_write(phy->spi, REG_RX_BBF_TUNE_DIVIDE, phy->rxbbf_div);
-	ad9361_spi_writef(phy->spi, REG_RX_BBF_TUNE_CONFIG, NO_OS_BIT(0),
+	ad9361_spi_write(phy, REG_RX_BBF_TUNE_DIVIDE, phy->rxbbf_div);
+	ad9361_spi_writef(phy, REG_RX_BBF_TUNE_CONFIG, NO_OS_BIT(0),
 			  phy->rxbbf_div >> 8);
 
 	/* Write the BBBW into registers 0x1FB and 0x1FC */
-	ad9361_spi_write(phy->spi, REG_RX_BBBW_MHZ, rx_bb_bw / 1000000UL);
+	ad9361_spi_write(phy, REG_RX_BBBW_MHZ, rx_bb_bw / 1000000UL);
 
 	tmp = NO_OS_DIV_ROUND_CLOSEST((rx_bb_bw % 1000000UL) * 128, 1000000UL);
-	ad9361_spi_write(phy->spi, REG_RX_BBBW_KHZ, no_os_min_t(uint8_t, 127, tmp));
+	ad9361_spi_write(phy, REG_RX_BBBW_KHZ, no_os_min_t(uint8_t, 127, tmp));
 
-	ad9361_spi_write(phy->spi, REG_RX_MIX_LO_CM,
+	ad9361_spi_write(phy, REG_RX_MIX_LO_CM,
 			 RX_MIX_LO_CM(0x3F)); /* Set Rx Mix LO CM */
-	ad9361_spi_write(phy->spi, REG_RX_MIX_GM_CONFIG,
+	ad9361_spi_write(phy, REG_RX_MIX_GM_CONFIG,
 			 RX_MIX_GM_PLOAD(3)); /* Set GM common mode */
 
 	/* Enable the RX BBF tune circuit by writing 0x1E2=0x02 and 0x1E3=0x02 */
-	ad9361_spi_write(phy->spi, REG_RX1_TUNE_CTRL, RX1_TUNE_RESAMPLE);
-	ad9361_spi_write(phy->spi, REG_RX2_TUNE_CTRL, RX2_TUNE_RESAMPLE);
+	ad9361_spi_write(phy, REG_RX1_TUNE_CTRL, RX1_TUNE_RESAMPLE);
+	ad9361_spi_write(phy, REG_RX2_TUNE_CTRL, RX2_TUNE_RESAMPLE);
 
 	/* Start the RX Baseband Filter calibration in register 0x016[7] */
 	/* Calibration is complete when register 0x016[7] self clears */
 	ret = ad9361_run_calibration(phy, RX_BB_TUNE_CAL);
 
 	/* Disable the RX baseband filter tune circuit, write 0x1E2=3, 0x1E3=3 */
-	ad9361_spi_write(phy->spi, REG_RX1_TUNE_CTRL,
+	ad9361_spi_write(phy, REG_RX1_TUNE_CTRL,
 			 RX1_TUNE_RESAMPLE | RX1_PD_TUNE);
-	ad9361_spi_write(phy->spi, REG_RX2_TUNE_CTRL,
+	ad9361_spi_write(phy, REG_RX2_TUNE_CTRL,
 			 RX2_TUNE_RESAMPLE | RX2_PD_TUNE);
 
 	return ret;
@@ -2784,19 +2923,19 @@ static int32_t ad9361_tx_bb_analog_filter_calib(struct ad9361_rf_phy *phy,
 				target));
 
 	/* Set TX baseband filter divide value */
-	ad9361_spi_write(phy->spi, REG_TX_BBF_TUNE_DIVIDER, txbbf_div);
-	ad9361_spi_writef(phy->spi, REG_TX_BBF_TUNE_MODE,
+	ad9361_spi_write(phy, REG_TX_BBF_TUNE_DIVIDER, txbbf_div);
+	ad9361_spi_writef(phy, REG_TX_BBF_TUNE_MODE,
 			  TX_BBF_TUNE_DIVIDER, txbbf_div >> 8);
 
 	/* Enable the TX baseband filter tune circuit by setting 0x0CA=0x22. */
-	ad9361_spi_write(phy->spi, REG_TX_TUNE_CTRL, TUNER_RESAMPLE | TUNE_CTRL(1));
+	ad9361_spi_write(phy, REG_TX_TUNE_CTRL, TUNER_RESAMPLE | TUNE_CTRL(1));
 
 	/* Start the TX Baseband Filter calibration in register 0x016[6] */
 	/* Calibration is complete when register 0x016[] self clears */
 	ret = ad9361_run_calibration(phy, TX_BB_TUNE_CAL);
 
 	/* Disable the TX baseband filter tune circuit by writing 0x0CA=0x26. */
-	ad9361_spi_write(phy->spi, REG_TX_TUNE_CTRL,
+	ad9361_spi_write(phy, REG_TX_TUNE_CTRL,
 			 TUNER_RESAMPLE | TUNE_CTRL(1) | PD_TUNE);
 
 	return ret;
@@ -2862,9 +3001,9 @@ static int32_t ad9361_tx_bb_second_filter_calib(struct ad9361_rf_phy *phy,
 		reg_res = 0x01;
 	}
 
-	ret = ad9361_spi_write(phy->spi, REG_CONFIG0, reg_conf);
-	ret |= ad9361_spi_write(phy->spi, REG_RESISTOR, reg_res);
-	ret |= ad9361_spi_write(phy->spi, REG_CAPACITOR, (uint8_t)cap);
+	ret = ad9361_spi_write(phy, REG_CONFIG0, reg_conf);
+	ret |= ad9361_spi_write(phy, REG_RESISTOR, reg_res);
+	ret |= ad9361_spi_write(phy, REG_CAPACITOR, (uint8_t)cap);
 
 	return ret;
 }
@@ -2885,15 +3024,15 @@ static int32_t ad9361_txrx_synth_cp_calib(struct ad9361_rf_phy *phy,
 		__func__, ref_clk_hz, tx);
 
 	/* REVIST: */
-	ad9361_spi_write(phy->spi, REG_RX_CP_LEVEL_DETECT + offs, 0x17);
+	ad9361_spi_write(phy, REG_RX_CP_LEVEL_DETECT + offs, 0x17);
 
-	ad9361_spi_write(phy->spi, REG_RX_DSM_SETUP_1 + offs, 0x0);
+	ad9361_spi_write(phy, REG_RX_DSM_SETUP_1 + offs, 0x0);
 
-	ad9361_spi_write(phy->spi, REG_RX_LO_GEN_POWER_MODE + offs, 0x00);
-	ad9361_spi_write(phy->spi, REG_RX_VCO_LDO + offs, 0x0B);
-	ad9361_spi_write(phy->spi, REG_RX_VCO_PD_OVERRIDES + offs, 0x02);
-	ad9361_spi_write(phy->spi, REG_RX_CP_CURRENT + offs, 0x80);
-	ad9361_spi_write(phy->spi, REG_RX_CP_CONFIG + offs, CP_OFFSET_OFF);
+	ad9361_spi_write(phy, REG_RX_LO_GEN_POWER_MODE + offs, 0x00);
+	ad9361_spi_write(phy, REG_RX_VCO_LDO + offs, 0x0B);
+	ad9361_spi_write(phy, REG_RX_VCO_PD_OVERRIDES + offs, 0x02);
+	ad9361_spi_write(phy, REG_RX_CP_CURRENT + offs, 0x80);
+	ad9361_spi_write(phy, REG_RX_CP_CONFIG + offs, CP_OFFSET_OFF);
 
 	/* see Table 70 Example Calibration Times for RF VCO Cal */
 	if (phy->pdata->fdd) {
@@ -2907,22 +3046,22 @@ static int32_t ad9361_txrx_synth_cp_calib(struct ad9361_rf_phy *phy,
 				      FB_CLOCK_ADV(2);
 	}
 
-	ad9361_spi_write(phy->spi, REG_RX_VCO_CAL + offs, vco_cal_cnt);
+	ad9361_spi_write(phy, REG_RX_VCO_CAL + offs, vco_cal_cnt);
 
 	/* Enable FDD mode during calibrations */
 
 	if (!phy->pdata->fdd) {
-		ad9361_spi_writef(phy->spi, REG_PARALLEL_PORT_CONF_3,
+		ad9361_spi_writef(phy, REG_PARALLEL_PORT_CONF_3,
 				  HALF_DUPLEX_MODE, 0);
 	}
 
-	ad9361_spi_write(phy->spi, REG_ENSM_CONFIG_2, DUAL_SYNTH_MODE);
-	ad9361_spi_write(phy->spi, REG_ENSM_CONFIG_1,
+	ad9361_spi_write(phy, REG_ENSM_CONFIG_2, DUAL_SYNTH_MODE);
+	ad9361_spi_write(phy, REG_ENSM_CONFIG_1,
 			 FORCE_ALERT_STATE |
 			 TO_ALERT);
-	ad9361_spi_write(phy->spi, REG_ENSM_MODE, FDD_MODE);
+	ad9361_spi_write(phy, REG_ENSM_MODE, FDD_MODE);
 
-	ad9361_spi_write(phy->spi, REG_RX_CP_CONFIG + offs,
+	ad9361_spi_write(phy, REG_RX_CP_CONFIG + offs,
 			 CP_OFFSET_OFF | CP_CAL_ENABLE);
 
 	return ad9361_check_cal_done(phy, REG_RX_CAL_STATUS + offs,
@@ -2938,9 +3077,9 @@ static int32_t ad9361_bb_dc_offset_calib(struct ad9361_rf_phy *phy)
 {
 	dev_dbg(&phy->spi->dev, "%s", __func__);
 
-	ad9361_spi_write(phy->spi, REG_BB_DC_OFFSET_COUNT, 0x3F);
-	ad9361_spi_write(phy->spi, REG_BB_DC_OFFSET_SHIFT, BB_DC_M_SHIFT(0xF));
-	ad9361_spi_write(phy->spi, REG_BB_DC_OFFSET_ATTEN, BB_DC_OFFSET_ATTEN(1));
+	ad9361_spi_write(phy, REG_BB_DC_OFFSET_COUNT, 0x3F);
+	ad9361_spi_write(phy, REG_BB_DC_OFFSET_SHIFT, BB_DC_M_SHIFT(0xF));
+	ad9361_spi_write(phy, REG_BB_DC_OFFSET_ATTEN, BB_DC_OFFSET_ATTEN(1));
 
 	return ad9361_run_calibration(phy, BBDC_CAL);
 }
@@ -2954,41 +3093,40 @@ static int32_t ad9361_bb_dc_offset_calib(struct ad9361_rf_phy *phy)
 static int32_t ad9361_rf_dc_offset_calib(struct ad9361_rf_phy *phy,
 		uint64_t rx_freq)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 
 	dev_dbg(&phy->spi->dev, "%s : rx_freq %"PRIu64,
 		__func__, rx_freq);
 
-	ad9361_spi_write(spi, REG_WAIT_COUNT, 0x20);
+	ad9361_spi_write(phy, REG_WAIT_COUNT, 0x20);
 
 	if (rx_freq <= 4000000000ULL) {
-		ad9361_spi_write(spi, REG_RF_DC_OFFSET_COUNT,
+		ad9361_spi_write(phy, REG_RF_DC_OFFSET_COUNT,
 				 phy->pdata->rf_dc_offset_count_low);
-		ad9361_spi_write(spi, REG_RF_DC_OFFSET_CONFIG_1,
+		ad9361_spi_write(phy, REG_RF_DC_OFFSET_CONFIG_1,
 				 RF_DC_CALIBRATION_COUNT(4) | DAC_FS(2));
-		ad9361_spi_write(spi, REG_RF_DC_OFFSET_ATTEN,
+		ad9361_spi_write(phy, REG_RF_DC_OFFSET_ATTEN,
 				 RF_DC_OFFSET_ATTEN(
 					 phy->pdata->dc_offset_attenuation_low));
 	} else {
-		ad9361_spi_write(spi, REG_RF_DC_OFFSET_COUNT,
+		ad9361_spi_write(phy, REG_RF_DC_OFFSET_COUNT,
 				 phy->pdata->rf_dc_offset_count_high);
-		ad9361_spi_write(spi, REG_RF_DC_OFFSET_CONFIG_1,
+		ad9361_spi_write(phy, REG_RF_DC_OFFSET_CONFIG_1,
 				 RF_DC_CALIBRATION_COUNT(4) | DAC_FS(3));
-		ad9361_spi_write(spi, REG_RF_DC_OFFSET_ATTEN,
+		ad9361_spi_write(phy, REG_RF_DC_OFFSET_ATTEN,
 				 RF_DC_OFFSET_ATTEN(
 					 phy->pdata->dc_offset_attenuation_high));
 	}
 
-	ad9361_spi_write(spi, REG_DC_OFFSET_CONFIG2,
+	ad9361_spi_write(phy, REG_DC_OFFSET_CONFIG2,
 			 USE_WAIT_COUNTER_FOR_RF_DC_INIT_CAL |
 			 DC_OFFSET_UPDATE(3));
 
 	if (phy->pdata->rx1rx2_phase_inversion_en ||
 	    (phy->pdata->port_ctrl.pp_conf[1] & INVERT_RX2)) {
-		ad9361_spi_write(spi, REG_INVERT_BITS,
+		ad9361_spi_write(phy, REG_INVERT_BITS,
 				 INVERT_RX1_RF_DC_CGOUT_WORD);
 	} else {
-		ad9361_spi_write(spi, REG_INVERT_BITS,
+		ad9361_spi_write(phy, REG_INVERT_BITS,
 				 INVERT_RX1_RF_DC_CGOUT_WORD |
 				 INVERT_RX2_RF_DC_CGOUT_WORD);
 	}
@@ -3059,12 +3197,12 @@ static int32_t __ad9361_tx_quad_calib(struct ad9361_rf_phy *phy, uint32_t phase,
 {
 	int32_t ret;
 
-	ad9361_spi_write(phy->spi, REG_QUAD_CAL_NCO_FREQ_PHASE_OFFSET,
+	ad9361_spi_write(phy, REG_QUAD_CAL_NCO_FREQ_PHASE_OFFSET,
 			 RX_NCO_FREQ(rxnco_word) | RX_NCO_PHASE_OFFSET(phase));
-	ad9361_spi_write(phy->spi, REG_QUAD_CAL_CTRL,
+	ad9361_spi_write(phy, REG_QUAD_CAL_CTRL,
 			 SETTLE_MAIN_ENABLE | DC_OFFSET_ENABLE | QUAD_CAL_SOFT_RESET |
 			 GAIN_ENABLE | PHASE_ENABLE | M_DECIM(decim));
-	ad9361_spi_write(phy->spi, REG_QUAD_CAL_CTRL,
+	ad9361_spi_write(phy, REG_QUAD_CAL_CTRL,
 			 SETTLE_MAIN_ENABLE | DC_OFFSET_ENABLE |
 			 GAIN_ENABLE | PHASE_ENABLE | M_DECIM(decim));
 
@@ -3073,12 +3211,12 @@ static int32_t __ad9361_tx_quad_calib(struct ad9361_rf_phy *phy, uint32_t phase,
 		return ret;
 
 	if (res) {
-		*res = ad9361_spi_read(phy->spi,
+		*res = ad9361_spi_read(phy,
 				       (phy->pdata->rx1tx1_mode_use_tx_num == 2) ?
 				       REG_QUAD_CAL_STATUS_TX2 : REG_QUAD_CAL_STATUS_TX1) &
 		       (TX1_LO_CONV | TX1_SSB_CONV);
 		if (phy->pdata->rx2tx2)
-			*res &= ad9361_spi_read(phy->spi, REG_QUAD_CAL_STATUS_TX2) &
+			*res &= ad9361_spi_read(phy, REG_QUAD_CAL_STATUS_TX2) &
 				(TX2_LO_CONV | TX2_SSB_CONV);
 	}
 
@@ -3147,7 +3285,6 @@ static int ad9361_tx_quad_calib(struct ad9361_rf_phy *phy,
 				uint32_t bw_rx, uint32_t bw_tx,
 				int32_t rx_phase)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t clktf, clkrf;
 	int32_t txnco_word, rxnco_word, txnco_freq, ret;
 	uint8_t __rx_phase = 0, reg_inv_bits = 0, val, decim;
@@ -3156,7 +3293,7 @@ static int ad9361_tx_quad_calib(struct ad9361_rf_phy *phy,
 	ret = 0;
 	if (phy->cached_synth_pd[0] & TX_LO_POWER_DOWN) {
 		if (phy->pdata->lo_powerdown_managed_en) {
-			ad9361_spi_writef(spi, REG_TX_SYNTH_POWER_DOWN_OVERRIDE,
+			ad9361_spi_writef(phy, REG_TX_SYNTH_POWER_DOWN_OVERRIDE,
 					  TX_LO_POWER_DOWN, 0);
 		} else {
 			dev_err(dev,
@@ -3218,7 +3355,7 @@ static int ad9361_tx_quad_calib(struct ad9361_rf_phy *phy,
 			__rx_phase = 0x1F;
 			break;
 		case 1:
-			if (ad9361_spi_readf(spi,
+			if (ad9361_spi_readf(phy,
 					     REG_TX_ENABLE_FILTER_CTRL, 0x3F) == 0x22)
 				__rx_phase = 0x15; 	/* REVISIT */
 			else
@@ -3245,30 +3382,30 @@ static int ad9361_tx_quad_calib(struct ad9361_rf_phy *phy,
 			     (phy->pdata->port_ctrl.pp_conf[1] & INVERT_RX2);
 
 	if (phase_inversion_en) {
-		ad9361_spi_writef(spi, REG_PARALLEL_PORT_CONF_2, INVERT_RX2, 0);
+		ad9361_spi_writef(phy, REG_PARALLEL_PORT_CONF_2, INVERT_RX2, 0);
 
-		reg_inv_bits = ad9361_spi_read(spi, REG_INVERT_BITS);
+		reg_inv_bits = ad9361_spi_read(phy, REG_INVERT_BITS);
 
-		ad9361_spi_write(spi, REG_INVERT_BITS,
+		ad9361_spi_write(phy, REG_INVERT_BITS,
 				 INVERT_RX1_RF_DC_CGOUT_WORD |
 				 INVERT_RX2_RF_DC_CGOUT_WORD);
 	}
 
-	ad9361_spi_writef(spi, REG_KEXP_2, TX_NCO_FREQ(~0), txnco_word);
-	ad9361_spi_write(spi, REG_QUAD_CAL_COUNT, 0xFF);
-	ad9361_spi_write(spi, REG_KEXP_1, KEXP_TX(1) | KEXP_TX_COMP(3) |
+	ad9361_spi_writef(phy, REG_KEXP_2, TX_NCO_FREQ(~0), txnco_word);
+	ad9361_spi_write(phy, REG_QUAD_CAL_COUNT, 0xFF);
+	ad9361_spi_write(phy, REG_KEXP_1, KEXP_TX(1) | KEXP_TX_COMP(3) |
 			 KEXP_DC_I(3) | KEXP_DC_Q(3));
-	ad9361_spi_write(spi, REG_MAG_FTEST_THRESH, 0x03);
-	ad9361_spi_write(spi, REG_MAG_FTEST_THRESH_2, 0x03);
+	ad9361_spi_write(phy, REG_MAG_FTEST_THRESH, 0x03);
+	ad9361_spi_write(phy, REG_MAG_FTEST_THRESH_2, 0x03);
 
 	if (phy->tx_quad_lpf_tia_match < 0) /* set in ad9361_load_gt() */
 		dev_err(dev, "failed to find suitable LPF TIA value in gain table\n");
 	else
-		ad9361_spi_write(spi, REG_TX_QUAD_FULL_LMT_GAIN,
+		ad9361_spi_write(phy, REG_TX_QUAD_FULL_LMT_GAIN,
 				 phy->tx_quad_lpf_tia_match);
 
-	ad9361_spi_write(spi, REG_QUAD_SETTLE_COUNT, 0xF0);
-	ad9361_spi_write(spi, REG_TX_QUAD_LPF_GAIN, 0x00);
+	ad9361_spi_write(phy, REG_QUAD_SETTLE_COUNT, 0xF0);
+	ad9361_spi_write(phy, REG_TX_QUAD_LPF_GAIN, 0x00);
 
 	if (rx_phase != -2) {
 		ret = __ad9361_tx_quad_calib(phy, __rx_phase, rxnco_word, decim, &val);
@@ -3293,8 +3430,8 @@ static int ad9361_tx_quad_calib(struct ad9361_rf_phy *phy,
 		ret = ad9361_tx_quad_phase_search(phy, rxnco_word, decim);
 
 	if (phase_inversion_en) {
-		ad9361_spi_writef(spi, REG_PARALLEL_PORT_CONF_2, INVERT_RX2, 1);
-		ad9361_spi_write(spi, REG_INVERT_BITS, reg_inv_bits);
+		ad9361_spi_writef(phy, REG_PARALLEL_PORT_CONF_2, INVERT_RX2, 1);
+		ad9361_spi_write(phy, REG_INVERT_BITS, reg_inv_bits);
 	}
 
 	if (txnco_freq > (int64_t)(bw_rx / 4) || txnco_freq > (int64_t)(bw_tx / 4)) {
@@ -3323,24 +3460,23 @@ out_restore:
 int32_t ad9361_tracking_control(struct ad9361_rf_phy *phy, bool bbdc_track,
 				bool rfdc_track, bool rxquad_track)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t qtrack = 0;
 
-	dev_dbg(&spi->dev, "%s : bbdc_track=%d, rfdc_track=%d, rxquad_track=%d",
+	dev_dbg(&phy->spi->dev, "%s : bbdc_track=%d, rfdc_track=%d, rxquad_track=%d",
 		__func__, bbdc_track, rfdc_track, rxquad_track);
 
-	ad9361_spi_write(spi, REG_CALIBRATION_CONFIG_2,
+	ad9361_spi_write(phy, REG_CALIBRATION_CONFIG_2,
 			 CALIBRATION_CONFIG2_DFLT | K_EXP_PHASE(0x15));
-	ad9361_spi_write(spi, REG_CALIBRATION_CONFIG_3,
+	ad9361_spi_write(phy, REG_CALIBRATION_CONFIG_3,
 			 PREVENT_POS_LOOP_GAIN | K_EXP_AMPLITUDE(0x15));
 
-	ad9361_spi_write(spi, REG_DC_OFFSET_CONFIG2,
+	ad9361_spi_write(phy, REG_DC_OFFSET_CONFIG2,
 			 USE_WAIT_COUNTER_FOR_RF_DC_INIT_CAL |
 			 DC_OFFSET_UPDATE(phy->pdata->dc_offset_update_events) |
 			 (bbdc_track ? ENABLE_BB_DC_OFFSET_TRACKING : 0) |
 			 (rfdc_track ? ENABLE_RF_OFFSET_TRACKING : 0));
 
-	ad9361_spi_writef(spi, REG_RX_QUAD_GAIN2,
+	ad9361_spi_writef(phy, REG_RX_QUAD_GAIN2,
 			  CORRECTION_WORD_DECIMATION_M(~0),
 			  phy->pdata->qec_tracking_slow_mode_en ? 4 : 0);
 
@@ -3352,7 +3488,7 @@ int32_t ad9361_tracking_control(struct ad9361_rf_phy *phy, bool bbdc_track,
 				 ENABLE_TRACKING_MODE_CH1 : ENABLE_TRACKING_MODE_CH2;
 	}
 
-	ad9361_spi_write(spi, REG_CALIBRATION_CONFIG_1,
+	ad9361_spi_write(phy, REG_CALIBRATION_CONFIG_1,
 			 ENABLE_PHASE_CORR | ENABLE_GAIN_CORR |
 			 FREE_RUN_MODE | ENABLE_CORR_WORD_DECIMATION |
 			 qtrack);
@@ -3373,7 +3509,7 @@ static int32_t ad9361_trx_vco_cal_control(struct ad9361_rf_phy *phy,
 	dev_dbg(&phy->spi->dev, "%s : state %d",
 		__func__, enable);
 
-	return ad9361_spi_writef(phy->spi,
+	return ad9361_spi_writef(phy,
 				 tx ? REG_TX_PFD_CONFIG : REG_RX_PFD_CONFIG,
 				 BYPASS_LD_SYNTH, !enable);
 }
@@ -3395,7 +3531,7 @@ static int32_t ad9361_trx_ext_lo_control(struct ad9361_rf_phy *phy,
 	 * POWER_DOWN_TRX_SYNTH and MCS_RF_ENABLE somehow conflict
 	 */
 
-	bool mcs_rf_enable = ad9361_spi_readf(phy->spi,
+	bool mcs_rf_enable = ad9361_spi_readf(phy,
 					      REG_MULTICHIP_SYNC_AND_TX_MON_CTRL,
 					      MCS_RF_ENABLE);
 
@@ -3403,13 +3539,13 @@ static int32_t ad9361_trx_ext_lo_control(struct ad9361_rf_phy *phy,
 		tx ? "TX" : "RX", enable);
 
 	if (tx) {
-		ret = ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_2,
+		ret = ad9361_spi_writef(phy, REG_ENSM_CONFIG_2,
 					POWER_DOWN_TX_SYNTH, mcs_rf_enable ? 0 : enable);
 
-		ret = ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_2,
+		ret = ad9361_spi_writef(phy, REG_ENSM_CONFIG_2,
 					TX_SYNTH_READY_MASK, enable);
 
-		ret |= ad9361_spi_writef(phy->spi, REG_RFPLL_DIVIDERS,
+		ret |= ad9361_spi_writef(phy, REG_RFPLL_DIVIDERS,
 					 TX_VCO_DIVIDER(~0), enable ? 7 :
 					 phy->cached_tx_rfpll_div);
 
@@ -3423,22 +3559,22 @@ static int32_t ad9361_trx_ext_lo_control(struct ad9361_rf_phy *phy,
 						     TX_SYNTH_VCO_POWER_DOWN);
 
 
-		ret |= ad9361_spi_write(phy->spi, REG_TX_SYNTH_POWER_DOWN_OVERRIDE,
+		ret |= ad9361_spi_write(phy, REG_TX_SYNTH_POWER_DOWN_OVERRIDE,
 					phy->cached_synth_pd[0]);
 
-		ret |= ad9361_spi_writef(phy->spi, REG_ANALOG_POWER_DOWN_OVERRIDE,
+		ret |= ad9361_spi_writef(phy, REG_ANALOG_POWER_DOWN_OVERRIDE,
 					 TX_EXT_VCO_BUFFER_POWER_DOWN, !enable);
 
-		ret |= ad9361_spi_write(phy->spi, REG_TX_LO_GEN_POWER_MODE,
+		ret |= ad9361_spi_write(phy, REG_TX_LO_GEN_POWER_MODE,
 					TX_LO_GEN_POWER_MODE(val));
 	} else {
-		ret = ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_2,
+		ret = ad9361_spi_writef(phy, REG_ENSM_CONFIG_2,
 					POWER_DOWN_RX_SYNTH, mcs_rf_enable ? 0 : enable);
 
-		ret = ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_2,
+		ret = ad9361_spi_writef(phy, REG_ENSM_CONFIG_2,
 					RX_SYNTH_READY_MASK, enable);
 
-		ret |= ad9361_spi_writef(phy->spi, REG_RFPLL_DIVIDERS,
+		ret |= ad9361_spi_writef(phy, REG_RFPLL_DIVIDERS,
 					 RX_VCO_DIVIDER(~0), enable ? 7 :
 					 phy->cached_rx_rfpll_div);
 
@@ -3451,13 +3587,13 @@ static int32_t ad9361_trx_ext_lo_control(struct ad9361_rf_phy *phy,
 						     RX_SYNTH_PTAT_POWER_DOWN |
 						     RX_SYNTH_VCO_POWER_DOWN);
 
-		ret |= ad9361_spi_write(phy->spi, REG_RX_SYNTH_POWER_DOWN_OVERRIDE,
+		ret |= ad9361_spi_write(phy, REG_RX_SYNTH_POWER_DOWN_OVERRIDE,
 					phy->cached_synth_pd[1]);
 
-		ret |= ad9361_spi_writef(phy->spi, REG_ANALOG_POWER_DOWN_OVERRIDE,
+		ret |= ad9361_spi_writef(phy, REG_ANALOG_POWER_DOWN_OVERRIDE,
 					 RX_EXT_VCO_BUFFER_POWER_DOWN, !enable);
 
-		ret |= ad9361_spi_write(phy->spi, REG_RX_LO_GEN_POWER_MODE,
+		ret |= ad9361_spi_write(phy, REG_RX_LO_GEN_POWER_MODE,
 					RX_LO_GEN_POWER_MODE(val));
 	}
 
@@ -3499,7 +3635,7 @@ int ad9361_synth_lo_powerdown(struct ad9361_rf_phy *phy,
 		break;
 	}
 
-	return ad9361_spi_writem(phy->spi, REG_TX_SYNTH_POWER_DOWN_OVERRIDE,
+	return ad9361_spi_writem(phy, REG_TX_SYNTH_POWER_DOWN_OVERRIDE,
 				 phy->cached_synth_pd, 2);
 }
 
@@ -3515,7 +3651,7 @@ static int32_t ad9361_set_ref_clk_cycles(struct ad9361_rf_phy *phy,
 	dev_dbg(&phy->spi->dev, "%s : ref_clk_hz %"PRIu32,
 		__func__, ref_clk_hz);
 
-	return ad9361_spi_write(phy->spi, REG_REFERENCE_CLOCK_CYCLES,
+	return ad9361_spi_write(phy, REG_REFERENCE_CLOCK_CYCLES,
 				REFERENCE_CLOCK_CYCLES_PER_US((ref_clk_hz / 1000000UL) - 1));
 }
 
@@ -3535,11 +3671,11 @@ int32_t ad9361_set_dcxo_tune(struct ad9361_rf_phy *phy,
 	if (phy->pdata->use_extclk)
 		return -ENODEV;
 
-	ad9361_spi_write(phy->spi, REG_DCXO_COARSE_TUNE,
+	ad9361_spi_write(phy, REG_DCXO_COARSE_TUNE,
 			 DCXO_TUNE_COARSE(coarse));
-	ad9361_spi_write(phy->spi, REG_DCXO_FINE_TUNE_LOW,
+	ad9361_spi_write(phy, REG_DCXO_FINE_TUNE_LOW,
 			 DCXO_TUNE_FINE_LOW(fine));
-	return ad9361_spi_write(phy->spi, REG_DCXO_FINE_TUNE_HIGH,
+	return ad9361_spi_write(phy, REG_DCXO_FINE_TUNE_HIGH,
 				DCXO_TUNE_FINE_HIGH(fine));
 }
 
@@ -3552,32 +3688,31 @@ int32_t ad9361_set_dcxo_tune(struct ad9361_rf_phy *phy,
 static int32_t ad9361_txmon_setup(struct ad9361_rf_phy *phy,
 				  struct tx_monitor_control *ctrl)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 
 	dev_dbg(&phy->spi->dev, "%s", __func__);
 
-	ad9361_spi_write(spi, REG_TPM_MODE_ENABLE,
+	ad9361_spi_write(phy, REG_TPM_MODE_ENABLE,
 			 (ctrl->one_shot_mode_en ? ONE_SHOT_MODE : 0) |
 			 TX_MON_DURATION(ilog2(ctrl->tx_mon_duration / 16)));
 
-	ad9361_spi_write(spi, REG_TX_MON_DELAY, ctrl->tx_mon_delay & 0xFF);
-	ad9361_spi_writef(spi, REG_TX_LEVEL_THRESH,
+	ad9361_spi_write(phy, REG_TX_MON_DELAY, ctrl->tx_mon_delay & 0xFF);
+	ad9361_spi_writef(phy, REG_TX_LEVEL_THRESH,
 			  TX_MON_DELAY_COUNTER(~0), ctrl->tx_mon_delay >> 8);
 
-	ad9361_spi_write(spi, REG_TX_MON_1_CONFIG,
+	ad9361_spi_write(phy, REG_TX_MON_1_CONFIG,
 			 TX_MON_1_LO_CM(ctrl->tx1_mon_lo_cm) |
 			 TX_MON_1_GAIN(ctrl->tx1_mon_front_end_gain));
-	ad9361_spi_write(spi, REG_TX_MON_2_CONFIG,
+	ad9361_spi_write(phy, REG_TX_MON_2_CONFIG,
 			 TX_MON_2_LO_CM(ctrl->tx2_mon_lo_cm) |
 			 TX_MON_2_GAIN(ctrl->tx2_mon_front_end_gain));
 
-	ad9361_spi_write(spi, REG_TX_ATTEN_THRESH,
+	ad9361_spi_write(phy, REG_TX_ATTEN_THRESH,
 			 ctrl->low_high_gain_threshold_mdB / 250);
 
-	ad9361_spi_write(spi, REG_TX_MON_HIGH_GAIN,
+	ad9361_spi_write(phy, REG_TX_MON_HIGH_GAIN,
 			 TX_MON_HIGH_GAIN(ctrl->high_gain_dB));
 
-	ad9361_spi_write(spi, REG_TX_MON_LOW_GAIN,
+	ad9361_spi_write(phy, REG_TX_MON_LOW_GAIN,
 			 (ctrl->tx_mon_track_en ? TX_MON_TRACK : 0) |
 			 TX_MON_LOW_GAIN(ctrl->low_gain_dB));
 
@@ -3597,23 +3732,23 @@ static int32_t ad9361_txmon_control(struct ad9361_rf_phy *phy,
 
 #if 0
 	if (!phy->pdata->fdd && en_mask) {
-		ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_1,
+		ad9361_spi_writef(phy, REG_ENSM_CONFIG_1,
 				  ENABLE_RX_DATA_PORT_FOR_CAL, 1);
 		phy->txmon_tdd_en = true;
 	} else {
-		ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_1,
+		ad9361_spi_writef(phy, REG_ENSM_CONFIG_1,
 				  ENABLE_RX_DATA_PORT_FOR_CAL, 0);
 		phy->txmon_tdd_en = false;
 	}
 #endif
 
-	ad9361_spi_writef(phy->spi, REG_ANALOG_POWER_DOWN_OVERRIDE,
+	ad9361_spi_writef(phy, REG_ANALOG_POWER_DOWN_OVERRIDE,
 			  TX_MONITOR_POWER_DOWN(~0), ~en_mask);
 
-	ad9361_spi_writef(phy->spi, REG_TPM_MODE_ENABLE,
+	ad9361_spi_writef(phy, REG_TPM_MODE_ENABLE,
 			  TX1_MON_ENABLE, !!(en_mask & TX_1));
 
-	return ad9361_spi_writef(phy->spi, REG_TPM_MODE_ENABLE,
+	return ad9361_spi_writef(phy, REG_TPM_MODE_ENABLE,
 				 TX2_MON_ENABLE, !!(en_mask & TX_2));
 }
 
@@ -3666,7 +3801,7 @@ int32_t ad9361_rf_port_setup(struct ad9361_rf_phy *phy, bool is_out,
 	dev_dbg(&phy->spi->dev, "%s : INPUT_SELECT 0x%"PRIx32,
 		__func__, val);
 
-	return ad9361_spi_write(phy->spi, REG_INPUT_SELECT, val);
+	return ad9361_spi_write(phy, REG_INPUT_SELECT, val);
 }
 
 /**
@@ -3678,13 +3813,12 @@ int32_t ad9361_rf_port_setup(struct ad9361_rf_phy *phy, bool is_out,
  */
 static int32_t ad9361_pp_port_setup(struct ad9361_rf_phy *phy, bool restore_c3)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	struct ad9361_phy_platform_data *pd = phy->pdata;
 
 	dev_dbg(&phy->spi->dev, "%s", __func__);
 
 	if (restore_c3) {
-		return ad9361_spi_write(spi, REG_PARALLEL_PORT_CONF_3,
+		return ad9361_spi_write(phy, REG_PARALLEL_PORT_CONF_3,
 					pd->port_ctrl.pp_conf[2]);
 	}
 
@@ -3696,22 +3830,22 @@ static int32_t ad9361_pp_port_setup(struct ad9361_rf_phy *phy, bool restore_c3)
 	if (pd->port_ctrl.pp_conf[2] & FULL_PORT)
 		pd->port_ctrl.pp_conf[2] &= ~(HALF_DUPLEX_MODE | SINGLE_PORT_MODE);
 
-	ad9361_spi_write(spi, REG_PARALLEL_PORT_CONF_1, pd->port_ctrl.pp_conf[0]);
-	ad9361_spi_write(spi, REG_PARALLEL_PORT_CONF_2, pd->port_ctrl.pp_conf[1]);
-	ad9361_spi_write(spi, REG_PARALLEL_PORT_CONF_3, pd->port_ctrl.pp_conf[2]);
-	ad9361_spi_write(spi, REG_RX_CLOCK_DATA_DELAY, pd->port_ctrl.rx_clk_data_delay);
-	ad9361_spi_write(spi, REG_TX_CLOCK_DATA_DELAY, pd->port_ctrl.tx_clk_data_delay);
+	ad9361_spi_write(phy, REG_PARALLEL_PORT_CONF_1, pd->port_ctrl.pp_conf[0]);
+	ad9361_spi_write(phy, REG_PARALLEL_PORT_CONF_2, pd->port_ctrl.pp_conf[1]);
+	ad9361_spi_write(phy, REG_PARALLEL_PORT_CONF_3, pd->port_ctrl.pp_conf[2]);
+	ad9361_spi_write(phy, REG_RX_CLOCK_DATA_DELAY, pd->port_ctrl.rx_clk_data_delay);
+	ad9361_spi_write(phy, REG_TX_CLOCK_DATA_DELAY, pd->port_ctrl.tx_clk_data_delay);
 
-	ad9361_spi_write(spi, REG_LVDS_BIAS_CTRL, pd->port_ctrl.lvds_bias_ctrl);
-	//	ad9361_spi_write(spi, REG_DIGITAL_IO_CTRL, pd->port_ctrl.digital_io_ctrl);
-	ad9361_spi_write(spi, REG_LVDS_INVERT_CTRL1, pd->port_ctrl.lvds_invert[0]);
-	ad9361_spi_write(spi, REG_LVDS_INVERT_CTRL2, pd->port_ctrl.lvds_invert[1]);
+	ad9361_spi_write(phy, REG_LVDS_BIAS_CTRL, pd->port_ctrl.lvds_bias_ctrl);
+	//	ad9361_spi_write(phy, REG_DIGITAL_IO_CTRL, pd->port_ctrl.digital_io_ctrl);
+	ad9361_spi_write(phy, REG_LVDS_INVERT_CTRL1, pd->port_ctrl.lvds_invert[0]);
+	ad9361_spi_write(phy, REG_LVDS_INVERT_CTRL2, pd->port_ctrl.lvds_invert[1]);
 
 	if (pd->rx1rx2_phase_inversion_en ||
 	    (pd->port_ctrl.pp_conf[1] & INVERT_RX2)) {
 
-		ad9361_spi_writef(spi, REG_PARALLEL_PORT_CONF_2, INVERT_RX2, 1);
-		ad9361_spi_writef(spi, REG_INVERT_BITS,
+		ad9361_spi_writef(phy, REG_PARALLEL_PORT_CONF_2, INVERT_RX2, 1);
+		ad9361_spi_writef(phy, REG_INVERT_BITS,
 				  INVERT_RX2_RF_DC_CGOUT_WORD, 0);
 	}
 
@@ -3727,7 +3861,6 @@ static int32_t ad9361_pp_port_setup(struct ad9361_rf_phy *phy, bool restore_c3)
 static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 			       struct gain_control *ctrl)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t reg, tmp1, tmp2;
 
 	dev_dbg(&phy->spi->dev, "%s", __func__);
@@ -3745,14 +3878,14 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 	phy->agc_mode[0] = ctrl->rx1_mode;
 	phy->agc_mode[1] = ctrl->rx2_mode;
 
-	ad9361_spi_write(spi, REG_AGC_CONFIG_1, reg); // Gain Control Mode Select
+	ad9361_spi_write(phy, REG_AGC_CONFIG_1, reg); // Gain Control Mode Select
 
 	/* AGC_USE_FULL_GAIN_TABLE handled in ad9361_load_gt() */
-	ad9361_spi_writef(spi, REG_AGC_CONFIG_2, MAN_GAIN_CTRL_RX1,
+	ad9361_spi_writef(phy, REG_AGC_CONFIG_2, MAN_GAIN_CTRL_RX1,
 			  ctrl->mgc_rx1_ctrl_inp_en);
-	ad9361_spi_writef(spi, REG_AGC_CONFIG_2, MAN_GAIN_CTRL_RX2,
+	ad9361_spi_writef(phy, REG_AGC_CONFIG_2, MAN_GAIN_CTRL_RX2,
 			  ctrl->mgc_rx2_ctrl_inp_en);
-	ad9361_spi_writef(spi, REG_AGC_CONFIG_2, DIG_GAIN_EN,
+	ad9361_spi_writef(phy, REG_AGC_CONFIG_2, DIG_GAIN_EN,
 			  ctrl->dig_gain_en);
 
 	ctrl->adc_ovr_sample_size = no_os_clamp_t(uint8_t, ctrl->adc_ovr_sample_size,
@@ -3778,63 +3911,63 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 	ctrl->mgc_inc_gain_step = no_os_clamp_t(uint8_t, ctrl->mgc_inc_gain_step, 1U,
 						8U);
 	reg |= MANUAL_INCR_STEP_SIZE(ctrl->mgc_inc_gain_step - 1);
-	ad9361_spi_write(spi, REG_AGC_CONFIG_3,
+	ad9361_spi_write(phy, REG_AGC_CONFIG_3,
 			 reg); // Incr Step Size, ADC Overrange Size
 
 	ctrl->mgc_dec_gain_step = no_os_clamp_t(uint8_t, ctrl->mgc_dec_gain_step, 1U,
 						8U);
 	reg = MANUAL_CTRL_IN_DECR_GAIN_STP_SIZE(ctrl->mgc_dec_gain_step - 1);
-	ad9361_spi_write(spi, REG_PEAK_WAIT_TIME,
+	ad9361_spi_write(phy, REG_PEAK_WAIT_TIME,
 			 reg); // Decr Step Size, Peak Overload Time
 
 	if (ctrl->dig_gain_en)
-		ad9361_spi_write(spi, REG_DIGITAL_GAIN,
+		ad9361_spi_write(phy, REG_DIGITAL_GAIN,
 				 MAXIMUM_DIGITAL_GAIN(ctrl->max_dig_gain) |
 				 DIG_GAIN_STP_SIZE(ctrl->dig_gain_step_size));
 
 	if (ctrl->adc_large_overload_thresh >= ctrl->adc_small_overload_thresh) {
-		ad9361_spi_write(spi, REG_ADC_SMALL_OVERLOAD_THRESH,
+		ad9361_spi_write(phy, REG_ADC_SMALL_OVERLOAD_THRESH,
 				 ctrl->adc_small_overload_thresh); // ADC Small Overload Threshold
-		ad9361_spi_write(spi, REG_ADC_LARGE_OVERLOAD_THRESH,
+		ad9361_spi_write(phy, REG_ADC_LARGE_OVERLOAD_THRESH,
 				 ctrl->adc_large_overload_thresh); // ADC Large Overload Threshold
 	} else {
-		ad9361_spi_write(spi, REG_ADC_SMALL_OVERLOAD_THRESH,
+		ad9361_spi_write(phy, REG_ADC_SMALL_OVERLOAD_THRESH,
 				 ctrl->adc_large_overload_thresh); // ADC Small Overload Threshold
-		ad9361_spi_write(spi, REG_ADC_LARGE_OVERLOAD_THRESH,
+		ad9361_spi_write(phy, REG_ADC_LARGE_OVERLOAD_THRESH,
 				 ctrl->adc_small_overload_thresh); // ADC Large Overload Threshold
 	}
 
 	reg = (ctrl->lmt_overload_high_thresh / 16) - 1;
 	reg = no_os_clamp(reg, 0U, 63U);
-	ad9361_spi_write(spi, REG_LARGE_LMT_OVERLOAD_THRESH, reg);
+	ad9361_spi_write(phy, REG_LARGE_LMT_OVERLOAD_THRESH, reg);
 	reg = (ctrl->lmt_overload_low_thresh / 16) - 1;
 	reg = no_os_clamp(reg, 0U, 63U);
-	ad9361_spi_writef(spi, REG_SMALL_LMT_OVERLOAD_THRESH,
+	ad9361_spi_writef(phy, REG_SMALL_LMT_OVERLOAD_THRESH,
 			  SMALL_LMT_OVERLOAD_THRESH(~0), reg);
 
 	if (has_split_gt && phy->pdata->split_gt) {
 		/* REVIST */
-		ad9361_spi_write(spi, REG_RX1_MANUAL_LPF_GAIN, 0x58); // Rx1 LPF Gain Index
-		ad9361_spi_write(spi, REG_RX2_MANUAL_LPF_GAIN, 0x18); // Rx2 LPF Gain Index
-		ad9361_spi_write(spi, REG_FAST_INITIAL_LMT_GAIN_LIMIT,
+		ad9361_spi_write(phy, REG_RX1_MANUAL_LPF_GAIN, 0x58); // Rx1 LPF Gain Index
+		ad9361_spi_write(phy, REG_RX2_MANUAL_LPF_GAIN, 0x18); // Rx2 LPF Gain Index
+		ad9361_spi_write(phy, REG_FAST_INITIAL_LMT_GAIN_LIMIT,
 				 0x27); // Initial LMT Gain Limit
 	}
 
-	ad9361_spi_write(spi, REG_RX1_MANUAL_DIGITALFORCED_GAIN,
+	ad9361_spi_write(phy, REG_RX1_MANUAL_DIGITALFORCED_GAIN,
 			 0x00); // Rx1 Digital Gain Index
-	ad9361_spi_write(spi, REG_RX2_MANUAL_DIGITALFORCED_GAIN,
+	ad9361_spi_write(phy, REG_RX2_MANUAL_DIGITALFORCED_GAIN,
 			 0x00); // Rx2 Digital Gain Index
 
 	reg = no_os_clamp_t(uint8_t, ctrl->low_power_thresh, 0U, 64U) * 2;
-	ad9361_spi_write(spi, REG_FAST_LOW_POWER_THRESH, reg); // Low Power Threshold
-	ad9361_spi_write(spi, REG_TX_SYMBOL_ATTEN_CONFIG,
+	ad9361_spi_write(phy, REG_FAST_LOW_POWER_THRESH, reg); // Low Power Threshold
+	ad9361_spi_write(phy, REG_TX_SYMBOL_ATTEN_CONFIG,
 			 0x00); // Tx Symbol Gain Control
 
-	ad9361_spi_writef(spi, REG_DEC_POWER_MEASURE_DURATION_0,
+	ad9361_spi_writef(phy, REG_DEC_POWER_MEASURE_DURATION_0,
 			  USE_HB1_OUT_FOR_DEC_PWR_MEAS,
 			  !ctrl->use_rx_fir_out_for_dec_pwr_meas); // USE HB1 or FIR output for power measurements
 
-	ad9361_spi_writef(spi, REG_DEC_POWER_MEASURE_DURATION_0,
+	ad9361_spi_writef(phy, REG_DEC_POWER_MEASURE_DURATION_0,
 			  ENABLE_DEC_PWR_MEAS, 1); // Power Measurement Duration
 
 	if (ctrl->rx1_mode == RF_GAIN_FASTATTACK_AGC ||
@@ -3843,29 +3976,29 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 	else
 		reg = ilog2(ctrl->dec_pow_measuremnt_duration / 16);
 
-	ad9361_spi_writef(spi, REG_DEC_POWER_MEASURE_DURATION_0,
+	ad9361_spi_writef(phy, REG_DEC_POWER_MEASURE_DURATION_0,
 			  DEC_POWER_MEASUREMENT_DURATION(~0), reg); // Power Measurement Duration
 
 	/* AGC */
 
 	tmp1 = reg = no_os_clamp_t(uint8_t, ctrl->agc_inner_thresh_high, 0U, 127U);
-	ad9361_spi_writef(spi, REG_AGC_LOCK_LEVEL,
+	ad9361_spi_writef(phy, REG_AGC_LOCK_LEVEL,
 			  AGC_LOCK_LEVEL_FAST_AGC_INNER_HIGH_THRESH_SLOW(~0),
 			  reg);
 
 	tmp2 = reg = no_os_clamp_t(uint8_t, ctrl->agc_inner_thresh_low, 0U, 127U);
 	reg |= (ctrl->adc_lmt_small_overload_prevent_gain_inc ?
 		PREVENT_GAIN_INC : 0);
-	ad9361_spi_write(spi, REG_AGC_INNER_LOW_THRESH, reg);
+	ad9361_spi_write(phy, REG_AGC_INNER_LOW_THRESH, reg);
 
 	reg = AGC_OUTER_HIGH_THRESH(tmp1 - ctrl->agc_outer_thresh_high) |
 	      AGC_OUTER_LOW_THRESH(ctrl->agc_outer_thresh_low - tmp2);
-	ad9361_spi_write(spi, REG_OUTER_POWER_THRESHS, reg);
+	ad9361_spi_write(phy, REG_OUTER_POWER_THRESHS, reg);
 
 	reg = AGC_OUTER_HIGH_THRESH_EXED_STP_SIZE(ctrl->agc_outer_thresh_high_dec_steps)
 	      |
 	      AGC_OUTER_LOW_THRESH_EXED_STP_SIZE(ctrl->agc_outer_thresh_low_inc_steps);
-	ad9361_spi_write(spi, REG_GAIN_STP_2, reg);
+	ad9361_spi_write(phy, REG_GAIN_STP_2, reg);
 
 	reg = ((ctrl->immed_gain_change_if_large_adc_overload) ?
 	       IMMED_GAIN_CHANGE_IF_LG_ADC_OVERLOAD : 0) |
@@ -3873,77 +4006,77 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 	       IMMED_GAIN_CHANGE_IF_LG_LMT_OVERLOAD : 0) |
 	      AGC_INNER_HIGH_THRESH_EXED_STP_SIZE(ctrl->agc_inner_thresh_high_dec_steps) |
 	      AGC_INNER_LOW_THRESH_EXED_STP_SIZE(ctrl->agc_inner_thresh_low_inc_steps);
-	ad9361_spi_write(spi, REG_GAIN_STP1, reg);
+	ad9361_spi_write(phy, REG_GAIN_STP1, reg);
 
 	reg = LARGE_ADC_OVERLOAD_EXED_COUNTER(ctrl->adc_large_overload_exceed_counter) |
 	      SMALL_ADC_OVERLOAD_EXED_COUNTER(ctrl->adc_small_overload_exceed_counter);
-	ad9361_spi_write(spi, REG_ADC_OVERLOAD_COUNTERS, reg);
+	ad9361_spi_write(phy, REG_ADC_OVERLOAD_COUNTERS, reg);
 
 	reg = DECREMENT_STP_SIZE_FOR_SMALL_LPF_GAIN_CHANGE(
 		      ctrl->f_agc_large_overload_inc_steps) |
 	      LARGE_LPF_GAIN_STEP(ctrl->adc_large_overload_inc_steps);
-	ad9361_spi_write(spi, REG_GAIN_STP_CONFIG_2, reg);
+	ad9361_spi_write(phy, REG_GAIN_STP_CONFIG_2, reg);
 
 	reg = LARGE_LMT_OVERLOAD_EXED_COUNTER(ctrl->lmt_overload_large_exceed_counter) |
 	      SMALL_LMT_OVERLOAD_EXED_COUNTER(ctrl->lmt_overload_small_exceed_counter);
-	ad9361_spi_write(spi, REG_LMT_OVERLOAD_COUNTERS, reg);
+	ad9361_spi_write(phy, REG_LMT_OVERLOAD_COUNTERS, reg);
 
-	ad9361_spi_writef(spi, REG_GAIN_STP_CONFIG1,
+	ad9361_spi_writef(phy, REG_GAIN_STP_CONFIG1,
 			  DEC_STP_SIZE_FOR_LARGE_LMT_OVERLOAD(~0),
 			  ctrl->lmt_overload_large_inc_steps);
 
 	reg = DIG_SATURATION_EXED_COUNTER(ctrl->dig_saturation_exceed_counter) |
 	      (ctrl->sync_for_gain_counter_en ?
 	       ENABLE_SYNC_FOR_GAIN_COUNTER : 0);
-	ad9361_spi_write(spi, REG_DIGITAL_SAT_COUNTER, reg);
+	ad9361_spi_write(phy, REG_DIGITAL_SAT_COUNTER, reg);
 
 	/*
 	* Fast AGC
 	*/
 
 	/* Fast AGC - Low Power */
-	ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+	ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 			  ENABLE_INCR_GAIN,
 			  ctrl->f_agc_allow_agc_gain_increase);
 
-	ad9361_spi_write(spi, REG_FAST_INCREMENT_TIME,
+	ad9361_spi_write(phy, REG_FAST_INCREMENT_TIME,
 			 ctrl->f_agc_lp_thresh_increment_time);
 
 	reg = ctrl->f_agc_lp_thresh_increment_steps - 1;
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 7U);
-	ad9361_spi_writef(spi, REG_FAST_ENERGY_DETECT_COUNT,
+	ad9361_spi_writef(phy, REG_FAST_ENERGY_DETECT_COUNT,
 			  INCREMENT_GAIN_STP_LPFLMT(~0), reg);
 
 	/* Fast AGC - Lock Level */
 	/* Dual use see also agc_inner_thresh_high */
-	ad9361_spi_writef(spi, REG_FAST_CONFIG_2_SETTLING_DELAY,
+	ad9361_spi_writef(phy, REG_FAST_CONFIG_2_SETTLING_DELAY,
 			  ENABLE_LMT_GAIN_INC_FOR_LOCK_LEVEL,
 			  ctrl->f_agc_lock_level_lmt_gain_increase_en);
 
 	reg = ctrl->f_agc_lock_level_gain_increase_upper_limit;
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 63U);
-	ad9361_spi_writef(spi, REG_FAST_AGCLL_UPPER_LIMIT,
+	ad9361_spi_writef(phy, REG_FAST_AGCLL_UPPER_LIMIT,
 			  AGCLL_MAX_INCREASE(~0), reg);
 
 	/* Fast AGC - Peak Detectors and Final Settling */
 	reg = ctrl->f_agc_lpf_final_settling_steps;
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 3U);
-	ad9361_spi_writef(spi, REG_FAST_ENERGY_LOST_THRESH,
+	ad9361_spi_writef(phy, REG_FAST_ENERGY_LOST_THRESH,
 			  POST_LOCK_LEVEL_STP_SIZE_FOR_LPF_TABLE_FULL_TABLE(~0),
 			  reg);
 
 	reg = ctrl->f_agc_lmt_final_settling_steps;
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 3U);
-	ad9361_spi_writef(spi, REG_FAST_STRONGER_SIGNAL_THRESH,
+	ad9361_spi_writef(phy, REG_FAST_STRONGER_SIGNAL_THRESH,
 			  POST_LOCK_LEVEL_STP_FOR_LMT_TABLE(~0), reg);
 
 	reg = ctrl->f_agc_final_overrange_count;
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 7U);
-	ad9361_spi_writef(spi, REG_FAST_FINAL_OVER_RANGE_AND_OPT_GAIN,
+	ad9361_spi_writef(phy, REG_FAST_FINAL_OVER_RANGE_AND_OPT_GAIN,
 			  FINAL_OVER_RANGE_COUNT(~0), reg);
 
 	/* Fast AGC - Final Power Test */
-	ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+	ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 			  ENABLE_GAIN_INC_AFTER_GAIN_LOCK,
 			  ctrl->f_agc_gain_increase_after_gain_lock_en);
 
@@ -3951,19 +4084,19 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 	/* 0 = MAX Gain, 1 = Optimized Gain, 2 = Set Gain */
 
 	reg = ctrl->f_agc_gain_index_type_after_exit_rx_mode;
-	ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+	ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 			  GOTO_SET_GAIN_IF_EXIT_RX_STATE, reg == SET_GAIN);
-	ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+	ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 			  GOTO_OPTIMIZED_GAIN_IF_EXIT_RX_STATE,
 			  reg == OPTIMIZED_GAIN);
 
-	ad9361_spi_writef(spi, REG_FAST_CONFIG_2_SETTLING_DELAY,
+	ad9361_spi_writef(phy, REG_FAST_CONFIG_2_SETTLING_DELAY,
 			  USE_LAST_LOCK_LEVEL_FOR_SET_GAIN,
 			  ctrl->f_agc_use_last_lock_level_for_set_gain_en);
 
 	reg = ctrl->f_agc_optimized_gain_offset;
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 15U);
-	ad9361_spi_writef(spi, REG_FAST_FINAL_OVER_RANGE_AND_OPT_GAIN,
+	ad9361_spi_writef(phy, REG_FAST_FINAL_OVER_RANGE_AND_OPT_GAIN,
 			  OPTIMIZE_GAIN_OFFSET(~0), reg);
 
 	tmp1 = !ctrl->f_agc_rst_gla_stronger_sig_thresh_exceeded_en ||
@@ -3972,43 +4105,43 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 	       !ctrl->f_agc_rst_gla_large_lmt_overload_en ||
 	       ctrl->f_agc_rst_gla_en_agc_pulled_high_en;
 
-	ad9361_spi_writef(spi, REG_AGC_CONFIG_2,
+	ad9361_spi_writef(phy, REG_AGC_CONFIG_2,
 			  AGC_GAIN_UNLOCK_CTRL, tmp1);
 
 	reg = !ctrl->f_agc_rst_gla_stronger_sig_thresh_exceeded_en;
-	ad9361_spi_writef(spi, REG_FAST_STRONG_SIGNAL_FREEZE,
+	ad9361_spi_writef(phy, REG_FAST_STRONG_SIGNAL_FREEZE,
 			  DONT_UNLOCK_GAIN_IF_STRONGER_SIGNAL, reg);
 
 	reg = ctrl->f_agc_rst_gla_stronger_sig_thresh_above_ll;
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 63U);
-	ad9361_spi_writef(spi, REG_FAST_STRONGER_SIGNAL_THRESH,
+	ad9361_spi_writef(phy, REG_FAST_STRONGER_SIGNAL_THRESH,
 			  STRONGER_SIGNAL_THRESH(~0), reg);
 
 	reg = ctrl->f_agc_rst_gla_engergy_lost_sig_thresh_below_ll;
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 63U);
-	ad9361_spi_writef(spi, REG_FAST_ENERGY_LOST_THRESH,
+	ad9361_spi_writef(phy, REG_FAST_ENERGY_LOST_THRESH,
 			  ENERGY_LOST_THRESH(~0),  reg);
 
 	reg = ctrl->f_agc_rst_gla_engergy_lost_goto_optim_gain_en;
-	ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+	ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 			  GOTO_OPT_GAIN_IF_ENERGY_LOST_OR_EN_AGC_HIGH, reg);
 
 	reg = !ctrl->f_agc_rst_gla_engergy_lost_sig_thresh_exceeded_en;
-	ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+	ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 			  DONT_UNLOCK_GAIN_IF_ENERGY_LOST, reg);
 
 	reg = ctrl->f_agc_energy_lost_stronger_sig_gain_lock_exit_cnt;
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 63U);
-	ad9361_spi_writef(spi, REG_FAST_GAIN_LOCK_EXIT_COUNT,
+	ad9361_spi_writef(phy, REG_FAST_GAIN_LOCK_EXIT_COUNT,
 			  GAIN_LOCK_EXIT_COUNT(~0), reg);
 
 	reg = !ctrl->f_agc_rst_gla_large_adc_overload_en ||
 	      !ctrl->f_agc_rst_gla_large_lmt_overload_en;
-	ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+	ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 			  DONT_UNLOCK_GAIN_IF_LG_ADC_OR_LMT_OVRG, reg);
 
 	reg = !ctrl->f_agc_rst_gla_large_adc_overload_en;
-	ad9361_spi_writef(spi, REG_FAST_LOW_POWER_THRESH,
+	ad9361_spi_writef(phy, REG_FAST_LOW_POWER_THRESH,
 			  DONT_UNLOCK_GAIN_IF_ADC_OVRG, reg);
 
 	/* 0 = Max Gain, 1 = Set Gain, 2 = Optimized Gain, 3 = No Gain Change */
@@ -4016,51 +4149,51 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 	if (ctrl->f_agc_rst_gla_en_agc_pulled_high_en) {
 		switch (ctrl->f_agc_rst_gla_if_en_agc_pulled_high_mode) {
 		case MAX_GAIN:
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_2_SETTLING_DELAY,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_2_SETTLING_DELAY,
 					  GOTO_MAX_GAIN_OR_OPT_GAIN_IF_EN_AGC_HIGH, 1);
 
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 					  GOTO_SET_GAIN_IF_EN_AGC_HIGH, 0);
 
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 					  GOTO_OPT_GAIN_IF_ENERGY_LOST_OR_EN_AGC_HIGH, 0);
 			break;
 		case SET_GAIN:
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_2_SETTLING_DELAY,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_2_SETTLING_DELAY,
 					  GOTO_MAX_GAIN_OR_OPT_GAIN_IF_EN_AGC_HIGH, 0);
 
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 					  GOTO_SET_GAIN_IF_EN_AGC_HIGH, 1);
 			break;
 		case OPTIMIZED_GAIN:
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_2_SETTLING_DELAY,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_2_SETTLING_DELAY,
 					  GOTO_MAX_GAIN_OR_OPT_GAIN_IF_EN_AGC_HIGH, 1);
 
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 					  GOTO_SET_GAIN_IF_EN_AGC_HIGH, 0);
 
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 					  GOTO_OPT_GAIN_IF_ENERGY_LOST_OR_EN_AGC_HIGH, 1);
 			break;
 		case NO_GAIN_CHANGE:
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 					  GOTO_SET_GAIN_IF_EN_AGC_HIGH, 0);
-			ad9361_spi_writef(spi, REG_FAST_CONFIG_2_SETTLING_DELAY,
+			ad9361_spi_writef(phy, REG_FAST_CONFIG_2_SETTLING_DELAY,
 					  GOTO_MAX_GAIN_OR_OPT_GAIN_IF_EN_AGC_HIGH, 0);
 			break;
 		}
 	} else {
-		ad9361_spi_writef(spi, REG_FAST_CONFIG_1,
+		ad9361_spi_writef(phy, REG_FAST_CONFIG_1,
 				  GOTO_SET_GAIN_IF_EN_AGC_HIGH, 0);
-		ad9361_spi_writef(spi, REG_FAST_CONFIG_2_SETTLING_DELAY,
+		ad9361_spi_writef(phy, REG_FAST_CONFIG_2_SETTLING_DELAY,
 				  GOTO_MAX_GAIN_OR_OPT_GAIN_IF_EN_AGC_HIGH, 0);
 	}
 
 	reg = ilog2(ctrl->f_agc_power_measurement_duration_in_state5 / 16);
 	reg = no_os_clamp_t(uint32_t, reg, 0U, 15U);
-	ad9361_spi_writef(spi, REG_RX1_MANUAL_LPF_GAIN,
+	ad9361_spi_writef(phy, REG_RX1_MANUAL_LPF_GAIN,
 			  POWER_MEAS_IN_STATE_5(~0), reg);
-	ad9361_spi_writef(spi, REG_RX1_MANUAL_LMT_FULL_GAIN,
+	ad9361_spi_writef(phy, REG_RX1_MANUAL_LMT_FULL_GAIN,
 			  POWER_MEAS_IN_STATE_5_MSB, reg >> 3);
 
 	return ad9361_gc_update(phy);
@@ -4076,14 +4209,13 @@ static int32_t ad9361_gc_setup(struct ad9361_rf_phy *phy,
 static int32_t ad9361_auxdac_set(struct ad9361_rf_phy *phy, int32_t dac,
 				 int32_t val_mV)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t val, tmp;
 
 	dev_dbg(&phy->spi->dev, "%s DAC%"PRId32" = %"PRId32" mV", __func__, dac,
 		val_mV);
 
 	/* Disable DAC if val == 0, Ignored in ENSM Auto Mode */
-	ad9361_spi_writef(spi, REG_AUXDAC_ENABLE_CTRL,
+	ad9361_spi_writef(phy, REG_AUXDAC_ENABLE_CTRL,
 			  AUXDAC_MANUAL_BAR(dac), val_mV ? 0 : 1);
 
 	if (val_mV < 306)
@@ -4101,13 +4233,13 @@ static int32_t ad9361_auxdac_set(struct ad9361_rf_phy *phy, int32_t dac,
 
 	switch (dac) {
 	case 1:
-		ad9361_spi_write(spi, REG_AUXDAC_1_WORD, val >> 2);
-		ad9361_spi_write(spi, REG_AUXDAC_1_CONFIG, AUXDAC_1_WORD_LSB(val) | tmp);
+		ad9361_spi_write(phy, REG_AUXDAC_1_WORD, val >> 2);
+		ad9361_spi_write(phy, REG_AUXDAC_1_CONFIG, AUXDAC_1_WORD_LSB(val) | tmp);
 		phy->auxdac1_value = val_mV;
 		break;
 	case 2:
-		ad9361_spi_write(spi, REG_AUXDAC_2_WORD, val >> 2);
-		ad9361_spi_write(spi, REG_AUXDAC_2_CONFIG, AUXDAC_2_WORD_LSB(val) | tmp);
+		ad9361_spi_write(phy, REG_AUXDAC_2_WORD, val >> 2);
+		ad9361_spi_write(phy, REG_AUXDAC_2_CONFIG, AUXDAC_2_WORD_LSB(val) | tmp);
 		phy->auxdac2_value = val_mV;
 		break;
 	default:
@@ -4147,7 +4279,6 @@ int32_t ad9361_auxdac_get(struct ad9361_rf_phy *phy, int32_t dac)
 static int32_t ad9361_auxdac_setup(struct ad9361_rf_phy *phy,
 				   struct auxdac_control *ctrl)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint8_t tmp;
 
 	dev_dbg(&phy->spi->dev, "%s", __func__);
@@ -4159,18 +4290,18 @@ static int32_t ad9361_auxdac_setup(struct ad9361_rf_phy *phy,
 		AUXDAC_AUTO_RX_BAR(ctrl->dac2_in_rx_en << 1 | ctrl->dac1_in_rx_en) |
 		AUXDAC_INIT_BAR(ctrl->dac2_in_alert_en << 1 | ctrl->dac1_in_alert_en));
 
-	ad9361_spi_writef(spi, REG_AUXDAC_ENABLE_CTRL,
+	ad9361_spi_writef(phy, REG_AUXDAC_ENABLE_CTRL,
 			  AUXDAC_AUTO_TX_BAR(~0) |
 			  AUXDAC_AUTO_RX_BAR(~0) |
 			  AUXDAC_INIT_BAR(~0),
 			  tmp); /* Auto Control */
 
-	ad9361_spi_writef(spi, REG_EXTERNAL_LNA_CTRL,
+	ad9361_spi_writef(phy, REG_EXTERNAL_LNA_CTRL,
 			  AUXDAC_MANUAL_SELECT, ctrl->auxdac_manual_mode_en);
-	ad9361_spi_write(spi, REG_AUXDAC1_RX_DELAY, ctrl->dac1_rx_delay_us);
-	ad9361_spi_write(spi, REG_AUXDAC1_TX_DELAY, ctrl->dac1_tx_delay_us);
-	ad9361_spi_write(spi, REG_AUXDAC2_RX_DELAY, ctrl->dac2_rx_delay_us);
-	ad9361_spi_write(spi, REG_AUXDAC2_TX_DELAY, ctrl->dac2_tx_delay_us);
+	ad9361_spi_write(phy, REG_AUXDAC1_RX_DELAY, ctrl->dac1_rx_delay_us);
+	ad9361_spi_write(phy, REG_AUXDAC1_TX_DELAY, ctrl->dac1_tx_delay_us);
+	ad9361_spi_write(phy, REG_AUXDAC2_RX_DELAY, ctrl->dac2_rx_delay_us);
+	ad9361_spi_write(phy, REG_AUXDAC2_TX_DELAY, ctrl->dac2_tx_delay_us);
 
 	return 0;
 }
@@ -4186,7 +4317,6 @@ static int32_t ad9361_auxadc_setup(struct ad9361_rf_phy *phy,
 				   struct auxadc_control *ctrl,
 				   uint32_t bbpll_freq)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t val;
 
 	dev_dbg(&phy->spi->dev, "%s", __func__);
@@ -4194,18 +4324,18 @@ static int32_t ad9361_auxadc_setup(struct ad9361_rf_phy *phy,
 	val = NO_OS_DIV_ROUND_CLOSEST(ctrl->temp_time_inteval_ms *
 				      (bbpll_freq / 1000UL), (1 << 29));
 
-	ad9361_spi_write(spi, REG_TEMP_OFFSET, ctrl->offset);
-	ad9361_spi_write(spi, REG_START_TEMP_READING, 0x00);
-	ad9361_spi_write(spi, REG_TEMP_SENSE2,
+	ad9361_spi_write(phy, REG_TEMP_OFFSET, ctrl->offset);
+	ad9361_spi_write(phy, REG_START_TEMP_READING, 0x00);
+	ad9361_spi_write(phy, REG_TEMP_SENSE2,
 			 MEASUREMENT_TIME_INTERVAL(val) |
 			 (ctrl->periodic_temp_measuremnt ?
 			  TEMP_SENSE_PERIODIC_ENABLE : 0));
-	ad9361_spi_write(spi, REG_TEMP_SENSOR_CONFIG,
+	ad9361_spi_write(phy, REG_TEMP_SENSOR_CONFIG,
 			 TEMP_SENSOR_DECIMATION(
 				 ilog2(ctrl->temp_sensor_decimation) - 8));
-	ad9361_spi_write(spi, REG_AUXADC_CLOCK_DIVIDER,
+	ad9361_spi_write(phy, REG_AUXADC_CLOCK_DIVIDER,
 			 bbpll_freq / ctrl->auxadc_clock_rate);
-	ad9361_spi_write(spi, REG_AUXADC_CONFIG,
+	ad9361_spi_write(phy, REG_AUXADC_CONFIG,
 			 AUX_ADC_DECIMATION(
 				 ilog2(ctrl->auxadc_decimation) - 8));
 
@@ -4221,9 +4351,9 @@ int32_t ad9361_get_temp(struct ad9361_rf_phy *phy)
 {
 	uint32_t val;
 
-	ad9361_spi_writef(phy->spi, REG_AUXADC_CONFIG, AUXADC_POWER_DOWN, 1);
-	val = ad9361_spi_read(phy->spi, REG_TEMPERATURE);
-	ad9361_spi_writef(phy->spi, REG_AUXADC_CONFIG, AUXADC_POWER_DOWN, 0);
+	ad9361_spi_writef(phy, REG_AUXADC_CONFIG, AUXADC_POWER_DOWN, 1);
+	val = ad9361_spi_read(phy, REG_TEMPERATURE);
+	ad9361_spi_writef(phy, REG_AUXADC_CONFIG, AUXADC_POWER_DOWN, 0);
 
 	return NO_OS_DIV_ROUND_CLOSEST(val * 1000000, 1140);
 }
@@ -4237,9 +4367,9 @@ int32_t ad9361_get_auxadc(struct ad9361_rf_phy *phy)
 {
 	uint8_t buf[2];
 
-	ad9361_spi_writef(phy->spi, REG_AUXADC_CONFIG, AUXADC_POWER_DOWN, 1);
-	ad9361_spi_readm(phy->spi, REG_AUXADC_LSB, buf, 2);
-	ad9361_spi_writef(phy->spi, REG_AUXADC_CONFIG, AUXADC_POWER_DOWN, 0);
+	ad9361_spi_writef(phy, REG_AUXADC_CONFIG, AUXADC_POWER_DOWN, 1);
+	ad9361_spi_readm(phy, REG_AUXADC_LSB, buf, 2);
+	ad9361_spi_writef(phy, REG_AUXADC_CONFIG, AUXADC_POWER_DOWN, 0);
 
 	return (buf[1] << 4) | AUXADC_WORD_LSB(buf[0]);
 }
@@ -4253,12 +4383,11 @@ int32_t ad9361_get_auxadc(struct ad9361_rf_phy *phy)
 static int32_t ad9361_ctrl_outs_setup(struct ad9361_rf_phy *phy,
 				      struct ctrl_outs_control *ctrl)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 
 	dev_dbg(&phy->spi->dev, "%s", __func__);
 
-	ad9361_spi_write(spi, REG_CTRL_OUTPUT_POINTER, ctrl->index); // Ctrl Out index
-	return ad9361_spi_write(spi, REG_CTRL_OUTPUT_ENABLE,
+	ad9361_spi_write(phy, REG_CTRL_OUTPUT_POINTER, ctrl->index); // Ctrl Out index
+	return ad9361_spi_write(phy, REG_CTRL_OUTPUT_ENABLE,
 				ctrl->en_mask); // Ctrl Out [7:0] output enable
 }
 
@@ -4270,11 +4399,10 @@ static int32_t ad9361_ctrl_outs_setup(struct ad9361_rf_phy *phy,
 static int32_t ad9361_gpo_setup(struct ad9361_rf_phy *phy,
 				struct gpo_control *ctrl)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 
 	dev_dbg(&phy->spi->dev, "%s", __func__);
 
-	ad9361_spi_write(spi, REG_AUTO_GPO,
+	ad9361_spi_write(phy, REG_AUTO_GPO,
 			 GPO_ENABLE_AUTO_RX(ctrl->gpo0_slave_rx_en |
 					    (ctrl->gpo1_slave_rx_en << 1) |
 					    (ctrl->gpo2_slave_rx_en << 2) |
@@ -4284,26 +4412,26 @@ static int32_t ad9361_gpo_setup(struct ad9361_rf_phy *phy,
 					    (ctrl->gpo2_slave_tx_en << 2) |
 					    (ctrl->gpo3_slave_tx_en << 3)));
 
-	ad9361_spi_write(spi, REG_GPO_FORCE_AND_INIT,
+	ad9361_spi_write(phy, REG_GPO_FORCE_AND_INIT,
 			 GPO_MANUAL_CTRL(ctrl->gpo_manual_mode_enable_mask) |
 			 GPO_INIT_STATE(ctrl->gpo0_inactive_state_high_en |
 					(ctrl->gpo1_inactive_state_high_en << 1) |
 					(ctrl->gpo2_inactive_state_high_en << 2) |
 					(ctrl->gpo3_inactive_state_high_en << 3)));
 
-	ad9361_spi_write(spi, REG_GPO0_RX_DELAY, ctrl->gpo0_rx_delay_us);
-	ad9361_spi_write(spi, REG_GPO0_TX_DELAY, ctrl->gpo0_tx_delay_us);
-	ad9361_spi_write(spi, REG_GPO1_RX_DELAY, ctrl->gpo1_rx_delay_us);
-	ad9361_spi_write(spi, REG_GPO1_TX_DELAY, ctrl->gpo1_tx_delay_us);
-	ad9361_spi_write(spi, REG_GPO2_RX_DELAY, ctrl->gpo2_rx_delay_us);
-	ad9361_spi_write(spi, REG_GPO2_TX_DELAY, ctrl->gpo2_tx_delay_us);
-	ad9361_spi_write(spi, REG_GPO3_RX_DELAY, ctrl->gpo3_rx_delay_us);
-	ad9361_spi_write(spi, REG_GPO3_TX_DELAY, ctrl->gpo3_tx_delay_us);
+	ad9361_spi_write(phy, REG_GPO0_RX_DELAY, ctrl->gpo0_rx_delay_us);
+	ad9361_spi_write(phy, REG_GPO0_TX_DELAY, ctrl->gpo0_tx_delay_us);
+	ad9361_spi_write(phy, REG_GPO1_RX_DELAY, ctrl->gpo1_rx_delay_us);
+	ad9361_spi_write(phy, REG_GPO1_TX_DELAY, ctrl->gpo1_tx_delay_us);
+	ad9361_spi_write(phy, REG_GPO2_RX_DELAY, ctrl->gpo2_rx_delay_us);
+	ad9361_spi_write(phy, REG_GPO2_TX_DELAY, ctrl->gpo2_tx_delay_us);
+	ad9361_spi_write(phy, REG_GPO3_RX_DELAY, ctrl->gpo3_rx_delay_us);
+	ad9361_spi_write(phy, REG_GPO3_TX_DELAY, ctrl->gpo3_tx_delay_us);
 
 	/*
 	 * GPO manual mode conflicts with automatic ENSM slave and eLNA mode
 	 */
-	ad9361_spi_writef(phy->spi, REG_EXTERNAL_LNA_CTRL, GPO_MANUAL_SELECT,
+	ad9361_spi_writef(phy, REG_EXTERNAL_LNA_CTRL, GPO_MANUAL_SELECT,
 			  ctrl->gpo_manual_mode_en);
 
 	return 0;
@@ -4320,7 +4448,6 @@ static int32_t ad9361_rssi_setup(struct ad9361_rf_phy *phy,
 				 struct rssi_control *ctrl,
 				 bool is_update)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t total_weight, weight[4], total_dur = 0, temp;
 	uint8_t dur_buf[4] = { 0 };
 	int32_t val, ret, i, j = 0;
@@ -4381,20 +4508,20 @@ static int32_t ad9361_rssi_setup(struct ad9361_rf_phy *phy,
 	val = total_weight - 0xFF;
 	weight[j - 1] -= val;
 
-	ad9361_spi_write(spi, REG_MEASURE_DURATION_01,
+	ad9361_spi_write(phy, REG_MEASURE_DURATION_01,
 			 (dur_buf[1] << 4) | dur_buf[0]); // RSSI Measurement Duration 0, 1
-	ad9361_spi_write(spi, REG_MEASURE_DURATION_23,
+	ad9361_spi_write(phy, REG_MEASURE_DURATION_23,
 			 (dur_buf[3] << 4) | dur_buf[2]); // RSSI Measurement Duration 2, 3
-	ad9361_spi_write(spi, REG_RSSI_WEIGHT_0,
+	ad9361_spi_write(phy, REG_RSSI_WEIGHT_0,
 			 weight[0]); // RSSI Weighted Multiplier 0
-	ad9361_spi_write(spi, REG_RSSI_WEIGHT_1,
+	ad9361_spi_write(phy, REG_RSSI_WEIGHT_1,
 			 weight[1]); // RSSI Weighted Multiplier 1
-	ad9361_spi_write(spi, REG_RSSI_WEIGHT_2,
+	ad9361_spi_write(phy, REG_RSSI_WEIGHT_2,
 			 weight[2]); // RSSI Weighted Multiplier 2
-	ad9361_spi_write(spi, REG_RSSI_WEIGHT_3,
+	ad9361_spi_write(phy, REG_RSSI_WEIGHT_3,
 			 weight[3]); // RSSI Weighted Multiplier 3
-	ad9361_spi_write(spi, REG_RSSI_DELAY, rssi_delay); // RSSI Delay
-	ad9361_spi_write(spi, REG_RSSI_WAIT_TIME, rssi_wait); // RSSI Wait
+	ad9361_spi_write(phy, REG_RSSI_DELAY, rssi_delay); // RSSI Delay
+	ad9361_spi_write(phy, REG_RSSI_WAIT_TIME, rssi_wait); // RSSI Wait
 
 	temp = RSSI_MODE_SELECT(ctrl->restart_mode);
 	if (ctrl->restart_mode == SPI_WRITE_TO_REGISTER)
@@ -4403,7 +4530,7 @@ static int32_t ad9361_rssi_setup(struct ad9361_rf_phy *phy,
 	if (rssi_duration == 0 && j == 1) /* Power of two */
 		temp |= DEFAULT_RSSI_MEAS_MODE;
 
-	ret = ad9361_spi_write(spi, REG_RSSI_CONFIG, temp); // RSSI Mode Select
+	ret = ad9361_spi_write(phy, REG_RSSI_CONFIG, temp); // RSSI Mode Select
 
 	if (ret < 0)
 		dev_err(&phy->spi->dev, "Unable to write rssi config");
@@ -4440,7 +4567,6 @@ static int32_t ad9361_bb_clk_change_handler(struct ad9361_rf_phy *phy)
 int32_t ad9361_ensm_set_state(struct ad9361_rf_phy *phy, uint8_t ensm_state,
 			      bool pinctrl)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	int32_t rc = 0;
 	uint32_t val;
 	uint32_t tmp;
@@ -4450,11 +4576,11 @@ int32_t ad9361_ensm_set_state(struct ad9361_rf_phy *phy, uint8_t ensm_state,
 
 
 	if (phy->curr_ensm_state == ENSM_STATE_SLEEP) {
-		ad9361_spi_write(spi, REG_CLOCK_ENABLE,
+		ad9361_spi_write(phy, REG_CLOCK_ENABLE,
 				 DIGITAL_POWER_UP | CLOCK_ENABLE_DFLT | BBPLL_ENABLE |
 				 (phy->pdata->use_extclk ? XO_BYPASS : 0)); /* Enable Clocks */
 		no_os_udelay(20);
-		ad9361_spi_write(spi, REG_ENSM_CONFIG_1, TO_ALERT | FORCE_ALERT_STATE);
+		ad9361_spi_write(phy, REG_ENSM_CONFIG_1, TO_ALERT | FORCE_ALERT_STATE);
 		ad9361_trx_vco_cal_control(phy, false, true); /* Enable VCO Cal */
 		ad9361_trx_vco_cal_control(phy, true, true);
 	}
@@ -4493,14 +4619,14 @@ int32_t ad9361_ensm_set_state(struct ad9361_rf_phy *phy, uint8_t ensm_state,
 	case ENSM_STATE_SLEEP:
 		ad9361_trx_vco_cal_control(phy, false, false); /* Disable VCO Cal */
 		ad9361_trx_vco_cal_control(phy, true, false);
-		ad9361_spi_write(spi, REG_ENSM_CONFIG_1, 0); /* Clear To Alert */
-		ad9361_spi_write(spi, REG_ENSM_CONFIG_1,
+		ad9361_spi_write(phy, REG_ENSM_CONFIG_1, 0); /* Clear To Alert */
+		ad9361_spi_write(phy, REG_ENSM_CONFIG_1,
 				 phy->pdata->fdd ? FORCE_TX_ON : FORCE_RX_ON);
 		/* Delay Flush Time 384 ADC clock cycles */
 		no_os_udelay(384000000UL / clk_get_rate(phy, phy->ref_clk_scale[ADC_CLK]));
-		ad9361_spi_write(spi, REG_ENSM_CONFIG_1, 0); /* Move to Wait*/
+		ad9361_spi_write(phy, REG_ENSM_CONFIG_1, 0); /* Move to Wait*/
 		no_os_udelay(1); /* Wait for ENSM settle */
-		ad9361_spi_write(spi, REG_CLOCK_ENABLE,
+		ad9361_spi_write(phy, REG_CLOCK_ENABLE,
 				 (phy->pdata->use_extclk ? XO_BYPASS : 0)); /* Turn off all clocks */
 		phy->curr_ensm_state = ensm_state;
 		return 0;
@@ -4518,7 +4644,7 @@ int32_t ad9361_ensm_set_state(struct ad9361_rf_phy *phy, uint8_t ensm_state,
 
 			val2 &= ~(FORCE_TX_ON | FORCE_RX_ON);
 			val2 |= TO_ALERT | FORCE_ALERT_STATE;
-			ad9361_spi_write(spi, REG_ENSM_CONFIG_1, val2);
+			ad9361_spi_write(phy, REG_ENSM_CONFIG_1, val2);
 
 			ad9361_check_cal_done(phy, REG_STATE, ENSM_STATE(~0), ENSM_STATE_ALERT);
 		} else {
@@ -4542,26 +4668,26 @@ int32_t ad9361_ensm_set_state(struct ad9361_rf_phy *phy, uint8_t ensm_state,
 				  RX_SYNTH_VCO_POWER_DOWN);
 		}
 
-		ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_2,
+		ad9361_spi_writef(phy, REG_ENSM_CONFIG_2,
 				  TXNRX_SPI_CTRL, ensm_state == ENSM_STATE_TX);
 
 		if (check)
 			ad9361_check_cal_done(phy, reg, VCO_LOCK, 1);
 	}
 
-	rc = ad9361_spi_write(spi, REG_ENSM_CONFIG_1, val);
+	rc = ad9361_spi_write(phy, REG_ENSM_CONFIG_1, val);
 	if (rc)
 		dev_err(dev, "Failed to restore state");
 
 	if ((val & FORCE_RX_ON) &&
 	    (phy->agc_mode[0] == RF_GAIN_MGC ||
 	     phy->agc_mode[1] == RF_GAIN_MGC)) {
-		tmp = ad9361_spi_read(spi, REG_SMALL_LMT_OVERLOAD_THRESH);
-		ad9361_spi_write(spi, REG_SMALL_LMT_OVERLOAD_THRESH,
+		tmp = ad9361_spi_read(phy, REG_SMALL_LMT_OVERLOAD_THRESH);
+		ad9361_spi_write(phy, REG_SMALL_LMT_OVERLOAD_THRESH,
 				 (tmp & SMALL_LMT_OVERLOAD_THRESH(~0)) |
 				 (phy->agc_mode[0] == RF_GAIN_MGC ? FORCE_PD_RESET_RX1 : 0) |
 				 (phy->agc_mode[1] == RF_GAIN_MGC ? FORCE_PD_RESET_RX2 : 0));
-		ad9361_spi_write(spi, REG_SMALL_LMT_OVERLOAD_THRESH,
+		ad9361_spi_write(phy, REG_SMALL_LMT_OVERLOAD_THRESH,
 				 tmp & SMALL_LMT_OVERLOAD_THRESH(~0));
 	}
 
@@ -4701,12 +4827,12 @@ int32_t ad9361_set_trx_clock_chain(struct ad9361_rf_phy *phy,
 	 */
 
 	if (phy->rx_fir_dec == 1 || phy->bypass_rx_fir) {
-		ad9361_spi_writef(phy->spi, REG_RX_ENABLE_FILTER_CTRL,
+		ad9361_spi_writef(phy, REG_RX_ENABLE_FILTER_CTRL,
 				  RX_FIR_ENABLE_DECIMATION(~0), !phy->bypass_rx_fir);
 	}
 
 	if (phy->tx_fir_int == 1 || phy->bypass_tx_fir) {
-		ad9361_spi_writef(phy->spi, REG_TX_ENABLE_FILTER_CTRL,
+		ad9361_spi_writef(phy, REG_TX_ENABLE_FILTER_CTRL,
 				  TX_FIR_ENABLE_INTERPOLATION(~0), !phy->bypass_tx_fir);
 	}
 
@@ -4917,18 +5043,18 @@ int32_t ad9361_set_ensm_mode(struct ad9361_rf_phy *phy, bool fdd, bool pinctrl)
 	int32_t ret;
 	uint32_t val = 0;
 
-	ad9361_spi_write(phy->spi, REG_ENSM_MODE, fdd ? FDD_MODE : 0);
+	ad9361_spi_write(phy, REG_ENSM_MODE, fdd ? FDD_MODE : 0);
 
-	val = ad9361_spi_read(phy->spi, REG_ENSM_CONFIG_2);
+	val = ad9361_spi_read(phy, REG_ENSM_CONFIG_2);
 	val &= POWER_DOWN_RX_SYNTH | POWER_DOWN_TX_SYNTH |
 	       RX_SYNTH_READY_MASK | TX_SYNTH_READY_MASK;
 
 	if (fdd)
-		ret = ad9361_spi_write(phy->spi, REG_ENSM_CONFIG_2,
+		ret = ad9361_spi_write(phy, REG_ENSM_CONFIG_2,
 				       val | DUAL_SYNTH_MODE |
 				       (pd->fdd_independent_mode ? FDD_EXTERNAL_CTRL_ENABLE : 0));
 	else
-		ret = ad9361_spi_write(phy->spi, REG_ENSM_CONFIG_2, val |
+		ret = ad9361_spi_write(phy, REG_ENSM_CONFIG_2, val |
 				       (pd->tdd_use_dual_synth ? DUAL_SYNTH_MODE : 0) |
 				       (pd->tdd_use_dual_synth ? 0 :
 					(pinctrl ? SYNTH_ENABLE_PIN_CTRL_MODE : 0)));
@@ -4938,13 +5064,13 @@ int32_t ad9361_set_ensm_mode(struct ad9361_rf_phy *phy, bool fdd, bool pinctrl)
 
 /**
  * Fastlock read value.
- * @param spi
+ * @param phy The AD9361 state structure.
  * @param tx
  * @param profile
  * @param word
  * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t ad9361_fastlock_readval(struct no_os_spi_desc *spi, bool tx,
+static int32_t ad9361_fastlock_readval(struct ad9361_rf_phy *phy, bool tx,
 				       uint32_t profile, uint32_t word)
 {
 	uint32_t offs = 0;
@@ -4952,16 +5078,16 @@ static int32_t ad9361_fastlock_readval(struct no_os_spi_desc *spi, bool tx,
 	if (tx)
 		offs = REG_TX_FAST_LOCK_SETUP - REG_RX_FAST_LOCK_SETUP;
 
-	ad9361_spi_write(spi, REG_RX_FAST_LOCK_PROGRAM_ADDR + offs,
+	ad9361_spi_write(phy, REG_RX_FAST_LOCK_PROGRAM_ADDR + offs,
 			 RX_FAST_LOCK_PROFILE_ADDR(profile) |
 			 RX_FAST_LOCK_PROFILE_WORD(word));
 
-	return ad9361_spi_read(spi, REG_RX_FAST_LOCK_PROGRAM_READ + offs);
+	return ad9361_spi_read(phy, REG_RX_FAST_LOCK_PROGRAM_READ + offs);
 }
 
 /**
  * Fastlock write value.
- * @param spi
+ * @param phy The AD9361 state structure.
  * @param tx
  * @param profile
  * @param word
@@ -4969,7 +5095,7 @@ static int32_t ad9361_fastlock_readval(struct no_os_spi_desc *spi, bool tx,
  * @param last
  * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t ad9361_fastlock_writeval(struct no_os_spi_desc *spi, bool tx,
+static int32_t ad9361_fastlock_writeval(struct ad9361_rf_phy *phy, bool tx,
 					uint32_t profile, uint32_t word, uint8_t val, bool last)
 {
 	uint32_t offs = 0;
@@ -4978,16 +5104,16 @@ static int32_t ad9361_fastlock_writeval(struct no_os_spi_desc *spi, bool tx,
 	if (tx)
 		offs = REG_TX_FAST_LOCK_SETUP - REG_RX_FAST_LOCK_SETUP;
 
-	ret = ad9361_spi_write(spi, REG_RX_FAST_LOCK_PROGRAM_ADDR + offs,
+	ret = ad9361_spi_write(phy, REG_RX_FAST_LOCK_PROGRAM_ADDR + offs,
 			       RX_FAST_LOCK_PROFILE_ADDR(profile) |
 			       RX_FAST_LOCK_PROFILE_WORD(word));
-	ret |= ad9361_spi_write(spi, REG_RX_FAST_LOCK_PROGRAM_DATA + offs, val);
-	ret |= ad9361_spi_write(spi, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs,
+	ret |= ad9361_spi_write(phy, REG_RX_FAST_LOCK_PROGRAM_DATA + offs, val);
+	ret |= ad9361_spi_write(phy, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs,
 				RX_FAST_LOCK_PROGRAM_WRITE |
 				RX_FAST_LOCK_PROGRAM_CLOCK_ENABLE);
 
 	if (last) /* Stop Clocks */
-		ret |= ad9361_spi_write(spi,
+		ret |= ad9361_spi_write(phy,
 					REG_RX_FAST_LOCK_PROGRAM_CTRL + offs, 0);
 
 	return ret;
@@ -5016,19 +5142,19 @@ int32_t ad9361_fastlock_load(struct ad9361_rf_phy *phy, bool tx,
 
 	buf[0] = values[0];
 	buf[1] = RX_FAST_LOCK_PROFILE_ADDR(profile) | RX_FAST_LOCK_PROFILE_WORD(0);
-	ad9361_spi_writem(phy->spi, REG_RX_FAST_LOCK_PROGRAM_DATA + offs, buf, 2);
+	ad9361_spi_writem(phy, REG_RX_FAST_LOCK_PROGRAM_DATA + offs, buf, 2);
 
 	for (i = 1; i < RX_FAST_LOCK_CONFIG_WORD_NUM; i++) {
 		buf[0] = RX_FAST_LOCK_PROGRAM_WRITE | RX_FAST_LOCK_PROGRAM_CLOCK_ENABLE;
 		buf[1] = 0;
 		buf[2] = values[i];
 		buf[3] = RX_FAST_LOCK_PROFILE_ADDR(profile) | RX_FAST_LOCK_PROFILE_WORD(i);
-		ad9361_spi_writem(phy->spi, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs, buf, 4);
+		ad9361_spi_writem(phy, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs, buf, 4);
 	}
 
-	ad9361_spi_write(phy->spi, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs,
+	ad9361_spi_write(phy, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs,
 			 RX_FAST_LOCK_PROGRAM_WRITE | RX_FAST_LOCK_PROGRAM_CLOCK_ENABLE);
-	ad9361_spi_write(phy->spi, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs, 0);
+	ad9361_spi_write(phy, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs, 0);
 
 	phy->fastlock.entry[tx][profile].flags = FASTLOOK_INIT;
 	phy->fastlock.entry[tx][profile].alc_orig = values[15];
@@ -5047,7 +5173,6 @@ int32_t ad9361_fastlock_load(struct ad9361_rf_phy *phy, bool tx,
 int32_t ad9361_fastlock_store(struct ad9361_rf_phy *phy, bool tx,
 			      uint32_t profile)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint8_t val[16];
 	uint32_t offs = 0, x, y;
 
@@ -5057,52 +5182,52 @@ int32_t ad9361_fastlock_store(struct ad9361_rf_phy *phy, bool tx,
 	if (tx)
 		offs = REG_TX_FAST_LOCK_SETUP - REG_RX_FAST_LOCK_SETUP;
 
-	val[0] = ad9361_spi_read(spi, REG_RX_INTEGER_BYTE_0 + offs);
-	val[1] = ad9361_spi_read(spi, REG_RX_INTEGER_BYTE_1 + offs);
-	val[2] = ad9361_spi_read(spi, REG_RX_FRACT_BYTE_0 + offs);
-	val[3] = ad9361_spi_read(spi, REG_RX_FRACT_BYTE_1 + offs);
-	val[4] = ad9361_spi_read(spi, REG_RX_FRACT_BYTE_2 + offs);
+	val[0] = ad9361_spi_read(phy, REG_RX_INTEGER_BYTE_0 + offs);
+	val[1] = ad9361_spi_read(phy, REG_RX_INTEGER_BYTE_1 + offs);
+	val[2] = ad9361_spi_read(phy, REG_RX_FRACT_BYTE_0 + offs);
+	val[3] = ad9361_spi_read(phy, REG_RX_FRACT_BYTE_1 + offs);
+	val[4] = ad9361_spi_read(phy, REG_RX_FRACT_BYTE_2 + offs);
 
-	x = ad9361_spi_readf(spi, REG_RX_VCO_BIAS_1 + offs, VCO_BIAS_REF(~0));
-	y = ad9361_spi_readf(spi, REG_RX_ALC_VARACTOR + offs, VCO_VARACTOR(~0));
+	x = ad9361_spi_readf(phy, REG_RX_VCO_BIAS_1 + offs, VCO_BIAS_REF(~0));
+	y = ad9361_spi_readf(phy, REG_RX_ALC_VARACTOR + offs, VCO_VARACTOR(~0));
 	val[5] = (x << 4) | y;
 
-	x = ad9361_spi_readf(spi, REG_RX_VCO_BIAS_1 + offs, VCO_BIAS_TCF(~0));
-	y = ad9361_spi_readf(spi, REG_RX_CP_CURRENT + offs, CHARGE_PUMP_CURRENT(~0));
+	x = ad9361_spi_readf(phy, REG_RX_VCO_BIAS_1 + offs, VCO_BIAS_TCF(~0));
+	y = ad9361_spi_readf(phy, REG_RX_CP_CURRENT + offs, CHARGE_PUMP_CURRENT(~0));
 	/* Wide BW option: N = 1
 	* Set init and steady state values to the same - let user space handle it
 	*/
 	val[6] = (x << 6) | y;
 	val[7] = y;
 
-	x = ad9361_spi_readf(spi, REG_RX_LOOP_FILTER_3 + offs, LOOP_FILTER_R3(~0));
+	x = ad9361_spi_readf(phy, REG_RX_LOOP_FILTER_3 + offs, LOOP_FILTER_R3(~0));
 	val[8] = (x << 4) | x;
 
-	x = ad9361_spi_readf(spi, REG_RX_LOOP_FILTER_2 + offs, LOOP_FILTER_C3(~0));
+	x = ad9361_spi_readf(phy, REG_RX_LOOP_FILTER_2 + offs, LOOP_FILTER_C3(~0));
 	val[9] = (x << 4) | x;
 
-	x = ad9361_spi_readf(spi, REG_RX_LOOP_FILTER_1 + offs, LOOP_FILTER_C1(~0));
-	y = ad9361_spi_readf(spi, REG_RX_LOOP_FILTER_1 + offs, LOOP_FILTER_C2(~0));
+	x = ad9361_spi_readf(phy, REG_RX_LOOP_FILTER_1 + offs, LOOP_FILTER_C1(~0));
+	y = ad9361_spi_readf(phy, REG_RX_LOOP_FILTER_1 + offs, LOOP_FILTER_C2(~0));
 	val[10] = (x << 4) | y;
 
-	x = ad9361_spi_readf(spi, REG_RX_LOOP_FILTER_2 + offs, LOOP_FILTER_R1(~0));
+	x = ad9361_spi_readf(phy, REG_RX_LOOP_FILTER_2 + offs, LOOP_FILTER_R1(~0));
 	val[11] = (x << 4) | x;
 
-	x = ad9361_spi_readf(spi, REG_RX_VCO_VARACTOR_CTRL_0 + offs,
+	x = ad9361_spi_readf(phy, REG_RX_VCO_VARACTOR_CTRL_0 + offs,
 			     VCO_VARACTOR_REFERENCE_TCF(~0));
-	y = ad9361_spi_readf(spi, REG_RFPLL_DIVIDERS,
+	y = ad9361_spi_readf(phy, REG_RFPLL_DIVIDERS,
 			     tx ? TX_VCO_DIVIDER(~0) : RX_VCO_DIVIDER(~0));
 	val[12] = (x << 4) | y;
 
-	x = ad9361_spi_readf(spi, REG_RX_FORCE_VCO_TUNE_1 + offs, VCO_CAL_OFFSET(~0));
-	y = ad9361_spi_readf(spi, REG_RX_VCO_VARACTOR_CTRL_1 + offs,
+	x = ad9361_spi_readf(phy, REG_RX_FORCE_VCO_TUNE_1 + offs, VCO_CAL_OFFSET(~0));
+	y = ad9361_spi_readf(phy, REG_RX_VCO_VARACTOR_CTRL_1 + offs,
 			     VCO_VARACTOR_REFERENCE(~0));
 	val[13] = (x << 4) | y;
 
-	val[14] = ad9361_spi_read(spi, REG_RX_FORCE_VCO_TUNE_0 + offs);
+	val[14] = ad9361_spi_read(phy, REG_RX_FORCE_VCO_TUNE_0 + offs);
 
-	x = ad9361_spi_readf(spi, REG_RX_FORCE_ALC + offs, FORCE_ALC_WORD(~0));
-	y = ad9361_spi_readf(spi, REG_RX_FORCE_VCO_TUNE_1 + offs, FORCE_VCO_TUNE);
+	x = ad9361_spi_readf(phy, REG_RX_FORCE_ALC + offs, FORCE_ALC_WORD(~0));
+	y = ad9361_spi_readf(phy, REG_RX_FORCE_VCO_TUNE_1 + offs, FORCE_VCO_TUNE);
 	val[15] = (x << 1) | y;
 
 	return ad9361_fastlock_load(phy, tx, profile, val);
@@ -5137,29 +5262,29 @@ static int32_t ad9361_fastlock_prepare(struct ad9361_rf_phy *phy, bool tx,
 	is_prepared = !!phy->fastlock.current_profile[tx];
 
 	if (prepare && !is_prepared) {
-		ad9361_spi_write(phy->spi,
+		ad9361_spi_write(phy,
 				 REG_RX_FAST_LOCK_SETUP_INIT_DELAY + offs,
 				 (tx ? phy->pdata->tx_fastlock_delay_ns :
 				  phy->pdata->rx_fastlock_delay_ns) / 250);
-		ad9361_spi_write(phy->spi, REG_RX_FAST_LOCK_SETUP + offs,
+		ad9361_spi_write(phy, REG_RX_FAST_LOCK_SETUP + offs,
 				 RX_FAST_LOCK_PROFILE(profile) |
 				 RX_FAST_LOCK_MODE_ENABLE);
-		ad9361_spi_write(phy->spi, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs,
+		ad9361_spi_write(phy, REG_RX_FAST_LOCK_PROGRAM_CTRL + offs,
 				 0);
 
-		ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_2, ready_mask, 1);
+		ad9361_spi_writef(phy, REG_ENSM_CONFIG_2, ready_mask, 1);
 		ad9361_trx_vco_cal_control(phy, tx, false);
 	} else if (!prepare && is_prepared) {
-		ad9361_spi_write(phy->spi, REG_RX_FAST_LOCK_SETUP + offs, 0);
+		ad9361_spi_write(phy, REG_RX_FAST_LOCK_SETUP + offs, 0);
 
 		/* Workaround: Exiting Fastlock Mode */
-		ad9361_spi_writef(phy->spi, REG_RX_FORCE_ALC + offs, FORCE_ALC_ENABLE, 1);
-		ad9361_spi_writef(phy->spi, REG_RX_FORCE_VCO_TUNE_1 + offs, FORCE_VCO_TUNE, 1);
-		ad9361_spi_writef(phy->spi, REG_RX_FORCE_ALC + offs, FORCE_ALC_ENABLE, 0);
-		ad9361_spi_writef(phy->spi, REG_RX_FORCE_VCO_TUNE_1 + offs, FORCE_VCO_TUNE, 0);
+		ad9361_spi_writef(phy, REG_RX_FORCE_ALC + offs, FORCE_ALC_ENABLE, 1);
+		ad9361_spi_writef(phy, REG_RX_FORCE_VCO_TUNE_1 + offs, FORCE_VCO_TUNE, 1);
+		ad9361_spi_writef(phy, REG_RX_FORCE_ALC + offs, FORCE_ALC_ENABLE, 0);
+		ad9361_spi_writef(phy, REG_RX_FORCE_VCO_TUNE_1 + offs, FORCE_VCO_TUNE, 0);
 
 		ad9361_trx_vco_cal_control(phy, tx, true);
-		ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_2, ready_mask, 0);
+		ad9361_spi_writef(phy, REG_ENSM_CONFIG_2, ready_mask, 0);
 
 		phy->fastlock.current_profile[tx] = 0;
 	}
@@ -5195,7 +5320,7 @@ int32_t ad9361_fastlock_recall(struct ad9361_rf_phy *phy, bool tx,
 	_new = phy->fastlock.entry[tx][profile].alc_written;
 
 	if (current_profile == 0)
-		curr = ad9361_spi_readf(phy->spi, REG_RX_FORCE_ALC + offs,
+		curr = ad9361_spi_readf(phy, REG_RX_FORCE_ALC + offs,
 					FORCE_ALC_WORD(~0)) << 1;
 	else
 		curr = phy->fastlock.entry[tx][current_profile - 1].alc_written;
@@ -5208,14 +5333,14 @@ int32_t ad9361_fastlock_recall(struct ad9361_rf_phy *phy, bool tx,
 		else
 			phy->fastlock.entry[tx][profile].alc_written = orig;
 
-		ad9361_fastlock_writeval(phy->spi, tx, profile, 0xF,
+		ad9361_fastlock_writeval(phy, tx, profile, 0xF,
 					 phy->fastlock.entry[tx][profile].alc_written, true);
 	}
 
 	ad9361_fastlock_prepare(phy, tx, profile, true);
 	phy->fastlock.current_profile[tx] = profile + 1;
 
-	return ad9361_spi_write(phy->spi, REG_RX_FAST_LOCK_SETUP + offs,
+	return ad9361_spi_write(phy, REG_RX_FAST_LOCK_SETUP + offs,
 				RX_FAST_LOCK_PROFILE(profile) |
 				(phy->pdata->trx_fastlock_pinctrl_en[tx] ?
 				 RX_FAST_LOCK_PROFILE_PIN_SELECT : 0) |
@@ -5239,7 +5364,7 @@ int32_t ad9361_fastlock_save(struct ad9361_rf_phy *phy, bool tx,
 		__func__, tx ? "TX" : "RX", profile);
 
 	for (i = 0; i < RX_FAST_LOCK_CONFIG_WORD_NUM; i++)
-		values[i] = ad9361_fastlock_readval(phy->spi, tx, profile, i);
+		values[i] = ad9361_fastlock_readval(phy, tx, profile, i);
 
 	return 0;
 }
@@ -5262,12 +5387,12 @@ int32_t ad9361_mcs(struct ad9361_rf_phy *phy, int32_t step)
 		/* REVIST:
 		* POWER_DOWN_TRX_SYNTH and MCS_RF_ENABLE somehow conflict
 		*/
-		ad9361_spi_writef(phy->spi, REG_ENSM_CONFIG_2,
+		ad9361_spi_writef(phy, REG_ENSM_CONFIG_2,
 				  POWER_DOWN_TX_SYNTH | POWER_DOWN_RX_SYNTH, 0);
 
-		ad9361_spi_writef(phy->spi, REG_MULTICHIP_SYNC_AND_TX_MON_CTRL,
+		ad9361_spi_writef(phy, REG_MULTICHIP_SYNC_AND_TX_MON_CTRL,
 				  mcs_mask, MCS_BB_ENABLE | MCS_BBPLL_ENABLE | MCS_RF_ENABLE);
-		ad9361_spi_writef(phy->spi, REG_CP_BLEED_CURRENT,
+		ad9361_spi_writef(phy, REG_CP_BLEED_CURRENT,
 				  MCS_REFCLK_SCALE_EN, 1);
 		break;
 	case 2:
@@ -5282,7 +5407,7 @@ int32_t ad9361_mcs(struct ad9361_rf_phy *phy, int32_t step)
 		no_os_gpio_set_value(phy->gpio_desc_sync, 0);
 		break;
 	case 3:
-		ad9361_spi_writef(phy->spi, REG_MULTICHIP_SYNC_AND_TX_MON_CTRL,
+		ad9361_spi_writef(phy, REG_MULTICHIP_SYNC_AND_TX_MON_CTRL,
 				  mcs_mask, MCS_BB_ENABLE | MCS_DIGITAL_CLK_ENABLE | MCS_RF_ENABLE);
 		break;
 	case 4:
@@ -5292,7 +5417,7 @@ int32_t ad9361_mcs(struct ad9361_rf_phy *phy, int32_t step)
 		no_os_gpio_set_value(phy->gpio_desc_sync, 0);
 		break;
 	case 5:
-		ad9361_spi_writef(phy->spi, REG_MULTICHIP_SYNC_AND_TX_MON_CTRL,
+		ad9361_spi_writef(phy, REG_MULTICHIP_SYNC_AND_TX_MON_CTRL,
 				  mcs_mask, MCS_RF_ENABLE);
 		break;
 	}
@@ -5367,7 +5492,6 @@ static uint32_t ad9361_ref_div_sel(uint32_t refin_Hz, uint32_t max)
 int32_t ad9361_setup(struct ad9361_rf_phy *phy)
 {
 	uint32_t refin_Hz, ref_freq, bbpll_freq;
-	struct no_os_spi_desc *spi = phy->spi;
 	struct ad9361_phy_platform_data *pd = phy->pdata;
 	int32_t ret;
 	uint32_t real_rx_bandwidth, real_tx_bandwidth;
@@ -5403,10 +5527,10 @@ int32_t ad9361_setup(struct ad9361_rf_phy *phy)
 	if (pd->port_ctrl.pp_conf[2] & FDD_RX_RATE_2TX_RATE)
 		phy->rx_eq_2tx = true;
 
-	ad9361_spi_write(spi, REG_CTRL, CTRL_ENABLE);
-	ad9361_spi_write(spi, REG_BANDGAP_CONFIG0,
+	ad9361_spi_write(phy, REG_CTRL, CTRL_ENABLE);
+	ad9361_spi_write(phy, REG_BANDGAP_CONFIG0,
 			 MASTER_BIAS_TRIM(0x0E)); /* Enable Master Bias */
-	ad9361_spi_write(spi, REG_BANDGAP_CONFIG1,
+	ad9361_spi_write(phy, REG_BANDGAP_CONFIG1,
 			 BANDGAP_TEMP_TRIM(0x0E)); /* Set Bandgap Trim */
 
 	ad9361_set_dcxo_tune(phy, pd->dcxo_coarse, pd->dcxo_fine);
@@ -5417,14 +5541,14 @@ int32_t ad9361_setup(struct ad9361_rf_phy *phy)
 	if (!ref_freq)
 		return -EINVAL;
 
-	ad9361_spi_writef(spi, REG_REF_DIVIDE_CONFIG_1, RX_REF_RESET_BAR, 1);
-	ad9361_spi_writef(spi, REG_REF_DIVIDE_CONFIG_2, TX_REF_RESET_BAR, 1);
-	ad9361_spi_writef(spi, REG_REF_DIVIDE_CONFIG_2,
+	ad9361_spi_writef(phy, REG_REF_DIVIDE_CONFIG_1, RX_REF_RESET_BAR, 1);
+	ad9361_spi_writef(phy, REG_REF_DIVIDE_CONFIG_2, TX_REF_RESET_BAR, 1);
+	ad9361_spi_writef(phy, REG_REF_DIVIDE_CONFIG_2,
 			  TX_REF_DOUBLER_FB_DELAY(~0), 3); /* FB DELAY */
-	ad9361_spi_writef(spi, REG_REF_DIVIDE_CONFIG_2,
+	ad9361_spi_writef(phy, REG_REF_DIVIDE_CONFIG_2,
 			  RX_REF_DOUBLER_FB_DELAY(~0), 3); /* FB DELAY */
 
-	ad9361_spi_write(spi, REG_CLOCK_ENABLE,
+	ad9361_spi_write(phy, REG_CLOCK_ENABLE,
 			 DIGITAL_POWER_UP | CLOCK_ENABLE_DFLT | BBPLL_ENABLE |
 			 (pd->use_extclk ? XO_BYPASS : 0)); /* Enable Clocks */
 
@@ -5442,8 +5566,8 @@ int32_t ad9361_setup(struct ad9361_rf_phy *phy)
 		return ret;
 	}
 
-	ad9361_spi_write(spi, REG_FRACT_BB_FREQ_WORD_2, 0x12);
-	ad9361_spi_write(spi, REG_FRACT_BB_FREQ_WORD_3, 0x34);
+	ad9361_spi_write(phy, REG_FRACT_BB_FREQ_WORD_2, 0x12);
+	ad9361_spi_write(phy, REG_FRACT_BB_FREQ_WORD_3, 0x34);
 
 	ret = ad9361_set_trx_clock_chain(phy, pd->rx_path_clks,
 					 pd->tx_path_clks);
@@ -5631,7 +5755,7 @@ int32_t ad9361_setup(struct ad9361_rf_phy *phy)
 	if (ret < 0)
 		return ret;
 
-	ad9361_spi_writef(phy->spi, REG_TX_ATTEN_OFFSET,
+	ad9361_spi_writef(phy, REG_TX_ATTEN_OFFSET,
 			  MASK_CLR_ATTEN_UPDATE, 0);
 
 	ret = ad9361_set_tx_atten(phy, pd->tx_atten,
@@ -5660,7 +5784,7 @@ int32_t ad9361_setup(struct ad9361_rf_phy *phy)
 	if (ret < 0)
 		return ret;
 
-	phy->curr_ensm_state = ad9361_spi_readf(spi, REG_STATE, ENSM_STATE(~0));
+	phy->curr_ensm_state = ad9361_spi_readf(phy, REG_STATE, ENSM_STATE(~0));
 	ad9361_ensm_set_state(phy, pd->fdd ? ENSM_STATE_FDD : ENSM_STATE_RX,
 			      pd->ensm_pin_ctrl);
 
@@ -5765,7 +5889,6 @@ static int32_t ad9361_verify_fir_filter_coef(struct ad9361_rf_phy *phy,
 		enum fir_dest dest,
 		uint32_t ntaps, short *coef)
 {
-	struct no_os_spi_desc *spi = phy->spi;
 	uint32_t val, offs = 0, gain = 0, conf, sel, cnt;
 	int32_t ret = 0;
 
@@ -5776,12 +5899,12 @@ static int32_t ad9361_verify_fir_filter_coef(struct ad9361_rf_phy *phy,
 		__func__, ntaps, dest);
 
 	if (dest & FIR_IS_RX) {
-		gain = ad9361_spi_read(spi, REG_RX_FILTER_GAIN);
+		gain = ad9361_spi_read(phy, REG_RX_FILTER_GAIN);
 		offs = REG_RX_FILTER_COEF_ADDR - REG_TX_FILTER_COEF_ADDR;
-		ad9361_spi_write(spi, REG_RX_FILTER_GAIN, 0);
+		ad9361_spi_write(phy, REG_RX_FILTER_GAIN, 0);
 	}
 
-	conf = ad9361_spi_read(spi, REG_TX_FILTER_CONF + offs);
+	conf = ad9361_spi_read(phy, REG_TX_FILTER_CONF + offs);
 
 	if ((dest & 3) == 3) {
 		sel = 1;
@@ -5793,15 +5916,15 @@ static int32_t ad9361_verify_fir_filter_coef(struct ad9361_rf_phy *phy,
 
 	for (; cnt > 0; cnt--, sel++) {
 
-		ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs,
+		ad9361_spi_write(phy, REG_TX_FILTER_CONF + offs,
 				 FIR_NUM_TAPS(ntaps / 16 - 1) |
 				 FIR_SELECT(sel) | FIR_START_CLK);
 		for (val = 0; val < ntaps; val++) {
 			short tmp;
-			ad9361_spi_write(spi, REG_TX_FILTER_COEF_ADDR + offs, val);
+			ad9361_spi_write(phy, REG_TX_FILTER_COEF_ADDR + offs, val);
 
-			tmp = (ad9361_spi_read(spi, REG_TX_FILTER_COEF_READ_DATA_1 + offs) & 0xFF) |
-			      (ad9361_spi_read(spi, REG_TX_FILTER_COEF_READ_DATA_2 + offs) << 8);
+			tmp = (ad9361_spi_read(phy, REG_TX_FILTER_COEF_READ_DATA_1 + offs) & 0xFF) |
+			      (ad9361_spi_read(phy, REG_TX_FILTER_COEF_READ_DATA_2 + offs) << 8);
 
 			if (tmp != coef[val]) {
 				dev_err(&phy->spi->dev,"%s%"PRIu32" read verify failed TAP%"PRIu32" %d =! %d",
@@ -5813,10 +5936,10 @@ static int32_t ad9361_verify_fir_filter_coef(struct ad9361_rf_phy *phy,
 	}
 
 	if (dest & FIR_IS_RX) {
-		ad9361_spi_write(spi, REG_RX_FILTER_GAIN, gain);
+		ad9361_spi_write(phy, REG_RX_FILTER_GAIN, gain);
 	}
 
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, conf);
+	ad9361_spi_write(phy, REG_TX_FILTER_CONF + offs, conf);
 
 	return ret;
 }
@@ -5853,21 +5976,21 @@ int32_t ad9361_load_fir_filter_coef(struct ad9361_rf_phy *phy,
 
 	if (dest & FIR_IS_RX) {
 		val = 3 - (gain_dB + 12) / 6;
-		ad9361_spi_write(spi, REG_RX_FILTER_GAIN, val & 0x3);
+		ad9361_spi_write(phy, REG_RX_FILTER_GAIN, val & 0x3);
 		offs = REG_RX_FILTER_COEF_ADDR - REG_TX_FILTER_COEF_ADDR;
 		phy->rx_fir_ntaps = ntaps;
-		fir_enable = ad9361_spi_readf(phy->spi,
+		fir_enable = ad9361_spi_readf(phy,
 					      REG_RX_ENABLE_FILTER_CTRL, RX_FIR_ENABLE_DECIMATION(~0));
-		ad9361_spi_writef(phy->spi, REG_RX_ENABLE_FILTER_CTRL,
+		ad9361_spi_writef(phy, REG_RX_ENABLE_FILTER_CTRL,
 				  RX_FIR_ENABLE_DECIMATION(~0),
 				  (phy->rx_fir_dec == 4) ? 3 : phy->rx_fir_dec);
 	} else {
 		if (gain_dB == -6)
 			fir_conf = TX_FIR_GAIN_6DB;
 		phy->tx_fir_ntaps = ntaps;
-		fir_enable = ad9361_spi_readf(phy->spi,
+		fir_enable = ad9361_spi_readf(phy,
 					      REG_TX_ENABLE_FILTER_CTRL, TX_FIR_ENABLE_INTERPOLATION(~0));
-		ad9361_spi_writef(phy->spi, REG_TX_ENABLE_FILTER_CTRL,
+		ad9361_spi_writef(phy, REG_TX_ENABLE_FILTER_CTRL,
 				  TX_FIR_ENABLE_INTERPOLATION(~0),
 				  (phy->tx_fir_int == 4) ? 3 : phy->tx_fir_int);
 	}
@@ -5876,31 +5999,38 @@ int32_t ad9361_load_fir_filter_coef(struct ad9361_rf_phy *phy,
 
 	fir_conf |= FIR_NUM_TAPS(val) | FIR_SELECT(dest) | FIR_START_CLK;
 
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, fir_conf);
+	ret = no_os_spi_batch_begin(spi);
+	if (ret < 0)
+		goto out;
+
+	ad9361_spi_write(phy, REG_TX_FILTER_CONF + offs, fir_conf);
 
 	for (val = 0; val < ntaps; val++) {
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_ADDR + offs, val);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_WRITE_DATA_1 + offs,
+		ad9361_spi_write(phy, REG_TX_FILTER_COEF_ADDR + offs, val);
+		ad9361_spi_write(phy, REG_TX_FILTER_COEF_WRITE_DATA_1 + offs,
 				 coef[val] & 0xFF);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_WRITE_DATA_2 + offs,
+		ad9361_spi_write(phy, REG_TX_FILTER_COEF_WRITE_DATA_2 + offs,
 				 coef[val] >> 8);
-		ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs,
+		ad9361_spi_write(phy, REG_TX_FILTER_CONF + offs,
 				 fir_conf | FIR_WRITE);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
+		ad9361_spi_write(phy, REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
+		ad9361_spi_write(phy, REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
 	}
 
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, fir_conf);
+	ad9361_spi_write(phy, REG_TX_FILTER_CONF + offs, fir_conf);
 	fir_conf &= ~FIR_START_CLK;
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, fir_conf);
+	ad9361_spi_write(phy, REG_TX_FILTER_CONF + offs, fir_conf);
 
-	ret = ad9361_verify_fir_filter_coef(phy, dest, ntaps, coef);
+	ret = no_os_spi_batch_end(spi);
+	if (!ret)
+		ret = ad9361_verify_fir_filter_coef(phy, dest, ntaps, coef);
 
+out:
 	if (dest & FIR_IS_RX)
-		ad9361_spi_writef(phy->spi, REG_RX_ENABLE_FILTER_CTRL,
+		ad9361_spi_writef(phy, REG_RX_ENABLE_FILTER_CTRL,
 				  RX_FIR_ENABLE_DECIMATION(~0), fir_enable);
 	else
-		ad9361_spi_writef(phy->spi, REG_TX_ENABLE_FILTER_CTRL,
+		ad9361_spi_writef(phy, REG_TX_ENABLE_FILTER_CTRL,
 				  TX_FIR_ENABLE_INTERPOLATION(~0), fir_enable);
 
 	ad9361_ensm_restore_prev_state(phy);
@@ -6232,40 +6362,40 @@ static inline int32_t ad9361_set_muldiv(struct refclk_scale *priv, uint32_t mul,
  */
 static int32_t ad9361_get_clk_scaler(struct refclk_scale *clk_priv)
 {
-	struct no_os_spi_desc *spi = clk_priv->spi;
+	struct ad9361_rf_phy *phy = clk_priv->phy;
 	uint32_t tmp, tmp1;
 
 	switch (clk_priv->source) {
 	case BB_REFCLK:
-		tmp = ad9361_spi_read(spi, REG_CLOCK_CTRL);
+		tmp = ad9361_spi_read(phy, REG_CLOCK_CTRL);
 		tmp &= 0x3;
 		break;
 	case RX_REFCLK:
-		tmp = ad9361_spi_readf(spi, REG_REF_DIVIDE_CONFIG_1,
+		tmp = ad9361_spi_readf(phy, REG_REF_DIVIDE_CONFIG_1,
 				       RX_REF_DIVIDER_MSB);
-		tmp1 = ad9361_spi_readf(spi, REG_REF_DIVIDE_CONFIG_2,
+		tmp1 = ad9361_spi_readf(phy, REG_REF_DIVIDE_CONFIG_2,
 					RX_REF_DIVIDER_LSB);
 		tmp = (tmp << 1) | tmp1;
 		break;
 	case TX_REFCLK:
-		tmp = ad9361_spi_readf(spi, REG_REF_DIVIDE_CONFIG_2,
+		tmp = ad9361_spi_readf(phy, REG_REF_DIVIDE_CONFIG_2,
 				       TX_REF_DIVIDER(~0));
 		break;
 	case ADC_CLK:
-		tmp = ad9361_spi_read(spi, REG_BBPLL);
+		tmp = ad9361_spi_read(phy, REG_BBPLL);
 		return ad9361_set_muldiv(clk_priv, 1, 1 << (tmp & 0x7));
 	case R2_CLK:
-		tmp = ad9361_spi_readf(spi, REG_RX_ENABLE_FILTER_CTRL,
+		tmp = ad9361_spi_readf(phy, REG_RX_ENABLE_FILTER_CTRL,
 				       DEC3_ENABLE_DECIMATION(~0));
 		return ad9361_set_muldiv(clk_priv, 1, tmp + 1);
 	case R1_CLK:
-		tmp = ad9361_spi_readf(spi, REG_RX_ENABLE_FILTER_CTRL, RHB2_EN);
+		tmp = ad9361_spi_readf(phy, REG_RX_ENABLE_FILTER_CTRL, RHB2_EN);
 		return ad9361_set_muldiv(clk_priv, 1, tmp + 1);
 	case CLKRF_CLK:
-		tmp = ad9361_spi_readf(spi, REG_RX_ENABLE_FILTER_CTRL, RHB1_EN);
+		tmp = ad9361_spi_readf(phy, REG_RX_ENABLE_FILTER_CTRL, RHB1_EN);
 		return ad9361_set_muldiv(clk_priv, 1, tmp + 1);
 	case RX_SAMPL_CLK:
-		tmp = ad9361_spi_readf(spi, REG_RX_ENABLE_FILTER_CTRL,
+		tmp = ad9361_spi_readf(phy, REG_RX_ENABLE_FILTER_CTRL,
 				       RX_FIR_ENABLE_DECIMATION(~0));
 
 		if (!tmp)
@@ -6275,20 +6405,20 @@ static int32_t ad9361_get_clk_scaler(struct refclk_scale *clk_priv)
 
 		return ad9361_set_muldiv(clk_priv, 1, tmp);
 	case DAC_CLK:
-		tmp = ad9361_spi_readf(spi, REG_BBPLL, NO_OS_BIT(3));
+		tmp = ad9361_spi_readf(phy, REG_BBPLL, NO_OS_BIT(3));
 		return ad9361_set_muldiv(clk_priv, 1, tmp + 1);
 	case T2_CLK:
-		tmp = ad9361_spi_readf(spi, REG_TX_ENABLE_FILTER_CTRL,
+		tmp = ad9361_spi_readf(phy, REG_TX_ENABLE_FILTER_CTRL,
 				       THB3_ENABLE_INTERP(~0));
 		return ad9361_set_muldiv(clk_priv, 1, tmp + 1);
 	case T1_CLK:
-		tmp = ad9361_spi_readf(spi, REG_TX_ENABLE_FILTER_CTRL, THB2_EN);
+		tmp = ad9361_spi_readf(phy, REG_TX_ENABLE_FILTER_CTRL, THB2_EN);
 		return ad9361_set_muldiv(clk_priv, 1, tmp + 1);
 	case CLKTF_CLK:
-		tmp = ad9361_spi_readf(spi, REG_TX_ENABLE_FILTER_CTRL, THB1_EN);
+		tmp = ad9361_spi_readf(phy, REG_TX_ENABLE_FILTER_CTRL, THB1_EN);
 		return ad9361_set_muldiv(clk_priv, 1, tmp + 1);
 	case TX_SAMPL_CLK:
-		tmp = ad9361_spi_readf(spi, REG_TX_ENABLE_FILTER_CTRL,
+		tmp = ad9361_spi_readf(phy, REG_TX_ENABLE_FILTER_CTRL,
 				       TX_FIR_ENABLE_INTERPOLATION(~0));
 
 		if (!tmp)
@@ -6355,7 +6485,7 @@ static int32_t ad9361_to_refclk_scaler(struct refclk_scale *clk_priv)
  */
 static int32_t ad9361_set_clk_scaler(struct refclk_scale *clk_priv, bool set)
 {
-	struct no_os_spi_desc *spi = clk_priv->spi;
+	struct ad9361_rf_phy *phy = clk_priv->phy;
 	uint32_t tmp;
 	int32_t ret;
 
@@ -6365,7 +6495,7 @@ static int32_t ad9361_set_clk_scaler(struct refclk_scale *clk_priv, bool set)
 		if (ret < 0)
 			return ret;
 		if (set)
-			return ad9361_spi_writef(spi, REG_CLOCK_CTRL,
+			return ad9361_spi_writef(phy, REG_CLOCK_CTRL,
 						 REF_FREQ_SCALER(~0), ret);
 		break;
 
@@ -6375,9 +6505,9 @@ static int32_t ad9361_set_clk_scaler(struct refclk_scale *clk_priv, bool set)
 			return ret;
 		if (set) {
 			tmp = ret;
-			ret = ad9361_spi_writef(spi, REG_REF_DIVIDE_CONFIG_1,
+			ret = ad9361_spi_writef(phy, REG_REF_DIVIDE_CONFIG_1,
 						RX_REF_DIVIDER_MSB, tmp >> 1);
-			ret |= ad9361_spi_writef(spi, REG_REF_DIVIDE_CONFIG_2,
+			ret |= ad9361_spi_writef(phy, REG_REF_DIVIDE_CONFIG_2,
 						 RX_REF_DIVIDER_LSB, tmp & 1);
 			return ret;
 		}
@@ -6387,7 +6517,7 @@ static int32_t ad9361_set_clk_scaler(struct refclk_scale *clk_priv, bool set)
 		if (ret < 0)
 			return ret;
 		if (set)
-			return ad9361_spi_writef(spi, REG_REF_DIVIDE_CONFIG_2,
+			return ad9361_spi_writef(phy, REG_REF_DIVIDE_CONFIG_2,
 						 TX_REF_DIVIDER(~0), ret);
 		break;
 	case ADC_CLK:
@@ -6396,13 +6526,13 @@ static int32_t ad9361_set_clk_scaler(struct refclk_scale *clk_priv, bool set)
 			return -EINVAL;
 
 		if (set)
-			return ad9361_spi_writef(spi, REG_BBPLL, 0x7, tmp);
+			return ad9361_spi_writef(phy, REG_BBPLL, 0x7, tmp);
 		break;
 	case R2_CLK:
 		if (clk_priv->mult != 1 || clk_priv->div > 3 || clk_priv->div < 1)
 			return -EINVAL;
 		if (set)
-			return ad9361_spi_writef(spi, REG_RX_ENABLE_FILTER_CTRL,
+			return ad9361_spi_writef(phy, REG_RX_ENABLE_FILTER_CTRL,
 						 DEC3_ENABLE_DECIMATION(~0),
 						 clk_priv->div - 1);
 		break;
@@ -6410,14 +6540,14 @@ static int32_t ad9361_set_clk_scaler(struct refclk_scale *clk_priv, bool set)
 		if (clk_priv->mult != 1 || clk_priv->div > 2 || clk_priv->div < 1)
 			return -EINVAL;
 		if (set)
-			return ad9361_spi_writef(spi, REG_RX_ENABLE_FILTER_CTRL,
+			return ad9361_spi_writef(phy, REG_RX_ENABLE_FILTER_CTRL,
 						 RHB2_EN, clk_priv->div - 1);
 		break;
 	case CLKRF_CLK:
 		if (clk_priv->mult != 1 || clk_priv->div > 2 || clk_priv->div < 1)
 			return -EINVAL;
 		if (set)
-			return ad9361_spi_writef(spi, REG_RX_ENABLE_FILTER_CTRL,
+			return ad9361_spi_writef(phy, REG_RX_ENABLE_FILTER_CTRL,
 						 RHB1_EN, clk_priv->div - 1);
 		break;
 	case RX_SAMPL_CLK:
@@ -6431,21 +6561,21 @@ static int32_t ad9361_set_clk_scaler(struct refclk_scale *clk_priv, bool set)
 			tmp = ilog2(clk_priv->div) + 1;
 
 		if (set)
-			return ad9361_spi_writef(spi, REG_RX_ENABLE_FILTER_CTRL,
+			return ad9361_spi_writef(phy, REG_RX_ENABLE_FILTER_CTRL,
 						 RX_FIR_ENABLE_DECIMATION(~0), tmp);
 		break;
 	case DAC_CLK:
 		if (clk_priv->mult != 1 || clk_priv->div > 2 || clk_priv->div < 1)
 			return -EINVAL;
 		if (set)
-			return ad9361_spi_writef(spi, REG_BBPLL,
+			return ad9361_spi_writef(phy, REG_BBPLL,
 						 NO_OS_BIT(3), clk_priv->div - 1);
 		break;
 	case T2_CLK:
 		if (clk_priv->mult != 1 || clk_priv->div > 3 || clk_priv->div < 1)
 			return -EINVAL;
 		if (set)
-			return ad9361_spi_writef(spi, REG_TX_ENABLE_FILTER_CTRL,
+			return ad9361_spi_writef(phy, REG_TX_ENABLE_FILTER_CTRL,
 						 THB3_ENABLE_INTERP(~0),
 						 clk_priv->div - 1);
 		break;
@@ -6453,14 +6583,14 @@ static int32_t ad9361_set_clk_scaler(struct refclk_scale *clk_priv, bool set)
 		if (clk_priv->mult != 1 || clk_priv->div > 2 || clk_priv->div < 1)
 			return -EINVAL;
 		if (set)
-			return ad9361_spi_writef(spi, REG_TX_ENABLE_FILTER_CTRL,
+			return ad9361_spi_writef(phy, REG_TX_ENABLE_FILTER_CTRL,
 						 THB2_EN, clk_priv->div - 1);
 		break;
 	case CLKTF_CLK:
 		if (clk_priv->mult != 1 || clk_priv->div > 2 || clk_priv->div < 1)
 			return -EINVAL;
 		if (set)
-			return ad9361_spi_writef(spi, REG_TX_ENABLE_FILTER_CTRL,
+			return ad9361_spi_writef(phy, REG_TX_ENABLE_FILTER_CTRL,
 						 THB1_EN, clk_priv->div - 1);
 		break;
 	case TX_SAMPL_CLK:
@@ -6474,7 +6604,7 @@ static int32_t ad9361_set_clk_scaler(struct refclk_scale *clk_priv, bool set)
 			tmp = ilog2(clk_priv->div) + 1;
 
 		if (set)
-			return ad9361_spi_writef(spi, REG_TX_ENABLE_FILTER_CTRL,
+			return ad9361_spi_writef(phy, REG_TX_ENABLE_FILTER_CTRL,
 						 TX_FIR_ENABLE_INTERPOLATION(~0), tmp);
 		break;
 	default:
@@ -6580,7 +6710,7 @@ uint32_t ad9361_bbpll_recalc_rate(struct refclk_scale *clk_priv,
 	uint32_t fract, integer;
 	uint8_t buf[4];
 
-	ad9361_spi_readm(clk_priv->spi, REG_INTEGER_BB_FREQ_WORD, &buf[0],
+	ad9361_spi_readm(clk_priv->phy, REG_INTEGER_BB_FREQ_WORD, &buf[0],
 			 REG_INTEGER_BB_FREQ_WORD - REG_FRACT_BB_FREQ_WORD_1 + 1);
 
 	fract = (buf[3] << 16) | (buf[2] << 8) | buf[1];
@@ -6643,14 +6773,14 @@ int32_t ad9361_bbpll_round_rate(struct refclk_scale *clk_priv, uint32_t rate,
 int32_t ad9361_bbpll_set_rate(struct refclk_scale *clk_priv, uint32_t rate,
 			      uint32_t parent_rate)
 {
-	struct no_os_spi_desc *spi = clk_priv->spi;
+	struct ad9361_rf_phy *phy = clk_priv->phy;
 	uint64_t tmp;
 	uint32_t fract, integer;
 	int32_t icp_val;
 	uint8_t lf_defaults[3] = { 0x35, 0x5B, 0xE8 };
 	uint64_t temp;
 
-	dev_dbg(&spi->dev, "%s: Rate %"PRIu32" Hz Parent Rate %"PRIu32" Hz",
+	dev_dbg(&phy->spi->dev, "%s: Rate %"PRIu32" Hz Parent Rate %"PRIu32" Hz",
 		__func__, rate, parent_rate);
 
 	/*
@@ -6665,15 +6795,15 @@ int32_t ad9361_bbpll_set_rate(struct refclk_scale *clk_priv, uint32_t rate,
 
 	icp_val = no_os_clamp(icp_val, 1, 64);
 
-	ad9361_spi_write(spi, REG_CP_CURRENT, icp_val);
-	ad9361_spi_writem(spi, REG_LOOP_FILTER_3, lf_defaults,
+	ad9361_spi_write(phy, REG_CP_CURRENT, icp_val);
+	ad9361_spi_writem(phy, REG_LOOP_FILTER_3, lf_defaults,
 			  NO_OS_ARRAY_SIZE(lf_defaults));
 
 	/* Allow calibration to occur and set cal count to 1024 for max accuracy */
-	ad9361_spi_write(spi, REG_VCO_CTRL,
+	ad9361_spi_write(phy, REG_VCO_CTRL,
 			 FREQ_CAL_ENABLE | FREQ_CAL_COUNT_LENGTH(3));
 	/* Set calibration clock to REFCLK/4 for more accuracy */
-	ad9361_spi_write(spi, REG_SDM_CTRL, 0x10);
+	ad9361_spi_write(phy, REG_SDM_CTRL, 0x10);
 
 	/* Calculate and set BBPLL frequency word */
 	temp = rate;
@@ -6685,21 +6815,21 @@ int32_t ad9361_bbpll_set_rate(struct refclk_scale *clk_priv, uint32_t rate,
 	integer = rate;
 	fract = tmp;
 
-	ad9361_spi_write(spi, REG_INTEGER_BB_FREQ_WORD, integer);
-	ad9361_spi_write(spi, REG_FRACT_BB_FREQ_WORD_3, fract);
-	ad9361_spi_write(spi, REG_FRACT_BB_FREQ_WORD_2, fract >> 8);
-	ad9361_spi_write(spi, REG_FRACT_BB_FREQ_WORD_1, fract >> 16);
+	ad9361_spi_write(phy, REG_INTEGER_BB_FREQ_WORD, integer);
+	ad9361_spi_write(phy, REG_FRACT_BB_FREQ_WORD_3, fract);
+	ad9361_spi_write(phy, REG_FRACT_BB_FREQ_WORD_2, fract >> 8);
+	ad9361_spi_write(phy, REG_FRACT_BB_FREQ_WORD_1, fract >> 16);
 
-	ad9361_spi_write(spi, REG_SDM_CTRL_1,
+	ad9361_spi_write(phy, REG_SDM_CTRL_1,
 			 INIT_BB_FO_CAL | BBPLL_RESET_BAR); /* Start BBPLL Calibration */
-	ad9361_spi_write(spi, REG_SDM_CTRL_1,
+	ad9361_spi_write(phy, REG_SDM_CTRL_1,
 			 BBPLL_RESET_BAR); /* Clear BBPLL start calibration bit */
 
-	ad9361_spi_write(spi, REG_VCO_PROGRAM_1,
+	ad9361_spi_write(phy, REG_VCO_PROGRAM_1,
 			 0x86); /* Increase BBPLL KV and phase margin */
-	ad9361_spi_write(spi, REG_VCO_PROGRAM_2,
+	ad9361_spi_write(phy, REG_VCO_PROGRAM_2,
 			 0x01); /* Increase BBPLL KV and phase margin */
-	ad9361_spi_write(spi, REG_VCO_PROGRAM_2,
+	ad9361_spi_write(phy, REG_VCO_PROGRAM_2,
 			 0x05); /* Increase BBPLL KV and phase margin */
 
 	return ad9361_check_cal_done(clk_priv->phy, REG_CH_1_OVERFLOW,
@@ -6809,16 +6939,16 @@ uint32_t ad9361_rfpll_int_recalc_rate(struct refclk_scale *clk_priv,
 		bool tx = clk_priv->source == TX_RFPLL_INT;
 		profile = profile - 1;
 
-		buf[0] = ad9361_fastlock_readval(phy->spi, tx, profile, 4);
-		buf[1] = ad9361_fastlock_readval(phy->spi, tx, profile, 3);
-		buf[2] = ad9361_fastlock_readval(phy->spi, tx, profile, 2);
-		buf[3] = ad9361_fastlock_readval(phy->spi, tx, profile, 1);
-		buf[4] = ad9361_fastlock_readval(phy->spi, tx, profile, 0);
-		vco_div = ad9361_fastlock_readval(phy->spi, tx, profile, 12) & 0xF;
+		buf[0] = ad9361_fastlock_readval(phy, tx, profile, 4);
+		buf[1] = ad9361_fastlock_readval(phy, tx, profile, 3);
+		buf[2] = ad9361_fastlock_readval(phy, tx, profile, 2);
+		buf[3] = ad9361_fastlock_readval(phy, tx, profile, 1);
+		buf[4] = ad9361_fastlock_readval(phy, tx, profile, 0);
+		vco_div = ad9361_fastlock_readval(phy, tx, profile, 12) & 0xF;
 
 	} else {
-		ad9361_spi_readm(clk_priv->spi, reg, &buf[0], NO_OS_ARRAY_SIZE(buf));
-		vco_div = ad9361_spi_readf(clk_priv->spi, REG_RFPLL_DIVIDERS, div_mask);
+		ad9361_spi_readm(clk_priv->phy, reg, &buf[0], NO_OS_ARRAY_SIZE(buf));
+		vco_div = ad9361_spi_readf(clk_priv->phy, REG_RFPLL_DIVIDERS, div_mask);
 	}
 
 	fract = (SYNTH_FRACT_WORD(buf[0]) << 16) | (buf[1] << 8) | buf[2];
@@ -6921,11 +7051,11 @@ int32_t ad9361_rfpll_int_set_rate(struct refclk_scale *clk_priv, uint32_t rate,
 		buf[2] = fract & 0xFF;
 		buf[3] = SYNTH_INTEGER_WORD(integer >> 8) |
 			 (~SYNTH_INTEGER_WORD(~0) &
-			  ad9361_spi_read(clk_priv->spi, reg - 3));
+			  ad9361_spi_read(clk_priv->phy, reg - 3));
 		buf[4] = integer & 0xFF;
 
-		ad9361_spi_writem(clk_priv->spi, reg, buf, 5);
-		ad9361_spi_writef(clk_priv->spi, REG_RFPLL_DIVIDERS, div_mask, vco_div);
+		ad9361_spi_writem(clk_priv->phy, reg, buf, 5);
+		ad9361_spi_writef(clk_priv->phy, REG_RFPLL_DIVIDERS, div_mask, vco_div);
 
 		ret = ad9361_check_cal_done(phy, lock_reg, VCO_LOCK, 1);
 
@@ -7447,68 +7577,68 @@ int32_t ad9361_rssi_gain_step_calib(struct ad9361_rf_phy *phy)
 	ad9361_ensm_force_state(phy, ENSM_STATE_ALERT);
 
 	/* Program the directly-addressable register values. */
-	ad9361_spi_write(phy->spi, REG_MAX_MIXER_CALIBRATION_GAIN_INDEX,
+	ad9361_spi_write(phy, REG_MAX_MIXER_CALIBRATION_GAIN_INDEX,
 			 MAX_MIXER_CALIBRATION_GAIN_INDEX(0x0F));
-	ad9361_spi_write(phy->spi, REG_MEASURE_DURATION,
+	ad9361_spi_write(phy, REG_MEASURE_DURATION,
 			 GAIN_CAL_MEAS_DURATION(0x0E));
-	ad9361_spi_write(phy->spi, REG_SETTLE_TIME,
+	ad9361_spi_write(phy, REG_SETTLE_TIME,
 			 SETTLE_TIME(0x3F));
-	ad9361_spi_write(phy->spi, REG_RSSI_CONFIG,
+	ad9361_spi_write(phy, REG_RSSI_CONFIG,
 			 RSSI_MODE_SELECT(0x3) | DEFAULT_RSSI_MEAS_MODE);
-	ad9361_spi_write(phy->spi, REG_MEASURE_DURATION_01,
+	ad9361_spi_write(phy, REG_MEASURE_DURATION_01,
 			 MEASUREMENT_DURATION_0(0x0E));
-	ad9361_spi_write(phy->spi, REG_LNA_GAIN,
+	ad9361_spi_write(phy, REG_LNA_GAIN,
 			 gain_step_calib_reg_val[lo_index][0]);
 
 	/* Program the LNA gain step words into the internal table. */
-	ad9361_spi_write(phy->spi, REG_CONFIG,
+	ad9361_spi_write(phy, REG_CONFIG,
 			 CALIB_TABLE_SELECT(0x3) | START_CALIB_TABLE_CLOCK);
 	for(i = 0; i < 4; i++) {
-		ad9361_spi_write(phy->spi, REG_WORD_ADDRESS, i);
-		ad9361_spi_write(phy->spi, REG_GAIN_DIFF_WORDERROR_WRITE,
+		ad9361_spi_write(phy, REG_WORD_ADDRESS, i);
+		ad9361_spi_write(phy, REG_GAIN_DIFF_WORDERROR_WRITE,
 				 gain_step_calib_reg_val[lo_index][i+1]);
-		ad9361_spi_write(phy->spi, REG_CONFIG,
+		ad9361_spi_write(phy, REG_CONFIG,
 				 CALIB_TABLE_SELECT(0x3) | WRITE_LNA_GAIN_DIFF | START_CALIB_TABLE_CLOCK);
 		no_os_udelay(3);	//Wait for data to fully write to internal table
 	}
 
-	ad9361_spi_write(phy->spi, REG_CONFIG, START_CALIB_TABLE_CLOCK);
-	ad9361_spi_write(phy->spi, REG_CONFIG, 0x00);
+	ad9361_spi_write(phy, REG_CONFIG, START_CALIB_TABLE_CLOCK);
+	ad9361_spi_write(phy, REG_CONFIG, 0x00);
 
 	/* Run and wait until the calibration completes. */
 	ad9361_run_calibration(phy, RX_GAIN_STEP_CAL);
 
 	/* Read the LNA and Mixer error terms into nonvolatile memory. */
-	ad9361_spi_write(phy->spi, REG_CONFIG, CALIB_TABLE_SELECT(0x1) | READ_SELECT);
+	ad9361_spi_write(phy, REG_CONFIG, CALIB_TABLE_SELECT(0x1) | READ_SELECT);
 	for(i = 0; i < 4; i++) {
-		ad9361_spi_write(phy->spi, REG_WORD_ADDRESS, i);
-		lna_error[i] = ad9361_spi_read(phy->spi, REG_GAIN_ERROR_READ);
+		ad9361_spi_write(phy, REG_WORD_ADDRESS, i);
+		lna_error[i] = ad9361_spi_read(phy, REG_GAIN_ERROR_READ);
 	}
-	ad9361_spi_write(phy->spi, REG_CONFIG, CALIB_TABLE_SELECT(0x1));
+	ad9361_spi_write(phy, REG_CONFIG, CALIB_TABLE_SELECT(0x1));
 	for(i = 0; i < 15; i++) {
-		ad9361_spi_write(phy->spi, REG_WORD_ADDRESS, i);
-		mixer_error[i] = ad9361_spi_read(phy->spi, REG_GAIN_ERROR_READ);
+		ad9361_spi_write(phy, REG_WORD_ADDRESS, i);
+		mixer_error[i] = ad9361_spi_read(phy, REG_GAIN_ERROR_READ);
 	}
-	ad9361_spi_write(phy->spi, REG_CONFIG, 0x00);
+	ad9361_spi_write(phy, REG_CONFIG, 0x00);
 
 	/* Programming gain step errors into the AD9361 in the field */
-	ad9361_spi_write(phy->spi,
+	ad9361_spi_write(phy,
 			 REG_CONFIG, CALIB_TABLE_SELECT(0x3) | START_CALIB_TABLE_CLOCK);
 	for(i = 0; i < 4; i++) {
-		ad9361_spi_write(phy->spi, REG_WORD_ADDRESS, i);
-		ad9361_spi_write(phy->spi, REG_GAIN_DIFF_WORDERROR_WRITE, lna_error[i]);
-		ad9361_spi_write(phy->spi, REG_CONFIG,
+		ad9361_spi_write(phy, REG_WORD_ADDRESS, i);
+		ad9361_spi_write(phy, REG_GAIN_DIFF_WORDERROR_WRITE, lna_error[i]);
+		ad9361_spi_write(phy, REG_CONFIG,
 				 CALIB_TABLE_SELECT(0x3) | WRITE_LNA_ERROR_TABLE | START_CALIB_TABLE_CLOCK);
 	}
-	ad9361_spi_write(phy->spi, REG_CONFIG,
+	ad9361_spi_write(phy, REG_CONFIG,
 			 CALIB_TABLE_SELECT(0x3) | START_CALIB_TABLE_CLOCK);
 	for(i = 0; i < 15; i++) {
-		ad9361_spi_write(phy->spi, REG_WORD_ADDRESS, i);
-		ad9361_spi_write(phy->spi, REG_GAIN_DIFF_WORDERROR_WRITE, mixer_error[i]);
-		ad9361_spi_write(phy->spi, REG_CONFIG,
+		ad9361_spi_write(phy, REG_WORD_ADDRESS, i);
+		ad9361_spi_write(phy, REG_GAIN_DIFF_WORDERROR_WRITE, mixer_error[i]);
+		ad9361_spi_write(phy, REG_CONFIG,
 				 CALIB_TABLE_SELECT(0x3) | WRITE_MIXER_ERROR_TABLE | START_CALIB_TABLE_CLOCK);
 	}
-	ad9361_spi_write(phy->spi, REG_CONFIG, 0x00);
+	ad9361_spi_write(phy, REG_CONFIG, 0x00);
 
 	ad9361_ensm_restore_prev_state(phy);
 
@@ -43,6 +43,7 @@
 /******************************************************************************/
 #include <stdint.h>
 #include "no_os_gpio.h"
+#include "no_os_regmap.h"
 #include "common.h"
 
 /******************************************************************************/
@@ -3340,6 +3341,7 @@ enum dev_id {
 struct ad9361_rf_phy {
 	enum dev_id		dev_sel;
 	struct no_os_spi_desc 	*spi;
+	struct no_os_regmap	*regmap;
 	struct no_os_gpio_desc 	*gpio_desc_resetb;
 	struct no_os_gpio_desc 	*gpio_desc_sync;
 	struct no_os_gpio_desc 	*gpio_desc_cal_sw1;
@@ -3440,16 +3442,18 @@ enum debugfs_cmd {
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
-int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
+int32_t ad9361_spi_readm(struct ad9361_rf_phy *phy, uint32_t reg,
 			 uint8_t *rbuf, uint32_t num);
-int32_t ad9361_spi_read(struct no_os_spi_desc *spi, uint32_t reg);
+int32_t ad9361_spi_read(struct ad9361_rf_phy *phy, uint32_t reg);
 int32_t ad9361_reg_read(struct ad9361_rf_phy *phy,
 			uint32_t reg, uint32_t *val);
-int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
+int32_t ad9361_spi_write(struct ad9361_rf_phy *phy,
 			 uint32_t reg, uint32_t val);
 int32_t ad9361_reg_write(struct ad9361_rf_phy *phy,
 			 uint32_t reg, uint32_t val);
 int32_t ad9361_reset(struct ad9361_rf_phy *phy);
+int32_t ad9361_regmap_init(struct ad9361_rf_phy *phy);
+int32_t ad9361_regmap_remove(struct ad9361_rf_phy *phy);
 int32_t ad9361_register_clocks(struct ad9361_rf_phy *phy);
 int32_t ad9361_unregister_clocks(struct ad9361_rf_phy *phy);
 uint32_t ad9361_gt(struct ad9361_rf_phy *phy);
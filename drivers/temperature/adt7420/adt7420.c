@@ -452,6 +452,18 @@ int adt7420_i2c_reg_read(struct adt7420_dev *dev, uint16_t register_address,
 			 uint16_t *data)
 {
 	uint8_t data_buffer[3] = { 0, 0 };
+	uint8_t reg = register_address;
+	struct no_os_i2c_msg msgs[] = {
+		{
+			.buff = &reg,
+			.bytes_number = 1,
+		},
+		{
+			/* read after a repeated start */
+			.buff = data_buffer,
+			.flags = NO_OS_I2C_M_RD,
+		},
+	};
 	uint8_t num_bytes;
 
 	if (no_os_field_get(ADT7320_L16, register_address))
@@ -459,10 +471,8 @@ int adt7420_i2c_reg_read(struct adt7420_dev *dev, uint16_t register_address,
 	else
 		num_bytes = 1;
 
-	if (no_os_i2c_write(dev->i2c_desc, &register_address, 1,
-			    0)) //add a repeat start
-		return -1;
-	if (no_os_i2c_read(dev->i2c_desc, data_buffer, num_bytes, 1))
+	msgs[1].bytes_number = num_bytes;
+	if (no_os_i2c_transfer(dev->i2c_desc, msgs, NO_OS_ARRAY_SIZE(msgs)))
 		return -1;
 
 	if (num_bytes == 1)
@@ -57,6 +57,7 @@
 #include "no_os_circular_buffer.h"
 #include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifdef NO_OS_NETWORKING
@@ -78,7 +79,17 @@
 #define MAX_SOCKET_TO_HANDLE	10
 #define REG_ACCESS_ATTRIBUTE	"direct_reg_access"
 #define IIOD_CONN_BUFFER_SIZE	0x1000
+/* Maximum time iio_step waits for socket events when event driven */
+#define IIO_EVENT_TIMEOUT_MS	10
+
+/* iio_desc.ready_conns has one bit per connection */
+#if IIOD_MAX_CONNECTIONS > 32
+#error "IIOD_MAX_CONNECTIONS must be at most 32"
+#endif
+
 #define NO_TRIGGER				(uint32_t)-1
+#define DEV_ID_PREFIX		"iio:device"
+#define TRIG_ID_PREFIX		"trigger"
 
 #define NO_OS_STRINGIFY(x) #x
 #define NO_OS_TOSTRING(x) NO_OS_STRINGIFY(x)
@@ -151,6 +162,30 @@ struct attr_fun_params {
 	struct iio_ch_info	*ch_info;
 };
 
+/* Attributes of an attribute array sorted by name */
+struct iio_attr_index {
+	/* Sorted references to the attributes */
+	struct iio_attribute	**attrs;
+	/* Number of attributes */
+	uint32_t		nb_attrs;
+};
+
+/* Channel lookup entry. Entries are sorted by direction and id */
+struct iio_ch_index {
+	/* Channel id as it appears in the xml. E.g. voltage0 */
+	char			*id;
+	/* Reference to the channel */
+	struct iio_channel	*ch;
+	/* Channel attributes */
+	struct iio_attr_index	attrs;
+};
+
+/* Key used to search a channel in iio_ch_index entries */
+struct iio_ch_key {
+	const char	*id;
+	bool		ch_out;
+};
+
 struct iio_buffer_priv {
 	/* Field visible by user */
 	struct iio_buffer	public;
@@ -164,6 +199,21 @@ struct iio_buffer_priv {
 	bool			initalized;
 	/* Set when no_os_calloc was used to initalize cb.buf */
 	bool			allocated;
+	/* Number of blocks requested with SET BUFFERS_COUNT */
+	uint32_t		buffers_count;
+	/* Blocks handed out with iio_buffer_get_block and not yet done */
+	uint32_t		nb_pending;
+	/*
+	 * Bytes sent by reference and not yet acknowledged. They are just
+	 * behind the read index and can't be overwritten.
+	 */
+	uint32_t		sending;
+	/* Set when the producer gets its blocks with iio_buffer_get_block */
+	bool			by_blocks;
+	/* Submitted again because the buffer ran empty during a READBUF */
+	bool			starved;
+	/* IIO instance, woken up when a block is done */
+	struct iio_desc		*iio;
 };
 
 /**
@@ -188,6 +238,18 @@ struct iio_dev_priv {
 	struct iio_buffer_priv buffer;
 	/* Set to -1 when no trigger is set*/
 	uint32_t		trig_idx;
+	/** Channels sorted by direction and id */
+	struct iio_ch_index	*ch_index;
+	/** Device attributes index */
+	struct iio_attr_index	attrs;
+	/** Debug attributes index */
+	struct iio_attr_index	debug_attrs;
+	/** Buffer attributes index */
+	struct iio_attr_index	buffer_attrs;
+	/** Memory used by the indexes */
+	struct iio_attribute	**attrs_storage;
+	/** Memory used to store channel ids */
+	char			*ch_ids_storage;
 };
 
 /**
@@ -206,6 +268,8 @@ struct iio_trig_priv {
 	struct iio_trigger *descriptor;
 	/** Set to true when the triggering condition is met */
 	bool	triggered;
+	/** Trigger attributes index */
+	struct iio_attr_index	attrs;
 };
 
 struct iio_desc {
@@ -229,6 +293,18 @@ struct iio_desc {
 	struct tcp_socket_desc	*current_sock;
 	/* Instance of server socket */
 	struct tcp_socket_desc	*server;
+	/* Set if the network interface can wait for socket events */
+	bool			event_driven;
+	/* Sockets of the connections. Used when event driven */
+	struct tcp_socket_desc	*conn_socks[IIOD_MAX_CONNECTIONS];
+	/* Mask of connections which need to be stepped */
+	uint32_t		ready_conns;
+	/* Mask of connections waiting for a device, stepped on wake up */
+	uint32_t		dev_wait_conns;
+	/* The last socket call of the stepped connection would block */
+	bool			sock_blocked;
+	/* The stepped connection waits for a device */
+	bool			dev_wait;
 #endif
 };
 
@@ -262,18 +338,49 @@ static inline int32_t _nb_active_conns(struct iio_desc *desc)
 }
 
 
+/* Record if the connection can only progress once its socket is ready */
+static inline int iio_sock_result(struct iio_desc *desc, int ret)
+{
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	desc->sock_blocked = (ret == -EAGAIN || ret == 0);
+#endif
+
+	return ret;
+}
+
+/* Record that the connection can only progress once its device is ready */
+static inline int iio_dev_wait(struct iiod_ctx *ctx)
+{
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	struct iio_desc *desc = ctx->instance;
+
+	desc->dev_wait = true;
+#endif
+
+	return -EAGAIN;
+}
+
+/* Make a waiting iio_step return, new data may be available */
+static inline void iio_wakeup(struct iio_desc *desc)
+{
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	if (desc && desc->event_driven)
+		socket_wakeup(desc->server);
+#endif
+}
+
 static int iio_recv(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
 {
 	struct iio_desc *desc = ctx->instance;
 
-	return desc->recv(ctx->conn, buf, len);
+	return iio_sock_result(desc, desc->recv(ctx->conn, buf, len));
 }
 
 static int iio_send(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
 {
 	struct iio_desc *desc = ctx->instance;
 
-	return desc->send(ctx->conn, buf, len);
+	return iio_sock_result(desc, desc->send(ctx->conn, buf, len));
 }
 
 static inline void _print_ch_id(char *buff, struct iio_channel *ch)
@@ -296,28 +403,101 @@ static inline void _print_ch_id(char *buff, struct iio_channel *ch)
 	}
 }
 
+static int iio_ch_index_cmp(const void *key, const void *elem)
+{
+	const struct iio_ch_key *k = key;
+	const struct iio_ch_index *e = elem;
+
+	if (k->ch_out != e->ch->ch_out)
+		return k->ch_out ? 1 : -1;
+
+	return strcmp(k->id, e->id);
+}
+
+static int iio_ch_index_sort_cmp(const void *a, const void *b)
+{
+	const struct iio_ch_index *e = a;
+	struct iio_ch_key k = {
+		.id = e->id,
+		.ch_out = e->ch->ch_out
+	};
+
+	return iio_ch_index_cmp(&k, b);
+}
+
+static int iio_attr_index_cmp(const void *key, const void *elem)
+{
+	const struct iio_attribute * const *attr = elem;
+
+	return strcmp(key, (*attr)->name);
+}
+
+static int iio_attr_index_sort_cmp(const void *a, const void *b)
+{
+	const struct iio_attribute * const *attr = a;
+
+	return iio_attr_index_cmp((*attr)->name, b);
+}
+
 /**
- * @brief Get channel ID from a list of channels.
+ * @brief Get channel from the sorted channel index of a device.
  * @param channel - Channel name.
- * @param desc - Device descriptor
+ * @param dev - Device
  * @param ch_out - If "true" is output channel, if "false" is input channel.
- * @return Channel ID, or negative value if attribute is not found.
+ * @return Channel index entry, or NULL if channel is not found.
  */
-static inline struct iio_channel *iio_get_channel(const char *channel,
-		struct iio_device *desc, bool ch_out)
+static inline struct iio_ch_index *iio_get_channel(const char *channel,
+		struct iio_dev_priv *dev, bool ch_out)
 {
-	int16_t i = 0;
-	char	ch_id[MAX_CHN_ID];
+	struct iio_ch_key key = {
+		.id = channel,
+		.ch_out = ch_out
+	};
 
-	while (i < desc->num_ch) {
-		_print_ch_id(ch_id, &desc->channels[i]);
-		if (!strcmp(channel, ch_id) &&
-		    (desc->channels[i].ch_out == ch_out))
-			return &desc->channels[i];
-		i++;
-	}
+	if (!dev->ch_index)
+		return NULL;
 
-	return NULL;
+	return bsearch(&key, dev->ch_index, dev->dev_descriptor->num_ch,
+		       sizeof(*dev->ch_index), iio_ch_index_cmp);
+}
+
+/**
+ * @brief Get attribute from a sorted attribute index.
+ * @param index - Attribute index.
+ * @param name - Attribute name.
+ * @return Attribute, or NULL if attribute is not found.
+ */
+static struct iio_attribute *iio_get_attr(struct iio_attr_index *index,
+		const char *name)
+{
+	struct iio_attribute **attr;
+
+	if (!index || !index->nb_attrs)
+		return NULL;
+
+	attr = bsearch(name, index->attrs, index->nb_attrs,
+		       sizeof(*index->attrs), iio_attr_index_cmp);
+
+	return attr ? *attr : NULL;
+}
+
+/*
+ * Get the index of an id generated as <prefix><index> (e.g. iio:device1).
+ * Returns -1 if id doesn't have this format.
+ */
+static int32_t iio_parse_id(const char *id, const char *prefix, uint32_t len)
+{
+	char *end;
+	uint32_t idx;
+
+	if (strncmp(id, prefix, len) || id[len] < '0' || id[len] > '9')
+		return -1;
+
+	idx = strtoul(id + len, &end, 10);
+	if (*end != '\0')
+		return -1;
+
+	return idx;
 }
 
 /**
@@ -329,12 +509,16 @@ static inline struct iio_channel *iio_get_channel(const char *channel,
 static struct iio_dev_priv *get_iio_device(struct iio_desc *desc,
 		const char *device_name)
 {
-	uint32_t i;
+	int32_t i;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		if (strcmp(desc->devs[i].dev_id, device_name) == 0)
-			return &desc->devs[i];
-	}
+	/* Device ids are generated as iio:device<index in devs> */
+	i = iio_parse_id(device_name, DEV_ID_PREFIX,
+			 sizeof(DEV_ID_PREFIX) - 1);
+	if (i < 0 || i >= (int32_t)desc->nb_devs)
+		return NULL;
+
+	if (strcmp(desc->devs[i].dev_id, device_name) == 0)
+		return &desc->devs[i];
 
 	return NULL;
 }
@@ -348,12 +532,16 @@ static struct iio_dev_priv *get_iio_device(struct iio_desc *desc,
 static struct iio_trig_priv *get_iio_trig_device(struct iio_desc *desc,
 		const char *trigger_id)
 {
-	uint32_t i;
+	int32_t i;
 
-	for (i = 0; i < desc->nb_trigs; i++) {
-		if (strcmp(desc->trigs[i].id, trigger_id) == 0)
-			return &desc->trigs[i];
-	}
+	/* Trigger ids are generated as trigger<index in trigs> */
+	i = iio_parse_id(trigger_id, TRIG_ID_PREFIX,
+			 sizeof(TRIG_ID_PREFIX) - 1);
+	if (i < 0 || i >= (int32_t)desc->nb_trigs)
+		return NULL;
+
+	if (strcmp(desc->trigs[i].id, trigger_id) == 0)
+		return &desc->trigs[i];
 
 	return NULL;
 }
@@ -369,16 +557,18 @@ static int iio_set_buffers_count(struct iiod_ctx *ctx, const char *device,
 				 uint32_t buffers_count)
 {
 	struct iio_desc *desc = ctx->instance;
+	struct iio_dev_priv *dev;
 
-	if(!get_iio_device(desc, device))
+	dev = get_iio_device(desc, device);
+	if (!dev)
 		return -ENODEV;
 
-	/* Our implementation uses a circular buffer to send/receive data so
-	 * only 1 is a valid value.
-	 */
-	if (buffers_count != 1)
+	if (!buffers_count || buffers_count > IIO_MAX_BUFFERS_COUNT)
 		return -EINVAL;
 
+	/* Will be used the next time the buffer is opened */
+	dev->buffer.buffers_count = buffers_count;
+
 	return 0;
 }
 
@@ -473,46 +663,54 @@ static int iio_write_all_attr(struct attr_fun_params *params,
 #endif
 }
 
+/**
+ * @brief Call store or show function of an attribute.
+ * @param params - Structure describing parameters for store and show functions
+ * @param attribute - Attribute to be modified
+ * @param is_write -If it has value "1", writes attribute, otherwise reads
+ * 		attribute.
+ * @return Length of chars written/read or negative value in case of error.
+ */
+static int iio_call_attr(struct attr_fun_params *params,
+			 struct iio_attribute *attribute, bool is_write)
+{
+	if (is_write) {
+		if (!attribute->store)
+			return -ENOENT;
+
+		return attribute->store(params->dev_instance, params->buf,
+					params->len, params->ch_info,
+					attribute->priv);
+	} else {
+		if (!attribute->show)
+			return -ENOENT;
+		return attribute->show(params->dev_instance, params->buf,
+				       params->len, params->ch_info,
+				       attribute->priv);
+	}
+}
+
 /**
  * @brief Read/write attribute.
  * @param params - Structure describing parameters for store and show functions
- * @param attributes - Array of attributes.
+ * @param index - Index of the attributes.
  * @param attr_name - Attribute name to be modified
  * @param is_write -If it has value "1", writes attribute, otherwise reads
  * 		attribute.
  * @return Length of chars written/read or negative value in case of error.
  */
 static int iio_rd_wr_attribute(struct attr_fun_params *params,
-			       struct iio_attribute *attributes,
+			       struct iio_attr_index *index,
 			       const char *attr_name,
 			       bool is_write)
 {
-	int16_t i = 0;
-
-	/* Search attribute */
-	while (attributes[i].name) {
-		if (!strcmp(attr_name, attributes[i].name))
-			break;
-		i++;
-	}
+	struct iio_attribute *attribute;
 
-	if (!attributes[i].name)
+	attribute = iio_get_attr(index, attr_name);
+	if (!attribute)
 		return -ENOENT;
 
-	if (is_write) {
-		if (!attributes[i].store)
-			return -ENOENT;
-
-		return attributes[i].store(params->dev_instance, params->buf,
-					   params->len, params->ch_info,
-					   attributes[i].priv);
-	} else {
-		if (!attributes[i].show)
-			return -ENOENT;
-		return attributes[i].show(params->dev_instance, params->buf,
-					  params->len, params->ch_info,
-					  attributes[i].priv);
-	}
+	return iio_call_attr(params, attribute, is_write);
 }
 
 /* Read a device register. The register address to read is set on
@@ -721,6 +919,25 @@ int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
 	}
 }
 
+static struct iio_attr_index *get_attr_index(enum iio_attr_type type,
+		struct iio_dev_priv *dev,
+		struct iio_ch_index *ch)
+{
+	switch (type) {
+	case IIO_ATTR_TYPE_DEBUG:
+		return &dev->debug_attrs;
+	case IIO_ATTR_TYPE_DEVICE:
+		return &dev->attrs;
+	case IIO_ATTR_TYPE_BUFFER:
+		return &dev->buffer_attrs;
+	case IIO_ATTR_TYPE_CH_IN:
+	case IIO_ATTR_TYPE_CH_OUT:
+		return ch ? &ch->attrs : NULL;
+	}
+
+	return NULL;
+}
+
 static struct iio_attribute *get_attributes(enum iio_attr_type type,
 		struct iio_dev_priv *dev,
 		struct iio_channel *ch)
@@ -780,6 +997,7 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 	struct iio_trig_priv *trig_dev;
 	struct iio_ch_info ch_info;
 	struct iio_channel *ch = NULL;
+	struct iio_ch_index *ch_idx = NULL;
 	struct attr_fun_params params;
 	struct iio_attribute *attributes;
 	int8_t ch_out;
@@ -797,10 +1015,10 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
-					     ch_out);
-			if (!ch)
+			ch_idx = iio_get_channel(attr->channel, dev, ch_out);
+			if (!ch_idx)
 				return -ENOENT;
+			ch = ch_idx->ch;
 			ch_info.ch_out = ch_out;
 			ch_info.ch_num = ch->channel;
 			ch_info.type = ch->ch_type;
@@ -814,10 +1032,13 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = buf;
 		params.len = len;
 		params.dev_instance = dev->dev_instance;
-		attributes = get_attributes(attr->type, dev, ch);
-		if (!strcmp(attr->name, ""))
+		if (attr->name[0] == '\0') {
+			attributes = get_attributes(attr->type, dev, ch);
 			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
+		}
+		return iio_rd_wr_attribute(&params,
+					   get_attr_index(attr->type, dev, ch_idx),
+					   attr->name, 0);
 	}
 
 	/* IIO device with given name is not found, verify if it corresponds to a trigger */
@@ -829,10 +1050,14 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = buf;
 		params.len = len;
 		params.dev_instance = trig_dev->instance;
-		attributes = get_trig_attributes(attr->type, trig_dev);
-		if (!strcmp(attr->name, ""))
+		if (attr->name[0] == '\0') {
+			attributes = get_trig_attributes(attr->type, trig_dev);
 			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
+		}
+		if (attr->type != IIO_ATTR_TYPE_DEVICE)
+			return -ENOENT;
+		return iio_rd_wr_attribute(&params, &trig_dev->attrs, attr->name,
+					   0);
 	}
 
 	/* No device and no trigger with given name were found */
@@ -857,6 +1082,7 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 	struct iio_attribute	*attributes;
 	struct iio_ch_info ch_info;
 	struct iio_channel *ch = NULL;
+	struct iio_ch_index *ch_idx = NULL;
 	int8_t ch_out;
 
 	dev = get_iio_device(ctx->instance, device);
@@ -873,10 +1099,10 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
-					     ch_out);
-			if (!ch)
+			ch_idx = iio_get_channel(attr->channel, dev, ch_out);
+			if (!ch_idx)
 				return -ENOENT;
+			ch = ch_idx->ch;
 
 			ch_info.ch_out = ch_out;
 			ch_info.ch_num = ch->channel;
@@ -891,10 +1117,13 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = (char *)buf;
 		params.len = len;
 		params.dev_instance = dev->dev_instance;
-		attributes = get_attributes(attr->type, dev, ch);
-		if (!strcmp(attr->name, ""))
+		if (attr->name[0] == '\0') {
+			attributes = get_attributes(attr->type, dev, ch);
 			return iio_write_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
+		}
+		return iio_rd_wr_attribute(&params,
+					   get_attr_index(attr->type, dev, ch_idx),
+					   attr->name, 1);
 	}
 
 	/* IIO device with given name is not found, verify if it corresponds to a trigger */
@@ -906,16 +1135,180 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = (char *)buf;
 		params.len = len;
 		params.dev_instance = trig_dev->instance;
-		attributes = get_trig_attributes(attr->type, trig_dev);
-		if (!strcmp(attr->name, ""))
+		if (attr->name[0] == '\0') {
+			attributes = get_trig_attributes(attr->type, trig_dev);
 			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
+		}
+		if (attr->type != IIO_ATTR_TYPE_DEVICE)
+			return -ENOENT;
+		return iio_rd_wr_attribute(&params, &trig_dev->attrs, attr->name,
+					   1);
 	}
 
 	/* No device and no trigger with given name were found */
 	return -ENODEV;
 }
 
+/**
+ * @brief Get the id of a device or trigger by its index in the xml.
+ * @param ctx - IIO instance and conn instance
+ * @param dev - Device index. Triggers follow the devices.
+ * @return Device id or NULL if not found.
+ */
+static const char *iio_get_dev_id(struct iiod_ctx *ctx, uint32_t dev)
+{
+	struct iio_desc *desc = ctx->instance;
+
+	if (dev < desc->nb_devs)
+		return desc->devs[dev].dev_id;
+
+	dev -= desc->nb_devs;
+	if (dev < desc->nb_trigs)
+		return desc->trigs[dev].id;
+
+	return NULL;
+}
+
+/**
+ * @brief Get attribute at a given position in the list.
+ * @param attributes - List of attributes, terminated by an empty name.
+ * @param idx - Position of the attribute.
+ * @return Attribute or NULL if the list is shorter.
+ */
+static struct iio_attribute *iio_get_attr_at(struct iio_attribute *attributes,
+		uint32_t idx)
+{
+	uint32_t i;
+
+	if (!attributes)
+		return NULL;
+
+	for (i = 0; i < idx; i++)
+		if (!attributes[i].name)
+			return NULL;
+
+	return attributes[idx].name ? &attributes[idx] : NULL;
+}
+
+/**
+ * @brief Read/write an attribute referenced by its indexes in the xml.
+ * @param ctx - IIO instance and conn instance
+ * @param dev_idx - Device index. Triggers follow the devices.
+ * @param attr - Attribute type, channel index and attribute index.
+ * @param buf - Buffer for the value.
+ * @param len - Length of buf or of the value to be written.
+ * @param is_write - If it has value "1", writes attribute, otherwise reads
+ * 		attribute.
+ * @return Length of chars written/read or negative value in case of error.
+ */
+static int iio_rd_wr_attr_by_idx(struct iiod_ctx *ctx, uint32_t dev_idx,
+				 struct iiod_attr_idx *attr, char *buf,
+				 uint32_t len, bool is_write)
+{
+	struct iio_desc *desc = ctx->instance;
+	struct iio_device *device;
+	struct iio_dev_priv *dev;
+	struct iio_trig_priv *trig;
+	struct iio_attribute *attribute;
+	struct iio_channel *ch;
+	struct iio_ch_info ch_info;
+	struct attr_fun_params params;
+	int8_t ch_out;
+
+	params.buf = buf;
+	params.len = len;
+	params.ch_info = NULL;
+
+	if (dev_idx >= desc->nb_devs) {
+		dev_idx -= desc->nb_devs;
+		if (dev_idx >= desc->nb_trigs)
+			return -ENODEV;
+
+		trig = &desc->trigs[dev_idx];
+		attribute = iio_get_attr_at(get_trig_attributes(attr->type, trig),
+					    attr->attr);
+		if (!attribute)
+			return -ENOENT;
+		params.dev_instance = trig->instance;
+
+		return iio_call_attr(&params, attribute, is_write);
+	}
+
+	dev = &desc->devs[dev_idx];
+	device = dev->dev_descriptor;
+	params.dev_instance = dev->dev_instance;
+	switch (attr->type) {
+	case IIO_ATTR_TYPE_DEBUG:
+		if (attr->attr == dev->debug_attrs.nb_attrs) {
+			/* direct_reg_access is the last debug attribute */
+			if (is_write && device->debug_reg_write)
+				return debug_reg_write(dev, buf, len);
+			if (!is_write && device->debug_reg_read)
+				return debug_reg_read(dev, buf, len);
+			return -ENOENT;
+		}
+		attribute = iio_get_attr_at(device->debug_attributes,
+					    attr->attr);
+		break;
+	case IIO_ATTR_TYPE_CH_IN:
+	case IIO_ATTR_TYPE_CH_OUT:
+		ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
+		if (!device->channels || attr->ch >= device->num_ch)
+			return -ENOENT;
+		ch = &device->channels[attr->ch];
+		if (ch->ch_out != ch_out)
+			return -ENOENT;
+		ch_info.ch_out = ch_out;
+		ch_info.ch_num = ch->channel;
+		ch_info.type = ch->ch_type;
+		ch_info.differential = ch->diferential;
+		ch_info.address = ch->address;
+		params.ch_info = &ch_info;
+		attribute = iio_get_attr_at(ch->attributes, attr->attr);
+		break;
+	default:
+		attribute = iio_get_attr_at(get_attributes(attr->type, dev, NULL),
+					    attr->attr);
+		break;
+	}
+	if (!attribute)
+		return -ENOENT;
+
+	return iio_call_attr(&params, attribute, is_write);
+}
+
+/**
+ * @brief Read an attribute referenced by its indexes in the xml.
+ * @param ctx - IIO instance and conn instance
+ * @param dev - Device index. Triggers follow the devices.
+ * @param attr - Attribute type, channel index and attribute index.
+ * @param buf - Buffer where value is read.
+ * @param len - Maximum length of value to be stored in buf.
+ * @return Number of bytes read.
+ */
+static int iio_read_attr_by_idx(struct iiod_ctx *ctx, uint32_t dev,
+				struct iiod_attr_idx *attr, char *buf,
+				uint32_t len)
+{
+	return iio_rd_wr_attr_by_idx(ctx, dev, attr, buf, len, 0);
+}
+
+/**
+ * @brief Write an attribute referenced by its indexes in the xml.
+ * @param ctx - IIO instance and conn instance
+ * @param dev - Device index. Triggers follow the devices.
+ * @param attr - Attribute type, channel index and attribute index.
+ * @param buf - Value to be written.
+ * @param len - Length of data.
+ * @return Number of written bytes.
+ */
+static int iio_write_attr_by_idx(struct iiod_ctx *ctx, uint32_t dev,
+				 struct iiod_attr_idx *attr, char *buf,
+				 uint32_t len)
+{
+	return iio_rd_wr_attr_by_idx(ctx, dev, attr, buf, len, 1);
+}
+
 /**
  * @brief Searches for trigger id and returns trigger index.
  * @param desc - IIO descriptor.
@@ -1094,6 +1487,9 @@ int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
 		}
 	}
 
+	/* New data or a trigger to process. Don't wait for socket events */
+	iio_wakeup(desc);
+
 	return 0;
 }
 
@@ -1128,6 +1524,7 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	struct iio_dev_priv *dev;
 	struct iio_trig_priv *trig;
 	uint32_t ch_mask;
+	uint32_t nb_blocks;
 	int32_t ret;
 	int8_t *buf;
 	uint32_t buf_size;
@@ -1150,6 +1547,12 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	dev->buffer.public.active_mask = mask;
 	dev->buffer.public.bytes_per_scan =
 		bytes_per_scan(dev->dev_descriptor->channels, mask);
+	/* The size of all the allocated blocks must fit in 32 bits */
+	nb_blocks = dev->buffer.raw_buf && dev->buffer.raw_buf_len ? 1 :
+		    dev->buffer.buffers_count;
+	if (dev->buffer.public.bytes_per_scan &&
+	    samples > UINT32_MAX / dev->buffer.public.bytes_per_scan / nb_blocks)
+		return -EINVAL;
 	dev->buffer.public.size = dev->buffer.public.bytes_per_scan * samples;
 	dev->buffer.public.samples = samples;
 	if (dev->buffer.raw_buf && dev->buffer.raw_buf_len) {
@@ -1165,8 +1568,8 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 			no_os_free(dev->buffer.cb.buff);
 			dev->buffer.allocated = 0;
 		}
-		buf_size = dev->buffer.public.size;
-		buf = (int8_t *)no_os_calloc(dev->buffer.public.size, sizeof(*buf));
+		buf_size = dev->buffer.public.size * dev->buffer.buffers_count;
+		buf = (int8_t *)no_os_calloc(buf_size, sizeof(*buf));
 		if (!buf)
 			return -ENOMEM;
 		dev->buffer.allocated = 1;
@@ -1181,6 +1584,10 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 
 		return ret;
 	}
+	dev->buffer.public.nb_blocks = buf_size / dev->buffer.public.size;
+	dev->buffer.nb_pending = 0;
+	dev->buffer.by_blocks = false;
+	dev->buffer.starved = false;
 
 	if (dev->dev_descriptor->pre_enable) {
 		ret = dev->dev_descriptor->pre_enable(dev->dev_instance, mask);
@@ -1221,11 +1628,9 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 	if (!dev->buffer.initalized)
 		return -EINVAL;
 
-	if (dev->buffer.allocated) {
-		/* Should something else be used to free internal strucutre */
-		no_os_free(dev->buffer.cb.buff);
-		dev->buffer.allocated = 0;
-	}
+	/* The connection still sends data from the buffer */
+	if (dev->buffer.sending)
+		return iio_dev_wait(ctx);
 
 	desc = ctx->instance;
 	if(dev->trig_idx != NO_TRIGGER) {
@@ -1238,22 +1643,38 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 	}
 
 	dev->buffer.public.active_mask = 0;
+	dev->buffer.nb_pending = 0;
 	if (dev->dev_descriptor->post_disable)
 		ret = dev->dev_descriptor->post_disable(dev->dev_instance);
 
+	/* Freed after post_disable, which stops the transfers to the blocks */
+	if (dev->buffer.allocated) {
+		/* Should something else be used to free internal strucutre */
+		no_os_free(dev->buffer.cb.buff);
+		dev->buffer.allocated = 0;
+	}
+
 	return ret;
 }
 
-static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
-			   enum iio_buffer_direction dir)
+/* Number of bytes that can still be written by the producer of the buffer */
+static uint32_t iio_buffer_free_space(struct iio_buffer_priv *buffer)
 {
-	struct iio_dev_priv *dev;
+	uint32_t used;
+	uint32_t reserved;
 
-	dev = get_iio_device(ctx->instance, device);
-	if (!dev || !dev->buffer.initalized)
-		return -EINVAL;
+	no_os_cb_size(&buffer->cb, &used);
+	reserved = used + buffer->sending +
+		   buffer->nb_pending * buffer->public.size;
+	if (reserved >= buffer->cb.size)
+		return 0;
 
-	dev->buffer.public.dir = dir;
+	return buffer->cb.size - reserved;
+}
+
+/* Ask the device to produce (INPUT) or consume (OUTPUT) a block */
+static int iio_submit(struct iio_dev_priv *dev, enum iio_buffer_direction dir)
+{
 	if (dev->dev_descriptor->submit && dev->trig_idx==NO_TRIGGER)
 		return dev->dev_descriptor->submit(&dev->dev_data);
 	else if ((dir == IIO_DIRECTION_INPUT && dev->dev_descriptor->read_dev
@@ -1266,6 +1687,9 @@ static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
 		struct iio_buffer *buffer = &dev->buffer.public;
 
 		ret = iio_buffer_get_block(buffer, &buff);
+		/* Cyclic buffers are pushed again, with nothing new to send */
+		if (ret == -EAGAIN && dir == IIO_DIRECTION_OUTPUT)
+			return 0;
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
@@ -1284,6 +1708,50 @@ static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
 	return 0;
 }
 
+static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
+			   enum iio_buffer_direction dir)
+{
+	struct iio_dev_priv *dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	dev->buffer.public.dir = dir;
+	dev->buffer.starved = false;
+	/*
+	 * All blocks are already filled or in progress. Data will be read
+	 * from them.
+	 */
+	if (dir == IIO_DIRECTION_INPUT &&
+	    iio_buffer_free_space(&dev->buffer) < dev->buffer.public.size)
+		return 0;
+
+	return iio_submit(dev, dir);
+}
+
+/*
+ * The buffer ran empty before the end of a READBUF, which is only refilled
+ * once. This happens when the client reads more than the data left from the
+ * previous READBUF. Submit again so that the device completes the blocks in
+ * progress or starts new ones, instead of waiting for data which never comes.
+ * Devices filling the buffer in the background are submitted only once until
+ * the data arrives.
+ */
+static int iio_wait_input(struct iiod_ctx *ctx, struct iio_dev_priv *dev)
+{
+	int ret;
+
+	if (!dev->buffer.starved) {
+		dev->buffer.starved = true;
+		ret = iio_submit(dev, IIO_DIRECTION_INPUT);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	return iio_dev_wait(ctx);
+}
+
 static int iio_push_buffer(struct iiod_ctx *ctx, const char *device)
 {
 	return iio_call_submit(ctx, device, IIO_DIRECTION_OUTPUT);
@@ -1324,9 +1792,13 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
+	if (!size)
+		return iio_wait_input(ctx, dev);
+	dev->buffer.starved = false;
+
 	bytes = no_os_min(size, bytes);
 	if (!bytes)
-		return -EAGAIN;
+		return iio_dev_wait(ctx);
 
 
 	ret = no_os_cb_read(&dev->buffer.cb, buf, bytes);
@@ -1339,6 +1811,156 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 	return bytes;
 }
 
+/*
+ * Zero-copy READBUF: the data is sent from the device buffer. Only built with
+ * IIO_ENABLE_ZERO_COPY, as it is not yet measured on hardware.
+ */
+#ifdef IIO_ENABLE_ZERO_COPY
+/**
+ * @brief Get a contiguous region of data from the device buffer without
+ * copying it. The region is valid until "iio_read_buffer_done()" is called.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param buf - Address where the start of the region is stored.
+ * @param bytes - Maximum number of bytes to get.
+ * @return: Number of bytes available in buf or negative value in case of
+ * error.
+ */
+static int iio_get_read_buffer(struct iiod_ctx *ctx, const char *device,
+			       char **buf, uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+	int32_t			ret;
+	uint32_t		size;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+	if (!size)
+		return iio_wait_input(ctx, dev);
+	dev->buffer.starved = false;
+
+	if (!bytes)
+		return iio_dev_wait(ctx);
+
+	size = 0;
+	ret = no_os_cb_prepare_async_read(&dev->buffer.cb, bytes, (void **)buf,
+					  &size);
+	if (ret != -NO_OS_EOVERRUN && NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (!size)
+		return iio_dev_wait(ctx);
+
+	return size;
+}
+
+/**
+ * @brief Mark the region returned by "iio_get_read_buffer()" as read.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @return: 0 or negative value in case of error.
+ */
+static int iio_read_buffer_done(struct iiod_ctx *ctx, const char *device)
+{
+	struct iio_dev_priv	*dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	return no_os_cb_end_async_read(&dev->buffer.cb);
+}
+
+#ifdef NO_OS_LWIP_NETWORKING
+/**
+ * @brief Called by lwip once a part of the read region was acknowledged by
+ * the client or the connection was closed.
+ * @param ctx - IIO device
+ * @param data - Not used.
+ * @param len - Number of bytes released.
+ * @param err - Not used. On errors, iiod gets the error from the connection.
+ */
+static void iio_read_buffer_sent_cb(void *ctx, const void *data, uint32_t len,
+				    int32_t err)
+{
+	struct iio_dev_priv *dev = ctx;
+
+	dev->buffer.sending -= len;
+	/* The space may be enough for the blocks which couldn't be started */
+	dev->buffer.starved = false;
+	iio_wakeup(dev->buffer.iio);
+}
+
+/**
+ * @brief Send data from the region returned by "iio_get_read_buffer()"
+ * without copying it into lwip. The data is kept until the client
+ * acknowledges it.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param buf - Data to send.
+ * @param len - Number of bytes to send.
+ * @return: Number of bytes queued or negative value in case of error.
+ */
+static int iio_send_read_buffer(struct iiod_ctx *ctx, const char *device,
+				uint8_t *buf, uint32_t len)
+{
+	struct tcp_socket_desc	*sock = ctx->conn;
+	struct iio_dev_priv	*dev;
+	int32_t			ret;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+#ifndef DISABLE_SECURE_SOCKET
+	/* The data is encrypted in a different buffer */
+	if (sock->secure)
+		return iio_send(ctx, buf, len);
+#endif
+
+	ret = no_os_lwip_send_zc(sock->net->net, sock->id, buf, len,
+				 iio_read_buffer_sent_cb, dev);
+	if (ret > 0)
+		dev->buffer.sending += ret;
+
+	return iio_sock_result(ctx->instance, ret);
+}
+
+/**
+ * @brief Check if the region given to "iio_send_read_buffer()" can be
+ * released while its data is not acknowledged yet.
+ * Producers using blocks don't overwrite the data sent by reference, so
+ * several regions can be in flight. Others could overwrite it, so their
+ * data must be acknowledged first.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @return: 0 if it can be released, -EAGAIN if not or negative value in case
+ * of error.
+ */
+static int iio_read_buffer_sent(struct iiod_ctx *ctx, const char *device)
+{
+	struct iio_dev_priv	*dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	if (dev->buffer.by_blocks || !dev->buffer.sending)
+		return 0;
+
+	return iio_dev_wait(ctx);
+}
+#endif
+#endif
 
 /**
  * @brief Write chunk of data into RAM.
@@ -1367,7 +1989,7 @@ static int iio_write_buffer(struct iiod_ctx *ctx, const char *device,
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
-	available = dev->buffer.public.size - size;
+	available = dev->buffer.cb.size - size;
 	bytes = no_os_min(available, bytes);
 	ret = no_os_cb_write(&dev->buffer.cb, buf, bytes);
 	if (NO_OS_IS_ERR_VALUE(ret))
@@ -1376,28 +1998,89 @@ static int iio_write_buffer(struct iiod_ctx *ctx, const char *device,
 	return bytes;
 }
 
+/* The public buffer is the first member of iio_buffer_priv */
+static inline struct iio_buffer_priv *to_buffer_priv(struct iio_buffer *buffer)
+{
+	return (struct iio_buffer_priv *)buffer;
+}
+
+/*
+ * For input buffers, up to iio_buffer.nb_blocks blocks can be requested
+ * before calling iio_buffer_block_done. Blocks must be marked as done in the
+ * order they were requested. -EAGAIN is returned when all blocks are in use,
+ * or for output buffers when no data was written since the last block.
+ */
 int iio_buffer_get_block(struct iio_buffer *buffer, void **addr)
 {
+	struct iio_buffer_priv *priv;
+	uint32_t offset;
 	uint32_t size;
+	int32_t ret;
 
-	if (!buffer)
+	if (!buffer || !addr)
 		return -EINVAL;
 
-	if (buffer->dir == IIO_DIRECTION_INPUT)
-		return no_os_cb_prepare_async_write(buffer->buf, buffer->size, addr, &size);
+	if (buffer->dir == IIO_DIRECTION_OUTPUT) {
+		/* Neither addr nor size are set when the buffer is empty */
+		size = 0;
+		ret = no_os_cb_prepare_async_read(buffer->buf, buffer->size,
+						  addr, &size);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		return size ? 0 : -EAGAIN;
+	}
+
+	priv = to_buffer_priv(buffer);
+	priv->by_blocks = true;
+	if (iio_buffer_free_space(priv) < buffer->size)
+		return -EAGAIN;
 
-	return no_os_cb_prepare_async_read(buffer->buf, buffer->size, addr, &size);
+	offset = buffer->buf->write.idx + priv->nb_pending * buffer->size;
+	*addr = buffer->buf->buff + (offset % buffer->buf->size);
+	priv->nb_pending++;
+
+	return 0;
 }
 
+/* Mark the oldest block returned by iio_buffer_get_block as done */
 int iio_buffer_block_done(struct iio_buffer *buffer)
 {
+	struct iio_buffer_priv *priv;
+	uint32_t size;
+	void *addr;
+	int32_t ret;
+
 	if (!buffer)
 		return -EINVAL;
 
-	if (buffer->dir == IIO_DIRECTION_INPUT)
-		return no_os_cb_end_async_write(buffer->buf);
+	priv = to_buffer_priv(buffer);
+	if (buffer->dir == IIO_DIRECTION_OUTPUT) {
+		ret = no_os_cb_end_async_read(buffer->buf);
+		if (!NO_OS_IS_ERR_VALUE(ret))
+			iio_wakeup(priv->iio);
 
-	return no_os_cb_end_async_read(buffer->buf);
+		return ret;
+	}
+
+	if (!priv->nb_pending)
+		return -EINVAL;
+
+	/* Blocks are aligned in the buffer so a whole block is available */
+	ret = no_os_cb_prepare_async_write(buffer->buf, buffer->size, &addr,
+					   &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = no_os_cb_end_async_write(buffer->buf);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	priv->nb_pending--;
+	/* Connections waiting for the data don't need a trigger */
+	iio_wakeup(priv->iio);
+
+	return 0;
 }
 
 /* Write to buffer iio_buffer.bytes_per_scan bytes from data */
@@ -1450,6 +2133,13 @@ static int32_t accept_network_clients(struct iio_desc *desc)
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
+		if (desc->event_driven) {
+			desc->conn_socks[id] = sock;
+			/* Data may have been received before the accept */
+			desc->ready_conns |= NO_OS_BIT(id);
+			continue;
+		}
+
 		ret = _push_conn(desc, id);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
@@ -1457,6 +2147,84 @@ static int32_t accept_network_clients(struct iio_desc *desc)
 
 	return 0;
 }
+
+static void iio_remove_network_conn(struct iio_desc *desc, uint32_t conn_id)
+{
+	struct iiod_conn_data data;
+
+	iiod_conn_remove(desc->iiod, conn_id, &data);
+	socket_remove(data.conn);
+	no_os_free(data.buf);
+	if (desc->event_driven) {
+		desc->conn_socks[conn_id] = NULL;
+		desc->ready_conns &= ~NO_OS_BIT(conn_id);
+		desc->dev_wait_conns &= ~NO_OS_BIT(conn_id);
+	}
+}
+
+/*
+ * Wait for socket events and step only the connections that have pending
+ * I/O. A connection is stepped until it waits for its socket, which reports
+ * the next event, or for its device. The connections waiting for a device
+ * are stepped again when the wait is woken up (by a trigger or a block done)
+ * or times out.
+ * While some connections are still ready the sockets are only polled, so
+ * that new clients and events on the other connections are not delayed.
+ */
+static int iio_event_step(struct iio_desc *desc)
+{
+	uint32_t ids[IIOD_MAX_CONNECTIONS + 1];
+	uint32_t timeout_ms;
+	uint32_t nb_ids;
+	uint32_t i, j;
+	int32_t ret;
+
+	timeout_ms = desc->ready_conns ? 0 : IIO_EVENT_TIMEOUT_MS;
+	nb_ids = NO_OS_ARRAY_SIZE(ids);
+	ret = socket_wait(desc->server, timeout_ms, ids, &nb_ids);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	/* Woken up or timed out */
+	if (ret == 1 || (!nb_ids && timeout_ms)) {
+		desc->ready_conns |= desc->dev_wait_conns;
+		desc->dev_wait_conns = 0;
+	}
+
+	for (i = 0; i < nb_ids; i++) {
+		if (ids[i] == desc->server->id) {
+			ret = accept_network_clients(desc);
+			if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN)
+				return ret;
+			continue;
+		}
+		for (j = 0; j < IIOD_MAX_CONNECTIONS; j++)
+			if (desc->conn_socks[j] &&
+			    desc->conn_socks[j]->id == ids[i])
+				desc->ready_conns |= NO_OS_BIT(j);
+	}
+
+	ret = -EAGAIN;
+	for (j = 0; j < IIOD_MAX_CONNECTIONS; j++) {
+		if (!(desc->ready_conns & NO_OS_BIT(j)))
+			continue;
+
+		desc->sock_blocked = false;
+		desc->dev_wait = false;
+		ret = iiod_conn_step(desc->iiod, j);
+		if (ret == -ENOTCONN) {
+			iio_remove_network_conn(desc, j);
+		} else if (ret == -EAGAIN && desc->dev_wait) {
+			desc->ready_conns &= ~NO_OS_BIT(j);
+			desc->dev_wait_conns |= NO_OS_BIT(j);
+		} else if (ret == -EAGAIN && desc->sock_blocked) {
+			/* Wait for the next event on the socket */
+			desc->ready_conns &= ~NO_OS_BIT(j);
+		}
+	}
+
+	return ret;
+}
 #endif
 
 /**
@@ -1466,13 +2234,15 @@ static int32_t accept_network_clients(struct iio_desc *desc)
  */
 int iio_step(struct iio_desc *desc)
 {
-	struct iiod_conn_data data;
 	uint32_t conn_id;
 	int32_t ret;
 
 	iio_process_async_triggers(desc);
 
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	if (desc->event_driven)
+		return iio_event_step(desc);
+
 	if (desc->server) {
 		ret = accept_network_clients(desc);
 		if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN)
@@ -1490,9 +2260,7 @@ int iio_step(struct iio_desc *desc)
 	ret = iiod_conn_step(desc->iiod, conn_id);
 	if (ret == -ENOTCONN) {
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
-		iiod_conn_remove(desc->iiod, conn_id, &data);
-		socket_remove(data.conn);
-		no_os_free(data.buf);
+		iio_remove_network_conn(desc, conn_id);
 #endif
 	} else {
 		_push_conn(desc, conn_id);
@@ -1797,6 +2565,8 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 			ldev->buffer.raw_buf = ndev->raw_buf;
 			ldev->buffer.raw_buf_len = ndev->raw_buf_len;
 			ldev->buffer.public.buf = &ldev->buffer.cb;
+			ldev->buffer.buffers_count = 1;
+			ldev->buffer.iio = desc;
 			ldev->buffer.initalized = 1;
 		} else {
 			ldev->buffer.initalized = 0;
@@ -1838,6 +2608,172 @@ static int32_t iio_init_trigs(struct iio_desc *desc,
 	return 0;
 }
 
+static uint32_t iio_count_attrs(struct iio_attribute *attrs)
+{
+	uint32_t n = 0;
+
+	if (attrs)
+		while (attrs[n].name)
+			n++;
+
+	return n;
+}
+
+/* Fill index with references to attrs, using storage, and sort them by name */
+static void iio_init_attr_index(struct iio_attr_index *index,
+				struct iio_attribute *attrs,
+				struct iio_attribute **storage)
+{
+	uint32_t i;
+
+	index->attrs = storage;
+	index->nb_attrs = iio_count_attrs(attrs);
+	for (i = 0; i < index->nb_attrs; i++)
+		storage[i] = &attrs[i];
+
+	qsort(storage, index->nb_attrs, sizeof(*storage),
+	      iio_attr_index_sort_cmp);
+}
+
+/*
+ * Build the lookup indexes of a device so that channels and attributes are
+ * found with a binary search instead of string formatting and linear scans.
+ */
+static int32_t iio_init_dev_index(struct iio_dev_priv *dev)
+{
+	struct iio_device *device = dev->dev_descriptor;
+	struct iio_attribute **storage;
+	struct iio_channel *ch;
+	char ch_id[MAX_CHN_ID];
+	uint32_t nb_attrs;
+	uint32_t ids_len;
+	uint32_t nb_ch;
+	uint32_t i;
+	char *id;
+
+	nb_ch = device->channels ? device->num_ch : 0;
+	nb_attrs = iio_count_attrs(device->attributes) +
+		   iio_count_attrs(device->debug_attributes) +
+		   iio_count_attrs(device->buffer_attributes);
+	ids_len = 0;
+	for (i = 0; i < nb_ch; i++) {
+		ch = &device->channels[i];
+		nb_attrs += iio_count_attrs(ch->attributes);
+		_print_ch_id(ch_id, ch);
+		ids_len += strlen(ch_id) + 1;
+	}
+
+	if (nb_attrs) {
+		dev->attrs_storage = no_os_calloc(nb_attrs,
+						  sizeof(*dev->attrs_storage));
+		if (!dev->attrs_storage)
+			return -ENOMEM;
+	}
+
+	if (nb_ch) {
+		dev->ch_index = no_os_calloc(nb_ch, sizeof(*dev->ch_index));
+		dev->ch_ids_storage = no_os_calloc(ids_len, sizeof(char));
+		if (!dev->ch_index || !dev->ch_ids_storage) {
+			no_os_free(dev->ch_index);
+			no_os_free(dev->ch_ids_storage);
+			no_os_free(dev->attrs_storage);
+			dev->ch_index = NULL;
+			dev->ch_ids_storage = NULL;
+			dev->attrs_storage = NULL;
+			return -ENOMEM;
+		}
+	}
+
+	storage = dev->attrs_storage;
+	iio_init_attr_index(&dev->attrs, device->attributes, storage);
+	storage += dev->attrs.nb_attrs;
+	iio_init_attr_index(&dev->debug_attrs, device->debug_attributes,
+			    storage);
+	storage += dev->debug_attrs.nb_attrs;
+	iio_init_attr_index(&dev->buffer_attrs, device->buffer_attributes,
+			    storage);
+	storage += dev->buffer_attrs.nb_attrs;
+
+	id = dev->ch_ids_storage;
+	for (i = 0; i < nb_ch; i++) {
+		ch = &device->channels[i];
+		_print_ch_id(id, ch);
+		dev->ch_index[i].id = id;
+		dev->ch_index[i].ch = ch;
+		id += strlen(id) + 1;
+		iio_init_attr_index(&dev->ch_index[i].attrs, ch->attributes,
+				    storage);
+		storage += dev->ch_index[i].attrs.nb_attrs;
+	}
+	if (nb_ch)
+		qsort(dev->ch_index, nb_ch, sizeof(*dev->ch_index),
+		      iio_ch_index_sort_cmp);
+
+	return 0;
+}
+
+static void iio_free_indexes(struct iio_desc *desc)
+{
+	struct iio_dev_priv *dev;
+	uint32_t i;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		dev = desc->devs + i;
+		no_os_free(dev->ch_index);
+		no_os_free(dev->ch_ids_storage);
+		no_os_free(dev->attrs_storage);
+		dev->ch_index = NULL;
+		dev->ch_ids_storage = NULL;
+		dev->attrs_storage = NULL;
+	}
+
+	for (i = 0; i < desc->nb_trigs; i++) {
+		no_os_free(desc->trigs[i].attrs.attrs);
+		desc->trigs[i].attrs.attrs = NULL;
+	}
+}
+
+/**
+ * @brief Build lookup indexes for devices, channels and attributes.
+ * @param desc - IIO descriptor.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_init_indexes(struct iio_desc *desc)
+{
+	struct iio_attribute **storage;
+	struct iio_trig_priv *trig;
+	uint32_t nb_attrs;
+	uint32_t i;
+	int32_t ret;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		ret = iio_init_dev_index(desc->devs + i);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto error;
+	}
+
+	for (i = 0; i < desc->nb_trigs; i++) {
+		trig = desc->trigs + i;
+		nb_attrs = iio_count_attrs(trig->descriptor->attributes);
+		if (!nb_attrs)
+			continue;
+
+		storage = no_os_calloc(nb_attrs, sizeof(*storage));
+		if (!storage) {
+			ret = -ENOMEM;
+			goto error;
+		}
+		iio_init_attr_index(&trig->attrs, trig->descriptor->attributes,
+				    storage);
+	}
+
+	return 0;
+error:
+	iio_free_indexes(desc);
+
+	return ret;
+}
+
 /**
  * @brief Set communication ops and read/write ops that will be called
  * from "libtinyiiod".
@@ -1871,17 +2807,35 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	if (NO_OS_IS_ERR_VALUE(ret))
 		goto free_desc;
 
-	ret = iio_init_xml(ldesc);
+	ret = iio_init_indexes(ldesc);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		goto free_trigs;
 
+	ret = iio_init_xml(ldesc);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto free_indexes;
+
 	/* device operations */
 	ops = &ldesc->iiod_ops;
 	ops->read_attr = iio_read_attr;
 	ops->write_attr = iio_write_attr;
+	ops->get_dev_id = iio_get_dev_id;
+	ops->read_attr_by_idx = iio_read_attr_by_idx;
+	ops->write_attr_by_idx = iio_write_attr_by_idx;
 	ops->get_trigger = iio_get_trigger;
 	ops->set_trigger = iio_set_trigger;
 	ops->read_buffer = iio_read_buffer;
+#ifdef IIO_ENABLE_ZERO_COPY
+	ops->get_read_buffer = iio_get_read_buffer;
+	ops->read_buffer_done = iio_read_buffer_done;
+#ifdef NO_OS_LWIP_NETWORKING
+	/* The server uses the lwip network interface */
+	if (init_param->phy_type == USE_NETWORK) {
+		ops->send_read_buffer = iio_send_read_buffer;
+		ops->read_buffer_sent = iio_read_buffer_sent;
+	}
+#endif
+#endif
 	ops->write_buffer = iio_write_buffer;
 	ops->refill_buffer = iio_refill_buffer;
 	ops->push_buffer = iio_push_buffer;
@@ -1934,6 +2888,8 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 		ret = socket_listen(ldesc->server, MAX_BACKLOG);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			goto free_pylink;
+		ldesc->event_driven = init_param->event_driven &&
+				      ldesc->server->net->socket_wait;
 	}
 #endif
 	else if (init_param->phy_type == USE_LOCAL_BACKEND) {
@@ -1968,6 +2924,8 @@ free_iiod:
 	iiod_remove(ldesc->iiod);
 free_xml:
 	no_os_free(ldesc->xml_desc);
+free_indexes:
+	iio_free_indexes(ldesc);
 free_trigs:
 	no_os_free(ldesc->trigs);
 free_devs:
@@ -1993,6 +2951,7 @@ int iio_remove(struct iio_desc *desc)
 #endif
 	no_os_cb_remove(desc->conns);
 	iiod_remove(desc->iiod);
+	iio_free_indexes(desc);
 	no_os_free(desc->devs);
 	no_os_free(desc->trigs);
 	no_os_free(desc->xml_desc);
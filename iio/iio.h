@@ -51,6 +51,15 @@
 #include "tcp_socket.h"
 #endif
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Maximum number of blocks that can be requested with SET BUFFERS_COUNT */
+#ifndef IIO_MAX_BUFFERS_COUNT
+#define IIO_MAX_BUFFERS_COUNT	16
+#endif
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -71,6 +80,9 @@ struct iio_device_init {
 	 * IIO buffer implementation can use a user provided buffer in raw_buf.
 	 * If raw_buf is NULL and iio_device has buffer callback function set,
 	 * it will allocate memory for it when needed.
+	 * When raw_buf is provided, it is split in as many blocks of the
+	 * requested buffer size as they fit. Otherwise the number of blocks
+	 * is the one requested by the client (SET BUFFERS_COUNT).
 	 */
 	int8_t *raw_buf;
 	/* Length of raw_buf */
@@ -122,6 +134,11 @@ struct iio_init_param {
 	uint32_t nb_devs;
 	struct iio_trigger_init *trigs;
 	uint32_t nb_trigs;
+	/**
+	 * USE_NETWORK only. Make iio_step wait for socket events instead of
+	 * polling the connections, if the network interface has socket_wait.
+	 */
+	bool event_driven;
 };
 
 /******************************************************************************/
@@ -148,9 +165,10 @@ int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
 		     int32_t size, int32_t *vals);
 
 /* DMA buffer functions. */
-/* Get buffer addr where to write iio_buffer.size bytes */
+/* Get buffer addr where to write iio_buffer.size bytes. For input buffers
+ * up to iio_buffer.nb_blocks blocks can be in progress at the same time */
 int iio_buffer_get_block(struct iio_buffer *buffer, void **addr);
-/* To be called to mark last iio_buffer_read as done */
+/* To be called to mark the oldest block from iio_buffer_get_block as done */
 int iio_buffer_block_done(struct iio_buffer *buffer);
 
 /* Trigger buffer functions. */
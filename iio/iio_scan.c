@@ -0,0 +1,1162 @@
+/***************************************************************************//**
+ *   @file   iio_scan.c
+ *   @brief  Scan packing engine: (de)interleaving and format conversion.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "iio_scan.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+#if defined(IIO_SCAN_SIMD) && defined(__SSE2__)
+#define IIO_SCAN_SSE2
+#include <emmintrin.h>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#elif defined(IIO_SCAN_SIMD) && defined(__ARM_NEON)
+#define IIO_SCAN_NEON
+#include <arm_neon.h>
+#endif
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Bytes converted at once, small enough for the data to stay in cache */
+#define IIO_SCAN_TILE_BYTES	2048
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define IIO_SCAN_HOST_BE	true
+#else
+#define IIO_SCAN_HOST_BE	false
+#endif
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Mask of the valid bits of a channel.
+ * @param ch - Channel layout.
+ * @return Mask with the realbits least significant bits set.
+ */
+static inline uint64_t scan_mask(const struct iio_scan_ch *ch)
+{
+	return ch->realbits == 64 ? UINT64_MAX : (1ull << ch->realbits) - 1;
+}
+
+/**
+ * @brief Check if a channel needs its samples byte swapped.
+ * @param ch - Channel layout.
+ * @return true if the storage endianness differs from the host one.
+ */
+static inline bool scan_swap(const struct iio_scan_ch *ch)
+{
+	return ch->is_big_endian != IIO_SCAN_HOST_BE;
+}
+
+/**
+ * @brief Load a stored sample.
+ * @param p - Sample in the scan.
+ * @param ch - Channel layout.
+ * @return The stored value.
+ */
+static uint64_t scan_load(const uint8_t *p, const struct iio_scan_ch *ch)
+{
+	uint64_t val = 0;
+	uint8_t i;
+
+	if (ch->is_big_endian)
+		for (i = 0; i < ch->bytes; i++)
+			val = (val << 8) | p[i];
+	else
+		for (i = ch->bytes; i > 0; i--)
+			val = (val << 8) | p[i - 1];
+
+	return val;
+}
+
+/**
+ * @brief Store a sample.
+ * @param p - Sample in the scan.
+ * @param val - Value to store.
+ * @param ch - Channel layout.
+ */
+static void scan_store(uint8_t *p, uint64_t val, const struct iio_scan_ch *ch)
+{
+	uint8_t i;
+
+	if (ch->is_big_endian)
+		for (i = ch->bytes; i > 0; i--, val >>= 8)
+			p[i - 1] = val;
+	else
+		for (i = 0; i < ch->bytes; i++, val >>= 8)
+			p[i] = val;
+}
+
+/**
+ * @brief Load a sample from a channel array.
+ * @param data - Channel array.
+ * @param i - Sample index.
+ * @param host_bytes - Size of the samples in the array.
+ * @return The sample.
+ */
+static uint64_t host_load(const void *data, uint32_t i, uint8_t host_bytes)
+{
+	switch (host_bytes) {
+	case 1:
+		return ((const uint8_t *)data)[i];
+	case 2:
+		return ((const uint16_t *)data)[i];
+	case 4:
+		return ((const uint32_t *)data)[i];
+	default:
+		return ((const uint64_t *)data)[i];
+	}
+}
+
+/**
+ * @brief Store a sample in a channel array.
+ * @param data - Channel array.
+ * @param i - Sample index.
+ * @param val - The sample.
+ * @param host_bytes - Size of the samples in the array.
+ */
+static void host_store(void *data, uint32_t i, uint64_t val,
+		       uint8_t host_bytes)
+{
+	switch (host_bytes) {
+	case 1:
+		((uint8_t *)data)[i] = val;
+		break;
+	case 2:
+		((uint16_t *)data)[i] = val;
+		break;
+	case 4:
+		((uint32_t *)data)[i] = val;
+		break;
+	default:
+		((uint64_t *)data)[i] = val;
+		break;
+	}
+}
+
+/**
+ * @brief Pack samples of channels with any format, one at a time.
+ * @param layout - Scan layout.
+ * @param scans - Destination scans.
+ * @param ch_data - Channel arrays, by channel index.
+ * @param first - Index of the first sample in the channel arrays.
+ * @param n - Number of scans.
+ */
+static void scan_pack_generic(const struct iio_scan_layout *layout,
+			      uint8_t *scans, const void *const *ch_data,
+			      uint32_t first, uint32_t n)
+{
+	const struct iio_scan_ch *ch;
+	uint64_t mask, val;
+	uint32_t i, k;
+
+	for (k = 0; k < layout->nb_ch; k++) {
+		ch = &layout->ch[k];
+		mask = scan_mask(ch);
+		for (i = 0; i < n; i++) {
+			val = host_load(ch_data[ch->idx], first + i,
+					ch->host_bytes);
+			scan_store(scans + i * layout->bytes_per_scan +
+				   ch->offset, (val & mask) << ch->shift, ch);
+		}
+	}
+}
+
+/**
+ * @brief Unpack samples of channels with any format, one at a time.
+ * @param layout - Scan layout.
+ * @param ch_data - Channel arrays, by channel index.
+ * @param first - Index of the first sample in the channel arrays.
+ * @param scans - Source scans.
+ * @param n - Number of scans.
+ */
+static void scan_unpack_generic(const struct iio_scan_layout *layout,
+				void *const *ch_data, uint32_t first,
+				const uint8_t *scans, uint32_t n)
+{
+	const struct iio_scan_ch *ch;
+	uint64_t mask, val;
+	uint32_t i, k;
+
+	for (k = 0; k < layout->nb_ch; k++) {
+		ch = &layout->ch[k];
+		mask = scan_mask(ch);
+		for (i = 0; i < n; i++) {
+			val = scan_load(scans + i * layout->bytes_per_scan +
+					ch->offset, ch);
+			val = (val >> ch->shift) & mask;
+			if (ch->is_signed && (val >> (ch->realbits - 1)) & 1)
+				val |= ~mask;
+			host_store(ch_data[ch->idx], first + i, val,
+				   ch->host_bytes);
+		}
+	}
+}
+
+/**
+ * @brief Convert 16 bit samples from the storage to the host format.
+ * @param p - Samples, converted in place.
+ * @param n - Number of samples.
+ * @param ch - Format of the samples.
+ */
+static void scan_unpack_conv16(uint16_t *p, uint32_t n,
+			       const struct iio_scan_ch *ch)
+{
+	uint32_t lsh = 16 - ch->realbits - ch->shift;
+	uint32_t rsh = 16 - ch->realbits;
+	uint16_t mask = scan_mask(ch);
+	bool swap = scan_swap(ch);
+	bool is_signed = ch->is_signed;
+	uint32_t i = 0;
+	uint16_t val;
+#if defined(IIO_SCAN_SSE2)
+	__m128i vlsh = _mm_cvtsi32_si128(lsh);
+	__m128i vrsh = _mm_cvtsi32_si128(rsh);
+	__m128i vshift = _mm_cvtsi32_si128(ch->shift);
+	__m128i vmask = _mm_set1_epi16(mask);
+	__m128i v;
+
+	for (; i + 8 <= n; i += 8) {
+		v = _mm_loadu_si128((__m128i *)(p + i));
+		if (swap)
+			v = _mm_or_si128(_mm_slli_epi16(v, 8),
+					 _mm_srli_epi16(v, 8));
+		if (is_signed)
+			v = _mm_sra_epi16(_mm_sll_epi16(v, vlsh), vrsh);
+		else
+			v = _mm_and_si128(_mm_srl_epi16(v, vshift), vmask);
+		_mm_storeu_si128((__m128i *)(p + i), v);
+	}
+#elif defined(IIO_SCAN_NEON)
+	int16x8_t vlsh = vdupq_n_s16(lsh);
+	int16x8_t vrsh = vdupq_n_s16(-(int16_t)rsh);
+	int16x8_t vshift = vdupq_n_s16(-(int16_t)ch->shift);
+	uint16x8_t vmask = vdupq_n_u16(mask);
+	uint16x8_t v;
+
+	for (; i + 8 <= n; i += 8) {
+		v = vld1q_u16(p + i);
+		if (swap)
+			v = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+		if (is_signed)
+			v = vreinterpretq_u16_s16(vshlq_s16(vreinterpretq_s16_u16(
+					vshlq_u16(v, vlsh)), vrsh));
+		else
+			v = vandq_u16(vshlq_u16(v, vshift), vmask);
+		vst1q_u16(p + i, v);
+	}
+#endif
+	for (; i < n; i++) {
+		val = swap ? __builtin_bswap16(p[i]) : p[i];
+		if (is_signed)
+			p[i] = (int16_t)(uint16_t)(val << lsh) >> rsh;
+		else
+			p[i] = (val >> ch->shift) & mask;
+	}
+}
+
+/**
+ * @brief Convert 16 bit samples from the host to the storage format.
+ * @param p - Samples, converted in place.
+ * @param n - Number of samples.
+ * @param ch - Format of the samples.
+ */
+static void scan_pack_conv16(uint16_t *p, uint32_t n,
+			     const struct iio_scan_ch *ch)
+{
+	uint16_t mask = scan_mask(ch);
+	bool swap = scan_swap(ch);
+	uint32_t i = 0;
+	uint16_t val;
+#if defined(IIO_SCAN_SSE2)
+	__m128i vshift = _mm_cvtsi32_si128(ch->shift);
+	__m128i vmask = _mm_set1_epi16(mask);
+	__m128i v;
+
+	for (; i + 8 <= n; i += 8) {
+		v = _mm_loadu_si128((__m128i *)(p + i));
+		v = _mm_sll_epi16(_mm_and_si128(v, vmask), vshift);
+		if (swap)
+			v = _mm_or_si128(_mm_slli_epi16(v, 8),
+					 _mm_srli_epi16(v, 8));
+		_mm_storeu_si128((__m128i *)(p + i), v);
+	}
+#elif defined(IIO_SCAN_NEON)
+	int16x8_t vshift = vdupq_n_s16(ch->shift);
+	uint16x8_t vmask = vdupq_n_u16(mask);
+	uint16x8_t v;
+
+	for (; i + 8 <= n; i += 8) {
+		v = vshlq_u16(vandq_u16(vld1q_u16(p + i), vmask), vshift);
+		if (swap)
+			v = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+		vst1q_u16(p + i, v);
+	}
+#endif
+	for (; i < n; i++) {
+		val = (p[i] & mask) << ch->shift;
+		p[i] = swap ? __builtin_bswap16(val) : val;
+	}
+}
+
+#if defined(IIO_SCAN_SSE2)
+/**
+ * @brief Swap the bytes of each 32 bit lane.
+ * @param v - Vector.
+ * @return Swapped vector.
+ */
+static inline __m128i scan_bswap32_sse2(__m128i v)
+{
+#ifdef __SSSE3__
+	return _mm_shuffle_epi8(v, _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11,
+						4, 5, 6, 7, 0, 1, 2, 3));
+#else
+	__m128i mid = _mm_set1_epi32(0x00FF0000);
+
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi32(v, 24),
+					 _mm_srli_epi32(v, 24)),
+			    _mm_or_si128(_mm_and_si128(_mm_slli_epi32(v, 8), mid),
+					 _mm_and_si128(_mm_srli_epi32(v, 8),
+						       _mm_srli_epi32(mid, 8))));
+#endif
+}
+#endif
+
+/**
+ * @brief Convert 32 bit samples from the storage to the host format.
+ * @param p - Samples, converted in place.
+ * @param n - Number of samples.
+ * @param ch - Format of the samples.
+ */
+static void scan_unpack_conv32(uint32_t *p, uint32_t n,
+			       const struct iio_scan_ch *ch)
+{
+	uint32_t lsh = 32 - ch->realbits - ch->shift;
+	uint32_t rsh = 32 - ch->realbits;
+	uint32_t mask = scan_mask(ch);
+	bool swap = scan_swap(ch);
+	bool is_signed = ch->is_signed;
+	uint32_t i = 0;
+	uint32_t val;
+#if defined(IIO_SCAN_SSE2)
+	__m128i vlsh = _mm_cvtsi32_si128(lsh);
+	__m128i vrsh = _mm_cvtsi32_si128(rsh);
+	__m128i vshift = _mm_cvtsi32_si128(ch->shift);
+	__m128i vmask = _mm_set1_epi32(mask);
+	__m128i v;
+
+	for (; i + 4 <= n; i += 4) {
+		v = _mm_loadu_si128((__m128i *)(p + i));
+		if (swap)
+			v = scan_bswap32_sse2(v);
+		if (is_signed)
+			v = _mm_sra_epi32(_mm_sll_epi32(v, vlsh), vrsh);
+		else
+			v = _mm_and_si128(_mm_srl_epi32(v, vshift), vmask);
+		_mm_storeu_si128((__m128i *)(p + i), v);
+	}
+#elif defined(IIO_SCAN_NEON)
+	int32x4_t vlsh = vdupq_n_s32(lsh);
+	int32x4_t vrsh = vdupq_n_s32(-(int32_t)rsh);
+	int32x4_t vshift = vdupq_n_s32(-(int32_t)ch->shift);
+	uint32x4_t vmask = vdupq_n_u32(mask);
+	uint32x4_t v;
+
+	for (; i + 4 <= n; i += 4) {
+		v = vld1q_u32(p + i);
+		if (swap)
+			v = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(v)));
+		if (is_signed)
+			v = vreinterpretq_u32_s32(vshlq_s32(vreinterpretq_s32_u32(
+					vshlq_u32(v, vlsh)), vrsh));
+		else
+			v = vandq_u32(vshlq_u32(v, vshift), vmask);
+		vst1q_u32(p + i, v);
+	}
+#endif
+	for (; i < n; i++) {
+		val = swap ? __builtin_bswap32(p[i]) : p[i];
+		if (is_signed)
+			p[i] = (int32_t)(val << lsh) >> rsh;
+		else
+			p[i] = (val >> ch->shift) & mask;
+	}
+}
+
+/**
+ * @brief Convert 32 bit samples from the host to the storage format.
+ * @param p - Samples, converted in place.
+ * @param n - Number of samples.
+ * @param ch - Format of the samples.
+ */
+static void scan_pack_conv32(uint32_t *p, uint32_t n,
+			     const struct iio_scan_ch *ch)
+{
+	uint32_t mask = scan_mask(ch);
+	bool swap = scan_swap(ch);
+	uint32_t i = 0;
+	uint32_t val;
+#if defined(IIO_SCAN_SSE2)
+	__m128i vshift = _mm_cvtsi32_si128(ch->shift);
+	__m128i vmask = _mm_set1_epi32(mask);
+	__m128i v;
+
+	for (; i + 4 <= n; i += 4) {
+		v = _mm_loadu_si128((__m128i *)(p + i));
+		v = _mm_sll_epi32(_mm_and_si128(v, vmask), vshift);
+		if (swap)
+			v = scan_bswap32_sse2(v);
+		_mm_storeu_si128((__m128i *)(p + i), v);
+	}
+#elif defined(IIO_SCAN_NEON)
+	int32x4_t vshift = vdupq_n_s32(ch->shift);
+	uint32x4_t vmask = vdupq_n_u32(mask);
+	uint32x4_t v;
+
+	for (; i + 4 <= n; i += 4) {
+		v = vshlq_u32(vandq_u32(vld1q_u32(p + i), vmask), vshift);
+		if (swap)
+			v = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(v)));
+		vst1q_u32(p + i, v);
+	}
+#endif
+	for (; i < n; i++) {
+		val = (p[i] & mask) << ch->shift;
+		p[i] = swap ? __builtin_bswap32(val) : val;
+	}
+}
+
+#if defined(IIO_SCAN_SSE2)
+/**
+ * @brief Transpose 8 vectors of 8 16 bit lanes.
+ * @param v - Vectors, transposed in place.
+ */
+static inline void scan_transpose8x16_sse2(__m128i *v)
+{
+	__m128i a0 = _mm_unpacklo_epi16(v[0], v[1]);
+	__m128i a1 = _mm_unpacklo_epi16(v[2], v[3]);
+	__m128i a2 = _mm_unpacklo_epi16(v[4], v[5]);
+	__m128i a3 = _mm_unpacklo_epi16(v[6], v[7]);
+	__m128i a4 = _mm_unpackhi_epi16(v[0], v[1]);
+	__m128i a5 = _mm_unpackhi_epi16(v[2], v[3]);
+	__m128i a6 = _mm_unpackhi_epi16(v[4], v[5]);
+	__m128i a7 = _mm_unpackhi_epi16(v[6], v[7]);
+	__m128i b0 = _mm_unpacklo_epi32(a0, a1);
+	__m128i b1 = _mm_unpackhi_epi32(a0, a1);
+	__m128i b2 = _mm_unpacklo_epi32(a2, a3);
+	__m128i b3 = _mm_unpackhi_epi32(a2, a3);
+	__m128i b4 = _mm_unpacklo_epi32(a4, a5);
+	__m128i b5 = _mm_unpackhi_epi32(a4, a5);
+	__m128i b6 = _mm_unpacklo_epi32(a6, a7);
+	__m128i b7 = _mm_unpackhi_epi32(a6, a7);
+
+	v[0] = _mm_unpacklo_epi64(b0, b2);
+	v[1] = _mm_unpackhi_epi64(b0, b2);
+	v[2] = _mm_unpacklo_epi64(b1, b3);
+	v[3] = _mm_unpackhi_epi64(b1, b3);
+	v[4] = _mm_unpacklo_epi64(b4, b6);
+	v[5] = _mm_unpackhi_epi64(b4, b6);
+	v[6] = _mm_unpacklo_epi64(b5, b7);
+	v[7] = _mm_unpackhi_epi64(b5, b7);
+}
+#endif
+
+/**
+ * @brief Deinterleave 16 bit samples.
+ * @param src - Scans.
+ * @param dst - Destination of each channel.
+ * @param nb_ch - Number of channels.
+ * @param n - Number of scans.
+ */
+static void scan_deinterleave16(const uint16_t *src, uint16_t **dst,
+				uint32_t nb_ch, uint32_t n)
+{
+	uint32_t i = 0, k;
+
+	if (nb_ch == 1) {
+		memcpy(dst[0], src, n * sizeof(*src));
+		return;
+	}
+#if defined(IIO_SCAN_SSE2)
+	__m128i v0, v1, v2, v3, t0, t1, t2, t3;
+
+	if (nb_ch == 2) {
+		for (; i + 8 <= n; i += 8, src += 16) {
+			v0 = _mm_loadu_si128((__m128i *)src);
+			v1 = _mm_loadu_si128((__m128i *)(src + 8));
+			t0 = _mm_unpacklo_epi16(v0, v1);
+			t1 = _mm_unpackhi_epi16(v0, v1);
+			v0 = _mm_unpacklo_epi16(t0, t1);
+			v1 = _mm_unpackhi_epi16(t0, t1);
+			_mm_storeu_si128((__m128i *)(dst[0] + i),
+					 _mm_unpacklo_epi16(v0, v1));
+			_mm_storeu_si128((__m128i *)(dst[1] + i),
+					 _mm_unpackhi_epi16(v0, v1));
+		}
+	} else if (nb_ch == 4) {
+		for (; i + 8 <= n; i += 8, src += 32) {
+			v0 = _mm_loadu_si128((__m128i *)src);
+			v1 = _mm_loadu_si128((__m128i *)(src + 8));
+			v2 = _mm_loadu_si128((__m128i *)(src + 16));
+			v3 = _mm_loadu_si128((__m128i *)(src + 24));
+			t0 = _mm_unpacklo_epi16(v0, v1);
+			t1 = _mm_unpackhi_epi16(v0, v1);
+			t2 = _mm_unpacklo_epi16(v2, v3);
+			t3 = _mm_unpackhi_epi16(v2, v3);
+			v0 = _mm_unpacklo_epi16(t0, t1);
+			v1 = _mm_unpackhi_epi16(t0, t1);
+			v2 = _mm_unpacklo_epi16(t2, t3);
+			v3 = _mm_unpackhi_epi16(t2, t3);
+			_mm_storeu_si128((__m128i *)(dst[0] + i),
+					 _mm_unpacklo_epi64(v0, v2));
+			_mm_storeu_si128((__m128i *)(dst[1] + i),
+					 _mm_unpackhi_epi64(v0, v2));
+			_mm_storeu_si128((__m128i *)(dst[2] + i),
+					 _mm_unpacklo_epi64(v1, v3));
+			_mm_storeu_si128((__m128i *)(dst[3] + i),
+					 _mm_unpackhi_epi64(v1, v3));
+		}
+	} else if (nb_ch % 8 == 0) {
+		__m128i v[8];
+		uint32_t g;
+
+		for (; i + 8 <= n; i += 8, src += 8 * nb_ch) {
+			for (g = 0; g < nb_ch; g += 8) {
+				for (k = 0; k < 8; k++)
+					v[k] = _mm_loadu_si128((__m128i *)
+							       (src + k * nb_ch + g));
+				scan_transpose8x16_sse2(v);
+				for (k = 0; k < 8; k++)
+					_mm_storeu_si128((__m128i *)(dst[g + k] + i),
+							 v[k]);
+			}
+		}
+	}
+#elif defined(IIO_SCAN_NEON)
+	uint16x8x2_t v2;
+	uint16x8x4_t v4;
+
+	if (nb_ch == 2) {
+		for (; i + 8 <= n; i += 8, src += 16) {
+			v2 = vld2q_u16(src);
+			vst1q_u16(dst[0] + i, v2.val[0]);
+			vst1q_u16(dst[1] + i, v2.val[1]);
+		}
+	} else if (nb_ch == 4) {
+		for (; i + 8 <= n; i += 8, src += 32) {
+			v4 = vld4q_u16(src);
+			vst1q_u16(dst[0] + i, v4.val[0]);
+			vst1q_u16(dst[1] + i, v4.val[1]);
+			vst1q_u16(dst[2] + i, v4.val[2]);
+			vst1q_u16(dst[3] + i, v4.val[3]);
+		}
+	}
+#endif
+	for (; i < n; i++, src += nb_ch)
+		for (k = 0; k < nb_ch; k++)
+			dst[k][i] = src[k];
+}
+
+/**
+ * @brief Interleave 16 bit samples.
+ * @param dst - Scans.
+ * @param src - Samples of each channel.
+ * @param nb_ch - Number of channels.
+ * @param n - Number of scans.
+ */
+static void scan_interleave16(uint16_t *dst, const uint16_t **src,
+			      uint32_t nb_ch, uint32_t n)
+{
+	uint32_t i = 0, k;
+
+	if (nb_ch == 1) {
+		memcpy(dst, src[0], n * sizeof(*dst));
+		return;
+	}
+#if defined(IIO_SCAN_SSE2)
+	__m128i a, b, c, d, ab, cd;
+
+	if (nb_ch == 2) {
+		for (; i + 8 <= n; i += 8, dst += 16) {
+			a = _mm_loadu_si128((__m128i *)(src[0] + i));
+			b = _mm_loadu_si128((__m128i *)(src[1] + i));
+			_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(a, b));
+			_mm_storeu_si128((__m128i *)(dst + 8),
+					 _mm_unpackhi_epi16(a, b));
+		}
+	} else if (nb_ch == 4) {
+		for (; i + 8 <= n; i += 8, dst += 32) {
+			a = _mm_loadu_si128((__m128i *)(src[0] + i));
+			b = _mm_loadu_si128((__m128i *)(src[1] + i));
+			c = _mm_loadu_si128((__m128i *)(src[2] + i));
+			d = _mm_loadu_si128((__m128i *)(src[3] + i));
+			ab = _mm_unpacklo_epi16(a, b);
+			cd = _mm_unpacklo_epi16(c, d);
+			_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi32(ab, cd));
+			_mm_storeu_si128((__m128i *)(dst + 8),
+					 _mm_unpackhi_epi32(ab, cd));
+			ab = _mm_unpackhi_epi16(a, b);
+			cd = _mm_unpackhi_epi16(c, d);
+			_mm_storeu_si128((__m128i *)(dst + 16),
+					 _mm_unpacklo_epi32(ab, cd));
+			_mm_storeu_si128((__m128i *)(dst + 24),
+					 _mm_unpackhi_epi32(ab, cd));
+		}
+	} else if (nb_ch % 8 == 0) {
+		__m128i v[8];
+		uint32_t g;
+
+		for (; i + 8 <= n; i += 8, dst += 8 * nb_ch) {
+			for (g = 0; g < nb_ch; g += 8) {
+				for (k = 0; k < 8; k++)
+					v[k] = _mm_loadu_si128((__m128i *)
+							       (src[g + k] + i));
+				scan_transpose8x16_sse2(v);
+				for (k = 0; k < 8; k++)
+					_mm_storeu_si128((__m128i *)
+							 (dst + k * nb_ch + g), v[k]);
+			}
+		}
+	}
+#elif defined(IIO_SCAN_NEON)
+	uint16x8x2_t v2;
+	uint16x8x4_t v4;
+
+	if (nb_ch == 2) {
+		for (; i + 8 <= n; i += 8, dst += 16) {
+			v2.val[0] = vld1q_u16(src[0] + i);
+			v2.val[1] = vld1q_u16(src[1] + i);
+			vst2q_u16(dst, v2);
+		}
+	} else if (nb_ch == 4) {
+		for (; i + 8 <= n; i += 8, dst += 32) {
+			v4.val[0] = vld1q_u16(src[0] + i);
+			v4.val[1] = vld1q_u16(src[1] + i);
+			v4.val[2] = vld1q_u16(src[2] + i);
+			v4.val[3] = vld1q_u16(src[3] + i);
+			vst4q_u16(dst, v4);
+		}
+	}
+#endif
+	for (; i < n; i++, dst += nb_ch)
+		for (k = 0; k < nb_ch; k++)
+			dst[k] = src[k][i];
+}
+
+#if defined(IIO_SCAN_SSE2)
+/**
+ * @brief Transpose 4 vectors of 4 32 bit lanes.
+ * @param v - Vectors, transposed in place.
+ */
+static inline void scan_transpose4x32_sse2(__m128i *v)
+{
+	__m128i t0 = _mm_unpacklo_epi32(v[0], v[1]);
+	__m128i t1 = _mm_unpacklo_epi32(v[2], v[3]);
+	__m128i t2 = _mm_unpackhi_epi32(v[0], v[1]);
+	__m128i t3 = _mm_unpackhi_epi32(v[2], v[3]);
+
+	v[0] = _mm_unpacklo_epi64(t0, t1);
+	v[1] = _mm_unpackhi_epi64(t0, t1);
+	v[2] = _mm_unpacklo_epi64(t2, t3);
+	v[3] = _mm_unpackhi_epi64(t2, t3);
+}
+#endif
+
+/**
+ * @brief Deinterleave 32 bit samples.
+ * @param src - Scans.
+ * @param dst - Destination of each channel.
+ * @param nb_ch - Number of channels.
+ * @param n - Number of scans.
+ */
+static void scan_deinterleave32(const uint32_t *src, uint32_t **dst,
+				uint32_t nb_ch, uint32_t n)
+{
+	uint32_t i = 0, k;
+
+	if (nb_ch == 1) {
+		memcpy(dst[0], src, n * sizeof(*src));
+		return;
+	}
+#if defined(IIO_SCAN_SSE2)
+	__m128i v[4], t0, t1;
+
+	if (nb_ch == 2) {
+		for (; i + 4 <= n; i += 4, src += 8) {
+			v[0] = _mm_loadu_si128((__m128i *)src);
+			v[1] = _mm_loadu_si128((__m128i *)(src + 4));
+			t0 = _mm_unpacklo_epi32(v[0], v[1]);
+			t1 = _mm_unpackhi_epi32(v[0], v[1]);
+			_mm_storeu_si128((__m128i *)(dst[0] + i),
+					 _mm_unpacklo_epi32(t0, t1));
+			_mm_storeu_si128((__m128i *)(dst[1] + i),
+					 _mm_unpackhi_epi32(t0, t1));
+		}
+	} else if (nb_ch % 4 == 0) {
+		uint32_t g;
+
+		for (; i + 4 <= n; i += 4, src += 4 * nb_ch) {
+			for (g = 0; g < nb_ch; g += 4) {
+				for (k = 0; k < 4; k++)
+					v[k] = _mm_loadu_si128((__m128i *)
+							       (src + k * nb_ch + g));
+				scan_transpose4x32_sse2(v);
+				for (k = 0; k < 4; k++)
+					_mm_storeu_si128((__m128i *)(dst[g + k] + i),
+							 v[k]);
+			}
+		}
+	}
+#elif defined(IIO_SCAN_NEON)
+	uint32x4x2_t v2;
+	uint32x4x4_t v4;
+
+	if (nb_ch == 2) {
+		for (; i + 4 <= n; i += 4, src += 8) {
+			v2 = vld2q_u32(src);
+			vst1q_u32(dst[0] + i, v2.val[0]);
+			vst1q_u32(dst[1] + i, v2.val[1]);
+		}
+	} else if (nb_ch == 4) {
+		for (; i + 4 <= n; i += 4, src += 16) {
+			v4 = vld4q_u32(src);
+			for (k = 0; k < 4; k++)
+				vst1q_u32(dst[k] + i, v4.val[k]);
+		}
+	}
+#endif
+	for (; i < n; i++, src += nb_ch)
+		for (k = 0; k < nb_ch; k++)
+			dst[k][i] = src[k];
+}
+
+/**
+ * @brief Interleave 32 bit samples.
+ * @param dst - Scans.
+ * @param src - Samples of each channel.
+ * @param nb_ch - Number of channels.
+ * @param n - Number of scans.
+ */
+static void scan_interleave32(uint32_t *dst, const uint32_t **src,
+			      uint32_t nb_ch, uint32_t n)
+{
+	uint32_t i = 0, k;
+
+	if (nb_ch == 1) {
+		memcpy(dst, src[0], n * sizeof(*dst));
+		return;
+	}
+#if defined(IIO_SCAN_SSE2)
+	__m128i v[4];
+
+	if (nb_ch == 2) {
+		for (; i + 4 <= n; i += 4, dst += 8) {
+			v[0] = _mm_loadu_si128((__m128i *)(src[0] + i));
+			v[1] = _mm_loadu_si128((__m128i *)(src[1] + i));
+			_mm_storeu_si128((__m128i *)dst,
+					 _mm_unpacklo_epi32(v[0], v[1]));
+			_mm_storeu_si128((__m128i *)(dst + 4),
+					 _mm_unpackhi_epi32(v[0], v[1]));
+		}
+	} else if (nb_ch % 4 == 0) {
+		uint32_t g;
+
+		for (; i + 4 <= n; i += 4, dst += 4 * nb_ch) {
+			for (g = 0; g < nb_ch; g += 4) {
+				for (k = 0; k < 4; k++)
+					v[k] = _mm_loadu_si128((__m128i *)
+							       (src[g + k] + i));
+				scan_transpose4x32_sse2(v);
+				for (k = 0; k < 4; k++)
+					_mm_storeu_si128((__m128i *)
+							 (dst + k * nb_ch + g), v[k]);
+			}
+		}
+	}
+#elif defined(IIO_SCAN_NEON)
+	uint32x4x2_t v2;
+	uint32x4x4_t v4;
+
+	if (nb_ch == 2) {
+		for (; i + 4 <= n; i += 4, dst += 8) {
+			v2.val[0] = vld1q_u32(src[0] + i);
+			v2.val[1] = vld1q_u32(src[1] + i);
+			vst2q_u32(dst, v2);
+		}
+	} else if (nb_ch == 4) {
+		for (; i + 4 <= n; i += 4, dst += 16) {
+			for (k = 0; k < 4; k++)
+				v4.val[k] = vld1q_u32(src[k] + i);
+			vst4q_u32(dst, v4);
+		}
+	}
+#endif
+	for (; i < n; i++, dst += nb_ch)
+		for (k = 0; k < nb_ch; k++)
+			dst[k] = src[k][i];
+}
+
+/**
+ * @brief Number of scans converted at once.
+ * @param layout - Scan layout.
+ * @return Multiple of 8 scans, so the SIMD blocks are not split.
+ */
+static uint32_t scan_tile(const struct iio_scan_layout *layout)
+{
+	uint32_t tile = IIO_SCAN_TILE_BYTES / layout->bytes_per_scan;
+
+	return no_os_max(tile & ~7u, 8u);
+}
+
+/**
+ * @brief Pack scans, starting from sample first of the channel arrays.
+ * @param layout - Scan layout.
+ * @param scans - Destination scans.
+ * @param ch_data - Channel arrays, by channel index.
+ * @param first - Index of the first sample in the channel arrays.
+ * @param n - Number of scans.
+ */
+static void scan_pack(const struct iio_scan_layout *layout, uint8_t *scans,
+		      const void *const *ch_data, uint32_t first, uint32_t n)
+{
+	const void *src[IIO_SCAN_MAX_CHANNELS];
+	const struct iio_scan_ch *ch = &layout->ch[0];
+	uint32_t tile = scan_tile(layout);
+	uint32_t nb_ch = layout->nb_ch;
+	uint32_t i, k, m;
+
+	if (!layout->uniform) {
+		scan_pack_generic(layout, scans, ch_data, first, n);
+		return;
+	}
+
+	for (i = 0; i < n; i += m) {
+		m = no_os_min(n - i, tile);
+		for (k = 0; k < nb_ch; k++)
+			src[k] = (const uint8_t *)ch_data[layout->ch[k].idx] +
+				 (first + i) * ch->bytes;
+
+		if (ch->bytes == 2) {
+			scan_interleave16((uint16_t *)scans,
+					  (const uint16_t **)src, nb_ch, m);
+			if (!layout->raw)
+				scan_pack_conv16((uint16_t *)scans, m * nb_ch,
+						 ch);
+		} else {
+			scan_interleave32((uint32_t *)scans,
+					  (const uint32_t **)src, nb_ch, m);
+			if (!layout->raw)
+				scan_pack_conv32((uint32_t *)scans, m * nb_ch,
+						 ch);
+		}
+		scans += m * layout->bytes_per_scan;
+	}
+}
+
+/**
+ * @brief Unpack scans, starting from sample first of the channel arrays.
+ * @param layout - Scan layout.
+ * @param ch_data - Channel arrays, by channel index.
+ * @param first - Index of the first sample in the channel arrays.
+ * @param scans - Source scans.
+ * @param n - Number of scans.
+ */
+static void scan_unpack(const struct iio_scan_layout *layout,
+			void *const *ch_data, uint32_t first,
+			const uint8_t *scans, uint32_t n)
+{
+	void *dst[IIO_SCAN_MAX_CHANNELS];
+	const struct iio_scan_ch *ch = &layout->ch[0];
+	uint32_t tile = scan_tile(layout);
+	uint32_t nb_ch = layout->nb_ch;
+	uint32_t i, k, m;
+
+	if (!layout->uniform) {
+		scan_unpack_generic(layout, ch_data, first, scans, n);
+		return;
+	}
+
+	for (i = 0; i < n; i += m) {
+		m = no_os_min(n - i, tile);
+		for (k = 0; k < nb_ch; k++)
+			dst[k] = (uint8_t *)ch_data[layout->ch[k].idx] +
+				 (first + i) * ch->bytes;
+
+		/* Deinterleave, then convert while the samples are in cache */
+		if (ch->bytes == 2) {
+			scan_deinterleave16((const uint16_t *)scans,
+					    (uint16_t **)dst, nb_ch, m);
+			if (!layout->raw)
+				for (k = 0; k < nb_ch; k++)
+					scan_unpack_conv16(dst[k], m, ch);
+		} else {
+			scan_deinterleave32((const uint32_t *)scans,
+					    (uint32_t **)dst, nb_ch, m);
+			if (!layout->raw)
+				for (k = 0; k < nb_ch; k++)
+					scan_unpack_conv32(dst[k], m, ch);
+		}
+		scans += m * layout->bytes_per_scan;
+	}
+}
+
+/**
+ * @brief Compute the layout of the scans for a mask of active channels.
+ * @param layout - Layout to be filled.
+ * @param channels - Channels of the device, iio_device.channels.
+ * @param num_ch - Number of channels, iio_device.num_ch.
+ * @param mask - Active channels.
+ * @return 0 in case of success, -EINVAL if a channel has no scan_type or an
+ * unsupported one.
+ */
+int iio_scan_layout_init(struct iio_scan_layout *layout,
+			 const struct iio_channel *channels, uint32_t num_ch,
+			 uint32_t mask)
+{
+	const struct scan_type *st;
+	struct iio_scan_ch *ch, *ch0;
+	uint32_t i, offset = 0;
+
+	if (!layout || !channels || !mask || num_ch > IIO_SCAN_MAX_CHANNELS ||
+	    (num_ch < IIO_SCAN_MAX_CHANNELS && mask >> num_ch))
+		return -EINVAL;
+
+	layout->nb_ch = 0;
+	layout->uniform = true;
+	ch0 = &layout->ch[0];
+	for (i = 0; i < num_ch; i++) {
+		if (!(mask & (1u << i)))
+			continue;
+
+		st = channels[i].scan_type;
+		if (!st || !st->realbits ||
+		    st->realbits + st->shift > st->storagebits)
+			return -EINVAL;
+
+		ch = &layout->ch[layout->nb_ch++];
+		switch (st->storagebits) {
+		case 8:
+		case 16:
+		case 32:
+		case 64:
+			ch->host_bytes = st->storagebits / 8;
+			break;
+		case 24:
+			ch->host_bytes = 4;
+			break;
+		default:
+			return -EINVAL;
+		}
+		ch->idx = i;
+		ch->bytes = st->storagebits / 8;
+		ch->shift = st->shift;
+		ch->realbits = st->realbits;
+		ch->is_signed = st->sign == 's' || st->sign == 'S';
+		ch->is_big_endian = st->is_big_endian;
+		ch->offset = offset;
+		offset += ch->bytes;
+
+		if (ch->bytes != ch0->bytes || ch->shift != ch0->shift ||
+		    ch->realbits != ch0->realbits ||
+		    ch->is_signed != ch0->is_signed ||
+		    ch->is_big_endian != ch0->is_big_endian)
+			layout->uniform = false;
+	}
+
+	layout->bytes_per_scan = offset;
+	if (ch0->bytes != 2 && ch0->bytes != 4)
+		layout->uniform = false;
+	layout->raw = layout->uniform && ch0->realbits == ch0->bytes * 8 &&
+		      !scan_swap(ch0);
+
+	return 0;
+}
+
+/**
+ * @brief Interleave samples of the active channels into scans.
+ * @param layout - Scan layout.
+ * @param scans - Destination, nb_scans * layout->bytes_per_scan bytes.
+ * @param ch_data - Samples of each channel, indexed by channel index. Only
+ * the active channels are accessed.
+ * @param nb_scans - Number of scans.
+ */
+void iio_scan_pack(const struct iio_scan_layout *layout, void *scans,
+		   const void *const *ch_data, uint32_t nb_scans)
+{
+	scan_pack(layout, scans, ch_data, 0, nb_scans);
+}
+
+/**
+ * @brief Deinterleave scans into samples of the active channels.
+ * @param layout - Scan layout.
+ * @param ch_data - Destination of each channel, indexed by channel index.
+ * Only the active channels are accessed.
+ * @param scans - Source, nb_scans * layout->bytes_per_scan bytes.
+ * @param nb_scans - Number of scans.
+ */
+void iio_scan_unpack(const struct iio_scan_layout *layout,
+		     void *const *ch_data, const void *scans,
+		     uint32_t nb_scans)
+{
+	scan_unpack(layout, ch_data, 0, scans, nb_scans);
+}
+
+/**
+ * @brief Pack samples of the active channels directly into the buffer.
+ *
+ * Equivalent to nb_scans calls to iio_buffer_push_scan, without assembling
+ * each scan separately.
+ * @param buffer - Input buffer.
+ * @param layout - Layout for buffer->active_mask.
+ * @param ch_data - Samples of each channel, indexed by channel index.
+ * @param nb_scans - Number of scans.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_buffer_push_scans(struct iio_buffer *buffer,
+			  const struct iio_scan_layout *layout,
+			  const void *const *ch_data, uint32_t nb_scans)
+{
+	uint32_t bps, done, size;
+	void *addr;
+	int32_t ret;
+
+	if (!buffer || !layout || !ch_data ||
+	    layout->bytes_per_scan != buffer->bytes_per_scan)
+		return -EINVAL;
+
+	bps = layout->bytes_per_scan;
+	for (done = 0; done < nb_scans; done += size / bps) {
+		ret = no_os_cb_prepare_async_write(buffer->buf,
+						   (nb_scans - done) * bps,
+						   &addr, &size);
+		if (ret)
+			return ret;
+
+		/* The buffer holds whole scans, so it never wraps mid scan */
+		scan_pack(layout, addr, ch_data, done, size / bps);
+
+		ret = no_os_cb_end_async_write(buffer->buf);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Unpack scans from the buffer directly into the channel arrays.
+ *
+ * Equivalent to nb_scans calls to iio_buffer_pop_scan, without copying each
+ * scan separately.
+ * @param buffer - Output buffer.
+ * @param layout - Layout for buffer->active_mask.
+ * @param ch_data - Destination of each channel, indexed by channel index.
+ * @param nb_scans - Number of scans.
+ * @return 0 in case of success, -EAGAIN if less than nb_scans scans are
+ * available, other negative error code otherwise.
+ */
+int iio_buffer_pop_scans(struct iio_buffer *buffer,
+			 const struct iio_scan_layout *layout,
+			 void *const *ch_data, uint32_t nb_scans)
+{
+	struct iio_cyclic_buffer_info *cyclic;
+	bool overrun = false;
+	uint32_t bps, done, size;
+	void *addr;
+	int32_t ret;
+
+	if (!buffer || !layout || !ch_data ||
+	    layout->bytes_per_scan != buffer->bytes_per_scan)
+		return -EINVAL;
+
+	bps = layout->bytes_per_scan;
+	cyclic = &buffer->cyclic_info;
+	if (cyclic->is_cyclic) {
+		/* The data stays in the buffer and is replayed */
+		for (done = 0; done < nb_scans; done += size / bps) {
+			size = no_os_min((nb_scans - done) * bps,
+					 buffer->size - cyclic->buff_index);
+			scan_unpack(layout, ch_data, done,
+				    (uint8_t *)buffer->buf->buff +
+				    cyclic->buff_index, size / bps);
+			cyclic->buff_index += size;
+			if (cyclic->buff_index == buffer->size)
+				cyclic->buff_index = 0;
+		}
+
+		return 0;
+	}
+
+	ret = no_os_cb_size(buffer->buf, &size);
+	if (ret && ret != -NO_OS_EOVERRUN)
+		return ret;
+	if (size < nb_scans * bps)
+		return -EAGAIN;
+
+	for (done = 0; done < nb_scans; done += size / bps) {
+		size = 0;
+		ret = no_os_cb_prepare_async_read(buffer->buf,
+						  (nb_scans - done) * bps,
+						  &addr, &size);
+		if (ret == -NO_OS_EOVERRUN)
+			overrun = true;
+		else if (ret)
+			return ret;
+		if (!size)
+			return -EAGAIN;
+
+		scan_unpack(layout, ch_data, done, addr, size / bps);
+
+		ret = no_os_cb_end_async_read(buffer->buf);
+		if (ret)
+			return ret;
+	}
+
+	return overrun ? -NO_OS_EOVERRUN : 0;
+}
@@ -0,0 +1,137 @@
+/***************************************************************************//**
+ *   @file   iio_scan.h
+ *   @brief  Header file for the scan packing engine.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef IIO_SCAN_H_
+#define IIO_SCAN_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "iio_types.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define IIO_SCAN_MAX_CHANNELS	32
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/*
+ * The scan engine converts whole blocks of samples between the buffer format
+ * described by iio_channel.scan_type (interleaved scans, storage endianness,
+ * shift and realbits) and one array of samples per channel, in host format:
+ * realbits wide values, sign extended for 's' channels, stored in
+ * int8/16/32/64_t for a storagebits of 8, 16, 24 or 32, 64.
+ * When all the active channels share the same 16 or 32 bit format, the
+ * samples are (de)interleaved and converted a block at a time. Define
+ * IIO_SCAN_SIMD (IIO_SCAN_SIMD=y in the project Makefile) to use SSE2 or NEON
+ * for it when the target has them. The NEON version is only checked by
+ * running tests/iio/scan on an ARM host.
+ */
+
+/**
+ * @struct iio_scan_ch
+ * @brief Position and format of an active channel in a scan
+ */
+struct iio_scan_ch {
+	/** Index of the channel in iio_device.channels */
+	uint8_t idx;
+	/** Bytes used in the scan */
+	uint8_t bytes;
+	/** Bytes used in the channel array */
+	uint8_t host_bytes;
+	/** Shift of the value in the stored sample */
+	uint8_t shift;
+	/** Number of valid bits */
+	uint8_t realbits;
+	/** Sign extend the value */
+	bool is_signed;
+	/** Stored in big endian */
+	bool is_big_endian;
+	/** Offset of the sample in the scan */
+	uint16_t offset;
+};
+
+/**
+ * @struct iio_scan_layout
+ * @brief Layout of the scans for a mask of active channels
+ */
+struct iio_scan_layout {
+	/** Size of a scan */
+	uint32_t bytes_per_scan;
+	/** Number of active channels */
+	uint32_t nb_ch;
+	/** All active channels have the same 16 or 32 bit format */
+	bool uniform;
+	/** Uniform and no conversion besides (de)interleaving is needed */
+	bool raw;
+	/** Active channels, in scan order */
+	struct iio_scan_ch ch[IIO_SCAN_MAX_CHANNELS];
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Compute the layout of the scans for the channels active in mask. */
+int iio_scan_layout_init(struct iio_scan_layout *layout,
+			 const struct iio_channel *channels, uint32_t num_ch,
+			 uint32_t mask);
+/* Interleave ch_data[channel index][0..nb_scans) into scans. */
+void iio_scan_pack(const struct iio_scan_layout *layout, void *scans,
+		   const void *const *ch_data, uint32_t nb_scans);
+/* Deinterleave scans into ch_data[channel index][0..nb_scans). */
+void iio_scan_unpack(const struct iio_scan_layout *layout,
+		     void *const *ch_data, const void *scans,
+		     uint32_t nb_scans);
+/* Pack nb_scans samples of each channel directly into the buffer. */
+int iio_buffer_push_scans(struct iio_buffer *buffer,
+			  const struct iio_scan_layout *layout,
+			  const void *const *ch_data, uint32_t nb_scans);
+/* Unpack nb_scans scans from the buffer directly into the channel arrays. */
+int iio_buffer_pop_scans(struct iio_buffer *buffer,
+			 const struct iio_scan_layout *layout,
+			 void *const *ch_data, uint32_t nb_scans);
+
+#endif /* IIO_SCAN_H_ */
@@ -50,7 +50,6 @@
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
-#ifndef LINUX_PLATFORM
 /**
  * @brief Initialize hardware trigger.
  *
@@ -170,7 +169,6 @@ int iio_hw_trig_remove(struct iio_hw_trig *trig)
 
 	return 0;
 }
-#endif
 
 /**
  * @brief Initialize software trigger.
@@ -220,6 +220,8 @@ struct iio_buffer {
 	uint32_t bytes_per_scan;
 	/* Number of requested samples */
 	uint32_t samples;
+	/* Number of blocks of size bytes that fit in buf */
+	uint32_t nb_blocks;
 	/* Buffer direction */
 	enum iio_buffer_direction dir;
 	/* Buffer where data is stored */
@@ -76,7 +76,8 @@ static struct iiod_str cmds[] = {
 	[IIOD_CMD_WRITEBUF]	= IIOD_STR("WRITEBUF"),
 	[IIOD_CMD_GETTRIG]	= IIOD_STR("GETTRIG"),
 	[IIOD_CMD_SETTRIG]	= IIOD_STR("SETTRIG"),
-	[IIOD_CMD_SET]		= IIOD_STR("SET")
+	[IIOD_CMD_SET]		= IIOD_STR("SET"),
+	[IIOD_CMD_BINARY]	= IIOD_STR("BINARY")
 };
 static const uint32_t priority_array[] = {
 	/* Order not tested, just personal expectation. Function can
@@ -94,7 +95,25 @@ static const uint32_t priority_array[] = {
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
 	IIOD_CMD_HELP,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	IIOD_CMD_BINARY
+};
+
+/* Binary ops to commands. Unknown ops are mapped to IIOD_CMD_HELP (-EINVAL) */
+static const uint8_t bin_cmds[] = {
+	[IIOD_BIN_OP_EXIT]		= IIOD_CMD_EXIT,
+	[IIOD_BIN_OP_PRINT]		= IIOD_CMD_PRINT,
+	[IIOD_BIN_OP_VERSION]		= IIOD_CMD_VERSION,
+	[IIOD_BIN_OP_TIMEOUT]		= IIOD_CMD_TIMEOUT,
+	[IIOD_BIN_OP_OPEN]		= IIOD_CMD_OPEN,
+	[IIOD_BIN_OP_CLOSE]		= IIOD_CMD_CLOSE,
+	[IIOD_BIN_OP_READ_ATTR]		= IIOD_CMD_READ,
+	[IIOD_BIN_OP_WRITE_ATTR]	= IIOD_CMD_WRITE,
+	[IIOD_BIN_OP_READBUF]		= IIOD_CMD_READBUF,
+	[IIOD_BIN_OP_WRITEBUF]		= IIOD_CMD_WRITEBUF,
+	[IIOD_BIN_OP_GETTRIG]		= IIOD_CMD_GETTRIG,
+	[IIOD_BIN_OP_SETTRIG]		= IIOD_CMD_SETTRIG,
+	[IIOD_BIN_OP_SET_BUFFERS_COUNT]	= IIOD_CMD_SET
 };
 
 static_assert(NO_OS_ARRAY_SIZE(cmds) == NO_OS_ARRAY_SIZE(priority_array),
@@ -247,6 +266,7 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 	case IIOD_CMD_EXIT:
 	case IIOD_CMD_PRINT:
 	case IIOD_CMD_VERSION:
+	case IIOD_CMD_BINARY:
 		return 0;
 	case IIOD_CMD_TIMEOUT:
 		return parse_num(token, &res->timeout, 10);
@@ -284,6 +304,50 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 	return -EINVAL;
 }
 
+/* Fill res from a binary header. The payload is processed in iiod_bin_load */
+static int32_t iiod_parse_bin_hdr(uint8_t *buf, struct comand_desc *res)
+{
+	uint32_t code;
+	uint8_t op;
+
+	res->client_id = no_os_get_unaligned_le16(buf);
+	op = buf[2];
+	res->dev_idx = buf[3];
+	code = no_os_get_unaligned_le32(buf + 4);
+	res->payload_len = no_os_get_unaligned_le32(buf + 8);
+
+	res->cmd = op < NO_OS_ARRAY_SIZE(bin_cmds) ? bin_cmds[op] :
+		   IIOD_CMD_HELP;
+	switch (res->cmd) {
+	case IIOD_CMD_TIMEOUT:
+		res->timeout = code;
+		break;
+	case IIOD_CMD_OPEN:
+		res->sample_count = code;
+		break;
+	case IIOD_CMD_READ:
+	case IIOD_CMD_WRITE:
+		res->attr_idx.type = code >> 24;
+		res->attr_idx.ch = (code >> 16) & 0xFF;
+		res->attr_idx.attr = code & 0xFFFF;
+		res->bytes_count = res->payload_len;
+		break;
+	case IIOD_CMD_READBUF:
+		res->bytes_count = code;
+		break;
+	case IIOD_CMD_WRITEBUF:
+		res->bytes_count = res->payload_len;
+		break;
+	case IIOD_CMD_SET:
+		res->count = code;
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
 static int dummy_open(struct iiod_ctx *ctx, const char *device,
 		      uint32_t samples, uint32_t mask, bool cyclic)
 {
@@ -347,6 +411,19 @@ int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 					       dummy_close);
 	ops->push_buffer = SET_DUMMY_IF_NULL(new_ops->push_buffer,
 					     dummy_close);
+	/* Binary protocol ops are optional */
+	ops->get_dev_id = new_ops->get_dev_id;
+	ops->read_attr_by_idx = new_ops->read_attr_by_idx;
+	ops->write_attr_by_idx = new_ops->write_attr_by_idx;
+	/* Zero copy ops are optional. Only used if both are set */
+	if (new_ops->get_read_buffer && new_ops->read_buffer_done) {
+		ops->get_read_buffer = new_ops->get_read_buffer;
+		ops->read_buffer_done = new_ops->read_buffer_done;
+		if (new_ops->send_read_buffer && new_ops->read_buffer_sent) {
+			ops->send_read_buffer = new_ops->send_read_buffer;
+			ops->read_buffer_sent = new_ops->read_buffer_sent;
+		}
+	}
 
 	return 0;
 }
@@ -412,9 +489,9 @@ int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
 			conn->used = 1;
 			conn->conn = data->conn;
 			/*
-			 * TODO in future:
-			 * think of using other buffer (e.g. ciruclar_buffer)
-			 * to somehow implement zero copy
+			 * Used for attributes and buffer data. READBUF data
+			 * is sent directly from the device buffer when
+			 * get_read_buffer is implemented.
 			 */
 			conn->payload_buf = data->buf;
 			conn->payload_buf_len = data->len;
@@ -483,7 +560,11 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 	len = buf->len - buf->idx;
 	if (len) {
 		tmp_buf = (uint8_t *)buf->buf + buf->idx;
-		if (flags & IIOD_WR)
+		if (flags & IIOD_REF)
+			ret = desc->ops.send_read_buffer(&ctx,
+							 conn->cmd_data.device,
+							 tmp_buf, len);
+		else if (flags & IIOD_WR)
 			ret = desc->ops.send(&ctx, tmp_buf, len);
 		else
 			ret = desc->ops.recv(&ctx, tmp_buf, len);
@@ -510,24 +591,56 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 static int32_t do_read_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
 {
 	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	bool zero_copy = !!desc->ops.get_read_buffer;
+	bool by_ref = !!desc->ops.send_read_buffer;
 	int32_t ret, len;
 
 	if (conn->nb_buf.len == 0) {
-		conn->nb_buf.buf = conn->payload_buf;
-		len = no_os_min(conn->payload_buf_len,
-				conn->cmd_data.bytes_count);
-		/* Read from dev */
-		ret = desc->ops.read_buffer(&ctx, conn->cmd_data.device,
-					    conn->nb_buf.buf, len);
+		if (zero_copy) {
+			/* Get a region from dev buffer. No copy */
+			ret = desc->ops.get_read_buffer(&ctx,
+							conn->cmd_data.device,
+							&conn->nb_buf.buf,
+							conn->cmd_data.bytes_count);
+		} else {
+			conn->nb_buf.buf = conn->payload_buf;
+			len = no_os_min(conn->payload_buf_len,
+					conn->cmd_data.bytes_count);
+			/* Read from dev */
+			ret = desc->ops.read_buffer(&ctx, conn->cmd_data.device,
+						    conn->nb_buf.buf, len);
+		}
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 		len = ret;
 		conn->nb_buf.len = len;
 		conn->nb_buf.idx = 0;
 	}
-	if (conn->nb_buf.idx < conn->nb_buf.len) {
+	if (conn->nb_buf.len) {
 		/* Write on conn */
-		ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_WR);
+		ret = rw_iiod_buff(desc, conn, &conn->nb_buf,
+				   by_ref ? IIOD_REF : IIOD_WR);
+		if (ret == -EAGAIN)
+			return ret;
+
+		/* The region is still referenced until it is sent */
+		if (by_ref && !NO_OS_IS_ERR_VALUE(ret)) {
+			ret = desc->ops.read_buffer_sent(&ctx,
+							 conn->cmd_data.device);
+			if (ret == -EAGAIN)
+				return ret;
+		}
+
+		if (zero_copy) {
+			/*
+			 * Release the region also on connection errors, the
+			 * data can't be sent anymore.
+			 */
+			len = desc->ops.read_buffer_done(&ctx,
+							 conn->cmd_data.device);
+			if (!NO_OS_IS_ERR_VALUE(ret))
+				ret = len;
+		}
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
@@ -573,6 +686,58 @@ static int32_t do_write_buff(struct iiod_desc *desc,
 	return 0;
 }
 
+/*
+ * Fill the fields used by the commands from the device index and the payload
+ * of a binary command
+ */
+static int32_t iiod_bin_load(struct iiod_desc *desc,
+			     struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	struct comand_desc *data = &conn->cmd_data;
+	uint8_t *payload = (uint8_t *)conn->payload_buf;
+	const char *id;
+
+	switch (data->cmd) {
+	case IIOD_CMD_HELP:
+	case IIOD_CMD_EXIT:
+	case IIOD_CMD_PRINT:
+	case IIOD_CMD_VERSION:
+	case IIOD_CMD_TIMEOUT:
+	case IIOD_CMD_READ:
+	case IIOD_CMD_WRITE:
+		/* No device id needed */
+		return 0;
+	default:
+		break;
+	}
+
+	id = desc->ops.get_dev_id(&ctx, data->dev_idx);
+	if (!id)
+		return -ENODEV;
+	strncpy(data->device, id, sizeof(data->device) - 1);
+
+	switch (data->cmd) {
+	case IIOD_CMD_OPEN:
+		if (data->payload_len != 2 * sizeof(uint32_t))
+			return -EINVAL;
+		data->mask = no_os_get_unaligned_le32(payload);
+		data->cyclic = !!(no_os_get_unaligned_le32(payload + 4) &
+				  IIOD_BIN_OPEN_CYCLIC);
+		break;
+	case IIOD_CMD_SETTRIG:
+		if (data->payload_len >= sizeof(data->trigger))
+			return -EINVAL;
+		memcpy(data->trigger, payload, data->payload_len);
+		data->trigger[data->payload_len] = '\0';
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
 static int32_t iiod_run_cmd(struct iiod_desc *desc,
 			    struct iiod_conn_priv *conn)
 {
@@ -585,6 +750,16 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	};
 	int32_t ret;
 
+	if (conn->binary) {
+		ret = iiod_bin_load(desc, conn);
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			conn->res.val = ret;
+			conn->res.write_val = 1;
+
+			return 0;
+		}
+	}
+
 	switch (data->cmd) {
 	case IIOD_CMD_HELP:
 	case IIOD_CMD_TIMEOUT:
@@ -600,7 +775,12 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		if (data->cmd == IIOD_CMD_CLOSE)
 			/* Set is_cyclic_buffer to false every time the device is closed */
 			conn->is_cyclic_buffer = false;
-		conn->res.val = call_op(&desc->ops, data, &ctx);
+		ret = call_op(&desc->ops, data, &ctx);
+		/* The buffer is still in use, close it later */
+		if (data->cmd == IIOD_CMD_CLOSE && ret == -EAGAIN)
+			return ret;
+
+		conn->res.val = ret;
 		conn->res.write_val = 1;
 		break;
 	case IIOD_CMD_EXIT:
@@ -620,7 +800,12 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		break;
 	case IIOD_CMD_READ:
 	case IIOD_CMD_GETTRIG:
-		if (data->cmd == IIOD_CMD_READ)
+		if (data->cmd == IIOD_CMD_READ && conn->binary)
+			ret = desc->ops.read_attr_by_idx(&ctx, data->dev_idx,
+							 &data->attr_idx,
+							 conn->payload_buf,
+							 conn->payload_buf_len);
+		else if (data->cmd == IIOD_CMD_READ)
 			ret = desc->ops.read_attr(&ctx, data->device, &attr,
 						  conn->payload_buf,
 						  conn->payload_buf_len);
@@ -637,9 +822,15 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		break;
 	case IIOD_CMD_WRITE:
 		conn->payload_buf[data->bytes_count] = '\0';
-		ret = desc->ops.write_attr(&ctx, data->device, &attr,
-					   conn->payload_buf,
-					   data->bytes_count);
+		if (conn->binary)
+			ret = desc->ops.write_attr_by_idx(&ctx, data->dev_idx,
+							  &data->attr_idx,
+							  conn->payload_buf,
+							  data->bytes_count);
+		else
+			ret = desc->ops.write_attr(&ctx, data->device, &attr,
+						   conn->payload_buf,
+						   data->bytes_count);
 		conn->nb_buf.len = 0;
 		conn->res.val = ret;
 		conn->res.write_val = 1;
@@ -652,6 +843,9 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 			break;
 		}
 		conn->res.val = data->bytes_count;
+		/* The mask is not sent in binary mode */
+		if (conn->binary)
+			break;
 		ret = snprintf(conn->buf_mask, 10, "%08"PRIx32, conn->mask);
 		conn->res.buf.buf = conn->buf_mask;
 		conn->res.buf.len = ret;
@@ -660,6 +854,14 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		conn->res.val = data->bytes_count;
 		conn->res.write_val = 1;
 		break;
+	case IIOD_CMD_BINARY:
+		conn->res.write_val = 1;
+		if (desc->ops.get_dev_id && desc->ops.read_attr_by_idx &&
+		    desc->ops.write_attr_by_idx)
+			conn->res.val = 0;
+		else
+			conn->res.val = -ENOSYS;
+		break;
 	default:
 		return -EINVAL;
 	}
@@ -703,6 +905,133 @@ end:
 	return ret;
 }
 
+/* Read the header of a binary command in parser_buf */
+static int32_t iiod_read_bin_hdr(struct iiod_desc *desc,
+				 struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	int32_t ret;
+
+	while (conn->parser_idx < IIOD_BIN_HDR_SIZE) {
+		ret = desc->ops.recv(&ctx,
+				     (uint8_t *)conn->parser_buf + conn->parser_idx,
+				     IIOD_BIN_HDR_SIZE - conn->parser_idx);
+		if (ret == -EAGAIN || ret == 0)
+			return -EAGAIN;
+
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			conn->parser_idx = 0;
+			return ret;
+		}
+
+		conn->parser_idx += ret;
+	}
+	conn->parser_idx = 0;
+
+	return 0;
+}
+
+/* Read the next command. A line or a binary header */
+static int32_t iiod_read_cmd(struct iiod_desc *desc,
+			     struct iiod_conn_priv *conn)
+{
+	if (conn->binary)
+		return iiod_read_bin_hdr(desc, conn);
+
+	return iiod_read_line(desc, conn);
+}
+
+/* Fill struct comand_desc with data from the received command. No I/O */
+static int32_t iiod_parse_cmd(struct iiod_conn_priv *conn)
+{
+	if (conn->binary)
+		return iiod_parse_bin_hdr((uint8_t *)conn->parser_buf,
+					  &conn->cmd_data);
+
+	return iiod_parse_line(conn->parser_buf, &conn->cmd_data,
+			       &conn->strtok_ctx);
+}
+
+/* Write the result of a command. Non blocking */
+static int32_t iiod_write_result(struct iiod_desc *desc,
+				 struct iiod_conn_priv *conn)
+{
+	int32_t ret;
+
+	/* Write result or the length of data to be sent*/
+	if (conn->res.write_val) {
+		if (conn->nb_buf.len == 0) {
+			conn->nb_buf.buf = conn->parser_buf;
+			ret = sprintf(conn->nb_buf.buf, "%"PRIi32,
+				      conn->res.val);
+			conn->nb_buf.len = ret;
+			conn->nb_buf.idx = 0;
+		}
+		/* Non-blocking. Will enter here until val is sent */
+		if (conn->nb_buf.idx < conn->nb_buf.len) {
+			ret = rw_iiod_buff(desc, conn, &conn->nb_buf,
+					   IIOD_WR | IIOD_ENDL);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
+	}
+	/* Send buf from result. Non blocking */
+	if (conn->res.buf.buf &&
+	    conn->res.buf.idx < conn->res.buf.len) {
+		ret = rw_iiod_buff(desc, conn, &conn->res.buf,
+				   IIOD_WR | IIOD_ENDL);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	return 0;
+}
+
+/*
+ * Write the response header of a binary command followed by the result
+ * buffer. For READBUF, the data is sent after in IIOD_RW_BUF. Non blocking
+ */
+static int32_t iiod_write_bin_result(struct iiod_desc *desc,
+				     struct iiod_conn_priv *conn)
+{
+	struct comand_desc *data = &conn->cmd_data;
+	int32_t val = conn->res.val;
+	uint8_t *hdr = (uint8_t *)conn->parser_buf;
+	uint32_t len = 0;
+	int32_t ret;
+
+	if (conn->nb_buf.len == 0) {
+		if (data->cmd == IIOD_CMD_READBUF && val > 0)
+			len = val;
+		else if (conn->res.buf.buf)
+			len = conn->res.buf.len;
+		if (!conn->res.write_val)
+			val = 0;
+
+		no_os_put_unaligned_le16(data->client_id, hdr);
+		hdr[2] = IIOD_BIN_OP_RESPONSE;
+		hdr[3] = data->dev_idx;
+		no_os_put_unaligned_le32(val, hdr + 4);
+		no_os_put_unaligned_le32(len, hdr + 8);
+		conn->nb_buf.buf = conn->parser_buf;
+		conn->nb_buf.len = IIOD_BIN_HDR_SIZE;
+		conn->nb_buf.idx = 0;
+	}
+	if (conn->nb_buf.idx < conn->nb_buf.len) {
+		ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_WR);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+	if (conn->res.buf.buf &&
+	    conn->res.buf.idx < conn->res.buf.len) {
+		ret = rw_iiod_buff(desc, conn, &conn->res.buf, IIOD_WR);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	return 0;
+}
+
 /*
  * Function will return SUCCESS when a state was processed.
  * If a state is still in processing state, it will return -EAGAIN.
@@ -720,14 +1049,12 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 
 	switch (conn->state) {
 	case IIOD_READING_LINE:
-		/* Read input data until \n. I/O Calls */
-		ret = iiod_read_line(desc, conn);
+		/* Read input data until \n or a binary header. I/O Calls */
+		ret = iiod_read_cmd(desc, conn);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
-		/* Fill struct comand_desc with data from line. No I/O */
-		ret = iiod_parse_line(conn->parser_buf, &conn->cmd_data,
-				      &conn->strtok_ctx);
+		ret = iiod_parse_cmd(conn);
 		if (NO_OS_IS_ERR_VALUE(ret)) {
 			/* Parsing line failed */
 			conn->res.write_val = 1;
@@ -739,9 +1066,20 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 			conn->nb_buf.len = conn->cmd_data.bytes_count;
 			conn->nb_buf.idx = 0;
 			conn->state = IIOD_READING_WRITE_DATA;
+		} else if (conn->binary && conn->cmd_data.payload_len &&
+			   conn->cmd_data.cmd != IIOD_CMD_WRITEBUF) {
+			/* Payload of a binary command. Read before running */
+			conn->nb_buf.buf = conn->payload_buf;
+			conn->nb_buf.len = conn->cmd_data.payload_len;
+			conn->nb_buf.idx = 0;
+			conn->state = IIOD_READING_WRITE_DATA;
 		} else {
 			conn->state = IIOD_RUNNING_CMD;
 		}
+		/* The stream can't be resynchronized if payload doesn't fit */
+		if (conn->binary && conn->state == IIOD_READING_WRITE_DATA &&
+		    conn->nb_buf.len >= conn->payload_buf_len)
+			return -ENOTCONN;
 
 		return 0;
 	case IIOD_RUNNING_CMD:
@@ -754,34 +1092,30 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 
 		return 0;
 	case IIOD_WRITING_CMD_RESULT:
-		/* Write result or the length of data to be sent*/
-		if (conn->res.write_val) {
-			if (conn->nb_buf.len == 0) {
-				conn->nb_buf.buf = conn->parser_buf;
-				ret = sprintf(conn->nb_buf.buf, "%"PRIi32,
-					      conn->res.val);
-				conn->nb_buf.len = ret;
-				conn->nb_buf.idx = 0;
-			}
-			/* Non-blocking. Will enter here until val is sent */
-			if (conn->nb_buf.idx < conn->nb_buf.len) {
-				ret = rw_iiod_buff(desc, conn, &conn->nb_buf,
-						   IIOD_WR | IIOD_ENDL);
-				if (NO_OS_IS_ERR_VALUE(ret))
-					return ret;
-			}
-		}
-		/* Send buf from result. Non blocking */
-		if (conn->res.buf.buf &&
-		    conn->res.buf.idx < conn->res.buf.len) {
-			ret = rw_iiod_buff(desc, conn, &conn->res.buf,
-					   IIOD_WR | IIOD_ENDL);
-			if (NO_OS_IS_ERR_VALUE(ret))
-				return ret;
+		if (!conn->binary) {
+			ret = iiod_write_result(desc, conn);
+		} else if (conn->cmd_data.cmd == IIOD_CMD_WRITEBUF) {
+			/* Answered after push. Data can't be skipped on error */
+			if (NO_OS_IS_ERR_VALUE((int32_t)conn->res.val))
+				return -ENOTCONN;
+			ret = 0;
+		} else {
+			ret = iiod_write_bin_result(desc, conn);
 		}
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		if (conn->cmd_data.cmd == IIOD_CMD_BINARY &&
+		    !NO_OS_IS_ERR_VALUE((int32_t)conn->res.val))
+			/* Next commands are in binary format */
+			conn->binary = true;
 
-		if (conn->cmd_data.cmd != IIOD_CMD_READBUF &&
-		    conn->cmd_data.cmd != IIOD_CMD_WRITEBUF) {
+		if (conn->binary && conn->cmd_data.cmd == IIOD_CMD_READBUF &&
+		    NO_OS_IS_ERR_VALUE((int32_t)conn->res.val)) {
+			/* No data follows the response */
+			conn->state = IIOD_LINE_DONE;
+		} else if (conn->cmd_data.cmd != IIOD_CMD_READBUF &&
+			   conn->cmd_data.cmd != IIOD_CMD_WRITEBUF) {
 			if (conn->is_cyclic_buffer && conn->cmd_data.cmd != IIOD_CMD_OPEN)
 				conn->state = IIOD_PUSH_CYCLIC_BUFFER;
 			else
@@ -807,6 +1141,11 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 				if (NO_OS_IS_ERR_VALUE(ret)) {
 					conn->res.val = ret;
 					conn->state = IIOD_LINE_DONE;
+					if (conn->binary) {
+						/* Send the error */
+						conn->cmd_data.cmd = IIOD_CMD_PRINT;
+						conn->state = IIOD_WRITING_CMD_RESULT;
+					}
 
 					return 0;
 				}
@@ -825,11 +1164,12 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 
 		return 0;
 	case IIOD_READING_WRITE_DATA:
-		/* Read attribute */
+		/* Read attribute or binary payload */
 		ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_RD);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
+		conn->nb_buf.len = 0;
 		conn->state = IIOD_RUNNING_CMD;
 
 		return 0;
@@ -847,13 +1187,12 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		}
 
 		/* Read data from the client to verify whether a close command has been sent */
-		ret = iiod_read_line(desc, conn);
+		ret = iiod_read_cmd(desc, conn);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return 0;
 
 		/* Fill struct comand_desc with data from line */
-		ret = iiod_parse_line(conn->parser_buf, &conn->cmd_data,
-				      &conn->strtok_ctx);
+		ret = iiod_parse_cmd(conn);
 		if (!NO_OS_IS_ERR_VALUE(ret) && conn->cmd_data.cmd == IIOD_CMD_CLOSE) {
 			/* Exit this state only if a close command is received
 			   All other commands will be ignored.
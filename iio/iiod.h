@@ -44,7 +44,9 @@
 #include <stdbool.h>
 
 /* Maximum nomber of iiod connections to allocate simultaneously */
+#ifndef IIOD_MAX_CONNECTIONS
 #define IIOD_MAX_CONNECTIONS	10
+#endif
 #define IIOD_VERSION		"1.1.0000000"
 #define IIOD_VERSION_LEN	(sizeof(IIOD_VERSION) - 1)
 
@@ -72,6 +74,66 @@ struct iiod_attr {
 	const char *channel;
 };
 
+/* Attribute referenced by its indexes in the xml. Used by the binary protocol */
+struct iiod_attr_idx {
+	enum iio_attr_type type;
+	/* Channel index. Only for IIO_ATTR_TYPE_CH_OUT and IIO_ATTR_TYPE_CH_IN */
+	uint32_t ch;
+	/*
+	 * Attribute index in the list of the given type. For
+	 * IIO_ATTR_TYPE_DEBUG, the index after the last debug attribute
+	 * refers to direct_reg_access.
+	 */
+	uint32_t attr;
+};
+
+/*
+ * Binary protocol.
+ * Enabled for a connection by sending the "BINARY" command. If "0" is
+ * answered, all the following commands and responses on the connection are
+ * frames with a header of IIOD_BIN_HDR_SIZE bytes, optionally followed by
+ * len bytes of payload. All fields are little endian:
+ *	uint16_t client_id	- Copied in the response. Multiple commands can
+ *				  be sent without waiting for the responses,
+ *				  they are answered in order.
+ *	uint8_t op		- enum iiod_bin_op
+ *	uint8_t dev		- Device index in the xml. Triggers follow
+ *				  the devices.
+ *	int32_t code		- Command argument. Result in a response.
+ *	uint32_t len		- Payload length.
+ * Payload and code for each op:
+ *	READ_ATTR/WRITE_ATTR:	code = IIOD_BIN_ATTR_CODE(). Value of the
+ *				attribute in the response/command payload.
+ *	OPEN:			code = samples. Payload is the le32 mask
+ *				followed by le32 flags (IIOD_BIN_OPEN_CYCLIC).
+ *	READBUF:		code = bytes. Data in the response payload.
+ *	WRITEBUF:		Data in the payload. Answered after the push.
+ *	GETTRIG/SETTRIG:	Trigger id in the payload. Empty to remove it.
+ *	SET_BUFFERS_COUNT:	code = buffers count.
+ *	TIMEOUT:		code = timeout.
+ */
+#define IIOD_BIN_HDR_SIZE		12
+#define IIOD_BIN_OPEN_CYCLIC		0x1
+#define IIOD_BIN_ATTR_CODE(type, ch, attr) \
+	((((type) & 0xFF) << 24) | (((ch) & 0xFF) << 16) | ((attr) & 0xFFFF))
+
+enum iiod_bin_op {
+	IIOD_BIN_OP_EXIT = 1,
+	IIOD_BIN_OP_PRINT,
+	IIOD_BIN_OP_VERSION,
+	IIOD_BIN_OP_TIMEOUT,
+	IIOD_BIN_OP_OPEN,
+	IIOD_BIN_OP_CLOSE,
+	IIOD_BIN_OP_READ_ATTR,
+	IIOD_BIN_OP_WRITE_ATTR,
+	IIOD_BIN_OP_READBUF,
+	IIOD_BIN_OP_WRITEBUF,
+	IIOD_BIN_OP_GETTRIG,
+	IIOD_BIN_OP_SETTRIG,
+	IIOD_BIN_OP_SET_BUFFERS_COUNT,
+	IIOD_BIN_OP_RESPONSE = 0xFF
+};
+
 struct iiod_ctx {
 	/* Value specified in iiod_init_param.instance in iiod_init */
 	void *instance;
@@ -112,7 +174,10 @@ struct iiod_ops {
 	 */
 	int (*open)(struct iiod_ctx *ctx, const char *device, uint32_t samples,
 		    uint32_t mask, bool cyclic);
-	/* Equivalent of iio_buffer_destroy */
+	/*
+	 * Equivalent of iio_buffer_destroy. -EAGAIN can be returned while the
+	 * buffer is still in use, close is then called again.
+	 */
 	int (*close)(struct iiod_ctx *ctx, const char *device);
 
 	/* Read data from opened buffer */
@@ -120,6 +185,33 @@ struct iiod_ops {
 			   uint32_t bytes);
 	/* Called to notify that buffer must be refiiled */
 	int (*refill_buffer)(struct iiod_ctx *ctx, const char *device);
+	/*
+	 * Optional zero-copy alternative of read_buffer.
+	 * buf is set to a contiguous region of the opened buffer holding
+	 * at maximum bytes of data and the number of available bytes is
+	 * returned. The region is sent directly on the connection and must be
+	 * valid until read_buffer_done is called.
+	 * If not set (or read_buffer_done is not set), read_buffer is used.
+	 */
+	int (*get_read_buffer)(struct iiod_ctx *ctx, const char *device,
+			       char **buf, uint32_t bytes);
+	/* Release the region returned by get_read_buffer */
+	int (*read_buffer_done)(struct iiod_ctx *ctx, const char *device);
+	/*
+	 * Optional. Send part of the region returned by get_read_buffer by
+	 * reference instead of with send. Same return values as send.
+	 * The connection keeps using the region after the call, so
+	 * read_buffer_done is called only once read_buffer_sent returns 0.
+	 * Only used together with get_read_buffer and read_buffer_sent.
+	 */
+	int (*send_read_buffer)(struct iiod_ctx *ctx, const char *device,
+				uint8_t *buf, uint32_t len);
+	/*
+	 * Return 0 once read_buffer_done can be called for the region,
+	 * -EAGAIN before. The data sent by reference may still be in use
+	 * after read_buffer_done, so close has to wait until it is released.
+	 */
+	int (*read_buffer_sent)(struct iiod_ctx *ctx, const char *device);
 
 	/* Write data to opened buffer */
 	int (*write_buffer)(struct iiod_ctx *ctx, const char *device,
@@ -146,6 +238,24 @@ struct iiod_ops {
 	int (*set_trigger)(struct iiod_ctx *ctx, const char *device,
 			   const char *trigger, uint32_t len);
 
+	/*
+	 * Optional. Needed by the binary protocol.
+	 * Return the id of the device (or trigger) with index dev in the xml,
+	 * as passed to the other ops. NULL if it doesn't exist.
+	 */
+	const char *(*get_dev_id)(struct iiod_ctx *ctx, uint32_t dev);
+	/*
+	 * Optional. Needed by the binary protocol.
+	 * Simular with read_attr and write_attr but the attribute is
+	 * referenced by indexes, no lookup by name is needed.
+	 */
+	int (*read_attr_by_idx)(struct iiod_ctx *ctx, uint32_t dev,
+				struct iiod_attr_idx *attr, char *buf,
+				uint32_t len);
+	int (*write_attr_by_idx)(struct iiod_ctx *ctx, uint32_t dev,
+				 struct iiod_attr_idx *attr, char *buf,
+				 uint32_t len);
+
 	/* I don't know what this should be used for :) */
 	int (*set_timeout)(struct iiod_ctx *ctx, uint32_t timeout);
 
@@ -43,6 +43,7 @@
 #define IIOD_WR				0x1
 #define IIOD_ENDL			0x2
 #define IIOD_RD				0x4
+#define IIOD_REF			0x8
 #define IIOD_PARSER_MAX_BUF_SIZE	128
 
 #define IIOD_STR(cmd) {(cmd), sizeof(cmd) - 1}
@@ -75,7 +76,9 @@ enum iiod_cmd {
 	IIOD_CMD_WRITEBUF,
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	/* Switch the connection to the binary protocol */
+	IIOD_CMD_BINARY
 };
 
 /*
@@ -95,6 +98,11 @@ struct comand_desc {
 	char attr[MAX_ATTR_NAME];
 	char trigger[MAX_TRIG_ID];
 	enum iio_attr_type type;
+	/* Binary protocol fields */
+	uint16_t client_id;
+	uint32_t dev_idx;
+	uint32_t payload_len;
+	struct iiod_attr_idx attr_idx;
 };
 
 /* Used to store buffer indexes for non blocking transfers */
@@ -161,6 +169,8 @@ struct iiod_conn_priv {
 	char *strtok_ctx;
 	/* True if the device was open with cyclic buffer flag */
 	bool is_cyclic_buffer;
+	/* True if the connection uses the binary protocol */
+	bool binary;
 };
 
 /* Private iiod information */
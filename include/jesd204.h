@@ -235,6 +235,32 @@ struct jesd204_dev_data {
 /* no-OS specific */
 #define JESD204_MAX_TOPOLOGY_LINKS	16
 
+/* no-OS specific */
+#ifndef JESD204_FSM_DEFER_RETRIES
+#define JESD204_FSM_DEFER_RETRIES	100
+#endif
+
+/* no-OS specific */
+#ifndef JESD204_FSM_DEFER_DELAY_MS
+#define JESD204_FSM_DEFER_DELAY_MS	1
+#endif
+
+/* no-OS specific */
+/**
+ * @struct jesd204_fsm_op_stats
+ * @brief Profiling data of a state transition, of the last initialization run
+ * @param time_us:	time spent in the transition (per device: in its ops)
+ * @param spi_xfers:	number of SPI messages sent during the transition
+ * @param calls:	number of op calls (per topology: number of passes)
+ * @param defers:	number of times an op returned JESD204_STATE_CHANGE_DEFER
+ */
+struct jesd204_fsm_op_stats {
+	uint32_t	time_us;
+	uint32_t	spi_xfers;
+	uint16_t	calls;
+	uint16_t	defers;
+};
+
 /* no-OS specific */
 struct jesd204_topology_dev {
 	struct jesd204_dev	*jdev;
@@ -249,6 +275,7 @@ struct jesd204_topology {
 	struct jesd204_dev_top		*dev_top;
 	struct jesd204_topology_dev	*devs;
 	unsigned int			devs_number;
+	struct jesd204_fsm_op_stats	op_stats[__JESD204_MAX_OPS];
 };
 
 /* no-OS specific */
@@ -269,9 +296,23 @@ int jesd204_topology_remove(struct jesd204_topology *topology);
 /* no-OS specific */
 int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx);
 
+/* no-OS specific */
+int jesd204_fsm_start_from(struct jesd204_topology *topology,
+			   unsigned int link_idx, enum jesd204_dev_op op);
+
+/* no-OS specific */
+int jesd204_fsm_resume(struct jesd204_topology *topology, unsigned int link_idx);
+
 /* no-OS specific */
 int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx);
 
+/* no-OS specific */
+int jesd204_fsm_get_op_stats(struct jesd204_dev *jdev, enum jesd204_dev_op op,
+			     struct jesd204_fsm_op_stats *stats);
+
+/* no-OS specific */
+void jesd204_fsm_print_stats(struct jesd204_topology *topology);
+
 void *jesd204_dev_priv(struct jesd204_dev *jdev);
 
 int jesd204_link_get_lmfc_lemc_rate(struct jesd204_link *lnk,
@@ -41,6 +41,85 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * By default the functions below use the C library heap. When NO_OS_ALLOC_POOL
+ * is defined, memory comes from a static heap of NO_OS_ALLOC_HEAP_SIZE bytes
+ * instead: each request is rounded up to a power of 2 size class and freed
+ * blocks are kept in a list per class, so allocation time is bounded and the
+ * heap can't fragment. Blocks are carved from the heap the first time their
+ * class runs out. Statistics, per call site too, are then available with
+ * no_os_alloc_get_stats() and no_os_alloc_get_site_stats(). The pool is
+ * locked with a no_os_mutex, created by no_os_alloc_init(): call it before
+ * starting threads which allocate memory.
+ */
+
+/* Alignment of the memory returned by the allocators */
+#define NO_OS_ALLOC_ALIGN	(2 * sizeof(void *))
+
+/**
+ * @struct no_os_alloc_stats
+ * @brief Statistics of the pool allocator.
+ */
+struct no_os_alloc_stats {
+	/** Size of the heap */
+	size_t heap_size;
+	/** Bytes of the heap split in blocks */
+	size_t heap_used;
+	/** Bytes requested by the allocations not yet freed */
+	size_t in_use;
+	/** Maximum value of in_use */
+	size_t high_water;
+	/** Number of successful allocations */
+	uint32_t nb_allocs;
+	/** Number of frees */
+	uint32_t nb_frees;
+	/** Number of allocations which failed */
+	uint32_t nb_failed;
+	/**
+	 * Per mille of heap_used which doesn't hold requested data (rounding
+	 * to the size class and free blocks kept by the pools).
+	 */
+	uint32_t fragmentation;
+	/** Number of call sites tracked */
+	uint32_t nb_sites;
+};
+
+/**
+ * @struct no_os_alloc_site_stats
+ * @brief Statistics of the allocations done from one place in the code.
+ */
+struct no_os_alloc_site_stats {
+	/** Return address of the call to no_os_malloc() or no_os_calloc() */
+	void *site;
+	/** Number of allocations */
+	uint32_t nb_allocs;
+	/** Bytes not yet freed */
+	size_t in_use;
+	/** Maximum value of in_use */
+	size_t high_water;
+	/** Size of the largest allocation */
+	size_t peak;
+};
+
+/**
+ * @struct no_os_arena
+ * @brief Bump allocator. Memory is only released all at once, by a reset.
+ */
+struct no_os_arena {
+	/** Start of the memory */
+	uint8_t *base;
+	/** Size of the memory */
+	size_t size;
+	/** Bytes allocated since the last reset */
+	size_t used;
+	/** Maximum value of used */
+	size_t high_water;
+};
+
+/* Create the lock of the pool allocator, before any thread is started */
+int no_os_alloc_init(void);
 
 /* Allocate memory and return a pointer to it */
 void *no_os_malloc(size_t size);
@@ -52,4 +131,20 @@ void *no_os_calloc(size_t nitems, size_t size);
  * no_os_malloc */
 void no_os_free(void *ptr);
 
+/* Get the statistics of the pool allocator */
+int no_os_alloc_get_stats(struct no_os_alloc_stats *stats);
+
+/* Get the statistics of the idx-th call site seen by the pool allocator */
+int no_os_alloc_get_site_stats(uint32_t idx,
+			       struct no_os_alloc_site_stats *stats);
+
+/* Use size bytes at mem as an arena */
+int no_os_arena_init(struct no_os_arena *arena, void *mem, size_t size);
+
+/* Allocate from an arena, NO_OS_ALLOC_ALIGN aligned */
+void *no_os_arena_alloc(struct no_os_arena *arena, size_t size);
+
+/* Release everything allocated from an arena */
+void no_os_arena_reset(struct no_os_arena *arena);
+
 #endif // _NO_OS_ALLOC_H_
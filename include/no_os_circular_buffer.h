@@ -46,20 +46,31 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/*
+ * The buffer can be used without locking by one producer (writer) and one
+ * consumer (reader), each running in its own context (thread, ISR or DMA
+ * completion callback). Each side owns its pointer and publishes its position
+ * with a release store after the data was accessed. The other side reads it
+ * with an acquire load. On overrun only the consumer moves its own pointer.
+ */
+
 /**
  * @struct no_os_cb_ptr
  * @brief Circular buffer pointer
  */
 struct no_os_cb_ptr {
-	/** Index of data in the buffer */
+	/** Index of data in the buffer. Only used by the owner of the pointer */
 	uint32_t	idx;
-	/** Counts the number of times idx exceeds the liniar buffer */
-	uint32_t	spin_count;
+	/** Published position, in bytes, modulo no_os_circular_buffer.wrap */
+	uint32_t	pos;
+	/** Write pointer only: position at the end of the region being written */
+	uint32_t	claim;
 	/** Set if async transaction is active */
 	bool		async_started;
 	/** Number of bytes to update after an async transaction is finished */
@@ -75,6 +86,13 @@ struct no_os_circular_buffer {
 	uint32_t	size;
 	/** Address of the buffer */
 	int8_t		*buff;
+	/** Positions wrap at this multiple of size */
+	uint32_t	wrap;
+	/**
+	 * Set if buff is followed by a second mapping of the same memory, so
+	 * any region of up to size bytes is contiguous.
+	 */
+	bool		mirrored;
 	/** Write pointer */
 	struct no_os_cb_ptr	write;
 	/** Read pointer */
@@ -89,6 +107,9 @@ int32_t no_os_cb_init(struct no_os_circular_buffer **desc, uint32_t size);
 /* Configure cb structure with given parameters without memory allocation */
 int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buf,
 		     uint32_t size);
+/* Same as no_os_cb_cfg, buf being mapped twice, back to back */
+int32_t no_os_cb_cfg_mirrored(struct no_os_circular_buffer *desc, int8_t *buf,
+			      uint32_t size);
 int32_t no_os_cb_remove(struct no_os_circular_buffer *desc);
 int32_t no_os_cb_size(struct no_os_circular_buffer *desc, uint32_t *size);
 
@@ -43,6 +43,16 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/** Forward rate changes the clock cannot do by itself to its parent. */
+#define NO_OS_CLK_SET_RATE_PARENT	NO_OS_BIT(0)
+/** Do not cache the rate, always ask the hardware. */
+#define NO_OS_CLK_GET_RATE_NOCACHE	NO_OS_BIT(1)
 
 /******************************************************************************/
 /************************* Structure Declarations *****************************/
@@ -56,6 +66,10 @@ struct no_os_clk_init_param {
 	const struct no_os_clk_platform_ops *platform_ops;
 	/**  CLK hardware device descriptor */
 	void		*dev_desc;
+	/** Parent clock, NULL for a root clock */
+	struct no_os_clk_desc *parent;
+	/** NO_OS_CLK_* flags */
+	uint32_t	flags;
 };
 
 struct no_os_clk_hw {
@@ -71,7 +85,7 @@ struct no_os_clk {
 	struct no_os_clk_hw	*hw;
 	uint32_t	hw_ch_num;
 	const char	*name;
-	const struct no_os_clk_desc *clk_desc;
+	struct no_os_clk_desc *clk_desc;
 };
 
 /**
@@ -87,15 +101,42 @@ typedef struct no_os_clk_desc {
 	const struct no_os_clk_platform_ops *platform_ops;
 	/**  CLK hardware device descriptor */
 	void		*dev_desc;
+	/** Parent clock, NULL for a root clock */
+	struct no_os_clk_desc	*parent;
+	/** First child clock */
+	struct no_os_clk_desc	*children;
+	/** Next clock sharing the same parent */
+	struct no_os_clk_desc	*sibling;
+	/** NO_OS_CLK_* flags */
+	uint32_t	flags;
+	/** Number of no_os_clk_enable() calls not yet balanced by a disable */
+	uint32_t	enable_count;
+	/** Cached rate, valid while rate_valid is set */
+	uint64_t	rate;
+	/** The cached rate matches the hardware */
+	bool		rate_valid;
 } no_os_clk_desc;
 
+/**
+ * @struct no_os_clk_rate_request
+ * @brief Rate negotiated by no_os_clk_round_rate() before any hardware
+ * access.
+ */
+struct no_os_clk_rate_request {
+	/** Requested rate on input, achievable rate on output */
+	uint64_t	rate;
+	/** Parent rate to assume on input, preferred parent rate on output */
+	uint64_t	parent_rate;
+};
+
 /**
  * @struct no_os_clk_platform_ops
  * @brief Structure holding CLK function pointers that point to the platform
  * specific function
  */
 struct no_os_clk_platform_ops {
-	/** Initialize CLK function pointer. */
+	/** Initialize CLK function pointer. The descriptor is returned zeroed,
+	 * except for the NO_OS_CLK_* flags the clock always needs. */
 	int (*init)(struct no_os_clk_desc **, const struct no_os_clk_init_param *);
 	/** Start CLK function pointer. */
 	int (*clk_enable)(struct no_os_clk_desc *);
@@ -107,6 +148,10 @@ struct no_os_clk_platform_ops {
 	int (*clk_round_rate)(struct no_os_clk_desc *, uint64_t, uint64_t *);
 	/* Change CLK frequency function pointer. */
 	int (*clk_set_rate)(struct no_os_clk_desc *, uint64_t);
+	/* Negotiate the rate and the parent rate, takes precedence over
+	 * clk_round_rate. */
+	int (*clk_determine_rate)(struct no_os_clk_desc *,
+				  struct no_os_clk_rate_request *);
 	/** CLK remove function pointer */
 	int (*remove)(struct no_os_clk_desc *);
 };
@@ -141,4 +186,21 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 int32_t no_os_clk_set_rate(struct no_os_clk_desc *desc,
 			   uint64_t rate);
 
+/* Check if the clock was enabled through no_os_clk_enable(). */
+bool no_os_clk_is_enabled(struct no_os_clk_desc *desc);
+
+/* Get the parent of the clock. */
+struct no_os_clk_desc *no_os_clk_get_parent(struct no_os_clk_desc *desc);
+
+/* Move the clock under a new parent. */
+int32_t no_os_clk_set_parent(struct no_os_clk_desc *desc,
+			     struct no_os_clk_desc *parent);
+
+/* Get the current frequency of the parent clock. */
+int32_t no_os_clk_get_parent_rate(struct no_os_clk_desc *desc,
+				  uint64_t *rate);
+
+/* Get the number of clock operations that reached the hardware. */
+uint32_t no_os_clk_get_hw_op_count(void);
+
 #endif // _NO_OS_CLK_H_
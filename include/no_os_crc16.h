@@ -41,12 +41,28 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "no_os_crc_table.h"
 
 #define NO_OS_CRC16_TABLE_SIZE 256
 
 #define NO_OS_DECLARE_CRC16_TABLE(_table) \
 	static uint16_t _table[NO_OS_CRC16_TABLE_SIZE]
 
+/* Advance a msb-first CRC-16 register by one bit. */
+#define NO_OS_CRC16_STEP(_crc, _poly) \
+	((((_crc) << 1) ^ (((_crc) & 0x8000) ? (_poly) : 0)) & 0xFFFF)
+
+/*
+ * Define a constant CRC-16 lookup table for the msb-first polynomial _poly.
+ * The table is computed at compile time, no_os_crc16_populate_msb() is not
+ * needed.
+ */
+#define NO_OS_DEFINE_CRC16_TABLE(_table, _poly) \
+	NO_OS_CRC_TABLE_BITS(_table, NO_OS_CRC16_STEP, (_poly), 0x8000); \
+	static const uint16_t _table[NO_OS_CRC16_TABLE_SIZE] = { \
+		NO_OS_CRC_TABLE_INIT(_table) \
+	}
+
 void no_os_crc16_populate_msb(uint16_t * table, const uint16_t polynomial);
 uint16_t no_os_crc16(const uint16_t * table, const uint8_t *pdata,
 		     size_t nbytes,
@@ -41,12 +41,28 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "no_os_crc_table.h"
 
 #define NO_OS_CRC24_TABLE_SIZE 256
 
 #define NO_OS_DECLARE_CRC24_TABLE(_table) \
 	static uint32_t _table[NO_OS_CRC24_TABLE_SIZE]
 
+/* Advance a msb-first CRC-24 register by one bit. */
+#define NO_OS_CRC24_STEP(_crc, _poly) \
+	((((_crc) << 1) ^ (((_crc) & 0x800000) ? (_poly) : 0)) & 0xFFFFFF)
+
+/*
+ * Define a constant CRC-24 lookup table for the msb-first polynomial _poly.
+ * The table is computed at compile time, no_os_crc24_populate_msb() is not
+ * needed.
+ */
+#define NO_OS_DEFINE_CRC24_TABLE(_table, _poly) \
+	NO_OS_CRC_TABLE_BITS(_table, NO_OS_CRC24_STEP, (_poly), 0x800000); \
+	static const uint32_t _table[NO_OS_CRC24_TABLE_SIZE] = { \
+		NO_OS_CRC_TABLE_INIT(_table) \
+	}
+
 void no_os_crc24_populate_msb(uint32_t * table, const uint32_t polynomial);
 uint32_t no_os_crc24(const uint32_t * table, const uint8_t *pdata,
 		     size_t nbytes,
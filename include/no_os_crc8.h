@@ -41,12 +41,28 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "no_os_crc_table.h"
 
 #define NO_OS_CRC8_TABLE_SIZE 256
 
 #define NO_OS_DECLARE_CRC8_TABLE(_table) \
 	static uint8_t _table[NO_OS_CRC8_TABLE_SIZE]
 
+/* Advance a msb-first CRC-8 register by one bit. */
+#define NO_OS_CRC8_STEP(_crc, _poly) \
+	((((_crc) << 1) ^ (((_crc) & 0x80) ? (_poly) : 0)) & 0xFF)
+
+/*
+ * Define a constant CRC-8 lookup table for the msb-first polynomial _poly.
+ * The table is computed at compile time, no_os_crc8_populate_msb() is not
+ * needed.
+ */
+#define NO_OS_DEFINE_CRC8_TABLE(_table, _poly) \
+	NO_OS_CRC_TABLE_BITS(_table, NO_OS_CRC8_STEP, (_poly), 0x80); \
+	static const uint8_t _table[NO_OS_CRC8_TABLE_SIZE] = { \
+		NO_OS_CRC_TABLE_INIT(_table) \
+	}
+
 void no_os_crc8_populate_msb(uint8_t * table, const uint8_t polynomial);
 uint8_t no_os_crc8(const uint8_t * table, const uint8_t *pdata, size_t nbytes,
 		   uint8_t crc);
@@ -0,0 +1,99 @@
+/***************************************************************************//**
+ *   @file   no_os_crc_table.h
+ *   @brief  Compile-time generation of the CRC lookup tables.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_CRC_TABLE_H_
+#define _NO_OS_CRC_TABLE_H_
+
+/*
+ * The CRC of a single byte is linear in the value of the byte, so entry n of
+ * a msb-first lookup table is the XOR of the entries of the bits set in n.
+ * The eight single bit entries are computed once, as enumeration constants
+ * named _table_b0 ... _table_b7, by the NO_OS_DEFINE_CRCx_TABLE macros and the
+ * table initializer below only combines them. This keeps the tables constant
+ * (they can be placed in flash) and removes the populate call at runtime.
+ */
+#define NO_OS_CRC_TABLE_ENTRY(_table, _n)			\
+	((((_n) & 0x01) ? _table##_b0 : 0) ^			\
+	 (((_n) & 0x02) ? _table##_b1 : 0) ^			\
+	 (((_n) & 0x04) ? _table##_b2 : 0) ^			\
+	 (((_n) & 0x08) ? _table##_b3 : 0) ^			\
+	 (((_n) & 0x10) ? _table##_b4 : 0) ^			\
+	 (((_n) & 0x20) ? _table##_b5 : 0) ^			\
+	 (((_n) & 0x40) ? _table##_b6 : 0) ^			\
+	 (((_n) & 0x80) ? _table##_b7 : 0))
+
+#define _NO_OS_CRC_TABLE_4(_table, _n)				\
+	NO_OS_CRC_TABLE_ENTRY(_table, (_n)),			\
+	NO_OS_CRC_TABLE_ENTRY(_table, (_n) + 1),		\
+	NO_OS_CRC_TABLE_ENTRY(_table, (_n) + 2),		\
+	NO_OS_CRC_TABLE_ENTRY(_table, (_n) + 3)
+#define _NO_OS_CRC_TABLE_16(_table, _n)				\
+	_NO_OS_CRC_TABLE_4(_table, (_n)),			\
+	_NO_OS_CRC_TABLE_4(_table, (_n) + 4),			\
+	_NO_OS_CRC_TABLE_4(_table, (_n) + 8),			\
+	_NO_OS_CRC_TABLE_4(_table, (_n) + 12)
+#define _NO_OS_CRC_TABLE_64(_table, _n)				\
+	_NO_OS_CRC_TABLE_16(_table, (_n)),			\
+	_NO_OS_CRC_TABLE_16(_table, (_n) + 16),			\
+	_NO_OS_CRC_TABLE_16(_table, (_n) + 32),			\
+	_NO_OS_CRC_TABLE_16(_table, (_n) + 48)
+
+/* Initializer of the 256 entries of a table. */
+#define NO_OS_CRC_TABLE_INIT(_table)				\
+	_NO_OS_CRC_TABLE_64(_table, 0),				\
+	_NO_OS_CRC_TABLE_64(_table, 64),			\
+	_NO_OS_CRC_TABLE_64(_table, 128),			\
+	_NO_OS_CRC_TABLE_64(_table, 192)
+
+/*
+ * Single bit entries of a table. _step advances the CRC register by one bit
+ * and _msb is the most significant bit of the register, so entry 1 (bit 0)
+ * is the polynomial itself.
+ */
+#define NO_OS_CRC_TABLE_BITS(_table, _step, _poly, _msb)	\
+	enum {							\
+		_table##_b0 = _step(_msb, _poly),		\
+		_table##_b1 = _step(_table##_b0, _poly),	\
+		_table##_b2 = _step(_table##_b1, _poly),	\
+		_table##_b3 = _step(_table##_b2, _poly),	\
+		_table##_b4 = _step(_table##_b3, _poly),	\
+		_table##_b5 = _step(_table##_b4, _poly),	\
+		_table##_b6 = _step(_table##_b5, _poly),	\
+		_table##_b7 = _step(_table##_b6, _poly),	\
+	}
+
+#endif // _NO_OS_CRC_TABLE_H_
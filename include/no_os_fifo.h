@@ -44,6 +44,7 @@
 /******************************************************************************/
 
 #include <stdint.h>
+#include "no_os_ilist.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -54,23 +55,54 @@
  * @brief Structure holding the fifo element parameters.
  */
 struct no_os_fifo_element {
-	/** next FIFO element */
-	struct no_os_fifo_element *next;
+	/** Link in the fifo or in the list of free elements */
+	struct no_os_ilist_node node;
 	/** FIFO data pointer */
 	char *data;
 	/** FIFO length */
 	uint32_t len;
 };
 
+/**
+ * @struct no_os_fifo
+ * @brief FIFO of data buffers.
+ *
+ * The elements are allocated together with their data buffer and are reused
+ * after being released, so once the fifo holds as many elements as it ever
+ * needs, inserting and releasing don't allocate memory anymore.
+ */
+struct no_os_fifo {
+	/** Elements holding data, in insertion order */
+	struct no_os_ilist elements;
+	/** Released elements, ready to be reused */
+	struct no_os_ilist free;
+	/** Size of the data buffer of each element */
+	uint32_t element_size;
+	/** Number of allocated elements */
+	uint32_t nb_elements;
+	/** Maximum number of allocated elements, 0 for no limit */
+	uint32_t max_elements;
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
 
+/* Allocate the fifo and preallocate nb_elements elements. */
+int32_t no_os_fifo_init(struct no_os_fifo **fifo, uint32_t element_size,
+			uint32_t nb_elements, uint32_t max_elements);
+
+/* Free the fifo and all its elements. */
+int32_t no_os_fifo_remove(struct no_os_fifo *fifo);
+
 /* Insert element to fifo tail. */
-int32_t no_os_fifo_insert(struct no_os_fifo_element **p_fifo, char *buff,
+int32_t no_os_fifo_insert(struct no_os_fifo *fifo, const char *buff,
 			  uint32_t len);
 
-/* Remove fifo head. */
-struct no_os_fifo_element *no_os_fifo_remove(struct no_os_fifo_element *p_fifo);
+/* Get fifo head, without removing it. */
+struct no_os_fifo_element *no_os_fifo_read(struct no_os_fifo *fifo);
+
+/* Remove fifo head, its element is kept for reuse. */
+void no_os_fifo_release(struct no_os_fifo *fifo);
 
 #endif // _NO_OS_FIFO_H_
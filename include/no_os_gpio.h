@@ -149,6 +149,12 @@ struct no_os_gpio_platform_ops {
 	int32_t (*gpio_ops_set_value)(struct no_os_gpio_desc *, uint8_t);
 	/** gpio get value function pointer */
 	int32_t (*gpio_ops_get_value)(struct no_os_gpio_desc *, uint8_t *);
+	/** gpio set multiple values function pointer (optional) */
+	int32_t (*gpio_ops_set_values)(struct no_os_gpio_desc **, uint8_t,
+				       const uint8_t *);
+	/** gpio get multiple values function pointer (optional) */
+	int32_t (*gpio_ops_get_values)(struct no_os_gpio_desc **, uint8_t,
+				       uint8_t *);
 };
 
 /******************************************************************************/
@@ -185,4 +191,12 @@ int32_t no_os_gpio_set_value(struct no_os_gpio_desc *desc,
 int32_t no_os_gpio_get_value(struct no_os_gpio_desc *desc,
 			     uint8_t *value);
 
+/* Set the values of several GPIOs. */
+int32_t no_os_gpio_set_values(struct no_os_gpio_desc **desc,
+			      uint8_t nb_gpios, const uint8_t *values);
+
+/* Get the values of several GPIOs. */
+int32_t no_os_gpio_get_values(struct no_os_gpio_desc **desc,
+			      uint8_t nb_gpios, uint8_t *values);
+
 #endif // _NO_OS_GPIO_H_
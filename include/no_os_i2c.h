@@ -52,10 +52,28 @@
 
 #define I2C_MAX_BUS_NUMBER 4
 
+/* The message of a no_os_i2c_transfer() is a read. */
+#define NO_OS_I2C_M_RD		0x01
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
 
+/**
+ * @struct no_os_i2c_msg
+ * @brief Message of a combined transfer. The messages of a transfer are
+ * separated by repeated START conditions, the STOP is generated after the
+ * last one.
+ */
+struct no_os_i2c_msg {
+	/** Data to write, or buffer where the read data is stored */
+	uint8_t		*buff;
+	/** Number of bytes */
+	uint32_t	bytes_number;
+	/** NO_OS_I2C_M_RD for a read, 0 for a write */
+	uint8_t		flags;
+};
+
 /**
  * @struct no_os_i2c_platform_ops
  * @brief Structure holding I2C function pointers that point to the platform
@@ -132,6 +150,9 @@ struct no_os_i2c_platform_ops {
 	int32_t (*i2c_ops_write)(struct no_os_i2c_desc *, uint8_t *, uint8_t, uint8_t);
 	/** i2c write function pointer */
 	int32_t (*i2c_ops_read)(struct no_os_i2c_desc *, uint8_t *, uint8_t, uint8_t);
+	/** i2c combined transfer function pointer (optional) */
+	int32_t (*i2c_ops_transfer)(struct no_os_i2c_desc *, struct no_os_i2c_msg *,
+				    uint32_t);
 	/** i2c remove function pointer */
 	int32_t (*i2c_ops_remove)(struct no_os_i2c_desc *);
 };
@@ -159,6 +180,11 @@ int32_t no_os_i2c_read(struct no_os_i2c_desc *desc,
 		       uint8_t bytes_number,
 		       uint8_t stop_bit);
 
+/* Send messages separated by repeated START conditions. */
+int32_t no_os_i2c_transfer(struct no_os_i2c_desc *desc,
+			   struct no_os_i2c_msg *msgs,
+			   uint32_t nb_msgs);
+
 /* Initialize I2C bus descriptor*/
 int32_t no_os_i2cbus_init(const struct no_os_i2c_init_param *param);
 
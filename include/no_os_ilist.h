@@ -0,0 +1,375 @@
+/***************************************************************************//**
+ *   @file   no_os_ilist.h
+ *   @brief  Intrusive list and lock-free queue header
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_ILIST_H_
+#define _NO_OS_ILIST_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_util.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/*
+ * Unlike no_os_list, which allocates an element for each inserted pointer,
+ * these lists link a no_os_ilist_node embedded in the user structure, so no
+ * operation allocates memory and all of them, except no_os_ilist_count, are
+ * O(1). A node can be part of a single list or queue at a time.
+ *
+ *	struct my_msg {
+ *		uint32_t id;
+ *		struct no_os_ilist_node node;
+ *	};
+ *
+ *	NO_OS_ILIST(rx);
+ *	struct my_msg *msg;
+ *
+ *	no_os_ilist_add_last(&rx, &m1.node);
+ *	no_os_ilist_add_last(&rx, &m2.node);
+ *	no_os_ilist_for_each_entry(msg, &rx, node)
+ *		printf("%d\n", msg->id);
+ *	msg = no_os_ilist_get_first_entry(&rx, struct my_msg, node);
+ *
+ * A queue (FIFO) uses no_os_ilist_add_last and no_os_ilist_get_first, a stack
+ * (LIFO) uses no_os_ilist_add_first and no_os_ilist_get_first.
+ * The lists are not thread safe. For passing nodes from interrupts or from
+ * other threads to a single consumer, use no_os_mpsc_queue.
+ */
+
+/**
+ * @struct no_os_ilist_node
+ * @brief Link embedded in the structures stored in a list
+ */
+struct no_os_ilist_node {
+	/** Next node */
+	struct no_os_ilist_node *next;
+	/** Previous node, not used by no_os_mpsc_queue */
+	struct no_os_ilist_node *prev;
+};
+
+/**
+ * @struct no_os_ilist
+ * @brief Circular double linked list with a sentinel node
+ */
+struct no_os_ilist {
+	/** Sentinel: head.next is the first node and head.prev the last one */
+	struct no_os_ilist_node head;
+};
+
+/**
+ * @struct no_os_mpsc_queue
+ * @brief Lock-free multiple producer, single consumer intrusive queue
+ *
+ * no_os_mpsc_queue_push may be called concurrently from any number of threads
+ * or interrupt handlers, no_os_mpsc_queue_pop only from one consumer. Push
+ * is wait-free: a single atomic exchange, which needs a target with atomic
+ * read-modify-write instructions (e.g. not ARMv6-M).
+ */
+struct no_os_mpsc_queue {
+	/** Last pushed node, updated by the producers */
+	struct no_os_ilist_node *last;
+	/** Next node to be popped, only used by the consumer */
+	struct no_os_ilist_node *first;
+	/** Placeholder node keeping the queue non-empty */
+	struct no_os_ilist_node stub;
+};
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Define and initialize an empty list. */
+#define NO_OS_ILIST(name) \
+	struct no_os_ilist name = { { &(name).head, &(name).head } }
+
+/* Get the structure containing the node. */
+#define no_os_ilist_entry(node, type, member) \
+	no_os_container_of(node, type, member)
+
+/* Get the structure containing the node or NULL if node is NULL. */
+#define no_os_ilist_entry_or_null(node, type, member) ({		\
+		struct no_os_ilist_node *_n_ = (node);			\
+		_n_ ? no_os_ilist_entry(_n_, type, member) : NULL;	\
+})
+
+#define no_os_ilist_first_entry(list, type, member) \
+	no_os_ilist_entry_or_null(no_os_ilist_first(list), type, member)
+#define no_os_ilist_last_entry(list, type, member) \
+	no_os_ilist_entry_or_null(no_os_ilist_last(list), type, member)
+#define no_os_ilist_get_first_entry(list, type, member) \
+	no_os_ilist_entry_or_null(no_os_ilist_get_first(list), type, member)
+#define no_os_ilist_get_last_entry(list, type, member) \
+	no_os_ilist_entry_or_null(no_os_ilist_get_last(list), type, member)
+#define no_os_mpsc_queue_pop_entry(queue, type, member) \
+	no_os_ilist_entry_or_null(no_os_mpsc_queue_pop(queue), type, member)
+
+/* Iterate over the nodes. The current node must not be removed. */
+#define no_os_ilist_for_each(pos, list) \
+	for ((pos) = (list)->head.next; (pos) != &(list)->head; \
+	     (pos) = (pos)->next)
+
+/* Iterate over the nodes. The current node may be removed. */
+#define no_os_ilist_for_each_safe(pos, tmp, list) \
+	for ((pos) = (list)->head.next, (tmp) = (pos)->next; \
+	     (pos) != &(list)->head; \
+	     (pos) = (tmp), (tmp) = (pos)->next)
+
+/* Iterate over the structures containing the nodes. */
+#define no_os_ilist_for_each_entry(pos, list, member) \
+	for ((pos) = no_os_ilist_entry((list)->head.next, typeof(*(pos)), \
+				       member); \
+	     &(pos)->member != &(list)->head; \
+	     (pos) = no_os_ilist_entry((pos)->member.next, typeof(*(pos)), \
+				       member))
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize an empty list.
+ * @param list - The list.
+ */
+static inline void no_os_ilist_init(struct no_os_ilist *list)
+{
+	list->head.next = &list->head;
+	list->head.prev = &list->head;
+}
+
+/**
+ * @brief Check if a list is empty.
+ * @param list - The list.
+ * @return true if the list has no nodes.
+ */
+static inline bool no_os_ilist_empty(const struct no_os_ilist *list)
+{
+	return list->head.next == &list->head;
+}
+
+/**
+ * @brief Insert a node between two adjacent nodes.
+ * @param node - Node to be inserted.
+ * @param prev - Node before the new one.
+ * @param next - Node after the new one.
+ */
+static inline void no_os_ilist_link(struct no_os_ilist_node *node,
+				    struct no_os_ilist_node *prev,
+				    struct no_os_ilist_node *next)
+{
+	node->next = next;
+	node->prev = prev;
+	prev->next = node;
+	next->prev = node;
+}
+
+/**
+ * @brief Insert a node after another one.
+ * @param pos - Node already in a list.
+ * @param node - Node to be inserted.
+ */
+static inline void no_os_ilist_insert_after(struct no_os_ilist_node *pos,
+		struct no_os_ilist_node *node)
+{
+	no_os_ilist_link(node, pos, pos->next);
+}
+
+/**
+ * @brief Insert a node before another one.
+ * @param pos - Node already in a list.
+ * @param node - Node to be inserted.
+ */
+static inline void no_os_ilist_insert_before(struct no_os_ilist_node *pos,
+		struct no_os_ilist_node *node)
+{
+	no_os_ilist_link(node, pos->prev, pos);
+}
+
+/**
+ * @brief Insert a node at the beginning of a list.
+ * @param list - The list.
+ * @param node - Node to be inserted.
+ */
+static inline void no_os_ilist_add_first(struct no_os_ilist *list,
+		struct no_os_ilist_node *node)
+{
+	no_os_ilist_insert_after(&list->head, node);
+}
+
+/**
+ * @brief Insert a node at the end of a list.
+ * @param list - The list.
+ * @param node - Node to be inserted.
+ */
+static inline void no_os_ilist_add_last(struct no_os_ilist *list,
+					struct no_os_ilist_node *node)
+{
+	no_os_ilist_insert_before(&list->head, node);
+}
+
+/**
+ * @brief Remove a node from the list it is part of.
+ * @param node - The node.
+ */
+static inline void no_os_ilist_del(struct no_os_ilist_node *node)
+{
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	node->next = NULL;
+	node->prev = NULL;
+}
+
+/**
+ * @brief Get the first node of a list, without removing it.
+ * @param list - The list.
+ * @return The first node or NULL if the list is empty.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_first(
+	const struct no_os_ilist *list)
+{
+	return no_os_ilist_empty(list) ? NULL : list->head.next;
+}
+
+/**
+ * @brief Get the last node of a list, without removing it.
+ * @param list - The list.
+ * @return The last node or NULL if the list is empty.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_last(
+	const struct no_os_ilist *list)
+{
+	return no_os_ilist_empty(list) ? NULL : list->head.prev;
+}
+
+/**
+ * @brief Get the node following another one.
+ * @param list - The list containing node.
+ * @param node - The node.
+ * @return The next node or NULL if node is the last one.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_next(
+	const struct no_os_ilist *list, const struct no_os_ilist_node *node)
+{
+	return node->next == &list->head ? NULL : node->next;
+}
+
+/**
+ * @brief Get the node preceding another one.
+ * @param list - The list containing node.
+ * @param node - The node.
+ * @return The previous node or NULL if node is the first one.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_prev(
+	const struct no_os_ilist *list, const struct no_os_ilist_node *node)
+{
+	return node->prev == &list->head ? NULL : node->prev;
+}
+
+/**
+ * @brief Remove the first node of a list.
+ * @param list - The list.
+ * @return The removed node or NULL if the list is empty.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_get_first(
+	struct no_os_ilist *list)
+{
+	struct no_os_ilist_node *node = no_os_ilist_first(list);
+
+	if (node)
+		no_os_ilist_del(node);
+
+	return node;
+}
+
+/**
+ * @brief Remove the last node of a list.
+ * @param list - The list.
+ * @return The removed node or NULL if the list is empty.
+ */
+static inline struct no_os_ilist_node *no_os_ilist_get_last(
+	struct no_os_ilist *list)
+{
+	struct no_os_ilist_node *node = no_os_ilist_last(list);
+
+	if (node)
+		no_os_ilist_del(node);
+
+	return node;
+}
+
+/**
+ * @brief Move all the nodes of a list at the end of another one.
+ * @param list - Destination list.
+ * @param other - Source list, empty on return.
+ */
+static inline void no_os_ilist_splice_last(struct no_os_ilist *list,
+		struct no_os_ilist *other)
+{
+	if (no_os_ilist_empty(other))
+		return;
+
+	other->head.next->prev = list->head.prev;
+	list->head.prev->next = other->head.next;
+	other->head.prev->next = &list->head;
+	list->head.prev = other->head.prev;
+	no_os_ilist_init(other);
+}
+
+/* Count the nodes of a list, O(n). */
+uint32_t no_os_ilist_count(const struct no_os_ilist *list);
+/* Insert a node before the first node for which cmp(node, other) < 0. */
+void no_os_ilist_add_sorted(struct no_os_ilist *list,
+			    struct no_os_ilist_node *node,
+			    int32_t (*cmp)(const struct no_os_ilist_node *node,
+					   const struct no_os_ilist_node *other));
+
+/* Initialize an empty queue. */
+void no_os_mpsc_queue_init(struct no_os_mpsc_queue *queue);
+/* Add a node at the end of the queue. Safe from any context. */
+void no_os_mpsc_queue_push(struct no_os_mpsc_queue *queue,
+			   struct no_os_ilist_node *node);
+/* Remove the first node of the queue. Only from the consumer. */
+struct no_os_ilist_node *no_os_mpsc_queue_pop(struct no_os_mpsc_queue *queue);
+/* Check if the queue is empty. Only from the consumer. */
+bool no_os_mpsc_queue_empty(struct no_os_mpsc_queue *queue);
+
+#endif // _NO_OS_ILIST_H_
@@ -1,6 +1,6 @@
 /***************************************************************************//**
  *   @file   no_os_lf256fifo.h
- *   @brief  SPSC lock-free fifo of fixed size (256), specialized for UART.
+ *   @brief  SPSC lock-free fifo of power of 2 size, specialized for UART.
  *   @author Darius Berghe (darius.berghe@analog.com)
 ********************************************************************************
  *   @copyright
@@ -45,15 +45,33 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/* Size of the fifo created by lf256fifo_init() */
+#define LF256FIFO_DEFAULT_SIZE	256
+
+/*
+ * One writer (usually an interrupt handler) and one reader may use the fifo at
+ * the same time without locking. The peek functions return the contiguous
+ * region which can be read or written in place, the matching commit function
+ * must then be called with the number of bytes actually consumed or produced.
+ */
 struct lf256fifo;
 
 int lf256fifo_init(struct lf256fifo **);
+int lf256fifo_init_size(struct lf256fifo **fifo, uint32_t size);
 bool lf256fifo_is_full(struct lf256fifo *);
 bool lf256fifo_is_empty(struct lf256fifo *);
+uint32_t lf256fifo_level(struct lf256fifo *fifo);
 int lf256fifo_read(struct lf256fifo *, uint8_t *);
 int lf256fifo_write(struct lf256fifo *, uint8_t);
+uint32_t lf256fifo_read_n(struct lf256fifo *fifo, uint8_t *buf, uint32_t n);
+uint32_t lf256fifo_write_n(struct lf256fifo *fifo, const uint8_t *buf,
+			   uint32_t n);
+uint32_t lf256fifo_peek_read(struct lf256fifo *fifo, uint8_t **buf);
+int lf256fifo_commit_read(struct lf256fifo *fifo, uint32_t n);
+uint32_t lf256fifo_peek_write(struct lf256fifo *fifo, uint8_t **buf);
+int lf256fifo_commit_write(struct lf256fifo *fifo, uint32_t n);
+uint32_t lf256fifo_get_overflows(struct lf256fifo *fifo);
 void lf256fifo_flush(struct lf256fifo *);
 void lf256fifo_remove(struct lf256fifo *fifo);
 
 #endif
-
@@ -0,0 +1,229 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap.h
+ *   @brief  Cached register map layer.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_REGMAP_H_
+#define _NO_OS_REGMAP_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_spi.h"
+#include "no_os_i2c.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Maximum size of the address and value of a SPI or I2C access */
+#define NO_OS_REGMAP_MAX_BYTES	6
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct no_os_regmap_range
+ * @brief Inclusive range of register addresses.
+ */
+struct no_os_regmap_range {
+	/** First register of the range */
+	uint32_t min;
+	/** Last register of the range */
+	uint32_t max;
+};
+
+/**
+ * @struct no_os_regmap_bus_ops
+ * @brief Access to the registers of a device. Implemented by the SPI and I2C
+ * backends, or by the driver for devices with a custom framing.
+ */
+struct no_os_regmap_bus_ops {
+	/** Read a register from the device */
+	int32_t (*reg_read)(void *ctx, uint32_t reg, uint32_t *val);
+	/** Write a register of the device */
+	int32_t (*reg_write)(void *ctx, uint32_t reg, uint32_t val);
+	/** Optional, called before no_os_regmap_sync() writes the registers */
+	int32_t (*sync_begin)(void *ctx);
+	/** Optional, called after no_os_regmap_sync() wrote the registers */
+	int32_t (*sync_end)(void *ctx);
+};
+
+/**
+ * @enum no_os_regmap_cache_type
+ * @brief Register cache implementation.
+ */
+enum no_os_regmap_cache_type {
+	/** One entry for each register, from 0 to max_register */
+	NO_OS_REGMAP_CACHE_FLAT,
+	/** No cache, every access goes to the device */
+	NO_OS_REGMAP_CACHE_NONE,
+};
+
+/**
+ * @struct no_os_regmap_config
+ * @brief Description of the register map of a device.
+ *
+ * A NULL access table means that all the registers are readable, writable or
+ * cacheable. A register is cached if it is part of cache_table and not part
+ * of volatile_table, whichever is easier to describe for the device.
+ */
+struct no_os_regmap_config {
+	/** Register address width in bits (8 or 16). SPI and I2C only */
+	uint8_t reg_bits;
+	/** Register value width in bits (8, 16, 24 or 32). SPI and I2C only */
+	uint8_t val_bits;
+	/** Set in the address of reads. SPI only */
+	uint32_t read_flag_mask;
+	/** Set in the address of writes. SPI only */
+	uint32_t write_flag_mask;
+	/** Highest register address */
+	uint32_t max_register;
+	/** Readable registers */
+	const struct no_os_regmap_range *rd_table;
+	uint32_t rd_table_len;
+	/** Writable registers */
+	const struct no_os_regmap_range *wr_table;
+	uint32_t wr_table_len;
+	/** Registers which may be cached */
+	const struct no_os_regmap_range *cache_table;
+	uint32_t cache_table_len;
+	/** Registers changed by the device, which are never cached */
+	const struct no_os_regmap_range *volatile_table;
+	uint32_t volatile_table_len;
+	/** Cache implementation */
+	enum no_os_regmap_cache_type cache_type;
+};
+
+/**
+ * @struct no_os_regmap_stats
+ * @brief Register access counters.
+ */
+struct no_os_regmap_stats {
+	/** Registers read from the device */
+	uint32_t bus_reads;
+	/** Registers written to the device */
+	uint32_t bus_writes;
+	/** Reads served from the cache */
+	uint32_t cache_hits;
+	/** Writes which did not change the cached value */
+	uint32_t skipped_writes;
+};
+
+/**
+ * @struct no_os_regmap
+ * @brief Register map descriptor.
+ */
+struct no_os_regmap {
+	/** Register map description */
+	struct no_os_regmap_config config;
+	/** Device access */
+	const struct no_os_regmap_bus_ops *ops;
+	/** Passed to ops */
+	void *ctx;
+	/** SPI descriptor of the SPI backend */
+	struct no_os_spi_desc *spi;
+	/** I2C descriptor of the I2C backend */
+	struct no_os_i2c_desc *i2c;
+	/** Cached register values */
+	uint32_t *cache;
+	/** Bitmap of the cache entries holding the register value */
+	uint32_t *valid;
+	/** Bitmap of the cache entries not written to the device yet */
+	uint32_t *dirty;
+	/** If set, writes of cacheable registers only update the cache */
+	bool cache_only;
+	/** Access counters */
+	struct no_os_regmap_stats stats;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Initialize a register map with custom device access functions. */
+int32_t no_os_regmap_init(struct no_os_regmap **map,
+			  const struct no_os_regmap_bus_ops *ops, void *ctx,
+			  const struct no_os_regmap_config *config);
+
+/* Initialize a register map of a SPI device (no_os_regmap_spi.c). */
+int32_t no_os_regmap_init_spi(struct no_os_regmap **map,
+			      struct no_os_spi_desc *spi,
+			      const struct no_os_regmap_config *config);
+
+/* Initialize a register map of an I2C device (no_os_regmap_i2c.c). */
+int32_t no_os_regmap_init_i2c(struct no_os_regmap **map,
+			      struct no_os_i2c_desc *i2c,
+			      const struct no_os_regmap_config *config);
+
+/* Free the resources allocated by no_os_regmap_init*(). */
+int32_t no_os_regmap_remove(struct no_os_regmap *map);
+
+/* Read a register. */
+int32_t no_os_regmap_read(struct no_os_regmap *map, uint32_t reg,
+			  uint32_t *val);
+
+/* Write a register. */
+int32_t no_os_regmap_write(struct no_os_regmap *map, uint32_t reg,
+			   uint32_t val);
+
+/* Update the bits of a register selected by mask. */
+int32_t no_os_regmap_update_bits(struct no_os_regmap *map, uint32_t reg,
+				 uint32_t mask, uint32_t val);
+
+/* Defer the writes of the cacheable registers until no_os_regmap_sync(). */
+void no_os_regmap_cache_only(struct no_os_regmap *map, bool enable);
+
+/* Write the dirty registers to the device. */
+int32_t no_os_regmap_sync(struct no_os_regmap *map);
+
+/* Forget the cached values, e.g. after a device reset. */
+void no_os_regmap_cache_drop(struct no_os_regmap *map);
+
+/* Check the widths of a register map accessed by the SPI or I2C backend. */
+bool no_os_regmap_valid_format(const struct no_os_regmap_config *config);
+
+/* Build the address and value bytes of a SPI or I2C access. */
+uint32_t no_os_regmap_format(struct no_os_regmap *map, uint8_t *buf,
+			     uint32_t reg, uint32_t val);
+
+/* Parse the value bytes of a SPI or I2C access. */
+uint32_t no_os_regmap_parse(struct no_os_regmap *map, uint8_t *buf);
+
+#endif // _NO_OS_REGMAP_H_
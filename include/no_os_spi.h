@@ -53,6 +53,10 @@
 #define	NO_OS_SPI_CPHA	0x01
 #define	NO_OS_SPI_CPOL	0x02
 #define SPI_MAX_BUS_NUMBER 8
+/** Maximum number of messages held by a SPI queue before it is flushed */
+#define NO_OS_SPI_QUEUE_MSGS		64
+/** Size of the buffer holding the data of the queued messages */
+#define NO_OS_SPI_QUEUE_BUFF_SIZE	1024
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -108,6 +112,30 @@ struct no_os_spi_msg {
 	uint32_t		cs_delay_last;
 };
 
+/**
+ * @struct no_os_spi_queue
+ * @brief Messages queued with no_os_spi_queue_msg() while a batch is open.
+ * They are sent with a single no_os_spi_transfer() call when the batch is
+ * closed, when the queue is full or before any other transfer on the same
+ * descriptor.
+ */
+struct no_os_spi_queue {
+	/** Queued messages */
+	struct no_os_spi_msg	msgs[NO_OS_SPI_QUEUE_MSGS];
+	/** Caller buffers where the received data is copied, may be NULL */
+	uint8_t			*rx_buffs[NO_OS_SPI_QUEUE_MSGS];
+	/** Data of the queued messages, sent and received in place */
+	uint8_t			buff[NO_OS_SPI_QUEUE_BUFF_SIZE];
+	/** Number of queued messages */
+	uint32_t		nb_msgs;
+	/** Number of used bytes of buff */
+	uint32_t		buff_len;
+	/** Number of open batches */
+	uint32_t		depth;
+	/** First flush error since the outermost batch was opened */
+	int32_t			err;
+};
+
 /**
  * @struct no_os_spi_platform_ops
  * @brief Structure holding SPI function pointers that point to the platform
@@ -182,6 +210,8 @@ struct no_os_spi_desc {
 	void		*extra;
 	/** Parent of the device */
 	struct no_os_spi_desc *parent;
+	/** Message queue, allocated by no_os_spi_batch_begin() */
+	struct no_os_spi_queue *queue;
 };
 
 /**
@@ -221,6 +251,24 @@ int32_t no_os_spi_transfer(struct no_os_spi_desc *desc,
 			   struct no_os_spi_msg *msgs,
 			   uint32_t len);
 
+/* Start queueing the messages sent with no_os_spi_queue_msg(). */
+int32_t no_os_spi_batch_begin(struct no_os_spi_desc *desc);
+
+/* Send the queued messages and stop queueing. */
+int32_t no_os_spi_batch_end(struct no_os_spi_desc *desc);
+
+/* Queue a message or send it right away if no batch is open. */
+int32_t no_os_spi_queue_msg(struct no_os_spi_desc *desc,
+			    uint8_t *data,
+			    uint8_t *rx_buff,
+			    uint16_t bytes_number);
+
+/* Send the queued messages. */
+int32_t no_os_spi_flush(struct no_os_spi_desc *desc);
+
+/* Get the number of SPI messages sent on all the buses. */
+uint32_t no_os_spi_get_xfer_count(void);
+
 /* Initialize SPI bus descriptor*/
 int32_t no_os_spibus_init(const struct no_os_spi_init_param *param);
 
@@ -120,6 +120,11 @@ struct no_os_uart_init_param {
 	uint32_t irq_id;
 	/** If set, the reception is interrupt driven. */
 	bool asynchronous_rx;
+	/**
+	 * Size of the software FIFO used for asynchronous_rx, a power of 2.
+	 * 0 for the default (LF256FIFO_DEFAULT_SIZE).
+	 */
+	uint32_t rx_fifo_size;
 	/** UART Baud Rate */
 	uint32_t        baud_rate;
 	/** UART number of data bits */
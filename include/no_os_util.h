@@ -42,6 +42,7 @@
 /******************************************************************************/
 /***************************** Include Files **********************************/
 /******************************************************************************/
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -49,6 +50,7 @@
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
 #define NO_OS_BIT(x)	(1 << (x))
+#define NO_OS_BIT_ULL(x)	(1ULL << (x))
 
 #define NO_OS_ARRAY_SIZE(x) \
 	(sizeof(x) / sizeof((x)[0]))
@@ -118,6 +120,12 @@
 
 #define no_os_align(x, align) (((x) + ((typeof(x))(align) - 1)) & ~((typeof(x))(align) - 1))
 
+/* Get the structure containing member, ptr must point to a member of type */
+#define no_os_container_of(ptr, type, member) ({			\
+		const typeof(((type *)0)->member) *_mptr_ = (ptr);	\
+		(type *)((char *)_mptr_ - offsetof(type, member));	\
+})
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
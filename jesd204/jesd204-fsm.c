@@ -4,98 +4,495 @@
  * Copyright (c) 2022 Analog Devices Inc.
  */
 
+#include <inttypes.h>
+#include <string.h>
 #include "no_os_error.h"
+#include "no_os_delay.h"
+#include "no_os_print_log.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
 #include "jesd204-priv.h"
 
+static const char *const jesd204_op_names[__JESD204_MAX_OPS] = {
+	[JESD204_OP_DEVICE_INIT] = "device_init",
+	[JESD204_OP_LINK_INIT] = "link_init",
+	[JESD204_OP_LINK_SUPPORTED] = "link_supported",
+	[JESD204_OP_LINK_PRE_SETUP] = "link_pre_setup",
+	[JESD204_OP_CLK_SYNC_STAGE1] = "clk_sync_stage1",
+	[JESD204_OP_CLK_SYNC_STAGE2] = "clk_sync_stage2",
+	[JESD204_OP_CLK_SYNC_STAGE3] = "clk_sync_stage3",
+	[JESD204_OP_LINK_SETUP] = "link_setup",
+	[JESD204_OP_OPT_SETUP_STAGE1] = "opt_setup_stage1",
+	[JESD204_OP_OPT_SETUP_STAGE2] = "opt_setup_stage2",
+	[JESD204_OP_OPT_SETUP_STAGE3] = "opt_setup_stage3",
+	[JESD204_OP_OPT_SETUP_STAGE4] = "opt_setup_stage4",
+	[JESD204_OP_OPT_SETUP_STAGE5] = "opt_setup_stage5",
+	[JESD204_OP_CLOCKS_ENABLE] = "clocks_enable",
+	[JESD204_OP_LINK_ENABLE] = "link_enable",
+	[JESD204_OP_LINK_RUNNING] = "link_running",
+	[JESD204_OP_OPT_POST_RUNNING_STAGE] = "opt_post_running_stage",
+};
+
 /* no-OS specific */
-int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+static uint32_t jesd204_fsm_elapsed_us(struct no_os_time start)
+{
+	struct no_os_time now = no_os_get_time();
+
+	return (now.s - start.s) * 1000000 + now.us - start.us;
+}
+
+/* no-OS specific */
+static void jesd204_fsm_dev_reset(struct jesd204_dev *jdev,
+				  enum jesd204_dev_op op,
+				  enum jesd204_state_op_reason reason)
+{
+	jdev->fsm_dev_done = false;
+	jdev->fsm_links_done = 0;
+	jdev->fsm_pass = 0;
+
+	if (reason == JESD204_STATE_OP_REASON_INIT)
+		memset(&jdev->op_stats[op], 0, sizeof(jdev->op_stats[op]));
+}
+
+/*
+ * no-OS specific
+ *
+ * Call the per_device op (ol == NULL) or the per_link op of a device, unless
+ * it is already done for this state or, for per_device, already called in this
+ * pass. Ops returning JESD204_STATE_CHANGE_DEFER are counted in pending and
+ * called again in the next pass.
+ */
+static int jesd204_fsm_call_op(struct jesd204_dev *jdev,
+			       enum jesd204_dev_op op,
+			       enum jesd204_state_op_reason reason,
+			       struct jesd204_link_opaque *ol,
+			       unsigned int pass, unsigned int *pending)
+{
+	const struct jesd204_state_op *state_op = &jdev->dev_data->state_ops[op];
+	struct jesd204_fsm_op_stats *stats = &jdev->op_stats[op];
+	struct no_os_time start;
+	uint32_t spi_xfers;
+	int ret;
+
+	if (ol) {
+		if (!state_op->per_link ||
+		    (jdev->fsm_links_done & NO_OS_BIT(ol->link_idx)))
+			return 0;
+	} else {
+		if (!state_op->per_device || jdev->fsm_dev_done ||
+		    jdev->fsm_pass == pass)
+			return 0;
+		jdev->fsm_pass = pass;
+	}
+
+	start = no_os_get_time();
+	spi_xfers = no_os_spi_get_xfer_count();
+
+	if (ol)
+		ret = state_op->per_link(jdev, reason, &ol->link);
+	else
+		ret = state_op->per_device(jdev, reason);
+
+	if (reason == JESD204_STATE_OP_REASON_INIT) {
+		stats->time_us += jesd204_fsm_elapsed_us(start);
+		stats->spi_xfers += no_os_spi_get_xfer_count() - spi_xfers;
+		stats->calls++;
+	}
+
+	if (ret == JESD204_STATE_CHANGE_DEFER) {
+		if (reason == JESD204_STATE_OP_REASON_INIT)
+			stats->defers++;
+		(*pending)++;
+		return 0;
+	}
+
+	if (ol)
+		jdev->fsm_links_done |= NO_OS_BIT(ol->link_idx);
+	else
+		jdev->fsm_dev_done = true;
+
+	if (ret < 0) {
+		if (ol) {
+			ol->link.error = ret;
+			pr_err("link[%" PRIu32 "], %s (%s) failed (%d)\n",
+			       ol->link.link_id, jesd204_op_names[op],
+			       jesd204_state_op_reason_str(reason), ret);
+		} else {
+			pr_err("%s (%s) failed (%d)\n", jesd204_op_names[op],
+			       jesd204_state_op_reason_str(reason), ret);
+		}
+
+		return ret;
+	}
+
+	if (jdev->is_top && state_op->post_state_sysref)
+		return jesd204_sysref_async(jdev);
+
+	return 0;
+}
+
+/* no-OS specific */
+static int jesd204_fsm_pass_init(struct jesd204_topology *topology,
+				 enum jesd204_dev_op op, uint32_t links,
+				 unsigned int pass, unsigned int *pending)
 {
 	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
 	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
-	enum jesd204_dev_op op;
+	struct jesd204_topology_dev *tdev;
+	struct jesd204_link_opaque *ol;
+	unsigned int lnk_dev;
+	unsigned int lnk_id;
+	unsigned int dev;
+	int ret;
+
+	for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
+		if (!(links & NO_OS_BIT(lnk_id)))
+			continue;
+
+		ol = &jdev_top->active_links[lnk_id];
+		for (dev = 0; dev < topology->devs_number; dev++) {
+			tdev = &topology->devs[dev];
+			for (lnk_dev = 0; lnk_dev < tdev->links_number; lnk_dev++) {
+				if (tdev->link_ids[lnk_dev] != jdev_top->link_ids[lnk_id])
+					continue;
+
+				ret = jesd204_fsm_call_op(tdev->jdev, op, reason, NULL,
+							  pass, pending);
+				if (ret)
+					return ret;
+
+				ret = jesd204_fsm_call_op(tdev->jdev, op, reason, ol,
+							  pass, pending);
+				if (ret)
+					return ret;
+			}
+		}
+
+		ret = jesd204_fsm_call_op(jdev_top->jdev, op, reason, ol, pass,
+					  pending);
+		if (ret)
+			return ret;
+	}
+
+	return jesd204_fsm_call_op(jdev_top->jdev, op, reason, NULL, pass,
+				   pending);
+}
+
+/* no-OS specific */
+static int jesd204_fsm_pass_uninit(struct jesd204_topology *topology,
+				   enum jesd204_dev_op op, uint32_t links,
+				   unsigned int pass, unsigned int *pending)
+{
+	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_UNINIT;
+	struct jesd204_dev_top *jdev_top = topology->dev_top;
+	struct jesd204_topology_dev *tdev;
+	struct jesd204_link_opaque *ol;
 	int lnk_dev;
 	int lnk_id;
 	int dev;
+	int ret;
+	int err;
 
-	for (op = 0; op < __JESD204_MAX_OPS; op++) {
-		for (dev = 0; dev < topology->devs_number; dev++)
-			per_device_op_done[dev] = false;
-
-		for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
-			for (dev = 0; dev < topology->devs_number; dev++) {
-				for (lnk_dev = 0; lnk_dev < topology->devs[dev].links_number; lnk_dev++) {
-					if (topology->devs[dev].link_ids[lnk_dev] == jdev_top->link_ids[lnk_id]) {
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_device
-						    && !per_device_op_done[dev]) {
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_device(
-								topology->devs[dev].jdev, reason);
-							per_device_op_done[dev] = true;
-						}
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_link)
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_link(
-								topology->devs[dev].jdev, reason,
-								&jdev_top->active_links[lnk_id].link);
-					}
-				}
-			}
-			if (jdev_top->jdev->dev_data->state_ops[op].per_link) {
-				jdev_top->jdev->dev_data->state_ops[op].per_link(jdev_top->jdev, reason,
-						&jdev_top->active_links[lnk_id].link);
-				if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
-					jesd204_sysref_async(jdev_top->jdev);
+	/* Keep going on errors, so that everything possible is torn down. */
+	err = jesd204_fsm_call_op(jdev_top->jdev, op, reason, NULL, pass,
+				  pending);
+
+	for (lnk_id = jdev_top->num_links - 1; lnk_id >= 0; lnk_id--) {
+		if (!(links & NO_OS_BIT(lnk_id)))
+			continue;
+
+		ol = &jdev_top->active_links[lnk_id];
+		ret = jesd204_fsm_call_op(jdev_top->jdev, op, reason, ol, pass,
+					  pending);
+		if (ret && !err)
+			err = ret;
+
+		for (dev = topology->devs_number - 1; dev >= 0; dev--) {
+			tdev = &topology->devs[dev];
+			for (lnk_dev = tdev->links_number - 1; lnk_dev >= 0; lnk_dev--) {
+				if (tdev->link_ids[lnk_dev] != jdev_top->link_ids[lnk_id])
+					continue;
+
+				ret = jesd204_fsm_call_op(tdev->jdev, op, reason, NULL,
+							  pass, pending);
+				if (ret && !err)
+					err = ret;
+
+				ret = jesd204_fsm_call_op(tdev->jdev, op, reason, ol,
+							  pass, pending);
+				if (ret && !err)
+					err = ret;
 			}
 		}
-		if (jdev_top->jdev->dev_data->state_ops[op].per_device) {
-			jdev_top->jdev->dev_data->state_ops[op].per_device(jdev_top->jdev, reason);
-			if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
-				jesd204_sysref_async(jdev_top->jdev);
+	}
+
+	return err;
+}
+
+/*
+ * no-OS specific
+ *
+ * Run one state transition on the selected links. The ops that defer are
+ * polled every JESD204_FSM_DEFER_DELAY_MS, up to JESD204_FSM_DEFER_RETRIES
+ * times, before moving on to the next state.
+ */
+static int jesd204_fsm_run_op(struct jesd204_topology *topology,
+			      enum jesd204_dev_op op,
+			      enum jesd204_state_op_reason reason,
+			      uint32_t links)
+{
+	struct jesd204_fsm_op_stats *stats = &topology->op_stats[op];
+	unsigned int pending = 0;
+	unsigned int pass = 0;
+	struct no_os_time start;
+	uint32_t spi_xfers;
+	unsigned int dev;
+	int ret;
+
+	for (dev = 0; dev < topology->devs_number; dev++)
+		jesd204_fsm_dev_reset(topology->devs[dev].jdev, op, reason);
+	jesd204_fsm_dev_reset(topology->dev_top->jdev, op, reason);
+
+	if (reason == JESD204_STATE_OP_REASON_INIT)
+		memset(stats, 0, sizeof(*stats));
+
+	start = no_os_get_time();
+	spi_xfers = no_os_spi_get_xfer_count();
+
+	do {
+		if (pass > JESD204_FSM_DEFER_RETRIES) {
+			pr_err("%s (%s) timed out, %u ops deferred\n",
+			       jesd204_op_names[op],
+			       jesd204_state_op_reason_str(reason), pending);
+			ret = -ETIMEDOUT;
+			break;
 		}
+
+		if (pass)
+			no_os_mdelay(JESD204_FSM_DEFER_DELAY_MS);
+
+		pending = 0;
+		pass++;
+
+		if (reason == JESD204_STATE_OP_REASON_INIT)
+			ret = jesd204_fsm_pass_init(topology, op, links, pass,
+						    &pending);
+		else
+			ret = jesd204_fsm_pass_uninit(topology, op, links, pass,
+						      &pending);
+
+		if (reason == JESD204_STATE_OP_REASON_INIT)
+			stats->defers += pending;
+	} while (!ret && pending);
+
+	if (reason == JESD204_STATE_OP_REASON_INIT) {
+		stats->time_us = jesd204_fsm_elapsed_us(start);
+		stats->spi_xfers = no_os_spi_get_xfer_count() - spi_xfers;
+		stats->calls = pass;
+	}
+
+	return ret;
+}
+
+/* no-OS specific */
+static int jesd204_fsm_links(struct jesd204_topology *topology,
+			     unsigned int link_idx, uint32_t *links)
+{
+	unsigned int num_links;
+
+	if (!topology || !topology->dev_top || !topology->dev_top->jdev ||
+	    !topology->dev_top->active_links)
+		return -EINVAL;
+
+	num_links = topology->dev_top->num_links;
+	if (!num_links || num_links > JESD204_MAX_LINKS)
+		return -EINVAL;
+
+	if (link_idx == JESD204_LINKS_ALL) {
+		*links = NO_OS_GENMASK(num_links - 1, 0);
+		return 0;
+	}
+
+	if (link_idx >= num_links)
+		return -EINVAL;
+
+	*links = NO_OS_BIT(link_idx);
+
+	return 0;
+}
+
+/*
+ * no-OS specific
+ *
+ * Bring the selected links up, each of them from its current state. A link
+ * moves to the next state only when all the ops of the current one are done,
+ * so on error the links stay in the failed state and can be resumed.
+ */
+static int jesd204_fsm_init_links(struct jesd204_topology *topology,
+				  uint32_t links)
+{
+	struct jesd204_link_opaque *active_links;
+	enum jesd204_dev_op op;
+	uint32_t op_links;
+	unsigned int lnk_id;
+	int ret;
+
+	active_links = topology->dev_top->active_links;
+
+	for (lnk_id = 0; lnk_id < topology->dev_top->num_links; lnk_id++)
+		if (links & NO_OS_BIT(lnk_id))
+			active_links[lnk_id].link.error = 0;
+
+	for (op = 0; op < __JESD204_MAX_OPS; op++) {
+		op_links = 0;
+		for (lnk_id = 0; lnk_id < topology->dev_top->num_links; lnk_id++)
+			if ((links & NO_OS_BIT(lnk_id)) &&
+			    active_links[lnk_id].state <= op)
+				op_links |= NO_OS_BIT(lnk_id);
+
+		if (!op_links)
+			continue;
+
+		ret = jesd204_fsm_run_op(topology, op,
+					 JESD204_STATE_OP_REASON_INIT, op_links);
+		if (ret)
+			return ret;
+
+		for (lnk_id = 0; lnk_id < topology->dev_top->num_links; lnk_id++)
+			if (op_links & NO_OS_BIT(lnk_id))
+				active_links[lnk_id].state = op + 1;
 	}
 
 	return 0;
 }
 
+/* no-OS specific */
+int jesd204_fsm_start_from(struct jesd204_topology *topology,
+			   unsigned int link_idx, enum jesd204_dev_op op)
+{
+	uint32_t links;
+	unsigned int lnk_id;
+	int ret;
+
+	if (op >= __JESD204_MAX_OPS)
+		return -EINVAL;
+
+	ret = jesd204_fsm_links(topology, link_idx, &links);
+	if (ret)
+		return ret;
+
+	for (lnk_id = 0; lnk_id < topology->dev_top->num_links; lnk_id++)
+		if (links & NO_OS_BIT(lnk_id))
+			topology->dev_top->active_links[lnk_id].state = op;
+
+	return jesd204_fsm_init_links(topology, links);
+}
+
+/* no-OS specific */
+int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+{
+	return jesd204_fsm_start_from(topology, link_idx,
+				      JESD204_OP_DEVICE_INIT);
+}
+
+/* no-OS specific */
+int jesd204_fsm_resume(struct jesd204_topology *topology, unsigned int link_idx)
+{
+	uint32_t links;
+	int ret;
+
+	ret = jesd204_fsm_links(topology, link_idx, &links);
+	if (ret)
+		return ret;
+
+	return jesd204_fsm_init_links(topology, links);
+}
+
 /* no-OS specific */
 int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
 {
-	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_UNINIT;
-	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
-	int lnk_dev;
-	int lnk_id;
-	int dev;
+	uint32_t links;
+	unsigned int lnk_id;
+	int err = 0;
+	int ret;
 	int op;
 
+	ret = jesd204_fsm_links(topology, link_idx, &links);
+	if (ret)
+		return ret;
+
 	for (op = __JESD204_MAX_OPS - 1; op >= 0; op--) {
-		for (dev = topology->devs_number - 1; dev >= 0 ; dev--)
-			per_device_op_done[dev] = false;
-
-		if (jdev_top->jdev->dev_data->state_ops[op].per_device)
-			jdev_top->jdev->dev_data->state_ops[op].per_device(jdev_top->jdev, reason);
-
-		for (lnk_id = jdev_top->num_links - 1; lnk_id >= 0; lnk_id--) {
-			if (jdev_top->jdev->dev_data->state_ops[op].per_link)
-				jdev_top->jdev->dev_data->state_ops[op].per_link(jdev_top->jdev, reason,
-						&jdev_top->active_links[lnk_id].link);
-			for (dev = topology->devs_number - 1; dev >= 0; dev--) {
-				for (lnk_dev = topology->devs[dev].links_number - 1; lnk_dev >= 0; lnk_dev--) {
-					if (topology->devs[dev].link_ids[lnk_dev] == jdev_top->link_ids[lnk_id]) {
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_device
-						    && !per_device_op_done[dev]) {
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_device(
-								topology->devs[dev].jdev, reason);
-							per_device_op_done[dev] = true;
-						}
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_link)
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_link(
-								topology->devs[dev].jdev, reason,
-								&jdev_top->active_links[lnk_id].link);
-					}
-				}
-			}
-		}
+		ret = jesd204_fsm_run_op(topology, op,
+					 JESD204_STATE_OP_REASON_UNINIT, links);
+		if (ret && !err)
+			err = ret;
 	}
 
+	for (lnk_id = 0; lnk_id < topology->dev_top->num_links; lnk_id++)
+		if (links & NO_OS_BIT(lnk_id))
+			topology->dev_top->active_links[lnk_id].state =
+				JESD204_OP_DEVICE_INIT;
+
+	return err;
+}
+
+/* no-OS specific */
+int jesd204_fsm_get_op_stats(struct jesd204_dev *jdev, enum jesd204_dev_op op,
+			     struct jesd204_fsm_op_stats *stats)
+{
+	if (!jdev || !stats || op >= __JESD204_MAX_OPS)
+		return -EINVAL;
+
+	*stats = jdev->op_stats[op];
+
 	return 0;
 }
+
+/*
+ * no-OS specific
+ *
+ * Devices are identified by their index in the topology (without the top
+ * device), dev < 0 is the top device.
+ */
+static void jesd204_fsm_print_dev_stats(struct jesd204_dev *jdev,
+					enum jesd204_dev_op op, int dev)
+{
+	struct jesd204_fsm_op_stats *stats = &jdev->op_stats[op];
+
+	if (!stats->calls)
+		return;
+
+	if (dev < 0)
+		pr_info("  top: %" PRIu32 " us, %" PRIu32 " spi, %u calls, %u defers\n",
+			stats->time_us, stats->spi_xfers, stats->calls,
+			stats->defers);
+	else
+		pr_info("  dev%d: %" PRIu32 " us, %" PRIu32 " spi, %u calls, %u defers\n",
+			dev, stats->time_us, stats->spi_xfers, stats->calls,
+			stats->defers);
+}
+
+/* no-OS specific */
+void jesd204_fsm_print_stats(struct jesd204_topology *topology)
+{
+	struct jesd204_fsm_op_stats *stats;
+	enum jesd204_dev_op op;
+	unsigned int dev;
+
+	if (!topology || !topology->dev_top || !topology->dev_top->jdev)
+		return;
+
+	for (op = 0; op < __JESD204_MAX_OPS; op++) {
+		stats = &topology->op_stats[op];
+		if (!stats->calls)
+			continue;
+
+		pr_info("%s: %" PRIu32 " us, %" PRIu32 " spi, %u passes, %u defers\n",
+			jesd204_op_names[op], stats->time_us, stats->spi_xfers,
+			stats->calls, stats->defers);
+
+		jesd204_fsm_print_dev_stats(topology->dev_top->jdev, op, -1);
+		for (dev = 0; dev < topology->devs_number; dev++)
+			jesd204_fsm_print_dev_stats(topology->devs[dev].jdev, op, dev);
+	}
+}
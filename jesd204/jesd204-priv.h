@@ -18,6 +18,11 @@
  * @is_top		true if this device is a top device in a topology of
  *			devices that make up a JESD204 link (typically the
  *			device that is the ADC, DAC, or transceiver)
+ * @fsm_dev_done	true if the per_device op of the current state is done
+ * @fsm_links_done	mask of the links whose per_link op of the current
+ *			state is done (bit index is the top device link index)
+ * @fsm_pass		last FSM pass that called the per_device op
+ * @op_stats		profiling data of each state transition
  */
 struct jesd204_dev {
 	const struct jesd204_dev_data	*dev_data;
@@ -27,6 +32,12 @@ struct jesd204_dev {
 
 	/* no-OS specific */
 	struct jesd204_topology		*topology;
+
+	/* no-OS specific */
+	bool				fsm_dev_done;
+	uint32_t			fsm_links_done;
+	unsigned int			fsm_pass;
+	struct jesd204_fsm_op_stats	op_stats[__JESD204_MAX_OPS];
 };
 
 /**
@@ -34,11 +45,15 @@ struct jesd204_dev {
  * @link		public link information
  * @jdev_top		JESD204 top level this links belongs to
  * @link_idx		Index in the array of JESD204 links in @jdev_top
+ * @state		first state transition not done yet for this link
  */
 struct jesd204_link_opaque {
 	struct jesd204_link		link;
 	struct jesd204_dev_top		*jdev_top;
 	unsigned int			link_idx;
+
+	/* no-OS specific */
+	enum jesd204_dev_op		state;
 };
 
 /**
@@ -172,8 +172,28 @@ int mqtt_noos_read(Network* net, unsigned char* buff, int len, int timeout)
 /* Implementation of mqtt_noos_write used by MQTTClient.c */
 int mqtt_noos_write(Network* net, unsigned char* buff, int len, int timeout)
 {
-	/* non blocking read is not implemented */
-	NO_OS_UNUSED_PARAM(timeout);
+	uint32_t	sent;
+	int32_t		rc;
+
+	if (!len)
+		return 0;
+
+	sent = 0;
+	do {
+		rc = socket_send(net->sock, (const void *)(buff + sent),
+				 (uint32_t)(len - sent));
+		if (rc != -EAGAIN) { //If data queued or error
+			if (NO_OS_IS_ERR_VALUE(rc))
+				return rc;
+
+			sent += rc;
+			if (sent >= len)
+				return sent;
+		}
+
+		/* Send buffer full, wait for it to be freed */
+		no_os_mdelay(1);
+	} while (--timeout > 0);
 
-	return socket_send(net->sock, (const void *)buff, (uint32_t)len);
+	return sent;
 }
@@ -59,11 +59,90 @@
 #include <netdb.h>
 #include <string.h>
 #include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define LINUX_SOCKET_MAX_EVENTS	32
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/* Epoll instance watching all the opened sockets */
+static int epoll_fd = -1;
+/* Event file descriptor used to wake up linux_socket_wait */
+static int wakeup_fd = -1;
 
 /******************************************************************************/
 /*************************** FUnctions Declarations *******************************/
 /******************************************************************************/
 
+/* Create the epoll instance on first use */
+static int32_t linux_socket_epoll_init(void)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN
+	};
+	int32_t ret;
+
+	if (epoll_fd >= 0)
+		return 0;
+
+	epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if (epoll_fd < 0)
+		return -errno;
+
+	wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (wakeup_fd < 0) {
+		ret = -errno;
+		goto close_epoll;
+	}
+
+	ev.data.fd = wakeup_fd;
+	if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &ev) < 0) {
+		ret = -errno;
+		goto close_wakeup;
+	}
+
+	return 0;
+
+close_wakeup:
+	close(wakeup_fd);
+	wakeup_fd = -1;
+close_epoll:
+	close(epoll_fd);
+	epoll_fd = -1;
+
+	return ret;
+}
+
+/*
+ * Register a socket to be reported by linux_socket_wait. Edge triggered, so
+ * a socket is reported only when its state changes.
+ * Sockets are removed from the epoll instance when they are closed.
+ */
+static int32_t linux_socket_epoll_add(int fd)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET,
+		.data.fd = fd
+	};
+	int32_t ret;
+
+	ret = linux_socket_epoll_init();
+	if (ret)
+		return ret;
+
+	if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0)
+		return -errno;
+
+	return 0;
+}
+
 /** @brief See \ref network_interface.socket_open */
 static int32_t linux_socket_open(void *desc, uint32_t *sock_id,
 				 enum socket_protocol prot, uint32_t buff_size)
@@ -79,6 +158,12 @@ static int32_t linux_socket_open(void *desc, uint32_t *sock_id,
 	flags = fcntl(*sock_id, F_GETFL);
 	fcntl(*sock_id, F_SETFL, flags | O_NONBLOCK);
 
+	err = linux_socket_epoll_add(*sock_id);
+	if (err) {
+		close(*sock_id);
+		return err;
+	}
+
 	return 0;
 }
 
@@ -137,12 +222,13 @@ static int32_t linux_socket_send(void *desc, uint32_t sock_id,
 {
 	int32_t ret;
 
-	ret = send(sock_id, data, size, 0);
+	ret = send(sock_id, data, size, MSG_NOSIGNAL);
 
 	if(ret < 0)
 		return -errno;
 
-	return size;
+	/* The socket is non blocking so only a part may have been sent */
+	return ret;
 }
 
 /** @brief See \ref network_interface.socket_recv */
@@ -253,6 +339,7 @@ static int32_t linux_socket_listen(void *desc, uint32_t sock_id,
 static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 				   uint32_t *client_socket_id)
 {
+	int nodelay = 1;
 	int32_t ret;
 
 	ret = accept4(sock_id, NULL, NULL, SOCK_NONBLOCK);
@@ -262,6 +349,88 @@ static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 
 	*client_socket_id = ret;
 
+	/*
+	 * Replies are sent in small chunks (e.g. the return code and then the
+	 * data). Don't let Nagle's algorithm delay them.
+	 */
+	ret = setsockopt(*client_socket_id, IPPROTO_TCP, TCP_NODELAY, &nodelay,
+			 sizeof(nodelay));
+	if (ret < 0) {
+		ret = -errno;
+		close(*client_socket_id);
+		return ret;
+	}
+
+	ret = linux_socket_epoll_add(*client_socket_id);
+	if (ret) {
+		close(*client_socket_id);
+		return ret;
+	}
+
+	return 0;
+}
+
+/** @brief See \ref network_interface.socket_wait */
+static int32_t linux_socket_wait(void *desc, uint32_t timeout_ms,
+				 uint32_t *sock_ids, uint32_t *nb_socks)
+{
+	struct epoll_event events[LINUX_SOCKET_MAX_EVENTS];
+	uint64_t val;
+	int32_t woken;
+	int32_t ret;
+	uint32_t i, n;
+
+	if (!sock_ids || !nb_socks || !*nb_socks)
+		return -EINVAL;
+
+	ret = linux_socket_epoll_init();
+	if (ret)
+		return ret;
+
+	ret = epoll_wait(epoll_fd, events,
+			 no_os_min(*nb_socks, LINUX_SOCKET_MAX_EVENTS),
+			 timeout_ms);
+	if (ret < 0) {
+		*nb_socks = 0;
+		if (errno == EINTR)
+			return 0;
+
+		return -errno;
+	}
+
+	n = 0;
+	woken = 0;
+	for (i = 0; i < (uint32_t)ret; i++) {
+		if (events[i].data.fd == wakeup_fd) {
+			/* Clear the counter and report the wake up */
+			if (read(wakeup_fd, &val, sizeof(val)) < 0 &&
+			    errno != EAGAIN) {
+				*nb_socks = 0;
+				return -errno;
+			}
+			woken = 1;
+			continue;
+		}
+		sock_ids[n++] = events[i].data.fd;
+	}
+	*nb_socks = n;
+
+	return woken;
+}
+
+/** @brief See \ref network_interface.socket_wakeup */
+static int32_t linux_socket_wakeup(void *desc)
+{
+	uint64_t val = 1;
+	int32_t ret;
+
+	ret = linux_socket_epoll_init();
+	if (ret)
+		return ret;
+
+	if (write(wakeup_fd, &val, sizeof(val)) < 0 && errno != EAGAIN)
+		return -errno;
+
 	return 0;
 }
 
@@ -277,7 +446,9 @@ struct network_interface linux_net = {
 	.socket_recvfrom = (int32_t (*)(void *, uint32_t, void *, uint32_t, struct socket_address* from))linux_socket_recvfrom,
 	.socket_bind = (int32_t (*)(void *, uint32_t, uint16_t))linux_socket_bind,
 	.socket_listen = (int32_t (*)(void *, uint32_t, uint32_t))linux_socket_listen,
-	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept
+	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept,
+	.socket_wait = linux_socket_wait,
+	.socket_wakeup = linux_socket_wakeup
 };
 
 #endif
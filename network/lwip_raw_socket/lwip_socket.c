@@ -126,6 +126,121 @@ static void _release_socket(struct lwip_network_desc *desc, uint32_t id)
 	sock->state = SOCKET_CLOSED;
 }
 
+/**
+ * @brief Send the data given to tcp_write() on the wire.
+ *
+ * Unless forced, the data is kept until a full window is queued or the send
+ * buffer is full, so that lwip creates full size segments. The queued data
+ * is also sent by no_os_lwip_step() and when an ACK is received.
+ * @param sock - socket to send data on.
+ * @param force - don't wait for more data.
+ * @return ERR_OK in the case of success, lwip error code otherwise
+ */
+static err_t _lwip_output(struct lwip_socket_desc *sock, bool force)
+{
+	struct tcp_pcb *pcb = sock->pcb;
+
+	if (!sock->unsent)
+		return ERR_OK;
+
+	if (!force && sock->unsent < pcb->snd_wnd &&
+	    tcp_sndbuf(pcb) >= TCP_MSS &&
+	    tcp_sndqueuelen(pcb) < TCP_SND_QUEUELEN / 2)
+		return ERR_OK;
+
+	sock->unsent = 0;
+
+	return tcp_output(pcb);
+}
+
+/**
+ * @brief Give as much data as the send buffer can hold to tcp_write().
+ * @param sock - socket to send data on.
+ * @param data - data to be sent.
+ * @param size - size of data.
+ * @param flags - TCP_WRITE_FLAG_COPY if lwip should copy the data.
+ * @return number of bytes queued, -EAGAIN if no byte could be queued, lwip
+ * error code otherwise
+ */
+static int32_t _lwip_write(struct lwip_socket_desc *sock, const void *data,
+			   uint32_t size, uint8_t flags)
+{
+	uint32_t avail;
+	err_t err;
+
+	if (!size)
+		return 0;
+
+	avail = tcp_sndbuf(sock->pcb);
+	if (avail < size) {
+		/* Partial write */
+		flags |= TCP_WRITE_FLAG_MORE;
+		size = avail;
+	}
+
+	if (size) {
+		err = tcp_write(sock->pcb, data, size, flags);
+		/* Too many segments are queued, retry once some are sent */
+		if (err == ERR_MEM)
+			size = 0;
+		else if (err != ERR_OK)
+			return err;
+	}
+
+	sock->queued += size;
+	sock->unsent += size;
+
+	/*
+	 * The send buffer is full, no point in waiting for more data. On an
+	 * output error the data stays queued and is sent again later.
+	 */
+	_lwip_output(sock, !size || (flags & TCP_WRITE_FLAG_MORE));
+
+	/*
+	 * Space is freed only when ACKs are processed by no_os_lwip_step(),
+	 * don't let the caller retry right away.
+	 */
+	if (!size)
+		return -EAGAIN;
+
+	return size;
+}
+
+/**
+ * @brief Call the sent callback of the zero-copy buffers which were
+ * acknowledged. If err is set, all the buffers are released.
+ * @param sock - socket on which the buffers were sent.
+ * @param err - 0 or the error passed to the sent callbacks.
+ */
+static void _lwip_zc_complete(struct lwip_socket_desc *sock, int32_t err)
+{
+	struct lwip_zc_buff zc;
+
+	while (sock->zc_count) {
+		zc = sock->zc[sock->zc_head];
+		if (!err && (int32_t)(sock->acked - zc.end) < 0)
+			break;
+
+		/* The callback may queue a new buffer */
+		sock->zc_head = (sock->zc_head + 1) % NO_OS_LWIP_ZC_QUEUE_LEN;
+		sock->zc_count--;
+		zc.sent(zc.ctx, zc.data, zc.len, err);
+	}
+}
+
+/**
+ * @brief Clear the send state of a socket which gets a new connection.
+ * @param sock - the socket.
+ */
+static void _lwip_reset_tx(struct lwip_socket_desc *sock)
+{
+	sock->queued = 0;
+	sock->acked = 0;
+	sock->unsent = 0;
+	sock->zc_head = 0;
+	sock->zc_count = 0;
+}
+
 /**
  * @brief Low level pbuf output function. Lwip will call this to send data
  * on the wire.
@@ -181,6 +296,7 @@ static err_t lwip_netif_init(struct netif *netif)
  */
 int32_t no_os_lwip_step(struct lwip_network_desc *desc, void *data)
 {
+	uint32_t i;
 	int ret;
 
 	sys_check_timeouts();
@@ -188,6 +304,11 @@ int32_t no_os_lwip_step(struct lwip_network_desc *desc, void *data)
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
+	/* Flush point for the data queued by the send calls */
+	for (i = 0; i < NO_OS_MAX_SOCKETS; i++)
+		if (desc->sockets[i].state == SOCKET_CONNECTED)
+			_lwip_output(&desc->sockets[i], true);
+
 	if (desc->platform_ops->step) {
 		ret = desc->platform_ops->step(desc, data);
 		if (ret)
@@ -398,9 +519,60 @@ static void lwip_err_callback(void *arg, err_t err)
 {
 	struct lwip_socket_desc *socket = arg;
 
+	/* The pcb was freed, together with the data queued on it */
+	socket->pcb = NULL;
+	if (socket->p) {
+		pbuf_free(socket->p);
+		socket->p = NULL;
+		socket->p_idx = 0;
+	}
+	_lwip_zc_complete(socket, -ECONNRESET);
+
 	socket->state = SOCKET_CLOSED;
 }
 
+/**
+ * @brief Release the lwip resources of a socket.
+ * @param sock - the socket.
+ * @return ERR_ABRT if the connection was aborted, ERR_OK otherwise
+ */
+static err_t _lwip_socket_close(struct lwip_socket_desc *sock)
+{
+	struct tcp_pcb *pcb = sock->pcb;
+	err_t err = ERR_OK;
+
+	if (sock->p) {
+		tcp_recved(pcb, sock->p->tot_len);
+		pbuf_free(sock->p);
+	}
+
+	if (pcb->state != LISTEN) {
+		tcp_recv(pcb, NULL);
+		tcp_sent(pcb, NULL);
+		tcp_err(pcb, NULL);
+	}
+
+	/*
+	 * lwip keeps sending the queued data after tcp_close(). The zero-copy
+	 * buffers may only be released once that data is dropped.
+	 */
+	if (sock->zc_count) {
+		tcp_abort(pcb);
+		err = ERR_ABRT;
+	} else {
+		tcp_close(pcb);
+	}
+	_lwip_zc_complete(sock, -ECONNABORTED);
+
+	sock->p_idx = 0;
+	sock->pcb = NULL;
+	sock->p = NULL;
+	sock->unsent = 0;
+	_release_socket(sock->desc, sock->id);
+
+	return err;
+}
+
 /**
  * @brief Close a socket connection.
  * @param desc - lwip sockets layer specific descriptor.
@@ -419,19 +591,7 @@ static int32_t lwip_socket_close(void *net, uint32_t sock_id)
 	if (!sock->pcb)
 		return 0;
 
-	if (sock->p) {
-		tcp_recved(sock->pcb, sock->p->tot_len);
-		pbuf_free(sock->p);
-	}
-
-	tcp_close(sock->pcb);
-	tcp_recv(sock->pcb, NULL);
-	tcp_err(sock->pcb, NULL);
-
-	sock->p_idx = 0;
-	sock->pcb = NULL;
-	sock->p = NULL;
-	_release_socket(desc, sock_id);
+	_lwip_socket_close(sock);
 
 	return 0;
 }
@@ -450,14 +610,8 @@ static err_t lwip_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
 	struct lwip_socket_desc *sock = arg;
 
 	/* The remote side has closed the connection. */
-	if (!p) {
-		tcp_recv(sock->pcb, NULL);
-		sock->state = SOCKET_CLOSED;
-
-		lwip_socket_close(sock->desc, sock->id);
-
-		return ERR_OK;
-	}
+	if (!p)
+		return _lwip_socket_close(sock);
 
 	if (err != ERR_OK) {
 		pbuf_free(p);
@@ -475,14 +629,33 @@ static err_t lwip_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
 }
 
 /**
- * @brief Configure the receive and error callbacks.
+ * @brief Called when sent data is acknowledged by the remote.
+ * @param arg - lwip sockets layer specific descriptor.
+ * @param tpcb - lwip TCP descriptor of the socket.
+ * @param len - number of acknowledged bytes.
+ * @return ERR_OK
+ */
+static err_t lwip_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+	struct lwip_socket_desc *sock = arg;
+
+	sock->acked += len;
+	_lwip_zc_complete(sock, 0);
+
+	return ERR_OK;
+}
+
+/**
+ * @brief Configure the receive, sent and error callbacks.
  * @param desc - lwip sockets layer specific descriptor.
  * @param err - error code.
  */
 static void lwip_config_socket(struct lwip_socket_desc *desc)
 {
+	_lwip_reset_tx(desc);
 	tcp_arg(desc->pcb, desc);
 	tcp_recv(desc->pcb, lwip_recv_callback);
+	tcp_sent(desc->pcb, lwip_sent_callback);
 	tcp_err(desc->pcb, lwip_err_callback);
 }
 
@@ -534,20 +707,21 @@ static int32_t lwip_socket_open(void *net, uint32_t *sock_id,
 
 /**
  * @brief Send a TCP packet.
+ *
+ * The data is copied and sent together with the data of the next calls,
+ * once a full window is queued or from no_os_lwip_step().
  * @param net - lwip sockets layer specific descriptor.
  * @param sock_id - index of the socket to send data to.
  * @param data - pointer to the data array.
  * @param size - size of data array.
- * @return 0 in the case of success, negative error code otherwise
+ * @return number of queued bytes in the case of success, -EAGAIN if the send
+ * buffer is full, negative error code otherwise
  */
 static int32_t lwip_socket_send(void *net, uint32_t sock_id, const void *data,
 				uint32_t size)
 {
 	struct lwip_network_desc *desc = net;
 	struct lwip_socket_desc *sock;
-	uint32_t avail;
-	uint32_t flags;
-	err_t err;
 
 	sock = _get_sock(desc, sock_id);
 	if (!sock)
@@ -556,25 +730,166 @@ static int32_t lwip_socket_send(void *net, uint32_t sock_id, const void *data,
 	if (sock->state != SOCKET_CONNECTED)
 		return -ENOTCONN;
 
-	avail = tcp_sndbuf(sock->pcb);
-	flags = TCP_WRITE_FLAG_COPY;
-	if (avail < size)
-		/* Partial write */
-		flags |= TCP_WRITE_FLAG_MORE;
+	return _lwip_write(sock, data, size, TCP_WRITE_FLAG_COPY);
+}
 
-	size = no_os_min(avail, size);
-	err = tcp_write(sock->pcb, data, size, flags);
-	if (err != ERR_OK)
-		return err;
+/**
+ * @brief Send a TCP packet without copying the data.
+ *
+ * The data must not be modified until sent is called, once the remote
+ * acknowledged it. Only the returned number of bytes is queued (and passed to
+ * sent), the rest has to be sent by another call.
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket to send data to.
+ * @param data - pointer to the data array.
+ * @param size - size of data array.
+ * @param sent - called when the queued bytes are released.
+ * @param ctx - parameter passed to sent.
+ * @return number of queued bytes in the case of success, -EAGAIN if the send
+ * buffer is full or NO_OS_LWIP_ZC_QUEUE_LEN buffers wait to be acknowledged,
+ * negative error code otherwise
+ */
+int32_t no_os_lwip_send_zc(struct lwip_network_desc *desc, uint32_t sock_id,
+			   const void *data, uint32_t size,
+			   no_os_lwip_sent_cb sent, void *ctx)
+{
+	struct lwip_socket_desc *sock;
+	struct lwip_zc_buff *zc;
+	int32_t ret;
 
-	if (!(flags & TCP_WRITE_FLAG_MORE)) {
-		/* Mark data as ready to be sent */
-		err = tcp_output(sock->pcb);
-		if (err != ERR_OK)
-			return err;
+	if (!desc || !data || !sent)
+		return -EINVAL;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (sock->state != SOCKET_CONNECTED)
+		return -ENOTCONN;
+
+	if (sock->zc_count == NO_OS_LWIP_ZC_QUEUE_LEN) {
+		_lwip_output(sock, true);
+		return -EAGAIN;
 	}
 
-	return size;
+	ret = _lwip_write(sock, data, size, 0);
+	if (ret <= 0)
+		return ret;
+
+	zc = &sock->zc[(sock->zc_head + sock->zc_count) %
+		       NO_OS_LWIP_ZC_QUEUE_LEN];
+	zc->end = sock->queued;
+	zc->data = data;
+	zc->len = ret;
+	zc->sent = sent;
+	zc->ctx = ctx;
+	sock->zc_count++;
+
+	return ret;
+}
+
+/**
+ * @brief Send the data queued on a socket, without waiting for a full window.
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket.
+ * @return 0 in the case of success, negative error code otherwise
+ */
+int32_t no_os_lwip_flush(struct lwip_network_desc *desc, uint32_t sock_id)
+{
+	struct lwip_socket_desc *sock;
+
+	if (!desc)
+		return -EINVAL;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (sock->state != SOCKET_CONNECTED)
+		return -ENOTCONN;
+
+	return _lwip_output(sock, true);
+}
+
+/**
+ * @brief Get the received data, without copying it.
+ *
+ * The data starts at offset in the first pbuf of the chain and stays valid
+ * until it is consumed with no_os_lwip_recv_consume().
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket to receive data from.
+ * @param p - the received pbuf chain, NULL if there is no data.
+ * @param offset - index of the first unread byte in p.
+ * @return number of unread bytes in the case of success, negative error code
+ * otherwise
+ */
+int32_t no_os_lwip_recv_peek(struct lwip_network_desc *desc, uint32_t sock_id,
+			     struct pbuf **p, uint32_t *offset)
+{
+	struct lwip_socket_desc *sock;
+
+	if (!desc || !p || !offset)
+		return -EINVAL;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (sock->state != SOCKET_CONNECTED)
+		return -ENOTCONN;
+
+	*p = sock->p;
+	*offset = sock->p_idx;
+	if (!sock->p)
+		return 0;
+
+	return sock->p->tot_len - sock->p_idx;
+}
+
+/**
+ * @brief Mark received data as read. The pbufs which were completely read are
+ * released and the receive window is updated.
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket to receive data from.
+ * @param len - number of bytes read.
+ * @return 0 in the case of success, negative error code otherwise
+ */
+int32_t no_os_lwip_recv_consume(struct lwip_network_desc *desc,
+				uint32_t sock_id, uint32_t len)
+{
+	struct lwip_socket_desc *sock;
+	struct pbuf *p;
+
+	if (!desc)
+		return -EINVAL;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (sock->state != SOCKET_CONNECTED)
+		return -ENOTCONN;
+
+	if (!sock->p)
+		return len ? -EINVAL : 0;
+
+	if (len > sock->p->tot_len - sock->p_idx)
+		return -EINVAL;
+
+	sock->p_idx += len;
+	while (sock->p && sock->p_idx >= sock->p->len) {
+		/* Done with the first pbuf. Cleanup and mark as read */
+		p = sock->p;
+		sock->p_idx -= p->len;
+		sock->p = p->next;
+		if (sock->p)
+			pbuf_ref(sock->p);
+
+		tcp_recved(sock->pcb, p->len);
+		pbuf_free(p);
+	}
+
+	return 0;
 }
 
 /**
@@ -583,53 +898,29 @@ static int32_t lwip_socket_send(void *net, uint32_t sock_id, const void *data,
  * @param sock_id - index of the socket to receive data from.
  * @param data - pointer to the data array.
  * @param size - size of data to be read.
- * @return 0 in the case of success, negative error code otherwise
+ * @return number of read bytes in the case of success, negative error code
+ * otherwise
  */
 static int32_t lwip_socket_recv(void *net, uint32_t sock_id, void *data,
 				uint32_t size)
 {
 	struct lwip_network_desc *desc = net;
-	struct lwip_socket_desc *socket;
-	struct pbuf *p, *old_p;
-	uint8_t *buf, *pdata;
-	uint32_t i, len;
+	uint32_t offset;
+	struct pbuf *p;
+	int32_t ret;
 
-	socket = _get_sock(desc, sock_id);
-	if (!socket)
-		return -EINVAL;
+	ret = no_os_lwip_recv_peek(desc, sock_id, &p, &offset);
+	if (ret <= 0)
+		return ret;
 
-	if (socket->state != SOCKET_CONNECTED)
-		return -ENOTCONN;
+	size = no_os_min(size, (uint32_t)ret);
+	pbuf_copy_partial(p, data, size, offset);
 
-	i = 0;
-	p = socket->p;
-	pdata = data;
-
-	/* Iterate over payloads until requested data has been read */
-	while (p && i < size) {
-		len = no_os_min(size - i, p->len - socket->p_idx);
-		buf = p->payload;
-		buf += socket->p_idx;
-		memcpy(pdata + i, buf, len);
-		i += len;
-		socket->p_idx += len;
-		if (socket->p_idx == p->len) {
-			/* Done with current p. Cleanup and mark as read */
-			old_p = p;
-			p = p->next;
-			if (p)
-				pbuf_ref(p);
-
-			if (old_p->ref > 0)
-				pbuf_free(old_p);
-
-			tcp_recved(socket->pcb, socket->p_idx);
-			socket->p_idx = 0;
-		}
-	}
-	socket->p = p;
+	ret = no_os_lwip_recv_consume(desc, sock_id, size);
+	if (ret)
+		return ret;
 
-	return i;
+	return size;
 }
 
 /**
@@ -716,6 +1007,8 @@ static err_t lwip_accept_callback(void *arg, struct tcp_pcb *new_pcb, err_t err)
 	socket->state = SOCKET_WAITING_ACCEPT;
 
 	tcp_setprio(socket->pcb, 0);
+	socket->p = NULL;
+	socket->p_idx = 0;
 	lwip_config_socket(socket);
 	tcp_nagle_disable(socket->pcb);
 
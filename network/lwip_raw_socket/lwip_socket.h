@@ -55,8 +55,30 @@
 #define NO_OS_LWIP_INIT_ONETIME		0
 #endif
 
+/* Zero-copy buffers which may wait to be acknowledged, for each socket */
+#ifndef NO_OS_LWIP_ZC_QUEUE_LEN
+#define NO_OS_LWIP_ZC_QUEUE_LEN		4
+#endif
+
 struct lwip_network_desc;
 
+/*
+ * Called once the data of a zero-copy send was acknowledged by the remote
+ * (err is 0), or with a negative error code if the connection was closed
+ * before. data can be reused or freed from this point.
+ */
+typedef void (*no_os_lwip_sent_cb)(void *ctx, const void *data, uint32_t len,
+				   int32_t err);
+
+struct lwip_zc_buff {
+	/* Value of the queued bytes counter after the last byte of the buffer */
+	uint32_t end;
+	const void *data;
+	uint32_t len;
+	no_os_lwip_sent_cb sent;
+	void *ctx;
+};
+
 struct lwip_socket_desc {
 	/* Unique identifier */
 	uint32_t id;
@@ -79,6 +101,15 @@ struct lwip_socket_desc {
 	struct pbuf *p;
 	/* Index of the current read byte in the first pbuf of the chain */
 	uint32_t p_idx;
+	/* Bytes given to tcp_write() and acknowledged by the remote */
+	uint32_t queued;
+	uint32_t acked;
+	/* Bytes given to tcp_write() since the last tcp_output() */
+	uint32_t unsent;
+	/* Zero-copy buffers waiting to be acknowledged */
+	struct lwip_zc_buff zc[NO_OS_LWIP_ZC_QUEUE_LEN];
+	uint32_t zc_head;
+	uint32_t zc_count;
 	/* Reference to the parent network descriptor. */
 	struct lwip_network_desc *desc;
 };
@@ -120,6 +151,17 @@ int32_t no_os_lwip_remove(struct lwip_network_desc *);
  * it will call the necessary lwip timers.
  */
 int32_t no_os_lwip_step(struct lwip_network_desc *, void *);
+/* Queue data to be sent without copying it, until it's acknowledged. */
+int32_t no_os_lwip_send_zc(struct lwip_network_desc *, uint32_t, const void *,
+			   uint32_t, no_os_lwip_sent_cb, void *);
+/* Send the data queued on a socket without waiting for more. */
+int32_t no_os_lwip_flush(struct lwip_network_desc *, uint32_t);
+/* Get the received pbuf chain and the offset of the first unread byte. */
+int32_t no_os_lwip_recv_peek(struct lwip_network_desc *, uint32_t,
+			     struct pbuf **, uint32_t *);
+/* Mark bytes returned by no_os_lwip_recv_peek() as read. */
+int32_t no_os_lwip_recv_consume(struct lwip_network_desc *, uint32_t,
+				uint32_t);
 
 extern struct network_interface lwip_socket_ops;
 
@@ -67,6 +67,9 @@ static uint8_t lwip_buff[ADIN1110_LWIP_BUFF_SIZE];
 
 /**
  * @brief Read a frame from the RX FIFO.
+ *
+ * The frame is received by the SPI controller directly in the pbuf, which
+ * is then adjusted to start after the SPI header.
  * @param desc - ADIN1110 descriptor.
  * @param p - the received pbuf.
  * @param len - length of the frame.
@@ -75,25 +78,33 @@ static uint8_t lwip_buff[ADIN1110_LWIP_BUFF_SIZE];
 static int adin1110_read_frames(struct adin1110_desc *desc, struct pbuf **p,
 				uint32_t *len)
 {
-	struct adin1110_eth_buff mac_buff = {0};
+	uint32_t buff_len;
 	int ret;
 
-	mac_buff.payload = &lwip_buff[ADIN1110_ETH_HDR_LEN];
-
-	ret = adin1110_read_fifo(desc, 0, &mac_buff);
-	if (ret)
+	ret = adin1110_rx_frame_len(desc, 0, len);
+	if (ret || !*len)
 		return ret;
 
-	*len = mac_buff.len;
-	if (!mac_buff.len)
-		return 0;
-
-	memcpy(lwip_buff, mac_buff.mac_dest, ADIN1110_ETH_HDR_LEN);
-	*p = pbuf_alloc(PBUF_RAW, mac_buff.len, PBUF_POOL);
+	/* The SPI transfer needs a contiguous buffer */
+	buff_len = ADIN1110_RX_BUFF_LEN(*len);
+	*p = pbuf_alloc(PBUF_RAW, buff_len, PBUF_POOL);
+	if (*p && (*p)->next) {
+		pbuf_free(*p);
+		*p = NULL;
+	}
+	if (!*p)
+		*p = pbuf_alloc(PBUF_RAW, buff_len, PBUF_RAM);
 	if (!*p)
 		return -ENOMEM;
 
-	pbuf_take(*p, lwip_buff, mac_buff.len);
+	ret = adin1110_read_fifo_inplace(desc, 0, (*p)->payload, *len);
+	if (ret) {
+		pbuf_free(*p);
+		return ret;
+	}
+
+	pbuf_remove_header(*p, ADIN1110_RX_HDR_ROOM);
+	pbuf_realloc(*p, *len);
 
 	return 0;
 }
@@ -115,6 +126,10 @@ static int32_t adin1110_step(struct lwip_network_desc *desc, void *data)
 	netif_desc = desc->lwip_netif;
 	mac_desc = desc->mac_desc;
 
+	/*
+	 * Each frame is read with a single SPI transfer, which also gets the
+	 * size of the next one, until the FIFO is empty.
+	 */
 	do {
 		ret = adin1110_read_frames(mac_desc, &p, &len);
 		if (ret)
@@ -141,23 +156,31 @@ static int32_t adin1110_step(struct lwip_network_desc *desc, void *data)
  */
 static int32_t adin1110_netif_output(struct netif *net, struct pbuf *p)
 {
+	struct adin1110_frag frags[ADIN1110_TX_MAX_FRAGS];
 	struct lwip_network_desc *lwip_desc;
 	struct adin1110_desc *mac_desc;
-	struct adin1110_eth_buff buff;
-	uint32_t frame_len;
+	uint32_t nb_frags = 0;
+	struct pbuf *q;
 
 	lwip_desc = net->state;
 	mac_desc = lwip_desc->mac_desc;
 
 	LINK_STATS_INC(link.xmit);
-	frame_len = pbuf_copy_partial(p, lwip_buff, p->tot_len, 0);
 
-	memcpy(&buff.mac_dest, lwip_buff, ADIN1110_ETH_HDR_LEN);
+	/* The SPI controller sends the frame straight from the pbuf chain */
+	for (q = p; q && nb_frags < ADIN1110_TX_MAX_FRAGS; q = q->next) {
+		frags[nb_frags].data = q->payload;
+		frags[nb_frags++].len = q->len;
+	}
 
-	buff.len = frame_len;
-	buff.payload = &lwip_buff[ADIN1110_ETH_HDR_LEN];
+	/* Chains which are too long are copied in a single fragment */
+	if (q) {
+		frags[0].data = lwip_buff;
+		frags[0].len = pbuf_copy_partial(p, lwip_buff, p->tot_len, 0);
+		nb_frags = 1;
+	}
 
-	return adin1110_write_fifo(mac_desc, 0, &buff);
+	return adin1110_write_fifo_frags(mac_desc, 0, frags, nb_frags);
 }
 
 /**
@@ -0,0 +1,318 @@
+
+/***************************************************************************//**
+ *   @file   lwip_linux_tap.c
+ *   @brief  Source file for the Linux TAP LWIP implementation.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifdef NO_OS_LWIP_NETWORKING
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <net/if.h>
+#include <linux/if_tun.h>
+
+#include "lwip/opt.h"
+#include "lwip/sys.h"
+#include "lwip/stats.h"
+#include "lwip/memp.h"
+#include "lwip/pbuf.h"
+#include "lwip/netif.h"
+#include "lwip_socket.h"
+
+#include "no_os_alloc.h"
+#include "lwip_linux_tap.h"
+
+/**
+ * @brief Linux TAP network device descriptor.
+ */
+struct linux_tap_desc {
+	int fd;
+	uint32_t stats_period_ms;
+	uint32_t stats_time;
+	struct linux_tap_stats stats;
+};
+
+/* Used for the frames which have too many pbufs */
+static uint8_t linux_tap_buff[LINUX_TAP_FRAME_LEN];
+
+/**
+ * @brief Check if there is a frame to be read from the TAP interface.
+ * @param tap - TAP descriptor.
+ * @return true if a frame can be read.
+ */
+static bool linux_tap_readable(struct linux_tap_desc *tap)
+{
+	struct pollfd pfd = {
+		.fd = tap->fd,
+		.events = POLLIN,
+	};
+
+	return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN);
+}
+
+/**
+ * @brief Print the traffic counters and the usage of the lwip memory pools.
+ * @param tap - TAP descriptor.
+ */
+static void linux_tap_print_stats(struct linux_tap_desc *tap)
+{
+	printf("tap: rx %"PRIu32" frames %"PRIu64" bytes, tx %"PRIu32" frames %"
+	       PRIu64" bytes, no pbuf %"PRIu32", dropped %"PRIu32", tx errors %"
+	       PRIu32"\n", tap->stats.rx_frames, tap->stats.rx_bytes,
+	       tap->stats.tx_frames, tap->stats.tx_bytes, tap->stats.rx_no_pbuf,
+	       tap->stats.rx_dropped, tap->stats.tx_errors);
+#if MEM_STATS
+	printf("tap: heap used %lu max %lu err %lu\n",
+	       (unsigned long)lwip_stats.mem.used,
+	       (unsigned long)lwip_stats.mem.max,
+	       (unsigned long)lwip_stats.mem.err);
+#endif
+#if MEMP_STATS
+	for (int i = 0; i < MEMP_MAX; i++)
+		printf("tap: pool %s used %lu max %lu avail %lu err %lu\n",
+		       lwip_stats.memp[i]->name,
+		       (unsigned long)lwip_stats.memp[i]->used,
+		       (unsigned long)lwip_stats.memp[i]->max,
+		       (unsigned long)lwip_stats.memp[i]->avail,
+		       (unsigned long)lwip_stats.memp[i]->err);
+#endif
+}
+
+/**
+ * @brief Pass the frames received on the TAP interface to lwip.
+ *
+ * The frames are read directly in the pbufs of the lwip pool.
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param data - unused.
+ * @return 0 in case of success, negative error otherwise.
+ */
+static int32_t linux_tap_step(struct lwip_network_desc *desc, void *data)
+{
+	struct linux_tap_desc *tap = desc->mac_desc;
+	struct netif *netif = desc->lwip_netif;
+	struct iovec iov[LINUX_TAP_MAX_IOV];
+	struct pbuf *p, *q;
+	uint32_t frames;
+	ssize_t len;
+	int nb_iov;
+
+	for (frames = 0; frames < LINUX_TAP_RX_BUDGET; frames++) {
+		if (!linux_tap_readable(tap))
+			break;
+
+		p = pbuf_alloc(PBUF_RAW, LINUX_TAP_FRAME_LEN, PBUF_POOL);
+		if (!p) {
+			/* The frame stays queued until pbufs are released */
+			tap->stats.rx_no_pbuf++;
+			break;
+		}
+
+		nb_iov = 0;
+		for (q = p; q && nb_iov < LINUX_TAP_MAX_IOV; q = q->next) {
+			iov[nb_iov].iov_base = q->payload;
+			iov[nb_iov++].iov_len = q->len;
+		}
+
+		len = readv(tap->fd, iov, nb_iov);
+		if (len <= 0) {
+			pbuf_free(p);
+			if (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+				return -errno;
+			break;
+		}
+
+		pbuf_realloc(p, len);
+		tap->stats.rx_frames++;
+		tap->stats.rx_bytes += len;
+		LINK_STATS_INC(link.recv);
+
+		if (netif->input(p, netif) != ERR_OK) {
+			tap->stats.rx_dropped++;
+			pbuf_free(p);
+		}
+	}
+
+	if (tap->stats_period_ms &&
+	    sys_now() - tap->stats_time >= tap->stats_period_ms) {
+		tap->stats_time = sys_now();
+		linux_tap_print_stats(tap);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Write the data inside a pbuf on the TAP interface.
+ * @param netif - lwip network interface.
+ * @param p - pbuf to be sent.
+ * @return 0 in case of success, negative error otherwise.
+ */
+static int32_t linux_tap_netif_output(struct netif *netif, struct pbuf *p)
+{
+	struct lwip_network_desc *lwip_desc = netif->state;
+	struct linux_tap_desc *tap = lwip_desc->mac_desc;
+	struct iovec iov[LINUX_TAP_MAX_IOV];
+	struct pbuf *q;
+	ssize_t len;
+	int nb_iov = 0;
+
+	LINK_STATS_INC(link.xmit);
+
+	/* The frame is sent straight from the pbuf chain */
+	for (q = p; q && nb_iov < LINUX_TAP_MAX_IOV; q = q->next) {
+		iov[nb_iov].iov_base = q->payload;
+		iov[nb_iov++].iov_len = q->len;
+	}
+
+	if (q) {
+		iov[0].iov_base = linux_tap_buff;
+		iov[0].iov_len = pbuf_copy_partial(p, linux_tap_buff,
+						   sizeof(linux_tap_buff), 0);
+		nb_iov = 1;
+	}
+
+	len = writev(tap->fd, iov, nb_iov);
+	if (len < 0) {
+		tap->stats.tx_errors++;
+		return -errno;
+	}
+
+	tap->stats.tx_frames++;
+	tap->stats.tx_bytes += len;
+
+	return 0;
+}
+
+/**
+ * @brief Attach to a TAP interface.
+ * @param desc - TAP descriptor.
+ * @param param - struct linux_tap_lwip_param.
+ * @return 0 in case of success, negative error otherwise.
+ */
+static int32_t linux_tap_lwip_init(void **desc, void *param)
+{
+	struct linux_tap_lwip_param *tap_param = param;
+	struct linux_tap_desc *tap;
+	struct ifreq ifr = {0};
+	int ret;
+
+	if (!desc || !tap_param || !tap_param->ifname)
+		return -EINVAL;
+
+	tap = no_os_calloc(1, sizeof(*tap));
+	if (!tap)
+		return -ENOMEM;
+
+	tap->fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+	if (tap->fd < 0) {
+		ret = -errno;
+		goto free_tap;
+	}
+
+	ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+	strncpy(ifr.ifr_name, tap_param->ifname, IFNAMSIZ - 1);
+	if (ioctl(tap->fd, TUNSETIFF, &ifr) < 0) {
+		ret = -errno;
+		printf("Unable to attach to %s (%d)\n", tap_param->ifname, ret);
+		goto close_fd;
+	}
+
+	tap->stats_period_ms = tap_param->stats_period_ms;
+	tap->stats_time = sys_now();
+	*desc = tap;
+
+	return 0;
+
+close_fd:
+	close(tap->fd);
+free_tap:
+	no_os_free(tap);
+
+	return ret;
+}
+
+/**
+ * @brief Detach from the TAP interface.
+ * @param desc - TAP descriptor.
+ * @return 0 in case of success, negative error otherwise.
+ */
+static int32_t linux_tap_lwip_remove(void *desc)
+{
+	struct linux_tap_desc *tap = desc;
+
+	if (!tap)
+		return -EINVAL;
+
+	close(tap->fd);
+	no_os_free(tap);
+
+	return 0;
+}
+
+/**
+ * @brief Get the traffic counters of the TAP network device.
+ * @param desc - TAP descriptor (mac_desc of the lwip descriptor).
+ * @param stats - the counters.
+ * @return 0 in case of success, negative error otherwise.
+ */
+int linux_tap_lwip_get_stats(void *desc, struct linux_tap_stats *stats)
+{
+	struct linux_tap_desc *tap = desc;
+
+	if (!tap || !stats)
+		return -EINVAL;
+
+	*stats = tap->stats;
+
+	return 0;
+}
+
+const struct no_os_lwip_ops linux_tap_lwip_ops = {
+	.init = linux_tap_lwip_init,
+	.remove = linux_tap_lwip_remove,
+	.netif_output = linux_tap_netif_output,
+	.step = linux_tap_step,
+};
+
+#endif /* NO_OS_LWIP_NETWORKING */
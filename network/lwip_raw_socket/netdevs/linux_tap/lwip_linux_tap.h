@@ -0,0 +1,89 @@
+/***************************************************************************//**
+ *   @file   lwip_linux_tap.h
+ *   @brief  Header file for the Linux TAP LWIP implementation.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _LWIP_LINUX_TAP_H_
+#define _LWIP_LINUX_TAP_H_
+
+#ifdef NO_OS_LWIP_NETWORKING
+
+#include <stdint.h>
+
+/* Largest frame read from the TAP interface (MTU, MAC header and VLAN tag) */
+#define LINUX_TAP_FRAME_LEN		1518
+/* Maximum number of frames passed to lwip by a step */
+#define LINUX_TAP_RX_BUDGET		32
+/* Maximum number of pbufs in the chain of a frame */
+#define LINUX_TAP_MAX_IOV		16
+
+/**
+ * @brief Initialization parameter of the TAP network device.
+ *
+ * The interface has to be created and configured before, e.g.:
+ * ip tuntap add dev tap0 mode tap user $USER
+ * ip addr add 169.254.97.1/16 dev tap0
+ * ip link set tap0 up
+ */
+struct linux_tap_lwip_param {
+	/* Name of the TAP interface */
+	const char *ifname;
+	/* Period of the statistics printed by the step function, 0 to disable */
+	uint32_t stats_period_ms;
+};
+
+/**
+ * @brief Traffic counters of the TAP network device.
+ */
+struct linux_tap_stats {
+	uint64_t rx_bytes;
+	uint64_t tx_bytes;
+	uint32_t rx_frames;
+	uint32_t tx_frames;
+	/* Frames left in the TAP queue because there was no pbuf for them */
+	uint32_t rx_no_pbuf;
+	/* Frames dropped by lwip */
+	uint32_t rx_dropped;
+	uint32_t tx_errors;
+};
+
+/* Get the traffic counters of the TAP network device. */
+int linux_tap_lwip_get_stats(void *desc, struct linux_tap_stats *stats);
+
+extern const struct no_os_lwip_ops linux_tap_lwip_ops;
+
+#endif /* NO_OS_LWIP_NETWORKING */
+#endif /* _LWIP_LINUX_TAP_H_ */
@@ -218,6 +218,36 @@ struct network_interface {
 	 */
 	int32_t (*socket_accept)(void *net, uint32_t sock_id,
 				 uint32_t *client_socket_id);
+
+	/**
+	 * @brief Wait until one of the opened sockets is ready for I/O.
+	 *
+	 * Optional. A socket is reported once each time it becomes readable
+	 * or writable, or when the connection is closed by the peer.
+	 * @param net - Network interface
+	 * @param timeout_ms - Maximum time to wait, in milliseconds
+	 * @param sock_ids - Address where to store the ids of the ready sockets
+	 * @param nb_socks - Size of sock_ids. Updated with the number of ready
+	 * sockets. It is set to 0 on timeout.
+	 * @return
+	 *  - 0 : On success
+	 *  - 1 : On success, the call was also woken up by socket_wakeup. Ready
+	 *  sockets returned at the same time are still stored in sock_ids.
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_wait)(void *net, uint32_t timeout_ms,
+			       uint32_t *sock_ids, uint32_t *nb_socks);
+
+	/**
+	 * @brief Make a pending or the next socket_wait call return.
+	 *
+	 * Optional. Can be called from a different thread than socket_wait.
+	 * @param net - Network interface
+	 * @return
+	 *  - 0 : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_wakeup)(void *net);
 };
 
 #endif
@@ -117,11 +117,17 @@ static int tls_net_recv(struct tcp_socket_desc *sock, unsigned char *buff,
 	return ret;
 }
 
-/* Wrapper over socket_recv */
+/* Wrapper over socket_send */
 static int tls_net_send(struct tcp_socket_desc *sock, unsigned char *buff,
 			size_t len)
 {
-	return sock->net->socket_send(sock->net->net, sock->id, buff, len);
+	int32_t ret;
+
+	ret = sock->net->socket_send(sock->net->net, sock->id, buff, len);
+	if (ret == -EAGAIN || (!ret && len))
+		return MBEDTLS_ERR_SSL_WANT_WRITE;
+
+	return ret;
 }
 
 /* Remove secure descriptor*/
@@ -461,3 +467,28 @@ int32_t socket_accept(struct tcp_socket_desc *desc,
 	return 0;
 }
 
+/** @brief See \ref network_interface.socket_wait */
+int32_t socket_wait(struct tcp_socket_desc *desc, uint32_t timeout_ms,
+		    uint32_t *sock_ids, uint32_t *nb_socks)
+{
+	if (!desc || !sock_ids || !nb_socks)
+		return -EINVAL;
+
+	if (!desc->net->socket_wait)
+		return -ENOSYS;
+
+	return desc->net->socket_wait(desc->net->net, timeout_ms, sock_ids,
+				      nb_socks);
+}
+
+/** @brief See \ref network_interface.socket_wakeup */
+int32_t socket_wakeup(struct tcp_socket_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->net->socket_wakeup)
+		return -ENOSYS;
+
+	return desc->net->socket_wakeup(desc->net->net);
+}
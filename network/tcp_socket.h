@@ -170,4 +170,11 @@ int32_t socket_listen(struct tcp_socket_desc *desc, uint32_t back_log);
 int32_t socket_accept(struct tcp_socket_desc *desc,
 		      struct tcp_socket_desc **new_client);
 
+/* Wait for I/O events on the sockets of the network interface */
+int32_t socket_wait(struct tcp_socket_desc *desc, uint32_t timeout_ms,
+		    uint32_t *sock_ids, uint32_t *nb_socks);
+
+/* Wake up socket_wait */
+int32_t socket_wakeup(struct tcp_socket_desc *desc);
+
 #endif
@@ -65,5 +65,6 @@ INCS +=	$(INCLUDE)/no_os_axi_io.h \
 ifeq (y,$(strip $(TINYIIOD)))
 INCS += $(DRIVERS)/adc/ad463x/iio_ad463x.h \
 	$(INCLUDE)/no_os_fifo.h \
+	$(INCLUDE)/no_os_ilist.h \
 	$(INCLUDE)/no_os_list.h
 endif
@@ -52,6 +52,7 @@ SRCS += $(DRIVERS)/cdc/ad7746/iio_ad7746.c \
 INCS += $(DRIVERS)/cdc/ad7746/iio_ad7746.h \
 	$(NO-OS)/iio/iio_app/iio_app.h \
 	$(INCLUDE)/no_os_fifo.h \
+	$(INCLUDE)/no_os_ilist.h \
 	$(INCLUDE)/no_os_list.h
 endif
 
@@ -31,6 +31,7 @@ INCS += $(INCLUDE)/no_os_lf256fifo.h
 INCS +=	$(INCLUDE)/no_os_irq.h
 INCS += $(INCLUDE)/no_os_list.h
 INCS += $(INCLUDE)/no_os_fifo.h
+INCS += $(INCLUDE)/no_os_ilist.h
 INCS += $(INCLUDE)/no_os_alloc.h
 INCS += $(PROJECT)/src/parameters.h \
 	$(INCLUDE)/no_os_mutex.h
@@ -59,6 +60,7 @@ LIBRARIES += iio
 SRC_DIRS += $(NO-OS)/iio/iio_app
 
 INCS +=	$(INCLUDE)/no_os_fifo.h \
+	$(INCLUDE)/no_os_ilist.h \
 	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_lf256fifo.h \
 	$(INCLUDE)/no_os_list.h \
@@ -347,7 +347,11 @@ int main(void)
 	jesd204_topology_init(&topology, devs,
 			      sizeof(devs)/sizeof(*devs));
 
-	jesd204_fsm_start(topology, JESD204_LINKS_ALL);
+	status = jesd204_fsm_start(topology, JESD204_LINKS_ALL);
+	if (status)
+		printf("jesd204_fsm_start() error: %" PRId32 "\n", status);
+
+	jesd204_fsm_print_stats(topology);
 
 	axi_jesd204_tx_status_read(tx_jesd);
 	axi_jesd204_rx_status_read(rx_jesd);
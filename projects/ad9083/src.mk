@@ -84,6 +84,7 @@ SRCS += $(NO-OS)/util/no_os_fifo.c \
 	$(DRIVERS)/api/no_os_uart.c
 
 INCS += $(INCLUDE)/no_os_fifo.h \
+	$(INCLUDE)/no_os_ilist.h \
 	$(INCLUDE)/no_os_irq.h \
 	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_lf256fifo.h \
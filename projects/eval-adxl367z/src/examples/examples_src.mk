@@ -24,5 +24,6 @@ INCS +=	$(DRIVERS)/accel/adxl367/iio_adxl367.h \
 	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_irq.h \
 	$(INCLUDE)/no_os_fifo.h \
+	$(INCLUDE)/no_os_ilist.h \
 	$(INCLUDE)/no_os_lf256fifo.h
 endif
@@ -1305,8 +1305,13 @@ int main(void)
 	jesd204_topology_init(&topology_tx, devs_tx,
 			      sizeof(devs_tx) / sizeof(*devs_tx));
 
-	jesd204_fsm_start(topology, JESD204_LINKS_ALL);
-	jesd204_fsm_start(topology_tx, JESD204_LINKS_ALL);
+	status = jesd204_fsm_start(topology, JESD204_LINKS_ALL);
+	if (status)
+		printf("jesd204_fsm_start() rx error: %d\n", status);
+
+	status = jesd204_fsm_start(topology_tx, JESD204_LINKS_ALL);
+	if (status)
+		printf("jesd204_fsm_start() tx error: %d\n", status);
 #endif
 
 	fmcdaq2_test(&fmcdaq2, &fmcdaq2_init);
@@ -22,6 +22,7 @@ SRCS += $(DRIVERS)/api/no_os_uart.c     \
 INCS += $(INCLUDE)/no_os_delay.h     \
         $(INCLUDE)/no_os_error.h     \
         $(INCLUDE)/no_os_fifo.h      \
+        $(INCLUDE)/no_os_ilist.h     \
         $(INCLUDE)/no_os_irq.h       \
         $(INCLUDE)/no_os_lf256fifo.h \
         $(INCLUDE)/no_os_list.h      \
@@ -46,6 +46,10 @@
 #include "common_data.h"
 #include "no_os_util.h"
 
+#ifdef NO_OS_LWIP_NETWORKING
+#include <string.h>
+#endif
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -99,6 +103,13 @@ int iio_example_main()
 	app_init_param.devices = devices;
 	app_init_param.nb_devices = NO_OS_ARRAY_SIZE(devices);
 	app_init_param.uart_init_params = iio_demo_uart_ip;
+#ifdef NO_OS_LWIP_NETWORKING
+	app_init_param.lwip_param.platform_ops = LWIP_OPS;
+	app_init_param.lwip_param.mac_param = &iio_demo_tap_ip;
+	app_init_param.lwip_param.extra = NULL;
+	memcpy(app_init_param.lwip_param.hwaddr, iio_demo_mac_address,
+	       sizeof(iio_demo_mac_address));
+#endif
 
 	status = iio_app_init(&app, app_init_param);
 	if (status)
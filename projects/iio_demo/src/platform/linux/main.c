@@ -52,6 +52,10 @@
 #include "iio_sw_trigger_example.h"
 #endif
 
+#ifdef IIO_TIMER_TRIGGER_EXAMPLE
+#include "iio_timer_trigger_example.h"
+#endif
+
 /***************************************************************************//**
  * @brief Main function execution for linux platform.
  *
@@ -70,12 +74,12 @@ int main()
 #endif
 
 #ifdef IIO_TIMER_TRIGGER_EXAMPLE
-#error Timer trigger example is not supported on linux platform.
+	ret = iio_timer_trigger_example_main();
 #endif
 
-#if (IIO_EXAMPLE + IIO_SW_TRIGGER_EXAMPLE == 0)
+#if (IIO_EXAMPLE + IIO_SW_TRIGGER_EXAMPLE + IIO_TIMER_TRIGGER_EXAMPLE == 0)
 #error At least one example has to be selected using y value in Makefile.
-#elif (IIO_EXAMPLE + IIO_SW_TRIGGER_EXAMPLE > 1)
+#elif (IIO_EXAMPLE + IIO_SW_TRIGGER_EXAMPLE + IIO_TIMER_TRIGGER_EXAMPLE > 1)
 #error Selected example projects cannot be enabled at the same time. \
 Please enable only one example and re-build the project.
 #endif
@@ -41,3 +41,16 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include "parameters.h"
+
+/******************************************************************************/
+/********************** Variables and User Defined Data ***********************/
+/******************************************************************************/
+#ifdef NO_OS_LWIP_NETWORKING
+/* Locally administered address, unique on the host TAP segment */
+uint8_t iio_demo_mac_address[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+
+struct linux_tap_lwip_param iio_demo_tap_ip = {
+	.ifname = LWIP_TAP_IFNAME,
+	.stats_period_ms = LWIP_TAP_STATS_PERIOD_MS,
+};
+#endif
@@ -46,6 +46,17 @@
 #include "common_data.h"
 #include "no_os_util.h"
 
+#ifdef IIO_TIMER_TRIGGER_EXAMPLE
+#include "linux_irq.h"
+#include "linux_timer.h"
+#include "no_os_irq.h"
+#include "no_os_timer.h"
+#endif
+
+#ifdef NO_OS_LWIP_NETWORKING
+#include "lwip_linux_tap.h"
+#endif
+
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
 /******************************************************************************/
@@ -60,4 +71,47 @@ and based on the available RAM memory of the platform */
 #define UART_EXTRA      NULL
 #define UART_OPS        NULL
 
+#ifdef IIO_TIMER_TRIGGER_EXAMPLE
+/* Adc Demo Timer settings */
+#define ADC_DEMO_TIMER_DEVICE_ID    0
+#define ADC_DEMO_TIMER_FREQ_HZ      1000000
+#define ADC_DEMO_TIMER_TICKS_COUNT  2000
+#define ADC_DEMO_TIMER_EXTRA        NULL
+#define TIMER_OPS                   &linux_timer_ops
+
+/* Adc Demo Timer trigger settings */
+#define ADC_DEMO_TIMER_IRQ_ID       LINUX_TIMER_IRQ_ID(ADC_DEMO_TIMER_DEVICE_ID)
+#define TIMER_IRQ_OPS               &linux_irq_ops
+#define ADC_DEMO_TIMER_IRQ_EXTRA    NULL
+
+/* Adc Demo timer trigger settings */
+#define ADC_DEMO_TIMER_CB_HANDLE    NULL
+#define ADC_DEMO_TIMER_TRIG_IRQ_ID  ADC_DEMO_TIMER_IRQ_ID
+
+/* Dac Demo Timer settings */
+#define DAC_DEMO_TIMER_DEVICE_ID    1
+#define DAC_DEMO_TIMER_FREQ_HZ      1000000
+#define DAC_DEMO_TIMER_TICKS_COUNT  2000
+#define DAC_DEMO_TIMER_EXTRA        NULL
+
+/* Dac Demo Timer trigger settings */
+#define DAC_DEMO_TIMER_IRQ_ID       LINUX_TIMER_IRQ_ID(DAC_DEMO_TIMER_DEVICE_ID)
+#define DAC_DEMO_TIMER_IRQ_EXTRA    NULL
+
+/* Dac Demo timer trigger settings */
+#define DAC_DEMO_TIMER_CB_HANDLE    NULL
+#define DAC_DEMO_TIMER_TRIG_IRQ_ID  DAC_DEMO_TIMER_IRQ_ID
+#endif
+
+#ifdef NO_OS_LWIP_NETWORKING
+/* TAP interface created with "ip tuntap add dev tap0 mode tap" */
+#define LWIP_TAP_IFNAME             "tap0"
+/* Period of the TAP and lwIP memory statistics report (0 to disable) */
+#define LWIP_TAP_STATS_PERIOD_MS    5000
+#define LWIP_OPS                    &linux_tap_lwip_ops
+
+extern uint8_t iio_demo_mac_address[6];
+extern struct linux_tap_lwip_param iio_demo_tap_ip;
+#endif
+
 #endif /* __PARAMETERS_H__ */
@@ -1,7 +1,17 @@
-CFLAGS += -DNO_OS_NETWORKING \
+ifeq (y,$(strip $(IIO_LWIP_TAP)))
+# lwIP stack on top of a Linux TAP interface (the lwip submodule is needed)
+CFLAGS += -DNO_OS_LWIP_NETWORKING \
+	-DNO_OS_STATIC_IP \
+	-DMEM_ALIGNMENT=8 \
 	-DDISABLE_SECURE_SOCKET
 
-LIBRARIES += iio
+LIBRARIES += lwip
+
+SRCS += $(NO-OS)/network/lwip_raw_socket/netdevs/linux_tap/lwip_linux_tap.c
+INCS += $(NO-OS)/network/lwip_raw_socket/netdevs/linux_tap/lwip_linux_tap.h
+else
+CFLAGS += -DNO_OS_NETWORKING \
+	-DDISABLE_SECURE_SOCKET
 
 SRCS += $(NO-OS)/network/linux_socket/linux_socket.c \
 	$(NO-OS)/network/tcp_socket.c
@@ -10,9 +20,12 @@ INCS += $(NO-OS)/network/linux_socket/linux_socket.h \
 	$(NO-OS)/network/tcp_socket.h                \
 	$(NO-OS)/network/network_interface.h         \
 	$(NO-OS)/network/noos_mbedtls_config.h
-	
+endif
+
+LIBRARIES += iio
 
-SRCS += $(NO-OS)/util/no_os_circular_buffer.c
+SRCS += $(NO-OS)/util/no_os_circular_buffer.c \
+	$(NO-OS)/util/no_os_lf256fifo.c
 INCS += $(INCLUDE)/no_os_circular_buffer.h
 
 SRCS += $(DRIVERS)/platform/linux/linux_uart.c \
@@ -21,3 +34,11 @@ SRCS += $(DRIVERS)/platform/linux/linux_uart.c \
 
 INCS += $(INCLUDE)/no_os_gpio.h \
 	$(INCLUDE)/no_os_trng.h		
+
+SRCS += $(DRIVERS)/platform/linux/linux_irq.c \
+	$(DRIVERS)/platform/linux/linux_timer.c \
+	$(DRIVERS)/api/no_os_irq.c \
+	$(DRIVERS)/api/no_os_timer.c
+
+INCS += $(DRIVERS)/platform/linux/linux_irq.h \
+	$(DRIVERS)/platform/linux/linux_timer.h
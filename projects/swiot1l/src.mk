@@ -31,6 +31,7 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 		$(INCLUDE)/no_os_list.h      \
 		$(INCLUDE)/no_os_mutex.h      \
 		$(INCLUDE)/no_os_crc8.h      \
+		$(INCLUDE)/no_os_crc_table.h      \
 		$(INCLUDE)/no_os_uart.h      \
 		$(INCLUDE)/no_os_i2c.h      \
 		$(INCLUDE)/no_os_mdio.h      \
@@ -72,7 +73,8 @@ SRCS += $(DRIVERS)/digital-io/max14906/iio_max14906.c
 INCS += $(DRIVERS)/temperature/adt75/iio_adt75.h
 SRCS += $(DRIVERS)/temperature/adt75/iio_adt75.c
 
-INCS += $(INCLUDE)/no_os_crc8.h
+INCS += $(INCLUDE)/no_os_crc8.h \
+	$(INCLUDE)/no_os_crc_table.h
 INCS += $(DRIVERS)/net/adin1110/adin1110.h
 INCS += $(NO-OS)/network/lwip_raw_socket/netdevs/adin1110/lwip_adin1110.h
 SRCS += $(NO-OS)/network/lwip_raw_socket/netdevs/adin1110/lwip_adin1110.c
@@ -0,0 +1,295 @@
+/***************************************************************************//**
+ *   @file   test_axi_dmac.c
+ *   @brief  AXI DMAC transfers on the modeled ADC, DAC and DMAC cores.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "axi_dmac.h"
+#include "axi_io_model.h"
+#include "no_os_alloc.h"
+#include "no_os_axi_io.h"
+#include "no_os_util.h"
+#include "mock_no_os_delay.h"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define DMAC_BASE		0x1000
+#define CONV_BASE		0x2000
+#define NB_CHANNELS		2
+/* One 16 bits sample for each channel */
+#define FRAME_SIZE		(NB_CHANNELS * 2)
+#define SAMPLE_RATE_HZ		10000000
+#define BUF_SIZE		4096
+#define TIMEOUT_MS		1000
+
+/* Registers of the ADC and DAC cores used to start streaming */
+#define CORE_REG_RSTN		0x040
+#define ADC_REG_CHAN_CNTRL(c)	(0x0400 + (c) * 0x40)
+
+static uint8_t buf[BUF_SIZE];
+static uint8_t src_buf[BUF_SIZE];
+static struct axi_dmac *dmac;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* The model advances with the host clock, so the delays have to be real */
+static void mdelay_cb(uint32_t msecs, int cmock_num_calls)
+{
+	struct timespec ts = {
+		.tv_sec = msecs / 1000,
+		.tv_nsec = (msecs % 1000) * 1000000
+	};
+
+	nanosleep(&ts, NULL);
+}
+
+static void add_dmac(enum axi_io_model_type conv_type)
+{
+	struct axi_io_model_init_param param = {
+		.type = AXI_IO_MODEL_DMAC,
+		.base = DMAC_BASE,
+		.core_base = CONV_BASE,
+	};
+	struct axi_dmac_init init = {
+		.name = "dmac",
+		.base = DMAC_BASE,
+		.irq_option = IRQ_DISABLED,
+	};
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_add(&param));
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_dma_map(buf, sizeof(buf)));
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_dma_map(src_buf,
+				sizeof(src_buf)));
+
+	if (conv_type != AXI_IO_MODEL_DMAC) {
+		param = (struct axi_io_model_init_param) {
+			.type = conv_type,
+			.base = CONV_BASE,
+			.num_channels = NB_CHANNELS,
+			.sample_rate_hz = SAMPLE_RATE_HZ,
+		};
+		TEST_ASSERT_EQUAL_INT32(0, axi_io_model_add(&param));
+
+		/* Out of reset, with all the ADC channels enabled */
+		no_os_axi_io_write(CONV_BASE, CORE_REG_RSTN, 1);
+		for (i = 0; i < NB_CHANNELS; i++)
+			no_os_axi_io_write(CONV_BASE, ADC_REG_CHAN_CNTRL(i), 1);
+	}
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_init(&dmac, &init));
+}
+
+/* ADC frames hold the same 16 bits ramp value on each channel */
+static uint16_t frame_value(uint32_t frame)
+{
+	uint32_t off = frame * FRAME_SIZE;
+
+	return buf[off] | (buf[off + 1] << 8);
+}
+
+/* Check that the frames in [first, first + nb) hold consecutive samples */
+static void assert_ramp(uint32_t first, uint32_t nb)
+{
+	uint32_t frame;
+
+	for (frame = first + 1; frame < first + nb; frame++)
+		TEST_ASSERT_EQUAL_UINT16((uint16_t)(frame_value(first) +
+						    frame - first),
+					 frame_value(frame));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(buf, 0, sizeof(buf));
+	no_os_mdelay_StubWithCallback(mdelay_cb);
+}
+
+void tearDown(void)
+{
+	axi_dmac_remove(dmac);
+	dmac = NULL;
+	axi_io_model_remove_all();
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_axi_dmac_detect_dev_to_mem(void)
+{
+	add_dmac(AXI_IO_MODEL_ADC);
+
+	TEST_ASSERT_EQUAL(DMA_DEV_TO_MEM, dmac->direction);
+	TEST_ASSERT_EQUAL_HEX32(0xFFFFFF, dmac->max_length);
+}
+
+void test_axi_dmac_dev_to_mem(void)
+{
+	struct axi_io_model_stats stats;
+	struct axi_dma_transfer xfer = {
+		.size = BUF_SIZE,
+		.cyclic = NO,
+		.dest_addr = (uint32_t)(uintptr_t)buf,
+	};
+
+	add_dmac(AXI_IO_MODEL_ADC);
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_start(dmac, &xfer));
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_wait_completion(dmac,
+				TIMEOUT_MS));
+
+	assert_ramp(0, BUF_SIZE / FRAME_SIZE);
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_EQUAL_UINT32(1, stats.transfers);
+	TEST_ASSERT_EQUAL_UINT32(0, stats.dma_errors);
+	TEST_ASSERT_TRUE(stats.bytes >= BUF_SIZE);
+}
+
+void test_axi_dmac_sg_dev_to_mem(void)
+{
+	struct axi_io_model_stats stats;
+	struct axi_dma_segment segs[4];
+	uint32_t i, seg_size = BUF_SIZE / NO_OS_ARRAY_SIZE(segs);
+
+	add_dmac(AXI_IO_MODEL_ADC);
+
+	memset(segs, 0, sizeof(segs));
+	for (i = 0; i < NO_OS_ARRAY_SIZE(segs); i++) {
+		segs[i].dest_addr = (uint32_t)(uintptr_t)buf + i * seg_size;
+		segs[i].x_length = seg_size;
+	}
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_sg_start(dmac, segs,
+				NO_OS_ARRAY_SIZE(segs), NO));
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_wait_completion(dmac,
+				TIMEOUT_MS));
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_ARRAY_SIZE(segs), stats.transfers);
+	TEST_ASSERT_EQUAL_UINT32(0, stats.dma_errors);
+	/*
+	 * The converter streams while the next segments are submitted, so
+	 * samples can be dropped between segments, but not inside one.
+	 */
+	for (i = 0; i < NO_OS_ARRAY_SIZE(segs); i++)
+		assert_ramp(i * seg_size / FRAME_SIZE, seg_size / FRAME_SIZE);
+}
+
+void test_axi_dmac_mem_to_dev(void)
+{
+	struct axi_io_model_stats stats;
+	struct axi_dma_transfer xfer = {
+		.size = BUF_SIZE,
+		.cyclic = NO,
+		.src_addr = (uint32_t)(uintptr_t)src_buf,
+	};
+	uint32_t i, sum = 0;
+
+	for (i = 0; i < BUF_SIZE; i++) {
+		src_buf[i] = i * 7;
+		sum += src_buf[i];
+	}
+
+	add_dmac(AXI_IO_MODEL_DAC);
+	TEST_ASSERT_EQUAL(DMA_MEM_TO_DEV, dmac->direction);
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_start(dmac, &xfer));
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_wait_completion(dmac,
+				TIMEOUT_MS));
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_EQUAL_UINT32(1, stats.transfers);
+	TEST_ASSERT_EQUAL_UINT32(sum, stats.dac_checksum);
+}
+
+void test_axi_dmac_mem_to_mem(void)
+{
+	struct axi_dma_transfer xfer = {
+		.size = BUF_SIZE,
+		.cyclic = NO,
+		.src_addr = (uint32_t)(uintptr_t)src_buf,
+		.dest_addr = (uint32_t)(uintptr_t)buf,
+	};
+	uint32_t i;
+
+	for (i = 0; i < BUF_SIZE; i++)
+		src_buf[i] = i ^ 0x5A;
+
+	/* No converter at core_base */
+	add_dmac(AXI_IO_MODEL_DMAC);
+	TEST_ASSERT_EQUAL(DMA_MEM_TO_MEM, dmac->direction);
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_start(dmac, &xfer));
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_wait_completion(dmac,
+				TIMEOUT_MS));
+
+	TEST_ASSERT_EQUAL_MEMORY(src_buf, buf, BUF_SIZE);
+}
+
+void test_axi_dmac_unmapped_address(void)
+{
+	struct axi_io_model_stats stats;
+	struct axi_dma_transfer xfer = {
+		.size = BUF_SIZE,
+		.cyclic = NO,
+		.dest_addr = 0x10,
+	};
+
+	add_dmac(AXI_IO_MODEL_ADC);
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_start(dmac, &xfer));
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_transfer_wait_completion(dmac,
+				TIMEOUT_MS));
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_EQUAL_UINT32(1, stats.dma_errors);
+}
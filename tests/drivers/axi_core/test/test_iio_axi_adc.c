@@ -0,0 +1,484 @@
+/***************************************************************************//**
+ *   @file   test_iio_axi_adc.c
+ *   @brief  Unit tests and benchmarks of the AXI ADC IIO buffer streaming.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "axi_adc_core.h"
+#include "axi_dmac.h"
+#include "axi_io_model.h"
+#include "iio.h"
+#include "iio_axi_adc.h"
+#include "iiod.h"
+#include "no_os_alloc.h"
+#include "no_os_axi_io.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_list.h"
+#include "no_os_util.h"
+#include "mock_no_os_delay.h"
+#include "mock_no_os_uart.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define DMAC_BASE		0x1000
+#define ADC_BASE		0x2000
+#define NB_CHANNELS		2
+/* One 16 bits sample for each channel */
+#define FRAME_SIZE		(NB_CHANNELS * 2)
+/* Slow enough for the ramp not to wrap between two blocks */
+#define SAMPLE_RATE_HZ		1000000
+#define BLOCK_SAMPLES		256
+#define BLOCK_SIZE		(BLOCK_SAMPLES * FRAME_SIZE)
+#define NB_BLOCKS		4
+#define NB_READS		32
+#define CONN_BUF_SIZE		0x1000
+#define OUT_SIZE		(4 * BLOCK_SIZE)
+#define MAX_STEPS		100000
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_RATE_HZ		100000000
+#define BENCH_BLOCK_SAMPLES	16384
+#define BENCH_BLOCK_SIZE	(BENCH_BLOCK_SAMPLES * FRAME_SIZE)
+#define BENCH_READS		400
+#ifdef IIO_ENABLE_ZERO_COPY
+#define BENCH_READBUF		"zero-copy"
+#else
+#define BENCH_READBUF		"copy"
+#endif
+#define RAW_BUF_SIZE		(NB_BLOCKS * BENCH_BLOCK_SIZE)
+#else
+#define RAW_BUF_SIZE		(NB_BLOCKS * BLOCK_SIZE)
+#endif
+
+#define DMAC_REG_CTRL		0x400
+#define DMAC_CTRL_ENABLE	NO_OS_BIT(0)
+
+/* Local backend connection: command to be received and the answer */
+struct fake_conn {
+	const char *in;
+	uint32_t in_len;
+	uint32_t in_idx;
+	uint8_t out[OUT_SIZE];
+	uint32_t out_len;
+	/* Only keep the start of the answer, for the benchmarks */
+	bool discard;
+};
+
+static int8_t raw_buf[RAW_BUF_SIZE];
+static char conn_buf[CONN_BUF_SIZE];
+static struct fake_conn conn;
+static struct axi_adc *adc;
+static struct axi_dmac *dmac;
+static struct iio_axi_adc_desc *iio_adc;
+static struct iio_desc *iio;
+/* Bytes received by the client since the buffer was opened */
+static uint32_t read_bytes;
+/* Ramp value expected in the next frame, -1 before the first one */
+static int32_t next_value;
+/* Frames missing from the ramp between DMA blocks */
+static uint64_t gap_frames;
+/* Block boundaries at which frames were missing */
+static uint32_t nb_gaps;
+
+/*******************************************************************************
+ *    FAKE CONNECTION
+ ******************************************************************************/
+
+static int fake_recv(void *c, uint8_t *buf, uint32_t len)
+{
+	len = no_os_min(len, conn.in_len - conn.in_idx);
+	if (!len)
+		return -EAGAIN;
+
+	memcpy(buf, conn.in + conn.in_idx, len);
+	conn.in_idx += len;
+
+	return len;
+}
+
+static int fake_send(void *c, uint8_t *buf, uint32_t len)
+{
+	uint32_t copy;
+
+	copy = no_os_min(len, OUT_SIZE - conn.out_len);
+	memcpy(conn.out + conn.out_len, buf, copy);
+	conn.out_len += copy;
+
+	return conn.discard ? len : copy;
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* The model advances with the host clock, so the delays have to be real */
+static void mdelay_cb(uint32_t msecs, int cmock_num_calls)
+{
+	struct timespec ts = {
+		.tv_sec = msecs / 1000,
+		.tv_nsec = (msecs % 1000) * 1000000
+	};
+
+	nanosleep(&ts, NULL);
+}
+
+/* Model the cores and initialize their drivers */
+static void setup_cores(uint64_t sample_rate_hz)
+{
+	struct axi_io_model_init_param model = {
+		.type = AXI_IO_MODEL_DMAC,
+		.base = DMAC_BASE,
+		.core_base = ADC_BASE,
+	};
+	struct axi_dmac_init dmac_init = {
+		.name = "rx_dmac",
+		.base = DMAC_BASE,
+		.irq_option = IRQ_DISABLED,
+	};
+	struct axi_adc_init adc_init = {
+		.name = "adc",
+		.base = ADC_BASE,
+		.num_channels = NB_CHANNELS,
+	};
+	struct iio_axi_adc_init_param iio_adc_init = { 0 };
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_add(&model));
+	model = (struct axi_io_model_init_param) {
+		.type = AXI_IO_MODEL_ADC,
+		.base = ADC_BASE,
+		.num_channels = NB_CHANNELS,
+		.sample_rate_hz = sample_rate_hz,
+	};
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_add(&model));
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_dma_map(raw_buf,
+				sizeof(raw_buf)));
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_adc_init(&adc, &adc_init));
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_init(&dmac, &dmac_init));
+	iio_adc_init.rx_adc = adc;
+	iio_adc_init.rx_dmac = dmac;
+	TEST_ASSERT_EQUAL_INT32(0, iio_axi_adc_init(&iio_adc, &iio_adc_init));
+}
+
+static void setup_iio(uint32_t raw_buf_len)
+{
+	struct iio_local_backend backend = {
+		.local_backend_event_read = fake_recv,
+		.local_backend_event_write = fake_send,
+		.local_backend_buff = conn_buf,
+		.local_backend_buff_len = sizeof(conn_buf),
+	};
+	struct iio_device_init dev = {
+		.name = "adc",
+		.raw_buf = raw_buf,
+		.raw_buf_len = raw_buf_len,
+	};
+	struct iio_init_param param = {
+		.phy_type = USE_LOCAL_BACKEND,
+		.local_backend = &backend,
+		.devs = &dev,
+		.nb_devs = 1,
+	};
+
+	dev.dev = iio_adc;
+	iio_axi_adc_get_dev_descriptor(iio_adc, &dev.dev_descriptor);
+	TEST_ASSERT_EQUAL_INT(0, iio_init(&iio, &param));
+}
+
+/* Run one command, return the first line of the answer */
+static int32_t run(const char *cmd)
+{
+	uint32_t steps = 0;
+	int32_t ret;
+
+	conn.in = cmd;
+	conn.in_len = strlen(cmd);
+	conn.in_idx = 0;
+	conn.out_len = 0;
+	while ((ret = iio_step(iio)) == -EAGAIN)
+		TEST_ASSERT_TRUE(++steps < MAX_STEPS);
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	TEST_ASSERT_EQUAL_UINT32(conn.in_len, conn.in_idx);
+
+	return strtol((char *)conn.out, NULL, 10);
+}
+
+static void open_buffer(uint32_t samples)
+{
+	char cmd[64];
+
+	sprintf(cmd, "OPEN iio:device0 %u 00000003\n", (unsigned)samples);
+	TEST_ASSERT_EQUAL_INT32(0, run(cmd));
+}
+
+/* ADC frames hold the same 16 bits ramp value on each channel */
+static uint16_t frame_value(uint8_t *data, uint32_t frame)
+{
+	uint8_t *f = data + frame * FRAME_SIZE;
+	uint32_t ch;
+
+	for (ch = 1; ch < NB_CHANNELS; ch++)
+		TEST_ASSERT_EQUAL_UINT16(no_os_get_unaligned_le16(f),
+					 no_os_get_unaligned_le16(f + ch * 2));
+
+	return no_os_get_unaligned_le16(f);
+}
+
+/*
+ * Read len bytes and check that the blocks are received in order. Within a
+ * block the ramp is continuous. Between blocks it may only skip the frames
+ * which the DMAC dropped while no transfer was queued, counted in gap_frames.
+ */
+static void readbuf(uint32_t len)
+{
+	const char *mask = "00000003\n";
+	uint32_t frame, off;
+	uint8_t *data;
+	char cmd[64];
+	uint16_t val;
+
+	sprintf(cmd, "READBUF iio:device0 %u\n", (unsigned)len);
+	TEST_ASSERT_EQUAL_INT32(len, run(cmd));
+	off = strchr((char *)conn.out, '\n') - (char *)conn.out + 1;
+	TEST_ASSERT_EQUAL_STRING_LEN(mask, conn.out + off, strlen(mask));
+	off += strlen(mask);
+	TEST_ASSERT_EQUAL_UINT32(off + len, conn.out_len);
+	data = conn.out + off;
+
+	for (frame = 0; frame < len / FRAME_SIZE; frame++) {
+		val = frame_value(data, frame);
+		if (next_value >= 0) {
+			if (read_bytes % BLOCK_SIZE) {
+				TEST_ASSERT_EQUAL_UINT16(next_value, val);
+			} else if (val != next_value) {
+				gap_frames += (uint16_t)(val - next_value);
+				nb_gaps++;
+			}
+		}
+		next_value = (uint16_t)(val + 1);
+		read_bytes += FRAME_SIZE;
+	}
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	no_os_mdelay_StubWithCallback(mdelay_cb);
+	no_os_udelay_Ignore();
+
+	memset(&conn, 0, sizeof(conn));
+	read_bytes = 0;
+	next_value = -1;
+	gap_frames = 0;
+	nb_gaps = 0;
+}
+
+void tearDown(void)
+{
+	if (iio)
+		iio_remove(iio);
+	iio = NULL;
+	if (iio_adc)
+		iio_axi_adc_remove(iio_adc);
+	iio_adc = NULL;
+	if (dmac)
+		axi_dmac_remove(dmac);
+	dmac = NULL;
+	if (adc)
+		axi_adc_remove(adc);
+	adc = NULL;
+	axi_io_model_remove_all();
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_iio_axi_adc_stream(void)
+{
+	struct axi_io_model_stats stats;
+	uint32_t i, reg;
+	uint64_t bytes;
+
+	setup_cores(SAMPLE_RATE_HZ);
+	setup_iio(NB_BLOCKS * BLOCK_SIZE);
+	open_buffer(BLOCK_SAMPLES);
+
+	for (i = 0; i < NB_READS; i++) {
+		readbuf(BLOCK_SIZE);
+		/* Never more blocks in flight than the buffer holds */
+		TEST_ASSERT_TRUE(iio_adc->nb_blocks <= NB_BLOCKS);
+	}
+
+	/*
+	 * Every block received by the client was completed by the DMAC and
+	 * marked done once. The other completed blocks are still in the buffer.
+	 * The samples missing between the received blocks were dropped by the
+	 * DMAC, the DMAC may have dropped more since then.
+	 */
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_TRUE(stats.transfers >= NB_READS);
+	TEST_ASSERT_TRUE(stats.transfers - NB_READS <= NB_BLOCKS);
+	TEST_ASSERT_TRUE(gap_frames * FRAME_SIZE <= stats.dropped_bytes);
+	TEST_ASSERT_EQUAL_UINT32(0, stats.dma_errors);
+
+	/* post_disable stops the DMA */
+	TEST_ASSERT_EQUAL_INT32(0, run("CLOSE iio:device0\n"));
+	TEST_ASSERT_EQUAL_UINT32(0, iio_adc->nb_blocks);
+	TEST_ASSERT_EQUAL_INT32(0, no_os_axi_io_read(DMAC_BASE, DMAC_REG_CTRL,
+				&reg));
+	TEST_ASSERT_EQUAL_UINT32(0, reg & DMAC_CTRL_ENABLE);
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	bytes = stats.bytes;
+	mdelay_cb(5, 0);
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_EQUAL_UINT64(bytes, stats.bytes);
+}
+
+/*
+ * The blocks started together are queued in the DMAC, which streams them
+ * without dropping samples. Samples may only be dropped between two refills,
+ * each drop being counted as one burst.
+ */
+void test_iio_axi_adc_dropped_bursts(void)
+{
+	struct axi_io_model_stats stats;
+	uint32_t i;
+
+	setup_cores(SAMPLE_RATE_HZ);
+	setup_iio(NB_BLOCKS * BLOCK_SIZE);
+	open_buffer(BLOCK_SAMPLES);
+
+	/* The first refill queues all the blocks */
+	for (i = 0; i < NB_BLOCKS; i++)
+		readbuf(BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_UINT64(0, gap_frames);
+
+	for (i = 0; i < NB_READS; i++)
+		readbuf(BLOCK_SIZE);
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_TRUE(nb_gaps <= stats.dropped_bursts);
+	/* At most one burst is dropped before each refill and after the last */
+	TEST_ASSERT_TRUE(stats.dropped_bursts <= NB_BLOCKS + NB_READS + 1);
+	TEST_ASSERT_TRUE(gap_frames * FRAME_SIZE <= stats.dropped_bytes);
+
+	TEST_ASSERT_EQUAL_INT32(0, run("CLOSE iio:device0\n"));
+}
+
+void test_iio_axi_adc_readbuf_tail(void)
+{
+	/* Two blocks, read by READBUFs which don't match them */
+	setup_cores(SAMPLE_RATE_HZ);
+	setup_iio(2 * BLOCK_SIZE);
+	open_buffer(BLOCK_SAMPLES);
+
+	readbuf(BLOCK_SIZE / 2);
+	/* More than the data left and the free blocks */
+	readbuf(3 * BLOCK_SIZE);
+	readbuf(BLOCK_SIZE + FRAME_SIZE);
+	readbuf(BLOCK_SIZE - FRAME_SIZE);
+
+	TEST_ASSERT_EQUAL_INT32(0, run("CLOSE iio:device0\n"));
+}
+
+#ifdef NO_OS_TEST_BENCH
+/*
+ * Stream BENCH_READS blocks from a fast ADC through a buffer of nb_blocks
+ * blocks. Report the throughput seen by the client and the share of the
+ * samples which the DMAC had to drop.
+ */
+static void stream_bench(uint32_t nb_blocks)
+{
+	struct axi_io_model_stats stats;
+	struct timespec start;
+	char cmd[64], msg[128];
+	double elapsed;
+	uint32_t i;
+
+	setup_cores(BENCH_RATE_HZ);
+	setup_iio(nb_blocks * BENCH_BLOCK_SIZE);
+	open_buffer(BENCH_BLOCK_SAMPLES);
+
+	sprintf(cmd, "READBUF iio:device0 %u\n", (unsigned)BENCH_BLOCK_SIZE);
+	conn.discard = true;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_READS; i++)
+		TEST_ASSERT_EQUAL_INT32(BENCH_BLOCK_SIZE, run(cmd));
+	elapsed = bench_elapsed_s(&start);
+	conn.discard = false;
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_EQUAL_INT32(0, run("CLOSE iio:device0\n"));
+
+	snprintf(msg, sizeof(msg),
+		 "%s, %u blocks of %u bytes: %.1f MB/s, %.1f%% dropped in %u "
+		 "bursts", BENCH_READBUF, (unsigned)nb_blocks,
+		 (unsigned)BENCH_BLOCK_SIZE,
+		 (double)BENCH_READS * BENCH_BLOCK_SIZE / elapsed / 1e6,
+		 100.0 * stats.dropped_bytes /
+		 (stats.bytes + stats.dropped_bytes),
+		 (unsigned)stats.dropped_bursts);
+	TEST_MESSAGE(msg);
+
+	tearDown();
+}
+
+void test_iio_axi_adc_stream_bench(void)
+{
+	stream_bench(1);
+	stream_bench(2);
+	stream_bench(NB_BLOCKS);
+}
+#endif
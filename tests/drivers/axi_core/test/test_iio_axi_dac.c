@@ -0,0 +1,386 @@
+/***************************************************************************//**
+ *   @file   test_iio_axi_adc.c
+ *   @brief  Unit tests and benchmarks of the AXI DAC IIO buffer streaming.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "axi_dac_core.h"
+#include "axi_dmac.h"
+#include "axi_io_model.h"
+#include "iio.h"
+#include "iio_axi_dac.h"
+#include "iiod.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_list.h"
+#include "no_os_util.h"
+#include "mock_no_os_delay.h"
+#include "mock_no_os_uart.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define DMAC_BASE		0x1000
+#define DAC_BASE		0x3000
+#define NB_CHANNELS		2
+/* One 16 bits sample for each channel */
+#define FRAME_SIZE		(NB_CHANNELS * 2)
+#define SAMPLE_RATE_HZ		1000000
+#define BLOCK_SAMPLES		256
+#define BLOCK_SIZE		(BLOCK_SAMPLES * FRAME_SIZE)
+#define NB_WRITES		16
+/* Time during which a cyclic buffer is played before being closed */
+#define CYCLIC_MS		20
+#define CONN_BUF_SIZE		0x1000
+#define MAX_STEPS		100000
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_RATE_HZ		100000000
+#define BENCH_BLOCK_SAMPLES	16384
+#define BENCH_BLOCK_SIZE	(BENCH_BLOCK_SAMPLES * FRAME_SIZE)
+#define BENCH_WRITES		400
+#define RAW_BUF_SIZE		BENCH_BLOCK_SIZE
+#else
+#define RAW_BUF_SIZE		BLOCK_SIZE
+#endif
+/* Largest WRITEBUF, with its data, followed by a CLOSE */
+#define IN_SIZE			(RAW_BUF_SIZE + 64)
+
+/* Local backend connection: command to be received and the answer */
+struct fake_conn {
+	char in[IN_SIZE];
+	uint32_t in_len;
+	uint32_t in_idx;
+	/* The bytes from hold_idx are only received after release_ns */
+	uint32_t hold_idx;
+	uint64_t release_ns;
+	char out[64];
+	uint32_t out_len;
+};
+
+static int8_t raw_buf[RAW_BUF_SIZE];
+static char conn_buf[CONN_BUF_SIZE];
+static struct fake_conn conn;
+static struct axi_dac *dac;
+static struct axi_dmac *dmac;
+static struct iio_axi_dac_desc *iio_dac;
+static struct iio_desc *iio;
+
+/*******************************************************************************
+ *    FAKE CONNECTION
+ ******************************************************************************/
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int fake_recv(void *c, uint8_t *buf, uint32_t len)
+{
+	uint32_t end = conn.in_len;
+
+	if (conn.hold_idx && now_ns() < conn.release_ns)
+		end = conn.hold_idx;
+	len = no_os_min(len, end - conn.in_idx);
+	if (!len)
+		return -EAGAIN;
+
+	memcpy(buf, conn.in + conn.in_idx, len);
+	conn.in_idx += len;
+
+	return len;
+}
+
+static int fake_send(void *c, uint8_t *buf, uint32_t len)
+{
+	len = no_os_min(len, sizeof(conn.out) - 1 - conn.out_len);
+	memcpy(conn.out + conn.out_len, buf, len);
+	conn.out_len += len;
+
+	return len;
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* The model advances with the host clock, so the delays have to be real */
+static void mdelay_cb(uint32_t msecs, int cmock_num_calls)
+{
+	struct timespec ts = {
+		.tv_sec = msecs / 1000,
+		.tv_nsec = (msecs % 1000) * 1000000
+	};
+
+	nanosleep(&ts, NULL);
+}
+
+/* Model the cores and initialize the drivers */
+static void setup(uint64_t sample_rate_hz, uint32_t raw_buf_len)
+{
+	struct axi_io_model_init_param model = {
+		.type = AXI_IO_MODEL_DMAC,
+		.base = DMAC_BASE,
+		.core_base = DAC_BASE,
+		.hw_cyclic = true,
+	};
+	struct axi_dmac_init dmac_init = {
+		.name = "tx_dmac",
+		.base = DMAC_BASE,
+		.irq_option = IRQ_DISABLED,
+	};
+	struct axi_dac_init dac_init = {
+		.name = "dac",
+		.base = DAC_BASE,
+		.num_channels = NB_CHANNELS,
+	};
+	struct iio_axi_dac_init_param iio_dac_init = { 0 };
+	struct iio_local_backend backend = {
+		.local_backend_event_read = fake_recv,
+		.local_backend_event_write = fake_send,
+		.local_backend_buff = conn_buf,
+		.local_backend_buff_len = sizeof(conn_buf),
+	};
+	struct iio_device_init dev = {
+		.name = "dac",
+		.raw_buf = raw_buf,
+		.raw_buf_len = raw_buf_len,
+	};
+	struct iio_init_param param = {
+		.phy_type = USE_LOCAL_BACKEND,
+		.local_backend = &backend,
+		.devs = &dev,
+		.nb_devs = 1,
+	};
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_add(&model));
+	model = (struct axi_io_model_init_param) {
+		.type = AXI_IO_MODEL_DAC,
+		.base = DAC_BASE,
+		.num_channels = NB_CHANNELS,
+		.sample_rate_hz = sample_rate_hz,
+	};
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_add(&model));
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_dma_map(raw_buf,
+				sizeof(raw_buf)));
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_dac_init(&dac, &dac_init));
+	TEST_ASSERT_EQUAL_INT32(0, axi_dmac_init(&dmac, &dmac_init));
+	iio_dac_init.tx_dac = dac;
+	iio_dac_init.tx_dmac = dmac;
+	TEST_ASSERT_EQUAL_INT32(0, iio_axi_dac_init(&iio_dac, &iio_dac_init));
+
+	dev.dev = iio_dac;
+	iio_axi_dac_get_dev_descriptor(iio_dac, &dev.dev_descriptor);
+	TEST_ASSERT_EQUAL_INT(0, iio_init(&iio, &param));
+}
+
+/* Run the command in conn.in, return the first line of the answer */
+static int32_t run_in(void)
+{
+	uint32_t steps = 0;
+	int32_t ret;
+
+	conn.in_idx = 0;
+	conn.out_len = 0;
+	memset(conn.out, 0, sizeof(conn.out));
+	while ((ret = iio_step(iio)) == -EAGAIN)
+		TEST_ASSERT_TRUE(++steps < MAX_STEPS);
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	TEST_ASSERT_EQUAL_UINT32(conn.in_len, conn.in_idx);
+
+	return strtol(conn.out, NULL, 10);
+}
+
+static int32_t run(const char *cmd)
+{
+	conn.in_len = strlen(cmd);
+	memcpy(conn.in, cmd, conn.in_len);
+
+	return run_in();
+}
+
+/* Prepare a WRITEBUF of len bytes set to val, run it with run_in() */
+static void writebuf_cmd(uint32_t len, uint8_t val)
+{
+	conn.in_len = sprintf(conn.in, "WRITEBUF iio:device0 %u\n",
+			      (unsigned)len);
+	memset(conn.in + conn.in_len, val, len);
+	conn.in_len += len;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	no_os_mdelay_StubWithCallback(mdelay_cb);
+	no_os_udelay_Ignore();
+
+	memset(&conn, 0, sizeof(conn));
+}
+
+void tearDown(void)
+{
+	if (iio)
+		iio_remove(iio);
+	iio = NULL;
+	if (iio_dac)
+		iio_axi_dac_remove(iio_dac);
+	iio_dac = NULL;
+	if (dmac)
+		axi_dmac_remove(dmac);
+	dmac = NULL;
+	if (dac)
+		axi_dac_remove(dac);
+	dac = NULL;
+	axi_io_model_remove_all();
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/*
+ * Each WRITEBUF replaces the cyclic transfer of the DMAC. All the bytes sent
+ * to the DAC come from the blocks written, so with every byte set to 1 their
+ * sum is the number of bytes sent.
+ */
+void test_iio_axi_dac_writebuf(void)
+{
+	struct axi_io_model_stats stats;
+	uint64_t bytes = 0;
+	uint32_t i;
+
+	setup(SAMPLE_RATE_HZ, BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_INT32(0, run("OPEN iio:device0 256 00000003\n"));
+
+	writebuf_cmd(BLOCK_SIZE, 1);
+	for (i = 0; i < NB_WRITES; i++) {
+		TEST_ASSERT_EQUAL_INT32(BLOCK_SIZE, run_in());
+		mdelay_cb(1, 0);
+		TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE,
+					&stats));
+		TEST_ASSERT_TRUE(stats.bytes > bytes);
+		bytes = stats.bytes;
+	}
+
+	TEST_ASSERT_EQUAL_UINT32((uint32_t)stats.bytes, stats.dac_checksum);
+	TEST_ASSERT_EQUAL_UINT64(0, stats.dropped_bytes);
+	TEST_ASSERT_EQUAL_UINT32(0, stats.dma_errors);
+
+	TEST_ASSERT_EQUAL_INT32(0, run("CLOSE iio:device0\n"));
+}
+
+/*
+ * After the WRITEBUF of a cyclic buffer, iiod pushes the buffer again until
+ * CLOSE is received. These pushes have no new data and must leave the
+ * transfer started by the first one alone.
+ */
+void test_iio_axi_dac_cyclic_writebuf(void)
+{
+	const char *close_cmd = "CLOSE iio:device0\n";
+	struct axi_io_model_stats stats;
+
+	setup(SAMPLE_RATE_HZ, BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_INT32(0, run("OPEN iio:device0 256 00000003 CYCLIC\n"));
+
+	writebuf_cmd(BLOCK_SIZE, 1);
+	conn.hold_idx = conn.in_len;
+	conn.release_ns = now_ns() + CYCLIC_MS * 1000000ULL;
+	strcpy(conn.in + conn.in_len, close_cmd);
+	conn.in_len += strlen(close_cmd);
+	TEST_ASSERT_EQUAL_INT32(BLOCK_SIZE, run_in());
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_TRUE(stats.bytes > BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_UINT32((uint32_t)stats.bytes, stats.dac_checksum);
+	TEST_ASSERT_EQUAL_UINT64(0, stats.dropped_bytes);
+	TEST_ASSERT_EQUAL_UINT32(0, stats.dma_errors);
+}
+
+#ifdef NO_OS_TEST_BENCH
+/*
+ * Write BENCH_WRITES blocks for a fast DAC, each one replacing the previous
+ * one. Report the throughput seen by the client and the one of the DAC.
+ */
+void test_iio_axi_dac_writebuf_bench(void)
+{
+	struct axi_io_model_stats stats;
+	struct timespec start;
+	double elapsed;
+	char msg[128];
+	uint32_t i;
+
+	setup(BENCH_RATE_HZ, BENCH_BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_INT32(0, run("OPEN iio:device0 16384 00000003\n"));
+
+	writebuf_cmd(BENCH_BLOCK_SIZE, 1);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_WRITES; i++)
+		TEST_ASSERT_EQUAL_INT32(BENCH_BLOCK_SIZE, run_in());
+	elapsed = bench_elapsed_s(&start);
+
+	TEST_ASSERT_EQUAL_INT32(0, axi_io_model_get_stats(DMAC_BASE, &stats));
+	TEST_ASSERT_EQUAL_INT32(0, run("CLOSE iio:device0\n"));
+
+	snprintf(msg, sizeof(msg),
+		 "blocks of %u bytes: %.1f MB/s written, %.1f MB/s sent to the DAC",
+		 (unsigned)BENCH_BLOCK_SIZE,
+		 (double)BENCH_WRITES * BENCH_BLOCK_SIZE / elapsed / 1e6,
+		 (double)stats.bytes / elapsed / 1e6);
+	TEST_MESSAGE(msg);
+}
+#endif
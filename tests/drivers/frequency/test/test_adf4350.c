@@ -0,0 +1,329 @@
+/***************************************************************************//**
+ *   @file   test_adf4350.c
+ *   @brief  Unit tests and benchmark of the ADF4350 frequency hopping.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "adf4350.h"
+#include "no_os_util.h"
+#include "mock_no_os_alloc.h"
+#include "mock_no_os_spi.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define FAKE_NB_DEVS		2
+#define FAKE_NB_REGS		6
+#define FAKE_LOG_LEN		16
+#define NB_HOPS			64
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_ROUNDS		2000
+#endif
+
+/* Model of the device registers and of the bus traffic */
+struct fake_adf4350 {
+	/* Registers of each device, selected by the SPI descriptor */
+	uint32_t regs[FAKE_NB_DEVS][FAKE_NB_REGS];
+	uint32_t nb_devs;
+	/* Register writes, in order */
+	uint32_t log[FAKE_LOG_LEN];
+	uint32_t nb_log;
+	/* Open batches and number of messages queued in the current one */
+	uint32_t depth;
+	uint32_t queued;
+	/* Bus transactions, messages and bytes sent */
+	uint32_t transfers;
+	uint32_t msgs;
+	uint32_t bytes;
+	int32_t batch_end_ret;
+};
+
+static struct fake_adf4350 fake;
+static struct no_os_spi_desc fake_spi[FAKE_NB_DEVS];
+static adf4350_dev *dev;
+static uint64_t freqs[NB_HOPS];
+static struct adf4350_hop table[NB_HOPS];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int32_t fake_queue_msg(struct no_os_spi_desc *desc, uint8_t *data,
+			      uint8_t *rx_buff, uint16_t bytes_number,
+			      int cmock_num_calls)
+{
+	uint32_t word;
+
+	TEST_ASSERT_EQUAL_INT(4, bytes_number);
+	word = no_os_get_unaligned_be32(data);
+	TEST_ASSERT_TRUE((word & 0x7) < FAKE_NB_REGS);
+	fake.regs[desc - fake_spi][word & 0x7] = word & ~0x7;
+	if (fake.nb_log < FAKE_LOG_LEN)
+		fake.log[fake.nb_log++] = word;
+	fake.msgs++;
+	fake.bytes += bytes_number;
+
+	if (fake.depth)
+		fake.queued++;
+	else
+		fake.transfers++;
+
+	return 0;
+}
+
+static int32_t fake_batch_begin(struct no_os_spi_desc *desc,
+				int cmock_num_calls)
+{
+	fake.depth++;
+
+	return 0;
+}
+
+static int32_t fake_batch_end(struct no_os_spi_desc *desc,
+			      int cmock_num_calls)
+{
+	TEST_ASSERT_TRUE(fake.depth > 0);
+	if (--fake.depth)
+		return 0;
+	if (fake.queued)
+		fake.transfers++;
+	fake.queued = 0;
+
+	return fake.batch_end_ret;
+}
+
+static int32_t fake_spi_init(struct no_os_spi_desc **desc,
+			     const struct no_os_spi_init_param *param,
+			     int cmock_num_calls)
+{
+	TEST_ASSERT_TRUE(fake.nb_devs < FAKE_NB_DEVS);
+	*desc = &fake_spi[fake.nb_devs++];
+
+	return 0;
+}
+
+static void *fake_malloc(size_t size, int cmock_num_calls)
+{
+	return calloc(1, size);
+}
+
+static void init(adf4350_dev **device)
+{
+	adf4350_init_param param = {
+		.clkin = 25000000,
+		.channel_spacing = 10000,
+		.power_up_frequency = 2500000000UL,
+		.charge_pump_current = 2500,
+		.muxout_select = 6,
+		.output_power = 3,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, adf4350_setup(device, param));
+}
+
+static void remove_dev(adf4350_dev *device)
+{
+	free(device->pdata);
+	free(device);
+}
+
+static void reset_counters(void)
+{
+	fake.nb_log = 0;
+	fake.transfers = 0;
+	fake.msgs = 0;
+	fake.bytes = 0;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	memset(&fake, 0, sizeof(fake));
+	no_os_spi_queue_msg_StubWithCallback(fake_queue_msg);
+	no_os_spi_batch_begin_StubWithCallback(fake_batch_begin);
+	no_os_spi_batch_end_StubWithCallback(fake_batch_end);
+	no_os_spi_init_StubWithCallback(fake_spi_init);
+	no_os_malloc_StubWithCallback(fake_malloc);
+
+	/* 100 kHz steps around 2.5 GHz, in the fractional mode */
+	for (i = 0; i < NB_HOPS; i++)
+		freqs[i] = 2500000000ULL + i * 100000ULL + 20000;
+
+	init(&dev);
+	reset_counters();
+}
+
+void tearDown(void)
+{
+	remove_dev(dev);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_adf4350_hop_same_registers_as_set_freq(void)
+{
+	adf4350_dev *ref;
+	uint32_t i;
+
+	init(&ref);
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop_table_init(dev, freqs, NB_HOPS,
+			      table));
+
+	for (i = 0; i < NB_HOPS; i++) {
+		TEST_ASSERT_EQUAL_INT(freqs[i],
+				      adf4350_out_altvoltage0_frequency(ref,
+						      freqs[i]));
+		TEST_ASSERT_EQUAL_INT(0, adf4350_hop(dev, &table[i]));
+		TEST_ASSERT_EQUAL_UINT32_ARRAY(fake.regs[1], fake.regs[0],
+					       FAKE_NB_REGS);
+		TEST_ASSERT_EQUAL_UINT32(ref->r0_int, dev->r0_int);
+		TEST_ASSERT_EQUAL_UINT32(ref->r0_fract, dev->r0_fract);
+		TEST_ASSERT_EQUAL_UINT32(ref->r1_mod, dev->r1_mod);
+	}
+
+	remove_dev(ref);
+}
+
+void test_adf4350_hop_sequence(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop_table_init(dev, freqs, 2, table));
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop(dev, &table[1]));
+
+	/* One transaction, register 0 last */
+	TEST_ASSERT_EQUAL_UINT32(1, fake.transfers);
+	TEST_ASSERT_TRUE(fake.nb_log >= 1);
+	TEST_ASSERT_EQUAL_UINT32(table[1].regs[0], fake.log[fake.nb_log - 1]);
+
+	/* Nothing to write when hopping to the current frequency */
+	reset_counters();
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop(dev, &table[1]));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.msgs);
+	TEST_ASSERT_EQUAL_UINT32(0, fake.transfers);
+}
+
+void test_adf4350_hop_divider_only(void)
+{
+	const uint64_t div_freqs[] = {2500000000ULL, 1250000000ULL};
+
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop_table_init(dev, div_freqs, 2,
+			      table));
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop(dev, &table[0]));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.msgs);
+
+	/* Register 4, then the double buffered values are loaded by register 0 */
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop(dev, &table[1]));
+	TEST_ASSERT_EQUAL_UINT32(2, fake.msgs);
+	TEST_ASSERT_EQUAL_UINT32(table[1].regs[4] | 4, fake.log[0]);
+	TEST_ASSERT_EQUAL_UINT32(table[1].regs[0], fake.log[1]);
+}
+
+void test_adf4350_hop_error(void)
+{
+	const uint64_t bad = ADF4350_MAX_OUT_FREQ + 1;
+
+	TEST_ASSERT_EQUAL_INT(-1, adf4350_hop_table_init(dev, &bad, 1, table));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adf4350_hop_table_init(dev, NULL, 1,
+			      table));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adf4350_hop(dev, NULL));
+
+	/* A failed batch forces a full register write on the next hop */
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop_table_init(dev, freqs, 2, table));
+	fake.batch_end_ret = -EIO;
+	TEST_ASSERT_EQUAL_INT(-EIO, adf4350_hop(dev, &table[1]));
+	fake.batch_end_ret = 0;
+	reset_counters();
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop(dev, &table[1]));
+	TEST_ASSERT_EQUAL_UINT32(FAKE_NB_REGS, fake.msgs);
+}
+
+#ifdef NO_OS_TEST_BENCH
+void test_adf4350_hop_benchmark(void)
+{
+	uint32_t set_bytes, hop_bytes, hop_xfers, i, r;
+	struct timespec start;
+	double set_rate, hop_rate;
+	char msg[160];
+
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop_table_init(dev, freqs, NB_HOPS,
+			      table));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (r = 0; r < BENCH_ROUNDS; r++)
+		for (i = 0; i < NB_HOPS; i++)
+			adf4350_out_altvoltage0_frequency(dev, freqs[i]);
+	set_rate = BENCH_ROUNDS * NB_HOPS / bench_elapsed_s(&start);
+	set_bytes = fake.bytes;
+
+	reset_counters();
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (r = 0; r < BENCH_ROUNDS; r++)
+		for (i = 0; i < NB_HOPS; i++)
+			adf4350_hop(dev, &table[i]);
+	hop_rate = BENCH_ROUNDS * NB_HOPS / bench_elapsed_s(&start);
+	hop_bytes = fake.bytes;
+	hop_xfers = fake.transfers;
+
+	snprintf(msg, sizeof(msg),
+		 "adf4350 set_freq: %.0f hops/s, %.1f bytes/hop; hop: %.0f hops/s, "
+		 "%.1f bytes/hop, %.1f transfers/hop",
+		 set_rate, (double)set_bytes / (BENCH_ROUNDS * NB_HOPS), hop_rate,
+		 (double)hop_bytes / (BENCH_ROUNDS * NB_HOPS),
+		 (double)hop_xfers / (BENCH_ROUNDS * NB_HOPS));
+	TEST_MESSAGE(msg);
+
+	/* set_freq already skips the unchanged registers, in two transactions */
+	TEST_ASSERT_TRUE(hop_bytes <= set_bytes);
+	TEST_ASSERT_EQUAL_UINT32(BENCH_ROUNDS * NB_HOPS, hop_xfers);
+}
+#endif
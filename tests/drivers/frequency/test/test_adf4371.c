@@ -0,0 +1,382 @@
+/***************************************************************************//**
+ *   @file   test_adf4371.c
+ *   @brief  Unit tests and benchmark of the ADF4371 frequency hopping.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "adf4371.h"
+#include "no_os_util.h"
+#include "mock_no_os_alloc.h"
+#include "mock_no_os_spi.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define FAKE_NB_DEVS		2
+#define FAKE_NB_REGS		0x80
+#define FAKE_LOG_LEN		32
+#define NB_HOPS			64
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_ROUNDS		2000
+#endif
+
+/* Register write seen on the bus */
+struct fake_write {
+	uint16_t addr;
+	uint8_t len;
+};
+
+/* Model of the device registers and of the bus traffic */
+struct fake_adf4371 {
+	/* Registers of each device, selected by the SPI descriptor */
+	uint8_t regs[FAKE_NB_DEVS][FAKE_NB_REGS];
+	uint32_t nb_devs;
+	/* Register writes, in order */
+	struct fake_write log[FAKE_LOG_LEN];
+	uint32_t nb_log;
+	/* Open batches and number of messages queued in the current one */
+	uint32_t depth;
+	uint32_t queued;
+	/* Bus transactions, messages and bytes sent */
+	uint32_t transfers;
+	uint32_t msgs;
+	uint32_t bytes;
+	int32_t batch_end_ret;
+};
+
+static struct fake_adf4371 fake;
+static struct no_os_spi_desc fake_spi[FAKE_NB_DEVS];
+static struct adf4371_dev *dev;
+static uint64_t freqs[NB_HOPS];
+static struct adf4371_hop table[NB_HOPS];
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* Streaming access, with the address incremented after each data byte */
+static void fake_access(struct no_os_spi_desc *desc, uint8_t *data,
+			uint16_t bytes_number)
+{
+	uint8_t *regs = fake.regs[desc - fake_spi];
+	uint16_t cmd, addr, i;
+
+	TEST_ASSERT_TRUE(bytes_number >= 3);
+	cmd = no_os_get_unaligned_be16(data);
+	addr = cmd & 0x7FFF;
+	TEST_ASSERT_TRUE(addr + bytes_number - 2 <= FAKE_NB_REGS);
+
+	fake.msgs++;
+	fake.bytes += bytes_number;
+
+	if (cmd & NO_OS_BIT(15)) {
+		for (i = 2; i < bytes_number; i++)
+			data[i] = regs[addr + i - 2];
+		return;
+	}
+
+	for (i = 2; i < bytes_number; i++)
+		regs[addr + i - 2] = data[i];
+	if (fake.nb_log < FAKE_LOG_LEN) {
+		fake.log[fake.nb_log].addr = addr;
+		fake.log[fake.nb_log++].len = bytes_number - 2;
+	}
+}
+
+static int32_t fake_queue_msg(struct no_os_spi_desc *desc, uint8_t *data,
+			      uint8_t *rx_buff, uint16_t bytes_number,
+			      int cmock_num_calls)
+{
+	fake_access(desc, data, bytes_number);
+	if (fake.depth)
+		fake.queued++;
+	else
+		fake.transfers++;
+
+	return 0;
+}
+
+static int32_t fake_write_and_read(struct no_os_spi_desc *desc, uint8_t *data,
+				   uint16_t bytes_number, int cmock_num_calls)
+{
+	/* Reads are never queued */
+	TEST_ASSERT_EQUAL_UINT32(0, fake.queued);
+	fake_access(desc, data, bytes_number);
+	fake.transfers++;
+
+	return 0;
+}
+
+static int32_t fake_batch_begin(struct no_os_spi_desc *desc,
+				int cmock_num_calls)
+{
+	fake.depth++;
+
+	return 0;
+}
+
+static int32_t fake_batch_end(struct no_os_spi_desc *desc,
+			      int cmock_num_calls)
+{
+	TEST_ASSERT_TRUE(fake.depth > 0);
+	if (--fake.depth)
+		return 0;
+	if (fake.queued)
+		fake.transfers++;
+	fake.queued = 0;
+
+	return fake.batch_end_ret;
+}
+
+static int32_t fake_spi_init(struct no_os_spi_desc **desc,
+			     const struct no_os_spi_init_param *param,
+			     int cmock_num_calls)
+{
+	TEST_ASSERT_TRUE(fake.nb_devs < FAKE_NB_DEVS);
+	*desc = &fake_spi[fake.nb_devs++];
+
+	return 0;
+}
+
+static void *fake_calloc(size_t nitems, size_t size, int cmock_num_calls)
+{
+	return calloc(nitems, size);
+}
+
+static void fake_free(void *ptr, int cmock_num_calls)
+{
+	free(ptr);
+}
+
+static void init(struct adf4371_dev **device)
+{
+	struct adf4371_chan_spec channel = {
+		.num = 0,
+		.power_up_frequency = 5000000000ULL,
+	};
+	struct adf4371_init_param param = {
+		.clkin_frequency = 122880000,
+		.muxout_select = 1,
+		.num_channels = 1,
+		.channels = &channel,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, adf4371_init(device, &param));
+}
+
+static void reset_counters(void)
+{
+	fake.nb_log = 0;
+	fake.transfers = 0;
+	fake.msgs = 0;
+	fake.bytes = 0;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	memset(&fake, 0, sizeof(fake));
+	no_os_spi_queue_msg_StubWithCallback(fake_queue_msg);
+	no_os_spi_write_and_read_StubWithCallback(fake_write_and_read);
+	no_os_spi_batch_begin_StubWithCallback(fake_batch_begin);
+	no_os_spi_batch_end_StubWithCallback(fake_batch_end);
+	no_os_spi_init_StubWithCallback(fake_spi_init);
+	no_os_spi_remove_IgnoreAndReturn(0);
+	no_os_calloc_StubWithCallback(fake_calloc);
+	no_os_free_StubWithCallback(fake_free);
+
+	/* 1 MHz steps around 5 GHz, in the fractional mode */
+	for (i = 0; i < NB_HOPS; i++)
+		freqs[i] = 5000000000ULL + i * 1000000ULL + 12345;
+
+	init(&dev);
+	reset_counters();
+}
+
+void tearDown(void)
+{
+	adf4371_remove(dev);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_adf4371_hop_same_registers_as_set_rate(void)
+{
+	struct adf4371_dev *ref;
+	uint64_t rate;
+	uint32_t i;
+
+	init(&ref);
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop_table_init(dev, 0, freqs, NB_HOPS,
+			      table));
+
+	for (i = 0; i < NB_HOPS; i++) {
+		TEST_ASSERT_EQUAL_INT(0, adf4371_clk_set_rate(ref, 0, freqs[i]));
+		TEST_ASSERT_EQUAL_INT(0, adf4371_hop(dev, &table[i]));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(fake.regs[1], fake.regs[0],
+					      FAKE_NB_REGS);
+
+		TEST_ASSERT_EQUAL_INT(0, adf4371_clk_recalc_rate(dev, 0, &rate));
+		TEST_ASSERT_UINT64_WITHIN(1, freqs[i], rate);
+	}
+
+	adf4371_remove(ref);
+}
+
+void test_adf4371_hop_sequence(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop_table_init(dev, 0, freqs, 2,
+			      table));
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop(dev, &table[1]));
+
+	/* One transaction, no read, register 0x10 last */
+	TEST_ASSERT_EQUAL_UINT32(1, fake.transfers);
+	TEST_ASSERT_TRUE(fake.nb_log >= 2);
+	TEST_ASSERT_EQUAL_UINT16(0x10, fake.log[fake.nb_log - 1].addr);
+	TEST_ASSERT_EQUAL_UINT8(1, fake.log[fake.nb_log - 1].len);
+
+	/* The fractional words are written with one streaming write */
+	TEST_ASSERT_TRUE(fake.log[0].addr >= 0x11);
+	TEST_ASSERT_TRUE(fake.log[0].addr + fake.log[0].len <= 0x1B);
+	TEST_ASSERT_TRUE(fake.log[0].len < 10);
+
+	/* Nothing to write when hopping to the current frequency */
+	reset_counters();
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop(dev, &table[1]));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.msgs);
+	TEST_ASSERT_EQUAL_UINT32(0, fake.transfers);
+}
+
+void test_adf4371_hop_divider_only(void)
+{
+	const uint64_t div_freqs[] = {5000000000ULL, 2500000000ULL};
+
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop_table_init(dev, 0, div_freqs, 2,
+			      table));
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop(dev, &table[0]));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.msgs);
+
+	/* Same VCO frequency: the RF divider, then register 0x10 */
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop(dev, &table[1]));
+	TEST_ASSERT_EQUAL_UINT32(2, fake.msgs);
+	TEST_ASSERT_EQUAL_UINT32(6, fake.bytes);
+	TEST_ASSERT_EQUAL_UINT16(0x24, fake.log[0].addr);
+	TEST_ASSERT_EQUAL_UINT16(0x10, fake.log[1].addr);
+	TEST_ASSERT_EQUAL_HEX8(0x80 | (1 << 4), fake.regs[0][0x24]);
+}
+
+void test_adf4371_hop_error(void)
+{
+	/* Over the 8 GHz maximum of RF8 */
+	const uint64_t bad = 8000000001ULL;
+
+	TEST_ASSERT_EQUAL_INT(-1, adf4371_hop_table_init(dev, 0, &bad, 1,
+			      table));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adf4371_hop_table_init(dev, 4, freqs, 1,
+			      table));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adf4371_hop(dev, NULL));
+
+	/* A failed batch forces a full register write on the next hop */
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop_table_init(dev, 0, freqs, 2,
+			      table));
+	fake.batch_end_ret = -EIO;
+	TEST_ASSERT_EQUAL_INT(-EIO, adf4371_hop(dev, &table[1]));
+	fake.batch_end_ret = 0;
+	reset_counters();
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop(dev, &table[1]));
+	/* Bulk write, 0x1F, read and write of 0x24, 0x26, 0x2B and 0x10 */
+	TEST_ASSERT_EQUAL_UINT32(7, fake.msgs);
+}
+
+#ifdef NO_OS_TEST_BENCH
+void test_adf4371_hop_benchmark(void)
+{
+	uint32_t set_bytes, set_xfers, hop_bytes, hop_xfers, i, r;
+	struct timespec start;
+	double set_rate, hop_rate;
+	char msg[160];
+
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop_table_init(dev, 0, freqs, NB_HOPS,
+			      table));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (r = 0; r < BENCH_ROUNDS; r++)
+		for (i = 0; i < NB_HOPS; i++)
+			adf4371_clk_set_rate(dev, 0, freqs[i]);
+	set_rate = BENCH_ROUNDS * NB_HOPS / bench_elapsed_s(&start);
+	set_bytes = fake.bytes;
+	set_xfers = fake.transfers;
+
+	reset_counters();
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (r = 0; r < BENCH_ROUNDS; r++)
+		for (i = 0; i < NB_HOPS; i++)
+			adf4371_hop(dev, &table[i]);
+	hop_rate = BENCH_ROUNDS * NB_HOPS / bench_elapsed_s(&start);
+	hop_bytes = fake.bytes;
+	hop_xfers = fake.transfers;
+
+	snprintf(msg, sizeof(msg),
+		 "adf4371 set_rate: %.0f hops/s, %.1f bytes/hop, %.1f transfers/hop; "
+		 "hop: %.0f hops/s, %.1f bytes/hop, %.1f transfers/hop",
+		 set_rate, (double)set_bytes / (BENCH_ROUNDS * NB_HOPS),
+		 (double)set_xfers / (BENCH_ROUNDS * NB_HOPS), hop_rate,
+		 (double)hop_bytes / (BENCH_ROUNDS * NB_HOPS),
+		 (double)hop_xfers / (BENCH_ROUNDS * NB_HOPS));
+	TEST_MESSAGE(msg);
+
+	TEST_ASSERT_TRUE(hop_bytes < set_bytes);
+	TEST_ASSERT_EQUAL_UINT32(BENCH_ROUNDS * NB_HOPS, hop_xfers);
+}
+#endif
@@ -0,0 +1,334 @@
+/***************************************************************************//**
+ *   @file   test_hop_cs.c
+ *   @brief  Chip select tests of the ADF4350, ADF5355 and ADF4371 hops.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "adf4350.h"
+#include "adf4371.h"
+#include "adf5355.h"
+#include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include "mock_no_os_delay.h"
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define FAKE_FRAME_LEN		64
+#define FAKE_NB_REGS		0x80
+#define NB_HOPS			4
+
+enum fake_dev_type {
+	FAKE_ADF4350,
+	FAKE_ADF5355,
+	FAKE_ADF4371,
+};
+
+/*
+ * Model of a SPI device which only latches a frame when CS is deasserted,
+ * like the ADF4350 and ADF5355 LE pin and the ADF4371 CS pin.
+ */
+struct fake_bus {
+	enum fake_dev_type type;
+	/* Bytes clocked in since CS was asserted */
+	uint8_t frame[FAKE_FRAME_LEN];
+	uint32_t len;
+	bool cs_asserted;
+	/* Registers of the device and address of the last latched frame */
+	uint32_t regs[FAKE_NB_REGS];
+	int32_t last_addr;
+	uint32_t frames;
+};
+
+static struct fake_bus fake;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void fake_latch(void)
+{
+	uint32_t word, i;
+	uint16_t addr;
+
+	fake.frames++;
+
+	switch (fake.type) {
+	case FAKE_ADF4350:
+	case FAKE_ADF5355:
+		TEST_ASSERT_EQUAL_UINT32(4, fake.len);
+		word = no_os_get_unaligned_be32(fake.frame);
+		if (fake.type == FAKE_ADF4350)
+			fake.last_addr = word & 0x7;
+		else
+			fake.last_addr = word & 0xF;
+		fake.regs[fake.last_addr] = word;
+		break;
+	case FAKE_ADF4371:
+		TEST_ASSERT_TRUE(fake.len >= 3);
+		addr = no_os_get_unaligned_be16(fake.frame) & 0x7FFF;
+		TEST_ASSERT_TRUE(addr + fake.len - 2 <= FAKE_NB_REGS);
+		fake.last_addr = addr;
+		for (i = 2; i < fake.len; i++)
+			fake.regs[addr + i - 2] = fake.frame[i];
+		break;
+	}
+
+	fake.len = 0;
+}
+
+static void fake_clock_in(const uint8_t *data, uint16_t bytes_number)
+{
+	TEST_ASSERT_TRUE(fake.len + bytes_number <= FAKE_FRAME_LEN);
+	fake.cs_asserted = true;
+	if (data)
+		memcpy(&fake.frame[fake.len], data, bytes_number);
+	else
+		memset(&fake.frame[fake.len], 0, bytes_number);
+	fake.len += bytes_number;
+}
+
+static void fake_cs_deassert(void)
+{
+	fake.cs_asserted = false;
+	fake_latch();
+}
+
+static int32_t fake_spi_init(struct no_os_spi_desc **desc,
+			     const struct no_os_spi_init_param *param)
+{
+	*desc = calloc(1, sizeof(**desc));
+
+	return *desc ? 0 : -ENOMEM;
+}
+
+static int32_t fake_spi_write_and_read(struct no_os_spi_desc *desc,
+				       uint8_t *data, uint16_t bytes_number)
+{
+	uint16_t cmd, i;
+
+	/* Only the ADF4371 reads back, with a streaming access */
+	cmd = no_os_get_unaligned_be16(data);
+	if (fake.type == FAKE_ADF4371 && (cmd & NO_OS_BIT(15))) {
+		TEST_ASSERT_FALSE(fake.cs_asserted);
+		for (i = 2; i < bytes_number; i++)
+			data[i] = fake.regs[(cmd & 0x7FFF) + i - 2];
+		return 0;
+	}
+
+	fake_clock_in(data, bytes_number);
+	fake_cs_deassert();
+
+	return 0;
+}
+
+static int32_t fake_spi_transfer(struct no_os_spi_desc *desc,
+				 struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		fake_clock_in(msgs[i].tx_buff, msgs[i].bytes_number);
+		if (msgs[i].cs_change)
+			fake_cs_deassert();
+	}
+
+	return 0;
+}
+
+static int32_t fake_spi_remove(struct no_os_spi_desc *desc)
+{
+	free(desc);
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops fake_spi_ops = {
+	.init = fake_spi_init,
+	.write_and_read = fake_spi_write_and_read,
+	.transfer = fake_spi_transfer,
+	.remove = fake_spi_remove,
+};
+
+static struct no_os_spi_init_param spi_param = {
+	.device_id = 0,
+	.max_speed_hz = 1000000,
+	.mode = NO_OS_SPI_MODE_0,
+	.platform_ops = &fake_spi_ops,
+};
+
+/* The last frame of a hop is latched and CS is left deasserted */
+static void check_hop_end(int32_t last_addr)
+{
+	TEST_ASSERT_FALSE(fake.cs_asserted);
+	TEST_ASSERT_EQUAL_UINT32(0, fake.len);
+	TEST_ASSERT_TRUE(fake.frames > 1);
+	TEST_ASSERT_EQUAL_INT32(last_addr, fake.last_addr);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&fake, 0, sizeof(fake));
+	fake.last_addr = -1;
+	no_os_udelay_Ignore();
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_adf4350_hop_deasserts_cs(void)
+{
+	const uint64_t freqs[NB_HOPS] = {
+		2500020000ULL, 2500120000ULL, 1250000000ULL, 2700000000ULL
+	};
+	struct adf4350_hop table[NB_HOPS];
+	adf4350_init_param param = {
+		.spi_init = spi_param,
+		.clkin = 25000000,
+		.channel_spacing = 10000,
+		.power_up_frequency = 2500000000UL,
+		.charge_pump_current = 2500,
+		.muxout_select = 6,
+		.output_power = 3,
+	};
+	adf4350_dev *dev;
+	uint32_t i;
+
+	fake.type = FAKE_ADF4350;
+	TEST_ASSERT_EQUAL_INT(0, adf4350_setup(&dev, param));
+	TEST_ASSERT_EQUAL_INT(0, adf4350_hop_table_init(dev, freqs, NB_HOPS,
+			      table));
+
+	for (i = 0; i < NB_HOPS; i++) {
+		fake.frames = 0;
+		TEST_ASSERT_EQUAL_INT(0, adf4350_hop(dev, &table[i]));
+		check_hop_end(0);
+		TEST_ASSERT_EQUAL_UINT32(table[i].regs[0], fake.regs[0]);
+	}
+
+	no_os_spi_remove(dev->spi_desc);
+	no_os_free(dev->pdata);
+	no_os_free(dev);
+}
+
+void test_adf5355_hop_deasserts_cs(void)
+{
+	const uint64_t freqs[NB_HOPS] = {
+		5000012345ULL, 5001012345ULL, 2500000000ULL, 5200000000ULL
+	};
+	struct adf5355_hop table[NB_HOPS];
+	struct adf5355_init_param param = {
+		.spi_init = &spi_param,
+		.dev_id = ADF5356,
+		.freq_req = 5000000000ULL,
+		.freq_req_chan = 0,
+		.clkin_freq = 122880000,
+		.cp_ua = 900,
+		.cp_neg_bleed_en = true,
+		.outa_en = true,
+		.outb_en = true,
+		.mux_out_sel = ADF5355_MUXOUT_DIGITAL_LOCK_DETECT,
+	};
+	struct adf5355_dev *dev;
+	uint32_t i;
+
+	fake.type = FAKE_ADF5355;
+	TEST_ASSERT_EQUAL_INT(0, adf5355_init(&dev, &param));
+	TEST_ASSERT_EQUAL_INT(0, adf5355_hop_table_init(dev, 0, freqs, NB_HOPS,
+			      table));
+
+	for (i = 0; i < NB_HOPS; i++) {
+		fake.frames = 0;
+		TEST_ASSERT_EQUAL_INT(0, adf5355_hop(dev, &table[i]));
+		check_hop_end(0);
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, adf5355_remove(dev));
+}
+
+void test_adf4371_hop_deasserts_cs(void)
+{
+	const uint64_t freqs[NB_HOPS] = {
+		5000012345ULL, 5001012345ULL, 2500000000ULL, 5200000000ULL
+	};
+	struct adf4371_hop table[NB_HOPS];
+	struct adf4371_chan_spec channel = {
+		.num = 0,
+		.power_up_frequency = 5000000000ULL,
+	};
+	struct adf4371_init_param param = {
+		.spi_init = &spi_param,
+		.clkin_frequency = 122880000,
+		.muxout_select = 1,
+		.num_channels = 1,
+		.channels = &channel,
+	};
+	struct adf4371_dev *dev;
+	uint32_t i;
+
+	fake.type = FAKE_ADF4371;
+	TEST_ASSERT_EQUAL_INT(0, adf4371_init(&dev, &param));
+	TEST_ASSERT_EQUAL_INT(0, adf4371_hop_table_init(dev, 0, freqs, NB_HOPS,
+			      table));
+
+	for (i = 0; i < NB_HOPS; i++) {
+		fake.frames = 0;
+		TEST_ASSERT_EQUAL_INT(0, adf4371_hop(dev, &table[i]));
+		check_hop_end(0x10);
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, adf4371_remove(dev));
+}
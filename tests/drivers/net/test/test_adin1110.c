@@ -0,0 +1,545 @@
+/***************************************************************************//**
+ *   @file   test_adin1110.c
+ *   @brief  ADIN1110 FIFO accesses on a model of the device behind the SPI bus.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "adin1110.h"
+#include "no_os_crc8.h"
+#include "no_os_util.h"
+#include "mock_no_os_delay.h"
+#include "mock_no_os_gpio.h"
+#include "mock_no_os_spi.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define FAKE_MAX_FRAMES		8
+#define FAKE_BUFF_LEN		(ADIN1110_BUFF_LEN + 16)
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_FRAMES		(64 * 1024)
+/* Frames waiting in the RX FIFO each time the interface is polled */
+#define BENCH_RX_BURST		4
+#endif
+
+/*
+ * Model of the device seen through the SPI bus: one RX FIFO, the TX FIFO and
+ * the registers used by the FIFO access.
+ */
+struct fake_adin1110 {
+	bool append_crc;
+	uint8_t crc_table[NO_OS_CRC8_TABLE_SIZE];
+	/* Frames waiting in the RX FIFO */
+	uint8_t rx_frames[FAKE_MAX_FRAMES][ADIN1110_BUFF_LEN];
+	uint32_t rx_len[FAKE_MAX_FRAMES];
+	uint32_t rx_head;
+	uint32_t rx_count;
+	/* Frames written to the TX FIFO */
+	uint8_t tx_frames[FAKE_MAX_FRAMES][ADIN1110_BUFF_LEN];
+	uint32_t tx_len[FAKE_MAX_FRAMES];
+	uint32_t tx_count;
+	uint32_t tx_fsize;
+	uint32_t tx_space;
+	/* Register reads, SPI transfers and bytes seen */
+	uint32_t reg_reads[0x100];
+	uint32_t transfers;
+	uint64_t spi_bytes;
+};
+
+static struct fake_adin1110 fake;
+static struct adin1110_desc desc;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void fake_check_crc(uint8_t *buff, uint32_t len)
+{
+	if (fake.append_crc)
+		TEST_ASSERT_EQUAL_HEX8(no_os_crc8(fake.crc_table, buff, len, 0),
+				       buff[len]);
+}
+
+static uint32_t fake_reg_value(uint16_t addr)
+{
+	if (addr == ADIN1110_RX_FSIZE_REG) {
+		if (!fake.rx_count)
+			return 0;
+		return fake.rx_len[fake.rx_head] + ADIN1110_FRAME_HEADER_LEN;
+	}
+	if (addr == ADIN1110_TX_SPACE_REG)
+		return fake.tx_space;
+
+	return 0;
+}
+
+/* Handle the bytes sent while CS was asserted */
+static void fake_transaction(uint8_t *tx, uint8_t *rx, uint32_t len)
+{
+	uint16_t cmd = no_os_get_unaligned_be16(tx);
+	uint16_t addr = cmd & ADIN1110_ADDR_MASK;
+	uint32_t header_len;
+	uint32_t val;
+	uint8_t *data;
+
+	TEST_ASSERT_TRUE(cmd & ADIN1110_CD_MASK);
+	fake_check_crc(tx, 2);
+
+	if (cmd & ADIN1110_RW_MASK) {
+		header_len = ADIN1110_WR_HEADER_LEN + fake.append_crc;
+		data = &tx[header_len];
+		if (addr == ADIN1110_TX_REG) {
+			TEST_ASSERT_EQUAL_UINT32(no_os_align(fake.tx_fsize, 4),
+						 len - header_len);
+			TEST_ASSERT_EQUAL_UINT16(0, no_os_get_unaligned_be16(data));
+			fake.tx_len[fake.tx_count] = fake.tx_fsize -
+						     ADIN1110_FRAME_HEADER_LEN;
+			memcpy(fake.tx_frames[fake.tx_count],
+			       data + ADIN1110_FRAME_HEADER_LEN,
+			       fake.tx_len[fake.tx_count]);
+			fake.tx_count++;
+			val = NO_OS_DIV_ROUND_UP(fake.tx_fsize, 2) +
+			      ADIN1110_FRAME_HEADER_LEN;
+			TEST_ASSERT_TRUE(fake.tx_space >= val);
+			fake.tx_space -= val;
+			return;
+		}
+
+		TEST_ASSERT_EQUAL_UINT32(header_len + ADIN1110_REG_LEN +
+					 fake.append_crc, len);
+		fake_check_crc(data, ADIN1110_REG_LEN);
+		if (addr == ADIN1110_TX_FSIZE_REG)
+			fake.tx_fsize = no_os_get_unaligned_be32(data);
+		return;
+	}
+
+	header_len = ADIN1110_RD_HEADER_LEN + fake.append_crc;
+	data = &rx[header_len];
+	if (addr == ADIN1110_RX_REG) {
+		TEST_ASSERT_NOT_EQUAL(0, fake.rx_count);
+		val = fake.rx_len[fake.rx_head];
+		TEST_ASSERT_EQUAL_UINT32(no_os_align(val + ADIN1110_FRAME_HEADER_LEN,
+						     4), len - header_len);
+		memset(data, 0, len - header_len);
+		memcpy(data + ADIN1110_FRAME_HEADER_LEN,
+		       fake.rx_frames[fake.rx_head], val);
+		fake.rx_head = (fake.rx_head + 1) % FAKE_MAX_FRAMES;
+		fake.rx_count--;
+		return;
+	}
+
+	TEST_ASSERT_EQUAL_UINT32(header_len + ADIN1110_REG_LEN +
+				 fake.append_crc, len);
+	fake.reg_reads[addr]++;
+	no_os_put_unaligned_be32(fake_reg_value(addr), data);
+	if (fake.append_crc)
+		data[ADIN1110_REG_LEN] = no_os_crc8(fake.crc_table, data,
+						    ADIN1110_REG_LEN, 0);
+}
+
+static int32_t fake_spi_transfer(struct no_os_spi_desc *spi,
+				 struct no_os_spi_msg *msgs, uint32_t len,
+				 int cmock_num_calls)
+{
+	static uint8_t tx[FAKE_BUFF_LEN];
+	static uint8_t rx[FAKE_BUFF_LEN];
+	uint32_t first = 0;
+	uint32_t pos = 0;
+	uint32_t i;
+
+	fake.transfers++;
+
+	for (i = 0; i < len; i++) {
+		TEST_ASSERT_TRUE(pos + msgs[i].bytes_number <= FAKE_BUFF_LEN);
+		if (msgs[i].tx_buff)
+			memcpy(&tx[pos], msgs[i].tx_buff, msgs[i].bytes_number);
+		else
+			memset(&tx[pos], 0, msgs[i].bytes_number);
+		pos += msgs[i].bytes_number;
+		fake.spi_bytes += msgs[i].bytes_number;
+
+		/* CS is deasserted after the last message of the transfer */
+		if (!msgs[i].cs_change && i != len - 1)
+			continue;
+
+		fake_transaction(tx, rx, pos);
+
+		/* Send the response to the messages of this transaction */
+		for (pos = 0; first <= i; first++) {
+			if (msgs[first].rx_buff)
+				memcpy(msgs[first].rx_buff, &rx[pos],
+				       msgs[first].bytes_number);
+			pos += msgs[first].bytes_number;
+		}
+		pos = 0;
+	}
+
+	return 0;
+}
+
+static void fake_push_rx(uint32_t len, uint8_t seed)
+{
+	uint32_t tail = (fake.rx_head + fake.rx_count) % FAKE_MAX_FRAMES;
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		fake.rx_frames[tail][i] = seed + i;
+	fake.rx_len[tail] = len;
+	fake.rx_count++;
+}
+
+static void check_frame(const uint8_t *frame, uint32_t len, uint8_t seed)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		TEST_ASSERT_EQUAL_HEX8((uint8_t)(seed + i), frame[i]);
+}
+
+static void init(bool append_crc)
+{
+	fake.append_crc = append_crc;
+	desc.append_crc = append_crc;
+}
+
+/* Receive all the frames, as the lwIP network interface does */
+static void rx_drain(uint32_t nb_frames, const uint32_t *lens)
+{
+	static uint8_t buff[ADIN1110_BUFF_LEN];
+	uint32_t len;
+	uint32_t i;
+
+	for (i = 0; i < nb_frames; i++)
+		fake_push_rx(lens[i], i);
+
+	for (i = 0; i < nb_frames; i++) {
+		TEST_ASSERT_EQUAL_INT(0, adin1110_rx_frame_len(&desc, 0, &len));
+		TEST_ASSERT_EQUAL_UINT32(lens[i], len);
+		TEST_ASSERT_TRUE(ADIN1110_RX_BUFF_LEN(len) <= sizeof(buff));
+		TEST_ASSERT_EQUAL_INT(0, adin1110_read_fifo_inplace(&desc, 0, buff,
+				      len));
+		check_frame(&buff[ADIN1110_RX_HDR_ROOM], len, i);
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, adin1110_rx_frame_len(&desc, 0, &len));
+	TEST_ASSERT_EQUAL_UINT32(0, len);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&fake, 0, sizeof(fake));
+	memset(&desc, 0, sizeof(desc));
+	no_os_crc8_populate_msb(fake.crc_table, 0x7);
+	desc.chip_type = ADIN1110;
+	no_os_spi_transfer_StubWithCallback(fake_spi_transfer);
+}
+
+void tearDown(void) {}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_adin1110_rx_one_transfer_per_frame(void)
+{
+	const uint32_t lens[] = {60, 1514, 64, 61, 100};
+
+	init(false);
+	rx_drain(NO_OS_ARRAY_SIZE(lens), lens);
+
+	/* The RX_FSIZE register is only read alone before the first frame */
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_ARRAY_SIZE(lens) + 1, fake.transfers);
+}
+
+void test_adin1110_rx_crc(void)
+{
+	const uint32_t lens[] = {1514, 60, 77};
+
+	init(true);
+	rx_drain(NO_OS_ARRAY_SIZE(lens), lens);
+
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_ARRAY_SIZE(lens) + 1, fake.transfers);
+}
+
+void test_adin1110_rx_size_prefetch_used_once(void)
+{
+	const uint32_t lens[] = {90};
+	uint32_t len;
+
+	init(false);
+	rx_drain(NO_OS_ARRAY_SIZE(lens), lens);
+
+	/* A new frame arrived after the FIFO was seen empty */
+	fake_push_rx(200, 3);
+	TEST_ASSERT_EQUAL_INT(0, adin1110_rx_frame_len(&desc, 0, &len));
+	TEST_ASSERT_EQUAL_UINT32(200, len);
+	TEST_ASSERT_EQUAL_UINT32(3, fake.transfers);
+}
+
+void test_adin1110_read_fifo(void)
+{
+	struct adin1110_eth_buff eth_buff;
+	uint8_t payload[ADIN1110_BUFF_LEN];
+
+	init(false);
+	eth_buff.payload = payload;
+	fake_push_rx(300, 5);
+
+	TEST_ASSERT_EQUAL_INT(0, adin1110_read_fifo(&desc, 0, &eth_buff));
+	TEST_ASSERT_EQUAL_UINT32(300, eth_buff.len);
+	check_frame(eth_buff.mac_dest, ADIN1110_ETH_HDR_LEN, 5);
+	check_frame(payload, 300 - ADIN1110_ETH_HDR_LEN,
+		    5 + ADIN1110_ETH_HDR_LEN);
+
+	/* Empty FIFO */
+	eth_buff.len = 0;
+	TEST_ASSERT_EQUAL_INT(0, adin1110_read_fifo(&desc, 0, &eth_buff));
+	TEST_ASSERT_EQUAL_UINT32(0, eth_buff.len);
+}
+
+void test_adin1110_read_fifo_inplace_invalid(void)
+{
+	uint8_t buff[ADIN1110_BUFF_LEN];
+
+	init(false);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adin1110_read_fifo_inplace(&desc, 1, buff,
+			      60));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adin1110_read_fifo_inplace(&desc, 0, buff,
+			      0));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.transfers);
+}
+
+void test_adin1110_tx_frags(void)
+{
+	uint8_t frame[1514];
+	struct adin1110_frag frags[3] = {
+		{ .data = frame, .len = ADIN1110_ETH_HDR_LEN },
+		{ .data = &frame[ADIN1110_ETH_HDR_LEN], .len = 20 },
+		{ .data = &frame[ADIN1110_ETH_HDR_LEN + 20] },
+	};
+	const uint32_t lens[] = {1514, 60, 34, 101, 1000};
+	uint32_t i;
+
+	init(true);
+	for (i = 0; i < sizeof(frame); i++)
+		frame[i] = i;
+	fake.tx_space = 0x1000;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(lens); i++) {
+		frags[2].len = lens[i] - ADIN1110_ETH_HDR_LEN - 20;
+		TEST_ASSERT_EQUAL_INT(0, adin1110_write_fifo_frags(&desc, 0, frags,
+				      3));
+
+		/* Short frames are padded to 60 bytes, before the FCS */
+		TEST_ASSERT_EQUAL_UINT32(no_os_max(lens[i], 60), fake.tx_len[i]);
+		check_frame(fake.tx_frames[i], lens[i], 0);
+	}
+
+	/* The TX_SPACE register is only read when the cached space runs out */
+	TEST_ASSERT_EQUAL_UINT32(1, fake.reg_reads[ADIN1110_TX_SPACE_REG]);
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_ARRAY_SIZE(lens) + 1, fake.transfers);
+	TEST_ASSERT_EQUAL_UINT32(fake.tx_space, desc.tx_space);
+}
+
+void test_adin1110_tx_fifo_full(void)
+{
+	uint8_t frame[1000] = {0};
+	struct adin1110_frag frag = { .data = frame, .len = sizeof(frame) };
+	struct adin1110_stats stats;
+
+	init(false);
+	fake.tx_space = 600;
+
+	TEST_ASSERT_EQUAL_INT(0, adin1110_write_fifo_frags(&desc, 0, &frag, 1));
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, adin1110_write_fifo_frags(&desc, 0, &frag,
+			      1));
+	TEST_ASSERT_EQUAL_UINT32(1, fake.tx_count);
+
+	/* The device sent the frame */
+	fake.tx_space = 600;
+	TEST_ASSERT_EQUAL_INT(0, adin1110_write_fifo_frags(&desc, 0, &frag, 1));
+	TEST_ASSERT_EQUAL_UINT32(2, fake.tx_count);
+	TEST_ASSERT_EQUAL_UINT32(3, fake.reg_reads[ADIN1110_TX_SPACE_REG]);
+
+	TEST_ASSERT_EQUAL_INT(0, adin1110_get_stats(&desc, &stats));
+	TEST_ASSERT_EQUAL_UINT32(2, stats.tx_frames);
+	TEST_ASSERT_EQUAL_UINT64(2 * sizeof(frame), stats.tx_bytes);
+	TEST_ASSERT_EQUAL_UINT32(3, stats.tx_space_reads);
+}
+
+void test_adin1110_tx_invalid(void)
+{
+	uint8_t frame[60];
+	struct adin1110_frag frags[ADIN1110_TX_MAX_FRAGS + 1];
+
+	init(false);
+	frags[0].data = frame;
+	frags[0].len = sizeof(frame);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adin1110_write_fifo_frags(&desc, 1, frags,
+			      1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adin1110_write_fifo_frags(&desc, 0, frags,
+			      0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adin1110_write_fifo_frags(&desc, 0, frags,
+			      ADIN1110_TX_MAX_FRAGS + 1));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.transfers);
+}
+
+void test_adin1110_spi_bytes(void)
+{
+	const uint32_t lens[] = {1514, 1514, 1514, 1514};
+	struct adin1110_stats stats;
+
+	init(false);
+	rx_drain(NO_OS_ARRAY_SIZE(lens), lens);
+
+	TEST_ASSERT_EQUAL_INT(0, adin1110_get_stats(&desc, &stats));
+	TEST_ASSERT_EQUAL_UINT32(4, stats.rx_frames);
+	TEST_ASSERT_EQUAL_UINT64(4 * 1514, stats.rx_bytes);
+	TEST_ASSERT_EQUAL_UINT32(fake.transfers, stats.spi_transfers);
+	TEST_ASSERT_EQUAL_UINT64(fake.spi_bytes, stats.spi_bytes);
+	/* Under 2% of SPI overhead for full size frames */
+	TEST_ASSERT_TRUE(stats.spi_bytes * 100 < stats.rx_bytes * 102);
+}
+
+#ifdef NO_OS_TEST_BENCH
+/*
+ * SPI transfers per frame and SPI bytes per Ethernet byte. The host time is
+ * not reported, since it is mostly spent in the model of the device.
+ */
+static void bench_report(const char *path, uint32_t len)
+{
+	char msg[128];
+
+	snprintf(msg, sizeof(msg),
+		 "%-13s %4u bytes: %.2f transfers/frame, "
+		 "%.4f SPI bytes/Ethernet byte", path, len,
+		 (double)fake.transfers / BENCH_FRAMES,
+		 (double)fake.spi_bytes / ((double)len * BENCH_FRAMES));
+	TEST_MESSAGE(msg);
+}
+
+/* Drain bursts of frames, as the lwIP network interface does */
+static void bench_rx(bool zero_copy, uint32_t len)
+{
+	static uint8_t buff[ADIN1110_BUFF_LEN];
+	struct adin1110_eth_buff eth_buff = { .payload = buff };
+	uint32_t i, j, fsize;
+
+	setUp();
+	init(false);
+	for (i = 0; i < BENCH_FRAMES; i += BENCH_RX_BURST) {
+		for (j = 0; j < BENCH_RX_BURST; j++)
+			fake_push_rx(len, j);
+
+		for (j = 0; ; j++) {
+			if (zero_copy) {
+				TEST_ASSERT_EQUAL_INT(0, adin1110_rx_frame_len(&desc,
+						      0, &fsize));
+				if (!fsize)
+					break;
+				TEST_ASSERT_EQUAL_INT(0,
+						      adin1110_read_fifo_inplace(&desc,
+								      0, buff, fsize));
+			} else {
+				eth_buff.len = 0;
+				TEST_ASSERT_EQUAL_INT(0, adin1110_read_fifo(&desc,
+						      0, &eth_buff));
+				fsize = eth_buff.len;
+				if (!fsize)
+					break;
+			}
+			TEST_ASSERT_EQUAL_UINT32(len, fsize);
+		}
+		TEST_ASSERT_EQUAL_UINT32(BENCH_RX_BURST, j);
+	}
+
+	bench_report(zero_copy ? "RX in place" : "RX read_fifo", len);
+}
+
+/* The device sends the frames as fast as they are written */
+static void bench_tx(bool zero_copy, uint32_t len)
+{
+	static uint8_t frame[1514];
+	struct adin1110_frag frag = { .data = frame, .len = len };
+	struct adin1110_eth_buff eth_buff = {
+		.len = len,
+		.payload = &frame[ADIN1110_ETH_HDR_LEN],
+	};
+	uint32_t i;
+
+	setUp();
+	init(false);
+	memcpy(eth_buff.mac_dest, frame, ADIN1110_ETH_HDR_LEN);
+	for (i = 0; i < BENCH_FRAMES; i++) {
+		fake.tx_count = 0;
+		fake.tx_space = 0x1000;
+		if (zero_copy)
+			TEST_ASSERT_EQUAL_INT(0, adin1110_write_fifo_frags(&desc,
+					      0, &frag, 1));
+		else
+			TEST_ASSERT_EQUAL_INT(0, adin1110_write_fifo(&desc, 0,
+					      &eth_buff));
+	}
+
+	bench_report(zero_copy ? "TX fragments" : "TX write_fifo", len);
+}
+
+void test_adin1110_bench(void)
+{
+	const uint32_t lens[] = {60, 590, 1514};
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(lens); i++) {
+		bench_rx(false, lens[i]);
+		bench_rx(true, lens[i]);
+		bench_tx(false, lens[i]);
+		bench_tx(true, lens[i]);
+	}
+}
+#endif
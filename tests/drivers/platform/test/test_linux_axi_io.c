@@ -0,0 +1,307 @@
+/***************************************************************************//**
+ *   @file   test_linux_axi_io.c
+ *   @brief  Register accesses of linux_axi_io.c on a file-backed UIO device.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* UIO indexes without a /sys/class/uio entry, so that the windows are
+ * LINUX_AXI_IO_DEVMEM_SIZE bytes long */
+#define BASE			4000
+#define NB_ACCESSES		100000
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_ACCESSES		(4 * 1024 * 1024)
+#define BENCH_REMAP_ACCESSES	(64 * 1024)
+#endif
+
+/* Backing file of all the /dev/uioX devices */
+static char regs_path[64];
+static int regs_fd = -1;
+static uint32_t nb_opens;
+/* When set, opening a device fails with this errno */
+static int open_errno;
+static atomic_bool stop_unmap;
+
+/*******************************************************************************
+ *    FAKE DEVICES
+ ******************************************************************************/
+
+static int fake_open(const char *path, int flags)
+{
+	nb_opens++;
+	if (open_errno) {
+		errno = open_errno;
+		return -1;
+	}
+
+	return open(regs_path, flags);
+}
+
+#define open(path, flags)	fake_open(path, flags)
+#include "linux_axi_io.c"
+#undef open
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	strcpy(regs_path, "/tmp/test_linux_axi_io_XXXXXX");
+	regs_fd = mkstemp(regs_path);
+	TEST_ASSERT_TRUE(regs_fd >= 0);
+	TEST_ASSERT_EQUAL_INT(0, ftruncate(regs_fd, LINUX_AXI_IO_DEVMEM_SIZE));
+	nb_opens = 0;
+	open_errno = 0;
+}
+
+void tearDown(void)
+{
+	linux_axi_io_unmap_all();
+	close(regs_fd);
+	unlink(regs_path);
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static uint32_t file_read(uint32_t offset)
+{
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(sizeof(val),
+			      pread(regs_fd, &val, sizeof(val), offset));
+
+	return val;
+}
+
+static void *unmap_thread(void *arg)
+{
+	while (!stop_unmap)
+		linux_axi_io_unmap_all();
+
+	return NULL;
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_axi_io_read_write(void)
+{
+	uint32_t val = 0;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_write(BASE, 0x10, 0x12345678));
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(BASE, 0x10, &val));
+	TEST_ASSERT_EQUAL_UINT32(0x12345678, val);
+	TEST_ASSERT_EQUAL_UINT32(0x12345678, file_read(0x10));
+
+	/* Changes made by the device are seen */
+	val = 0xA5A5A5A5;
+	TEST_ASSERT_EQUAL_INT(sizeof(val),
+			      pwrite(regs_fd, &val, sizeof(val), 0x20));
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(BASE, 0x20, &val));
+	TEST_ASSERT_EQUAL_UINT32(0xA5A5A5A5, val);
+
+	TEST_ASSERT_EQUAL_UINT32(1, nb_opens);
+}
+
+void test_axi_io_window_kept(void)
+{
+	uint32_t i, val, offset;
+
+	for (i = 0; i < NB_ACCESSES; i++) {
+		offset = (i * 4) % LINUX_AXI_IO_DEVMEM_SIZE;
+		TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_write(BASE + (i & 1),
+					offset, i));
+		TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(BASE + (i & 1),
+					offset, &val));
+		TEST_ASSERT_EQUAL_UINT32(i, val);
+	}
+
+	/* One mapping for each base */
+	TEST_ASSERT_EQUAL_UINT32(2, nb_opens);
+}
+
+void test_axi_io_out_of_window(void)
+{
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(BASE,
+			      LINUX_AXI_IO_DEVMEM_SIZE - 4, &val));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_axi_io_read(BASE,
+			      LINUX_AXI_IO_DEVMEM_SIZE - 2, &val));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_axi_io_write(BASE,
+			      LINUX_AXI_IO_DEVMEM_SIZE, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_axi_io_write(BASE,
+			      0xFFFFFFFC, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_opens);
+}
+
+void test_axi_io_open_error(void)
+{
+	uint32_t val;
+
+	open_errno = ENOENT;
+	TEST_ASSERT_EQUAL_INT(-ENOENT, no_os_axi_io_read(BASE, 0, &val));
+
+	/* Nothing was kept, the next access tries again */
+	open_errno = 0;
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(BASE, 0, &val));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_opens);
+}
+
+void test_axi_io_unmap_all(void)
+{
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_write(BASE, 0x40, 0xCAFE));
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_unmap_all());
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_unmap_all());
+
+	/* Mapped again */
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(BASE, 0x40, &val));
+	TEST_ASSERT_EQUAL_UINT32(0xCAFE, val);
+	TEST_ASSERT_EQUAL_UINT32(2, nb_opens);
+}
+
+void test_axi_io_max_maps(void)
+{
+	uint32_t i, val;
+
+	for (i = 0; i < LINUX_AXI_IO_MAX_MAPS; i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(BASE + i, 0, &val));
+
+	TEST_ASSERT_EQUAL_INT(-ENOMEM, no_os_axi_io_read(BASE + i, 0, &val));
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(BASE, 0, &val));
+	TEST_ASSERT_EQUAL_UINT32(LINUX_AXI_IO_MAX_MAPS, nb_opens);
+}
+
+/* The windows are unmapped and mapped again under the accesses */
+void test_axi_io_concurrent_unmap(void)
+{
+	pthread_t thread;
+	uint32_t i, val;
+
+	stop_unmap = false;
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, unmap_thread,
+						NULL));
+
+	for (i = 0; i < NB_ACCESSES; i++) {
+		TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_write(BASE, 0x80, i));
+		TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(BASE, 0x80, &val));
+		TEST_ASSERT_EQUAL_UINT32(i, val);
+	}
+
+	stop_unmap = true;
+	TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+}
+
+#ifdef NO_OS_TEST_BENCH
+/* Access as before the windows were kept: open and map on every access */
+static int32_t remap_access(uint32_t base, uint32_t offset, uint32_t *data,
+			    bool write)
+{
+	size_t size = offset + sizeof(*data);
+	void *addr;
+	int fd;
+
+	fd = fake_open("/dev/uio", O_RDWR);
+	if (fd < 0)
+		return -errno;
+
+	addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (addr == MAP_FAILED) {
+		close(fd);
+		return -errno;
+	}
+
+	if (write)
+		*(volatile uint32_t *)((uintptr_t)addr + offset) = *data;
+	else
+		*data = *(volatile uint32_t *)((uintptr_t)addr + offset);
+
+	munmap(addr, size);
+	close(fd);
+
+	return 0;
+}
+
+void test_axi_io_bench(void)
+{
+	struct timespec start_time;
+	double kept, remap;
+	uint32_t i, val;
+	char msg[128];
+
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	for (i = 0; i < BENCH_ACCESSES / 2; i++) {
+		no_os_axi_io_write(BASE, (i & 255) * 4, i);
+		no_os_axi_io_read(BASE, (i & 255) * 4, &val);
+		TEST_ASSERT_EQUAL_UINT32(i, val);
+	}
+	kept = BENCH_ACCESSES / bench_elapsed_s(&start_time);
+
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	for (i = 0; i < BENCH_REMAP_ACCESSES / 2; i++) {
+		val = i;
+		remap_access(BASE, (i & 255) * 4, &val, true);
+		remap_access(BASE, (i & 255) * 4, &val, false);
+		TEST_ASSERT_EQUAL_UINT32(i, val);
+	}
+	remap = BENCH_REMAP_ACCESSES / bench_elapsed_s(&start_time);
+
+	snprintf(msg, sizeof(msg),
+		 "Register accesses: kept windows %.0f/s, "
+		 "map on every access %.0f/s", kept, remap);
+	TEST_MESSAGE(msg);
+}
+#endif
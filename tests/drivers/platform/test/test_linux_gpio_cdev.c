@@ -0,0 +1,662 @@
+/***************************************************************************//**
+ *   @file   test_linux_gpio_cdev.c
+ *   @brief  Line requests of linux_gpio_cdev.c and linux_gpio_irq.c on a fake
+ *           GPIO chip.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include "no_os_alloc.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
+#include "no_os_util.h"
+#include "linux_irq.c"
+
+/*******************************************************************************
+ *    FAKE GPIO CHIP
+ ******************************************************************************/
+
+#define FAKE_MAX_REQS		16
+#define FAKE_CHIP_LINES		64
+#define WAIT_MS			2000
+
+/* Line request of the fake chip, its file descriptor is a pipe */
+struct fake_req {
+	bool used;
+	/* Read end, given to the driver */
+	int fd;
+	/* Write end, used to raise edge events */
+	int wr_fd;
+	struct gpio_v2_line_request req;
+};
+
+static struct fake_req fake_reqs[FAKE_MAX_REQS];
+static int chip_fd = -1;
+static uint32_t nb_chip_opens;
+/* Level of the lines of the chip, by offset */
+static uint64_t chip_levels;
+/* Number of calls of each ioctl */
+static uint32_t nb_get_line;
+static uint32_t nb_set_config;
+static uint32_t nb_set_values;
+static uint32_t nb_get_values;
+/* Last values given to GPIO_V2_LINE_SET_VALUES_IOCTL */
+static struct gpio_v2_line_values last_values;
+static atomic_uint nb_callbacks;
+
+static struct fake_req *fake_req_find(int fd)
+{
+	uint32_t i;
+
+	for (i = 0; i < FAKE_MAX_REQS; i++)
+		if (fake_reqs[i].used && fake_reqs[i].fd == fd)
+			return &fake_reqs[i];
+
+	return NULL;
+}
+
+static struct fake_req *fake_req_of_line(uint32_t offset)
+{
+	uint32_t i, j;
+
+	for (i = 0; i < FAKE_MAX_REQS; i++) {
+		if (!fake_reqs[i].used)
+			continue;
+		for (j = 0; j < fake_reqs[i].req.num_lines; j++)
+			if (fake_reqs[i].req.offsets[j] == offset)
+				return &fake_reqs[i];
+	}
+
+	return NULL;
+}
+
+/* Drive the output values of a configuration on the chip lines */
+static void fake_apply_config(struct fake_req *freq)
+{
+	struct gpio_v2_line_config *config = &freq->req.config;
+	uint32_t i, j;
+
+	for (i = 0; i < config->num_attrs; i++) {
+		if (config->attrs[i].attr.id != GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES)
+			continue;
+		for (j = 0; j < freq->req.num_lines; j++) {
+			if (!(config->attrs[i].mask & NO_OS_BIT_ULL(j)))
+				continue;
+			chip_levels &= ~NO_OS_BIT_ULL(freq->req.offsets[j]);
+			if (config->attrs[i].attr.values & NO_OS_BIT_ULL(j))
+				chip_levels |= NO_OS_BIT_ULL(freq->req.offsets[j]);
+		}
+	}
+}
+
+static int fake_get_line(struct gpio_v2_line_request *req)
+{
+	struct fake_req *freq = NULL;
+	int fds[2];
+	uint32_t i;
+
+	nb_get_line++;
+	/* A line can only be in one request, like in the kernel */
+	for (i = 0; i < req->num_lines; i++)
+		if (fake_req_of_line(req->offsets[i]))
+			return -EBUSY;
+
+	for (i = 0; i < FAKE_MAX_REQS; i++)
+		if (!fake_reqs[i].used)
+			freq = &fake_reqs[i];
+	if (!freq || pipe(fds))
+		return -ENOMEM;
+	fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+	freq->used = true;
+	freq->fd = fds[0];
+	freq->wr_fd = fds[1];
+	freq->req = *req;
+	fake_apply_config(freq);
+	req->fd = freq->fd;
+
+	return 0;
+}
+
+static int fake_ioctl(int fd, unsigned long request, void *arg)
+{
+	struct gpio_v2_line_values *vals = arg;
+	struct gpio_v2_line_info *info = arg;
+	struct fake_req *freq;
+	int ret = 0;
+	uint32_t i;
+
+	if (fd == chip_fd) {
+		if (request == GPIO_V2_GET_LINE_IOCTL) {
+			ret = fake_get_line(arg);
+		} else if (request == GPIO_V2_GET_LINEINFO_IOCTL) {
+			info->flags = GPIO_V2_LINE_FLAG_INPUT;
+		} else {
+			ret = -ENOTTY;
+		}
+		goto out;
+	}
+
+	freq = fake_req_find(fd);
+	if (!freq) {
+		ret = -EBADF;
+		goto out;
+	}
+
+	switch (request) {
+	case GPIO_V2_LINE_SET_CONFIG_IOCTL:
+		nb_set_config++;
+		freq->req.config = *(struct gpio_v2_line_config *)arg;
+		fake_apply_config(freq);
+		break;
+	case GPIO_V2_LINE_SET_VALUES_IOCTL:
+		nb_set_values++;
+		last_values = *vals;
+		for (i = 0; i < freq->req.num_lines; i++) {
+			if (!(vals->mask & NO_OS_BIT_ULL(i)))
+				continue;
+			chip_levels &= ~NO_OS_BIT_ULL(freq->req.offsets[i]);
+			if (vals->bits & NO_OS_BIT_ULL(i))
+				chip_levels |= NO_OS_BIT_ULL(freq->req.offsets[i]);
+		}
+		break;
+	case GPIO_V2_LINE_GET_VALUES_IOCTL:
+		nb_get_values++;
+		vals->bits = 0;
+		for (i = 0; i < freq->req.num_lines; i++)
+			if ((vals->mask & NO_OS_BIT_ULL(i)) &&
+			    (chip_levels & NO_OS_BIT_ULL(freq->req.offsets[i])))
+				vals->bits |= NO_OS_BIT_ULL(i);
+		break;
+	default:
+		ret = -ENOTTY;
+		break;
+	}
+out:
+	if (ret) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+static int fake_open(const char *path, int flags)
+{
+	nb_chip_opens++;
+	chip_fd = open("/dev/null", flags);
+
+	return chip_fd;
+}
+
+static int fake_close(int fd)
+{
+	struct fake_req *freq = fake_req_find(fd);
+
+	if (freq) {
+		close(freq->wr_fd);
+		freq->used = false;
+	} else if (fd == chip_fd) {
+		chip_fd = -1;
+	}
+
+	return close(fd);
+}
+
+#define open(path, flags)	fake_open(path, flags)
+#define ioctl(fd, req, arg)	fake_ioctl(fd, req, arg)
+#define close(fd)		fake_close(fd)
+#include "linux_gpio_cdev.c"
+#include "linux_gpio_irq.c"
+#undef open
+#undef ioctl
+#undef close
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	chip_levels = 0;
+	nb_chip_opens = 0;
+	nb_get_line = 0;
+	nb_set_config = 0;
+	nb_set_values = 0;
+	nb_get_values = 0;
+	memset(&last_values, 0, sizeof(last_values));
+	atomic_store(&nb_callbacks, 0);
+}
+
+void tearDown(void)
+{
+	uint32_t i;
+
+	/* Every test releases its lines, and so the chip */
+	for (i = 0; i < FAKE_MAX_REQS; i++)
+		TEST_ASSERT_FALSE(fake_reqs[i].used);
+	TEST_ASSERT_EQUAL_INT(-1, chip_fd);
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void gpio_get(struct no_os_gpio_desc **desc, uint32_t offset)
+{
+	struct no_os_gpio_init_param param = {
+		.port = 0,
+		.number = offset,
+		.pull = NO_OS_PULL_NONE,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_get(desc, &param));
+}
+
+static void group_get(struct no_os_gpio_desc **desc, uint8_t nb_gpios,
+		      const uint32_t *offsets)
+{
+	struct no_os_gpio_init_param param[8] = {0};
+	uint8_t i;
+
+	for (i = 0; i < nb_gpios; i++)
+		param[i].number = offsets[i];
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_get_group(desc, nb_gpios,
+			      param));
+}
+
+static void gpio_remove(struct no_os_gpio_desc **desc, uint8_t nb_gpios)
+{
+	uint8_t i;
+
+	for (i = 0; i < nb_gpios; i++)
+		TEST_ASSERT_EQUAL_INT(0,
+				      linux_gpio_cdev_ops.gpio_ops_remove(desc[i]));
+}
+
+static bool wait_callbacks(uint32_t count)
+{
+	uint32_t i;
+
+	for (i = 0; i < WAIT_MS; i++) {
+		if (atomic_load(&nb_callbacks) >= count)
+			return true;
+		usleep(1000);
+	}
+
+	return false;
+}
+
+static void edge_callback(void *ctx)
+{
+	atomic_fetch_add(&nb_callbacks, 1);
+}
+
+static void raise_edge(uint32_t offset)
+{
+	struct gpio_v2_line_event event = {0};
+	struct fake_req *freq = fake_req_of_line(offset);
+
+	TEST_ASSERT_NOT_NULL(freq);
+	event.timestamp_ns = linux_irq_time_ns();
+	event.id = GPIO_V2_LINE_EVENT_RISING_EDGE;
+	event.offset = offset;
+	TEST_ASSERT_EQUAL_INT(sizeof(event),
+			      write(freq->wr_fd, &event, sizeof(event)));
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_gpio_single_lines(void)
+{
+	struct no_os_gpio_desc *desc[2];
+	uint8_t values[2] = {1, 1};
+
+	gpio_get(&desc[0], 3);
+	gpio_get(&desc[1], 5);
+	TEST_ASSERT_EQUAL_UINT32(2, nb_get_line);
+	TEST_ASSERT_EQUAL_UINT32(1, nb_chip_opens);
+
+	/* One request, so one ioctl, for each line */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_set_values(desc,
+			      2, values));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_set_values);
+	TEST_ASSERT_EQUAL_HEX64(NO_OS_BIT_ULL(3) | NO_OS_BIT_ULL(5), chip_levels);
+
+	gpio_remove(desc, 2);
+}
+
+void test_gpio_group_set_values(void)
+{
+	const uint32_t offsets[4] = {3, 5, 7, 9};
+	struct no_os_gpio_desc *desc[4], *sub[2];
+	uint8_t values[4] = {1, 0, 1, 1};
+	uint32_t i;
+
+	group_get(desc, 4, offsets);
+	TEST_ASSERT_EQUAL_UINT32(1, nb_get_line);
+	for (i = 0; i < 4; i++) {
+		TEST_ASSERT_EQUAL_PTR(&linux_gpio_cdev_ops, desc[i]->platform_ops);
+		TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_direction_output(
+					      desc[i], 0));
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_set_values(desc,
+			      4, values));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_set_values);
+	TEST_ASSERT_EQUAL_HEX64(0xF, last_values.mask);
+	TEST_ASSERT_EQUAL_HEX64(0xD, last_values.bits);
+	TEST_ASSERT_EQUAL_HEX64(NO_OS_BIT_ULL(3) | NO_OS_BIT_ULL(7) |
+				NO_OS_BIT_ULL(9), chip_levels);
+
+	/* A subset of the group, in another order */
+	sub[0] = desc[3];
+	sub[1] = desc[1];
+	values[0] = 0;
+	values[1] = 1;
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_set_values(sub, 2,
+			      values));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_set_values);
+	TEST_ASSERT_EQUAL_HEX64(0xA, last_values.mask);
+	TEST_ASSERT_EQUAL_HEX64(0x2, last_values.bits);
+	TEST_ASSERT_EQUAL_HEX64(NO_OS_BIT_ULL(3) | NO_OS_BIT_ULL(5) |
+				NO_OS_BIT_ULL(7), chip_levels);
+
+	/* Configuring a line keeps the outputs of the others */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_direction_input(
+				      desc[1]));
+	TEST_ASSERT_EQUAL_HEX64(NO_OS_BIT_ULL(3) | NO_OS_BIT_ULL(7),
+				chip_levels & ~NO_OS_BIT_ULL(5));
+
+	gpio_remove(desc, 4);
+}
+
+void test_gpio_group_get_values(void)
+{
+	const uint32_t offsets[3] = {10, 4, 20};
+	struct no_os_gpio_desc *desc[4];
+	uint8_t values[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+
+	group_get(desc, 3, offsets);
+	chip_levels = NO_OS_BIT_ULL(10) | NO_OS_BIT_ULL(20);
+
+	/* NULL entries are skipped */
+	desc[3] = desc[2];
+	desc[2] = NULL;
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_get_values(desc,
+			      4, values));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_get_values);
+	TEST_ASSERT_EQUAL_UINT8(NO_OS_GPIO_HIGH, values[0]);
+	TEST_ASSERT_EQUAL_UINT8(NO_OS_GPIO_LOW, values[1]);
+	TEST_ASSERT_EQUAL_UINT8(0xFF, values[2]);
+	TEST_ASSERT_EQUAL_UINT8(NO_OS_GPIO_HIGH, values[3]);
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_get_value(desc[1],
+			      &values[1]));
+	TEST_ASSERT_EQUAL_UINT8(NO_OS_GPIO_LOW, values[1]);
+	TEST_ASSERT_EQUAL_UINT32(2, nb_get_values);
+
+	desc[2] = desc[3];
+	gpio_remove(desc, 3);
+}
+
+void test_gpio_group_and_single(void)
+{
+	const uint32_t offsets[2] = {1, 2};
+	struct no_os_gpio_desc *desc[3];
+	uint8_t values[3] = {1, 1, 1};
+
+	group_get(desc, 2, offsets);
+	gpio_get(&desc[2], 8);
+
+	/* One ioctl for each line request */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_set_values(desc,
+			      3, values));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_set_values);
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_get_values(desc,
+			      3, values));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_get_values);
+	TEST_ASSERT_EQUAL_HEX64(NO_OS_BIT_ULL(1) | NO_OS_BIT_ULL(2) |
+				NO_OS_BIT_ULL(8), chip_levels);
+
+	gpio_remove(desc, 3);
+}
+
+void test_gpio_group_config(void)
+{
+	struct no_os_gpio_init_param param[4] = {
+		{.number = 0, .pull = NO_OS_PULL_UP},
+		{.number = 1, .pull = NO_OS_PULL_NONE},
+		{.number = 2, .pull = NO_OS_PULL_DOWN},
+		{.number = 3, .pull = NO_OS_PULL_UP_WEAK},
+	};
+	struct no_os_gpio_desc *desc[4];
+	struct gpio_v2_line_config *config;
+	struct fake_req *freq;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_get_group(desc, 4, param));
+	freq = fake_req_of_line(0);
+	TEST_ASSERT_NOT_NULL(freq);
+	config = &freq->req.config;
+
+	/* The flags of the first line, then one attribute for the others */
+	TEST_ASSERT_EQUAL_UINT32(4, freq->req.num_lines);
+	TEST_ASSERT_EQUAL_HEX64(GPIO_V2_LINE_FLAG_INPUT |
+				GPIO_V2_LINE_FLAG_BIAS_PULL_UP, config->flags);
+	TEST_ASSERT_EQUAL_UINT32(2, config->num_attrs);
+	TEST_ASSERT_EQUAL_UINT32(GPIO_V2_LINE_ATTR_ID_FLAGS,
+				 config->attrs[0].attr.id);
+	TEST_ASSERT_EQUAL_HEX64(0, config->attrs[0].attr.flags);
+	TEST_ASSERT_EQUAL_HEX64(0x2, config->attrs[0].mask);
+	TEST_ASSERT_EQUAL_HEX64(GPIO_V2_LINE_FLAG_INPUT |
+				GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN,
+				config->attrs[1].attr.flags);
+	TEST_ASSERT_EQUAL_HEX64(0x4, config->attrs[1].mask);
+
+	/* An output of the group gets the output values attribute */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_direction_output(
+				      desc[1], NO_OS_GPIO_HIGH));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_set_config);
+	TEST_ASSERT_EQUAL_UINT32(3, config->num_attrs);
+	TEST_ASSERT_EQUAL_HEX64(GPIO_V2_LINE_FLAG_OUTPUT,
+				config->attrs[0].attr.flags);
+	TEST_ASSERT_EQUAL_UINT32(GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES,
+				 config->attrs[2].attr.id);
+	TEST_ASSERT_EQUAL_HEX64(0x2, config->attrs[2].mask);
+	TEST_ASSERT_EQUAL_HEX64(0x2, config->attrs[2].attr.values);
+	TEST_ASSERT_EQUAL_HEX64(NO_OS_BIT_ULL(1), chip_levels);
+
+	gpio_remove(desc, 4);
+}
+
+void test_gpio_group_remove(void)
+{
+	const uint32_t offsets[3] = {30, 31, 32};
+	struct no_os_gpio_desc *desc[3];
+	uint8_t values[2] = {1, 1};
+	struct fake_req *freq;
+
+	group_get(desc, 3, offsets);
+	freq = fake_req_of_line(30);
+
+	/* The request is kept while a line of the group is used */
+	gpio_remove(desc, 1);
+	TEST_ASSERT_TRUE(freq->used);
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_set_values(&desc[1],
+			      2, values));
+	TEST_ASSERT_EQUAL_HEX64(0x6, last_values.mask);
+
+	/* A line of the group can't be requested alone meanwhile */
+	TEST_ASSERT_EQUAL_INT(-EBUSY, linux_gpio_cdev_set_edge(0, 30,
+			      GPIO_V2_LINE_FLAG_EDGE_RISING, NULL));
+
+	gpio_remove(&desc[1], 2);
+	TEST_ASSERT_FALSE(freq->used);
+	TEST_ASSERT_EQUAL_UINT32(0, gpio_chips[0].nb_lines);
+
+	/* The lines are free again */
+	group_get(desc, 3, offsets);
+	gpio_remove(desc, 3);
+}
+
+void test_gpio_group_errors(void)
+{
+	struct no_os_gpio_init_param param[3] = {
+		{.number = 6}, {.number = 7}, {.number = 6},
+	};
+	struct no_os_gpio_desc *desc[3];
+	struct no_os_gpio_desc *single;
+
+	/* Same line twice, lines of different chips */
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_gpio_cdev_get_group(desc, 3, param));
+	param[2].number = 8;
+	param[2].port = 1;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_gpio_cdev_get_group(desc, 3, param));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_gpio_cdev_get_group(desc, 0, param));
+	TEST_ASSERT_EQUAL_UINT32(0, nb_get_line);
+
+	/* A line already requested */
+	param[2].port = 0;
+	gpio_get(&single, 7);
+	TEST_ASSERT_EQUAL_INT(-EBUSY, linux_gpio_cdev_get_group(desc, 3, param));
+	TEST_ASSERT_NULL(desc[0]);
+	TEST_ASSERT_EQUAL_UINT32(1, gpio_chips[0].nb_lines);
+
+	gpio_remove(&single, 1);
+}
+
+void test_gpio_irq_events(void)
+{
+	struct no_os_irq_init_param ip = {.irq_ctrl_id = 0};
+	struct no_os_callback_desc cb = {.callback = edge_callback};
+	struct no_os_irq_ctrl_desc *irq_desc;
+	struct linux_gpio_irq_desc *gdesc;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.init(&irq_desc, &ip));
+	gdesc = irq_desc->extra;
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.register_callback(irq_desc,
+			      12, &cb));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.trigger_level_set(irq_desc,
+			      12, NO_OS_IRQ_EDGE_BOTH));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.enable(irq_desc, 12));
+	TEST_ASSERT_EQUAL_HEX64(GPIO_V2_LINE_FLAG_INPUT |
+				GPIO_V2_LINE_FLAG_EDGE_RISING |
+				GPIO_V2_LINE_FLAG_EDGE_FALLING,
+				fake_req_of_line(12)->req.config.flags);
+
+	raise_edge(12);
+	raise_edge(12);
+	TEST_ASSERT_TRUE(wait_callbacks(2));
+	TEST_ASSERT_EQUAL_UINT64(2, gdesc->nb_events);
+
+	/* The line is released with the events */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.disable(irq_desc, 12));
+	TEST_ASSERT_NULL(fake_req_of_line(12));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.unregister_callback(irq_desc,
+			      12, &cb));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.remove(irq_desc));
+}
+
+void test_gpio_irq_shared_line(void)
+{
+	struct no_os_irq_init_param ip = {.irq_ctrl_id = 0};
+	struct no_os_callback_desc cb = {.callback = edge_callback};
+	struct no_os_irq_ctrl_desc *irq_desc;
+	struct no_os_gpio_desc *desc;
+	uint8_t value;
+
+	gpio_get(&desc, 14);
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.init(&irq_desc, &ip));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.register_callback(irq_desc,
+			      14, &cb));
+
+	/* The request of the GPIO gets the edge flags */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.enable(irq_desc, 14));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_get_line);
+	TEST_ASSERT_EQUAL_UINT32(1, nb_set_config);
+	raise_edge(14);
+	TEST_ASSERT_TRUE(wait_callbacks(1));
+
+	/* and loses them when the events are disabled, the GPIO keeps it */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.disable(irq_desc, 14));
+	TEST_ASSERT_NOT_NULL(fake_req_of_line(14));
+	TEST_ASSERT_EQUAL_HEX64(GPIO_V2_LINE_FLAG_INPUT,
+				fake_req_of_line(14)->req.config.flags);
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_cdev_ops.gpio_ops_get_value(desc,
+			      &value));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.unregister_callback(irq_desc,
+			      14, &cb));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.remove(irq_desc));
+	gpio_remove(&desc, 1);
+}
+
+void test_gpio_irq_grouped_line(void)
+{
+	const uint32_t offsets[2] = {16, 17};
+	struct no_os_irq_init_param ip = {.irq_ctrl_id = 0};
+	struct no_os_callback_desc cb = {.callback = edge_callback};
+	struct no_os_irq_ctrl_desc *irq_desc;
+	struct no_os_gpio_desc *desc[2];
+
+	group_get(desc, 2, offsets);
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.init(&irq_desc, &ip));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.register_callback(irq_desc,
+			      16, &cb));
+
+	/* The events of the request would be those of both lines */
+	TEST_ASSERT_EQUAL_INT(-EBUSY, linux_gpio_irq_ops.enable(irq_desc, 16));
+	TEST_ASSERT_EQUAL_UINT32(0, nb_set_config);
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.unregister_callback(irq_desc,
+			      16, &cb));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_ops.remove(irq_desc));
+	gpio_remove(desc, 2);
+}
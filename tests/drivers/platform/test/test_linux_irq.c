@@ -0,0 +1,258 @@
+/***************************************************************************//**
+ *   @file   test_linux_irq.c
+ *   @brief  Interrupt lines of linux_irq.c, raised by linux_timer.c and by
+ *           software triggers.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "no_os_alloc.h"
+#include "no_os_irq.h"
+#include "no_os_timer.h"
+#include "linux_irq.c"
+#include "linux_timer.c"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define SW_IRQ_ID	5
+#define TIMER_ID	3
+#define WAIT_MS		2000
+
+static struct no_os_irq_ctrl_desc *irq_desc;
+static atomic_uint nb_callbacks;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct no_os_irq_init_param ip = {.irq_ctrl_id = 0};
+
+	atomic_store(&nb_callbacks, 0);
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_ops.init(&irq_desc, &ip));
+}
+
+void tearDown(void)
+{
+	struct no_os_callback_desc cb = {0};
+
+	linux_irq_ops.unregister_callback(irq_desc, SW_IRQ_ID, &cb);
+	linux_irq_ops.unregister_callback(irq_desc, TIMER_ID, &cb);
+	linux_irq_clear_stats(SW_IRQ_ID);
+	linux_irq_clear_stats(TIMER_ID);
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_ops.remove(irq_desc));
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void count_callback(void *ctx)
+{
+	atomic_fetch_add(&nb_callbacks, 1);
+}
+
+static void register_line(uint32_t irq_id)
+{
+	struct no_os_callback_desc cb = {.callback = count_callback};
+
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_ops.register_callback(irq_desc,
+			      irq_id, &cb));
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_ops.enable(irq_desc, irq_id));
+}
+
+static bool wait_callbacks(uint32_t count)
+{
+	uint32_t i;
+
+	for (i = 0; i < WAIT_MS; i++) {
+		if (atomic_load(&nb_callbacks) >= count)
+			return true;
+		usleep(1000);
+	}
+
+	return false;
+}
+
+static bool wait_missed(uint32_t irq_id, uint64_t count)
+{
+	struct linux_irq_stats stats;
+	uint32_t i;
+
+	for (i = 0; i < WAIT_MS; i++) {
+		TEST_ASSERT_EQUAL_INT(0, linux_irq_get_stats(irq_id, &stats));
+		if (stats.nb_missed >= count)
+			return true;
+		usleep(1000);
+	}
+
+	return false;
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_irq_software_trigger(void)
+{
+	struct linux_irq_stats stats;
+
+	register_line(SW_IRQ_ID);
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_trigger(SW_IRQ_ID));
+	TEST_ASSERT_TRUE(wait_callbacks(1));
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_trigger(SW_IRQ_ID));
+	TEST_ASSERT_TRUE(wait_callbacks(2));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_get_stats(SW_IRQ_ID, &stats));
+	TEST_ASSERT_EQUAL_UINT64(2, stats.nb_events);
+	TEST_ASSERT_EQUAL_UINT64(0, stats.nb_missed);
+	TEST_ASSERT_TRUE(stats.min_latency_ns <= stats.max_latency_ns);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_irq_trigger(LINUX_IRQ_MAX_LINES));
+}
+
+void test_irq_disabled_line(void)
+{
+	struct linux_irq_stats stats;
+
+	register_line(SW_IRQ_ID);
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_ops.disable(irq_desc, SW_IRQ_ID));
+
+	/* The events raised while disabled are lost, and counted */
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_trigger(SW_IRQ_ID));
+	TEST_ASSERT_TRUE(wait_missed(SW_IRQ_ID, 1));
+	TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&nb_callbacks));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_ops.enable(irq_desc, SW_IRQ_ID));
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_trigger(SW_IRQ_ID));
+	TEST_ASSERT_TRUE(wait_callbacks(1));
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_get_stats(SW_IRQ_ID, &stats));
+	TEST_ASSERT_EQUAL_UINT64(1, stats.nb_events);
+	TEST_ASSERT_EQUAL_UINT64(1, stats.nb_missed);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_irq_ops.trigger_level_set(irq_desc,
+			      SW_IRQ_ID, NO_OS_IRQ_LEVEL_HIGH));
+}
+
+void test_irq_global_disable(void)
+{
+	register_line(SW_IRQ_ID);
+
+	/* The callbacks wait for the global enable */
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_ops.global_disable(irq_desc));
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_trigger(SW_IRQ_ID));
+	usleep(20000);
+	TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&nb_callbacks));
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_ops.global_enable(irq_desc));
+	TEST_ASSERT_TRUE(wait_callbacks(1));
+}
+
+void test_timer_periodic(void)
+{
+	struct no_os_timer_init_param tip = {
+		.id = TIMER_ID,
+		.freq_hz = 1000,
+		/* 5 ms */
+		.ticks_count = 5,
+	};
+	struct no_os_timer_desc *timer;
+	struct linux_irq_stats stats;
+	uint64_t elapsed;
+	uint32_t count;
+
+	register_line(LINUX_TIMER_IRQ_ID(TIMER_ID));
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_init(&timer, &tip));
+
+	/* Nothing before the start */
+	usleep(20000);
+	TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&nb_callbacks));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_start(timer));
+	TEST_ASSERT_TRUE(wait_callbacks(5));
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_get_elapsed_time_nsec(timer,
+			      &elapsed));
+	TEST_ASSERT_TRUE(elapsed >= 5 * 5000000ull);
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_counter_get(timer, &count));
+	TEST_ASSERT_TRUE(count < tip.ticks_count);
+
+	/* No more events once stopped */
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_stop(timer));
+	count = atomic_load(&nb_callbacks);
+	usleep(20000);
+	TEST_ASSERT_EQUAL_UINT32(count, atomic_load(&nb_callbacks));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_get_stats(LINUX_TIMER_IRQ_ID(TIMER_ID),
+			      &stats));
+	TEST_ASSERT_EQUAL_UINT64(count, stats.nb_events);
+
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_remove(timer));
+}
+
+void test_timer_counter(void)
+{
+	struct no_os_timer_init_param tip = {
+		.id = TIMER_ID,
+		.freq_hz = 0,
+		.ticks_count = 0,
+	};
+	struct no_os_timer_desc *timer;
+	uint32_t freq, count;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_init(&timer, &tip));
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_count_clk_get(timer, &freq));
+	TEST_ASSERT_EQUAL_UINT32(LINUX_TIMER_DEFAULT_FREQ_HZ, freq);
+
+	/* Without a period the counter runs freely, without events */
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_counter_set(timer, 100000));
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_counter_get(timer, &count));
+	TEST_ASSERT_TRUE(count >= 100000 && count < 101000);
+
+	/* The count is kept when the frequency changes */
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_count_clk_set(timer, 1000000));
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_counter_get(timer, &count));
+	TEST_ASSERT_TRUE(count >= 100000 && count < 200000);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_timer_count_clk_set(timer, 0));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_timer_remove(timer));
+}
@@ -0,0 +1,341 @@
+/***************************************************************************//**
+ *   @file   test_iio.c
+ *   @brief  Unit tests and benchmarks of the iio attribute accesses.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iio.h"
+#include "iio_types.h"
+#include "iiod.h"
+#include "mock_no_os_uart.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_alloc.h"
+#include "no_os_list.h"
+#include "no_os_util.h"
+#include "no_os_error.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_CH			16
+#define NB_ATTRS		24
+#define CONN_BUF_SIZE		0x1000
+#define OUT_SIZE		0x1000
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_CMDS		200000
+#endif
+
+/* Local backend connection: commands to be received and the answers */
+struct fake_conn {
+	const char *in;
+	uint32_t in_len;
+	uint32_t in_idx;
+	char out[OUT_SIZE];
+	uint32_t out_len;
+};
+
+/* Last write seen by an attribute */
+struct fake_store {
+	char val[32];
+	int32_t ch_num;
+	bool ch_out;
+	intptr_t priv;
+};
+
+static char attr_names[NB_ATTRS][16];
+static struct iio_attribute ch_attrs[NB_ATTRS + 1];
+static struct iio_attribute dev_attrs[NB_ATTRS + 1];
+static struct iio_channel adc_channels[NB_CH];
+static struct iio_channel dac_channels[NB_CH];
+static struct iio_device adc_device = {
+	.num_ch = NB_CH,
+	.channels = adc_channels,
+	.attributes = dev_attrs,
+	.debug_attributes = dev_attrs,
+};
+static struct iio_device dac_device = {
+	.num_ch = NB_CH,
+	.channels = dac_channels,
+	.attributes = dev_attrs,
+};
+
+static char conn_buf[CONN_BUF_SIZE];
+static struct fake_conn conn;
+static struct fake_store store;
+static struct iio_desc *iio;
+
+/*******************************************************************************
+ *    FAKE DEVICES AND CONNECTION
+ ******************************************************************************/
+
+static int fake_show(void *device, char *buf, uint32_t len,
+		     const struct iio_ch_info *channel, intptr_t priv)
+{
+	if (!channel)
+		return snprintf(buf, len, "dev %d", (int)priv);
+
+	return snprintf(buf, len, "%s%d %d", channel->ch_out ? "out" : "in",
+			(int)channel->ch_num, (int)priv);
+}
+
+static int fake_store(void *device, char *buf, uint32_t len,
+		      const struct iio_ch_info *channel, intptr_t priv)
+{
+	snprintf(store.val, sizeof(store.val), "%s", buf);
+	store.ch_num = channel ? channel->ch_num : -1;
+	store.ch_out = channel ? channel->ch_out : false;
+	store.priv = priv;
+
+	return len;
+}
+
+static int fake_recv(void *c, uint8_t *buf, uint32_t len)
+{
+	len = no_os_min(len, conn.in_len - conn.in_idx);
+	if (!len)
+		return -EAGAIN;
+
+	memcpy(buf, conn.in + conn.in_idx, len);
+	conn.in_idx += len;
+
+	return len;
+}
+
+static int fake_send(void *c, uint8_t *buf, uint32_t len)
+{
+	len = no_os_min(len, OUT_SIZE - conn.out_len);
+	memcpy(conn.out + conn.out_len, buf, len);
+	conn.out_len += len;
+
+	return len;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct iio_local_backend backend = {
+		.local_backend_event_read = fake_recv,
+		.local_backend_event_write = fake_send,
+		.local_backend_buff = conn_buf,
+		.local_backend_buff_len = sizeof(conn_buf),
+	};
+	struct iio_device_init devs[] = {
+		{.name = "adc", .dev_descriptor = &adc_device},
+		{.name = "dac", .dev_descriptor = &dac_device},
+	};
+	struct iio_init_param param = {
+		.phy_type = USE_LOCAL_BACKEND,
+		.local_backend = &backend,
+		.devs = devs,
+		.nb_devs = NO_OS_ARRAY_SIZE(devs),
+	};
+	uint32_t i;
+
+	/* Names sharing prefixes, as real attributes do */
+	for (i = 0; i < NB_ATTRS; i++) {
+		sprintf(attr_names[i], "calib_attr_%02u", (unsigned)i);
+		ch_attrs[i] = (struct iio_attribute) {
+			.name = attr_names[i],
+			.priv = i,
+			.show = fake_show,
+			.store = fake_store,
+		};
+	}
+	memcpy(dev_attrs, ch_attrs, sizeof(dev_attrs));
+
+	for (i = 0; i < NB_CH; i++) {
+		adc_channels[i] = (struct iio_channel) {
+			.ch_type = IIO_VOLTAGE,
+			.channel = i,
+			.scan_index = i,
+			.attributes = ch_attrs,
+			.indexed = true,
+		};
+		dac_channels[i] = adc_channels[i];
+		dac_channels[i].ch_out = true;
+	}
+
+	memset(&conn, 0, sizeof(conn));
+	memset(&store, 0, sizeof(store));
+	TEST_ASSERT_EQUAL_INT(0, iio_init(&iio, &param));
+}
+
+void tearDown(void)
+{
+	iio_remove(iio);
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* Run one command and check the whole answer */
+static void run(const char *cmd, const char *answer)
+{
+	uint32_t steps = 0;
+	int32_t ret;
+
+	conn.in = cmd;
+	conn.in_len = strlen(cmd);
+	conn.in_idx = 0;
+	conn.out_len = 0;
+	while ((ret = iio_step(iio)) == -EAGAIN)
+		TEST_ASSERT_TRUE(++steps < 1000);
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	TEST_ASSERT_EQUAL_UINT32(conn.in_len, conn.in_idx);
+	if (answer)
+		TEST_ASSERT_EQUAL_STRING_LEN(answer, conn.out, conn.out_len);
+}
+
+/* Answer of a READ returning val */
+static const char *read_answer(const char *val)
+{
+	static char answer[64];
+
+	sprintf(answer, "%u\n%s\n", (unsigned)strlen(val), val);
+
+	return answer;
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_iio_read_channel_attrs(void)
+{
+	char cmd[96], val[32];
+	uint32_t ch, a;
+
+	for (ch = 0; ch < NB_CH; ch++)
+		for (a = 0; a < NB_ATTRS; a++) {
+			sprintf(cmd, "READ iio:device0 INPUT voltage%u %s\n",
+				(unsigned)ch, attr_names[a]);
+			sprintf(val, "in%u %u", (unsigned)ch, (unsigned)a);
+			run(cmd, read_answer(val));
+
+			sprintf(cmd, "READ iio:device1 OUTPUT voltage%u %s\n",
+				(unsigned)ch, attr_names[a]);
+			sprintf(val, "out%u %u", (unsigned)ch, (unsigned)a);
+			run(cmd, read_answer(val));
+		}
+}
+
+void test_iio_read_device_attrs(void)
+{
+	char cmd[96], val[32];
+	uint32_t a;
+
+	for (a = 0; a < NB_ATTRS; a++) {
+		sprintf(val, "dev %u", (unsigned)a);
+		sprintf(cmd, "READ iio:device0 %s\n", attr_names[a]);
+		run(cmd, read_answer(val));
+		sprintf(cmd, "READ iio:device1 %s\n", attr_names[a]);
+		run(cmd, read_answer(val));
+		sprintf(cmd, "READ iio:device0 DEBUG %s\n", attr_names[a]);
+		run(cmd, read_answer(val));
+	}
+}
+
+void test_iio_write_attrs(void)
+{
+	run("WRITE iio:device1 OUTPUT voltage9 calib_attr_17 4\n1234", "4\n");
+	TEST_ASSERT_EQUAL_STRING_LEN("1234", store.val, strlen(store.val));
+	TEST_ASSERT_EQUAL_INT(9, store.ch_num);
+	TEST_ASSERT_TRUE(store.ch_out);
+	TEST_ASSERT_EQUAL_INT(17, store.priv);
+
+	run("WRITE iio:device0 calib_attr_03 2\n56", "2\n");
+	TEST_ASSERT_EQUAL_STRING_LEN("56", store.val, strlen(store.val));
+	TEST_ASSERT_EQUAL_INT(-1, store.ch_num);
+	TEST_ASSERT_EQUAL_INT(3, store.priv);
+}
+
+void test_iio_read_missing(void)
+{
+	/* Unknown attribute, channel, direction and device */
+	run("READ iio:device0 INPUT voltage3 calib_attr_99\n", "-2\n");
+	run("READ iio:device0 INPUT voltage16 calib_attr_00\n", "-2\n");
+	run("READ iio:device0 OUTPUT voltage3 calib_attr_00\n", "-2\n");
+	run("READ iio:device0 calib_attr\n", "-2\n");
+	run("READ iio:device2 calib_attr_00\n", "-19\n");
+	run("READ iio:devicex calib_attr_00\n", "-19\n");
+}
+
+#ifdef NO_OS_TEST_BENCH
+/* Attribute reads per second */
+static double read_bench(const char *cmd)
+{
+	struct timespec start;
+	uint32_t i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_CMDS; i++)
+		run(cmd, NULL);
+
+	return BENCH_CMDS / bench_elapsed_s(&start);
+}
+
+void test_iio_read_bench(void)
+{
+	static const char *const cmds[] = {
+		"READ iio:device0 INPUT voltage0 calib_attr_00\n",
+		"READ iio:device1 OUTPUT voltage15 calib_attr_23\n",
+		"READ iio:device1 calib_attr_23\n",
+	};
+	char msg[128];
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(cmds); i++) {
+		snprintf(msg, sizeof(msg), "%.*s: %.0f reads/s",
+			 (int)strlen(cmds[i]) - 1, cmds[i], read_bench(cmds[i]));
+		TEST_MESSAGE(msg);
+	}
+}
+#endif
@@ -0,0 +1,691 @@
+/***************************************************************************//**
+ *   @file   test_iiod.c
+ *   @brief  Unit tests and benchmarks of the iiod command handling.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iiod.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_error.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* Same as the connections of iio */
+#define CONN_BUF_SIZE		0x1000
+/* Device buffer, not a multiple of the reads so that regions wrap */
+#define DEV_BUF_SIZE		(48 * 1024 + 6)
+/* Period of the data generated by the device */
+#define PATTERN_SIZE		65521
+#define OUT_SIZE		(64 * 1024)
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_BYTES		(256 * 1024 * 1024)
+#define BENCH_READ		(16 * 1024)
+#define BENCH_ATTR_READS	(4 * 1024 * 1024)
+#define BENCH_PIPELINE		32
+#endif
+
+/* Application side of iiod: a device with a circular buffer */
+struct fake_dev {
+	struct no_os_circular_buffer cb;
+	int8_t mem[DEV_BUF_SIZE];
+	/* Size of the buffer opened by the client */
+	uint32_t size;
+	/* Bytes generated since open */
+	uint64_t generated;
+	bool opened;
+};
+
+/* Connection: commands to be received and everything sent */
+struct fake_conn {
+	const char *in;
+	uint32_t in_len;
+	uint32_t in_idx;
+	uint8_t out[OUT_SIZE];
+	uint32_t out_len;
+	/* Only count the sent bytes, as a socket would */
+	bool discard;
+	uint64_t sent;
+	uint32_t nb_sends;
+};
+
+/* Last attribute write */
+struct fake_attr_write {
+	uint32_t dev;
+	struct iiod_attr_idx attr;
+	char val[16];
+};
+
+static uint8_t pattern[PATTERN_SIZE];
+static char conn_buf[CONN_BUF_SIZE];
+static struct fake_dev dev;
+static struct fake_conn conn;
+static struct iiod_desc *iiod;
+static uint32_t conn_id;
+static struct fake_attr_write attr_write;
+/* Binary commands to be sent */
+static uint8_t frames[1024];
+
+/*******************************************************************************
+ *    FAKE APPLICATION
+ ******************************************************************************/
+
+static int fake_send(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
+{
+	struct fake_conn *c = ctx->conn;
+
+	if (!c->discard) {
+		len = no_os_min(len, OUT_SIZE - c->out_len);
+		memcpy(c->out + c->out_len, buf, len);
+		c->out_len += len;
+	} else {
+		/* Read the data once, like the copy to the network stack */
+		len = no_os_min(len, OUT_SIZE);
+		memcpy(c->out, buf, len);
+	}
+	c->sent += len;
+	c->nb_sends++;
+
+	return len;
+}
+
+static int fake_recv(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
+{
+	struct fake_conn *c = ctx->conn;
+
+	len = no_os_min(len, c->in_len - c->in_idx);
+	if (!len)
+		return -EAGAIN;
+
+	memcpy(buf, c->in + c->in_idx, len);
+	c->in_idx += len;
+
+	return len;
+}
+
+static int fake_open(struct iiod_ctx *ctx, const char *device,
+		     uint32_t samples, uint32_t mask, bool cyclic)
+{
+	struct fake_dev *d = ctx->instance;
+
+	/* One 16 bit channel */
+	if (strcmp(device, "iio:device0") || !samples ||
+	    samples * 2 > DEV_BUF_SIZE)
+		return -EINVAL;
+
+	d->size = samples * 2;
+	d->generated = 0;
+	d->opened = true;
+
+	return no_os_cb_cfg(&d->cb, d->mem, d->size);
+}
+
+static int fake_close(struct iiod_ctx *ctx, const char *device)
+{
+	struct fake_dev *d = ctx->instance;
+
+	d->opened = false;
+
+	return 0;
+}
+
+/* Fill the free space of the buffer, as a DMA transfer would */
+static int fake_refill_buffer(struct iiod_ctx *ctx, const char *device)
+{
+	struct fake_dev *d = ctx->instance;
+	uint32_t used, n, off;
+	int32_t ret;
+
+	if (!d->opened)
+		return -EINVAL;
+
+	no_os_cb_size(&d->cb, &used);
+	n = d->size - used;
+	while (n) {
+		off = d->generated % PATTERN_SIZE;
+		used = no_os_min(n, PATTERN_SIZE - off);
+		ret = no_os_cb_write(&d->cb, pattern + off, used);
+		if (ret)
+			return ret;
+		d->generated += used;
+		n -= used;
+	}
+
+	return 0;
+}
+
+/* Same as iio_read_buffer() */
+static int fake_read_buffer(struct iiod_ctx *ctx, const char *device,
+			    char *buf, uint32_t bytes)
+{
+	struct fake_dev *d = ctx->instance;
+	uint32_t size;
+	int32_t ret;
+
+	ret = no_os_cb_size(&d->cb, &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	bytes = no_os_min(size, bytes);
+	if (!bytes)
+		return -EAGAIN;
+
+	ret = no_os_cb_read(&d->cb, buf, bytes);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	return bytes;
+}
+
+/* Same as iio_get_read_buffer() */
+static int fake_get_read_buffer(struct iiod_ctx *ctx, const char *device,
+				char **buf, uint32_t bytes)
+{
+	struct fake_dev *d = ctx->instance;
+	uint32_t size;
+	int32_t ret;
+
+	ret = no_os_cb_size(&d->cb, &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (!size || !bytes)
+		return -EAGAIN;
+
+	size = 0;
+	ret = no_os_cb_prepare_async_read(&d->cb, bytes, (void **)buf, &size);
+	if (ret != -NO_OS_EOVERRUN && NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	return size ? (int)size : -EAGAIN;
+}
+
+static int fake_read_buffer_done(struct iiod_ctx *ctx, const char *device)
+{
+	struct fake_dev *d = ctx->instance;
+
+	return no_os_cb_end_async_read(&d->cb);
+}
+
+static int fake_read_attr(struct iiod_ctx *ctx, const char *device,
+			  struct iiod_attr *attr, char *buf, uint32_t len)
+{
+	if (strcmp(device, "iio:device0"))
+		return -ENODEV;
+
+	return snprintf(buf, len, "%s %s", attr->channel, attr->name);
+}
+
+static const char *fake_get_dev_id(struct iiod_ctx *ctx, uint32_t dev)
+{
+	return dev ? NULL : "iio:device0";
+}
+
+static int fake_read_attr_by_idx(struct iiod_ctx *ctx, uint32_t dev,
+				 struct iiod_attr_idx *attr, char *buf,
+				 uint32_t len)
+{
+	if (dev)
+		return -ENODEV;
+
+	return snprintf(buf, len, "%u %u %u", (unsigned)attr->type,
+			(unsigned)attr->ch, (unsigned)attr->attr);
+}
+
+static int fake_write_attr_by_idx(struct iiod_ctx *ctx, uint32_t dev,
+				  struct iiod_attr_idx *attr, char *buf,
+				  uint32_t len)
+{
+	if (dev)
+		return -ENODEV;
+
+	attr_write.dev = dev;
+	attr_write.attr = *attr;
+	snprintf(attr_write.val, sizeof(attr_write.val), "%s", buf);
+
+	return len;
+}
+
+static struct iiod_ops fake_ops = {
+	.send = fake_send,
+	.recv = fake_recv,
+	.open = fake_open,
+	.close = fake_close,
+	.refill_buffer = fake_refill_buffer,
+	.read_buffer = fake_read_buffer,
+	.read_attr = fake_read_attr,
+};
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < PATTERN_SIZE; i++)
+		pattern[i] = i * 7 + (i >> 8);
+	memset(&dev, 0, sizeof(dev));
+	memset(&conn, 0, sizeof(conn));
+	fake_ops.get_read_buffer = NULL;
+	fake_ops.read_buffer_done = NULL;
+	fake_ops.get_dev_id = fake_get_dev_id;
+	fake_ops.read_attr_by_idx = fake_read_attr_by_idx;
+	fake_ops.write_attr_by_idx = fake_write_attr_by_idx;
+	memset(&attr_write, 0, sizeof(attr_write));
+	iiod = NULL;
+}
+
+void tearDown(void)
+{
+	struct iiod_conn_data data;
+
+	if (!iiod)
+		return;
+
+	iiod_conn_remove(iiod, conn_id, &data);
+	iiod_remove(iiod);
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void start(bool zero_copy)
+{
+	struct iiod_init_param param = {
+		.ops = &fake_ops,
+		.instance = &dev,
+		.xml = "<context/>",
+		.xml_len = sizeof("<context/>") - 1,
+	};
+	struct iiod_conn_data data = {
+		.conn = &conn,
+		.buf = conn_buf,
+		.len = sizeof(conn_buf),
+	};
+
+	if (zero_copy) {
+		fake_ops.get_read_buffer = fake_get_read_buffer;
+		fake_ops.read_buffer_done = fake_read_buffer_done;
+	}
+	TEST_ASSERT_EQUAL_INT(0, iiod_init(&iiod, &param));
+	TEST_ASSERT_EQUAL_INT(0, iiod_conn_add(iiod, &data, &conn_id));
+}
+
+/* Run the commands in cmd, nb_cmds of them, and check that all were used */
+static void run(const char *cmd, uint32_t len, uint32_t nb_cmds)
+{
+	uint32_t steps = 0;
+	int32_t ret;
+
+	conn.in = cmd;
+	conn.in_len = len;
+	conn.in_idx = 0;
+	while (nb_cmds) {
+		ret = iiod_conn_step(iiod, conn_id);
+		if (ret == -EAGAIN) {
+			TEST_ASSERT_TRUE(++steps < 1000000);
+			continue;
+		}
+		TEST_ASSERT_EQUAL_INT(0, ret);
+		nb_cmds--;
+	}
+	TEST_ASSERT_EQUAL_UINT32(len, conn.in_idx);
+}
+
+static void run_line(const char *line)
+{
+	run(line, strlen(line), 1);
+}
+
+/* Check data against the device data, from stream offset off */
+static void check_data(const uint8_t *data, uint32_t len, uint64_t off)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		if (data[i] != pattern[(off + i) % PATTERN_SIZE])
+			TEST_FAIL_MESSAGE("Wrong buffer data");
+}
+
+/* Append a binary command to frames, return the new length */
+static uint32_t bin_cmd(uint32_t idx, uint16_t client_id, uint8_t op,
+			uint8_t dev, int32_t code, const void *payload,
+			uint32_t len)
+{
+	uint8_t *hdr = frames + idx;
+
+	TEST_ASSERT_TRUE(idx + IIOD_BIN_HDR_SIZE + len <= sizeof(frames));
+	no_os_put_unaligned_le16(client_id, hdr);
+	hdr[2] = op;
+	hdr[3] = dev;
+	no_os_put_unaligned_le32(code, hdr + 4);
+	no_os_put_unaligned_le32(len, hdr + 8);
+	if (len)
+		memcpy(hdr + IIOD_BIN_HDR_SIZE, payload, len);
+
+	return idx + IIOD_BIN_HDR_SIZE + len;
+}
+
+/* Check the response header at out[*idx] and skip it */
+static void bin_check_resp(uint32_t *idx, uint16_t client_id, uint8_t dev,
+			   int32_t code, uint32_t len)
+{
+	uint8_t *hdr = conn.out + *idx;
+
+	TEST_ASSERT_TRUE(*idx + IIOD_BIN_HDR_SIZE <= conn.out_len);
+	TEST_ASSERT_EQUAL_UINT16(client_id, no_os_get_unaligned_le16(hdr));
+	TEST_ASSERT_EQUAL_UINT8(IIOD_BIN_OP_RESPONSE, hdr[2]);
+	TEST_ASSERT_EQUAL_UINT8(dev, hdr[3]);
+	TEST_ASSERT_EQUAL_INT32(code, (int32_t)no_os_get_unaligned_le32(hdr + 4));
+	TEST_ASSERT_EQUAL_UINT32(len, no_os_get_unaligned_le32(hdr + 8));
+	*idx += IIOD_BIN_HDR_SIZE;
+}
+
+static void start_binary(bool zero_copy)
+{
+	start(zero_copy);
+	run_line("BINARY\n");
+	TEST_ASSERT_EQUAL_STRING_LEN("0\n", conn.out, conn.out_len);
+	conn.out_len = 0;
+}
+
+static void readbuf_stream(bool zero_copy)
+{
+	static const uint32_t reads[] = {1, 4096, 4097, 30000, 2, 16384};
+	char cmd[64], hdr[32];
+	uint64_t off = 0;
+	uint32_t i, len;
+
+	start(zero_copy);
+	run_line("OPEN iio:device0 24579 00000001\n");
+	TEST_ASSERT_EQUAL_STRING_LEN("0\n", conn.out, conn.out_len);
+
+	for (i = 0; i < 4 * NO_OS_ARRAY_SIZE(reads); i++) {
+		len = reads[i % NO_OS_ARRAY_SIZE(reads)];
+		conn.out_len = 0;
+		sprintf(cmd, "READBUF iio:device0 %"PRIu32"\n", len);
+		run_line(cmd);
+
+		/* Length, mask then the data */
+		sprintf(hdr, "%"PRIu32"\n00000001\n", len);
+		TEST_ASSERT_EQUAL_UINT32(strlen(hdr) + len, conn.out_len);
+		TEST_ASSERT_EQUAL_STRING_LEN(hdr, conn.out, strlen(hdr));
+		check_data(conn.out + strlen(hdr), len, off);
+		off += len;
+	}
+	/* Nothing is left referenced */
+	TEST_ASSERT_FALSE(dev.cb.read.async_started);
+
+	conn.out_len = 0;
+	run_line("CLOSE iio:device0\n");
+	TEST_ASSERT_EQUAL_STRING_LEN("0\n", conn.out, conn.out_len);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_iiod_readbuf_copy(void)
+{
+	readbuf_stream(false);
+}
+
+void test_iiod_readbuf_zero_copy(void)
+{
+	readbuf_stream(true);
+}
+
+void test_iiod_binary_not_supported(void)
+{
+	fake_ops.read_attr_by_idx = NULL;
+	start(false);
+	run_line("BINARY\n");
+	TEST_ASSERT_EQUAL_STRING_LEN("-38\n", conn.out, conn.out_len);
+
+	/* Still in ASCII mode */
+	conn.out_len = 0;
+	run_line("READ iio:device0 INPUT voltage0 raw\n");
+	TEST_ASSERT_EQUAL_STRING_LEN("12\nvoltage0 raw\n", conn.out,
+				     conn.out_len);
+}
+
+void test_iiod_binary_attrs(void)
+{
+	uint32_t len = 0, idx = 0;
+
+	start_binary(false);
+
+	/* Pipelined commands are answered in order */
+	len = bin_cmd(len, 10, IIOD_BIN_OP_READ_ATTR, 0,
+		      IIOD_BIN_ATTR_CODE(IIO_ATTR_TYPE_CH_IN, 3, 7), NULL, 0);
+	len = bin_cmd(len, 11, IIOD_BIN_OP_WRITE_ATTR, 0,
+		      IIOD_BIN_ATTR_CODE(IIO_ATTR_TYPE_DEVICE, 0, 2), "1234", 4);
+	len = bin_cmd(len, 12, IIOD_BIN_OP_READ_ATTR, 5,
+		      IIOD_BIN_ATTR_CODE(IIO_ATTR_TYPE_DEVICE, 0, 0), NULL, 0);
+	len = bin_cmd(len, 13, 0x7F, 0, 0, NULL, 0);
+	len = bin_cmd(len, 14, IIOD_BIN_OP_VERSION, 0, 0, NULL, 0);
+	run((char *)frames, len, 5);
+
+	bin_check_resp(&idx, 10, 0, 5, 5);
+	TEST_ASSERT_EQUAL_STRING_LEN("3 3 7", conn.out + idx, 5);
+	idx += 5;
+	bin_check_resp(&idx, 11, 0, 4, 0);
+	TEST_ASSERT_EQUAL_STRING_LEN("1234", attr_write.val,
+				     strlen(attr_write.val));
+	TEST_ASSERT_EQUAL_UINT32(IIO_ATTR_TYPE_DEVICE, attr_write.attr.type);
+	TEST_ASSERT_EQUAL_UINT32(2, attr_write.attr.attr);
+	bin_check_resp(&idx, 12, 5, -ENODEV, 0);
+	bin_check_resp(&idx, 13, 0, -EINVAL, 0);
+	bin_check_resp(&idx, 14, 0, 0, IIOD_VERSION_LEN);
+	TEST_ASSERT_EQUAL_STRING_LEN(IIOD_VERSION, conn.out + idx,
+				     IIOD_VERSION_LEN);
+	TEST_ASSERT_EQUAL_UINT32(idx + IIOD_VERSION_LEN, conn.out_len);
+}
+
+static void binary_readbuf(bool zero_copy)
+{
+	static const uint32_t reads[] = {1, 4096, 30000, 4097, 16384};
+	uint8_t open_payload[8];
+	uint32_t i, len, idx;
+	uint64_t off = 0;
+
+	start_binary(zero_copy);
+
+	/* Not opened yet: error and no data */
+	len = bin_cmd(0, 1, IIOD_BIN_OP_READBUF, 0, 16, NULL, 0);
+	run((char *)frames, len, 1);
+	idx = 0;
+	bin_check_resp(&idx, 1, 0, -EINVAL, 0);
+	TEST_ASSERT_EQUAL_UINT32(idx, conn.out_len);
+
+	no_os_put_unaligned_le32(0x1, open_payload);
+	no_os_put_unaligned_le32(0, open_payload + 4);
+	len = bin_cmd(0, 2, IIOD_BIN_OP_OPEN, 0, 24579, open_payload,
+		      sizeof(open_payload));
+	conn.out_len = 0;
+	run((char *)frames, len, 1);
+	idx = 0;
+	bin_check_resp(&idx, 2, 0, 0, 0);
+
+	for (i = 0; i < 3 * NO_OS_ARRAY_SIZE(reads); i++) {
+		len = reads[i % NO_OS_ARRAY_SIZE(reads)];
+		bin_cmd(0, 100 + i, IIOD_BIN_OP_READBUF, 0, len, NULL, 0);
+		conn.out_len = 0;
+		run((char *)frames, IIOD_BIN_HDR_SIZE, 1);
+
+		/* The data follows the header, no mask */
+		idx = 0;
+		bin_check_resp(&idx, 100 + i, 0, len, len);
+		TEST_ASSERT_EQUAL_UINT32(idx + len, conn.out_len);
+		check_data(conn.out + idx, len, off);
+		off += len;
+	}
+	TEST_ASSERT_FALSE(dev.cb.read.async_started);
+}
+
+void test_iiod_binary_readbuf_copy(void)
+{
+	binary_readbuf(false);
+}
+
+void test_iiod_binary_readbuf_zero_copy(void)
+{
+	binary_readbuf(true);
+}
+
+#ifdef NO_OS_TEST_BENCH
+static double readbuf_bench(bool zero_copy, bool binary, double *sends)
+{
+	uint8_t open_payload[8] = {1};
+	struct timespec start_time;
+	char cmd[64];
+	const char *c = cmd;
+	uint32_t i, len, nb;
+
+	if (binary) {
+		start_binary(zero_copy);
+		len = bin_cmd(0, 0, IIOD_BIN_OP_OPEN, 0, 24579, open_payload,
+			      sizeof(open_payload));
+		run((char *)frames, len, 1);
+		len = bin_cmd(0, 1, IIOD_BIN_OP_READBUF, 0, BENCH_READ, NULL, 0);
+		c = (char *)frames;
+	} else {
+		start(zero_copy);
+		run_line("OPEN iio:device0 24579 00000001\n");
+		len = sprintf(cmd, "READBUF iio:device0 %u\n", BENCH_READ);
+	}
+
+	nb = BENCH_BYTES / BENCH_READ;
+	conn.discard = true;
+	conn.sent = 0;
+	conn.nb_sends = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	for (i = 0; i < nb; i++)
+		run(c, len, 1);
+
+	TEST_ASSERT_TRUE(conn.sent >= (uint64_t)nb * BENCH_READ);
+	*sends = (double)conn.nb_sends / nb;
+
+	return (double)nb * BENCH_READ / bench_elapsed_s(&start_time) / 1e6;
+}
+
+void test_iiod_readbuf_bench(void)
+{
+	double res[4], sends[4];
+	char msg[256];
+	uint32_t i;
+
+	for (i = 0; i < 4; i++) {
+		res[i] = readbuf_bench(i & 1, i & 2, &sends[i]);
+		tearDown();
+		setUp();
+	}
+
+	snprintf(msg, sizeof(msg),
+		 "READBUF %u bytes: ASCII copy %.0f MB/s, %.1f sends/cmd; "
+		 "ASCII zero-copy %.0f MB/s, %.1f sends/cmd; "
+		 "binary copy %.0f MB/s, %.1f sends/cmd; "
+		 "binary zero-copy %.0f MB/s, %.1f sends/cmd",
+		 BENCH_READ, res[0], sends[0], res[1], sends[1],
+		 res[2], sends[2], res[3], sends[3]);
+	TEST_MESSAGE(msg);
+}
+
+/* Attribute reads per second, BENCH_PIPELINE commands per receive */
+static double attr_bench(bool binary)
+{
+	static const char line[] = "READ iio:device0 INPUT voltage3 raw\n";
+	static char lines[BENCH_PIPELINE * (sizeof(line) - 1)];
+	struct timespec start_time;
+	const char *c = lines;
+	uint32_t i, len = 0;
+
+	if (binary) {
+		start_binary(false);
+		for (i = 0; i < BENCH_PIPELINE; i++)
+			len = bin_cmd(len, i, IIOD_BIN_OP_READ_ATTR, 0,
+				      IIOD_BIN_ATTR_CODE(IIO_ATTR_TYPE_CH_IN,
+							 3, 7), NULL, 0);
+		c = (char *)frames;
+	} else {
+		start(false);
+		for (i = 0; i < BENCH_PIPELINE; i++) {
+			memcpy(lines + len, line, sizeof(line) - 1);
+			len += sizeof(line) - 1;
+		}
+	}
+
+	conn.discard = true;
+	clock_gettime(CLOCK_MONOTONIC, &start_time);
+	for (i = 0; i < BENCH_ATTR_READS / BENCH_PIPELINE; i++)
+		run(c, len, BENCH_PIPELINE);
+
+	return BENCH_ATTR_READS / bench_elapsed_s(&start_time);
+}
+
+void test_iiod_attr_bench(void)
+{
+	double ascii, binary;
+	char msg[128];
+
+	ascii = attr_bench(false);
+	tearDown();
+	setUp();
+	binary = attr_bench(true);
+
+	snprintf(msg, sizeof(msg),
+		 "Attribute reads: ASCII %.0f/s, binary %.0f/s",
+		 ascii, binary);
+	TEST_MESSAGE(msg);
+}
+#endif
@@ -0,0 +1,466 @@
+/***************************************************************************//**
+ *   @file   test_iio_scan.c
+ *   @brief  Unit tests and benchmarks of the scan packing engine.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iio_scan.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef NO_OS_TEST_BENCH
+#include <math.h>
+#include <stdio.h>
+#include "bench.h"
+#endif
+
+/*
+ * iio_scan.c is built without IIO_SCAN_SIMD, as in the projects by default.
+ * The SSE2 or NEON version is built here under different names, so that both
+ * are compared with the one sample at a time implementation.
+ */
+#define IIO_SCAN_SIMD
+#define iio_scan_layout_init	simd_scan_layout_init
+#define iio_scan_pack		simd_scan_pack
+#define iio_scan_unpack		simd_scan_unpack
+#define iio_buffer_push_scans	simd_buffer_push_scans
+#define iio_buffer_pop_scans	simd_buffer_pop_scans
+#include "iio_scan.c"
+#undef iio_scan_layout_init
+#undef iio_scan_pack
+#undef iio_scan_unpack
+#undef iio_buffer_push_scans
+#undef iio_buffer_pop_scans
+#undef IIO_SCAN_SIMD
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_CH		16
+#define NB_SCANS	1000
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_SAMPLES	(8u << 20)
+#endif
+
+static struct scan_type s16_le = {'s', 16, 16, 0, false};
+static struct scan_type u12_be_shift4 = {'u', 12, 16, 4, true};
+static struct scan_type s12_be_shift4 = {'s', 12, 16, 4, true};
+static struct scan_type s14_le_shift2 = {'s', 14, 16, 2, false};
+static struct scan_type s24_le = {'s', 24, 32, 0, false};
+static struct scan_type s24_be_shift8 = {'s', 24, 32, 8, true};
+static struct scan_type u32_be = {'u', 32, 32, 0, true};
+static struct scan_type s18_packed24 = {'s', 18, 24, 2, true};
+static struct scan_type u8_le = {'u', 8, 8, 0, false};
+static struct scan_type s64_le = {'s', 64, 64, 0, false};
+
+static struct iio_channel channels[NB_CH];
+static uint32_t host_in[NB_CH][NB_SCANS];
+static uint32_t host_out[NB_CH][NB_SCANS];
+static uint32_t host_ref[NB_CH][NB_SCANS];
+static uint8_t scans[NB_SCANS * NB_CH * 8];
+static uint8_t scans_ref[NB_SCANS * NB_CH * 8];
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t seed = 7;
+	uint32_t i, k;
+
+	for (k = 0; k < NB_CH; k++)
+		for (i = 0; i < NB_SCANS; i++) {
+			seed = seed * 1103515245 + 12345;
+			host_in[k][i] = seed ^ (seed >> 13);
+		}
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void set_channels(struct scan_type *st)
+{
+	uint32_t k;
+
+	for (k = 0; k < NB_CH; k++)
+		channels[k].scan_type = st;
+}
+
+static void set_pointers(void **ptr, uint32_t data[][NB_SCANS])
+{
+	uint32_t k;
+
+	for (k = 0; k < NB_CH; k++)
+		ptr[k] = data[k];
+}
+
+/*
+ * Check the block pack and unpack, portable and SIMD, against the one sample
+ * at a time implementation, selected by clearing uniform.
+ */
+static void check_against_generic(struct scan_type *st, uint32_t mask,
+				  uint32_t nb_scans)
+{
+	struct iio_scan_layout layout, ref;
+	void *in[NB_CH], *out[NB_CH], *exp[NB_CH];
+	uint32_t k;
+
+	set_channels(st);
+	set_pointers(in, host_in);
+	set_pointers(out, host_out);
+	set_pointers(exp, host_ref);
+	TEST_ASSERT_EQUAL_INT(0, iio_scan_layout_init(&layout, channels,
+			      NB_CH, mask));
+	TEST_ASSERT_TRUE(layout.uniform);
+	ref = layout;
+	ref.uniform = false;
+
+	iio_scan_pack(&ref, scans_ref, (const void *const *)in, nb_scans);
+	iio_scan_pack(&layout, scans, (const void *const *)in, nb_scans);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(scans_ref, scans,
+				      nb_scans * layout.bytes_per_scan);
+	simd_scan_pack(&layout, scans, (const void *const *)in, nb_scans);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(scans_ref, scans,
+				      nb_scans * layout.bytes_per_scan);
+
+	/* Unpack data with all bits set, not only the packed ones */
+	memcpy(scans, host_in, nb_scans * layout.bytes_per_scan);
+	memset(host_ref, 0, sizeof(host_ref));
+	iio_scan_unpack(&ref, exp, scans, nb_scans);
+
+	memset(host_out, 0, sizeof(host_out));
+	iio_scan_unpack(&layout, out, scans, nb_scans);
+	for (k = 0; k < NB_CH; k++)
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(host_ref[k], host_out[k],
+					      sizeof(host_out[k]));
+
+	memset(host_out, 0, sizeof(host_out));
+	simd_scan_unpack(&layout, out, scans, nb_scans);
+	for (k = 0; k < NB_CH; k++)
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(host_ref[k], host_out[k],
+					      sizeof(host_out[k]));
+}
+
+#ifdef NO_OS_TEST_BENCH
+static bool get_next_ch_idx(uint32_t ch_mask, uint32_t last_idx,
+			    uint32_t *new_idx)
+{
+	last_idx++;
+	ch_mask >>= last_idx;
+	if (!ch_mask)
+		return false;
+	while (!(ch_mask & 1)) {
+		last_idx++;
+		ch_mask >>= 1;
+	}
+	*new_idx = last_idx;
+
+	return true;
+}
+
+/* One scan at a time, as drivers did before the engine, without conversion */
+static void bench_per_scan(uint32_t nb_ch, uint32_t bytes, uint32_t nb_scans)
+{
+	uint8_t scan[NB_CH * sizeof(uint32_t)];
+	uint32_t mask = (1u << nb_ch) - 1;
+	uint32_t i, ch, k;
+
+	for (i = 0; i < nb_scans; i++) {
+		k = 0;
+		ch = -1;
+		while (get_next_ch_idx(mask, ch, &ch)) {
+			memcpy(scan + k, (uint8_t *)host_in[ch] + i * bytes, bytes);
+			k += bytes;
+		}
+		memcpy(scans + i * nb_ch * bytes, scan, nb_ch * bytes);
+	}
+}
+
+static void bench_format(const char *name, struct scan_type *st)
+{
+	static const uint32_t nb_chs[] = {1, 2, 4, 8, 16};
+	struct iio_scan_layout layout;
+	struct timespec start;
+	void *ptr[NB_CH];
+	uint32_t nb_scans, rounds, c, r, t;
+	double pack, unpack, per_scan;
+	char msg[128];
+
+	set_channels(st);
+	set_pointers(ptr, host_in);
+	for (c = 0; c < NO_OS_ARRAY_SIZE(nb_chs); c++) {
+		TEST_ASSERT_EQUAL_INT(0, iio_scan_layout_init(&layout, channels,
+				      NB_CH, (1u << nb_chs[c]) - 1));
+		/* Keep the working set in cache, repeat to get the count */
+		nb_scans = no_os_min(NB_SCANS, 16384 / layout.bytes_per_scan);
+		rounds = BENCH_SAMPLES / (nb_scans * nb_chs[c]);
+
+		/* Best of a few runs, the host may be shared */
+		pack = unpack = per_scan = 0;
+		for (t = 0; t < 3; t++) {
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			for (r = 0; r < rounds; r++)
+				iio_scan_pack(&layout, scans,
+					      (const void *const *)ptr, nb_scans);
+			pack = fmax(pack, rounds * nb_scans * nb_chs[c] /
+				    bench_elapsed_s(&start));
+
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			for (r = 0; r < rounds; r++)
+				iio_scan_unpack(&layout, ptr, scans, nb_scans);
+			unpack = fmax(unpack, rounds * nb_scans * nb_chs[c] /
+				      bench_elapsed_s(&start));
+
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			for (r = 0; r < rounds; r++)
+				bench_per_scan(nb_chs[c], st->storagebits / 8,
+					       nb_scans);
+			per_scan = fmax(per_scan, rounds * nb_scans * nb_chs[c] /
+					bench_elapsed_s(&start));
+		}
+
+		snprintf(msg, sizeof(msg),
+			 "%s %2u ch: pack %7.1f unpack %7.1f per scan %7.1f Msamples/s",
+			 name, nb_chs[c], pack / 1e6, unpack / 1e6,
+			 per_scan / 1e6);
+		TEST_MESSAGE(msg);
+	}
+}
+#endif
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_scan_layout(void)
+{
+	struct iio_scan_layout layout;
+
+	set_channels(&s16_le);
+	channels[3].scan_type = &s24_le;
+	channels[5].scan_type = &s18_packed24;
+
+	TEST_ASSERT_EQUAL_INT(0, iio_scan_layout_init(&layout, channels, NB_CH,
+			      0x29));
+	TEST_ASSERT_EQUAL_UINT32(3, layout.nb_ch);
+	TEST_ASSERT_EQUAL_UINT32(2 + 4 + 3, layout.bytes_per_scan);
+	TEST_ASSERT_TRUE(!layout.uniform);
+	TEST_ASSERT_EQUAL_UINT8(0, layout.ch[0].idx);
+	TEST_ASSERT_EQUAL_UINT8(3, layout.ch[1].idx);
+	TEST_ASSERT_EQUAL_UINT8(5, layout.ch[2].idx);
+	TEST_ASSERT_EQUAL_UINT32(2, layout.ch[1].offset);
+	TEST_ASSERT_EQUAL_UINT32(6, layout.ch[2].offset);
+	TEST_ASSERT_EQUAL_UINT8(4, layout.ch[2].host_bytes);
+
+	TEST_ASSERT_EQUAL_INT(0, iio_scan_layout_init(&layout, channels, NB_CH,
+			      0x3));
+	TEST_ASSERT_TRUE(layout.uniform);
+	TEST_ASSERT_TRUE(layout.raw);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_scan_layout_init(&layout, channels,
+			      4, 0x10));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_scan_layout_init(&layout, channels,
+			      NB_CH, 0));
+	channels[1].scan_type = NULL;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, iio_scan_layout_init(&layout, channels,
+			      NB_CH, 0x2));
+}
+
+void test_scan_known_values(void)
+{
+	struct iio_scan_layout layout;
+	const uint8_t raw[] = {
+		0xAB, 0xC5,			/* s12 be >> 4 */
+		0x12, 0x34, 0x56, 0x78,		/* s24 be >> 8 */
+		0x0E, 0x00, 0x07,		/* s18 in 24 be >> 2 */
+		0x81,				/* u8 */
+		0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, /* s64 le */
+	};
+	int16_t a;
+	int32_t b, c;
+	uint8_t d;
+	int64_t e;
+	void *ptr[5] = {&a, &b, &c, &d, &e};
+	uint8_t packed[sizeof(raw)];
+
+	channels[0].scan_type = &s12_be_shift4;
+	channels[1].scan_type = &s24_be_shift8;
+	channels[2].scan_type = &s18_packed24;
+	channels[3].scan_type = &u8_le;
+	channels[4].scan_type = &s64_le;
+	TEST_ASSERT_EQUAL_INT(0, iio_scan_layout_init(&layout, channels, 5,
+			      0x1F));
+	TEST_ASSERT_EQUAL_UINT32(sizeof(raw), layout.bytes_per_scan);
+
+	iio_scan_unpack(&layout, ptr, raw, 1);
+	TEST_ASSERT_EQUAL_INT(-0x544, a);
+	TEST_ASSERT_EQUAL_INT(0x123456, b);
+	TEST_ASSERT_EQUAL_INT(-0x7FFF, c);
+	TEST_ASSERT_EQUAL_UINT8(0x81, d);
+	TEST_ASSERT_TRUE(e == -2);
+
+	/* Bits outside realbits << shift are cleared */
+	iio_scan_pack(&layout, packed, (const void *const *)ptr, 1);
+	TEST_ASSERT_EQUAL_UINT8(0xAB, packed[0]);
+	TEST_ASSERT_EQUAL_UINT8(0xC0, packed[1]);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(raw + 2, packed + 2, 3);
+	TEST_ASSERT_EQUAL_UINT8(0x00, packed[5]);
+	TEST_ASSERT_EQUAL_UINT8(0x0E, packed[6]);
+	TEST_ASSERT_EQUAL_UINT8(0x00, packed[7]);
+	TEST_ASSERT_EQUAL_UINT8(0x04, packed[8]);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(raw + 9, packed + 9, 9);
+}
+
+void test_scan_uniform_matches_generic(void)
+{
+	static struct scan_type *formats[] = {
+		&s16_le, &u12_be_shift4, &s12_be_shift4, &s14_le_shift2,
+		&s24_le, &s24_be_shift8, &u32_be,
+	};
+	static const uint32_t masks[] = {
+		0x1, 0x3, 0x5, 0xF, 0x107, 0xFF, 0xFFF, 0xF0F0, 0xFFFF,
+	};
+	static const uint32_t counts[] = {1, 7, 8, 63, 64, 65, 200, NB_SCANS};
+	uint32_t f, m, n;
+
+	for (f = 0; f < NO_OS_ARRAY_SIZE(formats); f++)
+		for (m = 0; m < NO_OS_ARRAY_SIZE(masks); m++)
+			for (n = 0; n < NO_OS_ARRAY_SIZE(counts); n++)
+				check_against_generic(formats[f], masks[m],
+						      counts[n]);
+}
+
+void test_scan_round_trip(void)
+{
+	struct iio_scan_layout layout;
+	void *in[NB_CH], *out[NB_CH];
+	uint32_t i, k;
+	int32_t exp;
+
+	set_channels(&s24_be_shift8);
+	set_pointers(in, host_in);
+	set_pointers(out, host_out);
+	TEST_ASSERT_EQUAL_INT(0, iio_scan_layout_init(&layout, channels, NB_CH,
+			      0xFFFF));
+	iio_scan_pack(&layout, scans, (const void *const *)in, NB_SCANS);
+	iio_scan_unpack(&layout, out, scans, NB_SCANS);
+
+	for (k = 0; k < NB_CH; k++)
+		for (i = 0; i < NB_SCANS; i++) {
+			exp = (int32_t)(host_in[k][i] << 8) >> 8;
+			TEST_ASSERT_EQUAL_INT(exp, (int32_t)host_out[k][i]);
+		}
+}
+
+void test_scan_buffer_push_pop(void)
+{
+	static uint8_t cb_mem[3 * 8 * 100];
+	struct no_os_circular_buffer cb;
+	struct iio_scan_layout layout;
+	struct iio_buffer buffer;
+	void *in[NB_CH], *out[NB_CH];
+	uint32_t k;
+
+	set_channels(&s16_le);
+	set_pointers(in, host_in);
+	set_pointers(out, host_out);
+	TEST_ASSERT_EQUAL_INT(0, iio_scan_layout_init(&layout, channels, NB_CH,
+			      0xF0));
+	memset(&buffer, 0, sizeof(buffer));
+	buffer.buf = &cb;
+	buffer.bytes_per_scan = layout.bytes_per_scan;
+	buffer.size = 100 * layout.bytes_per_scan;
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_cfg(&cb, (int8_t *)cb_mem,
+					      sizeof(cb_mem)));
+
+	/* Wrap around the end of the circular buffer */
+	TEST_ASSERT_EQUAL_INT(0, iio_buffer_push_scans(&buffer, &layout,
+			      (const void *const *)in, 250));
+	TEST_ASSERT_EQUAL_INT(0, iio_buffer_pop_scans(&buffer, &layout, out,
+			      250));
+	TEST_ASSERT_EQUAL_INT(0, iio_buffer_push_scans(&buffer, &layout,
+			      (const void *const *)in, 100));
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, iio_buffer_pop_scans(&buffer, &layout,
+			      out, 101));
+	TEST_ASSERT_EQUAL_INT(0, iio_buffer_pop_scans(&buffer, &layout, out,
+			      100));
+	for (k = 4; k < 8; k++)
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(host_in[k], host_out[k], 200);
+
+	/* Cyclic buffers are replayed from their start */
+	memset(host_out, 0, sizeof(host_out));
+	buffer.cyclic_info.is_cyclic = true;
+	buffer.cyclic_info.buff_index = 0;
+	iio_scan_pack(&layout, cb_mem, (const void *const *)in, 100);
+	TEST_ASSERT_EQUAL_INT(0, iio_buffer_pop_scans(&buffer, &layout, out,
+			      60));
+	for (k = 4; k < 8; k++)
+		out[k] = (uint16_t *)host_out[k] + 60;
+	TEST_ASSERT_EQUAL_INT(0, iio_buffer_pop_scans(&buffer, &layout, out,
+			      60));
+	for (k = 4; k < 8; k++) {
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(host_in[k], host_out[k], 200);
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(host_in[k],
+					      (uint16_t *)host_out[k] + 100, 40);
+	}
+	TEST_ASSERT_EQUAL_UINT32(20 * layout.bytes_per_scan,
+				 buffer.cyclic_info.buff_index);
+}
+
+#ifdef NO_OS_TEST_BENCH
+void test_scan_bench(void)
+{
+	bench_format("s16/16 le   ", &s16_le);
+	bench_format("s12/16>>4 be", &s12_be_shift4);
+	bench_format("s24/32 le   ", &s24_le);
+	bench_format("u32/32 be   ", &u32_be);
+}
+#endif
@@ -0,0 +1,500 @@
+/***************************************************************************//**
+ *   @file   test_jesd204_fsm.c
+ *   @brief  Unit tests of the JESD204 finite state machine.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "jesd204.h"
+#include "jesd204-priv.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "mock_no_os_delay.h"
+#include "mock_no_os_spi.h"
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+TEST_FILE("jesd204-core.c")
+TEST_FILE("jesd204-fsm.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define MAX_CALLS	512
+#define MAX_DEVS	24
+
+struct test_call {
+	unsigned int dev;
+	enum jesd204_dev_op op;
+	int link_id;
+	enum jesd204_state_op_reason reason;
+};
+
+struct test_dev {
+	unsigned int idx;
+	struct jesd204_dev *jdev;
+	int ret[__JESD204_MAX_OPS];
+	unsigned int defers[__JESD204_MAX_OPS];
+	uint32_t us_per_call;
+	uint32_t spi_per_call;
+};
+
+static struct test_call calls[MAX_CALLS];
+static unsigned int nb_calls;
+static struct test_dev test_devs[MAX_DEVS];
+static struct jesd204_topology_dev topo_devs[MAX_DEVS];
+static struct jesd204_topology *topology;
+static unsigned int nb_devs;
+static uint64_t fake_us;
+static uint32_t fake_spi;
+static unsigned int nb_delays;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(calls, 0, sizeof(calls));
+	memset(test_devs, 0, sizeof(test_devs));
+	memset(topo_devs, 0, sizeof(topo_devs));
+	nb_calls = 0;
+	nb_devs = 0;
+	fake_us = 0;
+	fake_spi = 0;
+	nb_delays = 0;
+	topology = NULL;
+}
+
+void tearDown(void)
+{
+	unsigned int i;
+
+	if (topology) {
+		no_os_free(topology->dev_top->active_links);
+		no_os_free(topology->devs);
+		jesd204_topology_remove(topology);
+	}
+
+	for (i = 0; i < nb_devs; i++)
+		jesd204_dev_unregister(test_devs[i].jdev);
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static struct no_os_time fake_get_time(int cmock_num_calls)
+{
+	struct no_os_time t;
+
+	t.s = fake_us / 1000000;
+	t.us = fake_us % 1000000;
+
+	return t;
+}
+
+static void fake_mdelay(uint32_t msecs, int cmock_num_calls)
+{
+	fake_us += msecs * 1000;
+	nb_delays++;
+}
+
+static uint32_t fake_spi_count(int cmock_num_calls)
+{
+	return fake_spi;
+}
+
+static int test_op(struct jesd204_dev *jdev, enum jesd204_dev_op op,
+		   enum jesd204_state_op_reason reason, struct jesd204_link *lnk)
+{
+	struct test_dev *dev = *(struct test_dev **)jesd204_dev_priv(jdev);
+
+	TEST_ASSERT_TRUE(nb_calls < MAX_CALLS);
+	calls[nb_calls].dev = dev->idx;
+	calls[nb_calls].op = op;
+	calls[nb_calls].link_id = lnk ? (int)lnk->link_id : -1;
+	calls[nb_calls].reason = reason;
+	nb_calls++;
+
+	fake_us += dev->us_per_call;
+	fake_spi += dev->spi_per_call;
+
+	if (reason != JESD204_STATE_OP_REASON_INIT)
+		return JESD204_STATE_CHANGE_DONE;
+
+	if (dev->defers[op]) {
+		dev->defers[op]--;
+		return JESD204_STATE_CHANGE_DEFER;
+	}
+
+	if (dev->ret[op])
+		return dev->ret[op];
+
+	return JESD204_STATE_CHANGE_DONE;
+}
+
+#define TEST_DEV_OP(name, op)						\
+static int name(struct jesd204_dev *jdev,				\
+		enum jesd204_state_op_reason reason)			\
+{									\
+	return test_op(jdev, op, reason, NULL);				\
+}
+
+#define TEST_LINK_OP(name, op)						\
+static int name(struct jesd204_dev *jdev,				\
+		enum jesd204_state_op_reason reason,			\
+		struct jesd204_link *lnk)				\
+{									\
+	return test_op(jdev, op, reason, lnk);				\
+}
+
+TEST_DEV_OP(link_init_dev, JESD204_OP_LINK_INIT)
+TEST_DEV_OP(clk_sync_dev, JESD204_OP_CLK_SYNC_STAGE1)
+TEST_DEV_OP(link_running_dev, JESD204_OP_LINK_RUNNING)
+TEST_LINK_OP(link_init_link, JESD204_OP_LINK_INIT)
+TEST_LINK_OP(link_setup_link, JESD204_OP_LINK_SETUP)
+TEST_LINK_OP(link_running_link, JESD204_OP_LINK_RUNNING)
+
+/* The top device and the converters have per_link ops, the clock chip has
+ * per_device ones. */
+static const struct jesd204_dev_data link_dev_data = {
+	.sizeof_priv = sizeof(struct test_dev *),
+	.state_ops = {
+		[JESD204_OP_LINK_INIT] = {
+			.per_link = link_init_link,
+		},
+		[JESD204_OP_LINK_SETUP] = {
+			.per_link = link_setup_link,
+		},
+		[JESD204_OP_LINK_RUNNING] = {
+			.per_link = link_running_link,
+		},
+	},
+};
+
+static const struct jesd204_dev_data clk_dev_data = {
+	.sizeof_priv = sizeof(struct test_dev *),
+	.state_ops = {
+		[JESD204_OP_LINK_INIT] = {
+			.per_device = link_init_dev,
+		},
+		[JESD204_OP_CLK_SYNC_STAGE1] = {
+			.per_device = clk_sync_dev,
+		},
+		[JESD204_OP_LINK_RUNNING] = {
+			.per_device = link_running_dev,
+		},
+	},
+};
+
+static struct test_dev *add_dev(const struct jesd204_dev_data *data,
+				bool is_top, const unsigned int *link_ids,
+				unsigned int nb_links)
+{
+	struct test_dev *dev = &test_devs[nb_devs];
+	struct jesd204_topology_dev *tdev = &topo_devs[nb_devs];
+	unsigned int i;
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_dev_register(&dev->jdev, data));
+	*(struct test_dev **)jesd204_dev_priv(dev->jdev) = dev;
+	dev->idx = nb_devs;
+
+	tdev->jdev = dev->jdev;
+	tdev->is_top_device = is_top;
+	tdev->links_number = nb_links;
+	for (i = 0; i < nb_links; i++)
+		tdev->link_ids[i] = link_ids[i];
+
+	nb_devs++;
+
+	return dev;
+}
+
+/*
+ * dev 0: clock chip on both links, dev 1: converter on link 0,
+ * dev 2: converter on link 1, dev 3: top device with links 0 and 1.
+ */
+static void make_topology(void)
+{
+	static const unsigned int both[] = {0, 1};
+	static const unsigned int link0[] = {0};
+	static const unsigned int link1[] = {1};
+
+	add_dev(&clk_dev_data, false, both, 2);
+	add_dev(&link_dev_data, false, link0, 1);
+	add_dev(&link_dev_data, false, link1, 1);
+	add_dev(&link_dev_data, true, both, 2);
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_topology_init(&topology, topo_devs,
+			      nb_devs));
+}
+
+static void stub_platform(void)
+{
+	no_os_get_time_StubWithCallback(fake_get_time);
+	no_os_mdelay_StubWithCallback(fake_mdelay);
+	no_os_spi_get_xfer_count_StubWithCallback(fake_spi_count);
+}
+
+static unsigned int count_calls(unsigned int dev, enum jesd204_dev_op op,
+				int link_id)
+{
+	unsigned int i, n = 0;
+
+	for (i = 0; i < nb_calls; i++)
+		if (calls[i].dev == dev && calls[i].op == op &&
+		    calls[i].link_id == link_id)
+			n++;
+
+	return n;
+}
+
+static void assert_call(unsigned int i, unsigned int dev,
+			enum jesd204_dev_op op, int link_id)
+{
+	TEST_ASSERT_TRUE(i < nb_calls);
+	TEST_ASSERT_EQUAL_UINT32(dev, calls[i].dev);
+	TEST_ASSERT_EQUAL_INT(op, calls[i].op);
+	TEST_ASSERT_EQUAL_INT(link_id, calls[i].link_id);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_jesd204_fsm_start_order(void)
+{
+	make_topology();
+	stub_platform();
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start(topology, JESD204_LINKS_ALL));
+
+	/* Per op: for each link the devices on it, then the top device. */
+	assert_call(0, 0, JESD204_OP_LINK_INIT, -1);
+	assert_call(1, 1, JESD204_OP_LINK_INIT, 0);
+	assert_call(2, 3, JESD204_OP_LINK_INIT, 0);
+	assert_call(3, 2, JESD204_OP_LINK_INIT, 1);
+	assert_call(4, 3, JESD204_OP_LINK_INIT, 1);
+	assert_call(5, 0, JESD204_OP_CLK_SYNC_STAGE1, -1);
+	assert_call(6, 1, JESD204_OP_LINK_SETUP, 0);
+	assert_call(7, 3, JESD204_OP_LINK_SETUP, 0);
+	assert_call(8, 2, JESD204_OP_LINK_SETUP, 1);
+	assert_call(9, 3, JESD204_OP_LINK_SETUP, 1);
+	assert_call(10, 0, JESD204_OP_LINK_RUNNING, -1);
+	TEST_ASSERT_EQUAL_UINT32(15, nb_calls);
+	TEST_ASSERT_EQUAL_UINT32(0, nb_delays);
+}
+
+void test_jesd204_fsm_error_stops_and_resumes(void)
+{
+	struct test_dev *clk;
+
+	make_topology();
+	stub_platform();
+	clk = &test_devs[0];
+	clk->ret[JESD204_OP_CLK_SYNC_STAGE1] = -EIO;
+
+	TEST_ASSERT_EQUAL_INT(-EIO, jesd204_fsm_start(topology,
+			      JESD204_LINKS_ALL));
+	/* Nothing past the failed state was called. */
+	TEST_ASSERT_EQUAL_UINT32(6, nb_calls);
+	TEST_ASSERT_EQUAL_UINT32(0, count_calls(1, JESD204_OP_LINK_SETUP, 0));
+
+	/* Resume from the failed state, the earlier ones are not run again. */
+	clk->ret[JESD204_OP_CLK_SYNC_STAGE1] = 0;
+	nb_calls = 0;
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_resume(topology, JESD204_LINKS_ALL));
+	assert_call(0, 0, JESD204_OP_CLK_SYNC_STAGE1, -1);
+	TEST_ASSERT_EQUAL_UINT32(0, count_calls(1, JESD204_OP_LINK_INIT, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, count_calls(1, JESD204_OP_LINK_RUNNING, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, count_calls(2, JESD204_OP_LINK_RUNNING, 1));
+
+	/* Everything is done, resuming again does nothing. */
+	nb_calls = 0;
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_resume(topology, JESD204_LINKS_ALL));
+	TEST_ASSERT_EQUAL_UINT32(0, nb_calls);
+}
+
+void test_jesd204_fsm_link_error(void)
+{
+	make_topology();
+	stub_platform();
+	test_devs[2].ret[JESD204_OP_LINK_SETUP] = -ETIMEDOUT;
+
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT, jesd204_fsm_start(topology,
+			      JESD204_LINKS_ALL));
+	TEST_ASSERT_EQUAL_INT(0, topology->dev_top->active_links[0].link.error);
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT,
+			      topology->dev_top->active_links[1].link.error);
+	/* The top device op of the failed link was not called. */
+	TEST_ASSERT_EQUAL_UINT32(1, count_calls(3, JESD204_OP_LINK_SETUP, 0));
+	TEST_ASSERT_EQUAL_UINT32(0, count_calls(3, JESD204_OP_LINK_SETUP, 1));
+}
+
+void test_jesd204_fsm_defer(void)
+{
+	struct jesd204_fsm_op_stats stats;
+
+	make_topology();
+	stub_platform();
+	test_devs[1].defers[JESD204_OP_LINK_SETUP] = 2;
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start(topology, JESD204_LINKS_ALL));
+
+	/* Only the deferred op is called again, once per pass. */
+	TEST_ASSERT_EQUAL_UINT32(3, count_calls(1, JESD204_OP_LINK_SETUP, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, count_calls(2, JESD204_OP_LINK_SETUP, 1));
+	TEST_ASSERT_EQUAL_UINT32(1, count_calls(3, JESD204_OP_LINK_SETUP, 0));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_delays);
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_get_op_stats(test_devs[1].jdev,
+			      JESD204_OP_LINK_SETUP, &stats));
+	TEST_ASSERT_EQUAL_UINT32(3, stats.calls);
+	TEST_ASSERT_EQUAL_UINT32(2, stats.defers);
+	TEST_ASSERT_EQUAL_UINT32(3, topology->op_stats[JESD204_OP_LINK_SETUP].calls);
+	TEST_ASSERT_EQUAL_UINT32(2,
+				 topology->op_stats[JESD204_OP_LINK_SETUP].defers);
+}
+
+void test_jesd204_fsm_defer_timeout(void)
+{
+	make_topology();
+	stub_platform();
+	test_devs[0].defers[JESD204_OP_CLK_SYNC_STAGE1] = UINT32_MAX;
+
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT, jesd204_fsm_start(topology,
+			      JESD204_LINKS_ALL));
+	TEST_ASSERT_EQUAL_UINT32(JESD204_FSM_DEFER_RETRIES, nb_delays);
+	TEST_ASSERT_EQUAL_UINT32(JESD204_FSM_DEFER_RETRIES + 1,
+				 count_calls(0, JESD204_OP_CLK_SYNC_STAGE1, -1));
+	TEST_ASSERT_EQUAL_UINT32(0, count_calls(1, JESD204_OP_LINK_SETUP, 0));
+}
+
+void test_jesd204_fsm_start_one_link_from_state(void)
+{
+	make_topology();
+	stub_platform();
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start(topology, JESD204_LINKS_ALL));
+
+	nb_calls = 0;
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start_from(topology, 1,
+			      JESD204_OP_LINK_SETUP));
+	assert_call(0, 2, JESD204_OP_LINK_SETUP, 1);
+	assert_call(1, 3, JESD204_OP_LINK_SETUP, 1);
+	assert_call(2, 0, JESD204_OP_LINK_RUNNING, -1);
+	assert_call(3, 2, JESD204_OP_LINK_RUNNING, 1);
+	assert_call(4, 3, JESD204_OP_LINK_RUNNING, 1);
+	TEST_ASSERT_EQUAL_UINT32(5, nb_calls);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, jesd204_fsm_start(topology, 2));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, jesd204_fsm_start_from(topology, 0,
+			      __JESD204_MAX_OPS));
+}
+
+void test_jesd204_fsm_stats(void)
+{
+	struct jesd204_fsm_op_stats stats;
+
+	make_topology();
+	stub_platform();
+	test_devs[0].us_per_call = 250;
+	test_devs[0].spi_per_call = 4;
+	test_devs[1].us_per_call = 10;
+	test_devs[1].spi_per_call = 1;
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start(topology, JESD204_LINKS_ALL));
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_get_op_stats(test_devs[0].jdev,
+			      JESD204_OP_CLK_SYNC_STAGE1, &stats));
+	TEST_ASSERT_EQUAL_UINT32(250, stats.time_us);
+	TEST_ASSERT_EQUAL_UINT32(4, stats.spi_xfers);
+	TEST_ASSERT_EQUAL_UINT32(1, stats.calls);
+
+	/* The per state totals include all the devices. */
+	stats = topology->op_stats[JESD204_OP_LINK_INIT];
+	TEST_ASSERT_EQUAL_UINT32(260, stats.time_us);
+	TEST_ASSERT_EQUAL_UINT32(5, stats.spi_xfers);
+	TEST_ASSERT_EQUAL_UINT32(1, stats.calls);
+	TEST_ASSERT_EQUAL_UINT32(0, topology->op_stats[JESD204_OP_DEVICE_INIT].time_us);
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, jesd204_fsm_get_op_stats(test_devs[0].jdev,
+			      __JESD204_MAX_OPS, &stats));
+}
+
+void test_jesd204_fsm_stop(void)
+{
+	make_topology();
+	stub_platform();
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start(topology, JESD204_LINKS_ALL));
+
+	nb_calls = 0;
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_stop(topology, JESD204_LINKS_ALL));
+	/* Reverse order: last link first, top device first. */
+	assert_call(0, 3, JESD204_OP_LINK_RUNNING, 1);
+	assert_call(1, 2, JESD204_OP_LINK_RUNNING, 1);
+	assert_call(2, 0, JESD204_OP_LINK_RUNNING, -1);
+	assert_call(3, 3, JESD204_OP_LINK_RUNNING, 0);
+	assert_call(4, 1, JESD204_OP_LINK_RUNNING, 0);
+	TEST_ASSERT_EQUAL_UINT32(15, nb_calls);
+	TEST_ASSERT_EQUAL_INT(JESD204_STATE_OP_REASON_UNINIT, calls[0].reason);
+}
+
+void test_jesd204_fsm_many_devices(void)
+{
+	static const unsigned int link0[] = {0};
+	unsigned int i;
+
+	/* More devices than the previous 16 entries bookkeeping array. */
+	for (i = 0; i < MAX_DEVS - 1; i++)
+		add_dev(&clk_dev_data, false, link0, 1);
+	add_dev(&link_dev_data, true, link0, 1);
+	TEST_ASSERT_EQUAL_INT(0, jesd204_topology_init(&topology, topo_devs,
+			      nb_devs));
+	stub_platform();
+
+	TEST_ASSERT_EQUAL_INT(0, jesd204_fsm_start(topology, JESD204_LINKS_ALL));
+	for (i = 0; i < MAX_DEVS - 1; i++)
+		TEST_ASSERT_EQUAL_UINT32(1, count_calls(i, JESD204_OP_CLK_SYNC_STAGE1,
+							-1));
+}
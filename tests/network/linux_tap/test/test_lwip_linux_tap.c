@@ -0,0 +1,404 @@
+/***************************************************************************//**
+ *   @file   test_lwip_linux_tap.c
+ *   @brief  Frames passed through a TAP interface by lwip_linux_tap.c, with
+ *           the pbufs of lwIP replaced by a small pool.
+ *******************************************************************************
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include <errno.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "lwip_linux_tap.c"
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TAP_NAME	"notap0"
+/* Local experimental ethertype, the kernel doesn't use it */
+#define TEST_ETH_TYPE	0x88B5
+#define TEST_FRAME_LEN	1000
+#define ETH_HDR_LEN	14
+#define WAIT_MS		1000
+
+/* Small pbufs, so the frames are chained as in the lwIP pool */
+#define PBUF_POOL_LEN	64
+#define PBUF_SEG_LEN	128
+
+static struct pbuf pbufs[PBUF_POOL_LEN];
+static uint8_t pbuf_mem[PBUF_POOL_LEN][PBUF_SEG_LEN];
+static bool pbuf_used[PBUF_POOL_LEN];
+static uint32_t nb_pbufs_used;
+static bool pbuf_alloc_fails;
+
+static struct netif netif;
+static struct lwip_network_desc lwip_desc;
+static int pkt_fd = -1;
+
+static uint8_t rx_frame[LINUX_TAP_FRAME_LEN];
+static uint16_t rx_len;
+
+/*******************************************************************************
+ *    LWIP TEST DOUBLES
+ ******************************************************************************/
+
+u32_t sys_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+struct pbuf *pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
+{
+	struct pbuf *p = NULL, **last = &p;
+	u16_t left = length;
+	uint32_t i;
+
+	if (pbuf_alloc_fails)
+		return NULL;
+
+	for (i = 0; i < PBUF_POOL_LEN && left; i++) {
+		if (pbuf_used[i])
+			continue;
+
+		pbuf_used[i] = true;
+		nb_pbufs_used++;
+		pbufs[i].next = NULL;
+		pbufs[i].payload = pbuf_mem[i];
+		pbufs[i].len = left < PBUF_SEG_LEN ? left : PBUF_SEG_LEN;
+		pbufs[i].tot_len = left;
+		left -= pbufs[i].len;
+		*last = &pbufs[i];
+		last = &pbufs[i].next;
+	}
+
+	if (left) {
+		pbuf_free(p);
+		return NULL;
+	}
+
+	return p;
+}
+
+u8_t pbuf_free(struct pbuf *p)
+{
+	u8_t nb = 0;
+
+	for (; p; p = p->next, nb++) {
+		pbuf_used[p - pbufs] = false;
+		nb_pbufs_used--;
+	}
+
+	return nb;
+}
+
+void pbuf_realloc(struct pbuf *p, u16_t size)
+{
+	u16_t left = size;
+
+	for (; left > p->len; p = p->next) {
+		p->tot_len = left;
+		left -= p->len;
+	}
+
+	p->len = left;
+	p->tot_len = left;
+	pbuf_free(p->next);
+	p->next = NULL;
+}
+
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len,
+			u16_t offset)
+{
+	u16_t copied = 0, n;
+
+	for (; p && copied < len; p = p->next) {
+		if (offset >= p->len) {
+			offset -= p->len;
+			continue;
+		}
+
+		n = p->len - offset;
+		if (n > len - copied)
+			n = len - copied;
+		memcpy((uint8_t *)dataptr + copied, (uint8_t *)p->payload + offset,
+		       n);
+		copied += n;
+		offset = 0;
+	}
+
+	return copied;
+}
+
+/* Keep the test frames only, the kernel sends its own on a new interface */
+static err_t test_netif_input(struct pbuf *p, struct netif *inp)
+{
+	uint8_t type[2];
+
+	pbuf_copy_partial(p, type, sizeof(type), 12);
+	if ((type[0] << 8 | type[1]) == TEST_ETH_TYPE)
+		rx_len = pbuf_copy_partial(p, rx_frame, sizeof(rx_frame), 0);
+	pbuf_free(p);
+
+	return ERR_OK;
+}
+
+/*******************************************************************************
+ *    HELPER FUNCTIONS
+ ******************************************************************************/
+
+static void fill_frame(uint8_t *frame, uint16_t len, uint8_t seed)
+{
+	uint16_t i;
+
+	memset(frame, 0xFF, 6);
+	memcpy(frame + 6, (uint8_t[]) {
+		0x02, 0x00, 0x00, 0x00, 0x00, 0x01
+	}, 6);
+	frame[12] = TEST_ETH_TYPE >> 8;
+	frame[13] = TEST_ETH_TYPE & 0xFF;
+	for (i = ETH_HDR_LEN; i < len; i++)
+		frame[i] = seed + i;
+}
+
+static struct pbuf *frame_to_pbuf(const uint8_t *frame, uint16_t len)
+{
+	struct pbuf *p, *q;
+	uint16_t off = 0;
+
+	p = pbuf_alloc(PBUF_RAW, len, PBUF_POOL);
+	TEST_ASSERT_NOT_NULL(p);
+	for (q = p; q; q = q->next) {
+		memcpy(q->payload, frame + off, q->len);
+		off += q->len;
+	}
+
+	return p;
+}
+
+/* Wait for a frame sent by the netdev on the packet socket */
+static ssize_t recv_frame(uint8_t *frame, size_t size)
+{
+	struct pollfd pfd = {
+		.fd = pkt_fd,
+		.events = POLLIN,
+	};
+
+	if (poll(&pfd, 1, WAIT_MS) <= 0)
+		return -ETIMEDOUT;
+
+	return recv(pkt_fd, frame, size, 0);
+}
+
+/* Step the netdev until it passes a test frame to lwIP */
+static int32_t step_until_rx(void)
+{
+	uint32_t start = sys_now();
+	int32_t ret;
+
+	while (!rx_len && sys_now() - start < WAIT_MS) {
+		ret = linux_tap_lwip_ops.step(&lwip_desc, NULL);
+		if (ret)
+			return ret;
+		usleep(1000);
+	}
+
+	return rx_len ? 0 : -ETIMEDOUT;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct linux_tap_lwip_param param = {
+		.ifname = TAP_NAME,
+	};
+	struct sockaddr_ll addr = {
+		.sll_family = AF_PACKET,
+		.sll_protocol = htons(TEST_ETH_TYPE),
+	};
+	struct ifreq ifr = {0};
+	int fd;
+
+	memset(pbuf_used, 0, sizeof(pbuf_used));
+	nb_pbufs_used = 0;
+	pbuf_alloc_fails = false;
+	rx_len = 0;
+
+	/* Creating a TAP interface needs /dev/net/tun and CAP_NET_ADMIN */
+	if (linux_tap_lwip_ops.init(&lwip_desc.mac_desc, &param))
+		TEST_IGNORE_MESSAGE("Unable to create " TAP_NAME);
+
+	netif.input = test_netif_input;
+	netif.state = &lwip_desc;
+	lwip_desc.lwip_netif = &netif;
+
+	fd = socket(AF_INET, SOCK_DGRAM, 0);
+	TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+	strncpy(ifr.ifr_name, TAP_NAME, IFNAMSIZ - 1);
+	TEST_ASSERT_EQUAL_INT(0, ioctl(fd, SIOCGIFFLAGS, &ifr));
+	ifr.ifr_flags |= IFF_UP;
+	TEST_ASSERT_EQUAL_INT(0, ioctl(fd, SIOCSIFFLAGS, &ifr));
+	close(fd);
+
+	pkt_fd = socket(AF_PACKET, SOCK_RAW, htons(TEST_ETH_TYPE));
+	TEST_ASSERT_GREATER_OR_EQUAL(0, pkt_fd);
+	addr.sll_ifindex = if_nametoindex(TAP_NAME);
+	TEST_ASSERT_EQUAL_INT(0, bind(pkt_fd, (struct sockaddr *)&addr,
+				      sizeof(addr)));
+}
+
+void tearDown(void)
+{
+	if (pkt_fd >= 0)
+		close(pkt_fd);
+	pkt_fd = -1;
+
+	if (lwip_desc.mac_desc)
+		linux_tap_lwip_ops.remove(lwip_desc.mac_desc);
+	lwip_desc.mac_desc = NULL;
+}
+
+/*******************************************************************************
+ *    TEST FUNCTIONS
+ ******************************************************************************/
+
+/* A pbuf chain is written as one frame */
+void test_linux_tap_tx(void)
+{
+	uint8_t frame[TEST_FRAME_LEN], got[LINUX_TAP_FRAME_LEN];
+	struct linux_tap_stats stats;
+	struct pbuf *p;
+
+	fill_frame(frame, sizeof(frame), 1);
+	p = frame_to_pbuf(frame, sizeof(frame));
+	TEST_ASSERT_NOT_NULL(p->next);
+
+	TEST_ASSERT_EQUAL_INT(0, linux_tap_lwip_ops.netif_output(&netif, p));
+	pbuf_free(p);
+
+	TEST_ASSERT_EQUAL_INT(sizeof(frame), recv_frame(got, sizeof(got)));
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(frame, got, sizeof(frame));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_tap_lwip_get_stats(lwip_desc.mac_desc,
+			      &stats));
+	TEST_ASSERT_EQUAL_UINT32(1, stats.tx_frames);
+	TEST_ASSERT_EQUAL_UINT32(sizeof(frame), stats.tx_bytes);
+	TEST_ASSERT_EQUAL_UINT32(0, stats.tx_errors);
+}
+
+/* A chain longer than LINUX_TAP_MAX_IOV is copied before being written */
+void test_linux_tap_tx_long_chain(void)
+{
+	uint8_t frame[LINUX_TAP_MAX_IOV * 2 * 16], got[LINUX_TAP_FRAME_LEN];
+	struct pbuf chain[LINUX_TAP_MAX_IOV * 2];
+	uint32_t i;
+
+	fill_frame(frame, sizeof(frame), 2);
+	for (i = 0; i < NO_OS_ARRAY_SIZE(chain); i++) {
+		chain[i].payload = frame + i * 16;
+		chain[i].len = 16;
+		chain[i].tot_len = sizeof(frame) - i * 16;
+		chain[i].next = i + 1 < NO_OS_ARRAY_SIZE(chain) ?
+				&chain[i + 1] : NULL;
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, linux_tap_lwip_ops.netif_output(&netif,
+			      chain));
+
+	TEST_ASSERT_EQUAL_INT(sizeof(frame), recv_frame(got, sizeof(got)));
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(frame, got, sizeof(frame));
+}
+
+/* A frame sent on the interface is read in a pbuf chain and passed to lwIP */
+void test_linux_tap_rx(void)
+{
+	uint8_t frame[TEST_FRAME_LEN];
+	struct linux_tap_stats stats;
+
+	fill_frame(frame, sizeof(frame), 3);
+	TEST_ASSERT_EQUAL_INT(sizeof(frame), send(pkt_fd, frame, sizeof(frame),
+			      0));
+
+	TEST_ASSERT_EQUAL_INT(0, step_until_rx());
+	TEST_ASSERT_EQUAL_UINT16(sizeof(frame), rx_len);
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(frame, rx_frame, sizeof(frame));
+
+	/* The pbufs not used by the frame were released by pbuf_realloc() */
+	TEST_ASSERT_EQUAL_UINT32(0, nb_pbufs_used);
+
+	TEST_ASSERT_EQUAL_INT(0, linux_tap_lwip_get_stats(lwip_desc.mac_desc,
+			      &stats));
+	TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, stats.rx_frames);
+	TEST_ASSERT_GREATER_OR_EQUAL_UINT32(sizeof(frame), stats.rx_bytes);
+	TEST_ASSERT_EQUAL_UINT32(0, stats.rx_dropped);
+}
+
+/* A frame stays queued on the interface while there are no pbufs */
+void test_linux_tap_rx_no_pbuf(void)
+{
+	uint8_t frame[TEST_FRAME_LEN];
+	struct linux_tap_stats stats;
+
+	fill_frame(frame, sizeof(frame), 4);
+	TEST_ASSERT_EQUAL_INT(sizeof(frame), send(pkt_fd, frame, sizeof(frame),
+			      0));
+
+	pbuf_alloc_fails = true;
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT, step_until_rx());
+	TEST_ASSERT_EQUAL_INT(0, linux_tap_lwip_get_stats(lwip_desc.mac_desc,
+			      &stats));
+	TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, stats.rx_no_pbuf);
+
+	pbuf_alloc_fails = false;
+	TEST_ASSERT_EQUAL_INT(0, step_until_rx());
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(frame, rx_frame, sizeof(frame));
+	TEST_ASSERT_EQUAL_UINT32(0, nb_pbufs_used);
+}
@@ -0,0 +1,760 @@
+/***************************************************************************//**
+ *   @file   axi_io_model.c
+ *   @brief  Software model of the AXI DMAC, ADC and DAC cores.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "no_os_axi_io.h"
+#include "axi_io_model.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define MODEL_NB_REGS			1024
+#define MODEL_IRQ_PERIOD_NS		50000
+/* Longest interval for which data is moved at once */
+#define MODEL_MAX_INTERVAL_NS		1000000000ULL
+
+/* DMAC registers */
+#define MODEL_DMAC_VERSION		0x00040300
+#define MODEL_DMAC_QUEUE_MAX		4
+#define MODEL_DMAC_REG_VERSION		0x000
+#define MODEL_DMAC_REG_IRQ_MASK		0x080
+#define MODEL_DMAC_REG_IRQ_PENDING	0x084
+#define MODEL_DMAC_REG_IRQ_SOURCE	0x088
+#define MODEL_DMAC_IRQ_SOT		NO_OS_BIT(0)
+#define MODEL_DMAC_IRQ_EOT		NO_OS_BIT(1)
+#define MODEL_DMAC_REG_CTRL		0x400
+#define MODEL_DMAC_CTRL_ENABLE		NO_OS_BIT(0)
+#define MODEL_DMAC_REG_TRANSFER_ID	0x404
+#define MODEL_DMAC_REG_TRANSFER_SUBMIT	0x408
+#define MODEL_DMAC_REG_FLAGS		0x40c
+#define MODEL_DMAC_FLAG_CYCLIC		NO_OS_BIT(0)
+#define MODEL_DMAC_FLAG_LAST		NO_OS_BIT(1)
+#define MODEL_DMAC_REG_DEST_ADDRESS	0x410
+#define MODEL_DMAC_REG_SRC_ADDRESS	0x414
+#define MODEL_DMAC_REG_X_LENGTH		0x418
+#define MODEL_DMAC_REG_Y_LENGTH		0x41c
+#define MODEL_DMAC_REG_DEST_STRIDE	0x420
+#define MODEL_DMAC_REG_SRC_STRIDE	0x424
+#define MODEL_DMAC_REG_TRANSFER_DONE	0x428
+
+/* ADC and DAC common registers */
+#define MODEL_CORE_REG_RSTN		0x040
+#define MODEL_CORE_RSTN			NO_OS_BIT(0)
+#define MODEL_CORE_REG_CLK_FREQ		0x054
+#define MODEL_CORE_REG_CLK_RATIO	0x058
+#define MODEL_CORE_REG_STATUS		0x05c
+#define MODEL_ADC_REG_CHAN_CNTRL(c)	(0x0400 + (c) * 0x40)
+#define MODEL_ADC_ENABLE		NO_OS_BIT(0)
+#define MODEL_DAC_REG_DATA_SELECT(c)	(0x0418 + (c) * 0x40)
+#define MODEL_DAC_DATA_SEL_DMA		2
+/* Converters are modeled with 16 bit samples */
+#define MODEL_SAMPLE_BYTES		2
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/* Transfer accepted by a modeled DMAC */
+struct model_xfer {
+	uint32_t id;
+	/* Address of the memory side. Destination for memory to memory */
+	uint32_t addr;
+	uint32_t stride;
+	/* Source for memory to memory */
+	uint32_t src_addr;
+	uint32_t src_stride;
+	uint32_t x_length;
+	uint32_t y_length;
+	bool cyclic;
+	/* Progress */
+	uint32_t row;
+	uint32_t col;
+	bool error;
+};
+
+struct model_core {
+	struct axi_io_model_init_param param;
+	uint32_t regs[MODEL_NB_REGS];
+	struct model_core *next;
+
+	/* DMAC only */
+	struct model_core *conv;
+	/* Transfers being processed, the first one is active */
+	struct model_xfer queue[MODEL_DMAC_QUEUE_MAX];
+	uint32_t q_first;
+	uint32_t q_len;
+	/* Transfer submitted but not yet accepted */
+	struct model_xfer slot;
+	bool slot_full;
+	uint32_t next_id;
+	uint32_t done;
+	uint32_t pending;
+	uint64_t last_ns;
+	uint64_t frac;
+	/* Bytes produced by the ADC since the DMAC was enabled */
+	uint64_t stream_pos;
+	bool streaming;
+	bool dropping;
+	struct axi_io_model_stats stats;
+};
+
+struct model_map {
+	uint8_t *buf;
+	uint32_t size;
+	struct model_map *next;
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+static pthread_mutex_t model_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct model_core *model_cores;
+static struct model_map *model_maps;
+static pthread_t model_irq_thread;
+static bool model_irq_thread_run;
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+static uint64_t model_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static struct model_core *model_find(uint32_t base)
+{
+	struct model_core *core;
+
+	for (core = model_cores; core; core = core->next)
+		if (core->param.base == base)
+			return core;
+
+	return NULL;
+}
+
+static uint32_t *model_reg(struct model_core *core, uint32_t offset)
+{
+	return &core->regs[(offset / 4) % MODEL_NB_REGS];
+}
+
+/* Get the host address of a region of DMA memory. NULL if not mapped */
+static uint8_t *model_dma_addr(uint32_t addr, uint32_t len)
+{
+	struct model_map *map;
+	uint32_t start;
+
+	for (map = model_maps; map; map = map->next) {
+		start = (uint32_t)(uintptr_t)map->buf;
+		if (addr - start < map->size && len <= map->size - (addr - start))
+			return map->buf + (addr - start);
+	}
+
+	return NULL;
+}
+
+/*
+ * Get the converter of a DMAC. The converter can be added after the DMAC.
+ * A DMAC without converter is memory to memory.
+ */
+static struct model_core *model_dmac_conv(struct model_core *dmac)
+{
+	struct model_core *conv;
+
+	if (!dmac->conv) {
+		conv = model_find(dmac->param.core_base);
+		if (conv && conv->param.type != AXI_IO_MODEL_DMAC)
+			dmac->conv = conv;
+	}
+
+	return dmac->conv;
+}
+
+/* Number of bytes per second streamed by a converter. 0 if it is stopped */
+static uint64_t model_conv_rate(struct model_core *conv)
+{
+	uint32_t i, nb_en = 0;
+
+	if (!(*model_reg(conv, MODEL_CORE_REG_RSTN) & MODEL_CORE_RSTN))
+		return 0;
+
+	for (i = 0; i < conv->param.num_channels; i++) {
+		if (conv->param.type == AXI_IO_MODEL_ADC) {
+			if (*model_reg(conv, MODEL_ADC_REG_CHAN_CNTRL(i)) &
+			    MODEL_ADC_ENABLE)
+				nb_en++;
+		} else if ((*model_reg(conv, MODEL_DAC_REG_DATA_SELECT(i)) & 0xF) ==
+			   MODEL_DAC_DATA_SEL_DMA) {
+			nb_en++;
+		}
+	}
+	/* The DAC reads all the channels if none is selected explicitly */
+	if (!nb_en && conv->param.type == AXI_IO_MODEL_DAC)
+		nb_en = conv->param.num_channels;
+
+	return conv->param.sample_rate_hz * nb_en * MODEL_SAMPLE_BYTES;
+}
+
+/*
+ * ADC samples are 16 bits ramps, the same on all enabled channels. A gap in
+ * the ramp shows dropped samples.
+ */
+static void model_adc_fill(struct model_core *dmac, uint8_t *buf, uint32_t len)
+{
+	uint32_t frame_bytes, frame, off, i;
+	uint64_t rate;
+
+	rate = model_conv_rate(dmac->conv);
+	frame_bytes = rate / dmac->conv->param.sample_rate_hz;
+	for (i = 0; i < len; i++, dmac->stream_pos++) {
+		frame = dmac->stream_pos / frame_bytes;
+		off = dmac->stream_pos % frame_bytes;
+		buf[i] = (off & 1) ? (frame >> 8) & 0xFF : frame & 0xFF;
+	}
+}
+
+/* Move len bytes of the active transfer between memory and converter */
+static void model_dmac_copy(struct model_core *dmac, struct model_xfer *x,
+			    uint32_t len)
+{
+	uint8_t *buf;
+	uint32_t i;
+
+	buf = model_dma_addr(x->addr + x->row * x->stride + x->col, len);
+	if (!buf) {
+		if (!x->error)
+			dmac->stats.dma_errors++;
+		x->error = true;
+		if (dmac->conv->param.type == AXI_IO_MODEL_ADC)
+			dmac->stream_pos += len;
+		return;
+	}
+
+	if (dmac->conv->param.type == AXI_IO_MODEL_ADC) {
+		model_adc_fill(dmac, buf, len);
+	} else {
+		for (i = 0; i < len; i++)
+			dmac->stats.dac_checksum += buf[i];
+	}
+}
+
+/* Move the submitted transfer in the queue if there is space */
+static void model_dmac_accept(struct model_core *dmac)
+{
+	uint32_t depth = dmac->param.queue_depth;
+
+	if (!dmac->slot_full || dmac->q_len == depth)
+		return;
+
+	dmac->queue[(dmac->q_first + dmac->q_len) % depth] = dmac->slot;
+	dmac->q_len++;
+	dmac->slot_full = false;
+	dmac->streaming = true;
+	dmac->pending |= MODEL_DMAC_IRQ_SOT;
+}
+
+/* Remove the active transfer and signal its completion */
+static void model_dmac_complete(struct model_core *dmac)
+{
+	struct model_xfer *x = &dmac->queue[dmac->q_first];
+
+	dmac->pending |= MODEL_DMAC_IRQ_EOT;
+	if (x->cyclic) {
+		/* Cyclic transfers restart until the DMAC is disabled */
+		x->row = 0;
+		return;
+	}
+
+	dmac->done |= NO_OS_BIT(x->id);
+	dmac->stats.transfers++;
+	dmac->q_first = (dmac->q_first + 1) % dmac->param.queue_depth;
+	dmac->q_len--;
+	model_dmac_accept(dmac);
+}
+
+/* Memory to memory transfers complete at once */
+static void model_dmac_mem_to_mem(struct model_core *dmac)
+{
+	struct model_xfer *x;
+	uint8_t *src, *dest;
+
+	while (dmac->q_len) {
+		x = &dmac->queue[dmac->q_first];
+		for (x->row = 0; x->row < x->y_length; x->row++) {
+			src = model_dma_addr(x->src_addr + x->row * x->src_stride,
+					     x->x_length);
+			dest = model_dma_addr(x->addr + x->row * x->stride,
+					      x->x_length);
+			if (!src || !dest) {
+				dmac->stats.dma_errors++;
+				break;
+			}
+			memmove(dest, src, x->x_length);
+			dmac->stats.bytes += x->x_length;
+		}
+		x->cyclic = false;
+		model_dmac_complete(dmac);
+	}
+}
+
+/* Move the data streamed since the last call. Called with model_lock held */
+static void model_dmac_advance(struct model_core *dmac)
+{
+	struct model_xfer *x;
+	uint64_t now, budget, rate, frame_ns;
+	uint32_t len;
+
+	now = model_now_ns();
+	budget = no_os_min(now - dmac->last_ns, MODEL_MAX_INTERVAL_NS);
+	dmac->last_ns = now;
+
+	if (!(*model_reg(dmac, MODEL_DMAC_REG_CTRL) & MODEL_DMAC_CTRL_ENABLE))
+		return;
+
+	if (!model_dmac_conv(dmac)) {
+		model_dmac_mem_to_mem(dmac);
+		return;
+	}
+
+	rate = model_conv_rate(dmac->conv);
+	if (!rate)
+		return;
+
+	/* Only whole frames are streamed (or dropped), like on hardware */
+	frame_ns = 1000000000ULL * (rate / dmac->conv->param.sample_rate_hz);
+	budget = budget * rate + dmac->frac;
+	dmac->frac = budget % frame_ns;
+	budget = budget / frame_ns * (rate / dmac->conv->param.sample_rate_hz);
+
+	while (budget) {
+		if (!dmac->q_len) {
+			/* Nothing to transfer, data is lost */
+			if (dmac->streaming) {
+				if (!dmac->dropping)
+					dmac->stats.dropped_bursts++;
+				dmac->dropping = true;
+				dmac->stats.dropped_bytes += budget;
+			}
+			if (dmac->conv->param.type == AXI_IO_MODEL_ADC)
+				dmac->stream_pos += budget;
+			return;
+		}
+		dmac->dropping = false;
+
+		x = &dmac->queue[dmac->q_first];
+		len = no_os_min(budget, x->x_length - x->col);
+		model_dmac_copy(dmac, x, len);
+		dmac->stats.bytes += len;
+		budget -= len;
+		x->col += len;
+		if (x->col == x->x_length) {
+			x->col = 0;
+			x->row++;
+			if (x->row == x->y_length)
+				model_dmac_complete(dmac);
+		}
+	}
+}
+
+/* Submit a transfer from the values of the registers */
+static void model_dmac_submit(struct model_core *dmac)
+{
+	struct model_xfer *x = &dmac->slot;
+	bool dev_to_mem;
+
+	if (dmac->slot_full ||
+	    !(*model_reg(dmac, MODEL_DMAC_REG_CTRL) & MODEL_DMAC_CTRL_ENABLE))
+		return;
+
+	memset(x, 0, sizeof(*x));
+	dev_to_mem = !model_dmac_conv(dmac) || dmac->conv->param.type == AXI_IO_MODEL_ADC;
+	if (dev_to_mem) {
+		x->addr = *model_reg(dmac, MODEL_DMAC_REG_DEST_ADDRESS);
+		x->stride = *model_reg(dmac, MODEL_DMAC_REG_DEST_STRIDE);
+	} else {
+		x->addr = *model_reg(dmac, MODEL_DMAC_REG_SRC_ADDRESS);
+		x->stride = *model_reg(dmac, MODEL_DMAC_REG_SRC_STRIDE);
+	}
+	if (!dmac->conv) {
+		x->src_addr = *model_reg(dmac, MODEL_DMAC_REG_SRC_ADDRESS);
+		x->src_stride = *model_reg(dmac, MODEL_DMAC_REG_SRC_STRIDE);
+	}
+	x->x_length = *model_reg(dmac, MODEL_DMAC_REG_X_LENGTH) + 1;
+	x->y_length = *model_reg(dmac, MODEL_DMAC_REG_Y_LENGTH) + 1;
+	x->cyclic = *model_reg(dmac, MODEL_DMAC_REG_FLAGS) & MODEL_DMAC_FLAG_CYCLIC;
+	x->id = dmac->next_id;
+
+	dmac->next_id = (dmac->next_id + 1) % MODEL_DMAC_QUEUE_MAX;
+	dmac->done &= ~NO_OS_BIT(x->id);
+	dmac->slot_full = true;
+	model_dmac_accept(dmac);
+}
+
+static uint32_t model_dmac_read(struct model_core *dmac, uint32_t offset)
+{
+	model_dmac_advance(dmac);
+
+	switch (offset) {
+	case MODEL_DMAC_REG_IRQ_PENDING:
+		return dmac->pending;
+	case MODEL_DMAC_REG_IRQ_SOURCE:
+		return dmac->pending & ~*model_reg(dmac, MODEL_DMAC_REG_IRQ_MASK);
+	case MODEL_DMAC_REG_TRANSFER_ID:
+		return dmac->next_id;
+	case MODEL_DMAC_REG_TRANSFER_SUBMIT:
+		return dmac->slot_full;
+	case MODEL_DMAC_REG_TRANSFER_DONE:
+		return dmac->done;
+	default:
+		return *model_reg(dmac, offset);
+	}
+}
+
+static void model_dmac_write(struct model_core *dmac, uint32_t offset,
+			     uint32_t data)
+{
+	bool dest_mapped, src_mapped;
+
+	model_dmac_advance(dmac);
+
+	dest_mapped = !model_dmac_conv(dmac) || dmac->conv->param.type == AXI_IO_MODEL_ADC;
+	src_mapped = !dmac->conv || dmac->conv->param.type == AXI_IO_MODEL_DAC;
+	switch (offset) {
+	case MODEL_DMAC_REG_VERSION:
+	case MODEL_DMAC_REG_IRQ_SOURCE:
+	case MODEL_DMAC_REG_TRANSFER_ID:
+	case MODEL_DMAC_REG_TRANSFER_DONE:
+		/* Read only */
+		return;
+	case MODEL_DMAC_REG_IRQ_PENDING:
+		dmac->pending &= ~data;
+		return;
+	case MODEL_DMAC_REG_CTRL:
+		if (!(data & MODEL_DMAC_CTRL_ENABLE)) {
+			/* Disabling the DMAC drops all transfers */
+			dmac->q_len = 0;
+			dmac->slot_full = false;
+			dmac->streaming = false;
+			dmac->dropping = false;
+		}
+		break;
+	case MODEL_DMAC_REG_TRANSFER_SUBMIT:
+		if (data & NO_OS_BIT(0))
+			model_dmac_submit(dmac);
+		return;
+	case MODEL_DMAC_REG_FLAGS:
+		data &= MODEL_DMAC_FLAG_LAST |
+			(dmac->param.hw_cyclic ? MODEL_DMAC_FLAG_CYCLIC : 0);
+		break;
+	case MODEL_DMAC_REG_DEST_ADDRESS:
+	case MODEL_DMAC_REG_DEST_STRIDE:
+		if (!dest_mapped ||
+		    (offset == MODEL_DMAC_REG_DEST_STRIDE && !dmac->param.hw_2d))
+			data = 0;
+		break;
+	case MODEL_DMAC_REG_SRC_ADDRESS:
+	case MODEL_DMAC_REG_SRC_STRIDE:
+		if (!src_mapped ||
+		    (offset == MODEL_DMAC_REG_SRC_STRIDE && !dmac->param.hw_2d))
+			data = 0;
+		break;
+	case MODEL_DMAC_REG_X_LENGTH:
+		data &= dmac->param.max_length;
+		break;
+	case MODEL_DMAC_REG_Y_LENGTH:
+		data = dmac->param.hw_2d ? data & dmac->param.max_length : 0;
+		break;
+	default:
+		break;
+	}
+
+	*model_reg(dmac, offset) = data;
+}
+
+static uint32_t model_conv_read(struct model_core *conv, uint32_t offset)
+{
+	switch (offset) {
+	case MODEL_CORE_REG_STATUS:
+		return !!(*model_reg(conv, MODEL_CORE_REG_RSTN) & MODEL_CORE_RSTN);
+	case MODEL_CORE_REG_CLK_FREQ:
+		/* clock_hz = freq * ratio * 390625 / 256 */
+		return (conv->param.sample_rate_hz << 8) / 390625;
+	case MODEL_CORE_REG_CLK_RATIO:
+		return 1;
+	default:
+		return *model_reg(conv, offset);
+	}
+}
+
+/* Move data and collect the pending interrupts of the DMACs with handlers */
+static void *model_irq_thread_fn(void *arg)
+{
+	struct timespec period = {
+		.tv_sec = 0,
+		.tv_nsec = MODEL_IRQ_PERIOD_NS
+	};
+	struct model_core *core, *irq_core;
+	uint32_t source;
+
+	while (true) {
+		do {
+			irq_core = NULL;
+			pthread_mutex_lock(&model_lock);
+			if (!model_irq_thread_run) {
+				pthread_mutex_unlock(&model_lock);
+				return NULL;
+			}
+			for (core = model_cores; core; core = core->next) {
+				if (core->param.type != AXI_IO_MODEL_DMAC ||
+				    !core->param.irq_handler)
+					continue;
+				model_dmac_advance(core);
+				source = core->pending &
+					 ~*model_reg(core, MODEL_DMAC_REG_IRQ_MASK);
+				if (source && !irq_core)
+					irq_core = core;
+			}
+			pthread_mutex_unlock(&model_lock);
+
+			/* The handler accesses the registers, call it unlocked */
+			if (irq_core)
+				irq_core->param.irq_handler(irq_core->param.irq_ctx);
+		} while (irq_core);
+
+		nanosleep(&period, NULL);
+	}
+}
+
+/**
+ * @brief Add a modeled core.
+ * @param param - Parameters of the core.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_io_model_add(const struct axi_io_model_init_param *param)
+{
+	struct model_core *core;
+	int32_t ret = 0;
+
+	if (!param)
+		return -EINVAL;
+
+	if (param->type != AXI_IO_MODEL_DMAC && !param->sample_rate_hz)
+		return -EINVAL;
+
+	core = no_os_calloc(1, sizeof(*core));
+	if (!core)
+		return -ENOMEM;
+
+	core->param = *param;
+	if (param->type == AXI_IO_MODEL_DMAC) {
+		if (!core->param.max_length)
+			core->param.max_length = 0xFFFFFF;
+		if (!core->param.queue_depth ||
+		    core->param.queue_depth > MODEL_DMAC_QUEUE_MAX)
+			core->param.queue_depth = MODEL_DMAC_QUEUE_MAX;
+		*model_reg(core, MODEL_DMAC_REG_VERSION) = MODEL_DMAC_VERSION;
+		*model_reg(core, MODEL_DMAC_REG_IRQ_MASK) = MODEL_DMAC_IRQ_SOT |
+				MODEL_DMAC_IRQ_EOT;
+	}
+
+	pthread_mutex_lock(&model_lock);
+	if (model_find(param->base)) {
+		ret = -EEXIST;
+		goto unlock;
+	}
+	if (param->type == AXI_IO_MODEL_DMAC) {
+		core->last_ns = model_now_ns();
+		if (param->irq_handler && !model_irq_thread_run) {
+			model_irq_thread_run = true;
+			ret = -pthread_create(&model_irq_thread, NULL,
+					      model_irq_thread_fn, NULL);
+			if (ret) {
+				model_irq_thread_run = false;
+				goto unlock;
+			}
+		}
+	}
+	core->next = model_cores;
+	model_cores = core;
+unlock:
+	pthread_mutex_unlock(&model_lock);
+	if (ret)
+		no_os_free(core);
+
+	return ret;
+}
+
+/**
+ * @brief Make a buffer accessible to the modeled DMACs. The DMA address of the
+ * buffer is (uint32_t)(uintptr_t)buf.
+ * @param buf - Buffer.
+ * @param size - Size of the buffer in bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_io_model_dma_map(void *buf, uint32_t size)
+{
+	struct model_map *map;
+
+	if (!buf || !size)
+		return -EINVAL;
+
+	map = no_os_calloc(1, sizeof(*map));
+	if (!map)
+		return -ENOMEM;
+
+	map->buf = buf;
+	map->size = size;
+	pthread_mutex_lock(&model_lock);
+	map->next = model_maps;
+	model_maps = map;
+	pthread_mutex_unlock(&model_lock);
+
+	return 0;
+}
+
+/**
+ * @brief Get the statistics of a modeled DMAC.
+ * @param base - Base of the DMAC.
+ * @param stats - Filled with the statistics.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t axi_io_model_get_stats(uint32_t base, struct axi_io_model_stats *stats)
+{
+	struct model_core *core;
+
+	if (!stats)
+		return -EINVAL;
+
+	pthread_mutex_lock(&model_lock);
+	core = model_find(base);
+	if (core && core->param.type == AXI_IO_MODEL_DMAC) {
+		model_dmac_advance(core);
+		*stats = core->stats;
+	}
+	pthread_mutex_unlock(&model_lock);
+
+	return (core && core->param.type == AXI_IO_MODEL_DMAC) ? 0 : -ENODEV;
+}
+
+/**
+ * @brief Remove all the modeled cores and mapped buffers.
+ */
+void axi_io_model_remove_all(void)
+{
+	struct model_core *core;
+	struct model_map *map;
+	bool join;
+
+	pthread_mutex_lock(&model_lock);
+	join = model_irq_thread_run;
+	model_irq_thread_run = false;
+	pthread_mutex_unlock(&model_lock);
+	if (join)
+		pthread_join(model_irq_thread, NULL);
+
+	pthread_mutex_lock(&model_lock);
+	while (model_cores) {
+		core = model_cores;
+		model_cores = core->next;
+		no_os_free(core);
+	}
+	while (model_maps) {
+		map = model_maps;
+		model_maps = map->next;
+		no_os_free(map);
+	}
+	pthread_mutex_unlock(&model_lock);
+}
+
+/**
+ * @brief AXI IO read function of the modeled cores.
+ * @param base - Base of the core.
+ * @param offset - Address offset.
+ * @param data - Location where read data will be stored.
+ * @return 0 in case of success, -ENODEV if no core is modeled at base.
+ */
+int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
+{
+	struct model_core *core;
+
+	pthread_mutex_lock(&model_lock);
+	core = model_find(base);
+	if (!core)
+		*data = 0;
+	else if (core->param.type == AXI_IO_MODEL_DMAC)
+		*data = model_dmac_read(core, offset);
+	else
+		*data = model_conv_read(core, offset);
+	pthread_mutex_unlock(&model_lock);
+
+	return core ? 0 : -ENODEV;
+}
+
+/**
+ * @brief AXI IO write function of the modeled cores.
+ * @param base - Base of the core.
+ * @param offset - Address offset.
+ * @param data - Data to be written.
+ * @return 0 in case of success, -ENODEV if no core is modeled at base.
+ */
+int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
+{
+	struct model_core *core;
+
+	pthread_mutex_lock(&model_lock);
+	core = model_find(base);
+	if (core && core->param.type == AXI_IO_MODEL_DMAC)
+		model_dmac_write(core, offset, data);
+	else if (core)
+		*model_reg(core, offset) = data;
+	pthread_mutex_unlock(&model_lock);
+
+	return core ? 0 : -ENODEV;
+}
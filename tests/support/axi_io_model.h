@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *   @file   axi_io_model.h
+ *   @brief  Software model of the AXI DMAC, ADC and DAC cores.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _AXI_IO_MODEL_H_
+#define _AXI_IO_MODEL_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/*
+ * axi_io_model.c implements no_os_axi_io_read/write for the unit tests, which
+ * link it instead of a platform axi_io implementation. Each core is found by
+ * the base used by its driver.
+ * Time advances with the host monotonic clock. Data is moved between the
+ * converter and the memory whenever a register of the DMAC is accessed or,
+ * when irq_handler is set, from a background thread which also calls the
+ * handler while an unmasked interrupt is pending.
+ * Since the DMAC registers are only 32 bits wide, the buffers used by the DMA
+ * must be registered with axi_io_model_dma_map().
+ */
+
+/**
+ * @enum axi_io_model_type
+ * @brief Modeled cores
+ */
+enum axi_io_model_type {
+	AXI_IO_MODEL_DMAC,
+	AXI_IO_MODEL_ADC,
+	AXI_IO_MODEL_DAC,
+};
+
+/**
+ * @struct axi_io_model_init_param
+ * @brief Parameters of a modeled core
+ */
+struct axi_io_model_init_param {
+	/** Type of the core */
+	enum axi_io_model_type type;
+	/** Base address (or UIO index) used by the driver */
+	uint32_t base;
+	/** DMAC only: base of the ADC (DEV_TO_MEM) or DAC (MEM_TO_DEV) core */
+	uint32_t core_base;
+	/** DMAC only: Value of X_LENGTH read after writing 0xFFFFFFFF */
+	uint32_t max_length;
+	/** DMAC only: Number of transfers accepted by the hardware queue */
+	uint32_t queue_depth;
+	/** DMAC only: Support 2D transfers */
+	bool hw_2d;
+	/** DMAC only: Support HW cyclic transfers (only MEM_TO_DEV) */
+	bool hw_cyclic;
+	/** DMAC only: Called with irq_ctx while an interrupt is pending */
+	void (*irq_handler)(void *irq_ctx);
+	void *irq_ctx;
+	/** ADC/DAC only: Number of channels */
+	uint32_t num_channels;
+	/** ADC/DAC only: Sample rate, in samples per second per channel */
+	uint64_t sample_rate_hz;
+};
+
+/**
+ * @struct axi_io_model_stats
+ * @brief Statistics of a modeled DMAC
+ */
+struct axi_io_model_stats {
+	/** Bytes transferred between the converter and the memory */
+	uint64_t bytes;
+	/** Bytes produced (ADC) or needed (DAC) while no transfer was active */
+	uint64_t dropped_bytes;
+	/** Number of completed transfers */
+	uint32_t transfers;
+	/** Number of times the stream was interrupted by an empty queue */
+	uint32_t dropped_bursts;
+	/** Number of transfers with an address outside the mapped memory */
+	uint32_t dma_errors;
+	/** Sum of the bytes sent to the DAC */
+	uint32_t dac_checksum;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Add a modeled core. */
+int32_t axi_io_model_add(const struct axi_io_model_init_param *param);
+/* Make a buffer accessible to the modeled DMACs. */
+int32_t axi_io_model_dma_map(void *buf, uint32_t size);
+/* Get the statistics of a modeled DMAC. */
+int32_t axi_io_model_get_stats(uint32_t base, struct axi_io_model_stats *stats);
+/* Remove all the modeled cores and mapped buffers. */
+void axi_io_model_remove_all(void);
+
+#endif // _AXI_IO_MODEL_H_
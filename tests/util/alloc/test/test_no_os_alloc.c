@@ -0,0 +1,253 @@
+/***************************************************************************//**
+ *   @file   test_no_os_alloc.c
+ *   @brief  Unit tests of the pool allocator and of the arena.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define CHURN_SLOTS	64
+
+static void *slots[CHURN_SLOTS];
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/*
+ * Allocate or free a pseudo random slot with a pseudo random size, then free
+ * everything.
+ */
+static void churn(uint32_t nb_ops)
+{
+	uint32_t seed = 1;
+	uint32_t i, idx;
+
+	for (i = 0; i < nb_ops; i++) {
+		seed = seed * 1103515245 + 12345;
+		idx = (seed >> 16) % CHURN_SLOTS;
+		if (slots[idx]) {
+			no_os_free(slots[idx]);
+			slots[idx] = NULL;
+		} else {
+			slots[idx] = no_os_malloc(1 + (seed >> 8) % 300);
+			TEST_ASSERT_NOT_NULL(slots[idx]);
+		}
+	}
+
+	for (i = 0; i < CHURN_SLOTS; i++) {
+		no_os_free(slots[i]);
+		slots[i] = NULL;
+	}
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_alloc_reuse(void)
+{
+	void *p, *q;
+
+	p = no_os_malloc(100);
+	TEST_ASSERT_NOT_NULL(p);
+	TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)p % NO_OS_ALLOC_ALIGN);
+	memset(p, 0xAA, 100);
+	no_os_free(p);
+
+	/* Same size class, same block */
+	q = no_os_malloc(90);
+	TEST_ASSERT_EQUAL_PTR(p, q);
+	no_os_free(q);
+	no_os_free(NULL);
+}
+
+void test_calloc(void)
+{
+	uint8_t zero[64] = {0};
+	uint8_t *p;
+
+	p = no_os_malloc(64);
+	memset(p, 0x55, 64);
+	no_os_free(p);
+
+	p = no_os_calloc(16, 4);
+	TEST_ASSERT_NOT_NULL(p);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(zero, p, 64);
+	no_os_free(p);
+
+	TEST_ASSERT_NULL(no_os_calloc(SIZE_MAX / 2, 4));
+}
+
+void test_alloc_stats(void)
+{
+	struct no_os_alloc_stats before, stats;
+	struct no_os_alloc_site_stats site;
+	void *p[8];
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_alloc_get_stats(NULL));
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&before));
+	TEST_ASSERT_EQUAL_UINT32(65536, before.heap_size);
+
+	for (i = 0; i < 8; i++)
+		p[i] = no_os_malloc(10 * (i + 1));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&stats));
+	TEST_ASSERT_EQUAL_UINT32(before.nb_allocs + 8, stats.nb_allocs);
+	TEST_ASSERT_EQUAL_UINT32(before.in_use + 360, stats.in_use);
+	TEST_ASSERT_TRUE(stats.high_water >= stats.in_use);
+	TEST_ASSERT_TRUE(stats.heap_used >= stats.in_use);
+	TEST_ASSERT_TRUE(stats.fragmentation < 1000);
+
+	/* The loop above is a new call site */
+	TEST_ASSERT_EQUAL_UINT32(before.nb_sites + 1, stats.nb_sites);
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_site_stats(before.nb_sites,
+			      &site));
+	TEST_ASSERT_EQUAL_UINT32(8, site.nb_allocs);
+	TEST_ASSERT_EQUAL_UINT32(360, site.in_use);
+	TEST_ASSERT_EQUAL_UINT32(80, site.peak);
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      no_os_alloc_get_site_stats(stats.nb_sites, &site));
+
+	for (i = 0; i < 8; i++)
+		no_os_free(p[i]);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_site_stats(before.nb_sites,
+			      &site));
+	TEST_ASSERT_EQUAL_UINT32(0, site.in_use);
+	TEST_ASSERT_EQUAL_UINT32(360, site.high_water);
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&stats));
+	TEST_ASSERT_EQUAL_UINT32(before.in_use, stats.in_use);
+	TEST_ASSERT_EQUAL_UINT32(before.nb_frees + 8, stats.nb_frees);
+}
+
+void test_alloc_exhausted(void)
+{
+	struct no_os_alloc_stats before, stats;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&before));
+	TEST_ASSERT_NULL(no_os_malloc(65536));
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&stats));
+	TEST_ASSERT_EQUAL_UINT32(before.nb_failed + 1, stats.nb_failed);
+	TEST_ASSERT_EQUAL_UINT32(before.heap_used, stats.heap_used);
+}
+
+void test_alloc_too_large(void)
+{
+	struct no_os_alloc_stats before, stats;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&before));
+	TEST_ASSERT_NULL(no_os_malloc(UINT32_MAX));
+	TEST_ASSERT_NULL(no_os_malloc(SIZE_MAX - NO_OS_ALLOC_ALIGN));
+	TEST_ASSERT_NULL(no_os_malloc(SIZE_MAX));
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&stats));
+	TEST_ASSERT_EQUAL_UINT32(before.heap_used, stats.heap_used);
+	TEST_ASSERT_EQUAL_UINT32(before.nb_allocs, stats.nb_allocs);
+}
+
+void test_alloc_init(void)
+{
+	void *p;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_init());
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_init());
+
+	p = no_os_malloc(100);
+	TEST_ASSERT_NOT_NULL(p);
+	no_os_free(p);
+}
+
+void test_alloc_no_fragmentation(void)
+{
+	struct no_os_alloc_stats first, stats;
+
+	churn(100000);
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&first));
+
+	/* The blocks freed by the first run are enough for the second one */
+	churn(100000);
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&stats));
+	TEST_ASSERT_EQUAL_UINT32(first.heap_used, stats.heap_used);
+	TEST_ASSERT_EQUAL_UINT32(first.nb_failed, stats.nb_failed);
+}
+
+void test_arena(void)
+{
+	struct no_os_arena arena;
+	uint8_t mem[100];
+	uint8_t *p, *q;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_arena_init(NULL, mem, 100));
+	TEST_ASSERT_EQUAL_INT(0, no_os_arena_init(&arena, mem + 1, 99));
+	TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)arena.base % NO_OS_ALLOC_ALIGN);
+
+	p = no_os_arena_alloc(&arena, 1);
+	q = no_os_arena_alloc(&arena, 10);
+	TEST_ASSERT_EQUAL_PTR(arena.base, p);
+	TEST_ASSERT_EQUAL_PTR(arena.base + NO_OS_ALLOC_ALIGN, q);
+	TEST_ASSERT_NULL(no_os_arena_alloc(&arena, 200));
+	TEST_ASSERT_NULL(no_os_arena_alloc(&arena, 0));
+
+	no_os_arena_reset(&arena);
+	TEST_ASSERT_EQUAL_UINT32(0, arena.used);
+	TEST_ASSERT_EQUAL_PTR(p, no_os_arena_alloc(&arena, 16));
+	TEST_ASSERT_TRUE(arena.high_water >= 2 * NO_OS_ALLOC_ALIGN);
+}
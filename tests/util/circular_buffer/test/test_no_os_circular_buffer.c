@@ -0,0 +1,457 @@
+/***************************************************************************//**
+ *   @file   test_no_os_circular_buffer.c
+ *   @brief  Unit and stress tests of the circular buffer.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_circular_buffer.h"
+#include "linux_circular_buffer.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_error.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define CB_SIZE			4096
+/* Words moved by the stress tests */
+#define STRESS_WORDS		(4 * 1024 * 1024)
+#ifdef NO_OS_TEST_BENCH
+/* Bytes moved by the throughput test */
+#define BENCH_BYTES		(256 * 1024 * 1024)
+#define BENCH_CHUNK		1024
+#endif
+
+struct stress_ctx {
+	struct no_os_circular_buffer *cb;
+	/* Don't overwrite data that wasn't read */
+	bool backpressure;
+	/* Use the async functions */
+	bool async;
+	bool done;
+	uint32_t nb_overruns;
+	uint32_t nb_errors;
+};
+
+static uint8_t tx[CB_SIZE], rx[CB_SIZE];
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < CB_SIZE; i++)
+		tx[i] = i * 7 + 1;
+	memset(rx, 0, sizeof(rx));
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/* Chunk sizes, in words, cycling through a few awkward values */
+static uint32_t stress_chunk(uint32_t n)
+{
+	static const uint32_t chunks[] = {1, 3, 17, 64, 255, 7, 128, 33};
+
+	return chunks[n % NO_OS_ARRAY_SIZE(chunks)];
+}
+
+static void *stress_producer(void *arg)
+{
+	struct stress_ctx *ctx = arg;
+	uint32_t words[256];
+	uint32_t seq = 0;
+	uint32_t used, nb, i, n = 0;
+	uint32_t avail;
+	void *buff;
+
+	while (seq < STRESS_WORDS) {
+		nb = stress_chunk(n++);
+		nb = no_os_min(nb, STRESS_WORDS - seq);
+		if (ctx->backpressure) {
+			no_os_cb_size(ctx->cb, &used);
+			if (ctx->cb->size - used < nb * sizeof(uint32_t)) {
+				sched_yield();
+				continue;
+			}
+		}
+
+		if (ctx->async) {
+			if (no_os_cb_prepare_async_write(ctx->cb,
+							 nb * sizeof(uint32_t),
+							 &buff, &avail))
+				ctx->nb_errors++;
+			nb = avail / sizeof(uint32_t);
+			for (i = 0; i < nb; i++)
+				((uint32_t *)buff)[i] = seq++;
+			no_os_cb_end_async_write(ctx->cb);
+		} else {
+			for (i = 0; i < nb; i++)
+				words[i] = seq++;
+			if (no_os_cb_write(ctx->cb, words,
+					   nb * sizeof(uint32_t)))
+				ctx->nb_errors++;
+		}
+	}
+	__atomic_store_n(&ctx->done, true, __ATOMIC_RELEASE);
+
+	return NULL;
+}
+
+/*
+ * Read until the producer is done. Data read without an overrun being reported
+ * must follow the sequence written by the producer.
+ */
+static void stress_consume(struct stress_ctx *ctx)
+{
+	uint32_t words[256];
+	uint32_t next = 0;
+	uint32_t size, nb, i, n = 0;
+	uint32_t avail = 0;
+	bool resync = false;
+	int32_t ret;
+	bool done;
+	void *buff;
+
+	while (true) {
+		done = __atomic_load_n(&ctx->done, __ATOMIC_ACQUIRE);
+		no_os_cb_size(ctx->cb, &size);
+		if (!size && done)
+			break;
+		nb = stress_chunk(n++);
+		nb = no_os_min(nb, size / sizeof(uint32_t));
+		if (!nb) {
+			sched_yield();
+			continue;
+		}
+
+		if (ctx->async) {
+			avail = 0;
+			ret = no_os_cb_prepare_async_read(ctx->cb,
+							  nb * sizeof(uint32_t),
+							  &buff, &avail);
+			nb = avail / sizeof(uint32_t);
+			memcpy(words, buff, nb * sizeof(uint32_t));
+			no_os_cb_end_async_read(ctx->cb);
+		} else {
+			ret = no_os_cb_read(ctx->cb, words,
+					    nb * sizeof(uint32_t));
+		}
+
+		/* The data read along with an overrun may be torn */
+		if (ret == -NO_OS_EOVERRUN) {
+			ctx->nb_overruns++;
+			resync = true;
+			continue;
+		}
+		if (ret)
+			ctx->nb_errors++;
+
+		if (resync) {
+			next = words[0];
+			resync = false;
+		}
+		for (i = 0; i < nb; i++, next++)
+			if (words[i] != next) {
+				ctx->nb_errors++;
+				next = words[i];
+			}
+	}
+}
+
+static void stress_run(struct no_os_circular_buffer *cb, bool backpressure,
+		       bool async)
+{
+	struct stress_ctx ctx = {
+		.cb = cb,
+		.backpressure = backpressure,
+		.async = async,
+	};
+	pthread_t producer;
+
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL,
+						stress_producer, &ctx));
+	stress_consume(&ctx);
+	pthread_join(producer, NULL);
+
+	TEST_ASSERT_EQUAL_UINT32(0, ctx.nb_errors);
+	if (backpressure)
+		TEST_ASSERT_EQUAL_UINT32(0, ctx.nb_overruns);
+}
+
+#ifdef NO_OS_TEST_BENCH
+static void *bench_producer(void *arg)
+{
+	struct no_os_circular_buffer *cb = arg;
+	static uint8_t chunk[BENCH_CHUNK];
+	uint64_t sent = 0;
+	uint32_t used;
+
+	while (sent < BENCH_BYTES) {
+		no_os_cb_size(cb, &used);
+		if (cb->size - used < BENCH_CHUNK) {
+			sched_yield();
+			continue;
+		}
+		no_os_cb_write(cb, chunk, BENCH_CHUNK);
+		sent += BENCH_CHUNK;
+	}
+
+	return NULL;
+}
+
+static void bench_run(struct no_os_circular_buffer *cb, const char *name)
+{
+	static uint8_t chunk[BENCH_CHUNK];
+	struct timespec start;
+	pthread_t producer;
+	uint64_t received = 0;
+	uint32_t size;
+	char msg[96];
+	double t;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL,
+						bench_producer, cb));
+	while (received < BENCH_BYTES) {
+		no_os_cb_size(cb, &size);
+		if (size < BENCH_CHUNK) {
+			sched_yield();
+			continue;
+		}
+		TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(cb, chunk, BENCH_CHUNK));
+		received += BENCH_CHUNK;
+	}
+	pthread_join(producer, NULL);
+	t = bench_elapsed_s(&start);
+
+	snprintf(msg, sizeof(msg), "%s: %.0f MB/s", name,
+		 BENCH_BYTES / t / 1e6);
+	TEST_MESSAGE(msg);
+}
+#endif
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_cb_write_read(void)
+{
+	struct no_os_circular_buffer *cb;
+	uint32_t size;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&cb, 100));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_write(cb, tx, 60));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(cb, &size));
+	TEST_ASSERT_EQUAL_UINT32(60, size);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(cb, rx, 50));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(tx, rx, 50);
+
+	/* Wrap around the end of the buffer */
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_write(cb, tx + 60, 80));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(cb, &size));
+	TEST_ASSERT_EQUAL_UINT32(90, size);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(cb, rx + 50, 90));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(tx, rx, 140);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(cb, &size));
+	TEST_ASSERT_EQUAL_UINT32(0, size);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_remove(cb));
+}
+
+void test_cb_cfg_invalid(void)
+{
+	struct no_os_circular_buffer cb;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_cb_cfg(NULL, (int8_t *)rx, 1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_cb_cfg(&cb, (int8_t *)rx, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_cb_cfg(&cb, (int8_t *)rx,
+			      UINT32_MAX / 2 + 1));
+}
+
+void test_cb_overrun(void)
+{
+	struct no_os_circular_buffer cb;
+	uint32_t size;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_cfg(&cb, (int8_t *)rx, 64));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_write(&cb, tx, 100));
+	TEST_ASSERT_EQUAL_INT(-NO_OS_EOVERRUN, no_os_cb_size(&cb, &size));
+	TEST_ASSERT_EQUAL_UINT32(64, size);
+
+	/* The oldest data still in the buffer is read */
+	TEST_ASSERT_EQUAL_INT(-NO_OS_EOVERRUN, no_os_cb_read(&cb, tx + 1024,
+			      64));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(tx + 36, tx + 1024, 64);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(&cb, &size));
+	TEST_ASSERT_EQUAL_UINT32(0, size);
+}
+
+void test_cb_async_split(void)
+{
+	struct no_os_circular_buffer cb;
+	uint32_t avail;
+	void *buff;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_cfg(&cb, (int8_t *)rx, 64));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_write(&cb, tx, 48));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(&cb, tx + 1024, 48));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_prepare_async_write(&cb, 32, &buff,
+			      &avail));
+	TEST_ASSERT_EQUAL_PTR(rx + 48, buff);
+	TEST_ASSERT_EQUAL_UINT32(16, avail);
+	TEST_ASSERT_EQUAL_INT(-EBUSY, no_os_cb_prepare_async_write(&cb, 32,
+			      &buff, &avail));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_end_async_write(&cb));
+	TEST_ASSERT_EQUAL_INT(-1, no_os_cb_end_async_write(&cb));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_prepare_async_write(&cb, 16, &buff,
+			      &avail));
+	TEST_ASSERT_EQUAL_PTR(rx, buff);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_end_async_write(&cb));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_prepare_async_read(&cb, 32, &buff,
+			      &avail));
+	TEST_ASSERT_EQUAL_PTR(rx + 48, buff);
+	TEST_ASSERT_EQUAL_UINT32(16, avail);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_end_async_read(&cb));
+}
+
+void test_cb_mirrored(void)
+{
+	struct no_os_circular_buffer *cb;
+	uint32_t avail;
+	void *buff;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_cb_init_mirrored(&cb, 100));
+	TEST_ASSERT_EQUAL_UINT32(0, cb->size % 4096);
+	TEST_ASSERT_EQUAL_INT(-1, no_os_cb_remove(cb));
+
+	/* Move the pointers close to the end of the buffer */
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_write(cb, tx, 4000));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(cb, rx, 4000));
+
+	/* Regions crossing the end are returned whole */
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_prepare_async_write(cb, 1000, &buff,
+			      &avail));
+	TEST_ASSERT_EQUAL_UINT32(1000, avail);
+	memcpy(buff, tx, avail);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_end_async_write(cb));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_prepare_async_read(cb, 1000, &buff,
+			      &avail));
+	TEST_ASSERT_EQUAL_UINT32(1000, avail);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(tx, buff, 1000);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_end_async_read(cb));
+	/* Same memory seen through the first mapping */
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(tx + 96, cb->buff, 904);
+
+	TEST_ASSERT_EQUAL_INT(0, linux_cb_remove_mirrored(cb));
+}
+
+void test_cb_stress_backpressure(void)
+{
+	struct no_os_circular_buffer *cb;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&cb, CB_SIZE));
+	stress_run(cb, true, false);
+	no_os_cb_remove(cb);
+}
+
+void test_cb_stress_async_backpressure(void)
+{
+	struct no_os_circular_buffer *cb;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&cb, CB_SIZE));
+	stress_run(cb, true, true);
+	no_os_cb_remove(cb);
+}
+
+void test_cb_stress_overrun(void)
+{
+	struct no_os_circular_buffer *cb;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&cb, CB_SIZE));
+	stress_run(cb, false, false);
+	no_os_cb_remove(cb);
+}
+
+void test_cb_stress_mirrored(void)
+{
+	struct no_os_circular_buffer *cb;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_cb_init_mirrored(&cb, CB_SIZE));
+	stress_run(cb, true, true);
+	stress_run(cb, false, false);
+	linux_cb_remove_mirrored(cb);
+}
+
+#ifdef NO_OS_TEST_BENCH
+void test_cb_throughput(void)
+{
+	struct no_os_circular_buffer *cb;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&cb, 64 * 1024));
+	bench_run(cb, "heap");
+	no_os_cb_remove(cb);
+
+	TEST_ASSERT_EQUAL_INT(0, linux_cb_init_mirrored(&cb, 64 * 1024));
+	bench_run(cb, "mirrored");
+	linux_cb_remove_mirrored(cb);
+}
+#endif
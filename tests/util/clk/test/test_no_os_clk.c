@@ -0,0 +1,672 @@
+/***************************************************************************//**
+ *   @file   test_no_os_clk.c
+ *   @brief  Unit tests of the clock tree.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_clk.h"
+#include "no_os_util.h"
+#include "no_os_error.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* Fake clock chip: a VCO or an output divider behind a register map */
+struct fake_clk {
+	/* VCO rate, root clocks only */
+	uint64_t vco;
+	uint64_t vco_min;
+	uint64_t vco_max;
+	uint32_t div;
+	uint32_t max_div;
+	/* Register reads needed to read the configuration back */
+	uint32_t read_cost;
+	bool enabled;
+};
+
+static uint32_t reg_reads, reg_writes;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	reg_reads = 0;
+	reg_writes = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int fake_init(struct no_os_clk_desc **desc,
+		     const struct no_os_clk_init_param *param)
+{
+	*desc = calloc(1, sizeof(**desc));
+	if (!*desc)
+		return -ENOMEM;
+
+	(*desc)->name = param->name;
+	(*desc)->dev_desc = param->dev_desc;
+
+	return 0;
+}
+
+/* Shares its divider with other clocks, as the SYSREF outputs of the AD9528 */
+static int fake_shared_init(struct no_os_clk_desc **desc,
+			    const struct no_os_clk_init_param *param)
+{
+	int ret;
+
+	ret = fake_init(desc, param);
+	if (ret)
+		return ret;
+
+	(*desc)->flags = NO_OS_CLK_GET_RATE_NOCACHE;
+
+	return 0;
+}
+
+static int fake_remove(struct no_os_clk_desc *desc)
+{
+	free(desc);
+
+	return 0;
+}
+
+static int fake_enable(struct no_os_clk_desc *desc)
+{
+	struct fake_clk *clk = desc->dev_desc;
+
+	reg_writes++;
+	clk->enabled = true;
+
+	return 0;
+}
+
+static int fake_disable(struct no_os_clk_desc *desc)
+{
+	struct fake_clk *clk = desc->dev_desc;
+
+	reg_writes++;
+	clk->enabled = false;
+
+	return 0;
+}
+
+static int fake_vco_recalc_rate(struct no_os_clk_desc *desc, uint64_t *rate)
+{
+	struct fake_clk *clk = desc->dev_desc;
+
+	reg_reads += clk->read_cost;
+	*rate = clk->vco;
+
+	return 0;
+}
+
+static int fake_vco_round_rate(struct no_os_clk_desc *desc, uint64_t rate,
+			       uint64_t *rounded_rate)
+{
+	struct fake_clk *clk = desc->dev_desc;
+
+	if (rate < clk->vco_min || rate > clk->vco_max)
+		return -EINVAL;
+
+	*rounded_rate = rate;
+
+	return 0;
+}
+
+static int fake_vco_set_rate(struct no_os_clk_desc *desc, uint64_t rate)
+{
+	struct fake_clk *clk = desc->dev_desc;
+
+	reg_writes += 3;
+	clk->vco = rate;
+
+	return 0;
+}
+
+static int fake_div_recalc_rate(struct no_os_clk_desc *desc, uint64_t *rate)
+{
+	struct fake_clk *clk = desc->dev_desc;
+	uint64_t parent_rate;
+	int ret;
+
+	ret = no_os_clk_get_parent_rate(desc, &parent_rate);
+	if (ret)
+		return ret;
+
+	reg_reads += clk->read_cost;
+	*rate = parent_rate / clk->div;
+
+	return 0;
+}
+
+static int fake_div_calc(struct no_os_clk_desc *desc, uint64_t rate,
+			 uint32_t *div)
+{
+	struct fake_clk *clk = desc->dev_desc;
+	uint64_t parent_rate;
+	int ret;
+
+	ret = no_os_clk_get_parent_rate(desc, &parent_rate);
+	if (ret)
+		return ret;
+
+	if (!rate || rate > parent_rate)
+		return -EINVAL;
+
+	*div = no_os_clamp(NO_OS_DIV_ROUND_CLOSEST_ULL(parent_rate, rate), 1,
+			   clk->max_div);
+
+	return 0;
+}
+
+static int fake_div_round_rate(struct no_os_clk_desc *desc, uint64_t rate,
+			       uint64_t *rounded_rate)
+{
+	uint64_t parent_rate;
+	uint32_t div;
+	int ret;
+
+	ret = fake_div_calc(desc, rate, &div);
+	if (ret)
+		return ret;
+
+	no_os_clk_get_parent_rate(desc, &parent_rate);
+	*rounded_rate = parent_rate / div;
+
+	return 0;
+}
+
+static int fake_div_set_rate(struct no_os_clk_desc *desc, uint64_t rate)
+{
+	struct fake_clk *clk = desc->dev_desc;
+	uint32_t div;
+	int ret;
+
+	ret = fake_div_calc(desc, rate, &div);
+	if (ret)
+		return ret;
+
+	reg_writes += 2;
+	clk->div = div;
+
+	return 0;
+}
+
+/* Fixed divider: rate changes have to go to the parent */
+static int fake_fixed_determine_rate(struct no_os_clk_desc *desc,
+				     struct no_os_clk_rate_request *req)
+{
+	struct fake_clk *clk = desc->dev_desc;
+
+	if (req->parent_rate == req->rate * clk->div) {
+		req->rate = req->parent_rate / clk->div;
+		return 0;
+	}
+
+	req->parent_rate = req->rate * clk->div;
+	req->rate = req->parent_rate / clk->div;
+
+	return 0;
+}
+
+static const struct no_os_clk_platform_ops fake_vco_ops = {
+	.init = fake_init,
+	.clk_enable = fake_enable,
+	.clk_disable = fake_disable,
+	.clk_recalc_rate = fake_vco_recalc_rate,
+	.clk_round_rate = fake_vco_round_rate,
+	.clk_set_rate = fake_vco_set_rate,
+	.remove = fake_remove,
+};
+
+static const struct no_os_clk_platform_ops fake_div_ops = {
+	.init = fake_init,
+	.clk_enable = fake_enable,
+	.clk_disable = fake_disable,
+	.clk_recalc_rate = fake_div_recalc_rate,
+	.clk_round_rate = fake_div_round_rate,
+	.clk_set_rate = fake_div_set_rate,
+	.remove = fake_remove,
+};
+
+static const struct no_os_clk_platform_ops fake_shared_ops = {
+	.init = fake_shared_init,
+	.clk_recalc_rate = fake_div_recalc_rate,
+	.clk_round_rate = fake_div_round_rate,
+	.clk_set_rate = fake_div_set_rate,
+	.remove = fake_remove,
+};
+
+static const struct no_os_clk_platform_ops fake_fixed_ops = {
+	.init = fake_init,
+	.clk_recalc_rate = fake_div_recalc_rate,
+	.clk_determine_rate = fake_fixed_determine_rate,
+	.remove = fake_remove,
+};
+
+static struct no_os_clk_desc *fake_clk_add(struct fake_clk *clk,
+		const struct no_os_clk_platform_ops *ops,
+		struct no_os_clk_desc *parent,
+		uint32_t flags)
+{
+	struct no_os_clk_init_param param = {
+		.name = "fake",
+		.platform_ops = ops,
+		.dev_desc = clk,
+		.parent = parent,
+		.flags = flags,
+	};
+	struct no_os_clk_desc *desc;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_init(&desc, &param));
+
+	return desc;
+}
+
+static uint32_t reg_accesses(void)
+{
+	return reg_reads + reg_writes;
+}
+
+/* Without the tree every request goes straight to the driver */
+static int32_t bring_up_recalc(struct no_os_clk_desc *desc, bool tree,
+			       uint64_t *rate)
+{
+	if (tree)
+		return no_os_clk_recalc_rate(desc, rate);
+
+	return desc->platform_ops->clk_recalc_rate(desc, rate);
+}
+
+static int32_t bring_up_set_rate(struct no_os_clk_desc *desc, bool tree,
+				 uint64_t rate)
+{
+	if (tree)
+		return no_os_clk_set_rate(desc, rate);
+
+	return desc->platform_ops->clk_set_rate(desc, rate);
+}
+
+/*
+ * fmcdaq2 style bring-up: a VCO feeding the converter device clocks, the FPGA
+ * core clock and the two transceivers. The link is brought up twice, the
+ * second time as a resume after a failed link check. With tree == false the
+ * requests go to the drivers directly and the rates are never cached.
+ */
+static uint32_t bring_up(bool tree)
+{
+	struct fake_clk vco = { .vco = 1000000000, .vco_min = 500000000,
+		       .vco_max = 2000000000, .read_cost = 4
+	};
+	struct fake_clk dev_clk[2] = {
+		{ .div = 1, .max_div = 1024, .read_cost = 3 },
+		{ .div = 1, .max_div = 1024, .read_cost = 3 },
+	};
+	struct fake_clk clkgen = { .div = 4, .max_div = 128, .read_cost = 3 };
+	struct fake_clk xcvr[2] = {
+		{ .div = 1, .max_div = 16, .read_cost = 8 },
+		{ .div = 1, .max_div = 16, .read_cost = 8 },
+	};
+	uint32_t flags = tree ? 0 : NO_OS_CLK_GET_RATE_NOCACHE;
+	struct no_os_clk_desc *root, *dev[2], *core, *lane[2];
+	uint32_t start, run, i, j;
+	uint64_t rate;
+	int32_t ret;
+
+	root = fake_clk_add(&vco, &fake_vco_ops, NULL, flags);
+	core = fake_clk_add(&clkgen, &fake_div_ops, root, flags);
+	for (i = 0; i < 2; i++) {
+		dev[i] = fake_clk_add(&dev_clk[i], &fake_div_ops, root, flags);
+		lane[i] = fake_clk_add(&xcvr[i], &fake_div_ops, dev[i], flags);
+	}
+
+	start = reg_accesses();
+
+	for (run = 0; run < 2; run++) {
+		for (i = 0; i < 2; i++) {
+			/* Converter init: device clock and SYSREF checks */
+			for (j = 0; j < 2; j++) {
+				ret = bring_up_recalc(dev[i], tree, &rate);
+				TEST_ASSERT_EQUAL_INT(0, ret);
+			}
+			ret = bring_up_set_rate(dev[i], tree, 500000000);
+			TEST_ASSERT_EQUAL_INT(0, ret);
+
+			/* Link setup: lane rate and core clock */
+			ret = bring_up_set_rate(lane[i], tree, 250000000);
+			TEST_ASSERT_EQUAL_INT(0, ret);
+			ret = bring_up_set_rate(core, tree, 250000000);
+			TEST_ASSERT_EQUAL_INT(0, ret);
+
+			/* Link enable */
+			if (tree) {
+				if (no_os_clk_is_enabled(lane[i]))
+					no_os_clk_disable(lane[i]);
+				ret = no_os_clk_enable(lane[i]);
+				TEST_ASSERT_EQUAL_INT(0, ret);
+				ret = no_os_clk_enable(core);
+				TEST_ASSERT_EQUAL_INT(0, ret);
+			} else {
+				fake_enable(root);
+				fake_enable(dev[i]);
+				fake_enable(lane[i]);
+				fake_enable(root);
+				fake_enable(core);
+			}
+		}
+
+		/* Status report */
+		for (i = 0; i < 2; i++) {
+			ret = bring_up_recalc(lane[i], tree, &rate);
+			TEST_ASSERT_EQUAL_INT(0, ret);
+			TEST_ASSERT_EQUAL_UINT64(250000000, rate);
+			ret = bring_up_recalc(dev[i], tree, &rate);
+			TEST_ASSERT_EQUAL_INT(0, ret);
+			TEST_ASSERT_EQUAL_UINT64(500000000, rate);
+		}
+		ret = bring_up_recalc(core, tree, &rate);
+		TEST_ASSERT_EQUAL_INT(0, ret);
+		TEST_ASSERT_EQUAL_UINT64(250000000, rate);
+	}
+
+	TEST_ASSERT_TRUE(xcvr[0].enabled && xcvr[1].enabled && vco.enabled);
+
+	start = reg_accesses() - start;
+
+	for (i = 0; i < 2; i++) {
+		TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(lane[i]));
+		TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(dev[i]));
+	}
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(core));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(root));
+
+	return start;
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_clk_tree_links(void)
+{
+	struct fake_clk vco = { .vco = 1000000000 };
+	struct fake_clk a = { .div = 2 }, b = { .div = 4 };
+	struct no_os_clk_desc *root, *ca, *cb;
+
+	root = fake_clk_add(&vco, &fake_vco_ops, NULL, 0);
+	ca = fake_clk_add(&a, &fake_div_ops, root, 0);
+	cb = fake_clk_add(&b, &fake_div_ops, root, 0);
+
+	TEST_ASSERT_EQUAL_PTR(root, no_os_clk_get_parent(ca));
+	TEST_ASSERT_EQUAL_PTR(root, no_os_clk_get_parent(cb));
+	TEST_ASSERT_NULL(no_os_clk_get_parent(root));
+
+	/* No loops */
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_clk_set_parent(root, ca));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_clk_set_parent(ca, ca));
+
+	/* Reparent b under a */
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_parent(cb, ca));
+	TEST_ASSERT_EQUAL_PTR(ca, no_os_clk_get_parent(cb));
+
+	/* A parent can't go away before its children */
+	TEST_ASSERT_EQUAL_INT(-EBUSY, no_os_clk_remove(root));
+	TEST_ASSERT_EQUAL_INT(-EBUSY, no_os_clk_remove(ca));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(cb));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(ca));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(root));
+}
+
+void test_clk_rate_cache(void)
+{
+	struct fake_clk vco = { .vco = 1000000000, .vco_min = 500000000,
+		       .vco_max = 2000000000, .read_cost = 4
+	};
+	struct fake_clk a = { .div = 4, .max_div = 16, .read_cost = 3 };
+	struct no_os_clk_desc *root, *ca;
+	uint32_t ops;
+	uint64_t rate;
+
+	root = fake_clk_add(&vco, &fake_vco_ops, NULL, 0);
+	ca = fake_clk_add(&a, &fake_div_ops, root, 0);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(ca, &rate));
+	TEST_ASSERT_EQUAL_UINT64(250000000, rate);
+	TEST_ASSERT_EQUAL_UINT32(7, reg_reads);
+
+	/* Served from the cache */
+	ops = no_os_clk_get_hw_op_count();
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(ca, &rate));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(root, &rate));
+	TEST_ASSERT_EQUAL_UINT32(7, reg_reads);
+	TEST_ASSERT_EQUAL_UINT32(ops, no_os_clk_get_hw_op_count());
+
+	/* A parent rate change drops the cached rates below it */
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rate(root, 2000000000));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(ca, &rate));
+	TEST_ASSERT_EQUAL_UINT64(500000000, rate);
+	TEST_ASSERT_EQUAL_UINT32(14, reg_reads);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(ca));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(root));
+}
+
+void test_clk_platform_flags(void)
+{
+	struct fake_clk vco = { .vco = 1000000000, .vco_min = 500000000,
+		       .vco_max = 2000000000, .read_cost = 4
+	};
+	struct fake_clk shared = { .div = 4, .max_div = 16, .read_cost = 3 };
+	struct no_os_clk_desc *root, *ca, *cb;
+	uint64_t rate;
+
+	root = fake_clk_add(&vco, &fake_vco_ops, NULL, 0);
+	ca = fake_clk_add(&shared, &fake_shared_ops, root, 0);
+	cb = fake_clk_add(&shared, &fake_shared_ops, root,
+			  NO_OS_CLK_SET_RATE_PARENT);
+
+	/* The flags set by the platform are kept */
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_CLK_GET_RATE_NOCACHE, ca->flags);
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_CLK_GET_RATE_NOCACHE |
+				 NO_OS_CLK_SET_RATE_PARENT, cb->flags);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(ca, &rate));
+	TEST_ASSERT_EQUAL_UINT64(250000000, rate);
+
+	/* A change made through the other clock is seen */
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rate(cb, 125000000));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(ca, &rate));
+	TEST_ASSERT_EQUAL_UINT64(125000000, rate);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(cb));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(ca));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(root));
+}
+
+void test_clk_enable_refcount(void)
+{
+	struct fake_clk vco = { .vco = 1000000000 };
+	struct fake_clk a = { .div = 2 }, b = { .div = 4 };
+	struct no_os_clk_desc *root, *ca, *cb;
+
+	root = fake_clk_add(&vco, &fake_vco_ops, NULL, 0);
+	ca = fake_clk_add(&a, &fake_div_ops, root, 0);
+	cb = fake_clk_add(&b, &fake_div_ops, root, 0);
+
+	/* The parent is started once, before its first child */
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_enable(ca));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_enable(ca));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_enable(cb));
+	TEST_ASSERT_TRUE(vco.enabled && a.enabled && b.enabled);
+	TEST_ASSERT_EQUAL_UINT32(3, reg_writes);
+
+	/* And stopped after its last child */
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_disable(ca));
+	TEST_ASSERT_TRUE(a.enabled);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_disable(ca));
+	TEST_ASSERT_FALSE(a.enabled);
+	TEST_ASSERT_TRUE(vco.enabled);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_disable(cb));
+	TEST_ASSERT_FALSE(vco.enabled || b.enabled);
+	TEST_ASSERT_FALSE(no_os_clk_is_enabled(root));
+
+	/* A clock that isn't enabled is still forced off, parents untouched */
+	vco.enabled = true;
+	a.enabled = true;
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_disable(ca));
+	TEST_ASSERT_FALSE(a.enabled);
+	TEST_ASSERT_TRUE(vco.enabled);
+
+	/* An enabled clock moves its enable to the new parent */
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_enable(cb));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_parent(cb, ca));
+	TEST_ASSERT_TRUE(no_os_clk_is_enabled(ca));
+	TEST_ASSERT_TRUE(a.enabled && vco.enabled);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_disable(cb));
+	TEST_ASSERT_FALSE(no_os_clk_is_enabled(ca));
+	TEST_ASSERT_FALSE(no_os_clk_is_enabled(root));
+	TEST_ASSERT_FALSE(vco.enabled || a.enabled || b.enabled);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(cb));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(ca));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(root));
+}
+
+void test_clk_set_rate(void)
+{
+	struct fake_clk vco = { .vco = 1000000000, .vco_min = 500000000,
+		       .vco_max = 2000000000, .read_cost = 4
+	};
+	struct fake_clk a = { .div = 4, .max_div = 16, .read_cost = 3 };
+	struct no_os_clk_desc *root, *ca;
+	uint64_t rate;
+
+	root = fake_clk_add(&vco, &fake_vco_ops, NULL, 0);
+	ca = fake_clk_add(&a, &fake_div_ops, root, 0);
+
+	/* Rejected by the round pass, nothing written */
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_clk_set_rate(ca, 2000000000));
+	TEST_ASSERT_EQUAL_UINT32(0, reg_writes);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_round_rate(ca, 300000000, &rate));
+	TEST_ASSERT_EQUAL_UINT64(333333333, rate);
+	TEST_ASSERT_EQUAL_UINT32(0, reg_writes);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rate(ca, 300000000));
+	TEST_ASSERT_EQUAL_UINT32(2, reg_writes);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(ca, &rate));
+	TEST_ASSERT_EQUAL_UINT64(333333333, rate);
+
+	/* Already there */
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rate(ca, 333333333));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rate(ca, 300000000));
+	TEST_ASSERT_EQUAL_UINT32(2, reg_writes);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(ca));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(root));
+}
+
+void test_clk_set_rate_parent(void)
+{
+	struct fake_clk vco = { .vco = 1000000000, .vco_min = 500000000,
+		       .vco_max = 2000000000, .read_cost = 4
+	};
+	struct fake_clk fixed = { .div = 8, .read_cost = 1 };
+	struct fake_clk a = { .div = 4, .max_div = 16, .read_cost = 3 };
+	struct no_os_clk_desc *root, *cf, *ca;
+	uint64_t rate;
+
+	root = fake_clk_add(&vco, &fake_vco_ops, NULL, 0);
+	cf = fake_clk_add(&fixed, &fake_fixed_ops, root,
+			  NO_OS_CLK_SET_RATE_PARENT);
+	ca = fake_clk_add(&a, &fake_div_ops, root, 0);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(ca, &rate));
+	TEST_ASSERT_EQUAL_UINT64(250000000, rate);
+
+	/* Negotiated with the VCO limits, nothing written */
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_round_rate(cf, 200000000, &rate));
+	TEST_ASSERT_EQUAL_UINT64(200000000, rate);
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      no_os_clk_round_rate(cf, 300000000, &rate));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_clk_set_rate(cf, 300000000));
+	TEST_ASSERT_EQUAL_UINT32(0, reg_writes);
+
+	/* The fixed divider moves the VCO, its sibling follows */
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_set_rate(cf, 200000000));
+	TEST_ASSERT_EQUAL_UINT64(1600000000, vco.vco);
+	TEST_ASSERT_EQUAL_UINT32(3, reg_writes);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(cf, &rate));
+	TEST_ASSERT_EQUAL_UINT64(200000000, rate);
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_recalc_rate(ca, &rate));
+	TEST_ASSERT_EQUAL_UINT64(400000000, rate);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(ca));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(cf));
+	TEST_ASSERT_EQUAL_INT(0, no_os_clk_remove(root));
+}
+
+void test_clk_bring_up_accesses(void)
+{
+	uint32_t flat, tree;
+	char msg[128];
+
+	flat = bring_up(false);
+	tree = bring_up(true);
+
+	snprintf(msg, sizeof(msg),
+		 "bring-up: %u register accesses flat, %u with the clock tree",
+		 (unsigned int)flat, (unsigned int)tree);
+	TEST_MESSAGE(msg);
+
+	TEST_ASSERT_LESS_THAN_UINT32(flat, tree);
+}
@@ -0,0 +1,264 @@
+/***************************************************************************//**
+ *   @file   test_no_os_crc.c
+ *   @brief  Unit tests of the CRC lookup tables and of the CRC-32 implementations.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_crc8.h"
+#include "no_os_crc16.h"
+#include "no_os_crc24.h"
+#include "no_os_crc32.h"
+#include "no_os_util.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * no_os_crc32.c is built with the default NO_OS_CRC32_SLICE. The other slice
+ * sizes are built here under different names, so that all of them are
+ * compared with the bitwise implementation.
+ */
+#undef NO_OS_CRC32_SLICE
+#define NO_OS_CRC32_SLICE	1
+#define no_os_crc32		crc32_slice1
+#define crc32_table		crc32_table_slice1
+#define crc32_get_le32		crc32_get_le32_slice1
+#include "no_os_crc32.c"
+#undef no_os_crc32
+#undef crc32_table
+#undef crc32_get_le32
+
+#undef NO_OS_CRC32_SLICE
+#define NO_OS_CRC32_SLICE	4
+#define no_os_crc32		crc32_slice4
+#define crc32_table		crc32_table_slice4
+#define crc32_get_le32		crc32_get_le32_slice4
+#include "no_os_crc32.c"
+#undef no_os_crc32
+#undef crc32_table
+#undef crc32_get_le32
+
+#undef NO_OS_CRC32_SLICE
+#define NO_OS_CRC32_SLICE	8
+#define no_os_crc32		crc32_slice8
+#define crc32_table		crc32_table_slice8
+#define crc32_get_le32		crc32_get_le32_slice8
+#include "no_os_crc32.c"
+#undef no_os_crc32
+#undef crc32_table
+#undef crc32_get_le32
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* Polynomials used by the drivers */
+#define CRC8_POLY		0x07
+#define CRC8_POLY_2		0x31
+#define CRC16_POLY		0x1021
+#define CRC16_POLY_2		0x8005
+#define CRC24_POLY		0x864CFB
+
+#define BUF_SIZE		1024
+
+NO_OS_DEFINE_CRC8_TABLE(crc8_table, CRC8_POLY);
+NO_OS_DEFINE_CRC8_TABLE(crc8_table_2, CRC8_POLY_2);
+NO_OS_DEFINE_CRC16_TABLE(crc16_table, CRC16_POLY);
+NO_OS_DEFINE_CRC16_TABLE(crc16_table_2, CRC16_POLY_2);
+NO_OS_DEFINE_CRC24_TABLE(crc24_table, CRC24_POLY);
+
+static uint8_t buf[BUF_SIZE];
+
+static uint32_t (*const crc32_impl[])(const uint8_t *, size_t, uint32_t) = {
+	no_os_crc32, crc32_slice1, crc32_slice4, crc32_slice8
+};
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+/*
+ * Bit by bit msb-first CRC, as computed by the drivers before the table
+ * lookups (e.g. ad77681_compute_crc8()).
+ */
+static uint32_t crc_bitwise(uint32_t poly, uint8_t width, const uint8_t *data,
+			    size_t len, uint32_t crc)
+{
+	uint32_t msb = 1UL << (width - 1);
+	uint32_t mask = msb | (msb - 1);
+	uint8_t i;
+
+	while (len--) {
+		for (i = 0x80; i != 0; i >>= 1) {
+			if (!!(crc & msb) != !!(*data & i))
+				crc = (crc << 1) ^ poly;
+			else
+				crc <<= 1;
+		}
+		crc &= mask;
+		data++;
+	}
+
+	return crc;
+}
+
+/* Bit by bit lsb-first CRC-32 (IEEE 802.3) */
+static uint32_t crc32_bitwise(const uint8_t *data, size_t len, uint32_t crc)
+{
+	uint8_t i;
+
+	crc = ~crc;
+	while (len--) {
+		crc ^= *data++;
+		for (i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+	}
+
+	return ~crc;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	srand(1);
+	for (i = 0; i < BUF_SIZE; i++)
+		buf[i] = rand();
+}
+
+void tearDown(void) {}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_crc8_table(void)
+{
+	uint8_t table[NO_OS_CRC8_TABLE_SIZE];
+
+	no_os_crc8_populate_msb(table, CRC8_POLY);
+	TEST_ASSERT_EQUAL_MEMORY(table, crc8_table, sizeof(table));
+	no_os_crc8_populate_msb(table, CRC8_POLY_2);
+	TEST_ASSERT_EQUAL_MEMORY(table, crc8_table_2, sizeof(table));
+}
+
+void test_crc16_table(void)
+{
+	uint16_t table[NO_OS_CRC16_TABLE_SIZE];
+
+	no_os_crc16_populate_msb(table, CRC16_POLY);
+	TEST_ASSERT_EQUAL_MEMORY(table, crc16_table, sizeof(table));
+	no_os_crc16_populate_msb(table, CRC16_POLY_2);
+	TEST_ASSERT_EQUAL_MEMORY(table, crc16_table_2, sizeof(table));
+}
+
+void test_crc24_table(void)
+{
+	uint32_t table[NO_OS_CRC24_TABLE_SIZE];
+
+	no_os_crc24_populate_msb(table, CRC24_POLY);
+	TEST_ASSERT_EQUAL_MEMORY(table, crc24_table, sizeof(table));
+}
+
+void test_crc8_16_24_match_bitwise(void)
+{
+	uint32_t len;
+
+	for (len = 0; len <= 64; len++) {
+		TEST_ASSERT_EQUAL_HEX32(crc_bitwise(CRC8_POLY, 8, buf, len, 0),
+					no_os_crc8(crc8_table, buf, len, 0));
+		TEST_ASSERT_EQUAL_HEX32(crc_bitwise(CRC8_POLY_2, 8, buf, len, 0xFF),
+					no_os_crc8(crc8_table_2, buf, len, 0xFF));
+		TEST_ASSERT_EQUAL_HEX32(crc_bitwise(CRC16_POLY, 16, buf, len,
+						    0xFFFF),
+					no_os_crc16(crc16_table, buf, len, 0xFFFF));
+		TEST_ASSERT_EQUAL_HEX32(crc_bitwise(CRC16_POLY_2, 16, buf, len, 0),
+					no_os_crc16(crc16_table_2, buf, len, 0));
+		TEST_ASSERT_EQUAL_HEX32(crc_bitwise(CRC24_POLY, 24, buf, len,
+						    0xB704CE),
+					no_os_crc24(crc24_table, buf, len, 0xB704CE));
+	}
+}
+
+void test_crc32_check_value(void)
+{
+	const uint8_t check[] = "123456789";
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc32_bitwise(check, 9, 0));
+	for (i = 0; i < NO_OS_ARRAY_SIZE(crc32_impl); i++) {
+		TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc32_impl[i](check, 9, 0));
+		TEST_ASSERT_EQUAL_HEX32(0, crc32_impl[i](check, 0, 0));
+	}
+}
+
+void test_crc32_match_bitwise(void)
+{
+	uint32_t i, off, len;
+
+	/* All the lengths around the slice sizes, at all the alignments */
+	for (i = 0; i < NO_OS_ARRAY_SIZE(crc32_impl); i++)
+		for (off = 0; off < 8; off++)
+			for (len = 0; len <= 72; len++)
+				TEST_ASSERT_EQUAL_HEX32(
+					crc32_bitwise(buf + off, len, 0),
+					crc32_impl[i](buf + off, len, 0));
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(crc32_impl); i++)
+		TEST_ASSERT_EQUAL_HEX32(crc32_bitwise(buf, BUF_SIZE, 0),
+					crc32_impl[i](buf, BUF_SIZE, 0));
+}
+
+void test_crc32_cascade(void)
+{
+	uint32_t expected = crc32_bitwise(buf, BUF_SIZE, 0);
+	uint32_t i, split, crc;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(crc32_impl); i++)
+		for (split = 0; split <= BUF_SIZE; split += 37) {
+			crc = crc32_impl[i](buf, split, 0);
+			crc = crc32_impl[i](buf + split, BUF_SIZE - split, crc);
+			TEST_ASSERT_EQUAL_HEX32(expected, crc);
+		}
+}
@@ -0,0 +1,478 @@
+/***************************************************************************//**
+ *   @file   test_no_os_ilist.c
+ *   @brief  Unit tests and benchmarks of the intrusive lists and of the fifo.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_ilist.h"
+#include "no_os_list.h"
+#include "no_os_fifo.h"
+#include "no_os_alloc.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define NB_ITEMS	16
+#define NB_PRODUCERS	4
+#define MPSC_PER_PRODUCER	200000
+#ifdef NO_OS_TEST_BENCH
+#define BENCH_OPS	2000000
+#endif
+#define BENCH_DEPTH	8
+
+struct item {
+	uint32_t id;
+	uint32_t producer;
+	struct no_os_ilist_node node;
+};
+
+struct producer_ctx {
+	struct no_os_mpsc_queue *queue;
+	struct item *items;
+	uint32_t producer;
+	uint32_t count;
+};
+
+static struct item items[NB_ITEMS];
+static NO_OS_ILIST(list);
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	no_os_ilist_init(&list);
+	for (i = 0; i < NB_ITEMS; i++) {
+		items[i].id = i;
+		items[i].producer = 0;
+	}
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static uint32_t item_id(struct no_os_ilist_node *node)
+{
+	return no_os_ilist_entry(node, struct item, node)->id;
+}
+
+static int32_t item_cmp(const struct no_os_ilist_node *node,
+			const struct no_os_ilist_node *other)
+{
+	return (int32_t)(no_os_ilist_entry(node, struct item, node)->producer -
+			 no_os_ilist_entry(other, struct item, node)->producer);
+}
+
+#ifdef NO_OS_TEST_BENCH
+static void bench_report(const char *name, struct timespec *start)
+{
+	char msg[96];
+
+	snprintf(msg, sizeof(msg), "%s: %.1f M insert+remove/s", name,
+		 BENCH_OPS / bench_elapsed_s(start) / 1e6);
+	TEST_MESSAGE(msg);
+}
+#endif
+
+static void *mpsc_producer(void *arg)
+{
+	struct producer_ctx *ctx = arg;
+	uint32_t i;
+
+	for (i = 0; i < ctx->count; i++) {
+		ctx->items[i].producer = ctx->producer;
+		ctx->items[i].id = i;
+		no_os_mpsc_queue_push(ctx->queue, &ctx->items[i].node);
+		if (!(i % 1024))
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_ilist_queue(void)
+{
+	struct no_os_ilist_node *node;
+	uint32_t i;
+
+	TEST_ASSERT_TRUE(no_os_ilist_empty(&list));
+	TEST_ASSERT_NULL(no_os_ilist_get_first(&list));
+	TEST_ASSERT_NULL(no_os_ilist_first_entry(&list, struct item, node));
+
+	for (i = 0; i < NB_ITEMS; i++)
+		no_os_ilist_add_last(&list, &items[i].node);
+	TEST_ASSERT_EQUAL_UINT32(NB_ITEMS, no_os_ilist_count(&list));
+	TEST_ASSERT_EQUAL_UINT32(NB_ITEMS - 1, item_id(no_os_ilist_last(&list)));
+
+	for (i = 0; i < NB_ITEMS; i++) {
+		node = no_os_ilist_get_first(&list);
+		TEST_ASSERT_NOT_NULL(node);
+		TEST_ASSERT_EQUAL_UINT32(i, item_id(node));
+	}
+	TEST_ASSERT_TRUE(no_os_ilist_empty(&list));
+}
+
+void test_ilist_stack(void)
+{
+	struct item *it;
+	uint32_t i;
+
+	for (i = 0; i < NB_ITEMS; i++)
+		no_os_ilist_add_first(&list, &items[i].node);
+
+	for (i = NB_ITEMS; i > 0; i--) {
+		it = no_os_ilist_get_first_entry(&list, struct item, node);
+		TEST_ASSERT_NOT_NULL(it);
+		TEST_ASSERT_EQUAL_UINT32(i - 1, it->id);
+	}
+	TEST_ASSERT_NULL(no_os_ilist_get_last_entry(&list, struct item, node));
+}
+
+void test_ilist_del_iterate(void)
+{
+	struct no_os_ilist_node *node, *tmp;
+	struct item *it;
+	uint32_t i;
+
+	for (i = 0; i < NB_ITEMS; i++)
+		no_os_ilist_add_last(&list, &items[i].node);
+
+	/* Remove the odd items while iterating */
+	no_os_ilist_for_each_safe(node, tmp, &list)
+		if (item_id(node) & 1)
+			no_os_ilist_del(node);
+
+	i = 0;
+	no_os_ilist_for_each_entry(it, &list, node) {
+		TEST_ASSERT_EQUAL_UINT32(i, it->id);
+		i += 2;
+	}
+	TEST_ASSERT_EQUAL_UINT32(NB_ITEMS, i);
+
+	node = no_os_ilist_first(&list);
+	TEST_ASSERT_NULL(no_os_ilist_prev(&list, node));
+	TEST_ASSERT_EQUAL_UINT32(2, item_id(no_os_ilist_next(&list, node)));
+	node = no_os_ilist_last(&list);
+	TEST_ASSERT_NULL(no_os_ilist_next(&list, node));
+
+	no_os_ilist_insert_after(&items[0].node, &items[1].node);
+	no_os_ilist_insert_before(&items[0].node, &items[3].node);
+	TEST_ASSERT_EQUAL_UINT32(3, item_id(no_os_ilist_get_first(&list)));
+	TEST_ASSERT_EQUAL_UINT32(0, item_id(no_os_ilist_get_first(&list)));
+	TEST_ASSERT_EQUAL_UINT32(1, item_id(no_os_ilist_get_first(&list)));
+}
+
+void test_ilist_splice_sorted(void)
+{
+	NO_OS_ILIST(other);
+	uint32_t i;
+
+	/* Keys 3, 2, 1, 0, 3, 2, ... inserted in order of id */
+	for (i = 0; i < NB_ITEMS; i++) {
+		items[i].producer = 3 - i % 4;
+		no_os_ilist_add_sorted(&other, &items[i].node, item_cmp);
+	}
+
+	no_os_ilist_splice_last(&list, &other);
+	TEST_ASSERT_TRUE(no_os_ilist_empty(&other));
+	TEST_ASSERT_EQUAL_UINT32(NB_ITEMS, no_os_ilist_count(&list));
+
+	/* Sorted by key, equal keys in insertion order */
+	TEST_ASSERT_EQUAL_UINT32(3, item_id(no_os_ilist_get_first(&list)));
+	TEST_ASSERT_EQUAL_UINT32(7, item_id(no_os_ilist_get_first(&list)));
+	TEST_ASSERT_EQUAL_UINT32(11, item_id(no_os_ilist_get_first(&list)));
+	TEST_ASSERT_EQUAL_UINT32(15, item_id(no_os_ilist_get_first(&list)));
+	TEST_ASSERT_EQUAL_UINT32(2, item_id(no_os_ilist_get_first(&list)));
+	TEST_ASSERT_EQUAL_UINT32(12, item_id(no_os_ilist_get_last(&list)));
+}
+
+void test_mpsc_queue_order(void)
+{
+	struct no_os_mpsc_queue queue;
+	struct item *it;
+	uint32_t i;
+
+	no_os_mpsc_queue_init(&queue);
+	TEST_ASSERT_TRUE(no_os_mpsc_queue_empty(&queue));
+	TEST_ASSERT_NULL(no_os_mpsc_queue_pop(&queue));
+
+	for (i = 0; i < NB_ITEMS; i++)
+		no_os_mpsc_queue_push(&queue, &items[i].node);
+	TEST_ASSERT_TRUE(!no_os_mpsc_queue_empty(&queue));
+
+	/* Nodes can be pushed again once popped */
+	for (i = 0; i < 3 * NB_ITEMS; i++) {
+		it = no_os_mpsc_queue_pop_entry(&queue, struct item, node);
+		TEST_ASSERT_NOT_NULL(it);
+		TEST_ASSERT_EQUAL_UINT32(i % NB_ITEMS, it->id);
+		no_os_mpsc_queue_push(&queue, &it->node);
+	}
+
+	for (i = 0; i < NB_ITEMS; i++)
+		TEST_ASSERT_NOT_NULL(no_os_mpsc_queue_pop(&queue));
+	TEST_ASSERT_NULL(no_os_mpsc_queue_pop(&queue));
+	TEST_ASSERT_TRUE(no_os_mpsc_queue_empty(&queue));
+}
+
+void test_mpsc_queue_threads(void)
+{
+	static struct item pool[NB_PRODUCERS][MPSC_PER_PRODUCER];
+	struct producer_ctx ctx[NB_PRODUCERS];
+	uint32_t next[NB_PRODUCERS] = {0};
+	pthread_t threads[NB_PRODUCERS];
+	struct no_os_mpsc_queue queue;
+	uint32_t received = 0;
+	uint32_t errors = 0;
+	struct item *it;
+	uint32_t i;
+
+	no_os_mpsc_queue_init(&queue);
+	for (i = 0; i < NB_PRODUCERS; i++) {
+		ctx[i].queue = &queue;
+		ctx[i].items = pool[i];
+		ctx[i].producer = i;
+		ctx[i].count = MPSC_PER_PRODUCER;
+		TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL,
+							mpsc_producer, &ctx[i]));
+	}
+
+	while (received < NB_PRODUCERS * MPSC_PER_PRODUCER) {
+		it = no_os_mpsc_queue_pop_entry(&queue, struct item, node);
+		if (!it) {
+			sched_yield();
+			continue;
+		}
+		/* The order of each producer is kept */
+		if (it->producer >= NB_PRODUCERS || it->id != next[it->producer])
+			errors++;
+		else
+			next[it->producer]++;
+		received++;
+	}
+
+	for (i = 0; i < NB_PRODUCERS; i++)
+		pthread_join(threads[i], NULL);
+
+	TEST_ASSERT_EQUAL_UINT32(0, errors);
+	TEST_ASSERT_NULL(no_os_mpsc_queue_pop(&queue));
+}
+
+void test_fifo(void)
+{
+	struct no_os_fifo_element *el;
+	struct no_os_fifo *fifo;
+	char buf[8];
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_fifo_init(&fifo, 0, 0, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_fifo_init(&fifo, 8, 4, 2));
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_init(&fifo, sizeof(buf), 1, 3));
+	TEST_ASSERT_NULL(no_os_fifo_read(fifo));
+
+	for (i = 0; i < 3; i++) {
+		memset(buf, 'a' + i, sizeof(buf));
+		TEST_ASSERT_EQUAL_INT(0, no_os_fifo_insert(fifo, buf, i + 1));
+	}
+	TEST_ASSERT_EQUAL_INT(-ENOMEM, no_os_fifo_insert(fifo, buf, 1));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_fifo_insert(fifo, buf, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_fifo_insert(fifo, buf,
+			      sizeof(buf) + 1));
+
+	for (i = 0; i < 3; i++) {
+		el = no_os_fifo_read(fifo);
+		TEST_ASSERT_NOT_NULL(el);
+		TEST_ASSERT_EQUAL_UINT32(i + 1, el->len);
+		TEST_ASSERT_EQUAL_UINT8('a' + i, el->data[i]);
+		no_os_fifo_release(fifo);
+	}
+	TEST_ASSERT_NULL(no_os_fifo_read(fifo));
+	no_os_fifo_release(fifo);
+	TEST_ASSERT_EQUAL_UINT32(3, fifo->nb_elements);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_insert(fifo, buf, 1));
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_remove(fifo));
+}
+
+void test_fifo_steady_state_no_alloc(void)
+{
+	struct no_os_alloc_stats before, after;
+	struct no_os_fifo *fifo;
+	char buf[64] = {0};
+	uint32_t i, j;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_init(&fifo, sizeof(buf), 2, 0));
+
+	/* Grow to the working depth once */
+	for (j = 0; j < BENCH_DEPTH; j++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_fifo_insert(fifo, buf,
+				      sizeof(buf)));
+	for (j = 0; j < BENCH_DEPTH; j++)
+		no_os_fifo_release(fifo);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&before));
+	for (i = 0; i < 10000; i++) {
+		for (j = 0; j < 1 + i % BENCH_DEPTH; j++)
+			TEST_ASSERT_EQUAL_INT(0, no_os_fifo_insert(fifo, buf,
+					      1 + j));
+		for (j = 0; j < 1 + i % BENCH_DEPTH; j++) {
+			TEST_ASSERT_EQUAL_UINT32(1 + j,
+						 no_os_fifo_read(fifo)->len);
+			no_os_fifo_release(fifo);
+		}
+	}
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&after));
+
+	TEST_ASSERT_EQUAL_UINT32(before.nb_allocs, after.nb_allocs);
+	TEST_ASSERT_EQUAL_UINT32(before.nb_frees, after.nb_frees);
+	TEST_ASSERT_EQUAL_UINT32(BENCH_DEPTH, fifo->nb_elements);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_remove(fifo));
+}
+
+#ifdef NO_OS_TEST_BENCH
+void test_bench_ilist_vs_list(void)
+{
+	struct no_os_alloc_stats before, after;
+	struct no_os_list_desc *queue;
+	struct timespec start;
+	struct item *it;
+	void *data;
+	uint32_t i;
+
+	/* Keep BENCH_DEPTH elements queued, move one per operation */
+	TEST_ASSERT_EQUAL_INT(0, no_os_list_init(&queue, NO_OS_LIST_QUEUE,
+			      NULL));
+	for (i = 0; i < BENCH_DEPTH; i++)
+		TEST_ASSERT_EQUAL_INT(0, queue->push(queue, &items[i]));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&before));
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_OPS; i++) {
+		queue->pop(queue, &data);
+		queue->push(queue, data);
+	}
+	bench_report("no_os_list queue", &start);
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&after));
+	/* One allocation per insert */
+	TEST_ASSERT_EQUAL_UINT32(BENCH_OPS, after.nb_allocs - before.nb_allocs);
+
+	while (!queue->pop(queue, &data))
+		;
+	no_os_list_remove(queue);
+
+	for (i = 0; i < BENCH_DEPTH; i++)
+		no_os_ilist_add_last(&list, &items[i].node);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&before));
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_OPS; i++) {
+		it = no_os_ilist_get_first_entry(&list, struct item, node);
+		no_os_ilist_add_last(&list, &it->node);
+	}
+	bench_report("no_os_ilist queue", &start);
+	TEST_ASSERT_EQUAL_INT(0, no_os_alloc_get_stats(&after));
+	TEST_ASSERT_EQUAL_UINT32(before.nb_allocs, after.nb_allocs);
+	TEST_ASSERT_EQUAL_UINT32(BENCH_DEPTH, no_os_ilist_count(&list));
+}
+
+void test_bench_mpsc_queue(void)
+{
+	struct no_os_mpsc_queue queue;
+	struct no_os_ilist_node *node;
+	struct timespec start;
+	uint32_t i;
+
+	no_os_mpsc_queue_init(&queue);
+	for (i = 0; i < BENCH_DEPTH; i++)
+		no_os_mpsc_queue_push(&queue, &items[i].node);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_OPS; i++) {
+		node = no_os_mpsc_queue_pop(&queue);
+		no_os_mpsc_queue_push(&queue, node);
+	}
+	bench_report("no_os_mpsc_queue", &start);
+}
+
+void test_bench_fifo(void)
+{
+	struct no_os_fifo *fifo;
+	struct timespec start;
+	char buf[16] = {0};
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_init(&fifo, sizeof(buf),
+			      BENCH_DEPTH, 0));
+	for (i = 0; i < BENCH_DEPTH - 1; i++)
+		no_os_fifo_insert(fifo, buf, sizeof(buf));
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BENCH_OPS; i++) {
+		no_os_fifo_insert(fifo, buf, sizeof(buf));
+		no_os_fifo_release(fifo);
+	}
+	bench_report("no_os_fifo 16 bytes", &start);
+
+	TEST_ASSERT_EQUAL_UINT32(BENCH_DEPTH, fifo->nb_elements);
+	TEST_ASSERT_EQUAL_INT(0, no_os_fifo_remove(fifo));
+}
+#endif
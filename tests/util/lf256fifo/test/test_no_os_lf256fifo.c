@@ -0,0 +1,359 @@
+/***************************************************************************//**
+ *   @file   test_no_os_lf256fifo.c
+ *   @brief  Unit tests and host benchmark of the lock-free fifo.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_lf256fifo.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef NO_OS_TEST_BENCH
+#include "bench.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/* Bytes moved by the stress test */
+#define STRESS_BYTES		(64 * 1024 * 1024)
+/* 3 Mbaud, 8N1 */
+#define UART_BYTES_PER_S	300000
+/* Bytes moved into the fifo by one RX interrupt (hardware FIFO depth) */
+#define UART_BURST		16
+/* Duration of the simulated UART stream */
+#define UART_DURATION_MS	500
+/* Time between two reads of the application */
+#define UART_POLL_US		2000
+
+struct stream_ctx {
+	struct lf256fifo *fifo;
+	/* Stop writing when the fifo is full */
+	bool backpressure;
+	/* Simulated UART instead of a full speed producer */
+	bool paced;
+	bool done;
+	uint64_t sent;
+};
+
+static uint8_t tx[1024], rx[1024];
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < sizeof(tx); i++)
+		tx[i] = i * 7 + 1;
+	memset(rx, 0, sizeof(rx));
+}
+
+void tearDown(void)
+{
+}
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static uint64_t now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000ull + ts.tv_nsec / 1000;
+}
+
+/* Write a byte counter, as fast as possible or at the rate of the UART */
+static void *stream_producer(void *arg)
+{
+	struct stream_ctx *ctx = arg;
+	uint64_t start = now_us();
+	uint64_t total, due;
+	uint8_t chunk[255];
+	uint32_t i, nb, n = 0;
+	uint8_t *buf;
+
+	if (ctx->paced)
+		total = (uint64_t)UART_BYTES_PER_S * UART_DURATION_MS / 1000;
+	else
+		total = STRESS_BYTES;
+
+	while (ctx->sent < total) {
+		if (ctx->paced) {
+			due = (now_us() - start) * UART_BYTES_PER_S / 1000000;
+			if (due < ctx->sent + UART_BURST) {
+				usleep(50);
+				continue;
+			}
+			nb = UART_BURST;
+		} else {
+			/* Awkward sizes to hit all the wrap cases */
+			nb = 1 + (n++ * 37) % sizeof(chunk);
+		}
+		nb = no_os_min(nb, total - ctx->sent);
+
+		if (ctx->backpressure) {
+			/* Write in place what fits */
+			nb = no_os_min(nb, lf256fifo_peek_write(ctx->fifo, &buf));
+			for (i = 0; i < nb; i++)
+				buf[i] = ctx->sent + i;
+			lf256fifo_commit_write(ctx->fifo, nb);
+			if (!nb)
+				sched_yield();
+		} else {
+			for (i = 0; i < nb; i++)
+				chunk[i] = ctx->sent + i;
+			lf256fifo_write_n(ctx->fifo, chunk, nb);
+		}
+		ctx->sent += nb;
+	}
+	__atomic_store_n(&ctx->done, true, __ATOMIC_RELEASE);
+
+	return NULL;
+}
+
+/*
+ * Read until the producer is done, byte per byte or in bulk.
+ * Return the number of bytes read, check the sequence if nothing was dropped.
+ */
+static uint64_t stream_consume(struct stream_ctx *ctx, bool bulk)
+{
+	uint64_t received = 0;
+	uint8_t next = 0;
+	uint32_t i, nb;
+	bool done;
+
+	while (true) {
+		done = __atomic_load_n(&ctx->done, __ATOMIC_ACQUIRE);
+		if (bulk) {
+			nb = lf256fifo_read_n(ctx->fifo, rx, sizeof(rx));
+		} else {
+			for (nb = 0; nb < sizeof(rx); nb++)
+				if (lf256fifo_read(ctx->fifo, &rx[nb]))
+					break;
+		}
+		if (!nb) {
+			if (done)
+				break;
+			if (ctx->paced)
+				usleep(UART_POLL_US);
+			else
+				sched_yield();
+			continue;
+		}
+
+		if (ctx->backpressure)
+			for (i = 0; i < nb; i++, next++)
+				TEST_ASSERT_EQUAL_UINT8(next, rx[i]);
+		received += nb;
+	}
+
+	return received;
+}
+
+static void stream_run(uint32_t fifo_size, bool paced, bool bulk)
+{
+	struct stream_ctx ctx = {
+		.backpressure = !paced,
+		.paced = paced,
+	};
+	pthread_t producer;
+	uint64_t received;
+#ifdef NO_OS_TEST_BENCH
+	struct timespec start;
+	char msg[128];
+	double t;
+#endif
+
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_init_size(&ctx.fifo, fifo_size));
+#ifdef NO_OS_TEST_BENCH
+	clock_gettime(CLOCK_MONOTONIC, &start);
+#endif
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL,
+						stream_producer, &ctx));
+	received = stream_consume(&ctx, bulk);
+	pthread_join(producer, NULL);
+
+	/* Every byte is either read or counted as dropped */
+	TEST_ASSERT_EQUAL_UINT64(ctx.sent, received +
+				 lf256fifo_get_overflows(ctx.fifo));
+	if (!paced)
+		TEST_ASSERT_EQUAL_UINT32(0, lf256fifo_get_overflows(ctx.fifo));
+
+#ifdef NO_OS_TEST_BENCH
+	t = bench_elapsed_s(&start);
+	snprintf(msg, sizeof(msg), "%s, %u bytes fifo, %s reads: %.0f bytes/s, "
+		 "%u bytes dropped", paced ? "3 Mbaud UART" : "full speed",
+		 fifo_size, bulk ? "bulk" : "byte", received / t,
+		 lf256fifo_get_overflows(ctx.fifo));
+	TEST_MESSAGE(msg);
+#endif
+
+	lf256fifo_remove(ctx.fifo);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_lf256fifo_init(void)
+{
+	struct lf256fifo *fifo;
+	uint8_t *buf;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, lf256fifo_init(NULL));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, lf256fifo_init_size(&fifo, 100));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, lf256fifo_init_size(&fifo, 0x80000001));
+
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_init_size(&fifo, 0));
+	TEST_ASSERT_TRUE(lf256fifo_is_empty(fifo));
+	TEST_ASSERT_EQUAL_UINT32(LF256FIFO_DEFAULT_SIZE,
+				 lf256fifo_peek_write(fifo, &buf));
+	lf256fifo_remove(fifo);
+}
+
+void test_lf256fifo_byte(void)
+{
+	struct lf256fifo *fifo;
+	uint32_t i;
+	uint8_t c;
+
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_init(&fifo));
+	TEST_ASSERT_EQUAL_INT(-1, lf256fifo_read(fifo, &c));
+
+	for (i = 0; i < LF256FIFO_DEFAULT_SIZE; i++)
+		TEST_ASSERT_EQUAL_INT(0, lf256fifo_write(fifo, tx[i]));
+	TEST_ASSERT_TRUE(lf256fifo_is_full(fifo));
+	TEST_ASSERT_EQUAL_INT(-1, lf256fifo_write(fifo, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, lf256fifo_get_overflows(fifo));
+
+	for (i = 0; i < LF256FIFO_DEFAULT_SIZE; i++) {
+		TEST_ASSERT_EQUAL_INT(0, lf256fifo_read(fifo, &c));
+		TEST_ASSERT_EQUAL_UINT8(tx[i], c);
+	}
+	TEST_ASSERT_TRUE(lf256fifo_is_empty(fifo));
+
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_write(fifo, 5));
+	lf256fifo_flush(fifo);
+	TEST_ASSERT_TRUE(lf256fifo_is_empty(fifo));
+
+	lf256fifo_remove(fifo);
+}
+
+void test_lf256fifo_bulk(void)
+{
+	struct lf256fifo *fifo;
+
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_init_size(&fifo, 64));
+
+	TEST_ASSERT_EQUAL_UINT32(40, lf256fifo_write_n(fifo, tx, 40));
+	TEST_ASSERT_EQUAL_UINT32(30, lf256fifo_read_n(fifo, rx, 30));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(tx, rx, 30);
+
+	/* Wrap around the end of the fifo and drop what doesn't fit */
+	TEST_ASSERT_EQUAL_UINT32(54, lf256fifo_write_n(fifo, tx + 40, 60));
+	TEST_ASSERT_EQUAL_UINT32(6, lf256fifo_get_overflows(fifo));
+	TEST_ASSERT_EQUAL_UINT32(64, lf256fifo_level(fifo));
+	TEST_ASSERT_EQUAL_UINT32(64, lf256fifo_read_n(fifo, rx + 30, 100));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(tx, rx, 94);
+	TEST_ASSERT_EQUAL_UINT32(0, lf256fifo_read_n(fifo, rx, 100));
+
+	lf256fifo_remove(fifo);
+}
+
+void test_lf256fifo_peek_commit(void)
+{
+	struct lf256fifo *fifo;
+	uint8_t *buf;
+
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_init_size(&fifo, 64));
+	TEST_ASSERT_EQUAL_UINT32(0, lf256fifo_peek_read(fifo, &buf));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, lf256fifo_commit_read(fifo, 1));
+
+	TEST_ASSERT_EQUAL_UINT32(50, lf256fifo_write_n(fifo, tx, 50));
+	TEST_ASSERT_EQUAL_UINT32(50, lf256fifo_read_n(fifo, rx, 50));
+
+	/* Free space is split by the end of the fifo */
+	TEST_ASSERT_EQUAL_UINT32(14, lf256fifo_peek_write(fifo, &buf));
+	memcpy(buf, tx, 14);
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_commit_write(fifo, 14));
+	TEST_ASSERT_EQUAL_UINT32(50, lf256fifo_peek_write(fifo, &buf));
+	memcpy(buf, tx + 14, 20);
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_commit_write(fifo, 20));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, lf256fifo_commit_write(fifo, 31));
+
+	TEST_ASSERT_EQUAL_UINT32(14, lf256fifo_peek_read(fifo, &buf));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(tx, buf, 14);
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_commit_read(fifo, 14));
+	TEST_ASSERT_EQUAL_UINT32(20, lf256fifo_peek_read(fifo, &buf));
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(tx + 14, buf, 20);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, lf256fifo_commit_read(fifo, 21));
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_commit_read(fifo, 20));
+	TEST_ASSERT_TRUE(lf256fifo_is_empty(fifo));
+
+	lf256fifo_remove(fifo);
+}
+
+void test_lf256fifo_stress(void)
+{
+	stream_run(256, false, false);
+	stream_run(4096, false, true);
+}
+
+#ifdef NO_OS_TEST_BENCH
+void test_lf256fifo_uart_benchmark(void)
+{
+	stream_run(256, true, false);
+	stream_run(256, true, true);
+	stream_run(4096, true, true);
+}
+#endif
@@ -0,0 +1,581 @@
+/***************************************************************************//**
+ *   @file   test_no_os_regmap.c
+ *   @brief  Unit tests of the register map cache and of its SPI and I2C backends.
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_regmap.h"
+#include "no_os_alloc.h"
+#include "no_os_i2c.h"
+#include "no_os_mutex.h"
+#include "no_os_spi.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define FAKE_NB_REGS		0x40
+#define FAKE_LOG_LEN		64
+
+#define FAKE_READ_FLAG		0x8000
+
+/*
+ * Model of a device which counts the bus transactions and logs the registers
+ * written, in order.
+ */
+struct fake_dev {
+	uint32_t regs[FAKE_NB_REGS];
+	uint32_t reads;
+	uint32_t writes;
+	uint32_t sync_begins;
+	uint32_t sync_ends;
+	uint32_t log[FAKE_LOG_LEN];
+	uint32_t nb_log;
+	/* SPI backend */
+	uint32_t spi_transfers;
+	uint32_t spi_msgs;
+	uint8_t last_frame[NO_OS_REGMAP_MAX_BYTES];
+	/* I2C backend */
+	uint32_t i2c_ptr;
+	uint8_t i2c_stops[FAKE_LOG_LEN];
+	uint32_t i2c_ops;
+};
+
+static struct fake_dev fake;
+
+/* 0x10 - 0x13 are volatile, 0x30 - 0x3F are write only */
+static const struct no_os_regmap_range fake_rd_table[] = {
+	{ .min = 0x00, .max = 0x2F },
+};
+
+static const struct no_os_regmap_range fake_volatile_table[] = {
+	{ .min = 0x10, .max = 0x13 },
+};
+
+static const struct no_os_regmap_config fake_config = {
+	.max_register = FAKE_NB_REGS - 1,
+	.rd_table = fake_rd_table,
+	.rd_table_len = NO_OS_ARRAY_SIZE(fake_rd_table),
+	.volatile_table = fake_volatile_table,
+	.volatile_table_len = NO_OS_ARRAY_SIZE(fake_volatile_table),
+	.cache_type = NO_OS_REGMAP_CACHE_FLAT,
+};
+
+static struct no_os_regmap *map;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static void fake_log_write(uint32_t reg, uint32_t val)
+{
+	TEST_ASSERT_TRUE(reg < FAKE_NB_REGS);
+	TEST_ASSERT_TRUE(fake.nb_log < FAKE_LOG_LEN);
+	fake.regs[reg] = val;
+	fake.log[fake.nb_log++] = reg;
+	fake.writes++;
+}
+
+static int32_t fake_reg_read(void *ctx, uint32_t reg, uint32_t *val)
+{
+	TEST_ASSERT_EQUAL_PTR(&fake, ctx);
+	TEST_ASSERT_TRUE(reg < FAKE_NB_REGS);
+	fake.reads++;
+	*val = fake.regs[reg];
+
+	return 0;
+}
+
+static int32_t fake_reg_write(void *ctx, uint32_t reg, uint32_t val)
+{
+	TEST_ASSERT_EQUAL_PTR(&fake, ctx);
+	fake_log_write(reg, val);
+
+	return 0;
+}
+
+static int32_t fake_sync_begin(void *ctx)
+{
+	fake.sync_begins++;
+
+	return 0;
+}
+
+static int32_t fake_sync_end(void *ctx)
+{
+	fake.sync_ends++;
+
+	return 0;
+}
+
+static const struct no_os_regmap_bus_ops fake_ops = {
+	.reg_read = fake_reg_read,
+	.reg_write = fake_reg_write,
+	.sync_begin = fake_sync_begin,
+	.sync_end = fake_sync_end,
+};
+
+/* 16 bit address with the read flag, 8 bit value */
+static int32_t fake_spi_init(struct no_os_spi_desc **desc,
+			     const struct no_os_spi_init_param *param)
+{
+	*desc = calloc(1, sizeof(**desc));
+
+	return *desc ? 0 : -ENOMEM;
+}
+
+static void fake_spi_frame(uint8_t *data, uint16_t bytes_number)
+{
+	uint16_t addr;
+
+	TEST_ASSERT_EQUAL_UINT16(3, bytes_number);
+	memcpy(fake.last_frame, data, bytes_number);
+	addr = no_os_get_unaligned_be16(data);
+	if (addr & FAKE_READ_FLAG) {
+		TEST_ASSERT_TRUE((addr & ~FAKE_READ_FLAG) < FAKE_NB_REGS);
+		fake.reads++;
+		data[2] = fake.regs[addr & ~FAKE_READ_FLAG];
+		return;
+	}
+
+	fake_log_write(addr, data[2]);
+}
+
+static int32_t fake_spi_write_and_read(struct no_os_spi_desc *desc,
+				       uint8_t *data, uint16_t bytes_number)
+{
+	fake_spi_frame(data, bytes_number);
+
+	return 0;
+}
+
+static int32_t fake_spi_transfer(struct no_os_spi_desc *desc,
+				 struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+
+	fake.spi_transfers++;
+	for (i = 0; i < len; i++) {
+		TEST_ASSERT_EQUAL_UINT8(1, msgs[i].cs_change);
+		fake_spi_frame(msgs[i].tx_buff, msgs[i].bytes_number);
+		fake.spi_msgs++;
+	}
+
+	return 0;
+}
+
+static int32_t fake_spi_remove(struct no_os_spi_desc *desc)
+{
+	free(desc);
+
+	return 0;
+}
+
+static const struct no_os_spi_platform_ops fake_spi_ops = {
+	.init = fake_spi_init,
+	.write_and_read = fake_spi_write_and_read,
+	.transfer = fake_spi_transfer,
+	.remove = fake_spi_remove,
+};
+
+/* 8 bit address, 16 bit big endian value */
+static int32_t fake_i2c_init(struct no_os_i2c_desc **desc,
+			     const struct no_os_i2c_init_param *param)
+{
+	*desc = calloc(1, sizeof(**desc));
+
+	return *desc ? 0 : -ENOMEM;
+}
+
+static int32_t fake_i2c_write(struct no_os_i2c_desc *desc, uint8_t *data,
+			      uint8_t bytes_number, uint8_t stop_bit)
+{
+	TEST_ASSERT_TRUE(fake.i2c_ops < FAKE_LOG_LEN);
+	fake.i2c_stops[fake.i2c_ops++] = stop_bit;
+	TEST_ASSERT_TRUE(data[0] < FAKE_NB_REGS);
+	fake.i2c_ptr = data[0];
+	if (bytes_number == 1)
+		return 0;
+
+	TEST_ASSERT_EQUAL_UINT8(3, bytes_number);
+	fake_log_write(data[0], no_os_get_unaligned_be16(&data[1]));
+
+	return 0;
+}
+
+static int32_t fake_i2c_read(struct no_os_i2c_desc *desc, uint8_t *data,
+			     uint8_t bytes_number, uint8_t stop_bit)
+{
+	TEST_ASSERT_TRUE(fake.i2c_ops < FAKE_LOG_LEN);
+	fake.i2c_stops[fake.i2c_ops++] = stop_bit;
+	TEST_ASSERT_EQUAL_UINT8(2, bytes_number);
+	fake.reads++;
+	no_os_put_unaligned_be16(fake.regs[fake.i2c_ptr], data);
+
+	return 0;
+}
+
+static int32_t fake_i2c_remove(struct no_os_i2c_desc *desc)
+{
+	free(desc);
+
+	return 0;
+}
+
+static const struct no_os_i2c_platform_ops fake_i2c_ops = {
+	.i2c_ops_init = fake_i2c_init,
+	.i2c_ops_write = fake_i2c_write,
+	.i2c_ops_read = fake_i2c_read,
+	.i2c_ops_remove = fake_i2c_remove,
+};
+
+static void fake_regmap_init(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_init(&map, &fake_ops, &fake,
+			      &fake_config));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&fake, 0, sizeof(fake));
+	map = NULL;
+}
+
+void tearDown(void)
+{
+	if (map)
+		no_os_regmap_remove(map);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_regmap_read_cache_hit(void)
+{
+	uint32_t val;
+
+	fake.regs[0x05] = 0xA5;
+	fake_regmap_init();
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x05, &val));
+	TEST_ASSERT_EQUAL_HEX32(0xA5, val);
+	TEST_ASSERT_EQUAL_UINT32(1, fake.reads);
+
+	/* A cached register is never read again from the device */
+	fake.regs[0x05] = 0x00;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x05, &val));
+	TEST_ASSERT_EQUAL_HEX32(0xA5, val);
+	TEST_ASSERT_EQUAL_UINT32(1, fake.reads);
+	TEST_ASSERT_EQUAL_UINT32(1, map->stats.bus_reads);
+	TEST_ASSERT_EQUAL_UINT32(1, map->stats.cache_hits);
+}
+
+void test_regmap_volatile_bypasses_cache(void)
+{
+	uint32_t val, i;
+
+	fake_regmap_init();
+
+	for (i = 0; i < 3; i++) {
+		fake.regs[0x11] = i;
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x11, &val));
+		TEST_ASSERT_EQUAL_UINT32(i, val);
+	}
+	TEST_ASSERT_EQUAL_UINT32(3, fake.reads);
+	TEST_ASSERT_EQUAL_UINT32(0, map->stats.cache_hits);
+
+	/* Neither does a write of a volatile register fill the cache */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x11, 0x42));
+	fake.regs[0x11] = 0x43;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x11, &val));
+	TEST_ASSERT_EQUAL_HEX32(0x43, val);
+	TEST_ASSERT_EQUAL_UINT32(4, fake.reads);
+}
+
+void test_regmap_write_through(void)
+{
+	uint32_t val;
+
+	fake_regmap_init();
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x07, 0x3C));
+	TEST_ASSERT_EQUAL_UINT32(1, fake.writes);
+	TEST_ASSERT_EQUAL_HEX32(0x3C, fake.regs[0x07]);
+
+	/* The written value is cached, no read is needed */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x07, &val));
+	TEST_ASSERT_EQUAL_HEX32(0x3C, val);
+	TEST_ASSERT_EQUAL_UINT32(0, fake.reads);
+
+	/* Writing the same value again still reaches the device */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x07, 0x3C));
+	TEST_ASSERT_EQUAL_UINT32(2, fake.writes);
+}
+
+void test_regmap_cache_drop_after_reset(void)
+{
+	uint32_t val;
+
+	fake_regmap_init();
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x02, 0x11));
+	no_os_regmap_cache_only(map, true);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x03, 0x22));
+	no_os_regmap_cache_only(map, false);
+
+	/* Device reset: the registers return to their default */
+	memset(fake.regs, 0, sizeof(fake.regs));
+	fake.regs[0x02] = 0x80;
+	no_os_regmap_cache_drop(map);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x02, &val));
+	TEST_ASSERT_EQUAL_HEX32(0x80, val);
+	TEST_ASSERT_EQUAL_UINT32(1, fake.reads);
+
+	/* The value deferred before the reset is not written back */
+	fake.nb_log = 0;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_sync(map));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.nb_log);
+	TEST_ASSERT_EQUAL_HEX32(0, fake.regs[0x03]);
+}
+
+void test_regmap_update_bits(void)
+{
+	uint32_t val;
+
+	fake.regs[0x08] = 0xF0;
+	fake_regmap_init();
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(map, 0x08, 0x0F,
+			      0x05));
+	TEST_ASSERT_EQUAL_UINT32(1, fake.reads);
+	TEST_ASSERT_EQUAL_UINT32(1, fake.writes);
+	TEST_ASSERT_EQUAL_HEX32(0xF5, fake.regs[0x08]);
+
+	/* Read from the cache, unchanged value not written */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(map, 0x08, 0x0F,
+			      0x05));
+	TEST_ASSERT_EQUAL_UINT32(1, fake.reads);
+	TEST_ASSERT_EQUAL_UINT32(1, fake.writes);
+	TEST_ASSERT_EQUAL_UINT32(1, map->stats.skipped_writes);
+
+	/* A change is written without reading the device again */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(map, 0x08, 0xF0,
+			      0x30));
+	TEST_ASSERT_EQUAL_UINT32(1, fake.reads);
+	TEST_ASSERT_EQUAL_UINT32(2, fake.writes);
+	TEST_ASSERT_EQUAL_HEX32(0x35, fake.regs[0x08]);
+
+	/* A volatile register is always read and written */
+	fake.regs[0x12] = 0x01;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(map, 0x12, 0x01,
+			      0x01));
+	TEST_ASSERT_EQUAL_UINT32(2, fake.reads);
+	TEST_ASSERT_EQUAL_UINT32(3, fake.writes);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x08, &val));
+	TEST_ASSERT_EQUAL_HEX32(0x35, val);
+}
+
+void test_regmap_sync_writes_dirty_in_order(void)
+{
+	static const uint32_t regs[] = { 0x21, 0x01, 0x3F, 0x1F, 0x20 };
+	static const uint32_t sorted[] = { 0x01, 0x1F, 0x20, 0x21, 0x3F };
+	uint32_t i;
+
+	fake_regmap_init();
+
+	no_os_regmap_cache_only(map, true);
+	for (i = 0; i < NO_OS_ARRAY_SIZE(regs); i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, regs[i],
+				      0x10 + i));
+	/* Written twice, sent once with the last value */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x01, 0x99));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.writes);
+	no_os_regmap_cache_only(map, false);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_sync(map));
+	TEST_ASSERT_EQUAL_UINT32(1, fake.sync_begins);
+	TEST_ASSERT_EQUAL_UINT32(1, fake.sync_ends);
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_ARRAY_SIZE(sorted), fake.nb_log);
+	for (i = 0; i < NO_OS_ARRAY_SIZE(sorted); i++)
+		TEST_ASSERT_EQUAL_HEX32(sorted[i], fake.log[i]);
+	TEST_ASSERT_EQUAL_HEX32(0x99, fake.regs[0x01]);
+	TEST_ASSERT_EQUAL_HEX32(0x14, fake.regs[0x20]);
+
+	/* Nothing left to write */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_sync(map));
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_ARRAY_SIZE(sorted), fake.nb_log);
+}
+
+void test_regmap_access_tables(void)
+{
+	uint32_t val;
+
+	fake_regmap_init();
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_regmap_read(map, FAKE_NB_REGS,
+			      &val));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_regmap_write(map, FAKE_NB_REGS,
+			      0));
+	TEST_ASSERT_EQUAL_INT(-EPERM, no_os_regmap_read(map, 0x30, &val));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.reads);
+
+	/* A write only register reads back the cached value */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x30, 0x5A));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x30, &val));
+	TEST_ASSERT_EQUAL_HEX32(0x5A, val);
+	TEST_ASSERT_EQUAL_UINT32(0, fake.reads);
+}
+
+void test_regmap_cache_none(void)
+{
+	struct no_os_regmap_config config = fake_config;
+	uint32_t val;
+
+	config.cache_type = NO_OS_REGMAP_CACHE_NONE;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_init(&map, &fake_ops, &fake,
+			      &config));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x05, &val));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x05, &val));
+	TEST_ASSERT_EQUAL_UINT32(2, fake.reads);
+
+	/* No cache to defer the writes to */
+	no_os_regmap_cache_only(map, true);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x05, 0x01));
+	TEST_ASSERT_EQUAL_UINT32(1, fake.writes);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_sync(map));
+	TEST_ASSERT_EQUAL_UINT32(0, fake.sync_begins);
+}
+
+void test_regmap_spi_backend(void)
+{
+	struct no_os_spi_init_param spi_param = {
+		.max_speed_hz = 1000000,
+		.mode = NO_OS_SPI_MODE_0,
+		.platform_ops = &fake_spi_ops,
+	};
+	struct no_os_regmap_config config = fake_config;
+	struct no_os_spi_desc *spi;
+	uint32_t val, i;
+
+	config.reg_bits = 16;
+	config.val_bits = 8;
+	config.read_flag_mask = FAKE_READ_FLAG;
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_init(&spi, &spi_param));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_init_spi(&map, spi, &config));
+
+	fake.regs[0x2A] = 0x6B;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x2A, &val));
+	TEST_ASSERT_EQUAL_HEX32(0x6B, val);
+	TEST_ASSERT_EQUAL_HEX8(0x80, fake.last_frame[0]);
+	TEST_ASSERT_EQUAL_HEX8(0x2A, fake.last_frame[1]);
+	TEST_ASSERT_EQUAL_UINT32(1, fake.reads);
+
+	/* Outside of a sync, a write is sent on its own */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x04, 0x9C));
+	TEST_ASSERT_EQUAL_HEX32(0x9C, fake.regs[0x04]);
+	TEST_ASSERT_EQUAL_UINT32(0, fake.spi_transfers);
+
+	/* A sync is sent with a single transfer */
+	no_os_regmap_cache_only(map, true);
+	for (i = 0; i < 8; i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x20 + i, i));
+	no_os_regmap_cache_only(map, false);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_sync(map));
+	TEST_ASSERT_EQUAL_UINT32(1, fake.spi_transfers);
+	TEST_ASSERT_EQUAL_UINT32(8, fake.spi_msgs);
+	for (i = 0; i < 8; i++)
+		TEST_ASSERT_EQUAL_UINT32(i, fake.regs[0x20 + i]);
+	TEST_ASSERT_EQUAL_UINT32(1, fake.reads);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_remove(map));
+	map = NULL;
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_remove(spi));
+}
+
+void test_regmap_i2c_backend(void)
+{
+	struct no_os_i2c_init_param i2c_param = {
+		.max_speed_hz = 400000,
+		.slave_address = 0x48,
+		.platform_ops = &fake_i2c_ops,
+	};
+	struct no_os_regmap_config config = fake_config;
+	struct no_os_i2c_desc *i2c;
+	uint32_t val;
+
+	config.reg_bits = 8;
+	config.val_bits = 16;
+	TEST_ASSERT_EQUAL_INT(0, no_os_i2c_init(&i2c, &i2c_param));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_init_i2c(&map, i2c, &config));
+
+	/* A read is the address without STOP, then the value with STOP */
+	fake.regs[0x0C] = 0xBEEF;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x0C, &val));
+	TEST_ASSERT_EQUAL_HEX32(0xBEEF, val);
+	TEST_ASSERT_EQUAL_UINT32(2, fake.i2c_ops);
+	TEST_ASSERT_EQUAL_UINT8(0, fake.i2c_stops[0]);
+	TEST_ASSERT_EQUAL_UINT8(1, fake.i2c_stops[1]);
+
+	/* Cached from now on */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x0C, &val));
+	TEST_ASSERT_EQUAL_UINT32(2, fake.i2c_ops);
+
+	/* A write is a single transaction */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x0D, 0x1234));
+	TEST_ASSERT_EQUAL_UINT32(3, fake.i2c_ops);
+	TEST_ASSERT_EQUAL_UINT8(1, fake.i2c_stops[2]);
+	TEST_ASSERT_EQUAL_HEX32(0x1234, fake.regs[0x0D]);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_remove(map));
+	map = NULL;
+	TEST_ASSERT_EQUAL_INT(0, no_os_i2c_remove(i2c));
+}
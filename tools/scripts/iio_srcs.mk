@@ -1,13 +1,20 @@
 SRCS += $(NO-OS)/iio/iio.c
 SRCS += $(NO-OS)/iio/iiod.c
+SRCS += $(NO-OS)/iio/iio_scan.c
 SRCS += $(NO-OS)/util/no_os_circular_buffer.c
 
 INCS += $(NO-OS)/iio/iio.h
 INCS += $(NO-OS)/iio/iio_types.h
 INCS += $(NO-OS)/iio/iiod.h
+INCS += $(NO-OS)/iio/iio_scan.h
 INCS += $(NO-OS)/iio/iiod_private.h
 INCS += $(INCLUDE)/no_os_circular_buffer.h
 
+# SSE2/NEON version of the scan packing, off by default
+ifeq (y,$(strip $(IIO_SCAN_SIMD)))
+CFLAGS += -DIIO_SCAN_SIMD
+endif
+
 ifeq (y,$(strip $(NETWORKING)))
 DISABLE_SECURE_SOCKET ?= y
 SRC_DIRS += $(NO-OS)/network
@@ -37,8 +37,366 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 
+#include <errno.h>
+#include <string.h>
 #include "no_os_alloc.h"
 
+#ifdef NO_OS_ALLOC_POOL
+#include "no_os_mutex.h"
+
+#ifndef NO_OS_ALLOC_HEAP_SIZE
+#define NO_OS_ALLOC_HEAP_SIZE	(64 * 1024)
+#endif
+
+/* Number of call sites for which statistics are kept */
+#ifndef NO_OS_ALLOC_MAX_SITES
+#define NO_OS_ALLOC_MAX_SITES	32
+#endif
+
+/* Block sizes (header included) are 2^(class + NO_OS_ALLOC_MIN_SHIFT) */
+#define NO_OS_ALLOC_MIN_SHIFT	5
+#define NO_OS_ALLOC_NB_CLASSES	(sizeof(long) * 8 - NO_OS_ALLOC_MIN_SHIFT)
+#define NO_OS_ALLOC_NO_SITE	0xFF
+
+/**
+ * @union no_os_alloc_hdr
+ * @brief Start of a block, just before the memory returned to the user.
+ */
+union no_os_alloc_hdr {
+	/** While the block is allocated */
+	struct {
+		/** Requested size */
+		uint32_t size;
+		/** Size class */
+		uint8_t class;
+		/** Index in no_os_alloc_pool.sites */
+		uint8_t site;
+	} used;
+	/** While the block is free: next free block of the same class */
+	union no_os_alloc_hdr *next;
+	uint8_t align[NO_OS_ALLOC_ALIGN];
+};
+
+/**
+ * @struct no_os_alloc_pool_state
+ * @brief State of the pool allocator.
+ */
+struct no_os_alloc_pool_state {
+	/** Memory which wasn't split in blocks yet */
+	struct no_os_arena arena;
+	/** Free blocks of each class */
+	union no_os_alloc_hdr *free_list[NO_OS_ALLOC_NB_CLASSES];
+	struct no_os_alloc_stats stats;
+	struct no_os_alloc_site_stats sites[NO_OS_ALLOC_MAX_SITES];
+	/** Set by no_os_alloc_init(), the pool isn't locked before */
+	void *mutex;
+};
+
+static uint8_t no_os_alloc_heap[NO_OS_ALLOC_HEAP_SIZE]
+__attribute__((aligned(NO_OS_ALLOC_ALIGN)));
+
+/* The heap is aligned, so it is used as an arena without padding */
+static struct no_os_alloc_pool_state no_os_alloc_pool = {
+	.arena = {
+		.base = no_os_alloc_heap,
+		.size = NO_OS_ALLOC_HEAP_SIZE,
+	},
+	.stats = {
+		.heap_size = NO_OS_ALLOC_HEAP_SIZE,
+	},
+};
+#endif
+
+/**
+ * @brief Use a memory area as an arena.
+ * @param arena - Arena descriptor.
+ * @param mem - Start of the memory.
+ * @param size - Size of the memory, in bytes.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int no_os_arena_init(struct no_os_arena *arena, void *mem, size_t size)
+{
+	size_t pad;
+
+	if (!arena || !mem)
+		return -EINVAL;
+
+	pad = -(uintptr_t)mem & (NO_OS_ALLOC_ALIGN - 1);
+	if (pad > size)
+		return -EINVAL;
+
+	arena->base = (uint8_t *)mem + pad;
+	arena->size = size - pad;
+	arena->used = 0;
+	arena->high_water = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Allocate memory from an arena.
+ * @param arena - Arena descriptor.
+ * @param size - Size of the memory block, in bytes.
+ * @return Pointer to the allocated memory, or NULL if the arena is full.
+ */
+void *no_os_arena_alloc(struct no_os_arena *arena, size_t size)
+{
+	void *ptr;
+
+	size = (size + NO_OS_ALLOC_ALIGN - 1) & ~(NO_OS_ALLOC_ALIGN - 1);
+	if (!size || size > arena->size - arena->used)
+		return NULL;
+
+	ptr = arena->base + arena->used;
+	arena->used += size;
+	if (arena->used > arena->high_water)
+		arena->high_water = arena->used;
+
+	return ptr;
+}
+
+/**
+ * @brief Release all the memory allocated from an arena.
+ * @param arena - Arena descriptor.
+ * @return None.
+ */
+void no_os_arena_reset(struct no_os_arena *arena)
+{
+	arena->used = 0;
+}
+
+#ifdef NO_OS_ALLOC_POOL
+
+/**
+ * @brief Create the lock of the pool allocator.
+ *
+ * Must be called before the threads which allocate memory are started. The
+ * memory allocated by no_os_mutex_init() itself is taken without locking.
+ * Platforms without threads have no mutex, the pool then stays unlocked.
+ * @return 0
+ */
+int no_os_alloc_init(void)
+{
+	if (!no_os_alloc_pool.mutex)
+		no_os_mutex_init(&no_os_alloc_pool.mutex);
+
+	return 0;
+}
+
+static void no_os_alloc_lock(void)
+{
+	if (no_os_alloc_pool.mutex)
+		no_os_mutex_lock(no_os_alloc_pool.mutex);
+}
+
+static void no_os_alloc_unlock(void)
+{
+	if (no_os_alloc_pool.mutex)
+		no_os_mutex_unlock(no_os_alloc_pool.mutex);
+}
+
+/* Index of the statistics of a call site, NO_OS_ALLOC_NO_SITE if untracked */
+static uint8_t no_os_alloc_site(void *site)
+{
+	struct no_os_alloc_stats *stats = &no_os_alloc_pool.stats;
+	uint32_t i;
+
+	for (i = 0; i < stats->nb_sites; i++)
+		if (no_os_alloc_pool.sites[i].site == site)
+			return i;
+
+	if (stats->nb_sites == NO_OS_ALLOC_MAX_SITES)
+		return NO_OS_ALLOC_NO_SITE;
+
+	no_os_alloc_pool.sites[i].site = site;
+	stats->nb_sites++;
+
+	return i;
+}
+
+/* Allocate a block of the smallest class which fits size */
+static void *no_os_alloc_pool_get(size_t size, void *site)
+{
+	struct no_os_alloc_stats *stats = &no_os_alloc_pool.stats;
+	struct no_os_alloc_site_stats *site_stats;
+	union no_os_alloc_hdr *block;
+	unsigned long total;
+	uint32_t class;
+
+	total = size + sizeof(*block);
+	if (size > UINT32_MAX || total < size)
+		return NULL;
+
+	class = 0;
+	if (total > (1ul << NO_OS_ALLOC_MIN_SHIFT))
+		class = sizeof(long) * 8 - __builtin_clzl(total - 1) -
+			NO_OS_ALLOC_MIN_SHIFT;
+
+	/* Sizes close to ULONG_MAX, on targets where long has 32 bits */
+	if (class >= NO_OS_ALLOC_NB_CLASSES)
+		return NULL;
+
+	no_os_alloc_lock();
+
+	block = no_os_alloc_pool.free_list[class];
+	if (block) {
+		no_os_alloc_pool.free_list[class] = block->next;
+	} else {
+		block = no_os_arena_alloc(&no_os_alloc_pool.arena,
+					  1ul << (class + NO_OS_ALLOC_MIN_SHIFT));
+		if (!block) {
+			stats->nb_failed++;
+			no_os_alloc_unlock();
+			return NULL;
+		}
+		stats->heap_used = no_os_alloc_pool.arena.used;
+	}
+
+	block->used.size = size;
+	block->used.class = class;
+	block->used.site = no_os_alloc_site(site);
+
+	stats->nb_allocs++;
+	stats->in_use += size;
+	if (stats->in_use > stats->high_water)
+		stats->high_water = stats->in_use;
+
+	if (block->used.site != NO_OS_ALLOC_NO_SITE) {
+		site_stats = &no_os_alloc_pool.sites[block->used.site];
+		site_stats->nb_allocs++;
+		site_stats->in_use += size;
+		if (site_stats->in_use > site_stats->high_water)
+			site_stats->high_water = site_stats->in_use;
+		if (size > site_stats->peak)
+			site_stats->peak = size;
+	}
+
+	no_os_alloc_unlock();
+
+	return block + 1;
+}
+
+/**
+ * @brief Allocate memory and return a pointer to it.
+ * @param size - Size of the memory block, in bytes.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+__attribute__((weak)) void *no_os_malloc(size_t size)
+{
+	return no_os_alloc_pool_get(size, __builtin_return_address(0));
+}
+
+/**
+ * @brief Allocate memory and return a pointer to it, set memory to 0.
+ * @param nitems - Number of elements to be allocated.
+ * @param size - Size of elements.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+__attribute__((weak)) void *no_os_calloc(size_t nitems, size_t size)
+{
+	void *ptr;
+
+	if (size && nitems > SIZE_MAX / size)
+		return NULL;
+
+	ptr = no_os_alloc_pool_get(nitems * size, __builtin_return_address(0));
+	if (ptr)
+		memset(ptr, 0, nitems * size);
+
+	return ptr;
+}
+
+/**
+ * @brief Deallocate memory previously allocated by a call to no_os_calloc
+ * 		  or no_os_malloc.
+ * @param ptr - Pointer to a memory block previously allocated by a call
+ * 		  to no_os_calloc or no_os_malloc.
+ * @return None.
+ */
+__attribute__((weak)) void no_os_free(void *ptr)
+{
+	union no_os_alloc_hdr *block = ptr;
+	struct no_os_alloc_stats *stats = &no_os_alloc_pool.stats;
+	uint32_t class;
+
+	if (!ptr)
+		return;
+
+	block--;
+
+	no_os_alloc_lock();
+
+	stats->nb_frees++;
+	stats->in_use -= block->used.size;
+	if (block->used.site != NO_OS_ALLOC_NO_SITE)
+		no_os_alloc_pool.sites[block->used.site].in_use -=
+			block->used.size;
+
+	class = block->used.class;
+	block->next = no_os_alloc_pool.free_list[class];
+	no_os_alloc_pool.free_list[class] = block;
+
+	no_os_alloc_unlock();
+}
+
+/**
+ * @brief Get the statistics of the pool allocator.
+ * @param stats - Where to store the statistics.
+ * @return 0 in case of success, -EINVAL for invalid parameters.
+ */
+int no_os_alloc_get_stats(struct no_os_alloc_stats *stats)
+{
+	if (!stats)
+		return -EINVAL;
+
+	no_os_alloc_lock();
+	*stats = no_os_alloc_pool.stats;
+	no_os_alloc_unlock();
+
+	stats->fragmentation = 0;
+	if (stats->heap_used)
+		stats->fragmentation = (uint64_t)(stats->heap_used -
+						  stats->in_use) * 1000 /
+				       stats->heap_used;
+
+	return 0;
+}
+
+/**
+ * @brief Get the statistics of a call site.
+ * @param idx - Index of the call site, less than no_os_alloc_stats.nb_sites.
+ * @param stats - Where to store the statistics.
+ * @return 0 in case of success, -EINVAL for invalid parameters.
+ */
+int no_os_alloc_get_site_stats(uint32_t idx,
+			       struct no_os_alloc_site_stats *stats)
+{
+	int ret = -EINVAL;
+
+	if (!stats)
+		return -EINVAL;
+
+	no_os_alloc_lock();
+	if (idx < no_os_alloc_pool.stats.nb_sites) {
+		*stats = no_os_alloc_pool.sites[idx];
+		ret = 0;
+	}
+	no_os_alloc_unlock();
+
+	return ret;
+}
+
+#else
+
+/**
+ * @brief The C library heap needs no initialization.
+ * @return 0
+ */
+int no_os_alloc_init(void)
+{
+	return 0;
+}
+
 /**
  * @brief Allocate memory and return a pointer to it.
  * @param size - Size of the memory block, in bytes.
@@ -71,3 +429,27 @@ __attribute__((weak)) void no_os_free(void *ptr)
 {
 	free(ptr);
 }
+
+/**
+ * @brief Statistics are only kept by the pool allocator.
+ * @param stats - Unused.
+ * @return -ENOSYS
+ */
+int no_os_alloc_get_stats(struct no_os_alloc_stats *stats)
+{
+	return -ENOSYS;
+}
+
+/**
+ * @brief Statistics are only kept by the pool allocator.
+ * @param idx - Unused.
+ * @param stats - Unused.
+ * @return -ENOSYS
+ */
+int no_os_alloc_get_site_stats(uint32_t idx,
+			       struct no_os_alloc_site_stats *stats)
+{
+	return -ENOSYS;
+}
+
+#endif
@@ -54,15 +54,86 @@
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
+/* Read a position published by the other side of the buffer */
+static inline uint32_t no_os_cb_load(uint32_t *pos)
+{
+	return __atomic_load_n(pos, __ATOMIC_ACQUIRE);
+}
+
+/* Publish a position after the data before it was accessed */
+static inline void no_os_cb_store(uint32_t *pos, uint32_t val)
+{
+	__atomic_store_n(pos, val, __ATOMIC_RELEASE);
+}
+
+/* Number of bytes from position from to position to */
+static inline uint32_t no_os_cb_dist(struct no_os_circular_buffer *desc,
+				     uint32_t from, uint32_t to)
+{
+	if (to >= from)
+		return to - from;
+
+	return desc->wrap - from + to;
+}
+
+/* Position n bytes after pos */
+static inline uint32_t no_os_cb_advance(struct no_os_circular_buffer *desc,
+					uint32_t pos, uint32_t n)
+{
+	if (n >= desc->wrap - pos)
+		return n - (desc->wrap - pos);
+
+	return pos + n;
+}
+
+/* Position n bytes before pos */
+static inline uint32_t no_os_cb_rewind(struct no_os_circular_buffer *desc,
+				       uint32_t pos, uint32_t n)
+{
+	if (n > pos)
+		return desc->wrap - (n - pos);
+
+	return pos - n;
+}
+
 int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buff,
 		     uint32_t size)
 {
-	if (!desc)
+	/* Positions must be able to tell a full buffer from an overrun */
+	if (!desc || !size || size > UINT32_MAX / 2)
 		return -EINVAL;
 
 	memset(desc, 0, sizeof(*desc));
 	desc->size = size;
 	desc->buff = buff;
+	desc->wrap = size * (UINT32_MAX / size);
+
+	return 0;
+}
+
+/**
+ * @brief Configure a circular buffer in memory mapped twice.
+ *
+ * The size bytes starting at buf + size must be the same memory as the size
+ * bytes starting at buf, so regions crossing the end of the buffer are
+ * returned whole by the async functions. Such a buffer can't be released with
+ * no_os_cb_remove().
+ *
+ * @param desc - Circular buffer reference
+ * @param buf - Address of the first mapping
+ * @param size - Size of one mapping
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t no_os_cb_cfg_mirrored(struct no_os_circular_buffer *desc, int8_t *buf,
+			      uint32_t size)
+{
+	int32_t ret;
+
+	ret = no_os_cb_cfg(desc, buf, size);
+	if (ret)
+		return ret;
+
+	desc->mirrored = true;
 
 	return 0;
 }
@@ -70,8 +141,8 @@ int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buff,
 /**
  * @brief Create circular buffer structure.
  *
- * @note Circular buffer implementation is thread safe for one write
- * and one reader.
+ * @note Circular buffer implementation is lock-free for one writer and one
+ * reader, which may run in different threads or interrupt contexts.
  * If multiple writer or multiple readers access the circular buffer then
  * function that updates the structure should be called inside a critical
  * critical section.
@@ -85,6 +156,8 @@ int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buff,
 int32_t no_os_cb_init(struct no_os_circular_buffer **desc, uint32_t buff_size)
 {
 	struct no_os_circular_buffer	*ldesc;
+	int8_t				*buff;
+	int32_t				ret;
 
 	if (!desc || !buff_size)
 		return -EINVAL;
@@ -93,16 +166,25 @@ int32_t no_os_cb_init(struct no_os_circular_buffer **desc, uint32_t buff_size)
 	if (!ldesc)
 		return -ENOMEM;
 
-	*desc = ldesc;
+	buff = no_os_calloc(1, buff_size);
+	if (!buff) {
+		ret = -ENOMEM;
+		goto error;
+	}
 
-	ldesc->size = buff_size;
-	ldesc->buff = no_os_calloc(1, buff_size);
-	if (!ldesc->buff) {
-		no_os_free(ldesc);
-		return -ENOMEM;
+	ret = no_os_cb_cfg(ldesc, buff, buff_size);
+	if (ret) {
+		no_os_free(buff);
+		goto error;
 	}
 
+	*desc = ldesc;
+
 	return 0;
+error:
+	no_os_free(ldesc);
+
+	return ret;
 }
 
 /**
@@ -114,7 +196,7 @@ int32_t no_os_cb_init(struct no_os_circular_buffer **desc, uint32_t buff_size)
  */
 int32_t no_os_cb_remove(struct no_os_circular_buffer *desc)
 {
-	if (!desc)
+	if (!desc || desc->mirrored)
 		return -1;
 
 	if (desc->buff)
@@ -126,6 +208,10 @@ int32_t no_os_cb_remove(struct no_os_circular_buffer *desc)
 
 /**
  * @brief Get the number of elements in the buffer.
+ *
+ * Can be called from both sides of the buffer. The value is exact for the
+ * caller's side and may be outdated for the other one.
+ *
  * @param desc - Circular buffer reference
  * @param size - Where to store size of data available to read
  * @return
@@ -135,23 +221,13 @@ int32_t no_os_cb_remove(struct no_os_circular_buffer *desc)
  */
 int32_t no_os_cb_size(struct no_os_circular_buffer *desc, uint32_t *size)
 {
-	uint32_t nb_spins;
+	uint32_t read_pos;
 
 	if (!desc || !size)
 		return -EINVAL;
 
-	if (desc->write.spin_count > desc->read.spin_count)
-		nb_spins = desc->write.spin_count - desc->read.spin_count;
-	else
-		/* Integer overflow on desc->write.spin_count */
-		nb_spins = UINT32_MAX - desc->read.spin_count +
-			   desc->write.spin_count + 1;
-
-	if (nb_spins > 0)
-		*size = desc->size + desc->write.idx - desc->read.idx;
-	else
-		*size = desc->write.idx - desc->read.idx;
-
+	read_pos = no_os_cb_load(&desc->read.pos);
+	*size = no_os_cb_dist(desc, read_pos, no_os_cb_load(&desc->write.pos));
 	if (*size > desc->size) {
 		*size = desc->size;
 		return -NO_OS_EOVERRUN;
@@ -173,6 +249,8 @@ static int32_t no_os_cb_prepare_async_operation(struct no_os_circular_buffer
 {
 	struct no_os_cb_ptr	*ptr;
 	uint32_t	available_size;
+	uint32_t	write_pos;
+	uint32_t	claim;
 	int32_t		ret;
 
 	if (!desc || !buff || !raw_size_available)
@@ -187,13 +265,24 @@ static int32_t no_os_cb_prepare_async_operation(struct no_os_circular_buffer
 		return -EBUSY;
 
 	if (is_read) {
-		ret = no_os_cb_size(desc, &available_size);
-		if (ret == -NO_OS_EOVERRUN) {
-			/* Update read index */
-			desc->read.spin_count = desc->write.spin_count - 1;
+		write_pos = no_os_cb_load(&desc->write.pos);
+		available_size = no_os_cb_dist(desc, ptr->pos, write_pos);
+		if (available_size > desc->size) {
+			/* Move the read pointer behind the write pointer */
+			ret = -NO_OS_EOVERRUN;
 #ifndef IIO_IGNORE_BUFF_OVERRUN_ERR
-			desc->read.idx = desc->write.idx;
+			available_size = desc->size;
+#else
+			available_size = (write_pos % desc->size + desc->size -
+					  ptr->idx) % desc->size;
+			if (!available_size)
+				available_size = desc->size;
 #endif
+			ptr->idx = write_pos % desc->size;
+			ptr->idx = (ptr->idx + desc->size - available_size) %
+				   desc->size;
+			no_os_cb_store(&ptr->pos, no_os_cb_rewind(desc, write_pos,
+					available_size));
 		}
 		if (!available_size)
 			/* No data to read */
@@ -205,8 +294,25 @@ static int32_t no_os_cb_prepare_async_operation(struct no_os_circular_buffer
 			return -EAGAIN;
 	}
 
-	/* Size to end of buffer */
-	ptr->async_size = no_os_min(requested_size, desc->size - ptr->idx);
+	if (desc->mirrored)
+		ptr->async_size = no_os_min(requested_size, desc->size);
+	else
+		/* Size to end of buffer */
+		ptr->async_size = no_os_min(requested_size,
+					    desc->size - ptr->idx);
+
+	if (!is_read) {
+		/*
+		 * Let the reader know which region is being written. The fence
+		 * makes it visible before the data is touched, which matters
+		 * only if unread data may be overwritten.
+		 */
+		claim = no_os_cb_advance(desc, ptr->pos, ptr->async_size);
+		__atomic_store_n(&ptr->claim, claim, __ATOMIC_RELAXED);
+		if (no_os_cb_dist(desc, no_os_cb_load(&desc->read.pos), claim) >
+		    desc->size)
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	}
 
 	*raw_size_available = ptr->async_size;
 
@@ -241,58 +347,129 @@ static int32_t no_os_cb_end_async_operation(struct no_os_circular_buffer *desc,
 
 	/* Update pointer value */
 	new_val = ptr->idx + ptr->async_size;
-	if (new_val >= desc->size) {
-		ptr->spin_count++;
-		new_val %= desc->size;
-	}
+	if (new_val >= desc->size)
+		new_val -= desc->size;
 	ptr->idx = new_val;
+	no_os_cb_store(&ptr->pos, no_os_cb_advance(desc, ptr->pos,
+			ptr->async_size));
 	ptr->async_size = 0;
 	ptr->async_started = false;
 
 	return 0;
 }
 
+/* Copy n bytes between data and the buffer, starting at index idx */
+static inline void no_os_cb_copy(struct no_os_circular_buffer *desc,
+				 uint32_t idx, uint8_t *data, uint32_t n,
+				 bool is_read)
+{
+	uint32_t first;
+
+	first = desc->mirrored ? n : no_os_min(n, desc->size - idx);
+	if (is_read) {
+		memcpy(data, desc->buff + idx, first);
+		if (n > first)
+			memcpy(data + first, desc->buff, n - first);
+	} else {
+		memcpy(desc->buff + idx, data, first);
+		if (n > first)
+			memcpy(desc->buff, data + first, n - first);
+	}
+}
+
+/* Publish the n bytes after the current position of ptr */
+static inline void no_os_cb_commit(struct no_os_circular_buffer *desc,
+				   struct no_os_cb_ptr *ptr, uint32_t n)
+{
+	ptr->idx += n;
+	if (ptr->idx >= desc->size)
+		ptr->idx -= desc->size;
+	no_os_cb_store(&ptr->pos, no_os_cb_advance(desc, ptr->pos, n));
+}
+
 /*
- * Functionality described at cb_write/read having the is_read
- * parameter to specifiy if it is a read or write operation.
+ * Blocking write. The data is copied directly, with one position update per
+ * buffer size, instead of going through the async functions.
  */
-static int32_t no_os_cb_operation(struct no_os_circular_buffer *desc,
-				  void *data, uint32_t size,
-				  bool is_read)
+static int32_t no_os_cb_write_data(struct no_os_circular_buffer *desc,
+				   uint8_t *data, uint32_t size)
 {
-	uint8_t		*buff;
-	uint32_t	available_size = 0;
-	int32_t		ret;
-	uint32_t	i;
-	bool		sticky_overrun;
+	struct no_os_cb_ptr *ptr = &desc->write;
+	uint32_t claim;
+	uint32_t n;
 
-	if (!desc || !data || !size)
-		return -EINVAL;
+	/* Only one transaction type possible at a single time */
+	if (ptr->async_started)
+		return -EBUSY;
+
+	while (size) {
+		n = no_os_min(size, desc->size);
+		/* Same as no_os_cb_prepare_async_write() */
+		claim = no_os_cb_advance(desc, ptr->pos, n);
+		__atomic_store_n(&ptr->claim, claim, __ATOMIC_RELAXED);
+		if (no_os_cb_dist(desc, no_os_cb_load(&desc->read.pos), claim) >
+		    desc->size)
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+		no_os_cb_copy(desc, ptr->idx, data, n, false);
+		no_os_cb_commit(desc, ptr, n);
+		data += n;
+		size -= n;
+	}
 
-	sticky_overrun = 0;
-	i = 0;
-	while (i < size) {
-		do {
-			ret = no_os_cb_prepare_async_operation(desc, size - i,
-							       (void **)&buff,
+	return 0;
+}
+
+/*
+ * Blocking read. The data is copied directly while there is no overrun, the
+ * async functions are only used to resynchronize after one.
+ */
+static int32_t no_os_cb_read_data(struct no_os_circular_buffer *desc,
+				  uint8_t *data, uint32_t size)
+{
+	struct no_os_cb_ptr *ptr = &desc->read;
+	bool sticky_overrun = false;
+	uint32_t available_size;
+	uint32_t claim;
+	int32_t ret;
+	void *buff;
+
+	if (ptr->async_started)
+		return -EBUSY;
+
+	while (size) {
+		available_size = no_os_cb_dist(desc, ptr->pos,
+					       no_os_cb_load(&desc->write.pos));
+		if (available_size > desc->size) {
+			ret = no_os_cb_prepare_async_operation(desc, size,
+							       &buff,
 							       &available_size,
-							       is_read);
-		} while (ret == -EBUSY || ret == -EAGAIN);
-		if (ret == -NO_OS_EOVERRUN)
-			sticky_overrun = true;
+							       true);
+			/* Only the read pointer was moved */
+			ptr->async_started = false;
+			ptr->async_size = 0;
+			if (ret == -NO_OS_EOVERRUN)
+				sticky_overrun = true;
+			else if (ret)
+				return ret;
+			continue;
+		}
 
 		/* If no data is available return error */
-		if(!available_size)
+		if (!available_size)
 			return -1;
 
-		if (is_read)
-			memcpy((uint8_t *)data + i, buff, available_size);
-		else
-			memcpy(buff, (uint8_t *)data + i, available_size);
-
-		no_os_cb_end_async_operation(desc, is_read);
+		available_size = no_os_min(available_size, size);
+		no_os_cb_copy(desc, ptr->idx, data, available_size, true);
+		/* Check that the writer didn't reach the copied data */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		claim = __atomic_load_n(&desc->write.claim, __ATOMIC_RELAXED);
+		if (no_os_cb_dist(desc, ptr->pos, claim) > desc->size)
+			sticky_overrun = true;
 
-		i += available_size;
+		no_os_cb_commit(desc, ptr, available_size);
+		data += available_size;
+		size -= available_size;
 	}
 
 	if (sticky_overrun)
@@ -309,7 +486,8 @@ static int32_t no_os_cb_operation(struct no_os_circular_buffer *desc,
  * @param desc - Circular buffer reference
  * @param size_to_write - Number of bytes needed to write to the buffer.
  * @param write_buff - Address where to store the buffer where to write to.
- * @param size_avilable - no_os_min(size_to_write, size until end of allocated buffer)
+ * @param size_avilable - no_os_min(size_to_write, size until end of allocated
+ * buffer). For mirrored buffers, no_os_min(size_to_write, buffer size).
  * @return
  *  - 0   - No errors
  *  - -EINVAL   - Wrong parameters used
@@ -332,7 +510,8 @@ int32_t no_os_cb_prepare_async_write(struct no_os_circular_buffer *desc,
  * @param desc - Circular buffer reference
  * @param size_to_read - Number of bytes needed to write to the buffer.
  * @param read_buff - Address where to store the buffer where data will be read.
- * @param size_avilable - no_os_min(size_to_read, size until end of allocated buffer)
+ * @param size_avilable - no_os_min(size_to_read, size until end of allocated
+ * buffer). For mirrored buffers, no_os_min(size_to_read, data available).
  * @return
  *  - 0   - No errors
  *  - -EAGAIN   - No data available at this moment
@@ -384,7 +563,10 @@ int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc)
 int32_t no_os_cb_write(struct no_os_circular_buffer *desc, const void *data,
 		       uint32_t size)
 {
-	return no_os_cb_operation(desc, (void *)data, size, 0);
+	if (!desc || !data || !size)
+		return -EINVAL;
+
+	return no_os_cb_write_data(desc, (uint8_t *)data, size);
 }
 
 /**
@@ -400,5 +582,8 @@ int32_t no_os_cb_write(struct no_os_circular_buffer *desc, const void *data,
 int32_t no_os_cb_read(struct no_os_circular_buffer *desc, void *data,
 		      uint32_t size)
 {
-	return no_os_cb_operation(desc, data, size, 1);
+	if (!desc || !data || !size)
+		return -EINVAL;
+
+	return no_os_cb_read_data(desc, data, size);
 }
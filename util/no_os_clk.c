@@ -43,9 +43,149 @@
 #include "no_os_error.h"
 #include "no_os_clk.h"
 
+/******************************************************************************/
+/************************ Variables Definitions *******************************/
+/******************************************************************************/
+/** Number of platform operations called on all the clocks */
+static uint32_t clk_hw_op_count;
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
+/**
+ * @brief Add the clock to the children list of the parent.
+ * @param desc - The clock descriptor.
+ * @param parent - The parent clock descriptor.
+ */
+static void no_os_clk_link(struct no_os_clk_desc *desc,
+			   struct no_os_clk_desc *parent)
+{
+	desc->parent = parent;
+	desc->sibling = parent->children;
+	parent->children = desc;
+}
+
+/**
+ * @brief Remove the clock from the children list of its parent.
+ * @param desc - The clock descriptor.
+ */
+static void no_os_clk_unlink(struct no_os_clk_desc *desc)
+{
+	struct no_os_clk_desc **node;
+
+	if (!desc->parent)
+		return;
+
+	for (node = &desc->parent->children; *node; node = &(*node)->sibling) {
+		if (*node == desc) {
+			*node = desc->sibling;
+			break;
+		}
+	}
+
+	desc->parent = NULL;
+	desc->sibling = NULL;
+}
+
+/**
+ * @brief Drop the cached rate of the clock and of all the clocks below it.
+ * @param desc - The clock descriptor.
+ */
+static void no_os_clk_invalidate(struct no_os_clk_desc *desc)
+{
+	struct no_os_clk_desc *child;
+
+	desc->rate_valid = false;
+	for (child = desc->children; child; child = child->sibling)
+		no_os_clk_invalidate(child);
+}
+
+/**
+ * @brief Get the rate of the parent, 0 if there is none or it is unknown.
+ * @param desc - The clock descriptor.
+ * @return The parent rate.
+ */
+static uint64_t no_os_clk_parent_rate(struct no_os_clk_desc *desc)
+{
+	uint64_t rate;
+
+	if (no_os_clk_get_parent_rate(desc, &rate))
+		return 0;
+
+	return rate;
+}
+
+/**
+ * @brief Negotiate a rate without touching the hardware.
+ *
+ * The clock is asked first. If it prefers another parent rate and is allowed
+ * to change it, the parent negotiates that rate in turn and the clock is asked
+ * once more, this time with the rate the parent can actually provide.
+ *
+ * @param desc - The clock descriptor.
+ * @param req - The requested rate on input, the negotiated rates on output.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t no_os_clk_determine(struct no_os_clk_desc *desc,
+				   struct no_os_clk_rate_request *req)
+{
+	const struct no_os_clk_platform_ops *ops = desc->platform_ops;
+	struct no_os_clk_rate_request parent_req;
+	bool set_parent;
+	uint64_t rate = req->rate;
+	uint64_t parent_rate;
+	int32_t ret;
+
+	set_parent = desc->parent && (desc->flags & NO_OS_CLK_SET_RATE_PARENT);
+	parent_rate = no_os_clk_parent_rate(desc);
+	req->parent_rate = parent_rate;
+
+	if (ops->clk_determine_rate) {
+		clk_hw_op_count++;
+		ret = ops->clk_determine_rate(desc, req);
+		if (ret || !set_parent || req->parent_rate == parent_rate)
+			return ret;
+
+		parent_req.rate = req->parent_rate;
+		ret = no_os_clk_determine(desc->parent, &parent_req);
+		if (ret)
+			return ret;
+
+		req->rate = rate;
+		req->parent_rate = parent_req.rate;
+		clk_hw_op_count++;
+		ret = ops->clk_determine_rate(desc, req);
+		req->parent_rate = parent_req.rate;
+
+		return ret;
+	}
+
+	if (ops->clk_round_rate) {
+		clk_hw_op_count++;
+		return ops->clk_round_rate(desc, rate, &req->rate);
+	}
+
+	if (set_parent) {
+		parent_req.rate = rate;
+		ret = no_os_clk_determine(desc->parent, &parent_req);
+		if (ret)
+			return ret;
+
+		req->rate = parent_req.rate;
+		req->parent_rate = parent_req.rate;
+
+		return 0;
+	}
+
+	if (!desc->parent)
+		return -ENOSYS;
+
+	/* A clock that follows its parent can only run at the parent rate. */
+	req->rate = parent_rate;
+
+	return 0;
+}
+
 /**
  * Initialize clock.
  * @param desc - CLK descriptor.
@@ -68,6 +208,16 @@ int32_t no_os_clk_init(struct no_os_clk_desc **desc,
 		return -EINVAL;
 
 	(*desc)->platform_ops = param->platform_ops;
+	(*desc)->parent = NULL;
+	(*desc)->children = NULL;
+	(*desc)->sibling = NULL;
+	/* Keep the flags the platform set for this clock. */
+	(*desc)->flags |= param->flags;
+	(*desc)->enable_count = 0;
+	(*desc)->rate_valid = false;
+
+	if (param->parent)
+		no_os_clk_link(*desc, param->parent);
 
 	return 0;
 }
@@ -85,43 +235,108 @@ int32_t no_os_clk_remove(struct no_os_clk_desc *desc)
 	if (!desc->platform_ops->remove)
 		return -ENOSYS;
 
+	/* The children would be left pointing to a freed parent. */
+	if (desc->children)
+		return -EBUSY;
+
+	no_os_clk_unlink(desc);
+
 	return desc->platform_ops->remove(desc);
 }
 
 /**
  * Start the clock.
+ *
+ * Enables are counted: the hardware and the parent clocks are only enabled
+ * by the first call.
+ *
  * @param clk - The clock descriptor.
  * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_clk_enable(struct no_os_clk_desc *desc)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_enable)
+	if (desc->enable_count) {
+		desc->enable_count++;
+		return 0;
+	}
+
+	if (!desc->platform_ops->clk_enable && !desc->parent)
 		return -ENOSYS;
 
-	return desc->platform_ops->clk_enable(desc);
+	if (desc->parent) {
+		ret = no_os_clk_enable(desc->parent);
+		if (ret)
+			return ret;
+	}
+
+	if (desc->platform_ops->clk_enable) {
+		clk_hw_op_count++;
+		ret = desc->platform_ops->clk_enable(desc);
+		if (ret) {
+			if (desc->parent)
+				no_os_clk_disable(desc->parent);
+			return ret;
+		}
+	}
+
+	desc->enable_count = 1;
+
+	return 0;
 }
 
 /**
  * Stop the clock.
+ *
+ * Only the call balancing the first enable stops the hardware and releases
+ * the parent clocks. A clock that was never enabled is stopped right away,
+ * which lets drivers force a known state at init.
+ *
  * @param clk - The clock descriptor.
  * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_clk_disable(struct no_os_clk_desc *desc)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_disable)
+	if (desc->enable_count > 1) {
+		desc->enable_count--;
+		return 0;
+	}
+
+	if (!desc->platform_ops->clk_disable && !desc->parent)
 		return -ENOSYS;
 
-	return desc->platform_ops->clk_disable(desc);
+	if (desc->platform_ops->clk_disable) {
+		clk_hw_op_count++;
+		ret = desc->platform_ops->clk_disable(desc);
+		if (ret)
+			return ret;
+	}
+
+	if (!desc->enable_count)
+		return 0;
+
+	desc->enable_count = 0;
+	if (desc->parent)
+		return no_os_clk_disable(desc->parent);
+
+	return 0;
 }
 
 /**
  * Get the current frequency of the clock.
+ *
+ * The rate is read from the hardware once and cached until a rate change in
+ * the clock or in one of its parents.
+ *
  * @param clk - The clock descriptor.
  * @param rate - The current frequency.
  * @return 0 in case of success, negative error code otherwise.
@@ -129,13 +344,33 @@ int32_t no_os_clk_disable(struct no_os_clk_desc *desc)
 int32_t no_os_clk_recalc_rate(struct no_os_clk_desc *desc,
 			      uint64_t *rate)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops || !rate)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_recalc_rate)
+	if (desc->rate_valid) {
+		*rate = desc->rate;
+		return 0;
+	}
+
+	if (desc->platform_ops->clk_recalc_rate) {
+		clk_hw_op_count++;
+		ret = desc->platform_ops->clk_recalc_rate(desc, rate);
+	} else if (desc->parent) {
+		ret = no_os_clk_recalc_rate(desc->parent, rate);
+	} else {
 		return -ENOSYS;
+	}
+	if (ret)
+		return ret;
 
-	return desc->platform_ops->clk_recalc_rate(desc, rate);
+	if (!(desc->flags & NO_OS_CLK_GET_RATE_NOCACHE)) {
+		desc->rate = *rate;
+		desc->rate_valid = true;
+	}
+
+	return 0;
 }
 
 /**
@@ -149,17 +384,29 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 			     uint64_t rate,
 			     uint64_t *rounded_rate)
 {
+	struct no_os_clk_rate_request req;
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops || !rounded_rate)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_round_rate)
-		return -ENOSYS;
+	req.rate = rate;
+	ret = no_os_clk_determine(desc, &req);
+	if (ret)
+		return ret;
 
-	return desc->platform_ops->clk_round_rate(desc, rate, rounded_rate);
+	*rounded_rate = req.rate;
+
+	return 0;
 }
 
 /**
  * Change the frequency of the clock.
+ *
+ * The rate is negotiated along the chain of parents first, so an impossible
+ * request fails before any register is written. Nothing is written either if
+ * the clock already runs at the negotiated rate.
+ *
  * @param clk - The clock descriptor.
  * @param rate - The desired frequency.
  * @return 0 in case of success, negative error code otherwise.
@@ -167,11 +414,139 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 int32_t no_os_clk_set_rate(struct no_os_clk_desc *desc,
 			   uint64_t rate)
 {
+	const struct no_os_clk_platform_ops *ops;
+	struct no_os_clk_rate_request req;
+	uint64_t parent_rate;
+	bool set_parent;
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_set_rate)
+	ops = desc->platform_ops;
+	set_parent = desc->parent && (desc->flags & NO_OS_CLK_SET_RATE_PARENT);
+	if (!ops->clk_set_rate && !set_parent)
 		return -ENOSYS;
 
-	return desc->platform_ops->clk_set_rate(desc, rate);
+	parent_rate = no_os_clk_parent_rate(desc);
+	req.rate = rate;
+	req.parent_rate = parent_rate;
+	if (ops->clk_determine_rate || ops->clk_round_rate ||
+	    !ops->clk_set_rate) {
+		ret = no_os_clk_determine(desc, &req);
+		if (ret)
+			return ret;
+	}
+
+	if (desc->rate_valid && desc->rate == req.rate &&
+	    req.parent_rate == parent_rate)
+		return 0;
+
+	if (set_parent && req.parent_rate != parent_rate) {
+		ret = no_os_clk_set_rate(desc->parent, req.parent_rate);
+		if (ret)
+			return ret;
+	}
+
+	no_os_clk_invalidate(desc);
+
+	if (!ops->clk_set_rate)
+		return 0;
+
+	clk_hw_op_count++;
+
+	return ops->clk_set_rate(desc, req.rate);
+}
+
+/**
+ * Check if the clock was enabled through no_os_clk_enable().
+ * @param desc - The clock descriptor.
+ * @return true if the clock holds at least one enable, false otherwise.
+ */
+bool no_os_clk_is_enabled(struct no_os_clk_desc *desc)
+{
+	return desc && desc->enable_count;
+}
+
+/**
+ * Get the parent of the clock.
+ * @param desc - The clock descriptor.
+ * @return The parent clock descriptor, NULL for a root clock.
+ */
+struct no_os_clk_desc *no_os_clk_get_parent(struct no_os_clk_desc *desc)
+{
+	return desc ? desc->parent : NULL;
+}
+
+/**
+ * Move the clock under a new parent.
+ *
+ * Only the tree is updated, clocks with a hardware input mux have to select
+ * the matching input themselves. An enabled clock moves its enable from the
+ * old parent to the new one.
+ *
+ * @param desc - The clock descriptor.
+ * @param parent - The new parent, NULL to make the clock a root clock.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_set_parent(struct no_os_clk_desc *desc,
+			     struct no_os_clk_desc *parent)
+{
+	struct no_os_clk_desc *old_parent;
+	struct no_os_clk_desc *clk;
+	int32_t ret;
+
+	if (!desc || !desc->platform_ops)
+		return -EINVAL;
+
+	if (parent == desc->parent)
+		return 0;
+
+	for (clk = parent; clk; clk = clk->parent)
+		if (clk == desc)
+			return -EINVAL;
+
+	if (desc->enable_count && parent) {
+		ret = no_os_clk_enable(parent);
+		if (ret)
+			return ret;
+	}
+
+	old_parent = desc->parent;
+	no_os_clk_unlink(desc);
+	if (parent)
+		no_os_clk_link(desc, parent);
+	no_os_clk_invalidate(desc);
+
+	if (desc->enable_count && old_parent)
+		return no_os_clk_disable(old_parent);
+
+	return 0;
+}
+
+/**
+ * Get the current frequency of the parent clock.
+ * @param desc - The clock descriptor.
+ * @param rate - The parent frequency.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_get_parent_rate(struct no_os_clk_desc *desc,
+				  uint64_t *rate)
+{
+	if (!desc || !rate)
+		return -EINVAL;
+
+	if (!desc->parent)
+		return -ENOENT;
+
+	return no_os_clk_recalc_rate(desc->parent, rate);
+}
+
+/**
+ * Get the number of clock operations that reached the hardware.
+ * @return The number of platform operations called on all the clocks.
+ */
+uint32_t no_os_clk_get_hw_op_count(void)
+{
+	return clk_hw_op_count;
 }
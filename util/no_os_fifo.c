@@ -52,89 +52,162 @@
 /******************************************************************************/
 
 /**
- * @brief Create new fifo element
- * @param buff - Data to be saved in fifo.
- * @param len - Length of the data.
+ * @brief Allocate a new fifo element together with its data buffer.
+ * @param fifo - The fifo.
  * @return fifo element in case of success, NULL otherwise
  */
-static struct no_os_fifo_element * fifo_new_element(char *buff, uint32_t len)
+static struct no_os_fifo_element *fifo_alloc_element(struct no_os_fifo *fifo)
 {
-	struct no_os_fifo_element *q = no_os_calloc(1,
-				       sizeof(struct no_os_fifo_element));
-	if (!q)
+	struct no_os_fifo_element *q;
+
+	if (fifo->max_elements && fifo->nb_elements >= fifo->max_elements)
 		return NULL;
 
-	q->len = len;
-	q->data = no_os_calloc(1, len);
-	if (!(q->data)) {
-		no_os_free(q);
+	q = no_os_calloc(1, sizeof(*q) + fifo->element_size);
+	if (!q)
 		return NULL;
-	}
-	memcpy(q->data, buff, len);
+
+	q->data = (char *)(q + 1);
+	fifo->nb_elements++;
 
 	return q;
 }
 
 /**
- * @brief Get last element in fifo
- * @param p_fifo - pointer to fifo
- * @return fifo last element if exists, NULL otherwise
+ * @brief Get an element for new data, reusing a released one if possible.
+ * @param fifo - The fifo.
+ * @return fifo element in case of success, NULL otherwise
  */
-static struct no_os_fifo_element *no_os_fifo_get_last(struct no_os_fifo_element
-		*p_fifo)
+static struct no_os_fifo_element *fifo_new_element(struct no_os_fifo *fifo)
 {
-	if(p_fifo == NULL)
-		return NULL;
-	while (p_fifo->next) {
-		p_fifo = p_fifo->next;
+	struct no_os_fifo_element *q;
+
+	q = no_os_ilist_get_first_entry(&fifo->free, struct no_os_fifo_element,
+					node);
+	if (q)
+		return q;
+
+	return fifo_alloc_element(fifo);
+}
+
+/**
+ * @brief Free the elements of a list.
+ * @param list - List of fifo elements.
+ */
+static void fifo_free_elements(struct no_os_ilist *list)
+{
+	struct no_os_fifo_element *q;
+
+	while ((q = no_os_ilist_get_first_entry(list, struct no_os_fifo_element,
+						node)))
+		no_os_free(q);
+}
+
+/**
+ * @brief Allocate a fifo.
+ * @param fifo - Pointer to the fifo.
+ * @param element_size - Maximum length of the data of an element.
+ * @param nb_elements - Number of elements allocated here, more are allocated
+ *			by no_os_fifo_insert when needed.
+ * @param max_elements - Maximum number of elements, 0 for no limit.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t no_os_fifo_init(struct no_os_fifo **fifo, uint32_t element_size,
+			uint32_t nb_elements, uint32_t max_elements)
+{
+	struct no_os_fifo_element *q;
+	struct no_os_fifo *f;
+
+	if (!fifo || !element_size ||
+	    (max_elements && nb_elements > max_elements))
+		return -EINVAL;
+
+	f = no_os_calloc(1, sizeof(*f));
+	if (!f)
+		return -ENOMEM;
+
+	no_os_ilist_init(&f->elements);
+	no_os_ilist_init(&f->free);
+	f->element_size = element_size;
+	f->max_elements = max_elements;
+
+	while (f->nb_elements < nb_elements) {
+		q = fifo_alloc_element(f);
+		if (!q) {
+			no_os_fifo_remove(f);
+			return -ENOMEM;
+		}
+		no_os_ilist_add_last(&f->free, &q->node);
 	}
 
-	return p_fifo;
+	*fifo = f;
+
+	return 0;
+}
+
+/**
+ * @brief Free a fifo and all its elements.
+ * @param fifo - The fifo.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int32_t no_os_fifo_remove(struct no_os_fifo *fifo)
+{
+	if (!fifo)
+		return -EINVAL;
+
+	fifo_free_elements(&fifo->elements);
+	fifo_free_elements(&fifo->free);
+	no_os_free(fifo);
+
+	return 0;
 }
 
 /**
  * @brief Insert element to fifo, in the last position.
- * @param p_fifo - Pointer to fifo.
+ * @param fifo - The fifo.
  * @param buff - Data to be saved in fifo.
- * @param len - Length of the data.
- * @return 0 in case of success, -1 otherwise
+ * @param len - Length of the data, at most the element size of the fifo.
+ * @return 0 in case of success, negative error code otherwise
  */
-int32_t no_os_fifo_insert(struct no_os_fifo_element **p_fifo, char *buff,
+int32_t no_os_fifo_insert(struct no_os_fifo *fifo, const char *buff,
 			  uint32_t len)
 {
-	struct no_os_fifo_element *p, *q;
+	struct no_os_fifo_element *q;
 
-	if (len <= 0)
-		return -1;
+	if (!fifo || !len || len > fifo->element_size)
+		return -EINVAL;
 
-	q = fifo_new_element(buff, len);
+	q = fifo_new_element(fifo);
 	if (!q)
-		return -1;
+		return -ENOMEM;
 
-	if (!(*p_fifo)) {
-		*p_fifo = q;
-	} else {
-		p = no_os_fifo_get_last(*p_fifo);
-		p->next = q;
-	}
+	memcpy(q->data, buff, len);
+	q->len = len;
+	no_os_ilist_add_last(&fifo->elements, &q->node);
 
 	return 0;
 }
 
 /**
- * @brief Remove fifo head
- * @param p_fifo - Pointer to fifo.
- * @return next element in fifo if exists, NULL otherwise.
+ * @brief Get fifo head.
+ * @param fifo - The fifo.
+ * @return first element in fifo if exists, NULL otherwise.
  */
-struct no_os_fifo_element * no_os_fifo_remove(struct no_os_fifo_element *p_fifo)
+struct no_os_fifo_element *no_os_fifo_read(struct no_os_fifo *fifo)
 {
-	struct no_os_fifo_element *p = p_fifo;
+	return no_os_ilist_first_entry(&fifo->elements,
+				       struct no_os_fifo_element, node);
+}
 
-	if (p_fifo != NULL) {
-		p_fifo = p_fifo->next;
-		no_os_free(p->data);
-		no_os_free(p);
-	}
+/**
+ * @brief Remove fifo head. The element is kept for a later insert.
+ * @param fifo - The fifo.
+ */
+void no_os_fifo_release(struct no_os_fifo *fifo)
+{
+	struct no_os_ilist_node *node;
 
-	return p_fifo;
+	node = no_os_ilist_get_first(&fifo->elements);
+	if (node)
+		no_os_ilist_add_first(&fifo->free, node);
 }
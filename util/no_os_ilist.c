@@ -0,0 +1,175 @@
+/***************************************************************************//**
+ *   @file   no_os_ilist.c
+ *   @brief  Intrusive list and lock-free queue implementation
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include "no_os_ilist.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Count the nodes of a list.
+ * @param list - The list.
+ * @return Number of nodes.
+ */
+uint32_t no_os_ilist_count(const struct no_os_ilist *list)
+{
+	const struct no_os_ilist_node *node;
+	uint32_t count = 0;
+
+	for (node = list->head.next; node != &list->head; node = node->next)
+		count++;
+
+	return count;
+}
+
+/**
+ * @brief Insert a node keeping the list ordered.
+ *
+ * The node is inserted after the nodes equal to it, so nodes with the same
+ * key keep their insertion order.
+ * @param list - The list, ordered according to cmp.
+ * @param node - Node to be inserted.
+ * @param cmp - Returns a negative value if node must be placed before other.
+ */
+void no_os_ilist_add_sorted(struct no_os_ilist *list,
+			    struct no_os_ilist_node *node,
+			    int32_t (*cmp)(const struct no_os_ilist_node *node,
+					   const struct no_os_ilist_node *other))
+{
+	struct no_os_ilist_node *pos;
+
+	no_os_ilist_for_each(pos, list)
+		if (cmp(node, pos) < 0)
+			break;
+
+	no_os_ilist_insert_before(pos, node);
+}
+
+/**
+ * @brief Initialize an empty queue.
+ * @param queue - The queue.
+ */
+void no_os_mpsc_queue_init(struct no_os_mpsc_queue *queue)
+{
+	queue->stub.next = NULL;
+	queue->first = &queue->stub;
+	__atomic_store_n(&queue->last, &queue->stub, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Add a node at the end of the queue.
+ *
+ * Lock-free, may be called from interrupt handlers and from several threads
+ * at the same time.
+ * @param queue - The queue.
+ * @param node - Node to be added, owned by the queue until popped.
+ */
+void no_os_mpsc_queue_push(struct no_os_mpsc_queue *queue,
+			   struct no_os_ilist_node *node)
+{
+	struct no_os_ilist_node *prev;
+
+	__atomic_store_n(&node->next, NULL, __ATOMIC_RELAXED);
+	prev = __atomic_exchange_n(&queue->last, node, __ATOMIC_ACQ_REL);
+	/*
+	 * Until this store the consumer can't see node nor the nodes pushed
+	 * after it. The window is a few instructions long.
+	 */
+	__atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Remove the first node of the queue.
+ *
+ * Must be called by a single consumer. Returns NULL also when a producer was
+ * interrupted in the middle of no_os_mpsc_queue_push, in which case the nodes
+ * can be popped after the producer resumes.
+ * @param queue - The queue.
+ * @return The first node or NULL if there is none available.
+ */
+struct no_os_ilist_node *no_os_mpsc_queue_pop(struct no_os_mpsc_queue *queue)
+{
+	struct no_os_ilist_node *first = queue->first;
+	struct no_os_ilist_node *next;
+
+	next = __atomic_load_n(&first->next, __ATOMIC_ACQUIRE);
+	if (first == &queue->stub) {
+		if (!next)
+			return NULL;
+		queue->first = next;
+		first = next;
+		next = __atomic_load_n(&first->next, __ATOMIC_ACQUIRE);
+	}
+
+	if (next) {
+		queue->first = next;
+		return first;
+	}
+
+	/* first is the only node, or a push is in progress after it */
+	if (first != __atomic_load_n(&queue->last, __ATOMIC_ACQUIRE))
+		return NULL;
+
+	/* Keep the queue non-empty so first can be detached */
+	no_os_mpsc_queue_push(queue, &queue->stub);
+	next = __atomic_load_n(&first->next, __ATOMIC_ACQUIRE);
+	if (next) {
+		queue->first = next;
+		return first;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Check if the queue is empty.
+ * @param queue - The queue.
+ * @return true if no_os_mpsc_queue_pop has nothing to return.
+ */
+bool no_os_mpsc_queue_empty(struct no_os_mpsc_queue *queue)
+{
+	struct no_os_ilist_node *first = queue->first;
+
+	return first == &queue->stub &&
+	       !__atomic_load_n(&first->next, __ATOMIC_ACQUIRE);
+}
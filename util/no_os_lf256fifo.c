@@ -1,6 +1,6 @@
 /***************************************************************************//**
  *   @file   no_os_lf256fifo.c
- *   @brief  SPSC lock-free fifo of fixed size (256), specialized for UART.
+ *   @brief  SPSC lock-free fifo of power of 2 size, specialized for UART.
  *   @author Darius Berghe (darius.berghe@analog.com)
 ********************************************************************************
  *   @copyright
@@ -38,44 +38,102 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include <errno.h>
+#include <string.h>
 #include "no_os_lf256fifo.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /**
  * @struct lf256fifo
  * @brief Structure holding the fifo element parameters.
+ *
+ * ffilled and fempty are free running: the data starts at ffilled & mask and
+ * the number of bytes in the fifo is fempty - ffilled. The writer owns fempty
+ * and overflows, the reader owns ffilled.
  */
 struct lf256fifo {
 	uint8_t * data; // pointer to memory area where the buffer will be allocated
-	uint8_t ffilled; // the index where the data starts
-	uint8_t fempty; // the index where empty/non-used area starts
+	uint32_t size; // size of data, power of 2
+	uint32_t mask; // size - 1
+	uint32_t ffilled; // the index where the data starts
+	uint32_t fempty; // the index where empty/non-used area starts
+	uint32_t overflows; // number of bytes dropped because the fifo was full
 };
 
+/* Read an index owned by the other side of the fifo */
+static inline uint32_t lf256fifo_load(uint32_t *idx)
+{
+	return __atomic_load_n(idx, __ATOMIC_ACQUIRE);
+}
+
+/* Publish an index after the data before it was accessed */
+static inline void lf256fifo_store(uint32_t *idx, uint32_t val)
+{
+	__atomic_store_n(idx, val, __ATOMIC_RELEASE);
+}
+
+/* Count dropped chars. Only called by the writer */
+static inline void lf256fifo_add_overflows(struct lf256fifo *fifo, uint32_t n)
+{
+	__atomic_store_n(&fifo->overflows, fifo->overflows + n, __ATOMIC_RELAXED);
+}
+
 /**
  * @brief Initialize and allocate a lock-free 256 FIFO.
  * @param fifo - pointer to a fifo descriptor pointer.
  * @return 0 if successful, negative error code otherwise.
  */
 int lf256fifo_init(struct lf256fifo **fifo)
+{
+	return lf256fifo_init_size(fifo, LF256FIFO_DEFAULT_SIZE);
+}
+
+/**
+ * @brief Initialize and allocate a lock-free FIFO.
+ * @param fifo - pointer to a fifo descriptor pointer.
+ * @param size - size of the fifo in bytes, a power of 2 (0 for the default).
+ * @return 0 if successful, negative error code otherwise.
+ */
+int lf256fifo_init_size(struct lf256fifo **fifo, uint32_t size)
 {
 	if (fifo == NULL)
 		return -EINVAL;
 
+	if (!size)
+		size = LF256FIFO_DEFAULT_SIZE;
+
+	if ((size & (size - 1)) || size > (UINT32_MAX >> 1) + 1)
+		return -EINVAL;
+
 	struct lf256fifo *b = no_os_calloc(1, sizeof(struct lf256fifo));
 	if (b == NULL)
 		return -ENOMEM;
 
-	b->data = no_os_calloc(1, 256);
+	b->data = no_os_calloc(1, size);
 	if (b->data == NULL) {
 		no_os_free(b);
 		return -ENOMEM;
 	}
+	b->size = size;
+	b->mask = size - 1;
 
 	*fifo = b;
 
 	return 0;
 }
 
+/**
+ * @brief Get the number of bytes in the fifo.
+ * @param fifo - pointer to fifo descriptor.
+ * @return number of bytes available to read.
+ */
+uint32_t lf256fifo_level(struct lf256fifo *fifo)
+{
+	uint32_t ffilled = lf256fifo_load(&fifo->ffilled);
+
+	return lf256fifo_load(&fifo->fempty) - ffilled;
+}
+
 /**
  * @brief Test whether fifo is full.
  * @param fifo - pointer to fifo descriptor.
@@ -83,8 +141,7 @@ int lf256fifo_init(struct lf256fifo **fifo)
  */
 bool lf256fifo_is_full(struct lf256fifo *fifo)
 {
-	return (fifo->fempty + 1) ==
-	       fifo->ffilled; // intended overflow at 256 (data size is 256)
+	return lf256fifo_level(fifo) == fifo->size;
 }
 
 /**
@@ -94,7 +151,7 @@ bool lf256fifo_is_full(struct lf256fifo *fifo)
 */
 bool lf256fifo_is_empty(struct lf256fifo *fifo)
 {
-	return fifo->fempty == fifo->ffilled;
+	return !lf256fifo_level(fifo);
 }
 
 /**
@@ -105,11 +162,11 @@ bool lf256fifo_is_empty(struct lf256fifo *fifo)
 */
 int lf256fifo_read(struct lf256fifo * fifo, uint8_t *c)
 {
-	if (lf256fifo_is_empty(fifo))
+	if (lf256fifo_load(&fifo->fempty) == fifo->ffilled)
 		return -1; // buffer empty
 
-	*c = fifo->data[fifo->ffilled];
-	fifo->ffilled++; // intended overflow at 256 (data size is 256)
+	*c = fifo->data[fifo->ffilled & fifo->mask];
+	lf256fifo_store(&fifo->ffilled, fifo->ffilled + 1);
 
 	return 0;
 }
@@ -122,23 +179,146 @@ int lf256fifo_read(struct lf256fifo * fifo, uint8_t *c)
 */
 int lf256fifo_write(struct lf256fifo *fifo, uint8_t c)
 {
-	if (lf256fifo_is_full(fifo))
+	if (fifo->fempty - lf256fifo_load(&fifo->ffilled) == fifo->size) {
+		lf256fifo_add_overflows(fifo, 1);
 		return -1; // buffer full
+	}
 
-	fifo->data[fifo->fempty] = c;
-	fifo->fempty++; // intended overflow at 256 (data size is 256)
+	fifo->data[fifo->fempty & fifo->mask] = c;
+	lf256fifo_store(&fifo->fempty, fifo->fempty + 1);
 
 	return 0; // return success
 }
 
 /**
-* @brief Flush the fifo.
+* @brief Read up to n chars from fifo.
+* @param fifo - pointer to fifo descriptor.
+* @param buf - memory where the chars are read.
+* @param n - maximum number of chars to read.
+* @return number of chars read.
+*/
+uint32_t lf256fifo_read_n(struct lf256fifo *fifo, uint8_t *buf, uint32_t n)
+{
+	uint32_t idx = fifo->ffilled & fifo->mask;
+	uint32_t first;
+
+	n = no_os_min(n, lf256fifo_load(&fifo->fempty) - fifo->ffilled);
+	first = no_os_min(n, fifo->size - idx);
+	memcpy(buf, &fifo->data[idx], first);
+	memcpy(buf + first, fifo->data, n - first);
+	lf256fifo_store(&fifo->ffilled, fifo->ffilled + n);
+
+	return n;
+}
+
+/**
+* @brief Write up to n chars to fifo. The chars which don't fit are dropped.
+* @param fifo - pointer to fifo descriptor.
+* @param buf - chars to write.
+* @param n - number of chars to write.
+* @return number of chars written.
+*/
+uint32_t lf256fifo_write_n(struct lf256fifo *fifo, const uint8_t *buf,
+			   uint32_t n)
+{
+	uint32_t idx = fifo->fempty & fifo->mask;
+	uint32_t space, first;
+
+	space = fifo->size - (fifo->fempty - lf256fifo_load(&fifo->ffilled));
+	if (n > space) {
+		lf256fifo_add_overflows(fifo, n - space);
+		n = space;
+	}
+	first = no_os_min(n, fifo->size - idx);
+	memcpy(&fifo->data[idx], buf, first);
+	memcpy(fifo->data, buf + first, n - first);
+	lf256fifo_store(&fifo->fempty, fifo->fempty + n);
+
+	return n;
+}
+
+/**
+* @brief Get the contiguous region of the fifo which holds data.
+* @param fifo - pointer to fifo descriptor.
+* @param buf - where to store the start of the region.
+* @return size of the region, 0 if fifo is empty.
+*/
+uint32_t lf256fifo_peek_read(struct lf256fifo *fifo, uint8_t **buf)
+{
+	uint32_t idx = fifo->ffilled & fifo->mask;
+
+	*buf = &fifo->data[idx];
+
+	return no_os_min(lf256fifo_load(&fifo->fempty) - fifo->ffilled,
+			 fifo->size - idx);
+}
+
+/**
+* @brief Remove from fifo n chars read in place.
+* @param fifo - pointer to fifo descriptor.
+* @param n - number of chars.
+* @return 0 if successful, -EINVAL if fifo holds less than n chars.
+*/
+int lf256fifo_commit_read(struct lf256fifo *fifo, uint32_t n)
+{
+	if (n > lf256fifo_load(&fifo->fempty) - fifo->ffilled)
+		return -EINVAL;
+
+	lf256fifo_store(&fifo->ffilled, fifo->ffilled + n);
+
+	return 0;
+}
+
+/**
+* @brief Get the contiguous free region of the fifo.
+* @param fifo - pointer to fifo descriptor.
+* @param buf - where to store the start of the region.
+* @return size of the region, 0 if fifo is full.
+*/
+uint32_t lf256fifo_peek_write(struct lf256fifo *fifo, uint8_t **buf)
+{
+	uint32_t idx = fifo->fempty & fifo->mask;
+	uint32_t used = fifo->fempty - lf256fifo_load(&fifo->ffilled);
+
+	*buf = &fifo->data[idx];
+
+	return no_os_min(fifo->size - used, fifo->size - idx);
+}
+
+/**
+* @brief Add to fifo n chars written in place.
+* @param fifo - pointer to fifo descriptor.
+* @param n - number of chars.
+* @return 0 if successful, -EINVAL if there is no room for n chars.
+*/
+int lf256fifo_commit_write(struct lf256fifo *fifo, uint32_t n)
+{
+	if (n > fifo->size - (fifo->fempty - lf256fifo_load(&fifo->ffilled)))
+		return -EINVAL;
+
+	lf256fifo_store(&fifo->fempty, fifo->fempty + n);
+
+	return 0;
+}
+
+/**
+* @brief Get the number of chars dropped by writes to a full fifo.
+* @param fifo - pointer to fifo descriptor.
+* @return number of chars dropped since the fifo was created.
+*/
+uint32_t lf256fifo_get_overflows(struct lf256fifo *fifo)
+{
+	return __atomic_load_n(&fifo->overflows, __ATOMIC_RELAXED);
+}
+
+/**
+* @brief Flush the fifo. Must be called by the reader.
 * @param fifo - pointer to fifo descriptor.
 * @return void
 */
 void lf256fifo_flush(struct lf256fifo *fifo)
 {
-	fifo->ffilled = fifo->fempty;
+	lf256fifo_store(&fifo->ffilled, lf256fifo_load(&fifo->fempty));
 }
 
 /**
@@ -148,7 +328,9 @@ void lf256fifo_flush(struct lf256fifo *fifo)
 */
 void lf256fifo_remove(struct lf256fifo *fifo)
 {
-	if (fifo && fifo->data)
-		no_os_free(fifo->data);
-}
+	if (!fifo)
+		return;
 
+	no_os_free(fifo->data);
+	no_os_free(fifo);
+}
@@ -0,0 +1,449 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap.c
+ *   @brief  Implementation of the cached register map layer.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <string.h>
+#include "no_os_regmap.h"
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Check if a register is part of an access table.
+ * @param table - The access table, NULL for all the registers.
+ * @param len - Number of ranges in the table.
+ * @param reg - The register address.
+ * @return true if the register is in the table.
+ */
+static bool regmap_in_table(const struct no_os_regmap_range *table,
+			    uint32_t len, uint32_t reg)
+{
+	uint32_t i;
+
+	if (!table)
+		return true;
+
+	for (i = 0; i < len; i++)
+		if (reg >= table[i].min && reg <= table[i].max)
+			return true;
+
+	return false;
+}
+
+/**
+ * @brief Check if the value of a register may be cached.
+ * @param map - The register map.
+ * @param reg - The register address.
+ * @return true if the register is cacheable.
+ */
+static bool regmap_cacheable(struct no_os_regmap *map, uint32_t reg)
+{
+	if (!map->cache)
+		return false;
+
+	if (!regmap_in_table(map->config.cache_table,
+			     map->config.cache_table_len, reg))
+		return false;
+
+	/* Unlike the access tables, a missing volatile table means none. */
+	if (!map->config.volatile_table)
+		return true;
+
+	return !regmap_in_table(map->config.volatile_table,
+				map->config.volatile_table_len, reg);
+}
+
+/**
+ * @brief Test the bit of a register in a cache bitmap.
+ * @param bitmap - The bitmap.
+ * @param reg - The register address.
+ * @return true if the bit is set.
+ */
+static bool regmap_test_bit(uint32_t *bitmap, uint32_t reg)
+{
+	return bitmap[reg / 32] & NO_OS_BIT_ULL(reg % 32);
+}
+
+/**
+ * @brief Set or clear the bit of a register in a cache bitmap.
+ * @param bitmap - The bitmap.
+ * @param reg - The register address.
+ * @param set - The new value of the bit.
+ */
+static void regmap_set_bit(uint32_t *bitmap, uint32_t reg, bool set)
+{
+	if (set)
+		bitmap[reg / 32] |= NO_OS_BIT_ULL(reg % 32);
+	else
+		bitmap[reg / 32] &= ~NO_OS_BIT_ULL(reg % 32);
+}
+
+/**
+ * @brief Read a register from the device and count the access.
+ * @param map - The register map.
+ * @param reg - The register address.
+ * @param val - The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t regmap_bus_read(struct no_os_regmap *map, uint32_t reg,
+			       uint32_t *val)
+{
+	map->stats.bus_reads++;
+
+	return map->ops->reg_read(map->ctx, reg, val);
+}
+
+/**
+ * @brief Write a register of the device and count the access.
+ * @param map - The register map.
+ * @param reg - The register address.
+ * @param val - The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t regmap_bus_write(struct no_os_regmap *map, uint32_t reg,
+				uint32_t val)
+{
+	map->stats.bus_writes++;
+
+	return map->ops->reg_write(map->ctx, reg, val);
+}
+
+/**
+ * @brief Initialize a register map with custom device access functions.
+ * @param map - The register map.
+ * @param ops - The device access functions.
+ * @param ctx - Passed to the device access functions.
+ * @param config - Description of the register map, copied by this function.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_regmap_init(struct no_os_regmap **map,
+			  const struct no_os_regmap_bus_ops *ops, void *ctx,
+			  const struct no_os_regmap_config *config)
+{
+	struct no_os_regmap *descriptor;
+	uint32_t nb_words;
+
+	if (!map || !ops || !ops->reg_read || !ops->reg_write || !config)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->config = *config;
+	descriptor->ops = ops;
+	descriptor->ctx = ctx;
+
+	if (config->cache_type == NO_OS_REGMAP_CACHE_FLAT) {
+		nb_words = NO_OS_DIV_ROUND_UP(config->max_register + 1, 32);
+		descriptor->cache = no_os_calloc(config->max_register + 1,
+						 sizeof(*descriptor->cache));
+		descriptor->valid = no_os_calloc(nb_words, sizeof(uint32_t));
+		descriptor->dirty = no_os_calloc(nb_words, sizeof(uint32_t));
+		if (!descriptor->cache || !descriptor->valid ||
+		    !descriptor->dirty) {
+			no_os_regmap_remove(descriptor);
+			return -ENOMEM;
+		}
+	}
+
+	*map = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Check the value and address widths used by the SPI and I2C backends.
+ * @param config - Description of the register map.
+ * @return true if the widths are supported.
+ */
+bool no_os_regmap_valid_format(const struct no_os_regmap_config *config)
+{
+	if (!config)
+		return false;
+
+	if (config->reg_bits != 8 && config->reg_bits != 16)
+		return false;
+
+	return config->val_bits && config->val_bits <= 32 &&
+	       !(config->val_bits % 8);
+}
+
+/**
+ * @brief Build the address and value bytes of a SPI or I2C access.
+ * @param map - The register map.
+ * @param buf - Buffer of at least NO_OS_REGMAP_MAX_BYTES bytes.
+ * @param reg - The register address, including the read or write flag.
+ * @param val - The register value.
+ * @return Number of address bytes.
+ */
+uint32_t no_os_regmap_format(struct no_os_regmap *map, uint8_t *buf,
+			     uint32_t reg, uint32_t val)
+{
+	uint32_t reg_bytes = map->config.reg_bits / 8;
+	uint32_t val_bytes = map->config.val_bits / 8;
+	uint32_t i;
+
+	for (i = 0; i < reg_bytes; i++)
+		buf[i] = reg >> (8 * (reg_bytes - i - 1));
+	for (i = 0; i < val_bytes; i++)
+		buf[reg_bytes + i] = val >> (8 * (val_bytes - i - 1));
+
+	return reg_bytes;
+}
+
+/**
+ * @brief Parse a big endian register value.
+ * @param map - The register map.
+ * @param buf - The value bytes.
+ * @return The register value.
+ */
+uint32_t no_os_regmap_parse(struct no_os_regmap *map, uint8_t *buf)
+{
+	uint32_t i, val = 0;
+
+	for (i = 0; i < map->config.val_bits / 8u; i++)
+		val = (val << 8) | buf[i];
+
+	return val;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_regmap_init*(). The dirty
+ * registers are not written to the device.
+ * @param map - The register map.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_regmap_remove(struct no_os_regmap *map)
+{
+	if (!map)
+		return -EINVAL;
+
+	no_os_free(map->cache);
+	no_os_free(map->valid);
+	no_os_free(map->dirty);
+	no_os_free(map);
+
+	return 0;
+}
+
+/**
+ * @brief Read a register. Cacheable registers are read from the device only
+ * the first time, write-only registers can be read once written.
+ * @param map - The register map.
+ * @param reg - The register address.
+ * @param val - The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_regmap_read(struct no_os_regmap *map, uint32_t reg,
+			  uint32_t *val)
+{
+	bool cacheable;
+	int32_t ret;
+
+	if (!map || !val || reg > map->config.max_register)
+		return -EINVAL;
+
+	cacheable = regmap_cacheable(map, reg);
+	if (cacheable && regmap_test_bit(map->valid, reg)) {
+		map->stats.cache_hits++;
+		*val = map->cache[reg];
+		return 0;
+	}
+
+	if (!regmap_in_table(map->config.rd_table, map->config.rd_table_len,
+			     reg))
+		return -EPERM;
+
+	ret = regmap_bus_read(map, reg, val);
+	if (ret)
+		return ret;
+
+	if (cacheable) {
+		map->cache[reg] = *val;
+		regmap_set_bit(map->valid, reg, true);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Write a register. In cache only mode, the write of a cacheable
+ * register is deferred until no_os_regmap_sync().
+ * @param map - The register map.
+ * @param reg - The register address.
+ * @param val - The register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_regmap_write(struct no_os_regmap *map, uint32_t reg,
+			   uint32_t val)
+{
+	bool cacheable;
+	int32_t ret;
+
+	if (!map || reg > map->config.max_register)
+		return -EINVAL;
+
+	if (!regmap_in_table(map->config.wr_table, map->config.wr_table_len,
+			     reg))
+		return -EPERM;
+
+	cacheable = regmap_cacheable(map, reg);
+	if (!cacheable || !map->cache_only) {
+		ret = regmap_bus_write(map, reg, val);
+		if (ret)
+			return ret;
+	}
+
+	if (cacheable) {
+		map->cache[reg] = val;
+		regmap_set_bit(map->valid, reg, true);
+		regmap_set_bit(map->dirty, reg, map->cache_only);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Update the bits of a register selected by mask. The register is not
+ * read from the device if it is cached, and not written if the value of a
+ * cacheable register does not change.
+ * @param map - The register map.
+ * @param reg - The register address.
+ * @param mask - The bits to update.
+ * @param val - The new value of the bits, already shifted to their position.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_regmap_update_bits(struct no_os_regmap *map, uint32_t reg,
+				 uint32_t mask, uint32_t val)
+{
+	uint32_t orig, tmp;
+	int32_t ret;
+
+	ret = no_os_regmap_read(map, reg, &orig);
+	if (ret)
+		return ret;
+
+	tmp = (orig & ~mask) | (val & mask);
+	if (tmp == orig && regmap_cacheable(map, reg)) {
+		map->stats.skipped_writes++;
+		return 0;
+	}
+
+	return no_os_regmap_write(map, reg, tmp);
+}
+
+/**
+ * @brief Defer the writes of the cacheable registers until
+ * no_os_regmap_sync(). Several writes of the same register then cost a single
+ * device access.
+ * @param map - The register map.
+ * @param enable - Enable or disable the cache only mode. Disabling it does not
+ * sync the cache.
+ */
+void no_os_regmap_cache_only(struct no_os_regmap *map, bool enable)
+{
+	if (map && map->cache)
+		map->cache_only = enable;
+}
+
+/**
+ * @brief Write the dirty registers to the device, in ascending address order.
+ * @param map - The register map.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_regmap_sync(struct no_os_regmap *map)
+{
+	uint32_t reg, word, nb_words;
+	int32_t ret, ret2;
+
+	if (!map)
+		return -EINVAL;
+
+	if (!map->cache)
+		return 0;
+
+	if (map->ops->sync_begin) {
+		ret = map->ops->sync_begin(map->ctx);
+		if (ret)
+			return ret;
+	}
+
+	ret = 0;
+	nb_words = NO_OS_DIV_ROUND_UP(map->config.max_register + 1, 32);
+	for (word = 0; word < nb_words && !ret; word++) {
+		while (map->dirty[word] && !ret) {
+			reg = word * 32 + no_os_find_first_set_bit(map->dirty[word]);
+			ret = regmap_bus_write(map, reg, map->cache[reg]);
+			if (!ret)
+				regmap_set_bit(map->dirty, reg, false);
+		}
+	}
+
+	if (map->ops->sync_end) {
+		ret2 = map->ops->sync_end(map->ctx);
+		if (!ret)
+			ret = ret2;
+	}
+
+	return ret;
+}
+
+/**
+ * @brief Forget the cached values, e.g. after a device reset. The dirty
+ * registers are dropped as well.
+ * @param map - The register map.
+ */
+void no_os_regmap_cache_drop(struct no_os_regmap *map)
+{
+	uint32_t nb_words;
+
+	if (!map || !map->cache)
+		return;
+
+	nb_words = NO_OS_DIV_ROUND_UP(map->config.max_register + 1, 32);
+	memset(map->valid, 0, nb_words * sizeof(uint32_t));
+	memset(map->dirty, 0, nb_words * sizeof(uint32_t));
+}
@@ -136,17 +136,16 @@ int32_t no_os_log_base_2(uint32_t x)
 uint32_t no_os_greatest_common_divisor(uint32_t a,
 				       uint32_t b)
 {
-	uint32_t div;
-	uint32_t common_div = 1;
+	uint32_t tmp;
 
-	if ((a == 0) || (b == 0))
-		return no_os_max(a, b);
-
-	for (div = 1; (div <= a) && (div <= b); div++)
-		if (!(a % div) && !(b % div))
-			common_div = div;
+	/* Euclid's algorithm, gcd(a, 0) = a */
+	while (b) {
+		tmp = a % b;
+		a = b;
+		b = tmp;
+	}
 
-	return common_div;
+	return a;
 }
 /**
  * Find lowest common multiple of the given two numbers.